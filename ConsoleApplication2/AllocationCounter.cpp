@@ -0,0 +1,212 @@
+// =================================================================================================
+// Counting replacements of the global operator new and delete. Every form is replaced, nothrow
+// and over-aligned included, so no allocation goes uncounted and every pointer is freed by the
+// allocator that handed it out.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// =================================================================================================
+// ===================================== GLOBAL VARIABLES ==========================================
+
+static std::atomic<uint64_t> g_allocations(0);
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// GetAllocationCount
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint64_t GetAllocationCount()
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// CountedAlloc             nullptr when the heap is out
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void* CountedAlloc(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size != 0 ? size : 1);
+}
+
+// =================================================================================================
+// CountedAlignedAlloc      aligned_alloc wants the size in whole alignments; MSVC has no
+//                          aligned_alloc and frees what _aligned_malloc returns with _aligned_free
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void* CountedAlignedAlloc(size_t size, std::align_val_t alignment)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t align = (size_t)alignment;
+    size_t rounded = size != 0 ? (size + align - 1) / align * align : align;
+#ifdef _WIN32
+    return _aligned_malloc(rounded, align);
+#else
+    return std::aligned_alloc(align, rounded);
+#endif
+}
+
+// =================================================================================================
+// CountedAlignedFree
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CountedAlignedFree(void* p)
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+// =================================================================================================
+// operator new             plain and array, throwing and nothrow
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void* operator new(size_t size)
+{
+    void* p = CountedAlloc(size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+// =================================================================================================
+// operator new             over-aligned, throwing and nothrow
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    void* p = CountedAlignedAlloc(size, alignment);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return CountedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return CountedAlignedAlloc(size, alignment);
+}
+
+// =================================================================================================
+// operator delete          every form the plain and nothrow news pair with
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+// =================================================================================================
+// operator delete          every form the over-aligned news pair with
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    CountedAlignedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    CountedAlignedFree(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+    CountedAlignedFree(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept
+{
+    CountedAlignedFree(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    CountedAlignedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    CountedAlignedFree(p);
+}
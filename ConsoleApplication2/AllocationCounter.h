@@ -0,0 +1,22 @@
+// =================================================================================================
+// Counts every heap allocation of the process. AllocationCounter.cpp replaces the global operator
+// new and delete, every form of them, so it is linked into the bench and the test executables
+// only, never into joystick_core.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// operator new calls of every thread since the start, the failed ones included
+uint64_t GetAllocationCount();
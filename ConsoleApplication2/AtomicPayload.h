@@ -0,0 +1,55 @@
+// =================================================================================================
+// Trivially-copyable value stored as relaxed atomic words, the payload of the seqlock-style
+// containers. Concurrent Store/Load never race in the C++ memory model; consistency is up to the
+// sequence counter of the owner.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+template <typename T>
+class CAtomicPayload
+{
+   static_assert(std::is_trivially_copyable<T>::value, "payload must be trivially copyable");
+
+public:
+   static const size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+   void Store(const T& value)
+   {
+      uint64_t words[WORDS] = {};
+      std::memcpy(words, &value, sizeof(T));
+      for (size_t i = 0; i < WORDS; i++)
+      {
+         m_words[i].store(words[i], std::memory_order_relaxed);
+      }
+   }
+
+   void Load(T& value) const
+   {
+      uint64_t words[WORDS];
+      for (size_t i = 0; i < WORDS; i++)
+      {
+         words[i] = m_words[i].load(std::memory_order_relaxed);
+      }
+      std::memcpy(&value, words, sizeof(T));
+   }
+
+private:
+   std::atomic<uint64_t> m_words[WORDS] = {};
+};
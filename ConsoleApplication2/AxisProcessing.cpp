@@ -0,0 +1,354 @@
+// =================================================================================================
+// Axis post-processing: the raw stick and trigger values of a pad state turned into normalized
+// floats with deadzones, anti-deadzone, response curves and inversion, configured per device.
+// Scalar, SSE2 and AVX2 kernels compute the same result; the best one is picked at run time.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "AxisProcessing.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "CpuFeatures.h"
+#if JOYSTICK_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+#if JOYSTICK_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Every kernel loads the eight lanes of a report with one 16-byte read from leftX: the six axes,
+// then hat/player and flags/battery, which the processor gives a zero scale
+static_assert(offsetof(SPadState, R2) == offsetof(SPadState, leftX) + (AXIS_COUNT - 1) * sizeof(uint16_t), "axes must be contiguous");
+static_assert(offsetof(SPadState, leftX) + AXIS_LANES * sizeof(uint16_t) <= sizeof(SPadState), "axis lanes must stay inside SPadState");
+
+// Deadzones are kept this far apart so the remapping never divides by zero
+const float AXIS_MIN_DEADZONE_SPAN = 0.01f;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// IsRadialLane
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool IsRadialLane(const SAxisConfig& config, int axis)
+{
+    if (axis == AXIS_LEFT_X || axis == AXIS_LEFT_Y)
+    {
+        return config.leftStick == DEADZONE_RADIAL;
+    }
+    if (axis == AXIS_RIGHT_X || axis == AXIS_RIGHT_Y)
+    {
+        return config.rightStick == DEADZONE_RADIAL;
+    }
+    return false;
+}
+
+// =================================================================================================
+// BuildAxisCurve           the lookup table of one lane: custom points resampled, or a power curve
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BuildAxisCurve(const SAxisSettings& settings, float* curve)
+{
+    const std::vector<float>& points = settings.curvePoints;
+    float exponent = settings.curveExponent > 0.0f ? settings.curveExponent : 1.0f;
+
+    for (int i = 0; i < AXIS_CURVE_POINTS; i++)
+    {
+        float t = (float)i / (float)(AXIS_CURVE_POINTS - 1);
+        if (points.size() >= 2)
+        {
+            float position = t * (float)(points.size() - 1);
+            size_t index = std::min((size_t)position, points.size() - 2);
+            float fraction = position - (float)index;
+            curve[i] = points[index] + (points[index + 1] - points[index]) * fraction;
+        }
+        else
+        {
+            curve[i] = std::pow(t, exponent);
+        }
+    }
+}
+
+// =================================================================================================
+// BuildAxisProcessor       every division and every branch on the configuration happens here
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void BuildAxisProcessor(const SAxisConfig& config, SAxisProcessor& processor)
+{
+    std::memset(&processor, 0, sizeof(processor));
+
+    for (int lane = 0; lane < AXIS_LANES; lane++)
+    {
+        processor.curveBase[lane] = lane * AXIS_CURVE_POINTS;
+    }
+
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        const SAxisSettings& settings = config.axes[axis];
+        bool stick = axis < AXIS_L2;
+        float range = (float)settings.rawMax - (float)settings.rawMin;
+        float sign = settings.invert ? -1.0f : 1.0f;
+
+        if (stick)
+        {
+            processor.offset[axis] = ((float)settings.rawMin + (float)settings.rawMax) * 0.5f;
+            processor.scale[axis] = range != 0.0f ? sign * 2.0f / range : 0.0f;
+            processor.minimum[axis] = -1.0f;
+        }
+        else
+        {
+            // An inverted trigger rests at rawMax
+            processor.offset[axis] = settings.invert ? (float)settings.rawMax : (float)settings.rawMin;
+            processor.scale[axis] = range != 0.0f ? sign / range : 0.0f;
+            processor.minimum[axis] = 0.0f;
+        }
+
+        float deadzone = std::min(std::max(settings.deadzone, 0.0f), 1.0f - AXIS_MIN_DEADZONE_SPAN);
+        float outerDeadzone = std::max(std::min(settings.outerDeadzone, 1.0f), deadzone + AXIS_MIN_DEADZONE_SPAN);
+        float antiDeadzone = std::min(std::max(settings.antiDeadzone, 0.0f), 1.0f);
+        processor.deadzone[axis] = deadzone;
+        processor.deadzoneScale[axis] = 1.0f / (outerDeadzone - deadzone);
+        processor.antiDeadzone[axis] = antiDeadzone;
+        processor.antiDeadzoneScale[axis] = 1.0f - antiDeadzone;
+        processor.radialMask[axis] = IsRadialLane(config, axis) ? 0xFFFFFFFFu : 0;
+
+        BuildAxisCurve(settings, processor.curve + axis * AXIS_CURVE_POINTS);
+    }
+}
+
+// =================================================================================================
+// ProcessAxesScalar        the reference: lane by lane, the same operations in the same order as
+//                          the SIMD kernels so all of them agree to the bit
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ProcessAxesScalar(const SAxisProcessor& processor, const SPadState* states, size_t count, SAxisOutput* outputs)
+{
+    const float lastSegment = (float)(AXIS_CURVE_POINTS - 2);
+
+    for (size_t n = 0; n < count; n++)
+    {
+        uint16_t raw[AXIS_LANES];
+        std::memcpy(raw, &states[n].leftX, sizeof(raw));
+
+        float values[AXIS_LANES];
+        float squares[AXIS_LANES];
+        for (int lane = 0; lane < AXIS_LANES; lane++)
+        {
+            float value = ((float)raw[lane] - processor.offset[lane]) * processor.scale[lane];
+            values[lane] = std::min(std::max(value, processor.minimum[lane]), 1.0f);
+            squares[lane] = values[lane] * values[lane];
+        }
+
+        for (int lane = 0; lane < AXIS_LANES; lane++)
+        {
+            float magnitude = processor.radialMask[lane] != 0 ? std::sqrt(squares[lane] + squares[lane ^ 1]) : std::fabs(values[lane]);
+            float remapped = std::min(std::max((magnitude - processor.deadzone[lane]) * processor.deadzoneScale[lane], 0.0f), 1.0f);
+            float shaped = processor.antiDeadzone[lane] + remapped * processor.antiDeadzoneScale[lane];
+
+            float position = shaped * (float)(AXIS_CURVE_POINTS - 1);
+            int index = (int)std::min(position, lastSegment);
+            float fraction = position - (float)index;
+            const float* curve = processor.curve + processor.curveBase[lane] + index;
+            float curved = curve[0] + (curve[1] - curve[0]) * fraction;
+
+            float gain = remapped > 0.0f ? curved / magnitude : 0.0f;
+            outputs[n].values[lane] = values[lane] * gain;
+        }
+    }
+}
+
+#if JOYSTICK_HAVE_SSE2
+
+// =================================================================================================
+// ProcessHalfSse2          four lanes of one report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ProcessHalfSse2(const SAxisProcessor& processor, int base, __m128 raw, float* output)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    __m128 values = _mm_mul_ps(_mm_sub_ps(raw, _mm_load_ps(processor.offset + base)), _mm_load_ps(processor.scale + base));
+    values = _mm_min_ps(_mm_max_ps(values, _mm_load_ps(processor.minimum + base)), one);
+
+    // Each lane adds the square of its pair partner: x^2 + y^2 on both lanes of a stick
+    __m128 squares = _mm_mul_ps(values, values);
+    __m128 radial = _mm_sqrt_ps(_mm_add_ps(squares, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(2, 3, 0, 1))));
+    __m128 radialMask = _mm_load_ps((const float*)(processor.radialMask + base));
+    __m128 magnitude = _mm_or_ps(_mm_and_ps(radialMask, radial), _mm_andnot_ps(radialMask, _mm_and_ps(values, absMask)));
+
+    __m128 remapped = _mm_mul_ps(_mm_sub_ps(magnitude, _mm_load_ps(processor.deadzone + base)), _mm_load_ps(processor.deadzoneScale + base));
+    remapped = _mm_min_ps(_mm_max_ps(remapped, zero), one);
+    __m128 shaped = _mm_add_ps(_mm_load_ps(processor.antiDeadzone + base), _mm_mul_ps(remapped, _mm_load_ps(processor.antiDeadzoneScale + base)));
+
+    __m128 position = _mm_mul_ps(shaped, _mm_set1_ps((float)(AXIS_CURVE_POINTS - 1)));
+    __m128i index = _mm_cvttps_epi32(_mm_min_ps(position, _mm_set1_ps((float)(AXIS_CURVE_POINTS - 2))));
+    __m128 fraction = _mm_sub_ps(position, _mm_cvtepi32_ps(index));
+
+    // SSE2 has no gather: four scalar loads per end of the segment
+    alignas(16) int32_t offsets[4];
+    _mm_store_si128((__m128i*)offsets, _mm_add_epi32(index, _mm_load_si128((const __m128i*)(processor.curveBase + base))));
+    const float* curve = processor.curve;
+    __m128 low = _mm_setr_ps(curve[offsets[0]], curve[offsets[1]], curve[offsets[2]], curve[offsets[3]]);
+    __m128 high = _mm_setr_ps(curve[offsets[0] + 1], curve[offsets[1] + 1], curve[offsets[2] + 1], curve[offsets[3] + 1]);
+    __m128 curved = _mm_add_ps(low, _mm_mul_ps(_mm_sub_ps(high, low), fraction));
+
+    __m128 gain = _mm_and_ps(_mm_div_ps(curved, magnitude), _mm_cmpgt_ps(remapped, zero));
+    _mm_store_ps(output, _mm_mul_ps(values, gain));
+}
+
+// =================================================================================================
+// ProcessAxesSse2          one report as two halves of four lanes
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ProcessAxesSse2(const SAxisProcessor& processor, const SPadState* states, size_t count, SAxisOutput* outputs)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    for (size_t n = 0; n < count; n++)
+    {
+        __m128i raw = _mm_loadu_si128((const __m128i*)&states[n].leftX);
+        ProcessHalfSse2(processor, 0, _mm_cvtepi32_ps(_mm_unpacklo_epi16(raw, zero)), outputs[n].values);
+        ProcessHalfSse2(processor, 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(raw, zero)), outputs[n].values + 4);
+    }
+}
+
+#endif
+
+#if JOYSTICK_HAVE_AVX2
+
+// =================================================================================================
+// ProcessAxesAvx2          one report per register, the curve read with two gathers
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+JOYSTICK_TARGET_AVX2 static void ProcessAxesAvx2(const SAxisProcessor& processor, const SPadState* states, size_t count, SAxisOutput* outputs)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 curveLast = _mm256_set1_ps((float)(AXIS_CURVE_POINTS - 1));
+    const __m256 curveLastSegment = _mm256_set1_ps((float)(AXIS_CURVE_POINTS - 2));
+
+    const __m256 offset = _mm256_load_ps(processor.offset);
+    const __m256 scale = _mm256_load_ps(processor.scale);
+    const __m256 minimum = _mm256_load_ps(processor.minimum);
+    const __m256 radialMask = _mm256_load_ps((const float*)processor.radialMask);
+    const __m256 deadzone = _mm256_load_ps(processor.deadzone);
+    const __m256 deadzoneScale = _mm256_load_ps(processor.deadzoneScale);
+    const __m256 antiDeadzone = _mm256_load_ps(processor.antiDeadzone);
+    const __m256 antiDeadzoneScale = _mm256_load_ps(processor.antiDeadzoneScale);
+    const __m256i curveBase = _mm256_load_si256((const __m256i*)processor.curveBase);
+
+    for (size_t n = 0; n < count; n++)
+    {
+        __m128i raw = _mm_loadu_si128((const __m128i*)&states[n].leftX);
+        __m256 values = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(raw)), offset), scale);
+        values = _mm256_min_ps(_mm256_max_ps(values, minimum), one);
+
+        __m256 squares = _mm256_mul_ps(values, values);
+        __m256 radial = _mm256_sqrt_ps(_mm256_add_ps(squares, _mm256_permute_ps(squares, _MM_SHUFFLE(2, 3, 0, 1))));
+        __m256 magnitude = _mm256_blendv_ps(_mm256_and_ps(values, absMask), radial, radialMask);
+
+        __m256 remapped = _mm256_mul_ps(_mm256_sub_ps(magnitude, deadzone), deadzoneScale);
+        remapped = _mm256_min_ps(_mm256_max_ps(remapped, zero), one);
+        __m256 shaped = _mm256_add_ps(antiDeadzone, _mm256_mul_ps(remapped, antiDeadzoneScale));
+
+        __m256 position = _mm256_mul_ps(shaped, curveLast);
+        __m256i index = _mm256_cvttps_epi32(_mm256_min_ps(position, curveLastSegment));
+        __m256 fraction = _mm256_sub_ps(position, _mm256_cvtepi32_ps(index));
+
+        __m256i offsets = _mm256_add_epi32(index, curveBase);
+        __m256 low = _mm256_i32gather_ps(processor.curve, offsets, 4);
+        __m256 high = _mm256_i32gather_ps(processor.curve + 1, offsets, 4);
+        __m256 curved = _mm256_add_ps(low, _mm256_mul_ps(_mm256_sub_ps(high, low), fraction));
+
+        __m256 gain = _mm256_and_ps(_mm256_div_ps(curved, magnitude), _mm256_cmp_ps(remapped, zero, _CMP_GT_OQ));
+        _mm256_store_ps(outputs[n].values, _mm256_mul_ps(values, gain));
+    }
+}
+
+#endif
+
+// =================================================================================================
+// GetAxisKernel
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+PFN_AXIS_KERNEL GetAxisKernel(EAxisKernel kernel)
+{
+    switch (kernel)
+    {
+        case AXIS_KERNEL_SCALAR:
+            return ProcessAxesScalar;
+
+        case AXIS_KERNEL_SSE2:
+#if JOYSTICK_HAVE_SSE2
+            if (GetCpuFeatures() & CPU_FEATURE_SSE2)
+            {
+                return ProcessAxesSse2;
+            }
+#endif
+            break;
+
+        case AXIS_KERNEL_AVX2:
+#if JOYSTICK_HAVE_AVX2
+            if (GetCpuFeatures() & CPU_FEATURE_AVX2)
+            {
+                return ProcessAxesAvx2;
+            }
+#endif
+            break;
+
+        case AXIS_KERNEL_COUNT:
+            break;
+    }
+
+    return nullptr;
+}
+
+// =================================================================================================
+// GetBestAxisKernel
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+EAxisKernel GetBestAxisKernel()
+{
+    for (int kernel = AXIS_KERNEL_COUNT - 1; kernel > AXIS_KERNEL_SCALAR; kernel--)
+    {
+        if (GetAxisKernel((EAxisKernel)kernel) != nullptr)
+        {
+            return (EAxisKernel)kernel;
+        }
+    }
+    return AXIS_KERNEL_SCALAR;
+}
+
+// =================================================================================================
+// ProcessAxes              the kernel is chosen on the first call
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void ProcessAxes(const SAxisProcessor& processor, const SPadState* states, size_t count, SAxisOutput* outputs)
+{
+    static const PFN_AXIS_KERNEL kernel = GetAxisKernel(GetBestAxisKernel());
+    kernel(processor, states, count, outputs);
+}
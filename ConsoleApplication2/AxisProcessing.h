@@ -0,0 +1,112 @@
+// =================================================================================================
+// Axis post-processing: the raw stick and trigger values of a pad state turned into normalized
+// floats with deadzones, anti-deadzone, response curves and inversion, configured per device.
+// Scalar, SSE2 and AVX2 kernels compute the same result; the best one is picked at run time.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "PadState.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Lane of each axis, in SPadState order. Sticks come out in -1..1, triggers in 0..1.
+enum EAxis
+{
+	AXIS_LEFT_X,
+	AXIS_LEFT_Y,
+	AXIS_RIGHT_X,
+	AXIS_RIGHT_Y,
+	AXIS_L2,
+	AXIS_R2,
+	AXIS_COUNT
+};
+
+// Two unused lanes make a report one AVX register or two SSE registers
+const int AXIS_LANES = 8;
+
+// Points of each response curve lookup table, evenly spaced over the magnitude 0..1
+const int AXIS_CURVE_POINTS = 65;
+
+enum EDeadzoneShape
+{
+	DEADZONE_AXIAL,         // each axis on its own, a cross-shaped dead area
+	DEADZONE_RADIAL         // the stick's distance from center, a round dead area
+};
+
+enum EAxisKernel
+{
+	AXIS_KERNEL_SCALAR,
+	AXIS_KERNEL_SSE2,
+	AXIS_KERNEL_AVX2,
+	AXIS_KERNEL_COUNT
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SAxisSettings
+{
+	int32_t rawMin = 0;             // DS4 and DualSense report 0..255
+	int32_t rawMax = 255;
+	bool invert = false;
+	float deadzone = 0.0f;          // magnitudes up to this read as zero
+	float outerDeadzone = 1.0f;     // magnitudes from this on read as full
+	float antiDeadzone = 0.0f;      // smallest magnitude output past the deadzone, for games that add their own
+	float curveExponent = 1.0f;     // power curve used when curvePoints is empty
+	std::vector<float> curvePoints; // custom response, evenly spaced over 0..1, resampled to the table
+};
+
+// Per-device configuration; stick deadzones apply to the pair with radial shape
+struct SAxisConfig
+{
+	SAxisSettings axes[AXIS_COUNT];
+	EDeadzoneShape leftStick = DEADZONE_RADIAL;
+	EDeadzoneShape rightStick = DEADZONE_RADIAL;
+};
+
+// A configuration compiled for the kernels: one value per lane, every division done up front
+struct alignas(32) SAxisProcessor
+{
+	float offset[AXIS_LANES];       // center of a stick, rest position of a trigger
+	float scale[AXIS_LANES];        // 1 / half range or 1 / range, negative when inverted
+	float minimum[AXIS_LANES];      // -1 for sticks, 0 for triggers
+	float deadzone[AXIS_LANES];
+	float deadzoneScale[AXIS_LANES];        // 1 / (outer - inner)
+	float antiDeadzone[AXIS_LANES];
+	float antiDeadzoneScale[AXIS_LANES];    // 1 - anti-deadzone
+	uint32_t radialMask[AXIS_LANES];        // all ones on lanes of a radial stick
+	int32_t curveBase[AXIS_LANES];          // lane * AXIS_CURVE_POINTS, the gather offsets
+	float curve[AXIS_LANES * AXIS_CURVE_POINTS];
+};
+
+struct alignas(32) SAxisOutput
+{
+	float values[AXIS_LANES];       // indexed by EAxis, the unused lanes zero
+};
+
+// Processes count states into count outputs
+typedef void (*PFN_AXIS_KERNEL)(const SAxisProcessor& processor, const SPadState* states, size_t count, SAxisOutput* outputs);
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+void BuildAxisProcessor(const SAxisConfig& config, SAxisProcessor& processor);
+
+// nullptr when the build or the CPU lacks the instruction set
+PFN_AXIS_KERNEL GetAxisKernel(EAxisKernel kernel);
+EAxisKernel GetBestAxisKernel();
+
+// With the best kernel of the running CPU
+void ProcessAxes(const SAxisProcessor& processor, const SPadState* states, size_t count, SAxisOutput* outputs);
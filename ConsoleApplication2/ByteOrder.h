@@ -0,0 +1,107 @@
+// =================================================================================================
+// Little-endian loads and stores for the wire formats, byte by byte so they neither depend on the
+// host order nor on the alignment of the buffer.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include <cstring>
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// StoreLe16
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline void StoreLe16(unsigned char* bytes, uint16_t value)
+{
+	bytes[0] = (unsigned char)value;
+	bytes[1] = (unsigned char)(value >> 8);
+}
+
+// =================================================================================================
+// StoreLe32
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline void StoreLe32(unsigned char* bytes, uint32_t value)
+{
+	StoreLe16(bytes, (uint16_t)value);
+	StoreLe16(bytes + 2, (uint16_t)(value >> 16));
+}
+
+// =================================================================================================
+// StoreLe64
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline void StoreLe64(unsigned char* bytes, uint64_t value)
+{
+	StoreLe32(bytes, (uint32_t)value);
+	StoreLe32(bytes + 4, (uint32_t)(value >> 32));
+}
+
+// =================================================================================================
+// StoreLeFloat             IEEE 754 single, stored as its bit pattern
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline void StoreLeFloat(unsigned char* bytes, float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	StoreLe32(bytes, bits);
+}
+
+// =================================================================================================
+// LoadLe16
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline uint16_t LoadLe16(const unsigned char* bytes)
+{
+	return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+// =================================================================================================
+// LoadLe32
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline uint32_t LoadLe32(const unsigned char* bytes)
+{
+	return (uint32_t)LoadLe16(bytes) | ((uint32_t)LoadLe16(bytes + 2) << 16);
+}
+
+// =================================================================================================
+// LoadLe64
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline uint64_t LoadLe64(const unsigned char* bytes)
+{
+	return (uint64_t)LoadLe32(bytes) | ((uint64_t)LoadLe32(bytes + 4) << 32);
+}
+
+// =================================================================================================
+// LoadLeFloat
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline float LoadLeFloat(const unsigned char* bytes)
+{
+	uint32_t bits = LoadLe32(bytes);
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
@@ -0,0 +1,216 @@
+// =================================================================================================
+// Capture reader. Maps the whole capture into memory (mmap on Linux, a file mapping on Windows)
+// and walks its records in place, without copying report bytes.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CCaptureReader.h"
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CCaptureReader
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CCaptureReader::CCaptureReader() :
+    m_data(nullptr),
+    m_size(0),
+    m_offset(0),
+    m_header(),
+#ifdef _WIN32
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(NULL)
+#else
+    m_fd(-1)
+#endif
+{
+}
+
+// =================================================================================================
+// ~CCaptureReader
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CCaptureReader::~CCaptureReader()
+{
+    Close();
+}
+
+// =================================================================================================
+// Open                     map the file read-only and check its header
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CCaptureReader::Open(const char* path)
+{
+    if (m_data != nullptr || path == nullptr)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(SCaptureFileHeader))
+    {
+        Close();
+        return false;
+    }
+
+    m_mapping = CreateFileMapping(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mapping == NULL)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = (const unsigned char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    m_size = (size_t)fileSize.QuadPart;
+#else
+    m_fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(m_fd, &fileStat) != 0 || fileStat.st_size < (off_t)sizeof(SCaptureFileHeader))
+    {
+        Close();
+        return false;
+    }
+
+    void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data != MAP_FAILED)
+    {
+        // Replay walks the file front to back once
+        madvise(data, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+        m_data = (const unsigned char*)data;
+        m_size = (size_t)fileStat.st_size;
+    }
+#endif
+
+    if (m_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    if (std::memcmp(m_header.magic, CAPTURE_MAGIC, sizeof(m_header.magic)) != 0 ||
+        m_header.version != CAPTURE_VERSION ||
+        m_header.headerSize < sizeof(SCaptureFileHeader) || m_header.headerSize > m_size)
+    {
+        Close();
+        return false;
+    }
+
+    m_offset = m_header.headerSize;
+    return true;
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureReader::Close()
+{
+#ifdef _WIN32
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != NULL)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = NULL;
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_data != nullptr)
+    {
+        munmap((void*)m_data, m_size);
+    }
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_offset = 0;
+}
+
+// =================================================================================================
+// Next                     a truncated last record ends the capture like the end of the file
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CCaptureReader::Next(SCaptureRecordView& record)
+{
+    if (m_data == nullptr || m_size - m_offset < sizeof(SCaptureRecordHeader))
+    {
+        return false;
+    }
+
+    // Records are not aligned in the file
+    SCaptureRecordHeader header;
+    std::memcpy(&header, m_data + m_offset, sizeof(header));
+
+    size_t payloadOffset = m_offset + sizeof(header);
+    if (m_size - payloadOffset < header.length)
+    {
+        return false;
+    }
+
+    record.type = (ECaptureRecord)header.type;
+    record.deviceId = header.deviceId;
+    record.timestampNs = header.timestampNs;
+    record.payload = m_data + payloadOffset;
+    record.length = header.length;
+
+    m_offset = payloadOffset + header.length;
+    return true;
+}
+
+// =================================================================================================
+// Rewind
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureReader::Rewind()
+{
+    if (m_data != nullptr)
+    {
+        m_offset = m_header.headerSize;
+    }
+}
@@ -0,0 +1,54 @@
+// =================================================================================================
+// Capture reader. Maps the whole capture into memory (mmap on Linux, a file mapping on Windows)
+// and walks its records in place, without copying report bytes.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include "CaptureFormat.h"
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CCaptureReader
+{
+public:
+   CCaptureReader();
+   ~CCaptureReader();
+
+   CCaptureReader(const CCaptureReader&) = delete;
+   CCaptureReader& operator=(const CCaptureReader&) = delete;
+
+   // False when the file cannot be mapped or is not a capture of a known version
+   bool Open(const char* path);
+   void Close();
+
+   bool IsOpen() const { return m_data != nullptr; }
+   const SCaptureFileHeader& GetHeader() const { return m_header; }
+
+   // The next complete record; false at the end of the capture. The payload stays valid until
+   // Close.
+   bool Next(SCaptureRecordView& record);
+   void Rewind();
+
+private:
+   const unsigned char* m_data;
+   size_t m_size;
+   size_t m_offset;
+   SCaptureFileHeader m_header;
+#ifdef _WIN32
+   void* m_file;
+   void* m_mapping;
+#else
+   int m_fd;
+#endif
+};
@@ -0,0 +1,179 @@
+// =================================================================================================
+// Recording sink. Sits between a source and the core: everything the source reads is passed on
+// unchanged and also appended to a capture, raw report bytes as the device sent them.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CCaptureSink.h"
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CCaptureSink
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CCaptureSink::CCaptureSink(IInputSink* target) :
+    m_target(target),
+    m_devices(),
+    m_nextDeviceId(1)
+{
+}
+
+// =================================================================================================
+// Open
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CCaptureSink::Open(const char* path)
+{
+    return m_writer.Open(path);
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureSink::Close()
+{
+    m_writer.Close();
+}
+
+// =================================================================================================
+// IsDeviceAttached
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CCaptureSink::IsDeviceAttached(void* deviceKey)
+{
+    return m_target->IsDeviceAttached(deviceKey);
+}
+
+// =================================================================================================
+// OnDeviceArrived          devices the core turns away are not recorded either
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CCaptureSink::OnDeviceArrived(void* deviceKey, uint32_t identity, SHidDeviceDescriptor&& descriptor)
+{
+    SCaptureDevice device;
+    device.vendorId = (uint16_t)descriptor.vendorId;
+    device.productId = (uint16_t)descriptor.productId;
+    device.identity = identity;
+    device.descriptorHash = HashDeviceDescriptor(descriptor);
+
+    int playerIndex = m_target->OnDeviceArrived(deviceKey, identity, std::move(descriptor));
+    if (playerIndex == INVALID_PLAYER_INDEX)
+    {
+        return playerIndex;
+    }
+
+    for (SCapturedDevice& captured : m_devices)
+    {
+        if (captured.deviceKey == nullptr)
+        {
+            captured.deviceKey = deviceKey;
+            captured.deviceId = m_nextDeviceId++;
+            m_writer.WriteDeviceArrived(captured.deviceId, MonotonicNowNs(), device);
+            break;
+        }
+    }
+    return playerIndex;
+}
+
+// =================================================================================================
+// OnDeviceRemoved
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureSink::OnDeviceRemoved(void* deviceKey)
+{
+    m_target->OnDeviceRemoved(deviceKey);
+
+    for (SCapturedDevice& captured : m_devices)
+    {
+        if (captured.deviceKey == deviceKey)
+        {
+            m_writer.WriteDeviceRemoved(captured.deviceId, MonotonicNowNs());
+            captured.deviceKey = nullptr;
+            break;
+        }
+    }
+}
+
+// =================================================================================================
+// OnReport                 recorded whether or not it decodes, so decoder fixes can be replayed
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CCaptureSink::OnReport(void* deviceKey, const unsigned char* report, size_t length, uint64_t timestampNs)
+{
+    uint32_t deviceId = FindDeviceId(deviceKey);
+    if (deviceId != 0)
+    {
+        m_writer.WriteReport(deviceId, timestampNs, report, length);
+    }
+    return m_target->OnReport(deviceKey, report, length, timestampNs);
+}
+
+// =================================================================================================
+// OnState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CCaptureSink::OnState(void* deviceKey, const JSDATA& state, uint64_t timestampNs)
+{
+    uint32_t deviceId = FindDeviceId(deviceKey);
+    if (deviceId != 0)
+    {
+        m_writer.WriteState(deviceId, timestampNs, state);
+    }
+    return m_target->OnState(deviceKey, state, timestampNs);
+}
+
+// =================================================================================================
+// OnBatchEnd
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureSink::OnBatchEnd()
+{
+    m_target->OnBatchEnd();
+    m_writer.FlushIfDue(MonotonicNowNs());
+}
+
+// =================================================================================================
+// OnInputError             not recorded, a replay has no device to fail
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureSink::OnInputError(void* deviceKey, EInputError error, int osError)
+{
+    m_target->OnInputError(deviceKey, error, osError);
+}
+
+// =================================================================================================
+// FindDeviceId
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint32_t CCaptureSink::FindDeviceId(void* deviceKey) const
+{
+    for (const SCapturedDevice& captured : m_devices)
+    {
+        if (captured.deviceKey == deviceKey)
+        {
+            return captured.deviceId;
+        }
+    }
+    return 0;
+}
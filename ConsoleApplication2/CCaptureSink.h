@@ -0,0 +1,58 @@
+// =================================================================================================
+// Recording sink. Sits between a source and the core: everything the source reads is passed on
+// unchanged and also appended to a capture, raw report bytes as the device sent them.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include "IInputSource.h"
+#include "CCaptureWriter.h"
+#include "CDeviceRegistry.h"
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CCaptureSink : public IInputSink
+{
+public:
+   explicit CCaptureSink(IInputSink* target);
+
+   // Recording starts with the devices that arrive after this call
+   bool Open(const char* path);
+   void Close();
+
+   const CCaptureWriter& GetWriter() const { return m_writer; }
+
+   // IInputSink, called from the input thread only
+   bool IsDeviceAttached(void* deviceKey) override;
+   int OnDeviceArrived(void* deviceKey, uint32_t identity, SHidDeviceDescriptor&& descriptor) override;
+   void OnDeviceRemoved(void* deviceKey) override;
+   bool OnReport(void* deviceKey, const unsigned char* report, size_t length, uint64_t timestampNs) override;
+   bool OnState(void* deviceKey, const JSDATA& state, uint64_t timestampNs) override;
+   void OnBatchEnd() override;
+   void OnInputError(void* deviceKey, EInputError error, int osError) override;
+
+private:
+   struct SCapturedDevice
+   {
+      void* deviceKey;
+      uint32_t deviceId;
+   };
+
+   // Capture device id of a key, 0 when it is not recorded
+   uint32_t FindDeviceId(void* deviceKey) const;
+
+
+   IInputSink* m_target;
+   CCaptureWriter m_writer;
+   SCapturedDevice m_devices[MAX_CONTROLLERS];
+   uint32_t m_nextDeviceId;
+};
@@ -0,0 +1,291 @@
+// =================================================================================================
+// Capture writer. The input thread appends records to an in-memory buffer; full buffers are
+// written to the file by a thread of their own, so the input path never waits for the disk.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CCaptureWriter.h"
+#include <cstring>
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CCaptureWriter
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CCaptureWriter::CCaptureWriter() :
+    m_file(nullptr),
+    m_stopRequested(false),
+    m_current(-1),
+    m_currentFirstNs(0),
+    m_droppedRecords(0),
+    m_writeFailed(false)
+{
+}
+
+// =================================================================================================
+// ~CCaptureWriter
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CCaptureWriter::~CCaptureWriter()
+{
+    Close();
+}
+
+// =================================================================================================
+// Open                     the buffers are allocated here, recording itself never allocates
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CCaptureWriter::Open(const char* path)
+{
+    if (m_file != nullptr || path == nullptr)
+    {
+        return false;
+    }
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    SCaptureFileHeader header = {};
+    std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+    header.version = CAPTURE_VERSION;
+    header.headerSize = sizeof(SCaptureFileHeader);
+    header.startNs = MonotonicNowNs();
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1)
+    {
+        std::fclose(file);
+        return false;
+    }
+
+    m_buffers.assign(CAPTURE_BUFFER_COUNT, std::vector<unsigned char>());
+    m_freeBuffers.clear();
+    m_pendingBuffers.clear();
+    m_freeBuffers.reserve(CAPTURE_BUFFER_COUNT);
+    m_pendingBuffers.reserve(CAPTURE_BUFFER_COUNT);
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT; i++)
+    {
+        m_buffers[i].reserve(CAPTURE_BUFFER_SIZE);
+        m_freeBuffers.push_back(i);
+    }
+
+    m_current = m_freeBuffers.back();
+    m_freeBuffers.pop_back();
+    m_currentFirstNs = 0;
+    m_droppedRecords.store(0, std::memory_order_relaxed);
+    m_writeFailed.store(false, std::memory_order_relaxed);
+    m_stopRequested = false;
+
+    m_file = file;
+    m_thread = std::thread(&CCaptureWriter::Run, this);
+    return true;
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::Close()
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    SubmitCurrent();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_pendingReady.notify_one();
+    m_thread.join();
+
+    std::fclose(m_file);
+    m_file = nullptr;
+    m_current = -1;
+}
+
+// =================================================================================================
+// WriteDeviceArrived
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::WriteDeviceArrived(uint32_t deviceId, uint64_t timestampNs, const SCaptureDevice& device)
+{
+    AppendRecord(CAPTURE_RECORD_DEVICE_ARRIVED, deviceId, timestampNs, &device, sizeof(device));
+}
+
+// =================================================================================================
+// WriteDeviceRemoved
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::WriteDeviceRemoved(uint32_t deviceId, uint64_t timestampNs)
+{
+    AppendRecord(CAPTURE_RECORD_DEVICE_REMOVED, deviceId, timestampNs, nullptr, 0);
+}
+
+// =================================================================================================
+// WriteReport
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::WriteReport(uint32_t deviceId, uint64_t timestampNs, const unsigned char* report, size_t length)
+{
+    AppendRecord(CAPTURE_RECORD_REPORT, deviceId, timestampNs, report, length);
+}
+
+// =================================================================================================
+// WriteState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::WriteState(uint32_t deviceId, uint64_t timestampNs, const JSDATA& jsData)
+{
+    SCaptureState state;
+    PackCaptureState(jsData, state);
+    AppendRecord(CAPTURE_RECORD_STATE, deviceId, timestampNs, &state, sizeof(state));
+}
+
+// =================================================================================================
+// FlushIfDue
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::FlushIfDue(uint64_t nowNs)
+{
+    if (m_current >= 0 && !m_buffers[m_current].empty() && nowNs - m_currentFirstNs >= CAPTURE_FLUSH_INTERVAL_NS)
+    {
+        SubmitCurrent();
+    }
+}
+
+// =================================================================================================
+// AppendRecord             record header and payload into the current buffer, a full buffer goes
+//                          to the writer thread first
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::AppendRecord(ECaptureRecord type, uint32_t deviceId, uint64_t timestampNs, const void* payload, size_t length)
+{
+    if (m_file == nullptr || length > UINT16_MAX)
+    {
+        return;
+    }
+
+    size_t recordSize = sizeof(SCaptureRecordHeader) + length;
+    if (m_current >= 0 && m_buffers[m_current].size() + recordSize > CAPTURE_BUFFER_SIZE)
+    {
+        SubmitCurrent();
+    }
+    if (m_current < 0)
+    {
+        // The disk is behind by every buffer; losing records beats stalling the input thread
+        SubmitCurrent();
+        if (m_current < 0)
+        {
+            m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    std::vector<unsigned char>& buffer = m_buffers[m_current];
+    if (buffer.empty())
+    {
+        m_currentFirstNs = MonotonicNowNs();
+    }
+
+    SCaptureRecordHeader header;
+    header.type = (uint8_t)type;
+    header.reserved = 0;
+    header.length = (uint16_t)length;
+    header.deviceId = deviceId;
+    header.timestampNs = timestampNs;
+
+    const unsigned char* headerBytes = (const unsigned char*)&header;
+    buffer.insert(buffer.end(), headerBytes, headerBytes + sizeof(header));
+    if (length > 0)
+    {
+        const unsigned char* payloadBytes = (const unsigned char*)payload;
+        buffer.insert(buffer.end(), payloadBytes, payloadBytes + length);
+    }
+}
+
+// =================================================================================================
+// SubmitCurrent            queue the current buffer for writing and take a free one, if any
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::SubmitCurrent()
+{
+    bool submitted = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_current >= 0 && !m_buffers[m_current].empty())
+        {
+            m_pendingBuffers.push_back(m_current);
+            m_current = -1;
+            submitted = true;
+        }
+        if (m_current < 0 && !m_freeBuffers.empty())
+        {
+            m_current = m_freeBuffers.back();
+            m_freeBuffers.pop_back();
+        }
+    }
+
+    if (submitted)
+    {
+        m_pendingReady.notify_one();
+    }
+}
+
+// =================================================================================================
+// Run                      writer thread: write pending buffers in order until Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CCaptureWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_pendingReady.wait(lock, [this] { return m_stopRequested || !m_pendingBuffers.empty(); });
+        if (m_pendingBuffers.empty())
+        {
+            break;
+        }
+
+        int index = m_pendingBuffers.front();
+        m_pendingBuffers.erase(m_pendingBuffers.begin());
+        lock.unlock();
+
+        std::vector<unsigned char>& buffer = m_buffers[index];
+        if (!m_writeFailed.load(std::memory_order_relaxed) &&
+            std::fwrite(buffer.data(), 1, buffer.size(), m_file) != buffer.size())
+        {
+            m_writeFailed.store(true, std::memory_order_relaxed);
+        }
+        buffer.clear();
+
+        lock.lock();
+        m_freeBuffers.push_back(index);
+    }
+
+    lock.unlock();
+    std::fflush(m_file);
+}
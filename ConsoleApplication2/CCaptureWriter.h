@@ -0,0 +1,85 @@
+// =================================================================================================
+// Capture writer. The input thread appends records to an in-memory buffer; full buffers are
+// written to the file by a thread of their own, so the input path never waits for the disk.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CaptureFormat.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const size_t CAPTURE_BUFFER_SIZE = 256 * 1024;
+const int CAPTURE_BUFFER_COUNT = 4;                         // one filling, the rest with the writer
+
+// A partly filled buffer is handed over once its first record is this old, so an idle pad still
+// reaches the disk
+const uint64_t CAPTURE_FLUSH_INTERVAL_NS = 250000000ull;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CCaptureWriter
+{
+public:
+   CCaptureWriter();
+   ~CCaptureWriter();
+
+   // Creates the file, writes its header and starts the writer thread
+   bool Open(const char* path);
+
+   // Hands over what is buffered, waits for the writer thread to write it and closes the file
+   void Close();
+
+   bool IsOpen() const { return m_file != nullptr; }
+
+   // Input thread only. A record that finds every buffer with the writer is dropped and counted.
+   void WriteDeviceArrived(uint32_t deviceId, uint64_t timestampNs, const SCaptureDevice& device);
+   void WriteDeviceRemoved(uint32_t deviceId, uint64_t timestampNs);
+   void WriteReport(uint32_t deviceId, uint64_t timestampNs, const unsigned char* report, size_t length);
+   void WriteState(uint32_t deviceId, uint64_t timestampNs, const JSDATA& jsData);
+
+   // Input thread only, hands over the current buffer when it has waited long enough
+   void FlushIfDue(uint64_t nowNs);
+
+   uint64_t GetDroppedRecords() const { return m_droppedRecords.load(std::memory_order_relaxed); }
+
+   // False once a write to the file failed; later buffers are discarded
+   bool IsHealthy() const { return !m_writeFailed.load(std::memory_order_relaxed); }
+
+private:
+   void AppendRecord(ECaptureRecord type, uint32_t deviceId, uint64_t timestampNs, const void* payload, size_t length);
+   void SubmitCurrent();
+   void Run();
+
+
+   std::FILE* m_file;
+   std::thread m_thread;
+   std::mutex m_mutex;                 // guards the queues and m_stopRequested
+   std::condition_variable m_pendingReady;
+   std::vector<std::vector<unsigned char>> m_buffers;
+   std::vector<int> m_freeBuffers;
+   std::vector<int> m_pendingBuffers;  // oldest first
+   bool m_stopRequested;
+
+   int m_current;                      // buffer being filled, -1 while every buffer is pending
+   uint64_t m_currentFirstNs;
+   std::atomic<uint64_t> m_droppedRecords;
+   std::atomic<bool> m_writeFailed;
+};
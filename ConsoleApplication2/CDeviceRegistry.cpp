@@ -0,0 +1,245 @@
+// =================================================================================================
+// Registry of the connected controllers. Each device owns a fixed slot whose index is its player
+// index; report handles are resolved to slots through a small open-addressing table.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CDeviceRegistry.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CDeviceRegistry
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CDeviceRegistry::CDeviceRegistry() :
+    m_connectedCount(0)
+{
+    for (int i = 0; i < TABLE_SIZE; i++)
+    {
+        m_table[i].handle = nullptr;
+        m_table[i].slot = INVALID_PLAYER_INDEX;
+    }
+}
+
+// =================================================================================================
+// Attach                   a device that is already attached keeps its slot
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CDeviceRegistry::Attach(void* handle, uint32_t identity)
+{
+    SDeviceSlot* existing = Find(handle);
+    if (existing != nullptr)
+    {
+        return PlayerIndexOf(existing);
+    }
+
+    int slotIndex = ChooseSlot(identity);
+    if (slotIndex == INVALID_PLAYER_INDEX)
+    {
+        return INVALID_PLAYER_INDEX;
+    }
+
+    SDeviceSlot& slot = m_slots[slotIndex];
+    slot.handle = handle;
+    slot.identity = identity;
+    slot.connected = true;
+    slot.used = true;
+    slot.descriptor = SHidDeviceDescriptor();
+    slot.state = JSDATA();
+
+    InsertHandle(handle, slotIndex);
+    m_connectedCount++;
+
+    return slotIndex;
+}
+
+// =================================================================================================
+// Detach
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CDeviceRegistry::Detach(void* handle)
+{
+    SDeviceSlot* slot = Find(handle);
+    if (slot == nullptr)
+    {
+        return;
+    }
+
+    RemoveHandle(handle);
+    slot->handle = nullptr;
+    slot->connected = false;
+    m_connectedCount--;
+}
+
+// =================================================================================================
+// Find                     the hot-path lookup: one hash and a short probe, no allocation
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+SDeviceSlot* CDeviceRegistry::Find(void* handle)
+{
+    if (handle == nullptr)
+    {
+        return nullptr;
+    }
+
+    for (int i = HashHandle(handle); m_table[i].handle != nullptr; i = (i + 1) & (TABLE_SIZE - 1))
+    {
+        if (m_table[i].handle == handle)
+        {
+            return &m_slots[m_table[i].slot];
+        }
+    }
+
+    return nullptr;
+}
+
+// =================================================================================================
+// GetSlot
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+SDeviceSlot* CDeviceRegistry::GetSlot(int playerIndex)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return nullptr;
+    }
+
+    return &m_slots[playerIndex];
+}
+
+// =================================================================================================
+// PlayerIndexOf
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CDeviceRegistry::PlayerIndexOf(const SDeviceSlot* slot) const
+{
+    if (slot < m_slots || slot >= m_slots + MAX_CONTROLLERS)
+    {
+        return INVALID_PLAYER_INDEX;
+    }
+
+    return (int)(slot - m_slots);
+}
+
+// =================================================================================================
+// ConnectedCount
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CDeviceRegistry::ConnectedCount() const
+{
+    return m_connectedCount;
+}
+
+// =================================================================================================
+// HashHandle
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CDeviceRegistry::HashHandle(void* handle)
+{
+    uint64_t key = (uint64_t)(uintptr_t)handle;
+    key *= 0x9E3779B97F4A7C15ull;
+    return (int)(key >> 32) & (TABLE_SIZE - 1);
+}
+
+// =================================================================================================
+// ChooseSlot               prefer the slot this device had before, then a never used one, then any
+//                          free one
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CDeviceRegistry::ChooseSlot(uint32_t identity) const
+{
+    int neverUsed = INVALID_PLAYER_INDEX;
+    int anyFree = INVALID_PLAYER_INDEX;
+
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        const SDeviceSlot& slot = m_slots[i];
+        if (slot.connected)
+        {
+            continue;
+        }
+
+        if (slot.used && slot.identity == identity)
+        {
+            return i;
+        }
+        if (!slot.used && neverUsed == INVALID_PLAYER_INDEX)
+        {
+            neverUsed = i;
+        }
+        if (anyFree == INVALID_PLAYER_INDEX)
+        {
+            anyFree = i;
+        }
+    }
+
+    return neverUsed != INVALID_PLAYER_INDEX ? neverUsed : anyFree;
+}
+
+// =================================================================================================
+// InsertHandle
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CDeviceRegistry::InsertHandle(void* handle, int slot)
+{
+    int i = HashHandle(handle);
+    while (m_table[i].handle != nullptr)
+    {
+        i = (i + 1) & (TABLE_SIZE - 1);
+    }
+
+    m_table[i].handle = handle;
+    m_table[i].slot = slot;
+}
+
+// =================================================================================================
+// RemoveHandle             backward-shift deletion keeps probe chains intact without tombstones
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CDeviceRegistry::RemoveHandle(void* handle)
+{
+    int i = HashHandle(handle);
+    while (m_table[i].handle != handle)
+    {
+        if (m_table[i].handle == nullptr)
+        {
+            return;
+        }
+        i = (i + 1) & (TABLE_SIZE - 1);
+    }
+
+    int hole = i;
+    for (int j = (hole + 1) & (TABLE_SIZE - 1); m_table[j].handle != nullptr; j = (j + 1) & (TABLE_SIZE - 1))
+    {
+        // Move the entry back when its home position is not between the hole and its current place
+        int home = HashHandle(m_table[j].handle);
+        bool homeInRange = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+        if (!homeInRange)
+        {
+            m_table[hole] = m_table[j];
+            hole = j;
+        }
+    }
+
+    m_table[hole].handle = nullptr;
+    m_table[hole].slot = INVALID_PLAYER_INDEX;
+}
@@ -0,0 +1,88 @@
+// =================================================================================================
+// Registry of the connected controllers. Each device owns a fixed slot whose index is its player
+// index; report handles are resolved to slots through a small open-addressing table.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include "JSData.h"
+#include "HidDescriptor.h"
+#include "PadState.h"
+#include "Ds4Motion.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int MAX_CONTROLLERS = 8;
+const int INVALID_PLAYER_INDEX = -1;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SDeviceSlot
+{
+	void* handle = nullptr;
+	uint32_t identity = 0;          // hash of the device path, survives unplug/replug
+	bool connected = false;
+	bool used = false;              // the player index stays reserved for the same identity
+	SHidDeviceDescriptor descriptor;
+	JSDATA state;
+	SPadState padState;
+	SImuCalibration imuCalibration;
+	CSensorClock sensorClock;
+};
+
+class IDeviceRegistry
+{
+public:
+   virtual ~IDeviceRegistry() {}
+
+   // Player index of the device, INVALID_PLAYER_INDEX when all slots are taken
+   virtual int Attach(void* handle, uint32_t identity) = 0;
+   virtual void Detach(void* handle) = 0;
+
+   virtual SDeviceSlot* Find(void* handle) = 0;
+   virtual SDeviceSlot* GetSlot(int playerIndex) = 0;
+   virtual int PlayerIndexOf(const SDeviceSlot* slot) const = 0;
+   virtual int ConnectedCount() const = 0;
+};
+
+class CDeviceRegistry : public IDeviceRegistry
+{
+public:
+   CDeviceRegistry();
+
+   int Attach(void* handle, uint32_t identity) override;
+   void Detach(void* handle) override;
+
+   SDeviceSlot* Find(void* handle) override;
+   SDeviceSlot* GetSlot(int playerIndex) override;
+   int PlayerIndexOf(const SDeviceSlot* slot) const override;
+   int ConnectedCount() const override;
+
+private:
+   static const int TABLE_SIZE = 4 * MAX_CONTROLLERS;    // power of two, kept at most 25% full
+
+   struct SHandleEntry
+   {
+      void* handle;
+      int slot;
+   };
+
+   static int HashHandle(void* handle);
+   int ChooseSlot(uint32_t identity) const;
+   void InsertHandle(void* handle, int slot);
+   void RemoveHandle(void* handle);
+
+   SDeviceSlot m_slots[MAX_CONTROLLERS];
+   SHandleEntry m_table[TABLE_SIZE];
+   int m_connectedCount;
+};
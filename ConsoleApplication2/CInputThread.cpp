@@ -0,0 +1,178 @@
+// =================================================================================================
+// Dedicated input thread. Creates, opens, polls and closes an IInputSource entirely on its own
+// thread, so the source's OS objects (message-only window, epoll set) belong to that thread.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CInputThread.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+#ifndef _WIN32
+// Above ordinary SCHED_FIFO work, well below the kernel's own threads
+const int INPUT_THREAD_FIFO_PRIORITY = 10;
+#endif
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CInputThread
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CInputThread::CInputThread() :
+    m_stopRequested(false),
+    m_startState(START_PENDING),
+    m_source(nullptr)
+{
+}
+
+// =================================================================================================
+// ~CInputThread
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CInputThread::~CInputThread()
+{
+    Stop();
+}
+
+// =================================================================================================
+// Start
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CInputThread::Start(SourceFactory createSource, IInputSink* sink, EInputThreadPriority priority)
+{
+    if (m_thread.joinable() || !createSource || sink == nullptr)
+    {
+        return false;
+    }
+
+    m_stopRequested.store(false, std::memory_order_relaxed);
+    m_startState = START_PENDING;
+    m_thread = std::thread(&CInputThread::Run, this, createSource, sink, priority);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_started.wait(lock, [this] { return m_startState != START_PENDING; });
+    bool succeeded = m_startState == START_SUCCEEDED;
+    lock.unlock();
+
+    if (!succeeded)
+    {
+        m_thread.join();
+    }
+    return succeeded;
+}
+
+// =================================================================================================
+// Stop
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CInputThread::Stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    m_stopRequested.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_source != nullptr)
+        {
+            m_source->Wake();
+        }
+    }
+
+    m_thread.join();
+}
+
+// =================================================================================================
+// IsRunning
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CInputThread::IsRunning() const
+{
+    return m_thread.joinable() && !m_stopRequested.load(std::memory_order_acquire);
+}
+
+// =================================================================================================
+// Run                      thread body: open, poll until Stop or a fatal source error, close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CInputThread::Run(SourceFactory createSource, IInputSink* sink, EInputThreadPriority priority)
+{
+    ApplyPriority(priority);
+
+    std::unique_ptr<IInputSource> source = createSource();
+    bool opened = source && source->Open(sink);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_source = opened ? source.get() : nullptr;
+        m_startState = opened ? START_SUCCEEDED : START_FAILED;
+    }
+    m_started.notify_one();
+
+    if (!opened)
+    {
+        return;
+    }
+
+    while (!m_stopRequested.load(std::memory_order_acquire))
+    {
+        if (source->Poll(-1) < 0)
+        {
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_source = nullptr;
+    }
+
+    // Closed and destroyed here, the OS objects must go away on the thread that created them
+    source->Close();
+    source.reset();
+    m_stopRequested.store(true, std::memory_order_release);
+}
+
+// =================================================================================================
+// ApplyPriority            best effort, the thread keeps the default priority when not permitted
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CInputThread::ApplyPriority(EInputThreadPriority priority)
+{
+    if (priority != INPUT_THREAD_HIGH)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+#else
+    sched_param param = {};
+    param.sched_priority = INPUT_THREAD_FIFO_PRIORITY;
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+#endif
+}
@@ -0,0 +1,70 @@
+// =================================================================================================
+// Dedicated input thread. Creates, opens, polls and closes an IInputSource entirely on its own
+// thread, so the source's OS objects (message-only window, epoll set) belong to that thread.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "IInputSource.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+enum EInputThreadPriority
+{
+	INPUT_THREAD_NORMAL,
+	INPUT_THREAD_HIGH       // THREAD_PRIORITY_HIGHEST on Windows, SCHED_FIFO on Linux when permitted
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CInputThread
+{
+public:
+   typedef std::function<std::unique_ptr<IInputSource>()> SourceFactory;
+
+   CInputThread();
+   ~CInputThread();
+
+   // Runs createSource and Open(sink) on the new thread and returns once both are done.
+   // False, with no thread left running, when either fails.
+   bool Start(SourceFactory createSource, IInputSink* sink, EInputThreadPriority priority = INPUT_THREAD_NORMAL);
+
+   // Wakes the source, waits for the thread to close it and exit. Safe to call when not running.
+   void Stop();
+
+   bool IsRunning() const;
+
+private:
+   enum EStartState
+   {
+      START_PENDING,
+      START_SUCCEEDED,
+      START_FAILED
+   };
+
+   void Run(SourceFactory createSource, IInputSink* sink, EInputThreadPriority priority);
+   static void ApplyPriority(EInputThreadPriority priority);
+
+
+   std::thread m_thread;
+   std::atomic<bool> m_stopRequested;
+   std::mutex m_mutex;                 // guards m_source and m_startState
+   std::condition_variable m_started;
+   EStartState m_startState;
+   IInputSource* m_source;             // only while the thread is polling it
+};
@@ -0,0 +1,847 @@
+// =================================================================================================
+// Portable joystick core: device registry, report decoding, latest-state publishing and sample
+// delivery. It is fed by an IInputSource and has no platform code of its own.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CJoystickCore.h"
+#include "ReportDecoders.h"
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CJoystickCore
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CJoystickCore::CJoystickCore() :
+    m_sequence(0),
+    m_batched(false),
+    m_batchDelivery(BATCH_DELIVER_ALL),
+    m_connectedCount(0),
+    m_lastPlayerIndex(0)
+{
+}
+
+// =================================================================================================
+// IsDeviceAttached
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::IsDeviceAttached(void* deviceKey)
+{
+    return m_registry.Find(deviceKey) != nullptr;
+}
+
+// =================================================================================================
+// OnDeviceArrived          attach the device, pick the layout decoder of its VID/PID and take the
+//                          IMU calibration the source read, or the nominal one
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CJoystickCore::OnDeviceArrived(void* deviceKey, uint32_t identity, SHidDeviceDescriptor&& descriptor)
+{
+    int playerIndex = m_registry.Attach(deviceKey, identity);
+    if (playerIndex == INVALID_PLAYER_INDEX)
+    {
+        JOYSTICK_STATS(m_stats.OnRejectedDevice());
+        return INVALID_PLAYER_INDEX;
+    }
+
+    SDeviceSlot* pSlot = m_registry.GetSlot(playerIndex);
+    pSlot->descriptor = std::move(descriptor);
+    pSlot->descriptor.decoder = SelectReportDecoder(pSlot->descriptor.vendorId, pSlot->descriptor.productId);
+
+    // The wireless dongle passes the Bluetooth feature report through over USB
+    const std::vector<unsigned char>& calibration = pSlot->descriptor.calibrationReport;
+    bool bluetoothOrder = (!calibration.empty() && calibration[0] == DS4_CALIBRATION_BT_REPORT_ID) ||
+                          pSlot->descriptor.productId == DS4_PRODUCT_ID_DONGLE;
+    if (!ParseDs4Calibration(calibration.data(), calibration.size(), bluetoothOrder, pSlot->imuCalibration))
+    {
+        SetDefaultImuCalibration(pSlot->imuCalibration);
+    }
+    pSlot->padState = SPadState();
+    pSlot->sensorClock.Reset();
+    if (m_filters)
+    {
+        m_filters->Reset(playerIndex);
+    }
+    if (m_events)
+    {
+        m_events->Reset(playerIndex);
+    }
+    if (m_combos)
+    {
+        m_combos->Reset(playerIndex);
+    }
+    if (m_sharedState)
+    {
+        m_sharedState->PublishDevice(playerIndex, pSlot->descriptor.vendorId, pSlot->descriptor.productId, true);
+    }
+    if (m_stateServer)
+    {
+        m_stateServer->SubmitDevice(playerIndex, true);
+    }
+    if (m_outputs[playerIndex] && pSlot->descriptor.output && pSlot->descriptor.decoder == DECODER_DS4)
+    {
+        m_outputs[playerIndex]->Attach(pSlot->descriptor.output, pSlot->descriptor.bluetooth,
+                                       pSlot->descriptor.bluetooth ? m_outputConfig.minIntervalBluetoothUs : m_outputConfig.minIntervalUsbUs);
+    }
+
+    m_connectedCount.store(m_registry.ConnectedCount(), std::memory_order_relaxed);
+    return playerIndex;
+}
+
+// =================================================================================================
+// OnDeviceRemoved
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::OnDeviceRemoved(void* deviceKey)
+{
+    SDeviceSlot* pSlot = m_registry.Find(deviceKey);
+    if (pSlot != nullptr && m_sharedState)
+    {
+        m_sharedState->PublishDevice(m_registry.PlayerIndexOf(pSlot), pSlot->descriptor.vendorId, pSlot->descriptor.productId, false);
+    }
+    if (pSlot != nullptr && m_stateServer)
+    {
+        m_stateServer->SubmitDevice(m_registry.PlayerIndexOf(pSlot), false);
+    }
+    if (pSlot != nullptr)
+    {
+        // Stops the writer before the output handle of the device is closed
+        std::unique_ptr<CPadOutputWriter>& output = m_outputs[m_registry.PlayerIndexOf(pSlot)];
+        if (output)
+        {
+            output->Detach();
+        }
+        pSlot->descriptor.output.reset();
+    }
+
+    m_registry.Detach(deviceKey);
+    m_connectedCount.store(m_registry.ConnectedCount(), std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// OnReport                 known layouts are read straight from the report, anything else goes
+//                          through the platform parser of the device. Known layouts also fill the
+//                          pad state with every button, motion and touch. A report of a known ID
+//                          the layout refuses (short, bad CRC) is dropped, never handed to the
+//                          parser instead.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::OnReport(void* deviceKey, const unsigned char* report, size_t length, uint64_t timestampNs)
+{
+    SDeviceSlot* pSlot = m_registry.Find(deviceKey);
+    if (pSlot == nullptr)
+    {
+        JOYSTICK_STATS(m_stats.OnUnknownDevice());
+        return false;
+    }
+    if (report == nullptr || length == 0)
+    {
+        return false;
+    }
+
+    SHidDeviceDescriptor& descriptor = pSlot->descriptor;
+
+    PFN_REPORT_DECODER decodeReport = GetReportDecoder(descriptor.decoder, report[0]);
+    bool decoded = false;
+    if (decodeReport != nullptr)
+    {
+        decoded = decodeReport(report, length, pSlot->state);
+    }
+    else if (descriptor.genericDecoder != nullptr)
+    {
+        decoded = descriptor.genericDecoder(descriptor, report, length, pSlot->state);
+    }
+
+    JOYSTICK_STATS(m_stats.OnReport(m_registry.PlayerIndexOf(pSlot), decoded));
+    if (!decoded)
+    {
+        return false;
+    }
+
+    PFN_PAD_STATE_DECODER decodePadState = GetPadStateDecoder(descriptor.decoder, report[0]);
+    if (decodePadState == nullptr || !decodePadState(report, length, pSlot->padState))
+    {
+        PadStateFromJsData(pSlot->state, pSlot->padState);
+        pSlot->padState.flags = 0;
+    }
+
+    EmitSample(pSlot, timestampNs);
+    return true;
+}
+
+// =================================================================================================
+// OnState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::OnState(void* deviceKey, const JSDATA& state, uint64_t timestampNs)
+{
+    SDeviceSlot* pSlot = m_registry.Find(deviceKey);
+    if (pSlot == nullptr)
+    {
+        JOYSTICK_STATS(m_stats.OnUnknownDevice());
+        return false;
+    }
+
+    JOYSTICK_STATS(m_stats.OnReport(m_registry.PlayerIndexOf(pSlot), true));
+    pSlot->state = state;
+    PadStateFromJsData(state, pSlot->padState);
+    pSlot->padState.flags = 0;
+    EmitSample(pSlot, timestampNs);
+    return true;
+}
+
+// =================================================================================================
+// OnBatchEnd
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::OnBatchEnd()
+{
+    if (m_filters)
+    {
+        RunFilterPass();
+    }
+    if (m_batched)
+    {
+        FlushBatch();
+    }
+}
+
+// =================================================================================================
+// OnInputError             counted only; the source carries on with its other devices
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::OnInputError(void* deviceKey, EInputError error, int osError)
+{
+    (void)deviceKey;
+    (void)error;
+    (void)osError;
+    JOYSTICK_STATS(m_stats.OnInputError(error, osError));
+}
+
+// =================================================================================================
+// EmitSample               stamp the current state of a slot and deliver or collect it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::EmitSample(SDeviceSlot* pSlot, uint64_t timestampNs)
+{
+    SJoystickSample sample;
+    sample.timestampNs = timestampNs;
+    sample.sequence = m_sequence++;
+    sample.playerIndex = m_registry.PlayerIndexOf(pSlot);
+    sample.data = pSlot->state;
+
+    PublishPadState(pSlot, sample);
+
+    if (m_batched)
+    {
+        m_batchSamples.push_back(sample);
+    }
+    else
+    {
+        DeliverSample(sample);
+    }
+
+    m_lastPlayerIndex.store(sample.playerIndex, std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// PublishPadState          the pad state of a sample, its normalized axes when the player has an
+//                          axis configuration or filtering is on, its motion in physical units
+//                          when the report carried any, both queued for the filter pass, and the
+//                          state handed to the state server
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::PublishPadState(SDeviceSlot* pSlot, const SJoystickSample& sample)
+{
+    SPadState& padState = pSlot->padState;
+    padState.timestampNs = sample.timestampNs;
+    padState.sequence = (uint32_t)sample.sequence;
+    padState.playerIndex = (uint8_t)sample.playerIndex;
+    m_latestPadState[sample.playerIndex].Publish(padState);
+    if (m_events)
+    {
+        m_events->Process(sample.playerIndex, padState);
+    }
+    if (m_combos)
+    {
+        m_combos->Process(sample.playerIndex, padState);
+    }
+    if (m_sharedState)
+    {
+        m_sharedState->PublishPadState(sample.playerIndex, padState);
+    }
+
+    const SAxisProcessor* pAxisProcessor = m_axisProcessors[sample.playerIndex].get();
+    if (pAxisProcessor == nullptr)
+    {
+        pAxisProcessor = m_defaultAxisProcessor.get();
+    }
+
+    SAxisOutput axes = SAxisOutput();
+    if (pAxisProcessor != nullptr)
+    {
+        ProcessAxes(*pAxisProcessor, &padState, 1, &axes);
+        m_latestAxes[sample.playerIndex].Publish(axes);
+    }
+
+    SMotionSample motion = SMotionSample();
+    if ((padState.flags & PAD_FLAG_MOTION) != 0)
+    {
+        uint64_t deltaTicks = 0;
+        uint64_t ticks = pSlot->sensorClock.Unwrap(padState.sensorTimestamp, sample.timestampNs, deltaTicks);
+
+        motion.timestampNs = sample.timestampNs;
+        motion.sensorTimeNs = CSensorClock::TicksToNs(ticks);
+        motion.dtSeconds = (float)CSensorClock::TicksToNs(deltaTicks) * 1e-9f;
+        motion.playerIndex = sample.playerIndex;
+        ConvertPadMotion(pSlot->imuCalibration, padState, motion);
+
+        m_latestMotion[sample.playerIndex].Publish(motion);
+        if (m_motionCallback)
+        {
+            m_motionCallback(sample.playerIndex, motion);
+        }
+        if (m_sharedState)
+        {
+            m_sharedState->PublishMotion(sample.playerIndex, motion);
+        }
+    }
+    if (m_stateServer)
+    {
+        bool hasMotion = (padState.flags & PAD_FLAG_MOTION) != 0;
+        m_stateServer->SubmitState(sample.playerIndex, padState, hasMotion ? &motion : nullptr);
+    }
+
+    if (m_filters)
+    {
+        float values[FILTER_CHANNELS];
+        for (int axis = 0; axis < AXIS_COUNT; axis++)
+        {
+            values[FILTER_LEFT_X + axis] = axes.values[axis];
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            values[FILTER_GYRO_PITCH + i] = motion.gyroDps[i];
+            values[FILTER_ACCEL_X + i] = motion.accelG[i];
+        }
+
+        // A second report of the pad in one wakeup is filtered on its own, not merged, unless it
+        // carries the same timestamp: a batched read stamps its reports alike, and a zero step
+        // would read every change as a velocity spike. Then the newer one replaces the queued one.
+        if (m_filters->IsPending(sample.playerIndex) && m_filters->GetLastTimestamp(sample.playerIndex) != sample.timestampNs)
+        {
+            RunFilterPass();
+        }
+        m_filters->Submit(sample.playerIndex, values, sample.timestampNs);
+    }
+}
+
+// =================================================================================================
+// RunFilterPass            filter every queued report and publish the pads that had one
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::RunFilterPass()
+{
+    unsigned int updated = m_filters->Update();
+    for (int playerIndex = 0; updated != 0; playerIndex++, updated >>= 1)
+    {
+        if (updated & 1)
+        {
+            SFilteredState state;
+            m_filters->GetState(playerIndex, state);
+            m_latestFiltered[playerIndex].Publish(state);
+        }
+    }
+}
+
+// =================================================================================================
+// DeliverSample            publish one sample to the latest-state seqlock, the queue and the callback
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::DeliverSample(const SJoystickSample& sample)
+{
+    m_latestState[sample.playerIndex].Publish(sample);
+    if (m_sampleQueue && !m_sampleQueue->Push(sample))
+    {
+        JOYSTICK_STATS(m_stats.OnQueueDrop(sample.playerIndex));
+    }
+
+#if JOYSTICK_ENABLE_STATS
+    if (m_stats.OnDelivered(sample.playerIndex))
+    {
+        uint64_t nowNs = MonotonicNowNs();
+        m_stats.RecordLatency(sample.playerIndex, nowNs > sample.timestampNs ? nowNs - sample.timestampNs : 0);
+    }
+#endif
+
+    if (m_callback)
+    {
+        m_callback(sample.playerIndex, sample.data);
+    }
+}
+
+// =================================================================================================
+// FlushBatch               deliver the samples collected during one wakeup
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::FlushBatch()
+{
+    if (m_batchSamples.empty())
+    {
+        return;
+    }
+
+    // Keep only the newest sample of every player, in their original order
+    if (m_batchDelivery == BATCH_DELIVER_LATEST)
+    {
+        unsigned int seenPlayers = 0;
+        size_t kept = m_batchSamples.size();
+        for (size_t i = m_batchSamples.size(); i-- > 0;)
+        {
+            unsigned int playerBit = 1u << m_batchSamples[i].playerIndex;
+            if ((seenPlayers & playerBit) == 0)
+            {
+                seenPlayers |= playerBit;
+                m_batchSamples[--kept] = m_batchSamples[i];
+            }
+            else
+            {
+                JOYSTICK_STATS(m_stats.OnCoalesced(m_batchSamples[i].playerIndex));
+            }
+        }
+        m_batchSamples.erase(m_batchSamples.begin(), m_batchSamples.begin() + kept);
+    }
+
+    for (const SJoystickSample& sample : m_batchSamples)
+    {
+        DeliverSample(sample);
+    }
+
+    if (m_batchCallback)
+    {
+        m_batchCallback(m_batchSamples.data(), m_batchSamples.size());
+    }
+
+    m_batchSamples.clear();
+}
+
+// =================================================================================================
+// SetCallback              called with the player index of every delivered sample
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::SetCallback(std::function<void(int, JSDATA)> callback)
+{
+    m_callback = callback;
+}
+
+// =================================================================================================
+// EnableSampleQueue        must be called before input starts flowing
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::EnableSampleQueue(size_t capacity, ERingOverflowPolicy policy)
+{
+    m_sampleQueue.reset(new CSpscRing<SJoystickSample>(capacity, policy));
+}
+
+// =================================================================================================
+// EnableBatchedDelivery    collect the samples of a wakeup and deliver them on OnBatchEnd.
+//                          batchCallback (optional) receives the delivered samples of each wakeup.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::EnableBatchedDelivery(EBatchDelivery delivery, std::function<void(const SJoystickSample*, size_t)> batchCallback)
+{
+    m_batched = true;
+    m_batchDelivery = delivery;
+    m_batchCallback = batchCallback;
+    m_batchSamples.reserve(CORE_BATCH_RESERVE);
+}
+
+// =================================================================================================
+// SetMotionCallback
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::SetMotionCallback(std::function<void(int, const SMotionSample&)> motionCallback)
+{
+    m_motionCallback = motionCallback;
+}
+
+// =================================================================================================
+// SetAxisConfig            before input starts flowing, like the rest of the configuration
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::SetAxisConfig(int playerIndex, const SAxisConfig& config)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return;
+    }
+
+    if (!m_axisProcessors[playerIndex])
+    {
+        m_axisProcessors[playerIndex].reset(new SAxisProcessor);
+    }
+    BuildAxisProcessor(config, *m_axisProcessors[playerIndex]);
+}
+
+// =================================================================================================
+// EnableFiltering          filters the axes of players without an axis configuration as plain
+//                          normalized values
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::EnableFiltering(const SFilterConfig& config)
+{
+    if (!m_filters)
+    {
+        m_filters.reset(new CInputFilterBank);
+    }
+    m_filters->Configure(config);
+
+    if (!m_defaultAxisProcessor)
+    {
+        m_defaultAxisProcessor.reset(new SAxisProcessor);
+        BuildAxisProcessor(SAxisConfig(), *m_defaultAxisProcessor);
+    }
+}
+
+// =================================================================================================
+// SubscribeEvents
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::SubscribeEvents(const SPadEventSubscription& subscription)
+{
+    if (!m_events)
+    {
+        m_events.reset(new CPadEventDispatcher);
+    }
+    m_events->Subscribe(subscription);
+}
+
+// =================================================================================================
+// EnableCombos
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::EnableCombos(const std::vector<SComboDefinition>& combos, std::function<void(const SComboEvent*, size_t)> callback)
+{
+    std::unique_ptr<CPadComboEngine> engine(new CPadComboEngine);
+    if (!engine->Compile(combos))
+    {
+        return false;
+    }
+    engine->SetCallback(callback);
+    m_combos = std::move(engine);
+    return true;
+}
+
+// =================================================================================================
+// SetEventAxisThreshold    raw steps, PAD_EVENT_DEFAULT_AXIS_THRESHOLD until set
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::SetEventAxisThreshold(EAxis axis, uint16_t threshold)
+{
+    if (!m_events)
+    {
+        m_events.reset(new CPadEventDispatcher);
+    }
+    m_events->SetAxisThreshold(axis, threshold);
+}
+
+// =================================================================================================
+// EnableSharedState        before input starts flowing, like the rest of the configuration
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::EnableSharedState(const char* name)
+{
+    std::unique_ptr<CSharedStatePublisher> publisher(new CSharedStatePublisher);
+    if (!publisher->Open(name))
+    {
+        return false;
+    }
+    m_sharedState = std::move(publisher);
+    return true;
+}
+
+// =================================================================================================
+// EnableStateServer        before input starts flowing; the server starts right away and streams
+//                          whatever arrives from then on
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::EnableStateServer(const SStateServerConfig& config)
+{
+    std::unique_ptr<CStateServer> server(new CStateServer);
+    if (!server->Start(config))
+    {
+        return false;
+    }
+    m_stateServer = std::move(server);
+    return true;
+}
+
+// =================================================================================================
+// EnableOutput
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickCore::EnableOutput(const SPadOutputConfig& config)
+{
+    m_outputConfig = config;
+    for (int playerIndex = 0; playerIndex < MAX_CONTROLLERS; ++playerIndex)
+    {
+        if (!m_outputs[playerIndex])
+        {
+            m_outputs[playerIndex].reset(new CPadOutputWriter);
+        }
+    }
+}
+
+// =================================================================================================
+// SetRumble
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::SetRumble(int playerIndex, uint8_t strongMotor, uint8_t weakMotor)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS || !m_outputs[playerIndex])
+    {
+        return false;
+    }
+
+    SPadOutput output = {};
+    output.strongMotor = strongMotor;
+    output.weakMotor = weakMotor;
+    return m_outputs[playerIndex]->Submit(output, PAD_OUTPUT_RUMBLE);
+}
+
+// =================================================================================================
+// SetLightbar
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::SetLightbar(int playerIndex, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS || !m_outputs[playerIndex])
+    {
+        return false;
+    }
+
+    SPadOutput output = {};
+    output.red = red;
+    output.green = green;
+    output.blue = blue;
+    return m_outputs[playerIndex]->Submit(output, PAD_OUTPUT_LIGHTBAR);
+}
+
+// =================================================================================================
+// SetLightbarFlash
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::SetLightbarFlash(int playerIndex, unsigned int onMs, unsigned int offMs)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS || !m_outputs[playerIndex])
+    {
+        return false;
+    }
+
+    SPadOutput output = {};
+    output.flashOn = Ds4FlashSteps(onMs);
+    output.flashOff = Ds4FlashSteps(offMs);
+    return m_outputs[playerIndex]->Submit(output, PAD_OUTPUT_FLASH);
+}
+
+// =================================================================================================
+// GetOutputCounters
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::GetOutputCounters(int playerIndex, SPadOutputCounters& counters) const
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS || !m_outputs[playerIndex])
+    {
+        return false;
+    }
+
+    counters = m_outputs[playerIndex]->GetCounters();
+    return true;
+}
+
+// =================================================================================================
+// GetSampleQueue           nullptr until EnableSampleQueue was called
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CSpscRing<SJoystickSample>* CJoystickCore::GetSampleQueue()
+{
+    return m_sampleQueue.get();
+}
+
+// =================================================================================================
+// GetStateServer
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+const CStateServer* CJoystickCore::GetStateServer() const
+{
+    return m_stateServer.get();
+}
+
+// =================================================================================================
+// GetLatestState           false until the player reported for the first time
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::GetLatestState(int playerIndex, SJoystickSample& sample, uint64_t* version) const
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return false;
+    }
+
+    return m_latestState[playerIndex].Read(sample, version);
+}
+
+// =================================================================================================
+// GetLatestPadState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::GetLatestPadState(int playerIndex, SPadState& state, uint64_t* version) const
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return false;
+    }
+
+    return m_latestPadState[playerIndex].Read(state, version);
+}
+
+// =================================================================================================
+// GetLatestMotion          false until the player sent a report with motion
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::GetLatestMotion(int playerIndex, SMotionSample& motion, uint64_t* version) const
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return false;
+    }
+
+    return m_latestMotion[playerIndex].Read(motion, version);
+}
+
+// =================================================================================================
+// GetLatestAxes            false until the player reported with an axis configuration or filtering on
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::GetLatestAxes(int playerIndex, SAxisOutput& axes, uint64_t* version) const
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return false;
+    }
+
+    return m_latestAxes[playerIndex].Read(axes, version);
+}
+
+// =================================================================================================
+// GetFilteredState         false until the player reported with filtering on
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::GetFilteredState(int playerIndex, SFilteredState& state, uint64_t* version) const
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return false;
+    }
+
+    return m_latestFiltered[playerIndex].Read(state, version);
+}
+
+// =================================================================================================
+// GetPredictedState        the filtered state extrapolated to the time the consumer samples, e.g.
+//                          the next frame's display time
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::GetPredictedState(int playerIndex, uint64_t targetNs, float* values) const
+{
+    SFilteredState state;
+    if (!m_filters || !GetFilteredState(playerIndex, state))
+    {
+        return false;
+    }
+
+    m_filters->Predict(state, targetNs, values);
+    return true;
+}
+
+// =================================================================================================
+// GetConnectedCount
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CJoystickCore::GetConnectedCount() const
+{
+    return m_connectedCount.load(std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// GetLastPlayerIndex       player of the most recent sample
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CJoystickCore::GetLastPlayerIndex() const
+{
+    return m_lastPlayerIndex.load(std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// GetStatsSnapshot
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CJoystickCore::GetStatsSnapshot(SJoystickStatsSnapshot& snapshot) const
+{
+#if JOYSTICK_ENABLE_STATS
+    m_stats.Snapshot(snapshot);
+    return true;
+#else
+    (void)snapshot;
+    return false;
+#endif
+}
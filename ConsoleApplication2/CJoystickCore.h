@@ -0,0 +1,153 @@
+// =================================================================================================
+// Portable joystick core: device registry, report decoding, latest-state publishing and sample
+// delivery. It is fed by an IInputSource and has no platform code of its own.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "JSData.h"
+#include "IInputSource.h"
+#include "CDeviceRegistry.h"
+#include "CSpscRing.h"
+#include "CSeqLock.h"
+#include "CJoystickStats.h"
+#include "PadState.h"
+#include "Ds4Motion.h"
+#include "AxisProcessing.h"
+#include "InputFilters.h"
+#include "PadEvents.h"
+#include "PadCombos.h"
+#include "CSharedStatePublisher.h"
+#include "CStateServer.h"
+#include "CPadOutputWriter.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+enum EBatchDelivery
+{
+	BATCH_DELIVER_ALL,      // every report of a wakeup, in arrival order
+	BATCH_DELIVER_LATEST    // only the final state of each player per wakeup
+};
+
+// Samples the batch buffer is reserved for, it grows only past this
+const size_t CORE_BATCH_RESERVE = 64 * MAX_CONTROLLERS;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CJoystickCore : public IInputSink
+{
+public:
+   CJoystickCore();
+
+   // IInputSink, called from the input thread only
+   bool IsDeviceAttached(void* deviceKey) override;
+   int OnDeviceArrived(void* deviceKey, uint32_t identity, SHidDeviceDescriptor&& descriptor) override;
+   void OnDeviceRemoved(void* deviceKey) override;
+   bool OnReport(void* deviceKey, const unsigned char* report, size_t length, uint64_t timestampNs) override;
+   bool OnState(void* deviceKey, const JSDATA& state, uint64_t timestampNs) override;
+   void OnBatchEnd() override;
+   void OnInputError(void* deviceKey, EInputError error, int osError) override;
+
+   // Configuration, before input starts flowing
+   void SetCallback(std::function<void(int, JSDATA)> callback);
+   void EnableSampleQueue(size_t capacity, ERingOverflowPolicy policy);
+   void EnableBatchedDelivery(EBatchDelivery delivery, std::function<void(const SJoystickSample*, size_t)> batchCallback);
+   // Called on the input thread for every report that carries motion, batched or not
+   void SetMotionCallback(std::function<void(int, const SMotionSample&)> motionCallback);
+   // Turns on the normalized axes of one player; without a configuration they are not computed
+   void SetAxisConfig(int playerIndex, const SAxisConfig& config);
+   // Filters the normalized axes and the IMU of every player once per wakeup
+   void EnableFiltering(const SFilterConfig& config);
+   // Change-driven events, raised on the input thread as each report is decoded
+   void SubscribeEvents(const SPadEventSubscription& subscription);
+   void SetEventAxisThreshold(EAxis axis, uint16_t threshold);
+   // Chords, sequences and tap/hold gestures recognised on the input thread as each report is
+   // decoded, every connected pad against every combo; false when a definition is refused
+   bool EnableCombos(const std::vector<SComboDefinition>& combos, std::function<void(const SComboEvent*, size_t)> callback);
+   // Publishes devices, pad state and motion of every player to other processes through a named
+   // shared-memory region (CSharedStateReader); false when the region cannot be created
+   bool EnableSharedState(const char* name = SHARED_STATE_DEFAULT_NAME);
+   // Streams devices and pad state of every player over UDP (DSU and the compact delta protocol)
+   // from a thread of its own; false when a socket cannot be bound
+   bool EnableStateServer(const SStateServerConfig& config);
+   // Gives every player a writer thread for rumble and lightbar, started as a DualShock 4 arrives
+   // with an output handle from its source
+   void EnableOutput(const SPadOutputConfig& config);
+   bool IsBatched() const { return m_batched; }
+
+   // Consumers, any thread
+   CSpscRing<SJoystickSample>* GetSampleQueue();
+   // Ports and counters; nullptr until EnableStateServer succeeded
+   const CStateServer* GetStateServer() const;
+   // Output, never waits on the device; false while the player has no output writer attached
+   bool SetRumble(int playerIndex, uint8_t strongMotor, uint8_t weakMotor);
+   bool SetLightbar(int playerIndex, uint8_t red, uint8_t green, uint8_t blue);
+   // Both 0 for a steady light
+   bool SetLightbarFlash(int playerIndex, unsigned int onMs, unsigned int offMs);
+   bool GetOutputCounters(int playerIndex, SPadOutputCounters& counters) const;
+   bool GetLatestState(int playerIndex, SJoystickSample& sample, uint64_t* version = nullptr) const;
+   // Published as each report is decoded, ahead of a batch; false until the first report
+   bool GetLatestPadState(int playerIndex, SPadState& state, uint64_t* version = nullptr) const;
+   bool GetLatestMotion(int playerIndex, SMotionSample& motion, uint64_t* version = nullptr) const;
+   bool GetLatestAxes(int playerIndex, SAxisOutput& axes, uint64_t* version = nullptr) const;
+   bool GetFilteredState(int playerIndex, SFilteredState& state, uint64_t* version = nullptr) const;
+   // values receives FILTER_CHANNELS floats
+   bool GetPredictedState(int playerIndex, uint64_t targetNs, float* values) const;
+   int GetConnectedCount() const;
+   int GetLastPlayerIndex() const;
+
+   // False when the core was built without JOYSTICK_ENABLE_STATS
+   bool GetStatsSnapshot(SJoystickStatsSnapshot& snapshot) const;
+
+private:
+   void EmitSample(SDeviceSlot* pSlot, uint64_t timestampNs);
+   void PublishPadState(SDeviceSlot* pSlot, const SJoystickSample& sample);
+   void RunFilterPass();
+   void DeliverSample(const SJoystickSample& sample);
+   void FlushBatch();
+
+
+   CDeviceRegistry m_registry;
+   std::function<void(int, JSDATA)> m_callback;
+   std::unique_ptr<CSpscRing<SJoystickSample>> m_sampleQueue;
+   uint64_t m_sequence;
+   CSeqLock<SJoystickSample> m_latestState[MAX_CONTROLLERS];
+   CSeqLock<SPadState> m_latestPadState[MAX_CONTROLLERS];
+   CSeqLock<SMotionSample> m_latestMotion[MAX_CONTROLLERS];
+   std::function<void(int, const SMotionSample&)> m_motionCallback;
+   std::unique_ptr<SAxisProcessor> m_axisProcessors[MAX_CONTROLLERS];
+   CSeqLock<SAxisOutput> m_latestAxes[MAX_CONTROLLERS];
+   std::unique_ptr<SAxisProcessor> m_defaultAxisProcessor;
+   std::unique_ptr<CInputFilterBank> m_filters;
+   CSeqLock<SFilteredState> m_latestFiltered[MAX_CONTROLLERS];
+   std::unique_ptr<CPadEventDispatcher> m_events;
+   std::unique_ptr<CPadComboEngine> m_combos;
+   std::unique_ptr<CSharedStatePublisher> m_sharedState;
+   std::unique_ptr<CStateServer> m_stateServer;
+   SPadOutputConfig m_outputConfig;
+   std::unique_ptr<CPadOutputWriter> m_outputs[MAX_CONTROLLERS];
+   bool m_batched;
+   EBatchDelivery m_batchDelivery;
+   std::function<void(const SJoystickSample*, size_t)> m_batchCallback;
+   std::vector<SJoystickSample> m_batchSamples;
+   std::atomic<int> m_connectedCount;
+   std::atomic<int> m_lastPlayerIndex;
+#if JOYSTICK_ENABLE_STATS
+   CJoystickStats m_stats;
+#endif
+};
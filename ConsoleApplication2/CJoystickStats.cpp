@@ -0,0 +1,225 @@
+// =================================================================================================
+// Live statistics of the input path: per-player report counters and sampled input-to-callback
+// latency histograms, written by the input thread without locks and copied out by any thread.
+// Building with JOYSTICK_ENABLE_STATS=0 takes every update out of the core.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CJoystickStats.h"
+#include <chrono>
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CJoystickStats
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CJoystickStats::CJoystickStats() :
+    m_lastOsError(0),
+    m_unknownDeviceReports(0),
+    m_rejectedDevices(0)
+{
+    for (SDeviceCounters& device : m_devices)
+    {
+        device.reports.store(0, std::memory_order_relaxed);
+        device.decodeFailures.store(0, std::memory_order_relaxed);
+        device.delivered.store(0, std::memory_order_relaxed);
+        device.coalesced.store(0, std::memory_order_relaxed);
+        device.queueDrops.store(0, std::memory_order_relaxed);
+    }
+    for (std::atomic<uint64_t>& errors : m_inputErrors)
+    {
+        errors.store(0, std::memory_order_relaxed);
+    }
+}
+
+// =================================================================================================
+// OnInputError
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickStats::OnInputError(EInputError error, int osError)
+{
+    if (error < 0 || error >= INPUT_ERROR_COUNT)
+    {
+        return;
+    }
+    Bump(m_inputErrors[error]);
+    m_lastOsError.store(osError, std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// Snapshot
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CJoystickStats::Snapshot(SJoystickStatsSnapshot& snapshot) const
+{
+    snapshot.timestampNs = MonotonicNowNs();
+
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        const SDeviceCounters& device = m_devices[i];
+        SDeviceStats& stats = snapshot.devices[i];
+        stats.reports = device.reports.load(std::memory_order_relaxed);
+        stats.decodeFailures = device.decodeFailures.load(std::memory_order_relaxed);
+        stats.delivered = device.delivered.load(std::memory_order_relaxed);
+        stats.coalesced = device.coalesced.load(std::memory_order_relaxed);
+        stats.queueDrops = device.queueDrops.load(std::memory_order_relaxed);
+        device.latency.Snapshot(stats.latency);
+    }
+
+    for (int i = 0; i < INPUT_ERROR_COUNT; i++)
+    {
+        snapshot.inputErrors[i] = m_inputErrors[i].load(std::memory_order_relaxed);
+    }
+    snapshot.lastOsError = m_lastOsError.load(std::memory_order_relaxed);
+    snapshot.unknownDeviceReports = m_unknownDeviceReports.load(std::memory_order_relaxed);
+    snapshot.rejectedDevices = m_rejectedDevices.load(std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// SummarizeStats           rates and percentiles of what happened between two snapshots
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void SummarizeStats(const SJoystickStatsSnapshot& previous, const SJoystickStatsSnapshot& current, int playerIndex, SStatsSummary& summary)
+{
+    const SDeviceStats& before = previous.devices[playerIndex];
+    const SDeviceStats& after = current.devices[playerIndex];
+
+    double seconds = (double)(current.timestampNs - previous.timestampNs) / 1e9;
+    summary.reportsPerSecond = seconds > 0.0 ? (double)(after.reports - before.reports) / seconds : 0.0;
+    summary.decodeFailures = after.decodeFailures - before.decodeFailures;
+    summary.coalesced = after.coalesced - before.coalesced;
+    summary.queueDrops = after.queueDrops - before.queueDrops;
+
+    // Large, and only needed for the moment
+    std::unique_ptr<SHistogramSnapshot> interval(new SHistogramSnapshot);
+    SubtractHistogram(after.latency, before.latency, *interval);
+    summary.latencySamples = interval->total;
+    summary.latencyP50Us = HistogramPercentile(*interval, 0.50) / 1000.0;
+    summary.latencyP99Us = HistogramPercentile(*interval, 0.99) / 1000.0;
+    summary.latencyP999Us = HistogramPercentile(*interval, 0.999) / 1000.0;
+}
+
+// =================================================================================================
+// CStatsDump
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CStatsDump::CStatsDump() :
+    m_stopRequested(false)
+{
+}
+
+// =================================================================================================
+// ~CStatsDump
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CStatsDump::~CStatsDump()
+{
+    Stop();
+}
+
+// =================================================================================================
+// Start                    false as well when takeSnapshot has nothing to give
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CStatsDump::Start(SnapshotFunction takeSnapshot, unsigned int intervalMs, std::FILE* out)
+{
+    if (m_thread.joinable() || !takeSnapshot || intervalMs == 0 || out == nullptr)
+    {
+        return false;
+    }
+
+    m_previous.reset(new SJoystickStatsSnapshot);
+    if (!takeSnapshot(*m_previous))
+    {
+        m_previous.reset();
+        return false;
+    }
+
+    m_stopRequested = false;
+    m_thread = std::thread(&CStatsDump::Run, this, takeSnapshot, intervalMs, out);
+    return true;
+}
+
+// =================================================================================================
+// Stop
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStatsDump::Stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_stopCondition.notify_one();
+    m_thread.join();
+}
+
+// =================================================================================================
+// Run                      dump thread: one line per player that reported during the interval
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStatsDump::Run(SnapshotFunction takeSnapshot, unsigned int intervalMs, std::FILE* out)
+{
+    std::unique_ptr<SJoystickStatsSnapshot> previous(std::move(m_previous));
+    std::unique_ptr<SJoystickStatsSnapshot> current(new SJoystickStatsSnapshot);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopCondition.wait_for(lock, std::chrono::milliseconds(intervalMs), [this] { return m_stopRequested; }))
+    {
+        lock.unlock();
+        takeSnapshot(*current);
+
+        for (int player = 0; player < MAX_CONTROLLERS; player++)
+        {
+            if (current->devices[player].reports == previous->devices[player].reports)
+            {
+                continue;
+            }
+
+            SStatsSummary summary;
+            SummarizeStats(*previous, *current, player, summary);
+            std::fprintf(out, "stats P%d %.1f reports/s, %llu decode failures, %llu coalesced, %llu queue drops, "
+                "latency p50 %.1f us p99 %.1f us p99.9 %.1f us (%llu samples)\n",
+                player + 1, summary.reportsPerSecond, (unsigned long long)summary.decodeFailures,
+                (unsigned long long)summary.coalesced, (unsigned long long)summary.queueDrops,
+                summary.latencyP50Us, summary.latencyP99Us, summary.latencyP999Us,
+                (unsigned long long)summary.latencySamples);
+        }
+
+        for (int error = 0; error < INPUT_ERROR_COUNT; error++)
+        {
+            if (current->inputErrors[error] != previous->inputErrors[error])
+            {
+                std::fprintf(out, "stats input error %d: %llu more, last OS error %d\n", error,
+                    (unsigned long long)(current->inputErrors[error] - previous->inputErrors[error]), current->lastOsError);
+            }
+        }
+        std::fflush(out);
+
+        previous.swap(current);
+        lock.lock();
+    }
+}
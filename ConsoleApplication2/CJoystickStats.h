@@ -0,0 +1,171 @@
+// =================================================================================================
+// Live statistics of the input path: per-player report counters and sampled input-to-callback
+// latency histograms, written by the input thread without locks and copied out by any thread.
+// Building with JOYSTICK_ENABLE_STATS=0 takes every update out of the core.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "CDeviceRegistry.h"
+#include "CSpscRing.h"
+#include "IInputSource.h"
+#include "LatencyHistogram.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+#ifndef JOYSTICK_ENABLE_STATS
+#define JOYSTICK_ENABLE_STATS 1
+#endif
+
+// Wraps every statistics update on the hot path so the switch removes the code, not just the data
+#if JOYSTICK_ENABLE_STATS
+#define JOYSTICK_STATS(statement) statement
+#else
+#define JOYSTICK_STATS(statement)
+#endif
+
+// Every Nth delivered sample of a player is timed; reading the clock on each one would cost more
+// than the rest of the bookkeeping together. Power of two.
+const uint64_t STATS_LATENCY_SAMPLE_INTERVAL = 64;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SDeviceStats
+{
+	uint64_t reports;           // handed to the core for this player
+	uint64_t decodeFailures;    // matched neither the layout nor the generic decoder
+	uint64_t delivered;         // published to the latest state, queue and callback
+	uint64_t coalesced;         // replaced by a newer sample of the same wakeup (BATCH_DELIVER_LATEST)
+	uint64_t queueDrops;        // rejected by a full sample queue (RING_COUNT_DROPS)
+	SHistogramSnapshot latency; // report timestamp to callback, in ns
+};
+
+// About 66 KB, keep it off the stack of small threads
+struct SJoystickStatsSnapshot
+{
+	uint64_t timestampNs;
+	SDeviceStats devices[MAX_CONTROLLERS];
+	uint64_t inputErrors[INPUT_ERROR_COUNT];
+	int lastOsError;
+	uint64_t unknownDeviceReports;  // from a device the core never attached
+	uint64_t rejectedDevices;       // arrived while every player slot was taken
+};
+
+// Activity of one player between two snapshots
+struct SStatsSummary
+{
+	double reportsPerSecond;
+	uint64_t decodeFailures;
+	uint64_t coalesced;
+	uint64_t queueDrops;
+	uint64_t latencySamples;
+	double latencyP50Us;
+	double latencyP99Us;
+	double latencyP999Us;
+};
+
+class CJoystickStats
+{
+public:
+   CJoystickStats();
+
+   // Input thread only
+   void OnReport(int playerIndex, bool decoded)
+   {
+      SDeviceCounters& device = m_devices[playerIndex];
+      Bump(device.reports);
+      if (!decoded)
+      {
+         Bump(device.decodeFailures);
+      }
+   }
+
+   // True when this delivery is one of the timed ones
+   bool OnDelivered(int playerIndex)
+   {
+      SDeviceCounters& device = m_devices[playerIndex];
+      uint64_t delivered = device.delivered.load(std::memory_order_relaxed);
+      device.delivered.store(delivered + 1, std::memory_order_relaxed);
+      return (delivered & (STATS_LATENCY_SAMPLE_INTERVAL - 1)) == 0;
+   }
+
+   void RecordLatency(int playerIndex, uint64_t latencyNs) { m_devices[playerIndex].latency.Record(latencyNs); }
+   void OnCoalesced(int playerIndex) { Bump(m_devices[playerIndex].coalesced); }
+   void OnQueueDrop(int playerIndex) { Bump(m_devices[playerIndex].queueDrops); }
+   void OnUnknownDevice() { Bump(m_unknownDeviceReports); }
+   void OnRejectedDevice() { Bump(m_rejectedDevices); }
+   void OnInputError(EInputError error, int osError);
+
+   // Any thread
+   void Snapshot(SJoystickStatsSnapshot& snapshot) const;
+
+private:
+   struct alignas(CACHE_LINE_SIZE) SDeviceCounters
+   {
+      std::atomic<uint64_t> reports;
+      std::atomic<uint64_t> decodeFailures;
+      std::atomic<uint64_t> delivered;
+      std::atomic<uint64_t> coalesced;
+      std::atomic<uint64_t> queueDrops;
+      CLatencyHistogram latency;
+   };
+
+   // Single writer, so a plain load and store is enough
+   static void Bump(std::atomic<uint64_t>& counter)
+   {
+      counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+   }
+
+
+   SDeviceCounters m_devices[MAX_CONTROLLERS];
+   std::atomic<uint64_t> m_inputErrors[INPUT_ERROR_COUNT];
+   std::atomic<int> m_lastOsError;
+   std::atomic<uint64_t> m_unknownDeviceReports;
+   std::atomic<uint64_t> m_rejectedDevices;
+};
+
+// Writes a line per active player every interval, from a thread of its own
+class CStatsDump
+{
+public:
+   typedef std::function<bool(SJoystickStatsSnapshot&)> SnapshotFunction;
+
+   CStatsDump();
+   ~CStatsDump();
+
+   bool Start(SnapshotFunction takeSnapshot, unsigned int intervalMs, std::FILE* out = stderr);
+   void Stop();
+
+private:
+   void Run(SnapshotFunction takeSnapshot, unsigned int intervalMs, std::FILE* out);
+
+
+   std::unique_ptr<SJoystickStatsSnapshot> m_previous;   // first snapshot, handed to the thread
+   std::thread m_thread;
+   std::mutex m_mutex;
+   std::condition_variable m_stopCondition;
+   bool m_stopRequested;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+void SummarizeStats(const SJoystickStatsSnapshot& previous, const SJoystickStatsSnapshot& current, int playerIndex, SStatsSummary& summary);
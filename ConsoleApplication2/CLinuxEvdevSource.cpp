@@ -0,0 +1,564 @@
+// =================================================================================================
+// Linux evdev backend, the fallback when hidraw is not accessible. The kernel driver has already
+// decoded the pad, so complete JSDATA states are handed to the core on every SYN_REPORT.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CLinuxEvdevSource.h"
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include "CDeviceRegistry.h"
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int EVDEV_EPOLL_EVENTS = 16;
+const char EVDEV_DEVICE_DIR[] = "/dev/input";
+const char EVDEV_NAME_PREFIX[] = "event";
+
+// D-pad as a DS4 hat value (0 = up, clockwise, 8 = released), indexed [hatY + 1][hatX + 1]
+const int EVDEV_HAT_FROM_AXES[3][3] =
+{
+    { 7, 0, 1 },
+    { 6, 8, 2 },
+    { 5, 4, 3 }
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// HashDeviceName           FNV-1a hash of the physical path, the same pad keeps it across replugs
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t HashDeviceName(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    for (; *name != 0; name++)
+    {
+        hash = (hash ^ (unsigned char)*name) * 16777619u;
+    }
+    return hash;
+}
+
+// =================================================================================================
+// IsEventName
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool IsEventName(const char* name)
+{
+    return std::strncmp(name, EVDEV_NAME_PREFIX, sizeof(EVDEV_NAME_PREFIX) - 1) == 0;
+}
+
+// =================================================================================================
+// TestBit                  bit of an EVIOCGBIT bitmap
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool TestBit(const unsigned char* bits, int bit)
+{
+    return (bits[bit / 8] >> (bit % 8)) & 1;
+}
+
+// =================================================================================================
+// MapEvdevButton           HandlePressed index of a key code, in the order of the DS4 HID buttons
+//                          (hid-playstation / hid-sony mapping); -1 when it has no slot
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int MapEvdevButton(int code)
+{
+    switch (code)
+    {
+        case BTN_WEST:      return 0;   // square
+        case BTN_SOUTH:     return 1;   // cross
+        case BTN_EAST:      return 2;   // circle
+        case BTN_NORTH:     return 3;   // triangle
+        case BTN_TL:        return 4;   // L1
+        case BTN_TR:        return 5;   // R1
+        case BTN_TL2:       return 6;   // L2
+        case BTN_TR2:       return 7;   // R2
+        case BTN_SELECT:    return 8;   // share / create
+        case BTN_START:     return 9;   // options
+        case BTN_THUMBL:    return 10;  // L3
+        case BTN_THUMBR:    return 11;  // R3
+        default:            return -1;
+    }
+}
+
+// =================================================================================================
+// MapEvdevAxis
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static EJsField MapEvdevAxis(int code)
+{
+    switch (code)
+    {
+        case ABS_X:     return JSFIELD_LEFT_X;
+        case ABS_Y:     return JSFIELD_LEFT_Y;
+        case ABS_RX:    return JSFIELD_RIGHT_X;
+        case ABS_RY:    return JSFIELD_RIGHT_Y;
+        case ABS_Z:     return JSFIELD_L2;
+        case ABS_RZ:    return JSFIELD_R2;
+        default:        return JSFIELD_NONE;
+    }
+}
+
+// =================================================================================================
+// CLinuxEvdevSource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CLinuxEvdevSource::CLinuxEvdevSource() :
+    m_sink(nullptr),
+    m_epollFd(-1),
+    m_wakeFd(-1),
+    m_inotifyFd(-1),
+    m_eventBuffer(EVDEV_EVENTS_PER_READ * sizeof(input_event))
+{
+}
+
+// =================================================================================================
+// ~CLinuxEvdevSource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CLinuxEvdevSource::~CLinuxEvdevSource()
+{
+    Close();
+}
+
+// =================================================================================================
+// Open
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CLinuxEvdevSource::Open(IInputSink* sink)
+{
+    if (m_epollFd >= 0)
+    {
+        return sink == m_sink;
+    }
+    if (sink == nullptr)
+    {
+        return false;
+    }
+
+    m_sink = sink;
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epollFd < 0 || m_wakeFd < 0)
+    {
+        Close();
+        return false;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = &m_wakeFd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event) < 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd >= 0 && inotify_add_watch(m_inotifyFd, EVDEV_DEVICE_DIR, IN_CREATE | IN_ATTRIB | IN_DELETE) >= 0)
+    {
+        event.data.ptr = &m_inotifyFd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_inotifyFd, &event);
+    }
+
+    ScanDevices();
+    return true;
+}
+
+// =================================================================================================
+// Poll
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CLinuxEvdevSource::Poll(int timeoutMs)
+{
+    if (m_epollFd < 0)
+    {
+        return -1;
+    }
+
+    epoll_event events[EVDEV_EPOLL_EVENTS];
+    int count = epoll_wait(m_epollFd, events, EVDEV_EPOLL_EVENTS, timeoutMs);
+    if (count < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        m_sink->OnInputError(nullptr, INPUT_ERROR_READ, errno);
+        return -1;
+    }
+
+    int handled = 0;
+    for (int i = 0; i < count; i++)
+    {
+        void* key = events[i].data.ptr;
+        if (key == &m_wakeFd)
+        {
+            uint64_t value;
+            ssize_t result = read(m_wakeFd, &value, sizeof(value));
+            (void)result;
+        }
+        else if (key == &m_inotifyFd)
+        {
+            HandleHotplug();
+        }
+        else
+        {
+            handled += ReadDevice((SEvdevDevice*)key);
+        }
+    }
+
+    m_sink->OnBatchEnd();
+
+    // Devices closed during this wakeup are freed only now, later events may still point at them
+    for (size_t i = m_devices.size(); i-- > 0;)
+    {
+        if (m_devices[i]->fd < 0)
+        {
+            m_devices.erase(m_devices.begin() + i);
+        }
+    }
+
+    return handled;
+}
+
+// =================================================================================================
+// Wake
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxEvdevSource::Wake()
+{
+    if (m_wakeFd >= 0)
+    {
+        uint64_t one = 1;
+        ssize_t result = write(m_wakeFd, &one, sizeof(one));
+        (void)result;
+    }
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxEvdevSource::Close()
+{
+    for (std::unique_ptr<SEvdevDevice>& device : m_devices)
+    {
+        CloseDevice(device.get());
+    }
+    m_devices.clear();
+
+    if (m_inotifyFd >= 0)
+    {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+    if (m_wakeFd >= 0)
+    {
+        close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+    if (m_epollFd >= 0)
+    {
+        close(m_epollFd);
+        m_epollFd = -1;
+    }
+
+    m_sink = nullptr;
+}
+
+// =================================================================================================
+// ScanDevices
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxEvdevSource::ScanDevices()
+{
+    DIR* dir = opendir(EVDEV_DEVICE_DIR);
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    while (dirent* entry = readdir(dir))
+    {
+        if (IsEventName(entry->d_name))
+        {
+            OpenDevice(entry->d_name);
+        }
+    }
+
+    closedir(dir);
+}
+
+// =================================================================================================
+// OpenDevice               only nodes with gamepad buttons and a left stick are taken, which skips
+//                          the separate motion sensor and touchpad nodes of the Sony drivers
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CLinuxEvdevSource::OpenDevice(const std::string& name)
+{
+    if (FindDevice(name) != nullptr)
+    {
+        return true;
+    }
+
+    std::string path = std::string(EVDEV_DEVICE_DIR) + "/" + name;
+    int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+    {
+        m_sink->OnInputError(nullptr, INPUT_ERROR_OPEN, errno);
+        return false;
+    }
+
+    unsigned char keyBits[KEY_MAX / 8 + 1] = {};
+    unsigned char absBits[ABS_MAX / 8 + 1] = {};
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0 ||
+        ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0)
+    {
+        m_sink->OnInputError(nullptr, INPUT_ERROR_DEVICE_INFO, errno);
+        close(fd);
+        return false;
+    }
+    if (!TestBit(keyBits, BTN_GAMEPAD) || !TestBit(absBits, ABS_X))
+    {
+        close(fd);
+        return false;
+    }
+
+    input_id id;
+    SHidDeviceDescriptor descriptor;
+    if (ioctl(fd, EVIOCGID, &id) >= 0)
+    {
+        descriptor.vendorId = id.vendor;
+        descriptor.productId = id.product;
+    }
+
+    char phys[256] = {};
+    if (ioctl(fd, EVIOCGPHYS(sizeof(phys) - 1), phys) < 0 || phys[0] == 0)
+    {
+        std::strncpy(phys, name.c_str(), sizeof(phys) - 1);
+    }
+
+    std::unique_ptr<SEvdevDevice> device(new SEvdevDevice());
+    device->fd = fd;
+    device->name = name;
+    device->hatX = 0;
+    device->hatY = 0;
+    device->state.arrowValue = EVDEV_HAT_FROM_AXES[1][1];
+
+    int clockId = CLOCK_MONOTONIC;
+    device->monotonicTime = ioctl(fd, EVIOCSCLOCKID, &clockId) >= 0;
+
+    // Start from the current axis values, evdev only reports changes
+    for (int code = ABS_X; code <= ABS_RZ; code++)
+    {
+        input_absinfo absInfo;
+        EJsField field = MapEvdevAxis(code);
+        if (field != JSFIELD_NONE && TestBit(absBits, code) && ioctl(fd, EVIOCGABS(code), &absInfo) >= 0)
+        {
+            StoreFieldValue(device->state, field, (unsigned long)absInfo.value);
+        }
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = device.get();
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        m_sink->OnInputError(nullptr, INPUT_ERROR_OPEN, errno);
+        close(fd);
+        return false;
+    }
+
+    if (m_sink->OnDeviceArrived(device.get(), HashDeviceName(phys), std::move(descriptor)) == INVALID_PLAYER_INDEX)
+    {
+        close(fd);
+        return false;
+    }
+
+    m_devices.push_back(std::move(device));
+    return true;
+}
+
+// =================================================================================================
+// CloseDevice              the entry stays in m_devices with fd -1 until Poll frees it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxEvdevSource::CloseDevice(SEvdevDevice* device)
+{
+    if (device == nullptr || device->fd < 0)
+    {
+        return;
+    }
+
+    close(device->fd);
+    device->fd = -1;
+    m_sink->OnDeviceRemoved(device);
+}
+
+// =================================================================================================
+// FindDevice
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CLinuxEvdevSource::SEvdevDevice* CLinuxEvdevSource::FindDevice(const std::string& name)
+{
+    for (std::unique_ptr<SEvdevDevice>& device : m_devices)
+    {
+        if (device->fd >= 0 && device->name == name)
+        {
+            return device.get();
+        }
+    }
+    return nullptr;
+}
+
+// =================================================================================================
+// HandleHotplug
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxEvdevSource::HandleHotplug()
+{
+    alignas(inotify_event) char buffer[4096];
+
+    for (;;)
+    {
+        ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event* event = (const inotify_event*)(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->len == 0 || !IsEventName(event->name))
+            {
+                continue;
+            }
+
+            if (event->mask & IN_DELETE)
+            {
+                CloseDevice(FindDevice(event->name));
+            }
+            else
+            {
+                OpenDevice(event->name);
+            }
+        }
+    }
+}
+
+// =================================================================================================
+// ReadDevice               fetch up to EVDEV_EVENTS_PER_READ events per read() and apply them to the
+//                          device state; every SYN_REPORT hands one state to the sink
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CLinuxEvdevSource::ReadDevice(SEvdevDevice* device)
+{
+    int delivered = 0;
+
+    for (int i = 0; i < EVDEV_READS_PER_WAKEUP && device->fd >= 0; i++)
+    {
+        ssize_t length = read(device->fd, m_eventBuffer.data(), m_eventBuffer.size());
+        if (length < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        if (length <= 0)
+        {
+            // ENODEV is an unplug, not a failure
+            if (length < 0 && errno != ENODEV)
+            {
+                m_sink->OnInputError(device, INPUT_ERROR_READ, errno);
+            }
+            CloseDevice(device);
+            break;
+        }
+
+        const input_event* events = (const input_event*)m_eventBuffer.data();
+        size_t count = (size_t)length / sizeof(input_event);
+
+        for (size_t j = 0; j < count; j++)
+        {
+            const input_event& event = events[j];
+
+            if (event.type == EV_KEY)
+            {
+                int button = MapEvdevButton(event.code);
+                if (button >= 0)
+                {
+                    device->state.HandlePressed[button] = event.value != 0;
+                }
+            }
+            else if (event.type == EV_ABS && event.code == ABS_HAT0X)
+            {
+                device->hatX = event.value < 0 ? -1 : (event.value > 0 ? 1 : 0);
+                device->state.arrowValue = EVDEV_HAT_FROM_AXES[device->hatY + 1][device->hatX + 1];
+            }
+            else if (event.type == EV_ABS && event.code == ABS_HAT0Y)
+            {
+                device->hatY = event.value < 0 ? -1 : (event.value > 0 ? 1 : 0);
+                device->state.arrowValue = EVDEV_HAT_FROM_AXES[device->hatY + 1][device->hatX + 1];
+            }
+            else if (event.type == EV_ABS)
+            {
+                StoreFieldValue(device->state, MapEvdevAxis(event.code), (unsigned long)event.value);
+            }
+            else if (event.type == EV_SYN && event.code == SYN_REPORT)
+            {
+                uint64_t timestampNs = device->monotonicTime ?
+                    (uint64_t)event.input_event_sec * 1000000000ull + (uint64_t)event.input_event_usec * 1000ull :
+                    MonotonicNowNs();
+
+                if (m_sink->OnState(device, device->state, timestampNs))
+                {
+                    delivered++;
+                }
+            }
+        }
+    }
+
+    return delivered;
+}
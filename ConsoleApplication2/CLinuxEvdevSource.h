@@ -0,0 +1,73 @@
+// =================================================================================================
+// Linux evdev backend, the fallback when hidraw is not accessible. The kernel driver has already
+// decoded the pad, so complete JSDATA states are handed to the core on every SYN_REPORT.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "IInputSource.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// input_event records fetched per read()
+const size_t EVDEV_EVENTS_PER_READ = 64;
+
+// Reads of one device per wakeup before the other devices get their turn
+const int EVDEV_READS_PER_WAKEUP = 8;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CLinuxEvdevSource : public IInputSource
+{
+public:
+   CLinuxEvdevSource();
+   ~CLinuxEvdevSource();
+
+   // IInputSource, all but Wake run on the input thread
+   bool Open(IInputSink* sink) override;
+   int Poll(int timeoutMs) override;
+   void Wake() override;
+   void Close() override;
+
+   int DeviceCount() const { return (int)m_devices.size(); }
+
+private:
+   struct SEvdevDevice
+   {
+      int fd;
+      std::string name;       // eventN
+      JSDATA state;           // built up between two SYN_REPORTs
+      int hatX;
+      int hatY;
+      bool monotonicTime;     // event times are on CLOCK_MONOTONIC, like MonotonicNowNs()
+   };
+
+   void ScanDevices();
+   bool OpenDevice(const std::string& name);
+   void CloseDevice(SEvdevDevice* device);
+   SEvdevDevice* FindDevice(const std::string& name);
+   void HandleHotplug();
+   int ReadDevice(SEvdevDevice* device);
+
+
+   IInputSink* m_sink;
+   int m_epollFd;
+   int m_wakeFd;
+   int m_inotifyFd;
+   std::vector<std::unique_ptr<SEvdevDevice>> m_devices;
+   std::vector<unsigned char> m_eventBuffer;
+};
@@ -0,0 +1,595 @@
+// =================================================================================================
+// Linux hidraw backend. Reads raw HID reports of the pads from /dev/hidraw* through epoll, so the
+// same layout decoders run as on Windows; other pads are decoded by their compiled report
+// descriptor. CreateLinuxInputSource falls back to evdev when no hidraw node can be opened.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CLinuxHidrawSource.h"
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <linux/hidraw.h>
+#include <linux/input.h>
+#include "CDeviceRegistry.h"
+#include "CLinuxEvdevSource.h"
+#include "Ds4Motion.h"
+#include "MonotonicClock.h"
+#include "HidReportProgram.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int HIDRAW_EPOLL_EVENTS = 16;
+const char HIDRAW_DEVICE_DIR[] = "/dev";
+const char HIDRAW_NAME_PREFIX[] = "hidraw";
+
+// =================================================================================================
+// ================================ TYPES, CLASSES, STRUCTURES =====================================
+
+// Output reports of one hidraw node, through a blocking handle of its own so the writer thread
+// waits on a busy link instead of dropping the report the input handle would refuse
+class CHidrawOutputDevice : public IPadOutputDevice
+{
+public:
+   explicit CHidrawOutputDevice(int fd);
+   ~CHidrawOutputDevice() override;
+
+   bool Write(const unsigned char* report, size_t length) override;
+
+private:
+   int m_fd;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// HashDeviceName           FNV-1a hash of the physical path, the same pad keeps it across replugs
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t HashDeviceName(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    for (; *name != 0; name++)
+    {
+        hash = (hash ^ (unsigned char)*name) * 16777619u;
+    }
+    return hash;
+}
+
+// =================================================================================================
+// CHidrawOutputDevice
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CHidrawOutputDevice::CHidrawOutputDevice(int fd) :
+    m_fd(fd)
+{
+}
+
+// =================================================================================================
+// ~CHidrawOutputDevice
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CHidrawOutputDevice::~CHidrawOutputDevice()
+{
+    close(m_fd);
+}
+
+// =================================================================================================
+// Write                    hidraw takes the report whole, report ID first
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CHidrawOutputDevice::Write(const unsigned char* report, size_t length)
+{
+    ssize_t written;
+    do
+    {
+        written = write(m_fd, report, length);
+    } while (written < 0 && errno == EINTR);
+
+    return written == (ssize_t)length;
+}
+
+// =================================================================================================
+// ReadDs4Calibration       the IMU feature report of a DS4; left empty when the pad refuses it,
+//                          the core then falls back to the nominal scales
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ReadDs4Calibration(int fd, bool bluetooth, std::vector<unsigned char>& calibrationReport)
+{
+    unsigned char report[DS4_CALIBRATION_BT_SIZE] = {};
+    report[0] = bluetooth ? DS4_CALIBRATION_BT_REPORT_ID : DS4_CALIBRATION_USB_REPORT_ID;
+    int length = ioctl(fd, HIDIOCGFEATURE(sizeof(report)), report);
+    if (length > 0)
+    {
+        calibrationReport.assign(report, report + length);
+    }
+}
+
+// =================================================================================================
+// CompileReportDescriptor  reads the report descriptor and compiles it; false when the device
+//                          has none the kernel would hand out or it describes no pad
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool CompileReportDescriptor(int fd, SHidDeviceDescriptor& descriptor)
+{
+    int size = 0;
+    if (ioctl(fd, HIDIOCGRDESCSIZE, &size) < 0 || size <= 0 || size > HID_MAX_DESCRIPTOR_SIZE)
+    {
+        return false;
+    }
+
+    hidraw_report_descriptor reportDescriptor;
+    reportDescriptor.size = (uint32_t)size;
+    if (ioctl(fd, HIDIOCGRDESC, &reportDescriptor) < 0)
+    {
+        return false;
+    }
+
+    descriptor.reportDescriptor.assign(reportDescriptor.value, reportDescriptor.value + size);
+    return CompileHidReportDescriptor(descriptor.reportDescriptor.data(), descriptor.reportDescriptor.size(), descriptor.reportProgram) &&
+           !descriptor.reportProgram.ops.empty();
+}
+
+// =================================================================================================
+// IsHidrawName
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool IsHidrawName(const char* name)
+{
+    return std::strncmp(name, HIDRAW_NAME_PREFIX, sizeof(HIDRAW_NAME_PREFIX) - 1) == 0;
+}
+
+// =================================================================================================
+// CLinuxHidrawSource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CLinuxHidrawSource::CLinuxHidrawSource() :
+    m_sink(nullptr),
+    m_epollFd(-1),
+    m_wakeFd(-1),
+    m_inotifyFd(-1),
+    m_reportBuffer(HIDRAW_REPORT_BUFFER_SIZE)
+{
+}
+
+// =================================================================================================
+// ~CLinuxHidrawSource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CLinuxHidrawSource::~CLinuxHidrawSource()
+{
+    Close();
+}
+
+// =================================================================================================
+// Open                     a missing /dev watch only costs hotplug, the pads present now still open
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CLinuxHidrawSource::Open(IInputSink* sink)
+{
+    if (m_epollFd >= 0)
+    {
+        return sink == m_sink;
+    }
+    if (sink == nullptr)
+    {
+        return false;
+    }
+
+    m_sink = sink;
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epollFd < 0 || m_wakeFd < 0)
+    {
+        Close();
+        return false;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = &m_wakeFd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event) < 0)
+    {
+        Close();
+        return false;
+    }
+
+    // udev fixes the permissions after the node is created, so IN_ATTRIB retries the open
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd >= 0 && inotify_add_watch(m_inotifyFd, HIDRAW_DEVICE_DIR, IN_CREATE | IN_ATTRIB | IN_DELETE) >= 0)
+    {
+        event.data.ptr = &m_inotifyFd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_inotifyFd, &event);
+    }
+
+    ScanDevices();
+    return true;
+}
+
+// =================================================================================================
+// Poll                     one epoll wakeup; every readable device is drained up to
+//                          HIDRAW_READS_PER_WAKEUP reports, level triggering brings back the rest
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CLinuxHidrawSource::Poll(int timeoutMs)
+{
+    if (m_epollFd < 0)
+    {
+        return -1;
+    }
+
+    epoll_event events[HIDRAW_EPOLL_EVENTS];
+    int count = epoll_wait(m_epollFd, events, HIDRAW_EPOLL_EVENTS, timeoutMs);
+    if (count < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        m_sink->OnInputError(nullptr, INPUT_ERROR_READ, errno);
+        return -1;
+    }
+
+    int handled = 0;
+    for (int i = 0; i < count; i++)
+    {
+        void* key = events[i].data.ptr;
+        if (key == &m_wakeFd)
+        {
+            uint64_t value;
+            ssize_t result = read(m_wakeFd, &value, sizeof(value));
+            (void)result;
+        }
+        else if (key == &m_inotifyFd)
+        {
+            HandleHotplug();
+        }
+        else
+        {
+            handled += ReadDevice((SHidrawDevice*)key);
+        }
+    }
+
+    m_sink->OnBatchEnd();
+
+    // Devices closed during this wakeup are freed only now, later events may still point at them
+    for (size_t i = m_devices.size(); i-- > 0;)
+    {
+        if (m_devices[i]->fd < 0)
+        {
+            m_devices.erase(m_devices.begin() + i);
+        }
+    }
+
+    return handled;
+}
+
+// =================================================================================================
+// Wake
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxHidrawSource::Wake()
+{
+    if (m_wakeFd >= 0)
+    {
+        uint64_t one = 1;
+        ssize_t result = write(m_wakeFd, &one, sizeof(one));
+        (void)result;
+    }
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxHidrawSource::Close()
+{
+    for (std::unique_ptr<SHidrawDevice>& device : m_devices)
+    {
+        CloseDevice(device.get());
+    }
+    m_devices.clear();
+
+    if (m_inotifyFd >= 0)
+    {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+    if (m_wakeFd >= 0)
+    {
+        close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+    if (m_epollFd >= 0)
+    {
+        close(m_epollFd);
+        m_epollFd = -1;
+    }
+
+    m_sink = nullptr;
+}
+
+// =================================================================================================
+// ScanDevices
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxHidrawSource::ScanDevices()
+{
+    DIR* dir = opendir(HIDRAW_DEVICE_DIR);
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    while (dirent* entry = readdir(dir))
+    {
+        if (IsHidrawName(entry->d_name))
+        {
+            OpenDevice(entry->d_name);
+        }
+    }
+
+    closedir(dir);
+}
+
+// =================================================================================================
+// OpenDevice               pads with a known report layout, and devices whose report descriptor
+//                          has a Joystick or GamePad collection; keyboards and mice are left alone
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CLinuxHidrawSource::OpenDevice(const std::string& name)
+{
+    if (FindDevice(name) != nullptr)
+    {
+        return true;
+    }
+
+    // Read-write when allowed so feature and output reports can be sent later
+    std::string path = std::string(HIDRAW_DEVICE_DIR) + "/" + name;
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+    {
+        fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    }
+    if (fd < 0)
+    {
+        m_sink->OnInputError(nullptr, INPUT_ERROR_OPEN, errno);
+        return false;
+    }
+
+    hidraw_devinfo info;
+    if (ioctl(fd, HIDIOCGRAWINFO, &info) < 0)
+    {
+        m_sink->OnInputError(nullptr, INPUT_ERROR_DEVICE_INFO, errno);
+        close(fd);
+        return false;
+    }
+
+    SHidDeviceDescriptor descriptor;
+    descriptor.vendorId = (uint16_t)info.vendor;
+    descriptor.productId = (uint16_t)info.product;
+    descriptor.decoder = SelectReportDecoder(descriptor.vendorId, descriptor.productId);
+    if (descriptor.decoder == DECODER_GENERIC)
+    {
+        if (!CompileReportDescriptor(fd, descriptor))
+        {
+            close(fd);
+            return false;
+        }
+        descriptor.genericDecoder = DecodeReportProgram;
+    }
+
+    if (descriptor.decoder == DECODER_DS4)
+    {
+        ReadDs4Calibration(fd, info.bustype == BUS_BLUETOOTH, descriptor.calibrationReport);
+
+        int outputFd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (outputFd >= 0)
+        {
+            descriptor.output.reset(new CHidrawOutputDevice(outputFd));
+        }
+    }
+    descriptor.bluetooth = info.bustype == BUS_BLUETOOTH;
+
+    char phys[256] = {};
+    if (ioctl(fd, HIDIOCGRAWPHYS(sizeof(phys) - 1), phys) < 0 || phys[0] == 0)
+    {
+        std::strncpy(phys, name.c_str(), sizeof(phys) - 1);
+    }
+
+    std::unique_ptr<SHidrawDevice> device(new SHidrawDevice());
+    device->fd = fd;
+    device->name = name;
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = device.get();
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        m_sink->OnInputError(nullptr, INPUT_ERROR_OPEN, errno);
+        close(fd);
+        return false;
+    }
+
+    if (m_sink->OnDeviceArrived(device.get(), HashDeviceName(phys), std::move(descriptor)) == INVALID_PLAYER_INDEX)
+    {
+        close(fd);
+        return false;
+    }
+
+    m_devices.push_back(std::move(device));
+    return true;
+}
+
+// =================================================================================================
+// CloseDevice              the entry stays in m_devices with fd -1 until Poll frees it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxHidrawSource::CloseDevice(SHidrawDevice* device)
+{
+    if (device == nullptr || device->fd < 0)
+    {
+        return;
+    }
+
+    close(device->fd);
+    device->fd = -1;
+    m_sink->OnDeviceRemoved(device);
+}
+
+// =================================================================================================
+// FindDevice               open device of a /dev entry name
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CLinuxHidrawSource::SHidrawDevice* CLinuxHidrawSource::FindDevice(const std::string& name)
+{
+    for (std::unique_ptr<SHidrawDevice>& device : m_devices)
+    {
+        if (device->fd >= 0 && device->name == name)
+        {
+            return device.get();
+        }
+    }
+    return nullptr;
+}
+
+// =================================================================================================
+// HandleHotplug            open new hidraw nodes and close removed ones
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLinuxHidrawSource::HandleHotplug()
+{
+    alignas(inotify_event) char buffer[4096];
+
+    for (;;)
+    {
+        ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event* event = (const inotify_event*)(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->len == 0 || !IsHidrawName(event->name))
+            {
+                continue;
+            }
+
+            if (event->mask & IN_DELETE)
+            {
+                CloseDevice(FindDevice(event->name));
+            }
+            else
+            {
+                OpenDevice(event->name);
+            }
+        }
+    }
+}
+
+// =================================================================================================
+// ReadDevice               hidraw returns one report per read(), the buffer is reused for all of
+//                          them. Returns the reports the sink decoded.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CLinuxHidrawSource::ReadDevice(SHidrawDevice* device)
+{
+    int decoded = 0;
+
+    for (int i = 0; i < HIDRAW_READS_PER_WAKEUP && device->fd >= 0; i++)
+    {
+        ssize_t length = read(device->fd, m_reportBuffer.data(), m_reportBuffer.size());
+        if (length > 0)
+        {
+            if (m_sink->OnReport(device, m_reportBuffer.data(), (size_t)length, MonotonicNowNs()))
+            {
+                decoded++;
+            }
+            continue;
+        }
+
+        if (length < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+
+        // ENODEV: unplugged, inotify may not have told us yet. Anything else is worth counting.
+        if (length < 0 && errno != ENODEV)
+        {
+            m_sink->OnInputError(device, INPUT_ERROR_READ, errno);
+        }
+        CloseDevice(device);
+    }
+
+    return decoded;
+}
+
+// =================================================================================================
+// CreateLinuxInputSource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+std::unique_ptr<IInputSource> CreateLinuxInputSource(IInputSink* sink)
+{
+    std::unique_ptr<CLinuxHidrawSource> hidraw(new CLinuxHidrawSource());
+    if (!hidraw->Open(sink))
+    {
+        hidraw.reset();
+    }
+    else if (hidraw->DeviceCount() > 0)
+    {
+        return hidraw;
+    }
+
+    std::unique_ptr<CLinuxEvdevSource> evdev(new CLinuxEvdevSource());
+    if (evdev->Open(sink) && (evdev->DeviceCount() > 0 || hidraw == nullptr))
+    {
+        return evdev;
+    }
+    evdev.reset();
+
+    // Nothing plugged in yet, hidraw picks the pads up as they arrive
+    return hidraw;
+}
@@ -0,0 +1,76 @@
+// =================================================================================================
+// Linux hidraw backend. Reads raw HID reports of the pads from /dev/hidraw* through epoll, so the
+// same layout decoders run as on Windows; other pads are decoded by their compiled report
+// descriptor. CreateLinuxInputSource falls back to evdev when no hidraw node can be opened.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "IInputSource.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Reports read from one device per wakeup before the other devices get their turn
+const int HIDRAW_READS_PER_WAKEUP = 64;
+
+// HID_MAX_BUFFER_SIZE of the kernel, no report is larger
+const size_t HIDRAW_REPORT_BUFFER_SIZE = 4096;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CLinuxHidrawSource : public IInputSource
+{
+public:
+   CLinuxHidrawSource();
+   ~CLinuxHidrawSource();
+
+   // IInputSource, all but Wake run on the input thread
+   bool Open(IInputSink* sink) override;
+   int Poll(int timeoutMs) override;
+   void Wake() override;
+   void Close() override;
+
+   int DeviceCount() const { return (int)m_devices.size(); }
+
+private:
+   struct SHidrawDevice
+   {
+      int fd;
+      std::string name;       // hidrawN
+   };
+
+   void ScanDevices();
+   bool OpenDevice(const std::string& name);
+   void CloseDevice(SHidrawDevice* device);
+   SHidrawDevice* FindDevice(const std::string& name);
+   void HandleHotplug();
+   int ReadDevice(SHidrawDevice* device);
+
+
+   IInputSink* m_sink;
+   int m_epollFd;
+   int m_wakeFd;
+   int m_inotifyFd;
+   std::vector<std::unique_ptr<SHidrawDevice>> m_devices;
+   std::vector<unsigned char> m_reportBuffer;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// hidraw when at least one known pad can be opened, evdev otherwise; nullptr when neither opens
+std::unique_ptr<IInputSource> CreateLinuxInputSource(IInputSink* sink);
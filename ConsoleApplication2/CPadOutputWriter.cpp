@@ -0,0 +1,244 @@
+// =================================================================================================
+// Asynchronous writer of one pad's output reports. Callers only merge their update into a pending
+// state word; a thread of the writer's own turns whatever is pending into one output report, at
+// most one per minimum interval, so a game loop setting rumble every frame costs the pad a report
+// per interval and never waits on the device.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CPadOutputWriter.h"
+#include <chrono>
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// m_pending: strong, weak, red, green, blue, flash on, flash off from the low byte up
+const uint64_t PAD_OUTPUT_PENDING = 1ULL << 63;
+
+const uint64_t PAD_OUTPUT_RUMBLE_BITS = 0x000000000000FFFFULL;
+const uint64_t PAD_OUTPUT_LIGHTBAR_BITS = 0x000000FFFFFF0000ULL;
+const uint64_t PAD_OUTPUT_FLASH_BITS = 0x00FFFF0000000000ULL;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// PackPadOutput
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint64_t PackPadOutput(const SPadOutput& output)
+{
+    return (uint64_t)output.strongMotor | (uint64_t)output.weakMotor << 8 | (uint64_t)output.red << 16 |
+           (uint64_t)output.green << 24 | (uint64_t)output.blue << 32 | (uint64_t)output.flashOn << 40 |
+           (uint64_t)output.flashOff << 48;
+}
+
+// =================================================================================================
+// UnpackPadOutput
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SPadOutput UnpackPadOutput(uint64_t packed)
+{
+    SPadOutput output;
+    output.strongMotor = (uint8_t)packed;
+    output.weakMotor = (uint8_t)(packed >> 8);
+    output.red = (uint8_t)(packed >> 16);
+    output.green = (uint8_t)(packed >> 24);
+    output.blue = (uint8_t)(packed >> 32);
+    output.flashOn = (uint8_t)(packed >> 40);
+    output.flashOff = (uint8_t)(packed >> 48);
+    return output;
+}
+
+// =================================================================================================
+// CPadOutputWriter
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CPadOutputWriter::CPadOutputWriter() :
+    m_bluetooth(false),
+    m_minIntervalNs(0),
+    m_attached(false),
+    m_pending(0),
+    m_stopRequested(false),
+    m_submits(0),
+    m_coalesced(0),
+    m_writes(0),
+    m_unchanged(0),
+    m_writeErrors(0)
+{
+}
+
+// =================================================================================================
+// ~CPadOutputWriter
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CPadOutputWriter::~CPadOutputWriter()
+{
+    Detach();
+}
+
+// =================================================================================================
+// Attach
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadOutputWriter::Attach(std::shared_ptr<IPadOutputDevice> device, bool bluetooth, uint32_t minIntervalUs)
+{
+    Detach();
+    if (!device)
+    {
+        return;
+    }
+
+    m_device = std::move(device);
+    m_bluetooth = bluetooth;
+    m_minIntervalNs = (uint64_t)minIntervalUs * 1000;
+    m_pending.store(0, std::memory_order_relaxed);
+    m_stopRequested = false;
+    m_thread = std::thread(&CPadOutputWriter::Run, this);
+    m_attached.store(true, std::memory_order_release);
+}
+
+// =================================================================================================
+// Detach                   a report being written completes first; what is still pending is
+//                          dropped with the device
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadOutputWriter::Detach()
+{
+    m_attached.store(false, std::memory_order_release);
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+    }
+    m_device.reset();
+}
+
+// =================================================================================================
+// Submit                   only the update that makes a report due wakes the writer; the ones
+//                          after it merge into the same report without touching the mutex
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CPadOutputWriter::Submit(const SPadOutput& output, uint32_t fields)
+{
+    if (!m_attached.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    uint64_t mask = ((fields & PAD_OUTPUT_RUMBLE) ? PAD_OUTPUT_RUMBLE_BITS : 0) |
+                    ((fields & PAD_OUTPUT_LIGHTBAR) ? PAD_OUTPUT_LIGHTBAR_BITS : 0) |
+                    ((fields & PAD_OUTPUT_FLASH) ? PAD_OUTPUT_FLASH_BITS : 0);
+    uint64_t packed = PackPadOutput(output) & mask;
+
+    uint64_t previous = m_pending.load(std::memory_order_relaxed);
+    while (!m_pending.compare_exchange_weak(previous, (previous & ~mask) | packed | PAD_OUTPUT_PENDING,
+                                            std::memory_order_acq_rel, std::memory_order_relaxed))
+    {
+    }
+
+    m_submits.fetch_add(1, std::memory_order_relaxed);
+    if (previous & PAD_OUTPUT_PENDING)
+    {
+        m_coalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_one();
+    }
+    return true;
+}
+
+// =================================================================================================
+// Run                      waits for a pending state and for the interval since the device
+//                          finished the last report, refused ones included, then takes the state
+//                          as it is by then. Counted from the end of the write, the interval holds
+//                          between the starts of two writes too. The mutex is let go while the
+//                          device writes.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadOutputWriter::Run()
+{
+    unsigned char report[PAD_OUTPUT_MAX_REPORT_SIZE];
+    uint64_t lastWriteNs = 0;
+    uint64_t lastWritten = 0;
+    bool written = false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopRequested)
+    {
+        if (!(m_pending.load(std::memory_order_acquire) & PAD_OUTPUT_PENDING))
+        {
+            m_wake.wait(lock);
+            continue;
+        }
+
+        uint64_t nowNs = MonotonicNowNs();
+        if (lastWriteNs != 0 && nowNs - lastWriteNs < m_minIntervalNs)
+        {
+            m_wake.wait_for(lock, std::chrono::nanoseconds(m_minIntervalNs - (nowNs - lastWriteNs)));
+            continue;
+        }
+
+        uint64_t state = m_pending.fetch_and(~PAD_OUTPUT_PENDING, std::memory_order_acq_rel) & ~PAD_OUTPUT_PENDING;
+        if (written && state == lastWritten)
+        {
+            m_unchanged.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        lock.unlock();
+        size_t length = BuildDs4OutputReport(UnpackPadOutput(state), m_bluetooth, report);
+        bool accepted = m_device->Write(report, length);
+        lastWriteNs = MonotonicNowNs();
+        lock.lock();
+
+        if (accepted)
+        {
+            m_writes.fetch_add(1, std::memory_order_relaxed);
+            lastWritten = state;
+            written = true;
+        }
+        else
+        {
+            m_writeErrors.fetch_add(1, std::memory_order_relaxed);
+            written = false;
+        }
+    }
+}
+
+// =================================================================================================
+// GetCounters
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+SPadOutputCounters CPadOutputWriter::GetCounters() const
+{
+    SPadOutputCounters counters;
+    counters.submits = m_submits.load(std::memory_order_relaxed);
+    counters.coalesced = m_coalesced.load(std::memory_order_relaxed);
+    counters.writes = m_writes.load(std::memory_order_relaxed);
+    counters.unchanged = m_unchanged.load(std::memory_order_relaxed);
+    counters.writeErrors = m_writeErrors.load(std::memory_order_relaxed);
+    return counters;
+}
@@ -0,0 +1,93 @@
+// =================================================================================================
+// Asynchronous writer of one pad's output reports. Callers only merge their update into a pending
+// state word; a thread of the writer's own turns whatever is pending into one output report, at
+// most one per minimum interval, so a game loop setting rumble every frame costs the pad a report
+// per interval and never waits on the device.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "PadOutput.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Shortest time between two reports: over USB about the pad's input interval; over Bluetooth the
+// reports share the link with 1 kHz of input and back up when sent faster
+const uint32_t PAD_OUTPUT_MIN_INTERVAL_USB_US = 4000;
+const uint32_t PAD_OUTPUT_MIN_INTERVAL_BT_US = 10000;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SPadOutputConfig
+{
+	uint32_t minIntervalUsbUs = PAD_OUTPUT_MIN_INTERVAL_USB_US;
+	uint32_t minIntervalBluetoothUs = PAD_OUTPUT_MIN_INTERVAL_BT_US;
+};
+
+struct SPadOutputCounters
+{
+	uint64_t submits;           // updates accepted
+	uint64_t coalesced;         // updates merged into a report already pending
+	uint64_t writes;            // reports the device took
+	uint64_t unchanged;         // pending states equal to the last report, not sent again
+	uint64_t writeErrors;       // reports the device refused; the next update sends the state again
+};
+
+class CPadOutputWriter
+{
+public:
+   CPadOutputWriter();
+   ~CPadOutputWriter();
+
+   CPadOutputWriter(const CPadOutputWriter&) = delete;
+   CPadOutputWriter& operator=(const CPadOutputWriter&) = delete;
+
+   // Input thread: starts the writer thread on a device that arrived, with everything off and
+   // nothing sent until the first update; Detach stops it and lets go of the device
+   void Attach(std::shared_ptr<IPadOutputDevice> device, bool bluetooth, uint32_t minIntervalUs);
+   void Detach();
+
+   // Any thread, never waits on the device: merges the fields of output into the pending state.
+   // False while no device is attached.
+   bool Submit(const SPadOutput& output, uint32_t fields);
+
+   SPadOutputCounters GetCounters() const;
+
+private:
+   void Run();
+
+
+   std::shared_ptr<IPadOutputDevice> m_device;
+   bool m_bluetooth;
+   uint64_t m_minIntervalNs;
+   std::thread m_thread;
+   std::atomic<bool> m_attached;
+
+   // SPadOutput packed a byte per field, PENDING bit on top while a report is due
+   std::atomic<uint64_t> m_pending;
+
+   std::mutex m_mutex;                 // guards m_stopRequested and the wait on m_wake
+   std::condition_variable m_wake;
+   bool m_stopRequested;
+
+   std::atomic<uint64_t> m_submits;
+   std::atomic<uint64_t> m_coalesced;
+   std::atomic<uint64_t> m_writes;
+   std::atomic<uint64_t> m_unchanged;
+   std::atomic<uint64_t> m_writeErrors;
+};
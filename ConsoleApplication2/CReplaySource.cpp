@@ -0,0 +1,285 @@
+// =================================================================================================
+// Replay source: plays a capture back through the sink as if the pads were connected, at the
+// recorded timing, a multiple of it, or as fast as the sink takes it.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CReplaySource.h"
+#include <chrono>
+#include <cstring>
+#include "CDeviceRegistry.h"
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CReplaySource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CReplaySource::CReplaySource(const std::string& path, double speed) :
+    m_path(path),
+    m_speed(speed > 0.0 ? speed : REPLAY_SPEED_UNLIMITED),
+    m_sink(nullptr),
+    m_next(),
+    m_hasNext(false),
+    m_started(false),
+    m_firstRecordNs(0),
+    m_startNs(0),
+    m_finished(false),
+    m_wakeRequested(false)
+{
+}
+
+// =================================================================================================
+// Open                     map the capture; its devices arrive as their records are replayed
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CReplaySource::Open(IInputSink* sink)
+{
+    if (m_sink != nullptr)
+    {
+        return sink == m_sink;
+    }
+    if (sink == nullptr || !m_reader.Open(m_path.c_str()))
+    {
+        return false;
+    }
+
+    m_sink = sink;
+    m_hasNext = m_reader.Next(m_next);
+    m_started = false;
+    m_finished.store(!m_hasNext, std::memory_order_release);
+    return true;
+}
+
+// =================================================================================================
+// Poll                     wait for the next record to fall due, then hand over every due record
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CReplaySource::Poll(int timeoutMs)
+{
+    if (m_sink == nullptr)
+    {
+        return -1;
+    }
+
+    uint64_t timeoutNs = timeoutMs >= 0 ? (uint64_t)timeoutMs * 1000000ull : UINT64_MAX;
+    if (!m_hasNext)
+    {
+        WaitForWake(timeoutNs);
+        return 0;
+    }
+
+    uint64_t nowNs = MonotonicNowNs();
+    if (!m_started)
+    {
+        m_firstRecordNs = m_next.timestampNs;
+        m_startNs = nowNs;
+        m_started = true;
+    }
+
+    if (m_speed != REPLAY_SPEED_UNLIMITED)
+    {
+        uint64_t dueNs = ScheduledNs(m_next.timestampNs);
+        if (nowNs < dueNs)
+        {
+            if (WaitForWake(dueNs - nowNs < timeoutNs ? dueNs - nowNs : timeoutNs))
+            {
+                return 0;
+            }
+            nowNs = MonotonicNowNs();
+            if (nowNs < dueNs)
+            {
+                return 0;
+            }
+        }
+    }
+
+    int handled = 0;
+    for (int i = 0; i < REPLAY_RECORDS_PER_POLL && m_hasNext; i++)
+    {
+        if (m_speed != REPLAY_SPEED_UNLIMITED && ScheduledNs(m_next.timestampNs) > nowNs)
+        {
+            break;
+        }
+
+        if (Deliver(m_next, nowNs))
+        {
+            handled++;
+        }
+        m_hasNext = m_reader.Next(m_next);
+    }
+
+    m_sink->OnBatchEnd();
+    if (!m_hasNext)
+    {
+        m_finished.store(true, std::memory_order_release);
+    }
+    return handled;
+}
+
+// =================================================================================================
+// Wake
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CReplaySource::Wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeRequested = true;
+    }
+    m_wakeCondition.notify_one();
+}
+
+// =================================================================================================
+// Close                    the devices still attached leave like unplugged pads
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CReplaySource::Close()
+{
+    if (m_sink == nullptr)
+    {
+        return;
+    }
+
+    for (std::unique_ptr<SReplayDevice>& device : m_devices)
+    {
+        if (device->attached)
+        {
+            m_sink->OnDeviceRemoved(device.get());
+        }
+    }
+    m_devices.clear();
+    m_reader.Close();
+    m_sink = nullptr;
+}
+
+// =================================================================================================
+// WaitForWake              true when woken before waitNs passed
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CReplaySource::WaitForWake(uint64_t waitNs)
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    if (waitNs == UINT64_MAX)
+    {
+        m_wakeCondition.wait(lock, [this] { return m_wakeRequested; });
+    }
+    else
+    {
+        m_wakeCondition.wait_for(lock, std::chrono::nanoseconds(waitNs), [this] { return m_wakeRequested; });
+    }
+
+    bool woken = m_wakeRequested;
+    m_wakeRequested = false;
+    return woken;
+}
+
+// =================================================================================================
+// ScheduledNs              when a record is due on the replay clock
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint64_t CReplaySource::ScheduledNs(uint64_t recordNs) const
+{
+    // Sources stamp with their own clocks, a record may be a little older than the first one
+    uint64_t offsetNs = recordNs > m_firstRecordNs ? recordNs - m_firstRecordNs : 0;
+    return m_startNs + (uint64_t)((double)offsetNs / m_speed);
+}
+
+// =================================================================================================
+// Deliver                  one record to the sink, stamped with the replay time. True for a report
+//                          or a state that decoded.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CReplaySource::Deliver(const SCaptureRecordView& record, uint64_t nowNs)
+{
+    SReplayDevice* pDevice = FindDevice(record.deviceId);
+
+    switch (record.type)
+    {
+        case CAPTURE_RECORD_DEVICE_ARRIVED:
+        {
+            if (record.length < sizeof(SCaptureDevice))
+            {
+                return false;
+            }
+            SCaptureDevice device;
+            std::memcpy(&device, record.payload, sizeof(device));
+
+            if (pDevice == nullptr)
+            {
+                m_devices.emplace_back(new SReplayDevice());
+                pDevice = m_devices.back().get();
+                pDevice->deviceId = record.deviceId;
+                pDevice->attached = false;
+            }
+
+            // Only the layout decoders can be replayed, the platform parser data is not captured
+            SHidDeviceDescriptor descriptor;
+            descriptor.vendorId = device.vendorId;
+            descriptor.productId = device.productId;
+            pDevice->attached = m_sink->OnDeviceArrived(pDevice, device.identity, std::move(descriptor)) != INVALID_PLAYER_INDEX;
+            return false;
+        }
+
+        case CAPTURE_RECORD_DEVICE_REMOVED:
+            if (pDevice != nullptr && pDevice->attached)
+            {
+                m_sink->OnDeviceRemoved(pDevice);
+                pDevice->attached = false;
+            }
+            return false;
+
+        case CAPTURE_RECORD_REPORT:
+            return pDevice != nullptr && pDevice->attached &&
+                m_sink->OnReport(pDevice, record.payload, record.length, nowNs);
+
+        case CAPTURE_RECORD_STATE:
+        {
+            if (pDevice == nullptr || !pDevice->attached || record.length < sizeof(SCaptureState))
+            {
+                return false;
+            }
+            SCaptureState state;
+            std::memcpy(&state, record.payload, sizeof(state));
+            JSDATA jsData;
+            UnpackCaptureState(state, jsData);
+            return m_sink->OnState(pDevice, jsData, nowNs);
+        }
+    }
+
+    // Record types of a later version are skipped
+    return false;
+}
+
+// =================================================================================================
+// FindDevice
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CReplaySource::SReplayDevice* CReplaySource::FindDevice(uint32_t deviceId)
+{
+    for (std::unique_ptr<SReplayDevice>& device : m_devices)
+    {
+        if (device->deviceId == deviceId)
+        {
+            return device.get();
+        }
+    }
+    return nullptr;
+}
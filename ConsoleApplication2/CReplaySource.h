@@ -0,0 +1,81 @@
+// =================================================================================================
+// Replay source: plays a capture back through the sink as if the pads were connected, at the
+// recorded timing, a multiple of it, or as fast as the sink takes it.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "IInputSource.h"
+#include "CCaptureReader.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const double REPLAY_SPEED_ORIGINAL = 1.0;
+const double REPLAY_SPEED_UNLIMITED = 0.0;      // no waiting between records
+
+// Records one Poll hands over before returning, so Stop is noticed during an unlimited replay
+const int REPLAY_RECORDS_PER_POLL = 256;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CReplaySource : public IInputSource
+{
+public:
+   // speed scales the recorded gaps between records: 2.0 plays twice as fast
+   CReplaySource(const std::string& path, double speed = REPLAY_SPEED_ORIGINAL);
+
+   // IInputSource
+   bool Open(IInputSink* sink) override;
+   int Poll(int timeoutMs) override;
+   void Wake() override;
+   void Close() override;
+
+   // Every record has been handed over; Poll only waits from now on
+   bool IsFinished() const { return m_finished.load(std::memory_order_acquire); }
+
+private:
+   struct SReplayDevice
+   {
+      uint32_t deviceId;
+      bool attached;
+   };
+
+   bool WaitForWake(uint64_t waitNs);
+   uint64_t ScheduledNs(uint64_t recordNs) const;
+   bool Deliver(const SCaptureRecordView& record, uint64_t nowNs);
+   SReplayDevice* FindDevice(uint32_t deviceId);
+
+
+   const std::string m_path;
+   const double m_speed;
+   CCaptureReader m_reader;
+   IInputSink* m_sink;
+   std::vector<std::unique_ptr<SReplayDevice>> m_devices;    // the addresses are the device keys
+
+   SCaptureRecordView m_next;
+   bool m_hasNext;
+   bool m_started;
+   uint64_t m_firstRecordNs;
+   uint64_t m_startNs;
+   std::atomic<bool> m_finished;
+
+   std::mutex m_wakeMutex;
+   std::condition_variable m_wakeCondition;
+   bool m_wakeRequested;
+};
@@ -0,0 +1,84 @@
+// =================================================================================================
+// Single-writer seqlock. The writer never blocks and readers on any number of threads get a
+// consistent copy of the last published value without taking a lock.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <cstdint>
+#include "AtomicPayload.h"
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+template <typename T>
+class CSeqLock
+{
+public:
+   CSeqLock() : m_sequence(0) {}
+
+   // Writer side, one thread only
+   void Publish(const T& value)
+   {
+      uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+      m_sequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      m_payload.Store(value);
+      m_sequence.store(sequence + 2, std::memory_order_release);
+   }
+
+   // One attempt; false when nothing was published yet or a write overlapped the copy
+   bool TryRead(T& value, uint64_t* version = nullptr) const
+   {
+      uint64_t before = m_sequence.load(std::memory_order_acquire);
+      if (before == 0 || (before & 1) != 0)
+      {
+         return false;
+      }
+
+      m_payload.Load(value);
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (m_sequence.load(std::memory_order_relaxed) != before)
+      {
+         return false;
+      }
+
+      if (version != nullptr)
+      {
+         *version = before / 2;
+      }
+      return true;
+   }
+
+   // Retries until a consistent copy is read; false only when nothing was published yet
+   bool Read(T& value, uint64_t* version = nullptr) const
+   {
+      while (!TryRead(value, version))
+      {
+         if (m_sequence.load(std::memory_order_relaxed) == 0)
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   // Number of completed publications
+   uint64_t Version() const
+   {
+      return m_sequence.load(std::memory_order_acquire) / 2;
+   }
+
+private:
+   alignas(64) std::atomic<uint64_t> m_sequence;    // odd while a write is in progress
+   CAtomicPayload<T> m_payload;
+};
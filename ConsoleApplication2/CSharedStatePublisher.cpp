@@ -0,0 +1,251 @@
+// =================================================================================================
+// Writer of the shared-memory pad state (SharedStateFormat.h): creates the named region, a file
+// mapping on Windows and a POSIX shared memory object on Linux, and publishes into it from the
+// input thread.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CSharedStatePublisher.h"
+#include <cstring>
+#include <new>
+#include "MonotonicClock.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// IsProcessAlive           a process we may not signal still exists
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool IsProcessAlive(uint32_t processId)
+{
+#ifdef _WIN32
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)processId);
+    if (process == NULL)
+    {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill((pid_t)processId, 0) == 0 || errno == EPERM;
+#endif
+}
+
+// =================================================================================================
+// CSharedStatePublisher
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CSharedStatePublisher::CSharedStatePublisher() :
+    m_region(nullptr),
+    m_deviceTable(),
+#ifdef _WIN32
+    m_mapping(NULL)
+#else
+    m_fd(-1)
+#endif
+{
+}
+
+// =================================================================================================
+// ~CSharedStatePublisher
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CSharedStatePublisher::~CSharedStatePublisher()
+{
+    Close();
+}
+
+// =================================================================================================
+// Open                     the region is laid out with the status STARTING and turned LIVE last,
+//                          so a reader that maps it early waits instead of reading half a header
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSharedStatePublisher::Open(const char* name)
+{
+    if (m_region != nullptr || name == nullptr || std::strlen(name) >= SHARED_STATE_MAX_NAME)
+    {
+        return false;
+    }
+
+    void* memory = nullptr;
+#ifdef _WIN32
+    m_name = std::string("Local\\") + name;
+    m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)sizeof(SSharedStateRegion), m_name.c_str());
+    if (m_mapping == NULL)
+    {
+        return false;
+    }
+
+    memory = MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SSharedStateRegion));
+    DWORD processId = GetCurrentProcessId();
+#else
+    m_name = std::string("/") + name;
+    m_fd = shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (m_fd < 0)
+    {
+        return false;
+    }
+
+    if (ftruncate(m_fd, (off_t)sizeof(SSharedStateRegion)) == 0)
+    {
+        void* mapped = mmap(nullptr, sizeof(SSharedStateRegion), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        memory = mapped != MAP_FAILED ? mapped : nullptr;
+    }
+    pid_t processId = getpid();
+#endif
+
+    if (memory == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    // A region left LIVE by a writer that crashed is taken over, one whose writer runs is not
+    SSharedStateHeader* pHeader = (SSharedStateHeader*)memory;
+    if (pHeader->status.load(std::memory_order_acquire) == SHARED_STATE_LIVE &&
+        std::memcmp(pHeader->magic, SHARED_STATE_MAGIC, sizeof(pHeader->magic)) == 0 &&
+        pHeader->writerProcessId != (uint32_t)processId && IsProcessAlive(pHeader->writerProcessId))
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(memory);
+#else
+        munmap(memory, sizeof(SSharedStateRegion));
+        close(m_fd);
+        m_fd = -1;
+#endif
+        Close();
+        return false;
+    }
+
+    // Readers of a previous writer may still hold the mapping; they see STARTING until it is ready
+    pHeader->status.store(SHARED_STATE_STARTING, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_region = new (memory) SSharedStateRegion();
+    SSharedStateHeader& header = m_region->header;
+    std::memcpy(header.magic, SHARED_STATE_MAGIC, sizeof(header.magic));
+    header.version = SHARED_STATE_VERSION;
+    header.headerSize = (uint16_t)sizeof(SSharedStateHeader);
+    header.regionSize = (uint32_t)sizeof(SSharedStateRegion);
+    header.slotCount = SHARED_STATE_SLOTS;
+    header.slotSize = (uint32_t)sizeof(SSharedStateSlot);
+    header.writerProcessId = (uint32_t)processId;
+    header.writerStartNs = MonotonicNowNs();
+
+    m_deviceTable = SSharedDeviceTable();
+    m_region->deviceTable.Publish(m_deviceTable);
+    header.status.store(SHARED_STATE_LIVE, std::memory_order_release);
+    return true;
+}
+
+// =================================================================================================
+// Close                    mapped readers keep the memory until they let go of it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSharedStatePublisher::Close()
+{
+    if (m_region != nullptr)
+    {
+        m_region->header.status.store(SHARED_STATE_CLOSED, std::memory_order_release);
+    }
+
+#ifdef _WIN32
+    if (m_region != nullptr)
+    {
+        UnmapViewOfFile(m_region);
+    }
+    if (m_mapping != NULL)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = NULL;
+    }
+#else
+    if (m_region != nullptr)
+    {
+        munmap(m_region, sizeof(SSharedStateRegion));
+    }
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        shm_unlink(m_name.c_str());
+        m_fd = -1;
+    }
+#endif
+
+    m_region = nullptr;
+    m_name.clear();
+}
+
+// =================================================================================================
+// PublishDevice            arrivals and removals, rare enough to republish the whole table
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSharedStatePublisher::PublishDevice(int playerIndex, uint16_t vendorId, uint16_t productId, bool connected)
+{
+    if (m_region == nullptr || playerIndex < 0 || playerIndex >= SHARED_STATE_SLOTS)
+    {
+        return;
+    }
+
+    SSharedDevice& device = m_deviceTable.devices[playerIndex];
+    device.vendorId = vendorId;
+    device.productId = productId;
+    device.connected = connected ? 1 : 0;
+    if (connected)
+    {
+        device.arrivals++;
+    }
+    m_region->deviceTable.Publish(m_deviceTable);
+}
+
+// =================================================================================================
+// PublishPadState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSharedStatePublisher::PublishPadState(int playerIndex, const SPadState& state)
+{
+    if (m_region == nullptr || playerIndex < 0 || playerIndex >= SHARED_STATE_SLOTS)
+    {
+        return;
+    }
+    m_region->slots[playerIndex].padState.Publish(state);
+}
+
+// =================================================================================================
+// PublishMotion
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSharedStatePublisher::PublishMotion(int playerIndex, const SMotionSample& motion)
+{
+    if (m_region == nullptr || playerIndex < 0 || playerIndex >= SHARED_STATE_SLOTS)
+    {
+        return;
+    }
+    m_region->slots[playerIndex].motion.Publish(motion);
+}
@@ -0,0 +1,53 @@
+// =================================================================================================
+// Writer of the shared-memory pad state (SharedStateFormat.h): creates the named region, a file
+// mapping on Windows and a POSIX shared memory object on Linux, and publishes into it from the
+// input thread.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include <string>
+#include "SharedStateFormat.h"
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CSharedStatePublisher
+{
+public:
+   CSharedStatePublisher();
+   ~CSharedStatePublisher();
+
+   CSharedStatePublisher(const CSharedStatePublisher&) = delete;
+   CSharedStatePublisher& operator=(const CSharedStatePublisher&) = delete;
+
+   // Creates the region or takes over the one a previous writer left; false when it cannot be
+   // created or mapped
+   bool Open(const char* name = SHARED_STATE_DEFAULT_NAME);
+   // Marks the region closed for the readers and removes the name
+   void Close();
+   bool IsOpen() const { return m_region != nullptr; }
+
+   // Input thread only
+   void PublishDevice(int playerIndex, uint16_t vendorId, uint16_t productId, bool connected);
+   void PublishPadState(int playerIndex, const SPadState& state);
+   void PublishMotion(int playerIndex, const SMotionSample& motion);
+
+private:
+   SSharedStateRegion* m_region;
+   SSharedDeviceTable m_deviceTable;   // the writer's copy, published whole on every change
+   std::string m_name;
+#ifdef _WIN32
+   void* m_mapping;
+#else
+   int m_fd;
+#endif
+};
@@ -0,0 +1,248 @@
+// =================================================================================================
+// Reader of the shared-memory pad state (SharedStateFormat.h) for processes other than the one
+// that owns the pads. Maps the region read-only once; every read after that is a seqlock copy out
+// of the mapping, with no system call.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CSharedStateReader.h"
+#include <cstring>
+#include <string>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// A writer that died inside a publication leaves its seqlock odd for good; a read gives up after
+// this many overlapped copies instead of spinning on it
+const int SHARED_STATE_READ_ATTEMPTS = 64;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ReadSeqLock
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+static bool ReadSeqLock(const CSeqLock<T>& seqLock, T& value, uint64_t* version)
+{
+    for (int attempt = 0; attempt < SHARED_STATE_READ_ATTEMPTS; attempt++)
+    {
+        if (seqLock.TryRead(value, version))
+        {
+            return true;
+        }
+        if (seqLock.Version() == 0)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+// =================================================================================================
+// CSharedStateReader
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CSharedStateReader::CSharedStateReader() :
+    m_region(nullptr),
+    m_writerStartNs(0),
+#ifdef _WIN32
+    m_mapping(NULL)
+#else
+    m_fd(-1)
+#endif
+{
+}
+
+// =================================================================================================
+// ~CSharedStateReader
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CSharedStateReader::~CSharedStateReader()
+{
+    Close();
+}
+
+// =================================================================================================
+// Open                     map read-only and check the header once the writer marked it live
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSharedStateReader::Open(const char* name)
+{
+    if (m_region != nullptr || name == nullptr || std::strlen(name) >= SHARED_STATE_MAX_NAME)
+    {
+        return false;
+    }
+
+    const void* memory = nullptr;
+#ifdef _WIN32
+    std::string mappingName = std::string("Local\\") + name;
+    m_mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, mappingName.c_str());
+    if (m_mapping == NULL)
+    {
+        return false;
+    }
+
+    memory = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, sizeof(SSharedStateRegion));
+#else
+    std::string objectName = std::string("/") + name;
+    m_fd = shm_open(objectName.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (m_fd < 0)
+    {
+        return false;
+    }
+
+    // A writer between shm_open and ftruncate leaves the object shorter than the region
+    struct stat objectStat;
+    if (fstat(m_fd, &objectStat) == 0 && objectStat.st_size >= (off_t)sizeof(SSharedStateRegion))
+    {
+        void* mapped = mmap(nullptr, sizeof(SSharedStateRegion), PROT_READ, MAP_SHARED, m_fd, 0);
+        memory = mapped != MAP_FAILED ? mapped : nullptr;
+    }
+#endif
+
+    m_region = (const SSharedStateRegion*)memory;
+    if (m_region == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    const SSharedStateHeader& header = m_region->header;
+    if (header.status.load(std::memory_order_acquire) != SHARED_STATE_LIVE ||
+        std::memcmp(header.magic, SHARED_STATE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SHARED_STATE_VERSION ||
+        header.headerSize != sizeof(SSharedStateHeader) ||
+        header.regionSize != sizeof(SSharedStateRegion) ||
+        header.slotCount != SHARED_STATE_SLOTS ||
+        header.slotSize != sizeof(SSharedStateSlot))
+    {
+        Close();
+        return false;
+    }
+
+    m_writerStartNs = header.writerStartNs;
+    return true;
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSharedStateReader::Close()
+{
+#ifdef _WIN32
+    if (m_region != nullptr)
+    {
+        UnmapViewOfFile(m_region);
+    }
+    if (m_mapping != NULL)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = NULL;
+    }
+#else
+    if (m_region != nullptr)
+    {
+        munmap((void*)m_region, sizeof(SSharedStateRegion));
+    }
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+#endif
+
+    m_region = nullptr;
+    m_writerStartNs = 0;
+}
+
+// =================================================================================================
+// IsLive                   a new writer lays the region out again under the same name
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSharedStateReader::IsLive() const
+{
+    if (m_region == nullptr || m_region->header.status.load(std::memory_order_acquire) != SHARED_STATE_LIVE)
+    {
+        return false;
+    }
+    return m_region->header.writerStartNs == m_writerStartNs;
+}
+
+// =================================================================================================
+// ReadPadState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSharedStateReader::ReadPadState(int playerIndex, SPadState& state, uint64_t* version) const
+{
+    if (!IsLive() || playerIndex < 0 || playerIndex >= SHARED_STATE_SLOTS)
+    {
+        return false;
+    }
+    return ReadSeqLock(m_region->slots[playerIndex].padState, state, version);
+}
+
+// =================================================================================================
+// ReadMotion
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSharedStateReader::ReadMotion(int playerIndex, SMotionSample& motion, uint64_t* version) const
+{
+    if (!IsLive() || playerIndex < 0 || playerIndex >= SHARED_STATE_SLOTS)
+    {
+        return false;
+    }
+    return ReadSeqLock(m_region->slots[playerIndex].motion, motion, version);
+}
+
+// =================================================================================================
+// ReadDeviceTable
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSharedStateReader::ReadDeviceTable(SSharedDeviceTable& table, uint64_t* version) const
+{
+    if (!IsLive())
+    {
+        return false;
+    }
+    return ReadSeqLock(m_region->deviceTable, table, version);
+}
+
+// =================================================================================================
+// GetPadStateVersion       0 while the region is not live
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint64_t CSharedStateReader::GetPadStateVersion(int playerIndex) const
+{
+    if (!IsLive() || playerIndex < 0 || playerIndex >= SHARED_STATE_SLOTS)
+    {
+        return 0;
+    }
+    return m_region->slots[playerIndex].padState.Version();
+}
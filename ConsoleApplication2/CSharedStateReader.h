@@ -0,0 +1,55 @@
+// =================================================================================================
+// Reader of the shared-memory pad state (SharedStateFormat.h) for processes other than the one
+// that owns the pads. Maps the region read-only once; every read after that is a seqlock copy out
+// of the mapping, with no system call.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include "SharedStateFormat.h"
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CSharedStateReader
+{
+public:
+   CSharedStateReader();
+   ~CSharedStateReader();
+
+   CSharedStateReader(const CSharedStateReader&) = delete;
+   CSharedStateReader& operator=(const CSharedStateReader&) = delete;
+
+   // False while no writer has created the region, or when it has another layout version
+   bool Open(const char* name = SHARED_STATE_DEFAULT_NAME);
+   void Close();
+   bool IsOpen() const { return m_region != nullptr; }
+
+   // False once the writer closed or was replaced; Close and Open again to follow the new one
+   bool IsLive() const;
+
+   // Consumers, any thread. False until the writer published for the player, or while the
+   // region is not live; version counts the publications of the player.
+   bool ReadPadState(int playerIndex, SPadState& state, uint64_t* version = nullptr) const;
+   bool ReadMotion(int playerIndex, SMotionSample& motion, uint64_t* version = nullptr) const;
+   bool ReadDeviceTable(SSharedDeviceTable& table, uint64_t* version = nullptr) const;
+   // Publications of the player so far, to poll for news without copying the state
+   uint64_t GetPadStateVersion(int playerIndex) const;
+
+private:
+   const SSharedStateRegion* m_region;
+   uint64_t m_writerStartNs;           // of the writer the region had at Open
+#ifdef _WIN32
+   void* m_mapping;
+#else
+   int m_fd;
+#endif
+};
@@ -13,9 +13,7 @@
 #include "CSonyJoystick.h"
 #include <windows.h>
 #include <iostream>
-#include <hidusage.h>
-#include <hidsdi.h>
-#include <hidpi.h>
+#include "CWin32RawInputSource.h"
 
 // =================================================================================================
 // ========================================= NAMESPACES ============================================
@@ -26,18 +24,18 @@
 // =================================================================================================
 // ====================================== CONSTANTS, ENUMS =========================================
 
+const UINT_PTR RENDER_TIMER_ID = 1;
+const unsigned int DEFAULT_REFRESH_RATE_HZ = 60;   // when the monitor does not report its rate
+const UINT_PTR STATS_TIMER_ID = 2;
+const UINT STATS_REFRESH_MS = 500;
+const uint32_t DISPLAY_STATS_LINES = (1u << DISPLAY_LINE_STATS_RATE) | (1u << DISPLAY_LINE_STATS_LATENCY);
+
 // =================================================================================================
 // ================================ TYPES, CLASSES, STRUCTURES =====================================
 
 // =================================================================================================
 // ================================== STATIC MEMBER VARIABLES ======================================
 
-HDC hdcMem;
-HBITMAP hbmMem, hbmOld;
-
-CSonyJoystick* m_thisClass;
-
-
 // =================================================================================================
 // ===================================== GLOBAL VARIABLES ==========================================
 
@@ -47,18 +45,40 @@ CSonyJoystick* m_thisClass;
 // =================================================================================================
 // ===================================== FUNCTION DEFINITIONS ======================================
 
+// =================================================================================================
+// WindowProc               routes messages to the CSonyJoystick that created the window
+//
+// Author: Eran Yeruham, Date: 28 July 2024
+// -------------------------------------------------------------------------------------------------
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) 
+{
+    if (uMsg == WM_NCCREATE)
+    {
+        CREATESTRUCT* pCreate = (CREATESTRUCT*)lParam;
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)pCreate->lpCreateParams);
+    }
+
+    CSonyJoystick* pJoystick = (CSonyJoystick*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
+    if (pJoystick == NULL)
+    {
+        return DefWindowProc(hwnd, uMsg, wParam, lParam);
+    }
+
+    return pJoystick->HandleWindowMessage(hwnd, uMsg, wParam, lParam);
+}
+
+// =================================================================================================
+// HandleWindowMessage
+//
+// Author: Eran Yeruham, Date: 28 July 2024
+// -------------------------------------------------------------------------------------------------
+LRESULT CSonyJoystick::HandleWindowMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
     switch (uMsg)
     {
         case WM_ERASEBKGND:
             return 1; // Prevent flickering by not erasing the background
 
-        case WM_INPUT:
-            m_thisClass->ProcessRawInput((HRAWINPUT)lParam);
-            InvalidateRect(hwnd, NULL, TRUE); // Request to redraw the window
-            break;
-        
         case WM_DESTROY:
             PostQuitMessage(0);
             return 0;
@@ -66,46 +86,66 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
         case WM_SIZE:
         {
             // Resize the memory DC and bitmap when the window is resized
-            if (hdcMem) 
+            if (m_hdcMem) 
             {
                 HDC hdc = GetDC(hwnd);
                 RECT rect;
                 GetClientRect(hwnd, &rect);
 
                 HBITMAP hbmNew = CreateCompatibleBitmap(hdc, rect.right, rect.bottom);
-                SelectObject(hdcMem, hbmNew);
-                DeleteObject(hbmMem);
+                SelectObject(m_hdcMem, hbmNew);
+                DeleteObject(m_hbmMem);
 
-                hbmMem = hbmNew;
+                m_hbmMem = hbmNew;
                 ReleaseDC(hwnd, hdc);
+
+                // The new bitmap is blank, everything is drawn again on the next paint
+                FillRect(m_hdcMem, &rect, (HBRUSH)GetStockObject(WHITE_BRUSH));
+                m_displayDiff.Invalidate();
+                InvalidateRect(hwnd, NULL, FALSE);
             }
         }
         break;
-        
+
+        case WM_DISPLAYCHANGE:
+            // Follow a mode change of the monitor unless a fixed rate was asked for
+            if (m_refreshRateHz == 0)
+            {
+                SetRefreshRate(0);
+            }
+            break;
+
+        case WM_TIMER:
+        {
+            if (wParam == STATS_TIMER_ID)
+            {
+                UpdateStats(hwnd);
+                return 0;
+            }
+            if (wParam != RENDER_TIMER_ID)
+            {
+                break;
+            }
+
+            // Only the bands of the lines that changed since the last frame reach WM_PAINT
+            InvalidateLines(hwnd, UpdateBackBuffer(hwnd));
+            return 0;
+        }
+
         case WM_PAINT:
         {
             PAINTSTRUCT ps;
             HDC hdc = BeginPaint(hwnd, &ps);
-            RECT rect;
-            GetClientRect(hwnd, &rect);
 
-            // Create memory DC and bitmap if they don't exist
-            if (!hdcMem) 
+            // The back buffer is drawn by the render timer, painting only copies the damaged part
+            UpdateBackBuffer(hwnd);
+            if (m_hdcMem)
             {
-                hdcMem = CreateCompatibleDC(hdc);
-                hbmMem = CreateCompatibleBitmap(hdc, rect.right, rect.bottom);
-                hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
+                BitBlt(hdc, ps.rcPaint.left, ps.rcPaint.top,
+                    ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+                    m_hdcMem, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
             }
 
-            // Clear the memory DC
-            FillRect(hdcMem, &rect, (HBRUSH)GetStockObject(WHITE_BRUSH));
-
-            // Draw on the memory DC
-            m_thisClass->DrawTextOnDC(hdcMem);
-
-            // Copy the memory DC to the screen
-            BitBlt(hdc, 0, 0, rect.right, rect.bottom, hdcMem, 0, 0, SRCCOPY);
-
             EndPaint(hwnd, &ps);
             break;
         }
@@ -116,224 +156,116 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 
 // =================================================================================================
-// CSonyJoystick
+// CSonyJoystick            input starts here for the callers that predate Start
 //
 // Author: Eran Yeruham, Date: 28 July 2024
 // -------------------------------------------------------------------------------------------------
-CSonyJoystick::CSonyJoystick(std::function<void(JSDATA)> callBackUpdate)
+CSonyJoystick::CSonyJoystick(std::function<void(JSDATA)> callBackUpdate) :
+    m_captureSink(&m_core),
+    m_hdcMem(NULL),
+    m_hbmMem(NULL),
+    m_hbmOld(NULL),
+    m_refreshRateHz(0),
+    m_showStats(false),
+    m_statsSummary()
 {
-    m_thisClass = this;
-    m_hwnd = InitDummyWindow();
-    RegisterInputDevices(m_hwnd);
+    std::function<void(int, JSDATA)> playerCallback;
+    if (callBackUpdate)
+    {
+        playerCallback = [callBackUpdate](int, JSDATA jsData) { callBackUpdate(jsData); };
+    }
 
-    m_CallbackUpdater = callBackUpdate;
+    Init(playerCallback, JOYSTICK_DATA_WINDOW);
+    Start();
 }
 
 // =================================================================================================
-// ~CSonyJoystick
+// CSonyJoystick
 //
-// Author: Eran Yeruham, Date: 28 July 2024
+// Author: Eran Yeruham, Date: 17 October 2026
 // -------------------------------------------------------------------------------------------------
-CSonyJoystick::~CSonyJoystick()
+CSonyJoystick::CSonyJoystick(std::function<void(int, JSDATA)> callBackUpdate, EJoystickWindow window) :
+    m_captureSink(&m_core),
+    m_hdcMem(NULL),
+    m_hbmMem(NULL),
+    m_hbmOld(NULL),
+    m_refreshRateHz(0),
+    m_showStats(false),
+    m_statsSummary()
 {
-    if (hdcMem) 
-    {
-        SelectObject(hdcMem, hbmOld);
-        DeleteDC(hdcMem);
-        DeleteObject(hbmMem);
-    }
+    Init(callBackUpdate, window);
 }
 
 // =================================================================================================
-// ProcessRawInput
+// Init
 //
-// Author: Eran Yeruham, Date: 28 July 2024
+// Author: Eran Yeruham, Date: 17 October 2026
 // -------------------------------------------------------------------------------------------------
-bool CSonyJoystick::ProcessRawInput(HRAWINPUT hRawInput)
+void CSonyJoystick::Init(std::function<void(int, JSDATA)> callBackUpdate, EJoystickWindow window)
 {
-    UINT dwSize;
-    GetRawInputData(hRawInput, RID_INPUT, NULL, &dwSize, sizeof(RAWINPUTHEADER));
+    m_hwnd = window == JOYSTICK_DATA_WINDOW ? InitDummyWindow() : NULL;
 
-    LPBYTE lpb = new BYTE[dwSize];
-    if (lpb == NULL) 
-    {
-        return false;
-    }
+    // Runs on the input thread. The window no longer repaints per report, its render timer picks
+    // up the latest state at the refresh rate.
+    m_core.SetCallback(callBackUpdate);
 
-    if (GetRawInputData(hRawInput, RID_INPUT, lpb, &dwSize, sizeof(RAWINPUTHEADER)) != dwSize) 
+    if (m_hwnd)
     {
-        delete[] lpb;
-        return false;
+        SetRefreshRate(0);
     }
+}
 
-    RAWINPUT* raw = (RAWINPUT*)lpb;
-    if (raw->header.dwType == RIM_TYPEHID) 
-    {
-        UINT cbSize = 0;
-
-        // Query the required buffer size for the preparsed data
-        if (GetRawInputDeviceInfo(raw->header.hDevice, RIDI_PREPARSEDDATA, NULL, &cbSize) != 0) 
-        {
-            delete[] lpb;
-            return false;
-        }
-
-        // Allocate the buffer for the preparsed data
-        PHIDP_PREPARSED_DATA pPreparsedData = (PHIDP_PREPARSED_DATA)new BYTE[cbSize];
-        if (pPreparsedData == NULL) 
-        {
-            delete[] lpb;
-            return false;
-        }
-
-        // Get the preparsed data
-        if (GetRawInputDeviceInfo(raw->header.hDevice, RIDI_PREPARSEDDATA, pPreparsedData, &cbSize) == -1) 
-        {
-            delete[] lpb;
-            delete[] pPreparsedData;
-            return false;
-        }
-
-        HIDP_CAPS caps;
-        if (HidP_GetCaps(pPreparsedData, &caps) == HIDP_STATUS_SUCCESS)
-        {
-            USHORT numValues = caps.NumberInputValueCaps;
-            USHORT numButtons = caps.NumberInputButtonCaps;
-
-
-            HIDP_VALUE_CAPS* valueCaps = new HIDP_VALUE_CAPS[numValues];
-            HIDP_BUTTON_CAPS* buttonCaps = new HIDP_BUTTON_CAPS[numButtons];
-
-
-            if (HidP_GetValueCaps(HidP_Input, valueCaps, &numValues, pPreparsedData) != HIDP_STATUS_SUCCESS) 
-            {
-                delete[] valueCaps;
-                delete[] buttonCaps;
-                delete[] pPreparsedData;
-                delete[] lpb;
-                return false;
-            }
-
-            if (HidP_GetButtonCaps(HidP_Input, buttonCaps, &numButtons, pPreparsedData) != HIDP_STATUS_SUCCESS)
-            {
-                delete[] valueCaps;
-                delete[] buttonCaps;
-                delete[] pPreparsedData;
-                delete[] lpb;
-                return false;
-            }
+// =================================================================================================
+// Start                    open raw input on a dedicated thread behind a message-only window
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::Start(EInputThreadPriority priority)
+{
+    bool batchedRead = m_core.IsBatched();
+    IInputSink* sink = m_captureSink.GetWriter().IsOpen() ? (IInputSink*)&m_captureSink : &m_core;
 
-            for (USHORT i = 0; i < numValues - 1; i++)
-            {
-                ULONG value;
-                if (valueCaps[i].Range.UsageMin == HID_USAGE_GENERIC_X)
-                {
-                    if (HidP_GetUsageValue(HidP_Input, valueCaps[i].UsagePage, 0, HID_USAGE_GENERIC_X, &value, pPreparsedData, (PCHAR)raw->data.hid.bRawData, raw->data.hid.dwSizeHid) == HIDP_STATUS_SUCCESS) {
-                        m_jsData.leftX = value;
-                    }
-                    else
-                    {
-                        int err = GetLastError();
-                    }
-                }
-                else if (valueCaps[i].Range.UsageMin == HID_USAGE_GENERIC_Y)
-                {
-                    if (HidP_GetUsageValue(HidP_Input, valueCaps[i].UsagePage, 0, HID_USAGE_GENERIC_Y, &value, pPreparsedData, (PCHAR)raw->data.hid.bRawData, raw->data.hid.dwSizeHid) == HIDP_STATUS_SUCCESS) {
-                        m_jsData.leftY = value;
-                    }
-                    else
-                    {
-                    }
-                }
-                else if (valueCaps[i].Range.UsageMin == HID_USAGE_GENERIC_Z)
-                {
-                    if (HidP_GetUsageValue(HidP_Input, valueCaps[i].UsagePage, 0, HID_USAGE_GENERIC_Z, &value, pPreparsedData, (PCHAR)raw->data.hid.bRawData, raw->data.hid.dwSizeHid) == HIDP_STATUS_SUCCESS) 
-                    {
-                        m_jsData.rightX = value;
-                    }
-                    else
-                    {
-                    }
-                }
-                else if (valueCaps[i].Range.UsageMin == HID_USAGE_GENERIC_RX)
-                {
-                    if (HidP_GetUsageValue(HidP_Input, valueCaps[i].UsagePage, 0, HID_USAGE_GENERIC_RX, &value, pPreparsedData, (PCHAR)raw->data.hid.bRawData, raw->data.hid.dwSizeHid) == HIDP_STATUS_SUCCESS) 
-                    {
-                        m_jsData.L2 = value;
-                    }
-                    else 
-                    {
-                    }
-                }
-                else if (valueCaps[i].Range.UsageMin == HID_USAGE_GENERIC_RY)
-                {
-                    if (HidP_GetUsageValue(HidP_Input, valueCaps[i].UsagePage, 0, HID_USAGE_GENERIC_RY, &value, pPreparsedData, (PCHAR)raw->data.hid.bRawData, raw->data.hid.dwSizeHid) == HIDP_STATUS_SUCCESS) 
-                    {
-                        m_jsData.R2 = value;
-                    }
-                    else 
-                    {
-                    }
-                }
-                else if (valueCaps[i].Range.UsageMin == HID_USAGE_GENERIC_RZ)
-                {
-                    if (HidP_GetUsageValue(HidP_Input, valueCaps[i].UsagePage, 0, HID_USAGE_GENERIC_RZ, &value, pPreparsedData, (PCHAR)raw->data.hid.bRawData, raw->data.hid.dwSizeHid) == HIDP_STATUS_SUCCESS) {
-                        m_jsData.rightY = value;
-                    }
-                    else 
-                    {
-                    }
-                }
-                else if (valueCaps[i].Range.UsageMin == HID_USAGE_GENERIC_HATSWITCH)
-                {
-                    if (HidP_GetUsageValue(HidP_Input, valueCaps[i].UsagePage, 0, HID_USAGE_GENERIC_HATSWITCH, &value, pPreparsedData, (PCHAR)raw->data.hid.bRawData, raw->data.hid.dwSizeHid) == HIDP_STATUS_SUCCESS) {
-                        m_jsData.arrowValue = value;
-                    }
-                }
-            }
+    return m_inputThread.Start([batchedRead]()
+    {
+        std::unique_ptr<CWin32RawInputSource> source(new CWin32RawInputSource());
+        source->SetBatchedRead(batchedRead);
+        return std::unique_ptr<IInputSource>(std::move(source));
+    }, sink, priority);
+}
 
-            for (ULONG j = 0; j < BUTTONS_NUM; j++)
-            {
-                m_jsData.HandlePressed[j] = false;
+// =================================================================================================
+// Stop                     no callback runs once this returns
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSonyJoystick::Stop()
+{
+    m_inputThread.Stop();
+    m_captureSink.Close();
+}
 
-            }
-            for (USHORT i = 0; i < numButtons; i++)
-            {
-                if (buttonCaps[i].UsagePage == HID_USAGE_PAGE_BUTTON)
-                {
-                    ULONG buttonUsageMin = buttonCaps[i].Range.UsageMin;
-                    ULONG buttonUsageMax = buttonCaps[i].Range.UsageMax;
-                    USHORT numUsages = USHORT(buttonUsageMax - buttonUsageMin + 1);
-
-                    USAGE* usages = new USAGE[numUsages];
-                    ULONG usageLength = numUsages;
-
-                    if (HidP_GetUsages(HidP_Input, buttonCaps[i].UsagePage, 0, usages, &usageLength, pPreparsedData, (PCHAR)raw->data.hid.bRawData, raw->data.hid.dwSizeHid) == HIDP_STATUS_SUCCESS)
-                    {
-                        for (ULONG j = 0; j < usageLength; j++)
-                        {
-                            if (usages[j])
-                            { 
-                                m_jsData.HandlePressed[*usages - 1] = true;
-                                break;
-                            }
-                        }
-                    }
-
-                    delete[] usages;
-                }
-            }
-            delete[] valueCaps;
-        }
+// =================================================================================================
+// ~CSonyJoystick
+//
+// Author: Eran Yeruham, Date: 28 July 2024
+// -------------------------------------------------------------------------------------------------
+CSonyJoystick::~CSonyJoystick()
+{
+    Stop();
 
-        delete[] pPreparsedData;
+    if (m_hwnd)
+    {
+        KillTimer(m_hwnd, RENDER_TIMER_ID);
+        KillTimer(m_hwnd, STATS_TIMER_ID);
+        DestroyWindow(m_hwnd);
     }
 
-    delete[] lpb;
-
-    m_CallbackUpdater(m_jsData);
-
-    return true;
+    if (m_hdcMem) 
+    {
+        SelectObject(m_hdcMem, m_hbmOld);
+        DeleteDC(m_hdcMem);
+        DeleteObject(m_hbmMem);
+    }
 }
 
 // =================================================================================================
@@ -360,7 +292,8 @@ HWND CSonyJoystick::InitDummyWindow()
     wc.lpszClassName = L"RawInputExample";
     wc.hIconSm = LoadIcon(NULL, IDI_APPLICATION);
 
-    if (!RegisterClassEx(&wc))
+    // A second instance finds the class already registered
+    if (!RegisterClassEx(&wc) && GetLastError() != ERROR_CLASS_ALREADY_EXISTS)
     {
         return 0;
     }
@@ -370,8 +303,8 @@ HWND CSonyJoystick::InitDummyWindow()
         L"RawInputExample",
         L"Raw Input Example",
         WS_OVERLAPPEDWINDOW,
-        CW_USEDEFAULT, CW_USEDEFAULT, 280, 450,
-        NULL, NULL, hInstance, NULL);
+        CW_USEDEFAULT, CW_USEDEFAULT, 280, 520,
+        NULL, NULL, hInstance, this);
 
     if (hwnd == NULL)
     {
@@ -382,61 +315,252 @@ HWND CSonyJoystick::InitDummyWindow()
 }
 
 // =================================================================================================
-// RegisterInputDevices
+// DrawTextOnDC             all lines of the player that reported last
 //
 // Author: Eran Yeruham, Date: 28 July 2024
 // -------------------------------------------------------------------------------------------------
-bool CSonyJoystick::RegisterInputDevices(HWND hwnd)
+void CSonyJoystick::DrawTextOnDC(HDC hdc)
 {
-    RAWINPUTDEVICE rid[1];
-    rid[0].usUsagePage = 0x01; // Generic Desktop Controls
-    rid[0].usUsage = 0x05;     // Game Pad
-    rid[0].dwFlags = RIDEV_INPUTSINK;
-    rid[0].hwndTarget = hwnd;
+    int playerIndex = m_core.GetLastPlayerIndex();
+    SJoystickSample sample;
+    m_core.GetLatestState(playerIndex, sample);
 
-    if (RegisterRawInputDevices(rid, 1, sizeof(rid[0])) == FALSE) 
+    DrawLines(hdc, sample.data, playerIndex, m_core.GetConnectedCount(), DISPLAY_ALL_LINES);
+}
+
+// =================================================================================================
+// DrawLines                the text of the lines in the mask, each on a cleared band
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSonyJoystick::DrawLines(HDC hdc, const JSDATA& jsData, int playerIndex, int connectedCount, uint32_t lineMask)
+{
+    RECT client = { 0, 0, 0, 0 };
+    if (m_hwnd)
     {
-        return false;
+        GetClientRect(m_hwnd, &client);
+    }
+
+    TCHAR buffer[256];
+    for (int line = 0; line < DISPLAY_LINE_COUNT; line++)
+    {
+        if (!(lineMask & (1u << line)))
+        {
+            continue;
+        }
+
+        switch (line)
+        {
+            case DISPLAY_LINE_LEFT_X:   _stprintf_s(buffer, _T("Left X: %ld"), (long)jsData.leftX); break;
+            case DISPLAY_LINE_LEFT_Y:   _stprintf_s(buffer, _T("Left Y: %ld"), (long)jsData.leftY); break;
+            case DISPLAY_LINE_RIGHT_X:  _stprintf_s(buffer, _T("Right X: %ld"), (long)jsData.rightX); break;
+            case DISPLAY_LINE_RIGHT_Y:  _stprintf_s(buffer, _T("Right Y: %ld"), (long)jsData.rightY); break;
+            case DISPLAY_LINE_R2:       _stprintf_s(buffer, _T("R2: %ld"), (long)jsData.R2); break;
+            case DISPLAY_LINE_L2:       _stprintf_s(buffer, _T("L2: %ld "), (long)jsData.L2); break;
+            case DISPLAY_LINE_ARROW:    _stprintf_s(buffer, _T("Arrow: %d"), jsData.arrowValue); break;
+            case DISPLAY_LINE_PLAYER:
+                _stprintf_s(buffer, _T("Player: %d (%d connected)"), playerIndex + 1, connectedCount);
+                break;
+            case DISPLAY_LINE_STATS_RATE:
+                buffer[0] = 0;
+                if (m_showStats)
+                {
+                    _stprintf_s(buffer, _T("Rate: %.0f/s  lost: %llu  bad: %llu"), m_statsSummary.reportsPerSecond,
+                        (unsigned long long)m_statsSummary.queueDrops, (unsigned long long)m_statsSummary.decodeFailures);
+                }
+                break;
+            case DISPLAY_LINE_STATS_LATENCY:
+                buffer[0] = 0;
+                if (m_showStats)
+                {
+                    _stprintf_s(buffer, _T("Latency us: %.1f / %.1f / %.1f"), m_statsSummary.latencyP50Us,
+                        m_statsSummary.latencyP99Us, m_statsSummary.latencyP999Us);
+                }
+                break;
+            default:
+                _stprintf_s(buffer, _T("Button Pressed: %s\n"),
+                    jsData.HandlePressed[line - DISPLAY_LINE_BUTTON_FIRST] ? _T("Yes") : _T("No"));
+                break;
+        }
+
+        // Shorter text must not leave the tail of the previous one behind
+        SDisplayRect band = GetDisplayLineRect(line, client.right);
+        RECT rect = { band.left, band.top, band.right, band.bottom };
+        FillRect(hdc, &rect, (HBRUSH)GetStockObject(WHITE_BRUSH));
+        TextOut(hdc, DISPLAY_TEXT_LEFT, band.top, buffer, (int)_tcslen(buffer));
     }
-    
-    return true;
 }
 
 // =================================================================================================
-// DrawTextOnDC
+// UpdateBackBuffer         creates the memory DC on first use and redraws the lines that differ
+//                          from what it holds. Returns the mask of redrawn lines.
 //
-// Author: Eran Yeruham, Date: 28 July 2024
+// Author: Eran Yeruham, Date: 17 October 2026
 // -------------------------------------------------------------------------------------------------
-void CSonyJoystick::DrawTextOnDC(HDC hdc)
+uint32_t CSonyJoystick::UpdateBackBuffer(HWND hwnd)
 {
-    // Create a string with the joystick state
-    TCHAR buffer[256];
-    _stprintf_s(buffer, _T("Left X: %ld"), m_jsData.leftX);
-    TextOut(hdc, 10, 10, buffer, (int)_tcslen(buffer));
+    if (!m_hdcMem)
+    {
+        HDC hdc = GetDC(hwnd);
+        RECT rect;
+        GetClientRect(hwnd, &rect);
 
-    _stprintf_s(buffer, _T("Left Y: %ld"), m_jsData.leftY);
-    TextOut(hdc, 10, 30, buffer, (int)_tcslen(buffer));
+        m_hdcMem = CreateCompatibleDC(hdc);
+        m_hbmMem = CreateCompatibleBitmap(hdc, rect.right, rect.bottom);
+        m_hbmOld = (HBITMAP)SelectObject(m_hdcMem, m_hbmMem);
+        ReleaseDC(hwnd, hdc);
 
-    _stprintf_s(buffer, _T("Right X: %ld"), m_jsData.rightX);
-    TextOut(hdc, 10, 50, buffer, (int)_tcslen(buffer));
+        FillRect(m_hdcMem, &rect, (HBRUSH)GetStockObject(WHITE_BRUSH));
+        m_displayDiff.Invalidate();
+    }
 
-    _stprintf_s(buffer, _T("Right Y: %ld"), m_jsData.rightY);
-    TextOut(hdc, 10, 70, buffer, (int)_tcslen(buffer));
+    int playerIndex = m_core.GetLastPlayerIndex();
+    SJoystickSample sample;
+    m_core.GetLatestState(playerIndex, sample);
+    int connectedCount = m_core.GetConnectedCount();
 
-    _stprintf_s(buffer, _T("R2: %ld"), m_jsData.R2);
-    TextOut(hdc, 10, 90, buffer, (int)_tcslen(buffer));
+    uint32_t dirty = m_displayDiff.Update(sample.data, playerIndex, connectedCount);
+    if (dirty != 0)
+    {
+        DrawLines(m_hdcMem, sample.data, playerIndex, connectedCount, dirty);
+    }
+    return dirty;
+}
 
-    _stprintf_s(buffer, _T("L2: %ld "), m_jsData.L2);
-    TextOut(hdc, 10, 110, buffer, (int)_tcslen(buffer));
+// =================================================================================================
+// InvalidateLines          hand the bands of the lines in the mask to WM_PAINT
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSonyJoystick::InvalidateLines(HWND hwnd, uint32_t lineMask)
+{
+    if (lineMask == 0)
+    {
+        return;
+    }
+
+    RECT client;
+    GetClientRect(hwnd, &client);
+    for (int line = 0; line < DISPLAY_LINE_COUNT; line++)
+    {
+        if (lineMask & (1u << line))
+        {
+            SDisplayRect band = GetDisplayLineRect(line, client.right);
+            RECT rect = { band.left, band.top, band.right, band.bottom };
+            InvalidateRect(hwnd, &rect, FALSE);
+        }
+    }
+}
+
+// =================================================================================================
+// UpdateStats              stats timer: summarize the last interval of the shown player and redraw
+//                          its two lines
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSonyJoystick::UpdateStats(HWND hwnd)
+{
+    if (!m_showStats || !m_core.GetStatsSnapshot(*m_statsCurrent))
+    {
+        return;
+    }
+
+    SummarizeStats(*m_statsPrevious, *m_statsCurrent, m_core.GetLastPlayerIndex(), m_statsSummary);
+    m_statsPrevious.swap(m_statsCurrent);
+
+    if (m_hdcMem)
+    {
+        int playerIndex = m_core.GetLastPlayerIndex();
+        SJoystickSample sample;
+        m_core.GetLatestState(playerIndex, sample);
+        DrawLines(m_hdcMem, sample.data, playerIndex, m_core.GetConnectedCount(), DISPLAY_STATS_LINES);
+        InvalidateLines(hwnd, DISPLAY_STATS_LINES);
+    }
+}
+
+// =================================================================================================
+// ShowStats
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::ShowStats(bool show)
+{
+    if (!m_hwnd)
+    {
+        return false;
+    }
+
+    if (show)
+    {
+        if (!m_statsPrevious)
+        {
+            m_statsPrevious.reset(new SJoystickStatsSnapshot);
+            m_statsCurrent.reset(new SJoystickStatsSnapshot);
+        }
+        if (!m_core.GetStatsSnapshot(*m_statsPrevious))
+        {
+            return false;
+        }
+
+        m_statsSummary = SStatsSummary();
+        m_showStats = true;
+        SetTimer(m_hwnd, STATS_TIMER_ID, STATS_REFRESH_MS, NULL);
+    }
+    else
+    {
+        KillTimer(m_hwnd, STATS_TIMER_ID);
+        m_showStats = false;
+    }
+
+    // Shown blank until the first interval is over, cleared when turned off
+    m_displayDiff.Invalidate();
+    InvalidateRect(m_hwnd, NULL, FALSE);
+    return true;
+}
 
-    _stprintf_s(buffer, _T("Arrow: %d"), m_jsData.arrowValue);
-    TextOut(hdc, 10, 130, buffer, (int)_tcslen(buffer));
+// =================================================================================================
+// SetRefreshRate           redraws per second of the data window, 0 follows the monitor it is on
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSonyJoystick::SetRefreshRate(unsigned int hz)
+{
+    if (!m_hwnd)
+    {
+        return;
+    }
 
-    for (int i=0; i< BUTTONS_NUM; i++)
+    m_refreshRateHz = hz;
+    unsigned int rate = hz != 0 ? hz : GetMonitorRefreshRate(m_hwnd);
+
+    // Replaces the running timer; USER_TIMER_MINIMUM bounds the fastest rate
+    UINT interval = (1000 + rate - 1) / rate;
+    SetTimer(m_hwnd, RENDER_TIMER_ID, interval, NULL);
+}
+
+// =================================================================================================
+// GetMonitorRefreshRate    current mode of the monitor holding the window
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+unsigned int CSonyJoystick::GetMonitorRefreshRate(HWND hwnd)
+{
+    MONITORINFOEX monitorInfo;
+    monitorInfo.cbSize = sizeof(monitorInfo);
+    if (!GetMonitorInfo(MonitorFromWindow(hwnd, MONITOR_DEFAULTTOPRIMARY), &monitorInfo))
+    {
+        return DEFAULT_REFRESH_RATE_HZ;
+    }
+
+    DEVMODE mode = {};
+    mode.dmSize = sizeof(mode);
+    if (!EnumDisplaySettings(monitorInfo.szDevice, ENUM_CURRENT_SETTINGS, &mode))
     {
-        _stprintf_s(buffer, _T("Button Pressed: %s\n"), m_jsData.HandlePressed[i] ? _T("Yes") : _T("No"));
-        TextOut(hdc, 10, 160 + i*20, buffer, (int)_tcslen(buffer));
+        return DEFAULT_REFRESH_RATE_HZ;
     }
+
+    // 0 and 1 both mean the hardware default
+    return mode.dmDisplayFrequency > 1 ? mode.dmDisplayFrequency : DEFAULT_REFRESH_RATE_HZ;
 }
 
 // =================================================================================================
@@ -446,5 +570,173 @@ void CSonyJoystick::DrawTextOnDC(HDC hdc)
 // -------------------------------------------------------------------------------------------------
 void CSonyJoystick::ShowDataWindow()
 {
-    ShowWindow(m_hwnd, SW_SHOW);
-}
\ No newline at end of file
+    if (m_hwnd)
+    {
+        ShowWindow(m_hwnd, SW_SHOW);
+    }
+}
+
+// =================================================================================================
+// EnableSampleQueue        the input thread pushes into the ring without a lock, so it is only
+//                          replaced while the thread is not running
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::EnableSampleQueue(size_t capacity, ERingOverflowPolicy policy)
+{
+    if (m_inputThread.IsRunning())
+    {
+        return false;
+    }
+    m_core.EnableSampleQueue(capacity, policy);
+    return true;
+}
+
+// =================================================================================================
+// GetSampleQueue           NULL until EnableSampleQueue was called
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CSpscRing<SJoystickSample>* CSonyJoystick::GetSampleQueue()
+{
+    return m_core.GetSampleQueue();
+}
+
+// =================================================================================================
+// EnableCapture            raw reports go to the file as the device sent them, written by a
+//                          thread of the capture writer
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::EnableCapture(const char* path)
+{
+    if (m_inputThread.IsRunning())
+    {
+        return false;
+    }
+    return m_captureSink.Open(path);
+}
+
+// =================================================================================================
+// EnableSharedState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::EnableSharedState(const char* name)
+{
+    if (m_inputThread.IsRunning())
+    {
+        return false;
+    }
+    return m_core.EnableSharedState(name);
+}
+
+// =================================================================================================
+// EnableStateServer
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::EnableStateServer(const SStateServerConfig& config)
+{
+    if (m_inputThread.IsRunning())
+    {
+        return false;
+    }
+    return m_core.EnableStateServer(config);
+}
+
+// =================================================================================================
+// EnableOutput
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::EnableOutput(const SPadOutputConfig& config)
+{
+    if (m_inputThread.IsRunning())
+    {
+        return false;
+    }
+    m_core.EnableOutput(config);
+    return true;
+}
+
+// =================================================================================================
+// EnableCombos
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::EnableCombos(const std::vector<SComboDefinition>& combos, std::function<void(const SComboEvent*, size_t)> callback)
+{
+    if (m_inputThread.IsRunning())
+    {
+        return false;
+    }
+    return m_core.EnableCombos(combos, callback);
+}
+
+// =================================================================================================
+// SetRumble
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::SetRumble(int playerIndex, uint8_t strongMotor, uint8_t weakMotor)
+{
+    return m_core.SetRumble(playerIndex, strongMotor, weakMotor);
+}
+
+// =================================================================================================
+// SetLightbar
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::SetLightbar(int playerIndex, uint8_t red, uint8_t green, uint8_t blue)
+{
+    return m_core.SetLightbar(playerIndex, red, green, blue);
+}
+
+// =================================================================================================
+// SetLightbarFlash
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::SetLightbarFlash(int playerIndex, unsigned int onMs, unsigned int offMs)
+{
+    return m_core.SetLightbarFlash(playerIndex, onMs, offMs);
+}
+
+// =================================================================================================
+// EnableBatchedInput       drain every pending report per WM_INPUT wakeup through GetRawInputBuffer.
+//                          batchCallback (optional) receives the delivered samples of each wakeup.
+//                          Start hands the read mode to the source, so it is refused once running.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::EnableBatchedInput(EBatchDelivery delivery, std::function<void(const SJoystickSample*, size_t)> batchCallback)
+{
+    if (m_inputThread.IsRunning())
+    {
+        return false;
+    }
+    m_core.EnableBatchedDelivery(delivery, batchCallback);
+    return true;
+}
+
+// =================================================================================================
+// GetLatestState           false until the player reported for the first time
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSonyJoystick::GetLatestState(int playerIndex, SJoystickSample& sample, uint64_t* version) const
+{
+    return m_core.GetLatestState(playerIndex, sample, version);
+}
+
+// =================================================================================================
+// GetConnectedCount
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CSonyJoystick::GetConnectedCount() const
+{
+    return m_core.GetConnectedCount();
+}
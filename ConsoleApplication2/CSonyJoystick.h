@@ -14,7 +14,14 @@
 
 #include <windows.h>
 #include <functional>
+#include <memory>
 #include <tchar.h>
+#include "JSData.h"
+#include "CJoystickCore.h"
+#include "CInputThread.h"
+#include "CCaptureSink.h"
+#include "CJoystickStats.h"
+#include "DisplayDiff.h"
 
 
 // =================================================================================================
@@ -23,57 +30,99 @@
 // =================================================================================================
 // ====================================== CONSTANTS, ENUMS =========================================
 
-const int BUTTONS_NUM = 12;
-
-// =================================================================================================
-// ================================= TYPES, CLASSES, STRUCTURES ====================================
-
-struct JSDATA
+enum EJoystickWindow
 {
-	LONG leftX;
-	LONG leftY;
-	LONG rightX;
-	LONG rightY;
-	LONG L2;
-	LONG R2;
-	bool HandlePressed[BUTTONS_NUM];
-	int arrowValue;
-
-	JSDATA() :
-			leftX(0),
-			leftY(0),
-			rightX(0),
-			rightY(0),
-			L2(0),
-			R2(0),
-		    arrowValue(-1)
-	{
-		for (int i=0;i< BUTTONS_NUM;i++)
-		{
-			HandlePressed[i] = false;
-		}
-	}
+	JOYSTICK_DATA_WINDOW,   // the visual window is created, ShowDataWindow shows it
+	JOYSTICK_HEADLESS       // no window and no GDI, input and callbacks only
 };
 
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
 
 class CSonyJoystick
 {
 public:
+	// Legacy: starts input at once, as it did before Start existed, so every Enable* below
+	// returns false on it, as does a Start of its own
 	CSonyJoystick(std::function<void(JSDATA)> callBackUpdate);
+	CSonyJoystick(std::function<void(int, JSDATA)> callBackUpdate, EJoystickWindow window = JOYSTICK_DATA_WINDOW);    // called with the player index
    ~CSonyJoystick();
 
-   bool ProcessRawInput(HRAWINPUT hRawInput);
+   // Raw input runs on its own thread with a message-only window; the callbacks are called there.
+   // Configure the queue and batching before Start.
+   bool Start(EInputThreadPriority priority = INPUT_THREAD_NORMAL);
+   void Stop();
+
+   LRESULT HandleWindowMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
    void DrawTextOnDC(HDC hdc);
    void ShowDataWindow();
 
+   // The data window redraws the changed lines at most this often; 0 (the default) uses the
+   // refresh rate of the monitor it is on
+   void SetRefreshRate(unsigned int hz);
+
+   // Report rate, losses and delivery latency of the shown player below the player line, refreshed
+   // twice a second. False when the core was built without statistics.
+   bool ShowStats(bool show);
+
+   // Decoded samples are also pushed into a lock-free queue for a consumer thread; call before Start
+   bool EnableSampleQueue(size_t capacity, ERingOverflowPolicy policy);
+   CSpscRing<SJoystickSample>* GetSampleQueue();
+
+   // Records every raw report to a capture file (CaptureFormat.h) until Stop; call before Start
+   bool EnableCapture(const char* path);
+
+   // Makes the state of every player readable by other processes through CSharedStateReader,
+   // without a raw input registration of their own; call before Start
+   bool EnableSharedState(const char* name = SHARED_STATE_DEFAULT_NAME);
+
+   // Streams the state of every player over UDP to DSU clients (emulators) and compact-protocol
+   // clients on loopback or the network; call before Start
+   bool EnableStateServer(const SStateServerConfig& config);
+
+   // Rumble and lightbar of DualShock 4 pads, written by a thread per pad; call before Start.
+   // The setters return at once from any thread, false while the player has no pad that takes
+   // output reports.
+   bool EnableOutput(const SPadOutputConfig& config = SPadOutputConfig());
+   bool SetRumble(int playerIndex, uint8_t strongMotor, uint8_t weakMotor);
+   bool SetLightbar(int playerIndex, uint8_t red, uint8_t green, uint8_t blue);
+   bool SetLightbarFlash(int playerIndex, unsigned int onMs, unsigned int offMs);
+
+   // Combos and gestures of every pad, called back on the input thread; call before Start
+   bool EnableCombos(const std::vector<SComboDefinition>& combos, std::function<void(const SComboEvent*, size_t)> callback);
+
+   // Opt-in: drain all pending reports per wakeup with GetRawInputBuffer; call before Start
+   bool EnableBatchedInput(EBatchDelivery delivery, std::function<void(const SJoystickSample*, size_t)> batchCallback = nullptr);
+
+   // Newest decoded state of a player, safe to poll from any number of threads without blocking
+   // the input thread
+   bool GetLatestState(int playerIndex, SJoystickSample& sample, uint64_t* version = NULL) const;
+   int GetConnectedCount() const;
+
 private:
    HWND InitDummyWindow();
-   bool RegisterInputDevices(HWND hwnd);
-   
+   void Init(std::function<void(int, JSDATA)> callBackUpdate, EJoystickWindow window);
+   void DrawLines(HDC hdc, const JSDATA& jsData, int playerIndex, int connectedCount, uint32_t lineMask);
+   uint32_t UpdateBackBuffer(HWND hwnd);
+   void InvalidateLines(HWND hwnd, uint32_t lineMask);
+   void UpdateStats(HWND hwnd);
+   static unsigned int GetMonitorRefreshRate(HWND hwnd);
+
 
-   std::function<void(JSDATA)> m_CallbackUpdater;
-   JSDATA m_jsData;
+   CJoystickCore m_core;
+   CCaptureSink m_captureSink;         // in front of m_core once EnableCapture succeeded
+   CInputThread m_inputThread;
    HWND m_hwnd;
+   HDC m_hdcMem;
+   HBITMAP m_hbmMem;
+   HBITMAP m_hbmOld;
+   CDisplayDiff m_displayDiff;         // what the back buffer shows
+   unsigned int m_refreshRateHz;
+   bool m_showStats;
+   std::unique_ptr<SJoystickStatsSnapshot> m_statsPrevious;     // large, so on the heap
+   std::unique_ptr<SJoystickStatsSnapshot> m_statsCurrent;
+   SStatsSummary m_statsSummary;       // of the player shown, over the last stats interval
 
 
  
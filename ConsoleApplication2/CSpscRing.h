@@ -0,0 +1,264 @@
+// =================================================================================================
+// Lock-free single-producer / single-consumer ring of timestamped joystick samples.
+//
+// Every slot carries its own sequence number, so the consumer can detect a slot the producer has
+// overwritten while it was being copied and never hands out a torn sample.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "AtomicPayload.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const size_t CACHE_LINE_SIZE = 64;
+
+enum ERingOverflowPolicy
+{
+	RING_OVERWRITE_OLDEST,  // producer never waits, the consumer skips what it missed
+	RING_COUNT_DROPS        // a full ring rejects the new sample and counts it as dropped
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+template <typename T>
+class CSpscRing
+{
+public:
+   CSpscRing(size_t capacity, ERingOverflowPolicy policy);
+
+   // Producer side
+   bool Push(const T& item);
+
+   // Consumer side
+   bool TryPop(T& item);
+   size_t DrainBatch(T* items, size_t maxCount);
+   bool ReadLatest(T& item);
+
+   size_t Capacity() const { return m_capacity; }
+   size_t Size() const;
+   uint64_t DroppedCount() const;
+
+private:
+   struct alignas(CACHE_LINE_SIZE) SSlot
+   {
+      std::atomic<uint64_t> sequence;   // 2 * index + 1 while written, 2 * index + 2 when complete
+      CAtomicPayload<T> payload;
+   };
+
+   bool ReadSlot(uint64_t index, T& item);
+
+   const size_t m_capacity;
+   const size_t m_mask;
+   const ERingOverflowPolicy m_policy;
+   std::unique_ptr<SSlot[]> m_slots;
+
+   alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_head;         // written by the producer
+   std::atomic<uint64_t> m_rejected;                              // RING_COUNT_DROPS, producer side
+   alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_tail;         // written by the consumer
+   std::atomic<uint64_t> m_overwritten;                           // RING_OVERWRITE_OLDEST, consumer side
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// RoundUpToPowerOfTwo
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline size_t RoundUpToPowerOfTwo(size_t value)
+{
+   size_t result = 1;
+   while (result < value)
+   {
+      result <<= 1;
+   }
+   return result;
+}
+
+// =================================================================================================
+// CSpscRing                capacity is rounded up to a power of two
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+CSpscRing<T>::CSpscRing(size_t capacity, ERingOverflowPolicy policy) :
+   m_capacity(RoundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)),
+   m_mask(m_capacity - 1),
+   m_policy(policy),
+   m_slots(new SSlot[m_capacity]),
+   m_head(0),
+   m_rejected(0),
+   m_tail(0),
+   m_overwritten(0)
+{
+   for (size_t i = 0; i < m_capacity; i++)
+   {
+      m_slots[i].sequence.store(0, std::memory_order_relaxed);
+   }
+}
+
+// =================================================================================================
+// Push                     never blocks; false when the sample was dropped
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+bool CSpscRing<T>::Push(const T& item)
+{
+   uint64_t head = m_head.load(std::memory_order_relaxed);
+
+   if (m_policy == RING_COUNT_DROPS && head - m_tail.load(std::memory_order_acquire) >= m_capacity)
+   {
+      m_rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+   }
+
+   SSlot& slot = m_slots[head & m_mask];
+   slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release);
+   slot.payload.Store(item);
+   slot.sequence.store(2 * head + 2, std::memory_order_release);
+
+   m_head.store(head + 1, std::memory_order_release);
+   return true;
+}
+
+// =================================================================================================
+// ReadSlot                 copy slot index out, false if the producer rewrote it meanwhile
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+bool CSpscRing<T>::ReadSlot(uint64_t index, T& item)
+{
+   const SSlot& slot = m_slots[index & m_mask];
+
+   uint64_t before = slot.sequence.load(std::memory_order_acquire);
+   if (before != 2 * index + 2)
+   {
+      return false;
+   }
+
+   slot.payload.Load(item);
+   std::atomic_thread_fence(std::memory_order_acquire);
+
+   return slot.sequence.load(std::memory_order_relaxed) == before;
+}
+
+// =================================================================================================
+// TryPop                   oldest sample still in the ring
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+bool CSpscRing<T>::TryPop(T& item)
+{
+   uint64_t tail = m_tail.load(std::memory_order_relaxed);
+
+   for (;;)
+   {
+      uint64_t head = m_head.load(std::memory_order_acquire);
+      if (tail == head)
+      {
+         m_tail.store(tail, std::memory_order_release);
+         return false;
+      }
+
+      // The producer lapped us, everything older than one ring is gone
+      if (head - tail > m_capacity)
+      {
+         m_overwritten.fetch_add(head - m_capacity - tail, std::memory_order_relaxed);
+         tail = head - m_capacity;
+      }
+
+      if (ReadSlot(tail, item))
+      {
+         m_tail.store(tail + 1, std::memory_order_release);
+         return true;
+      }
+
+      // Overwritten while copying
+      m_overwritten.fetch_add(1, std::memory_order_relaxed);
+      tail++;
+   }
+}
+
+// =================================================================================================
+// DrainBatch               up to maxCount samples, oldest first
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+size_t CSpscRing<T>::DrainBatch(T* items, size_t maxCount)
+{
+   size_t count = 0;
+   while (count < maxCount && TryPop(items[count]))
+   {
+      count++;
+   }
+   return count;
+}
+
+// =================================================================================================
+// ReadLatest               newest sample; everything older is consumed, not counted as dropped
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+bool CSpscRing<T>::ReadLatest(T& item)
+{
+   for (;;)
+   {
+      uint64_t head = m_head.load(std::memory_order_acquire);
+      if (head == m_tail.load(std::memory_order_relaxed))
+      {
+         return false;
+      }
+
+      if (ReadSlot(head - 1, item))
+      {
+         m_tail.store(head, std::memory_order_release);
+         return true;
+      }
+   }
+}
+
+// =================================================================================================
+// Size                     approximate when called concurrently with the producer
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+size_t CSpscRing<T>::Size() const
+{
+   uint64_t head = m_head.load(std::memory_order_acquire);
+   uint64_t tail = m_tail.load(std::memory_order_acquire);
+   uint64_t size = head - tail;
+   return size > m_capacity ? m_capacity : (size_t)size;
+}
+
+// =================================================================================================
+// DroppedCount             rejected pushes plus samples overwritten before the consumer read them
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+uint64_t CSpscRing<T>::DroppedCount() const
+{
+   return m_rejected.load(std::memory_order_relaxed) + m_overwritten.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,364 @@
+// =================================================================================================
+// Client of the UDP state server (CStateServer) in either protocol: subscribes, keeps the
+// subscription alive, acknowledges compact datagrams and holds the latest state of every pad.
+// The stand-in for an emulator or a remote rig on loopback, and a reader for other tools.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CStateClient.h"
+#include <cstring>
+#include "MonotonicClock.h"
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+#ifdef _WIN32
+const STATE_SERVER_SOCKET STATE_CLIENT_NO_SOCKET = (STATE_SERVER_SOCKET)INVALID_SOCKET;
+#else
+const STATE_SERVER_SOCKET STATE_CLIENT_NO_SOCKET = -1;
+#endif
+
+const size_t STATE_CLIENT_MAX_DATAGRAM = 2048;
+
+// Room for the bursts of a server serving 8 pads at 8 kHz between two polls
+const int STATE_CLIENT_RECEIVE_BUFFER = 1 << 20;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CStateClient
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CStateClient::CStateClient() :
+    m_protocol(STATE_CLIENT_COMPACT),
+    m_socket(STATE_CLIENT_NO_SOCKET),
+    m_clientId(0),
+    m_lastSubscriptionNs(0),
+    m_counters()
+{
+    std::memset(m_dsuPads, 0, sizeof(m_dsuPads));
+    std::memset(m_dsuSeen, 0, sizeof(m_dsuSeen));
+}
+
+// =================================================================================================
+// ~CStateClient
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CStateClient::~CStateClient()
+{
+    Close();
+}
+
+// =================================================================================================
+// Open                     the socket is connected to the server, so nothing else gets through
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CStateClient::Open(EStateClientProtocol protocol, uint16_t port, const char* address)
+{
+    if (m_socket != STATE_CLIENT_NO_SOCKET || address == nullptr)
+    {
+        return false;
+    }
+
+    sockaddr_in server;
+    std::memset(&server, 0, sizeof(server));
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    if (inet_pton(AF_INET, address, &server.sin_addr) != 1)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        return false;
+    }
+    m_socket = (STATE_SERVER_SOCKET)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    u_long nonBlocking = 1;
+    if (m_socket != STATE_CLIENT_NO_SOCKET && ioctlsocket((SOCKET)m_socket, FIONBIO, &nonBlocking) != 0)
+    {
+        closesocket((SOCKET)m_socket);
+        m_socket = STATE_CLIENT_NO_SOCKET;
+    }
+    if (m_socket == STATE_CLIENT_NO_SOCKET)
+    {
+        WSACleanup();
+        return false;
+    }
+#else
+    m_socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+    if (m_socket == STATE_CLIENT_NO_SOCKET)
+    {
+        return false;
+    }
+#endif
+
+    int receiveBuffer = STATE_CLIENT_RECEIVE_BUFFER;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, (const char*)&receiveBuffer, sizeof(receiveBuffer));
+    if (connect(m_socket, (const sockaddr*)&server, sizeof(server)) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_protocol = protocol;
+    m_clientId = (uint32_t)(MonotonicNowNs() >> 10);
+    m_decoder.Reset();
+    std::memset(m_dsuPads, 0, sizeof(m_dsuPads));
+    std::memset(m_dsuSeen, 0, sizeof(m_dsuSeen));
+    m_counters = SStateClientCounters();
+    m_lastSubscriptionNs = 0;
+    SendSubscription();
+    return true;
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateClient::Close()
+{
+    if (m_socket == STATE_CLIENT_NO_SOCKET)
+    {
+        return;
+    }
+
+    if (m_protocol == STATE_CLIENT_COMPACT)
+    {
+        SDeltaClientMessage message = SDeltaClientMessage();
+        message.message = DELTA_CLIENT_UNSUBSCRIBE;
+        message.clientId = m_clientId;
+        unsigned char packet[DELTA_CLIENT_MESSAGE_SIZE];
+        Send(packet, BuildDeltaClientMessage(message, packet));
+    }
+
+#ifdef _WIN32
+    closesocket((SOCKET)m_socket);
+    WSACleanup();
+#else
+    close(m_socket);
+#endif
+    m_socket = STATE_CLIENT_NO_SOCKET;
+}
+
+// =================================================================================================
+// IsOpen
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CStateClient::IsOpen() const
+{
+    return m_socket != STATE_CLIENT_NO_SOCKET;
+}
+
+// =================================================================================================
+// Poll                     Windows reports an ICMP port unreachable, a server not up yet, as a
+//                          failed receive; that is not an error of the client
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CStateClient::Poll(uint32_t timeoutUs)
+{
+    if (m_socket == STATE_CLIENT_NO_SOCKET)
+    {
+        return -1;
+    }
+
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(m_socket, &readable);
+    timeval timeout;
+    timeout.tv_sec = (long)(timeoutUs / 1000000);
+    timeout.tv_usec = (long)(timeoutUs % 1000000);
+    if (select((int)m_socket + 1, &readable, nullptr, nullptr, &timeout) < 0)
+    {
+        return -1;
+    }
+
+    unsigned char datagram[STATE_CLIENT_MAX_DATAGRAM];
+    int taken = 0;
+    for (;;)
+    {
+        int received = (int)recv(m_socket, (char*)datagram, sizeof(datagram), 0);
+        if (received < 0)
+        {
+#ifdef _WIN32
+            if (WSAGetLastError() == WSAECONNRESET)
+            {
+                continue;
+            }
+#endif
+            break;
+        }
+
+        taken++;
+        m_counters.datagrams++;
+        m_counters.bytes += (uint64_t)received;
+        if (m_protocol == STATE_CLIENT_COMPACT)
+        {
+            if (!m_decoder.Decode(datagram, (size_t)received))
+            {
+                m_counters.invalid++;
+            }
+        }
+        else
+        {
+            TakeDsuPacket(datagram, (size_t)received);
+        }
+    }
+
+    // One acknowledgement for everything this poll took
+    if ((taken != 0 && m_protocol == STATE_CLIENT_COMPACT) ||
+        MonotonicNowNs() - m_lastSubscriptionNs >= STATE_CLIENT_RENEW_INTERVAL_NS)
+    {
+        SendSubscription();
+    }
+    return taken;
+}
+
+// =================================================================================================
+// TakeDsuPacket            a packet number past the next expected one counts the packets between
+//                          as lost; version and slot answers are valid but carry no pad state
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateClient::TakeDsuPacket(const unsigned char* packet, size_t length)
+{
+    SDsuPadData padData;
+    if (!ParseDsuPadData(packet, length, padData))
+    {
+        uint32_t serverId = 0;
+        uint32_t message = 0;
+        if (!CheckDsuPacket(packet, length, DSU_MAGIC_SERVER, serverId, message))
+        {
+            m_counters.invalid++;
+        }
+        return;
+    }
+    if (padData.slot >= DSU_SLOTS)
+    {
+        m_counters.invalid++;
+        return;
+    }
+
+    int slot = padData.slot;
+    if (m_dsuSeen[slot])
+    {
+        int32_t gap = (int32_t)(padData.packetNumber - m_dsuPads[slot].packetNumber - 1);
+        if (gap > 0)
+        {
+            m_counters.lost += (uint64_t)gap;
+        }
+        if (gap < 0)
+        {
+            return;
+        }
+    }
+    m_dsuPads[slot] = padData;
+    m_dsuSeen[slot] = true;
+    m_counters.updates++;
+}
+
+// =================================================================================================
+// SendSubscription         DSU: the slots and then a pad data request for all of them; compact:
+//                          the acknowledgement, which subscribes to every pad as well
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateClient::SendSubscription()
+{
+    if (m_protocol == STATE_CLIENT_COMPACT)
+    {
+        unsigned char packet[DELTA_CLIENT_MESSAGE_SIZE];
+        Send(packet, m_decoder.BuildAck(m_clientId, (uint8_t)((1u << MAX_CONTROLLERS) - 1), packet));
+    }
+    else
+    {
+        unsigned char packet[DSU_MAX_REQUEST_SIZE];
+        if (m_lastSubscriptionNs == 0)
+        {
+            const uint8_t slots[DSU_SLOTS] = { 0, 1, 2, 3 };
+            Send(packet, BuildDsuPortInfoRequest(m_clientId, slots, DSU_SLOTS, packet));
+        }
+        Send(packet, BuildDsuPadDataRequest(m_clientId, 0, 0, packet));
+    }
+    m_lastSubscriptionNs = MonotonicNowNs();
+}
+
+// =================================================================================================
+// Send                     a refused request is repeated with the next renewal
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateClient::Send(const unsigned char* packet, size_t length)
+{
+    if (send(m_socket, (const char*)packet, (int)length, 0) >= 0)
+    {
+        m_counters.sent++;
+    }
+}
+
+// =================================================================================================
+// GetState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CStateClient::GetState(int playerIndex, SPadState& state) const
+{
+    return m_decoder.GetState(playerIndex, state);
+}
+
+// =================================================================================================
+// GetDsuPadData
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CStateClient::GetDsuPadData(int slot, SDsuPadData& padData) const
+{
+    if (slot < 0 || slot >= DSU_SLOTS || !m_dsuSeen[slot])
+    {
+        return false;
+    }
+    padData = m_dsuPads[slot];
+    return true;
+}
+
+// =================================================================================================
+// GetCounters
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+SStateClientCounters CStateClient::GetCounters() const
+{
+    SStateClientCounters counters = m_counters;
+    if (m_protocol == STATE_CLIENT_COMPACT)
+    {
+        counters.updates = m_decoder.GetRecordCount();
+        counters.missingBases = m_decoder.GetMissingBaseCount();
+    }
+    return counters;
+}
@@ -0,0 +1,89 @@
+// =================================================================================================
+// Client of the UDP state server (CStateServer) in either protocol: subscribes, keeps the
+// subscription alive, acknowledges compact datagrams and holds the latest state of every pad.
+// The stand-in for an emulator or a remote rig on loopback, and a reader for other tools.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include "CStateServer.h"
+#include "DsuProtocol.h"
+#include "DeltaProtocol.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+enum EStateClientProtocol
+{
+	STATE_CLIENT_DSU,
+	STATE_CLIENT_COMPACT
+};
+
+// Subscriptions are renewed well inside the server's timeout
+const uint64_t STATE_CLIENT_RENEW_INTERVAL_NS = 1000000000ULL;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SStateClientCounters
+{
+	uint64_t datagrams;
+	uint64_t bytes;
+	uint64_t updates;           // DSU pad data packets, compact records
+	uint64_t lost;              // DSU: gaps in the packet numbers
+	uint64_t missingBases;      // compact: records whose base the client no longer held
+	uint64_t invalid;           // datagrams that failed their checks
+	uint64_t sent;              // subscriptions and acknowledgements
+};
+
+// One thread at a time
+class CStateClient
+{
+public:
+   CStateClient();
+   ~CStateClient();
+
+   CStateClient(const CStateClient&) = delete;
+   CStateClient& operator=(const CStateClient&) = delete;
+
+   // Subscribes to every pad of the server at an IPv4 address; false when the socket fails
+   bool Open(EStateClientProtocol protocol, uint16_t port, const char* address = "127.0.0.1");
+   // Unsubscribes in the compact protocol, DSU subscriptions simply lapse
+   void Close();
+   bool IsOpen() const;
+
+   // Waits up to timeoutUs for datagrams and takes every one that arrived, then acknowledges them
+   // and renews the subscription when due. The datagrams taken, -1 on a socket error.
+   int Poll(uint32_t timeoutUs);
+
+   // Compact protocol
+   bool GetState(int playerIndex, SPadState& state) const;
+   // DSU
+   bool GetDsuPadData(int slot, SDsuPadData& padData) const;
+
+   SStateClientCounters GetCounters() const;
+
+private:
+   void SendSubscription();
+   void Send(const unsigned char* packet, size_t length);
+   void TakeDsuPacket(const unsigned char* packet, size_t length);
+
+
+   EStateClientProtocol m_protocol;
+   STATE_SERVER_SOCKET m_socket;
+   uint32_t m_clientId;
+   uint64_t m_lastSubscriptionNs;
+   CDeltaDecoder m_decoder;
+   SDsuPadData m_dsuPads[DSU_SLOTS];
+   bool m_dsuSeen[DSU_SLOTS];
+   SStateClientCounters m_counters;
+};
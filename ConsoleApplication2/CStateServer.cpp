@@ -0,0 +1,826 @@
+// =================================================================================================
+// UDP state server: streams the decoded pad state of every player to emulators over DSU
+// (DsuProtocol.h) and to other clients in the compact delta protocol (DeltaProtocol.h). It runs
+// on its own thread; the input path only pushes into a ring and never waits on the network.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CStateServer.h"
+#include <cstring>
+#include "MonotonicClock.h"
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+#ifdef _WIN32
+const STATE_SERVER_SOCKET STATE_SERVER_NO_SOCKET = (STATE_SERVER_SOCKET)INVALID_SOCKET;
+#else
+const STATE_SERVER_SOCKET STATE_SERVER_NO_SOCKET = -1;
+#endif
+
+// Wakeup of the server thread while nobody listens; the queue holds far more reports than arrive
+// in it, so only the device changes and the latest states matter
+const uint32_t STATE_SERVER_IDLE_WAIT_US = 20000;
+
+const uint64_t STATE_SERVER_EXPIRY_INTERVAL_NS = 1000000000ULL;
+
+// Client messages read per socket and wakeup, so a flood cannot hold the reports back
+const int STATE_SERVER_RECEIVE_BATCH = 64;
+const size_t STATE_SERVER_MAX_REQUEST = 256;
+
+// Datagrams handed to one sendmmsg
+const unsigned int STATE_SERVER_SEND_BATCH = 64;
+
+// Room for a burst of datagrams at 8 pads and several clients without dropping on the socket
+const int STATE_SERVER_SEND_BUFFER = 1 << 20;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CloseUdpSocket
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CloseUdpSocket(STATE_SERVER_SOCKET udpSocket)
+{
+#ifdef _WIN32
+    closesocket((SOCKET)udpSocket);
+#else
+    close(udpSocket);
+#endif
+}
+
+// =================================================================================================
+// OpenUdpSocket            bound, non-blocking; port 0 lets the system pick, boundPort tells
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static STATE_SERVER_SOCKET OpenUdpSocket(uint16_t port, bool loopbackOnly, uint16_t& boundPort)
+{
+#ifdef _WIN32
+    STATE_SERVER_SOCKET udpSocket = (STATE_SERVER_SOCKET)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#else
+    STATE_SERVER_SOCKET udpSocket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+#endif
+    if (udpSocket == STATE_SERVER_NO_SOCKET)
+    {
+        return STATE_SERVER_NO_SOCKET;
+    }
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+
+    socklen_t addressLength = sizeof(address);
+    int sendBuffer = STATE_SERVER_SEND_BUFFER;
+    setsockopt(udpSocket, SOL_SOCKET, SO_SNDBUF, (const char*)&sendBuffer, sizeof(sendBuffer));
+    if (bind(udpSocket, (const sockaddr*)&address, sizeof(address)) != 0 ||
+        getsockname(udpSocket, (sockaddr*)&address, &addressLength) != 0)
+    {
+        CloseUdpSocket(udpSocket);
+        return STATE_SERVER_NO_SOCKET;
+    }
+
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    if (ioctlsocket((SOCKET)udpSocket, FIONBIO, &nonBlocking) != 0)
+    {
+        CloseUdpSocket(udpSocket);
+        return STATE_SERVER_NO_SOCKET;
+    }
+#endif
+
+    boundPort = ntohs(address.sin_port);
+    return udpSocket;
+}
+
+// =================================================================================================
+// CStateServer
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CStateServer::CStateServer() :
+    m_stopRequested(false),
+    m_serverId(0),
+    m_dsuSocket(STATE_SERVER_NO_SOCKET),
+    m_compactSocket(STATE_SERVER_NO_SOCKET),
+    m_dsuPort(0),
+    m_compactPort(0),
+    m_reports(0),
+    m_requests(0),
+    m_dsuPackets(0),
+    m_dsuBytes(0),
+    m_compactDatagrams(0),
+    m_compactBytes(0),
+    m_compactRecords(0),
+    m_compactKeyframes(0),
+    m_sendErrors(0)
+{
+    std::memset(m_sequences, 0, sizeof(m_sequences));
+    std::memset(m_connected, 0, sizeof(m_connected));
+    std::memset(m_battery, 0, sizeof(m_battery));
+    std::memset(m_dsuPacketNumbers, 0, sizeof(m_dsuPacketNumbers));
+}
+
+// =================================================================================================
+// ~CStateServer
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CStateServer::~CStateServer()
+{
+    Stop();
+}
+
+// =================================================================================================
+// Start
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CStateServer::Start(const SStateServerConfig& config)
+{
+    if (m_thread.joinable() || (!config.dsu && !config.compact) || config.queueCapacity == 0)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        return false;
+    }
+#endif
+
+    m_config = config;
+    bool opened = true;
+    if (config.dsu)
+    {
+        m_dsuSocket = OpenUdpSocket(config.dsuPort, config.loopbackOnly, m_dsuPort);
+        opened = m_dsuSocket != STATE_SERVER_NO_SOCKET;
+    }
+    if (opened && config.compact)
+    {
+        m_compactSocket = OpenUdpSocket(config.compactPort, config.loopbackOnly, m_compactPort);
+        opened = m_compactSocket != STATE_SERVER_NO_SOCKET;
+    }
+    if (!opened)
+    {
+        CloseSockets();
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    m_queue.reset(new CSpscRing<SItem>(config.queueCapacity, RING_OVERWRITE_OLDEST));
+    m_items.resize(m_queue->Capacity());
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        m_history[i].Reset();
+    }
+    m_serverId = (uint32_t)(MonotonicNowNs() >> 10);
+    m_stopRequested.store(false, std::memory_order_release);
+    m_thread = std::thread(&CStateServer::Run, this);
+    return true;
+}
+
+// =================================================================================================
+// Stop                     the thread notices within one wakeup
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::Stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    m_stopRequested.store(true, std::memory_order_release);
+    m_thread.join();
+    CloseSockets();
+    m_dsuClients.clear();
+    m_compactClients.clear();
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+// =================================================================================================
+// CloseSockets
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::CloseSockets()
+{
+    if (m_dsuSocket != STATE_SERVER_NO_SOCKET)
+    {
+        CloseUdpSocket(m_dsuSocket);
+        m_dsuSocket = STATE_SERVER_NO_SOCKET;
+    }
+    if (m_compactSocket != STATE_SERVER_NO_SOCKET)
+    {
+        CloseUdpSocket(m_compactSocket);
+        m_compactSocket = STATE_SERVER_NO_SOCKET;
+    }
+    m_dsuPort = 0;
+    m_compactPort = 0;
+}
+
+// =================================================================================================
+// SubmitDevice
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::SubmitDevice(int playerIndex, bool connected)
+{
+    if (!m_queue || playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return;
+    }
+
+    SItem item = SItem();
+    item.type = ITEM_DEVICE;
+    item.playerIndex = (uint8_t)playerIndex;
+    item.connected = connected ? 1 : 0;
+    m_queue->Push(item);
+}
+
+// =================================================================================================
+// SubmitState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::SubmitState(int playerIndex, const SPadState& state, const SMotionSample* pMotion)
+{
+    if (!m_queue || playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return;
+    }
+
+    SItem item;
+    item.state = state;
+    item.motion = pMotion != nullptr ? *pMotion : SMotionSample();
+    item.type = ITEM_STATE;
+    item.playerIndex = (uint8_t)playerIndex;
+    item.hasMotion = pMotion != nullptr ? 1 : 0;
+    item.connected = 1;
+    m_queue->Push(item);
+}
+
+// =================================================================================================
+// GetCounters
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+SStateServerCounters CStateServer::GetCounters() const
+{
+    SStateServerCounters counters;
+    counters.reports = m_reports.load(std::memory_order_relaxed);
+    counters.queueOverwrites = m_queue ? m_queue->DroppedCount() : 0;
+    counters.requests = m_requests.load(std::memory_order_relaxed);
+    counters.dsuPackets = m_dsuPackets.load(std::memory_order_relaxed);
+    counters.dsuBytes = m_dsuBytes.load(std::memory_order_relaxed);
+    counters.compactDatagrams = m_compactDatagrams.load(std::memory_order_relaxed);
+    counters.compactBytes = m_compactBytes.load(std::memory_order_relaxed);
+    counters.compactRecords = m_compactRecords.load(std::memory_order_relaxed);
+    counters.compactKeyframes = m_compactKeyframes.load(std::memory_order_relaxed);
+    counters.sendErrors = m_sendErrors.load(std::memory_order_relaxed);
+    return counters;
+}
+
+// =================================================================================================
+// Run                      thread body: wait for requests or the flush interval, answer the
+//                          requests, turn the queued reports into datagrams and send them at once
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::Run()
+{
+    uint64_t lastExpiryNs = MonotonicNowNs();
+    while (!m_stopRequested.load(std::memory_order_acquire))
+    {
+        bool idle = m_dsuClients.empty() && m_compactClients.empty();
+        uint32_t waitUs = idle ? STATE_SERVER_IDLE_WAIT_US : m_config.flushIntervalUs;
+
+        fd_set readable;
+        FD_ZERO(&readable);
+        STATE_SERVER_SOCKET highest = 0;
+        if (m_dsuSocket != STATE_SERVER_NO_SOCKET)
+        {
+            FD_SET(m_dsuSocket, &readable);
+            highest = m_dsuSocket;
+        }
+        if (m_compactSocket != STATE_SERVER_NO_SOCKET)
+        {
+            FD_SET(m_compactSocket, &readable);
+            highest = m_compactSocket > highest ? m_compactSocket : highest;
+        }
+
+        timeval timeout;
+        timeout.tv_sec = (long)(waitUs / 1000000);
+        timeout.tv_usec = (long)(waitUs % 1000000);
+        int ready = select((int)highest + 1, &readable, nullptr, nullptr, &timeout);
+
+        uint64_t nowNs = MonotonicNowNs();
+        if (ready > 0 && m_dsuSocket != STATE_SERVER_NO_SOCKET && FD_ISSET(m_dsuSocket, &readable))
+        {
+            ReceiveRequests(false, nowNs);
+        }
+        if (ready > 0 && m_compactSocket != STATE_SERVER_NO_SOCKET && FD_ISSET(m_compactSocket, &readable))
+        {
+            ReceiveRequests(true, nowNs);
+        }
+
+        size_t count = m_queue->DrainBatch(m_items.data(), m_items.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            ProcessItem(m_items[i]);
+        }
+        for (size_t i = 0; i < m_compactClients.size(); i++)
+        {
+            CloseCompactDatagram(*m_compactClients[i]);
+        }
+        FlushSends();
+
+        if (nowNs - lastExpiryNs >= STATE_SERVER_EXPIRY_INTERVAL_NS)
+        {
+            ExpireClients(nowNs);
+            lastExpiryNs = nowNs;
+        }
+    }
+}
+
+// =================================================================================================
+// ReceiveRequests          Windows reports an ICMP port unreachable for an earlier send as a
+//                          failed receive; that one is skipped, anything else ends the batch
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::ReceiveRequests(bool compact, uint64_t nowNs)
+{
+    STATE_SERVER_SOCKET udpSocket = compact ? m_compactSocket : m_dsuSocket;
+    unsigned char packet[STATE_SERVER_MAX_REQUEST];
+    for (int i = 0; i < STATE_SERVER_RECEIVE_BATCH; i++)
+    {
+        sockaddr_in from;
+        socklen_t fromLength = sizeof(from);
+        int received = (int)recvfrom(udpSocket, (char*)packet, sizeof(packet), 0, (sockaddr*)&from, &fromLength);
+        if (received < 0)
+        {
+#ifdef _WIN32
+            if (WSAGetLastError() == WSAECONNRESET)
+            {
+                continue;
+            }
+#endif
+            break;
+        }
+        if (from.sin_family != AF_INET)
+        {
+            continue;
+        }
+
+        SAddress address = { from.sin_addr.s_addr, from.sin_port };
+        if (compact)
+        {
+            SDeltaClientMessage message;
+            if (ParseDeltaClientMessage(packet, (size_t)received, message))
+            {
+                HandleCompactMessage(message, address, nowNs);
+            }
+        }
+        else
+        {
+            SDsuRequest request;
+            if (ParseDsuRequest(packet, (size_t)received, request))
+            {
+                HandleDsuRequest(request, address, nowNs);
+            }
+        }
+    }
+}
+
+// =================================================================================================
+// HandleDsuRequest         version and slot queries are answered right away; a pad data request
+//                          subscribes the sender to one slot, the slot with a MAC, or all of them
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::HandleDsuRequest(const SDsuRequest& request, const SAddress& address, uint64_t nowNs)
+{
+    m_requests.fetch_add(1, std::memory_order_relaxed);
+    unsigned char packet[DSU_PAD_DATA_PACKET_SIZE];
+    switch (request.message)
+    {
+        case DSU_MESSAGE_VERSION:
+        {
+            size_t length = BuildDsuVersion(m_serverId, packet);
+            QueueSend(AppendSendData(packet, length), length, address, false);
+            return;
+        }
+
+        case DSU_MESSAGE_PORT_INFO:
+        {
+            for (uint32_t i = 0; i < request.slotCount; i++)
+            {
+                int slot = request.slots[i];
+                if (slot >= DSU_SLOTS)
+                {
+                    continue;
+                }
+                SDsuSlotInfo info;
+                MakeDsuSlotInfo(slot, m_connected[slot], m_battery[slot], info);
+                size_t length = BuildDsuPortInfo(m_serverId, info, packet);
+                QueueSend(AppendSendData(packet, length), length, address, false);
+            }
+            return;
+        }
+
+        case DSU_MESSAGE_PAD_DATA:
+            break;
+
+        default:
+            return;
+    }
+
+    uint8_t slotMask = 0;
+    if (request.registration == 0)
+    {
+        slotMask = (1 << DSU_SLOTS) - 1;
+    }
+    if ((request.registration & DSU_REGISTER_SLOT) != 0 && request.slot < DSU_SLOTS)
+    {
+        slotMask |= (uint8_t)(1 << request.slot);
+    }
+    if ((request.registration & DSU_REGISTER_MAC) != 0)
+    {
+        for (int slot = 0; slot < DSU_SLOTS; slot++)
+        {
+            SDsuSlotInfo info;
+            MakeDsuSlotInfo(slot, true, 0, info);
+            if (std::memcmp(info.mac, request.mac, sizeof(info.mac)) == 0)
+            {
+                slotMask |= (uint8_t)(1 << slot);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m_dsuClients.size(); i++)
+    {
+        SDsuClient& client = m_dsuClients[i];
+        if (client.address.ip == address.ip && client.address.port == address.port)
+        {
+            client.slotMask |= slotMask;
+            client.lastRequestNs = nowNs;
+            return;
+        }
+    }
+
+    if (m_dsuClients.size() < STATE_SERVER_MAX_CLIENTS)
+    {
+        SDsuClient client = { address, nowNs, slotMask };
+        m_dsuClients.push_back(client);
+    }
+}
+
+// =================================================================================================
+// HandleCompactMessage     an acknowledgement of a sequence the server has not sent yet, left by
+//                          an earlier run of the server, is taken as none
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::HandleCompactMessage(const SDeltaClientMessage& message, const SAddress& address, uint64_t nowNs)
+{
+    m_requests.fetch_add(1, std::memory_order_relaxed);
+
+    SCompactClient* pClient = nullptr;
+    for (size_t i = 0; i < m_compactClients.size(); i++)
+    {
+        SCompactClient* pCandidate = m_compactClients[i].get();
+        if (pCandidate->address.ip == address.ip && pCandidate->address.port == address.port)
+        {
+            if (message.message == DELTA_CLIENT_UNSUBSCRIBE)
+            {
+                m_compactClients.erase(m_compactClients.begin() + i);
+                return;
+            }
+            pClient = pCandidate;
+            break;
+        }
+    }
+
+    if (pClient == nullptr)
+    {
+        if (message.message == DELTA_CLIENT_UNSUBSCRIBE || m_compactClients.size() >= STATE_SERVER_MAX_CLIENTS)
+        {
+            return;
+        }
+        m_compactClients.emplace_back(new SCompactClient());
+        pClient = m_compactClients.back().get();
+        pClient->address = address;
+    }
+
+    pClient->lastRequestNs = nowNs;
+    pClient->playerMask = message.playerMask;
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        uint32_t acked = message.acked[i];
+        pClient->acked[i] = (int32_t)(m_sequences[i] - acked) >= 0 ? acked : 0;
+    }
+}
+
+// =================================================================================================
+// ProcessItem              every report gets the next sequence of its pad and goes into the
+//                          history, whether or not anybody listens
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::ProcessItem(const SItem& item)
+{
+    int playerIndex = item.playerIndex;
+    uint32_t sequence = ++m_sequences[playerIndex];
+    if (sequence == 0)
+    {
+        sequence = ++m_sequences[playerIndex];
+    }
+
+    if (item.type == ITEM_DEVICE)
+    {
+        // A new pad in the slot starts from a keyframe, a removed one is announced
+        bool connected = item.connected != 0;
+        m_connected[playerIndex] = connected;
+        m_battery[playerIndex] = 0;
+        m_history[playerIndex].Reset();
+        for (size_t i = 0; i < m_compactClients.size(); i++)
+        {
+            SCompactClient& client = *m_compactClients[i];
+            client.acked[playerIndex] = 0;
+            client.chained[playerIndex] = 0;
+            if (!connected && ((client.playerMask >> playerIndex) & 1) != 0)
+            {
+                AppendCompactRecord(client, playerIndex, sequence, SPadState(), true);
+            }
+        }
+        return;
+    }
+
+    m_reports.fetch_add(1, std::memory_order_relaxed);
+    m_connected[playerIndex] = true;
+    m_battery[playerIndex] = item.state.battery;
+    m_history[playerIndex].Store(sequence, item.state);
+
+    if (playerIndex < DSU_SLOTS)
+    {
+        size_t offset = 0;
+        size_t length = 0;
+        for (size_t i = 0; i < m_dsuClients.size(); i++)
+        {
+            const SDsuClient& client = m_dsuClients[i];
+            if (((client.slotMask >> playerIndex) & 1) == 0)
+            {
+                continue;
+            }
+            if (length == 0)
+            {
+                // Built once, sent to every client of the slot
+                SDsuSlotInfo info;
+                MakeDsuSlotInfo(playerIndex, true, item.state.battery, info);
+                unsigned char packet[DSU_PAD_DATA_PACKET_SIZE];
+                length = BuildDsuPadData(m_serverId, info, m_dsuPacketNumbers[playerIndex]++, item.state,
+                                         item.hasMotion ? &item.motion : nullptr, packet);
+                offset = AppendSendData(packet, length);
+            }
+            QueueSend(offset, length, client.address, false);
+        }
+    }
+
+    for (size_t i = 0; i < m_compactClients.size(); i++)
+    {
+        SCompactClient& client = *m_compactClients[i];
+        if (((client.playerMask >> playerIndex) & 1) != 0)
+        {
+            AppendCompactRecord(client, playerIndex, sequence, item.state, false);
+        }
+    }
+}
+
+// =================================================================================================
+// AppendCompactRecord      the base is the pad's previous record in the open datagram, else the
+//                          client's acknowledged state while the history still has it, else the
+//                          idle state
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::AppendCompactRecord(SCompactClient& client, int playerIndex, uint32_t sequence, const SPadState& state, bool disconnected)
+{
+    if (client.datagramLength != 0 &&
+        (client.datagramLength + DELTA_MAX_RECORD_SIZE > DELTA_MAX_DATAGRAM || client.recordCount == UINT8_MAX))
+    {
+        CloseCompactDatagram(client);
+    }
+    if (client.datagramLength == 0)
+    {
+        client.datagramLength = DELTA_DATAGRAM_HEADER_SIZE;
+        client.recordCount = 0;
+    }
+
+    SDeltaRecordHeader header = SDeltaRecordHeader();
+    header.playerIndex = (uint8_t)playerIndex;
+    header.sequence = sequence;
+    header.timeUs = (uint32_t)(state.timestampNs / 1000);
+    if (disconnected)
+    {
+        header.fieldMask = DELTA_FIELD_DISCONNECTED;
+    }
+    else
+    {
+        uint32_t baseSequence = client.chained[playerIndex] != 0 ? client.chained[playerIndex] : client.acked[playerIndex];
+        const SPadState* pBase = nullptr;
+        if (baseSequence != 0 && sequence - baseSequence < DELTA_HISTORY)
+        {
+            pBase = m_history[playerIndex].Find(baseSequence);
+        }
+
+        if (pBase != nullptr)
+        {
+            header.baseDistance = (uint8_t)(sequence - baseSequence);
+            header.fieldMask = GetDeltaFieldMask(*pBase, state);
+        }
+        else
+        {
+            header.fieldMask = GetDeltaFieldMask(SPadState(), state);
+            m_compactKeyframes.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    client.datagramLength += WriteDeltaRecord(header, state, client.datagram + client.datagramLength);
+    client.recordCount++;
+    client.chained[playerIndex] = disconnected ? 0 : sequence;
+    m_compactRecords.fetch_add(1, std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// CloseCompactDatagram     the records of the next datagram no longer chain to this one's
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::CloseCompactDatagram(SCompactClient& client)
+{
+    if (client.datagramLength == 0)
+    {
+        return;
+    }
+
+    WriteDeltaDatagramHeader(m_serverId, client.recordCount, client.datagram);
+    QueueSend(AppendSendData(client.datagram, client.datagramLength), client.datagramLength, client.address, true);
+    client.datagramLength = 0;
+    client.recordCount = 0;
+    std::memset(client.chained, 0, sizeof(client.chained));
+}
+
+// =================================================================================================
+// AppendSendData           the bytes stay until FlushSends
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t CStateServer::AppendSendData(const unsigned char* data, size_t length)
+{
+    size_t offset = m_sendBuffer.size();
+    m_sendBuffer.insert(m_sendBuffer.end(), data, data + length);
+    return offset;
+}
+
+// =================================================================================================
+// QueueSend
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::QueueSend(size_t offset, size_t length, const SAddress& address, bool compact)
+{
+    SOutgoing outgoing = { offset, length, address, compact };
+    m_outgoing.push_back(outgoing);
+}
+
+// =================================================================================================
+// FlushSends               one sendmmsg per run of datagrams on the same socket on Linux, one
+//                          sendto each elsewhere. A refused datagram is counted and dropped.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::FlushSends()
+{
+    size_t index = 0;
+    while (index < m_outgoing.size())
+    {
+        bool compact = m_outgoing[index].compact;
+        STATE_SERVER_SOCKET udpSocket = compact ? m_compactSocket : m_dsuSocket;
+
+#ifdef _WIN32
+        const SOutgoing& outgoing = m_outgoing[index];
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = outgoing.address.ip;
+        address.sin_port = outgoing.address.port;
+        int sent = sendto((SOCKET)udpSocket, (const char*)m_sendBuffer.data() + outgoing.offset, (int)outgoing.length, 0,
+                          (const sockaddr*)&address, sizeof(address));
+        unsigned int accepted = sent == SOCKET_ERROR ? 0 : 1;
+        unsigned int count = 1;
+#else
+        mmsghdr messages[STATE_SERVER_SEND_BATCH];
+        iovec vectors[STATE_SERVER_SEND_BATCH];
+        sockaddr_in addresses[STATE_SERVER_SEND_BATCH];
+        unsigned int count = 0;
+        while (index + count < m_outgoing.size() && count < STATE_SERVER_SEND_BATCH && m_outgoing[index + count].compact == compact)
+        {
+            const SOutgoing& outgoing = m_outgoing[index + count];
+            std::memset(&addresses[count], 0, sizeof(addresses[count]));
+            addresses[count].sin_family = AF_INET;
+            addresses[count].sin_addr.s_addr = outgoing.address.ip;
+            addresses[count].sin_port = outgoing.address.port;
+            vectors[count].iov_base = m_sendBuffer.data() + outgoing.offset;
+            vectors[count].iov_len = outgoing.length;
+            std::memset(&messages[count], 0, sizeof(messages[count]));
+            messages[count].msg_hdr.msg_name = &addresses[count];
+            messages[count].msg_hdr.msg_namelen = sizeof(addresses[count]);
+            messages[count].msg_hdr.msg_iov = &vectors[count];
+            messages[count].msg_hdr.msg_iovlen = 1;
+            count++;
+        }
+        int sent = sendmmsg(udpSocket, messages, count, 0);
+        unsigned int accepted = sent < 0 ? 0 : (unsigned int)sent;
+#endif
+
+        for (unsigned int i = 0; i < accepted; i++)
+        {
+            const SOutgoing& outgoing = m_outgoing[index + i];
+            if (outgoing.compact)
+            {
+                m_compactDatagrams.fetch_add(1, std::memory_order_relaxed);
+                m_compactBytes.fetch_add(outgoing.length, std::memory_order_relaxed);
+            }
+            else
+            {
+                m_dsuPackets.fetch_add(1, std::memory_order_relaxed);
+                m_dsuBytes.fetch_add(outgoing.length, std::memory_order_relaxed);
+            }
+        }
+        if (accepted < count)
+        {
+            m_sendErrors.fetch_add(1, std::memory_order_relaxed);
+            index += accepted + 1;
+        }
+        else
+        {
+            index += count;
+        }
+    }
+
+    m_outgoing.clear();
+    m_sendBuffer.clear();
+}
+
+// =================================================================================================
+// ExpireClients            DSU and compact clients alike have to renew their subscription
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CStateServer::ExpireClients(uint64_t nowNs)
+{
+    for (size_t i = m_dsuClients.size(); i-- > 0;)
+    {
+        if (nowNs - m_dsuClients[i].lastRequestNs > DSU_SUBSCRIPTION_TIMEOUT_NS)
+        {
+            m_dsuClients.erase(m_dsuClients.begin() + i);
+        }
+    }
+    for (size_t i = m_compactClients.size(); i-- > 0;)
+    {
+        if (nowNs - m_compactClients[i]->lastRequestNs > DELTA_SUBSCRIPTION_TIMEOUT_NS)
+        {
+            m_compactClients.erase(m_compactClients.begin() + i);
+        }
+    }
+}
@@ -0,0 +1,191 @@
+// =================================================================================================
+// UDP state server: streams the decoded pad state of every player to emulators over DSU
+// (DsuProtocol.h) and to other clients in the compact delta protocol (DeltaProtocol.h). It runs
+// on its own thread; the input path only pushes into a ring and never waits on the network.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "CDeviceRegistry.h"
+#include "CSpscRing.h"
+#include "PadState.h"
+#include "Ds4Motion.h"
+#include "DsuProtocol.h"
+#include "DeltaProtocol.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Clients per protocol; requests from more are ignored until one lapses
+const size_t STATE_SERVER_MAX_CLIENTS = 16;
+
+#ifdef _WIN32
+typedef uintptr_t STATE_SERVER_SOCKET;     // SOCKET, without winsock2.h in every includer
+#else
+typedef int STATE_SERVER_SOCKET;
+#endif
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SStateServerConfig
+{
+	bool dsu = true;
+	uint16_t dsuPort = DSU_DEFAULT_PORT;            // 0 takes any free port, see GetDsuPort
+	bool compact = true;
+	uint16_t compactPort = DELTA_DEFAULT_PORT;
+	bool loopbackOnly = true;                       // false serves remote rigs on every interface
+	uint32_t flushIntervalUs = 1000;                // longest a report waits; the reports of one
+	                                                // interval share the compact datagrams
+	size_t queueCapacity = 1024;                    // reports between the input path and the server
+};
+
+struct SStateServerCounters
+{
+	uint64_t reports;           // taken off the queue
+	uint64_t queueOverwrites;   // reports the server thread fell behind on
+	uint64_t requests;          // client messages accepted
+	uint64_t dsuPackets;
+	uint64_t dsuBytes;
+	uint64_t compactDatagrams;
+	uint64_t compactBytes;
+	uint64_t compactRecords;
+	uint64_t compactKeyframes;
+	uint64_t sendErrors;        // datagrams the socket refused; the next report supersedes them
+};
+
+class CStateServer
+{
+public:
+   CStateServer();
+   ~CStateServer();
+
+   CStateServer(const CStateServer&) = delete;
+   CStateServer& operator=(const CStateServer&) = delete;
+
+   // Binds the sockets and starts the thread; false, with nothing left open, when a socket fails
+   bool Start(const SStateServerConfig& config);
+   void Stop();
+   bool IsRunning() const { return m_thread.joinable(); }
+
+   // The bound ports, 0 for a protocol that is off
+   uint16_t GetDsuPort() const { return m_dsuPort; }
+   uint16_t GetCompactPort() const { return m_compactPort; }
+
+   // Input thread only; never blocks, a full queue overwrites its oldest report
+   void SubmitDevice(int playerIndex, bool connected);
+   void SubmitState(int playerIndex, const SPadState& state, const SMotionSample* pMotion);
+
+   // Any thread
+   SStateServerCounters GetCounters() const;
+
+private:
+   enum EItemType
+   {
+      ITEM_STATE,
+      ITEM_DEVICE
+   };
+
+   struct SItem
+   {
+      SPadState state;
+      SMotionSample motion;
+      uint8_t type;                    // EItemType
+      uint8_t playerIndex;
+      uint8_t hasMotion;
+      uint8_t connected;
+   };
+
+   // IPv4 address and port, both in network order
+   struct SAddress
+   {
+      uint32_t ip;
+      uint16_t port;
+   };
+
+   struct SDsuClient
+   {
+      SAddress address;
+      uint64_t lastRequestNs;
+      uint8_t slotMask;                // slots subscribed to
+   };
+
+   struct SCompactClient
+   {
+      SAddress address;
+      uint64_t lastRequestNs;
+      uint8_t playerMask;
+      uint32_t acked[MAX_CONTROLLERS];
+      uint32_t chained[MAX_CONTROLLERS];   // last record of the pad in the open datagram, 0 for none
+      size_t datagramLength;               // 0 while no datagram is open
+      uint8_t recordCount;
+      unsigned char datagram[DELTA_MAX_DATAGRAM];
+   };
+
+   struct SOutgoing
+   {
+      size_t offset;                   // into m_sendBuffer
+      size_t length;
+      SAddress address;
+      bool compact;
+   };
+
+   void Run();
+   void CloseSockets();
+   void ReceiveRequests(bool compact, uint64_t nowNs);
+   void HandleDsuRequest(const SDsuRequest& request, const SAddress& address, uint64_t nowNs);
+   void HandleCompactMessage(const SDeltaClientMessage& message, const SAddress& address, uint64_t nowNs);
+   void ProcessItem(const SItem& item);
+   void AppendCompactRecord(SCompactClient& client, int playerIndex, uint32_t sequence, const SPadState& state, bool disconnected);
+   void CloseCompactDatagram(SCompactClient& client);
+   size_t AppendSendData(const unsigned char* data, size_t length);
+   void QueueSend(size_t offset, size_t length, const SAddress& address, bool compact);
+   void FlushSends();
+   void ExpireClients(uint64_t nowNs);
+
+
+   SStateServerConfig m_config;
+   std::unique_ptr<CSpscRing<SItem>> m_queue;
+   std::thread m_thread;
+   std::atomic<bool> m_stopRequested;
+   uint32_t m_serverId;
+   STATE_SERVER_SOCKET m_dsuSocket;
+   STATE_SERVER_SOCKET m_compactSocket;
+   uint16_t m_dsuPort;
+   uint16_t m_compactPort;
+
+   // Server thread only
+   std::vector<SItem> m_items;
+   std::vector<SDsuClient> m_dsuClients;
+   std::vector<std::unique_ptr<SCompactClient>> m_compactClients;
+   std::vector<unsigned char> m_sendBuffer;
+   std::vector<SOutgoing> m_outgoing;
+   CDeltaHistory m_history[MAX_CONTROLLERS];
+   uint32_t m_sequences[MAX_CONTROLLERS];
+   bool m_connected[MAX_CONTROLLERS];
+   uint8_t m_battery[MAX_CONTROLLERS];
+   uint32_t m_dsuPacketNumbers[DSU_SLOTS];
+
+   std::atomic<uint64_t> m_reports;
+   std::atomic<uint64_t> m_requests;
+   std::atomic<uint64_t> m_dsuPackets;
+   std::atomic<uint64_t> m_dsuBytes;
+   std::atomic<uint64_t> m_compactDatagrams;
+   std::atomic<uint64_t> m_compactBytes;
+   std::atomic<uint64_t> m_compactRecords;
+   std::atomic<uint64_t> m_compactKeyframes;
+   std::atomic<uint64_t> m_sendErrors;
+};
@@ -0,0 +1,194 @@
+// =================================================================================================
+// Synthetic input source: a number of virtual DualShock 4 pads producing USB reports at a fixed
+// rate. Drives the core, the input thread and the delivery path without hardware on any platform.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CSyntheticInputSource.h"
+#include <chrono>
+#include <cstring>
+#include "CDeviceRegistry.h"
+#include "MonotonicClock.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CSyntheticInputSource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CSyntheticInputSource::CSyntheticInputSource(int deviceCount, unsigned int reportRateHz) :
+    m_sink(nullptr),
+    m_deviceCount(deviceCount < 0 ? 0 : (deviceCount > MAX_CONTROLLERS ? MAX_CONTROLLERS : deviceCount)),
+    m_periodNs(1000000000ull / (reportRateHz > 0 ? reportRateHz : 1)),
+    m_nextDueNs(0),
+    m_wakeRequested(false)
+{
+}
+
+// =================================================================================================
+// Open                     every virtual pad arrives as a USB DualShock 4
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CSyntheticInputSource::Open(IInputSink* sink)
+{
+    if (m_sink != nullptr)
+    {
+        return sink == m_sink;
+    }
+    if (sink == nullptr)
+    {
+        return false;
+    }
+
+    m_sink = sink;
+    m_devices.assign(m_deviceCount, SSyntheticDevice());
+
+    for (int i = 0; i < m_deviceCount; i++)
+    {
+        SHidDeviceDescriptor descriptor;
+        descriptor.vendorId = SONY_VENDOR_ID;
+        descriptor.productId = DS4_PRODUCT_ID_V2;
+        m_sink->OnDeviceArrived(&m_devices[i], (uint32_t)(i + 1), std::move(descriptor));
+    }
+
+    m_nextDueNs = MonotonicNowNs() + m_periodNs;
+    return true;
+}
+
+// =================================================================================================
+// Poll                     sleep until the next report is due, then hand over every due report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CSyntheticInputSource::Poll(int timeoutMs)
+{
+    if (m_sink == nullptr)
+    {
+        return -1;
+    }
+
+    uint64_t nowNs = MonotonicNowNs();
+    if (nowNs < m_nextDueNs)
+    {
+        uint64_t waitNs = m_nextDueNs - nowNs;
+        if (timeoutMs >= 0 && (uint64_t)timeoutMs * 1000000ull < waitNs)
+        {
+            waitNs = (uint64_t)timeoutMs * 1000000ull;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait_for(lock, std::chrono::nanoseconds(waitNs), [this] { return m_wakeRequested; });
+        m_wakeRequested = false;
+        lock.unlock();
+
+        nowNs = MonotonicNowNs();
+        if (nowNs < m_nextDueNs)
+        {
+            return 0;
+        }
+    }
+
+    uint64_t dueCount = (nowNs - m_nextDueNs) / m_periodNs + 1;
+    if (dueCount > SYNTHETIC_MAX_CATCH_UP)
+    {
+        m_nextDueNs += (dueCount - SYNTHETIC_MAX_CATCH_UP) * m_periodNs;
+        dueCount = SYNTHETIC_MAX_CATCH_UP;
+    }
+
+    int handled = 0;
+    for (uint64_t n = 0; n < dueCount; n++)
+    {
+        for (int i = 0; i < m_deviceCount; i++)
+        {
+            BuildReport(i, m_devices[i].reportIndex++, m_report);
+            if (m_sink->OnReport(&m_devices[i], m_report, SYNTHETIC_REPORT_SIZE, nowNs))
+            {
+                handled++;
+            }
+        }
+    }
+    m_nextDueNs += dueCount * m_periodNs;
+
+    m_sink->OnBatchEnd();
+    return handled;
+}
+
+// =================================================================================================
+// Wake
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSyntheticInputSource::Wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeRequested = true;
+    }
+    m_wakeCondition.notify_one();
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSyntheticInputSource::Close()
+{
+    if (m_sink == nullptr)
+    {
+        return;
+    }
+
+    for (SSyntheticDevice& device : m_devices)
+    {
+        m_sink->OnDeviceRemoved(&device);
+    }
+    m_sink = nullptr;
+}
+
+// =================================================================================================
+// BuildReport              sticks sweep, triggers ramp, the d-pad turns and one face button at a
+//                          time is held, so every decoded field keeps changing
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CSyntheticInputSource::BuildReport(int device, uint64_t reportIndex, unsigned char* report)
+{
+    std::memset(report, 0, SYNTHETIC_REPORT_SIZE);
+
+    unsigned char phase = (unsigned char)(reportIndex + device * 32);
+    report[0] = DS4_USB_REPORT_ID;
+    report[1] = phase;
+    report[2] = (unsigned char)(255 - phase);
+    report[3] = (unsigned char)(phase * 2);
+    report[4] = (unsigned char)(phase / 2);
+    report[5] = (unsigned char)(((reportIndex >> 6) & 0x07) | (0x10 << ((reportIndex >> 8) & 0x03)));
+    report[6] = (unsigned char)(1 << ((reportIndex >> 10) & 0x07));
+    report[7] = (unsigned char)((reportIndex & 0x3F) << 2);
+    report[8] = phase;
+    report[9] = (unsigned char)(255 - phase);
+
+    // Sensor clock one millisecond per report, yaw swinging, the pad lying flat, no fingers down
+    uint16_t sensorTicks = (uint16_t)(reportIndex * 188);
+    int16_t yaw = (int16_t)((int8_t)phase * 16);
+    int16_t accelZ = 8192;
+    report[10] = (unsigned char)sensorTicks;
+    report[11] = (unsigned char)(sensorTicks >> 8);
+    report[15] = (unsigned char)yaw;
+    report[16] = (unsigned char)((uint16_t)yaw >> 8);
+    report[23] = (unsigned char)accelZ;
+    report[24] = (unsigned char)(accelZ >> 8);
+    report[30] = 0x08;
+    report[35] = 0x80;
+    report[39] = 0x80;
+}
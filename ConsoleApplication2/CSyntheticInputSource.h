@@ -0,0 +1,63 @@
+// =================================================================================================
+// Synthetic input source: a number of virtual DualShock 4 pads producing USB reports at a fixed
+// rate. Drives the core, the input thread and the delivery path without hardware on any platform.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "IInputSource.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const size_t SYNTHETIC_REPORT_SIZE = 64;           // DS4 USB input report
+
+// Reports a late Poll catches up per device, older ones are skipped like a full HID queue would
+const int SYNTHETIC_MAX_CATCH_UP = 64;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CSyntheticInputSource : public IInputSource
+{
+public:
+   CSyntheticInputSource(int deviceCount, unsigned int reportRateHz);
+
+   // IInputSource
+   bool Open(IInputSink* sink) override;
+   int Poll(int timeoutMs) override;
+   void Wake() override;
+   void Close() override;
+
+   // The report the given device sends as its reportIndex-th report
+   static void BuildReport(int device, uint64_t reportIndex, unsigned char* report);
+
+private:
+   struct SSyntheticDevice
+   {
+      uint64_t reportIndex;
+   };
+
+   IInputSink* m_sink;
+   const int m_deviceCount;
+   const uint64_t m_periodNs;
+   uint64_t m_nextDueNs;
+   std::vector<SSyntheticDevice> m_devices;
+   unsigned char m_report[SYNTHETIC_REPORT_SIZE];
+
+   std::mutex m_wakeMutex;
+   std::condition_variable m_wakeCondition;
+   bool m_wakeRequested;
+};
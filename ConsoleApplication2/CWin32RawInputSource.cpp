@@ -0,0 +1,735 @@
+// =================================================================================================
+// Win32 raw input backend. Reads WM_INPUT / GetRawInputBuffer reports of the game pads registered
+// for a window and hands them to the portable core.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CWin32RawInputSource.h"
+#include <windows.h>
+#include <hidusage.h>
+#include <hidsdi.h>
+#include <hidpi.h>
+#include <tchar.h>
+#include <cstring>
+#include <vector>
+#include "CDeviceRegistry.h"
+#include "Ds4Motion.h"
+#include "MonotonicClock.h"
+#include "RawInputBatch.h"
+
+// =================================================================================================
+// ========================================= NAMESPACES ============================================
+
+// =================================================================================================
+// =========================================== MACROS ==============================================
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Blocks the GetRawInputBuffer buffer is sized for, it grows only if a larger block shows up
+const size_t RAW_INPUT_BATCH_BLOCKS = 64;
+
+const TCHAR RAW_INPUT_WINDOW_CLASS[] = _T("SonyJoystickRawInput");
+
+static_assert(sizeof(RAWINPUTHEADER) == sizeof(SRawInputHeader), "SRawInputHeader must mirror RAWINPUTHEADER");
+static_assert(offsetof(RAWINPUT, data.hid.bRawData) == RAW_HID_DATA_OFFSET, "SRawHidHeader must mirror RAWHID");
+
+// =================================================================================================
+// ================================ TYPES, CLASSES, STRUCTURES =====================================
+
+// Output reports of one HID device; raw input only reads, so the pad is opened through its device
+// path for writing
+class CWin32HidOutputDevice : public IPadOutputDevice
+{
+public:
+   CWin32HidOutputDevice(HANDLE hFile, size_t reportLength);
+   ~CWin32HidOutputDevice() override;
+
+   bool Write(const unsigned char* report, size_t length) override;
+
+private:
+   HANDLE m_hFile;
+   std::vector<unsigned char> m_report;    // caps.OutputReportByteLength, what WriteFile takes
+};
+
+// =================================================================================================
+// ================================== STATIC MEMBER VARIABLES ======================================
+
+// =================================================================================================
+// ===================================== GLOBAL VARIABLES ==========================================
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// DecodeHidPReport         decode a report through the HidP_* parser using the cached device caps
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool DecodeHidPReport(SHidDeviceDescriptor& descriptor, const unsigned char* report, size_t length, JSDATA& jsData)
+{
+    PHIDP_PREPARSED_DATA pPreparsedData = (PHIDP_PREPARSED_DATA)descriptor.preparsedData.data();
+    PCHAR reportBytes = (PCHAR)report;
+    ULONG reportLength = (ULONG)length;
+
+    for (const SValueField& valueField : descriptor.valueFields)
+    {
+        ULONG value;
+        if (HidP_GetUsageValue(HidP_Input, valueField.usagePage, 0, valueField.usage, &value, pPreparsedData, reportBytes, reportLength) == HIDP_STATUS_SUCCESS)
+        {
+            StoreFieldValue(jsData, valueField.field, value);
+        }
+    }
+
+    for (ULONG j = 0; j < BUTTONS_NUM; j++)
+    {
+        jsData.HandlePressed[j] = false;
+    }
+
+    USAGE* usages = descriptor.usageBuffer.data();
+    for (const SButtonRange& buttonRange : descriptor.buttonRanges)
+    {
+        ULONG usageLength = (ULONG)descriptor.usageBuffer.size();
+
+        if (HidP_GetUsages(HidP_Input, buttonRange.usagePage, 0, usages, &usageLength, pPreparsedData, reportBytes, reportLength) == HIDP_STATUS_SUCCESS)
+        {
+            // HidP_GetUsages lists every pressed button; usages past BUTTONS_NUM (PS, touchpad) have no slot
+            for (ULONG j = 0; j < usageLength; j++)
+            {
+                if (usages[j] >= 1 && usages[j] <= BUTTONS_NUM)
+                {
+                    jsData.HandlePressed[usages[j] - 1] = true;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// =================================================================================================
+// CWin32HidOutputDevice
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CWin32HidOutputDevice::CWin32HidOutputDevice(HANDLE hFile, size_t reportLength) :
+    m_hFile(hFile),
+    m_report(reportLength)
+{
+}
+
+// =================================================================================================
+// ~CWin32HidOutputDevice
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CWin32HidOutputDevice::~CWin32HidOutputDevice()
+{
+    CloseHandle(m_hFile);
+}
+
+// =================================================================================================
+// Write                    padded with zeros to the output report length of the device
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CWin32HidOutputDevice::Write(const unsigned char* report, size_t length)
+{
+    if (length > m_report.size())
+    {
+        m_report.resize(length);
+    }
+    std::memcpy(m_report.data(), report, length);
+    std::memset(m_report.data() + length, 0, m_report.size() - length);
+
+    DWORD written = 0;
+    return WriteFile(m_hFile, m_report.data(), (DWORD)m_report.size(), &written, NULL) && written == m_report.size();
+}
+
+// =================================================================================================
+// OpenHidDevice            the HID device path behind a raw input handle, opened with access;
+//                          INVALID_HANDLE_VALUE when the device has no path or cannot be opened
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static HANDLE OpenHidDevice(HANDLE hDevice, DWORD access)
+{
+    UINT nameLength = 0;
+    if (GetRawInputDeviceInfo(hDevice, RIDI_DEVICENAME, NULL, &nameLength) != 0 || nameLength == 0)
+    {
+        return INVALID_HANDLE_VALUE;
+    }
+
+    std::vector<TCHAR> name(nameLength + 1);
+    if (GetRawInputDeviceInfo(hDevice, RIDI_DEVICENAME, name.data(), &nameLength) == (UINT)-1)
+    {
+        return INVALID_HANDLE_VALUE;
+    }
+
+    return CreateFile(name.data(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+}
+
+// =================================================================================================
+// IsBluetoothDs4           the Bluetooth input report is 78 bytes, the USB one 64
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool IsBluetoothDs4(const HIDP_CAPS& caps)
+{
+    return caps.InputReportByteLength > 64;
+}
+
+// =================================================================================================
+// ReadDs4Calibration       the IMU feature report of a DS4 through its HID device path; left empty
+//                          when the pad cannot be opened or refuses it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ReadDs4Calibration(HANDLE hDevice, const HIDP_CAPS& caps, std::vector<unsigned char>& calibrationReport)
+{
+    HANDLE hFile = OpenHidDevice(hDevice, GENERIC_READ | GENERIC_WRITE);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    bool bluetooth = IsBluetoothDs4(caps);
+    size_t length = bluetooth ? DS4_CALIBRATION_BT_SIZE : DS4_CALIBRATION_USB_SIZE;
+    std::vector<unsigned char> report(caps.FeatureReportByteLength > length ? caps.FeatureReportByteLength : length);
+    report[0] = bluetooth ? DS4_CALIBRATION_BT_REPORT_ID : DS4_CALIBRATION_USB_REPORT_ID;
+    if (HidD_GetFeature(hFile, report.data(), (ULONG)report.size()))
+    {
+        calibrationReport.assign(report.begin(), report.begin() + length);
+    }
+
+    CloseHandle(hFile);
+}
+
+// =================================================================================================
+// BuildDeviceDescriptor    query the preparsed data and input caps of a device and map its usages
+//                          to JSDATA fields
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool BuildDeviceDescriptor(HANDLE hDevice, SHidDeviceDescriptor& descriptor)
+{
+    UINT cbSize = 0;
+
+    // Query the required buffer size for the preparsed data
+    if (GetRawInputDeviceInfo(hDevice, RIDI_PREPARSEDDATA, NULL, &cbSize) != 0)
+    {
+        return false;
+    }
+
+    descriptor.preparsedData.resize(cbSize);
+    if (GetRawInputDeviceInfo(hDevice, RIDI_PREPARSEDDATA, descriptor.preparsedData.data(), &cbSize) == (UINT)-1)
+    {
+        return false;
+    }
+
+    PHIDP_PREPARSED_DATA pPreparsedData = (PHIDP_PREPARSED_DATA)descriptor.preparsedData.data();
+
+    RID_DEVICE_INFO deviceInfo;
+    deviceInfo.cbSize = sizeof(deviceInfo);
+    cbSize = sizeof(deviceInfo);
+    if (GetRawInputDeviceInfo(hDevice, RIDI_DEVICEINFO, &deviceInfo, &cbSize) != (UINT)-1 && deviceInfo.dwType == RIM_TYPEHID)
+    {
+        descriptor.vendorId = deviceInfo.hid.dwVendorId;
+        descriptor.productId = deviceInfo.hid.dwProductId;
+    }
+
+    HIDP_CAPS caps;
+    if (HidP_GetCaps(pPreparsedData, &caps) != HIDP_STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    USHORT numValues = caps.NumberInputValueCaps;
+    USHORT numButtons = caps.NumberInputButtonCaps;
+
+    std::vector<HIDP_VALUE_CAPS> valueCaps(numValues);
+    std::vector<HIDP_BUTTON_CAPS> buttonCaps(numButtons);
+
+    if (numValues > 0 && HidP_GetValueCaps(HidP_Input, valueCaps.data(), &numValues, pPreparsedData) != HIDP_STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    if (numButtons > 0 && HidP_GetButtonCaps(HidP_Input, buttonCaps.data(), &numButtons, pPreparsedData) != HIDP_STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    for (USHORT i = 0; i < numValues; i++)
+    {
+        USAGE usageMin = valueCaps[i].IsRange ? valueCaps[i].Range.UsageMin : valueCaps[i].NotRange.Usage;
+        USAGE usageMax = valueCaps[i].IsRange ? valueCaps[i].Range.UsageMax : valueCaps[i].NotRange.Usage;
+
+        for (ULONG usage = usageMin; usage <= usageMax; usage++)
+        {
+            EJsField field = MapUsageToField(valueCaps[i].UsagePage, (USAGE)usage);
+            if (field != JSFIELD_NONE)
+            {
+                descriptor.valueFields.push_back({ valueCaps[i].UsagePage, (USAGE)usage, field });
+            }
+        }
+    }
+
+    for (USHORT i = 0; i < numButtons; i++)
+    {
+        if (buttonCaps[i].UsagePage == HID_USAGE_PAGE_BUTTON)
+        {
+            USAGE usageMin = buttonCaps[i].IsRange ? buttonCaps[i].Range.UsageMin : buttonCaps[i].NotRange.Usage;
+            USAGE usageMax = buttonCaps[i].IsRange ? buttonCaps[i].Range.UsageMax : buttonCaps[i].NotRange.Usage;
+
+            descriptor.buttonRanges.push_back({ buttonCaps[i].UsagePage, usageMin, usageMax });
+        }
+    }
+
+    // Sized once here so HidP_GetUsages never needs a buffer of its own on the report path
+    ULONG maxUsages = HidP_MaxUsageListLength(HidP_Input, HID_USAGE_PAGE_BUTTON, pPreparsedData);
+    descriptor.usageBuffer.resize(maxUsages > 0 ? maxUsages : 1);
+
+    if (SelectReportDecoder(descriptor.vendorId, descriptor.productId) == DECODER_DS4)
+    {
+        ReadDs4Calibration(hDevice, caps, descriptor.calibrationReport);
+
+        descriptor.bluetooth = IsBluetoothDs4(caps);
+        HANDLE hOutput = OpenHidDevice(hDevice, GENERIC_WRITE);
+        if (hOutput != INVALID_HANDLE_VALUE)
+        {
+            descriptor.output.reset(new CWin32HidOutputDevice(hOutput, caps.OutputReportByteLength));
+        }
+    }
+
+    descriptor.genericDecoder = DecodeHidPReport;
+    return true;
+}
+
+// =================================================================================================
+// GetDeviceIdentity        FNV-1a hash of the device path, the same pad keeps it across replugs
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t GetDeviceIdentity(HANDLE hDevice)
+{
+    UINT nameLength = 0;
+    if (GetRawInputDeviceInfo(hDevice, RIDI_DEVICENAME, NULL, &nameLength) != 0 || nameLength == 0)
+    {
+        return 0;
+    }
+
+    std::vector<TCHAR> name(nameLength);
+    if (GetRawInputDeviceInfo(hDevice, RIDI_DEVICENAME, name.data(), &nameLength) == (UINT)-1)
+    {
+        return 0;
+    }
+
+    uint32_t hash = 2166136261u;
+    for (TCHAR c : name)
+    {
+        if (c == 0)
+        {
+            break;
+        }
+        hash = (hash ^ (uint32_t)c) * 16777619u;
+    }
+
+    return hash;
+}
+
+// =================================================================================================
+// CWin32RawInputSource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CWin32RawInputSource::CWin32RawInputSource() :
+    m_sink(NULL),
+    m_hwnd(NULL),
+    m_ownsWindow(false),
+    m_threadId(0),
+    m_batchedRead(false),
+    m_reportsHandled(0)
+{
+}
+
+// =================================================================================================
+// ~CWin32RawInputSource
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CWin32RawInputSource::~CWin32RawInputSource()
+{
+    Close();
+}
+
+// =================================================================================================
+// SetTargetWindow
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CWin32RawInputSource::SetTargetWindow(HWND hwnd)
+{
+    m_hwnd = hwnd;
+}
+
+// =================================================================================================
+// SetBatchedRead
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CWin32RawInputSource::SetBatchedRead(bool batched)
+{
+    m_batchedRead = batched;
+}
+
+// =================================================================================================
+// MessageWindowProc        routes raw input of the message-only window to its source
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+LRESULT CALLBACK CWin32RawInputSource::MessageWindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    if (uMsg == WM_NCCREATE)
+    {
+        CREATESTRUCT* pCreate = (CREATESTRUCT*)lParam;
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)pCreate->lpCreateParams);
+    }
+
+    CWin32RawInputSource* pSource = (CWin32RawInputSource*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
+    if (pSource != NULL)
+    {
+        switch (uMsg)
+        {
+            case WM_INPUT:
+                pSource->ProcessRawInput((HRAWINPUT)lParam);
+                break;
+
+            case WM_INPUT_DEVICE_CHANGE:
+                pSource->ProcessDeviceChange(wParam, (HANDLE)lParam);
+                break;
+        }
+    }
+
+    return DefWindowProc(hwnd, uMsg, wParam, lParam);
+}
+
+// =================================================================================================
+// CreateMessageWindow      HWND_MESSAGE window: never shown, never painted, receives raw input only
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+HWND CWin32RawInputSource::CreateMessageWindow()
+{
+    HINSTANCE hInstance = GetModuleHandle(NULL);
+
+    WNDCLASSEX wc = {};
+    wc.cbSize = sizeof(WNDCLASSEX);
+    wc.lpfnWndProc = MessageWindowProc;
+    wc.hInstance = hInstance;
+    wc.lpszClassName = RAW_INPUT_WINDOW_CLASS;
+
+    if (!RegisterClassEx(&wc) && GetLastError() != ERROR_CLASS_ALREADY_EXISTS)
+    {
+        return NULL;
+    }
+
+    return CreateWindowEx(0, RAW_INPUT_WINDOW_CLASS, NULL, 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, hInstance, this);
+}
+
+// =================================================================================================
+// Open                     register the game pad usage for the target window. RIDEV_DEVNOTIFY
+//                          reports the pads already present through WM_INPUT_DEVICE_CHANGE.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CWin32RawInputSource::Open(IInputSink* sink)
+{
+    if (m_sink != NULL)
+    {
+        return sink == m_sink;
+    }
+    if (sink == NULL)
+    {
+        return false;
+    }
+
+    if (m_hwnd == NULL)
+    {
+        m_hwnd = CreateMessageWindow();
+        if (m_hwnd == NULL)
+        {
+            return false;
+        }
+        m_ownsWindow = true;
+    }
+
+    m_sink = sink;
+    m_threadId = GetCurrentThreadId();
+
+    RAWINPUTDEVICE rid[1];
+    rid[0].usUsagePage = 0x01; // Generic Desktop Controls
+    rid[0].usUsage = 0x05;     // Game Pad
+    rid[0].dwFlags = RIDEV_INPUTSINK | RIDEV_DEVNOTIFY;
+    rid[0].hwndTarget = m_hwnd;
+
+    if (RegisterRawInputDevices(rid, 1, sizeof(rid[0])) == FALSE)
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+// =================================================================================================
+// Poll                     pump the messages of the window thread, WM_INPUT reaches
+//                          ProcessRawInput through the window procedure
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CWin32RawInputSource::Poll(int timeoutMs)
+{
+    m_reportsHandled = 0;
+
+    DWORD timeout = timeoutMs < 0 ? INFINITE : (DWORD)timeoutMs;
+    if (MsgWaitForMultipleObjects(0, NULL, FALSE, timeout, QS_ALLINPUT) == WAIT_FAILED)
+    {
+        if (m_sink != NULL)
+        {
+            m_sink->OnInputError(NULL, INPUT_ERROR_READ, (int)GetLastError());
+        }
+        return -1;
+    }
+
+    MSG msg;
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+    {
+        if (msg.message == WM_QUIT)
+        {
+            return -1;
+        }
+
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+
+    return m_reportsHandled;
+}
+
+// =================================================================================================
+// Wake
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CWin32RawInputSource::Wake()
+{
+    if (m_threadId != 0)
+    {
+        PostThreadMessage(m_threadId, WM_NULL, 0, 0);
+    }
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CWin32RawInputSource::Close()
+{
+    if (m_sink == NULL)
+    {
+        return;
+    }
+
+    RAWINPUTDEVICE rid[1];
+    rid[0].usUsagePage = 0x01;
+    rid[0].usUsage = 0x05;
+    rid[0].dwFlags = RIDEV_REMOVE;
+    rid[0].hwndTarget = NULL;
+    RegisterRawInputDevices(rid, 1, sizeof(rid[0]));
+
+    if (m_ownsWindow)
+    {
+        DestroyWindow(m_hwnd);
+        m_hwnd = NULL;
+        m_ownsWindow = false;
+    }
+
+    m_sink = NULL;
+}
+
+// =================================================================================================
+// ProcessRawInput
+//
+// Author: Eran Yeruham, Date: 28 July 2024
+// -------------------------------------------------------------------------------------------------
+bool CWin32RawInputSource::ProcessRawInput(HRAWINPUT hRawInput)
+{
+    if (m_sink == NULL)
+    {
+        return false;
+    }
+
+    uint64_t timestampNs = MonotonicNowNs();
+
+    UINT dwSize = 0;
+    if (GetRawInputData(hRawInput, RID_INPUT, NULL, &dwSize, sizeof(RAWINPUTHEADER)) != 0)
+    {
+        m_sink->OnInputError(NULL, INPUT_ERROR_READ, (int)GetLastError());
+        return false;
+    }
+
+    // The buffer only grows, so once the largest report has been seen no further allocation happens
+    if (m_rawInputBuffer.size() < dwSize)
+    {
+        m_rawInputBuffer.resize(dwSize);
+    }
+
+    LPBYTE lpb = m_rawInputBuffer.data();
+    if (GetRawInputData(hRawInput, RID_INPUT, lpb, &dwSize, sizeof(RAWINPUTHEADER)) != dwSize)
+    {
+        m_sink->OnInputError(NULL, INPUT_ERROR_READ, (int)GetLastError());
+        return false;
+    }
+
+    RAWINPUT* raw = (RAWINPUT*)lpb;
+    if (raw->header.dwType != RIM_TYPEHID)
+    {
+        return false;
+    }
+
+    int decoded = ProcessHidBlock(raw->header.hDevice, raw->data.hid.bRawData, raw->data.hid.dwSizeHid, raw->data.hid.dwCount, timestampNs);
+
+    // Everything else already queued is picked up in the same wakeup
+    if (m_batchedRead)
+    {
+        DrainRawInputBuffer(timestampNs);
+    }
+
+    m_sink->OnBatchEnd();
+    return decoded > 0;
+}
+
+// =================================================================================================
+// DrainRawInputBuffer      read all pending reports with GetRawInputBuffer and decode them in one pass.
+//                          RAWINPUT has no arrival time of its own, so every report drained here is
+//                          stamped with the time of the wakeup; the core merges same-timestamp
+//                          reports of a pad in its filters rather than filter over a zero step.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CWin32RawInputSource::DrainRawInputBuffer(uint64_t timestampNs)
+{
+    UINT cbSize = 0;
+    if (GetRawInputBuffer(NULL, &cbSize, sizeof(RAWINPUTHEADER)) != 0 || cbSize == 0)
+    {
+        return;
+    }
+
+    // Room for a good number of blocks per call; QWORD elements keep the buffer block aligned
+    size_t wantedWords = ((size_t)cbSize * RAW_INPUT_BATCH_BLOCKS + sizeof(QWORD) - 1) / sizeof(QWORD);
+    if (m_rawBatchBuffer.size() < wantedWords)
+    {
+        m_rawBatchBuffer.resize(wantedWords);
+    }
+
+    for (;;)
+    {
+        UINT bufferSize = (UINT)(m_rawBatchBuffer.size() * sizeof(QWORD));
+        UINT blockCount = GetRawInputBuffer((PRAWINPUT)m_rawBatchBuffer.data(), &bufferSize, sizeof(RAWINPUTHEADER));
+        if (blockCount == (UINT)-1)
+        {
+            m_sink->OnInputError(NULL, INPUT_ERROR_READ, (int)GetLastError());
+            break;
+        }
+        if (blockCount == 0)
+        {
+            break;
+        }
+
+        ForEachRawInputBlock(m_rawBatchBuffer.data(), m_rawBatchBuffer.size() * sizeof(QWORD), blockCount,
+            [this, timestampNs](const SRawInputBlock& block)
+            {
+                ProcessHidBlock(block.device, block.reports, block.reportSize, block.reportCount, timestampNs);
+            });
+    }
+}
+
+// =================================================================================================
+// ProcessHidBlock          hand every report of one RAWHID block to the sink, returns the decoded count
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CWin32RawInputSource::ProcessHidBlock(HANDLE hDevice, const BYTE* reports, DWORD reportSize, DWORD reportCount, uint64_t timestampNs)
+{
+    if (reportSize == 0 || !AttachDevice(hDevice))
+    {
+        return 0;
+    }
+
+    int decoded = 0;
+    for (DWORD i = 0; i < reportCount; i++)
+    {
+        if (m_sink->OnReport(hDevice, reports + (size_t)i * reportSize, reportSize, timestampNs))
+        {
+            decoded++;
+        }
+    }
+
+    m_reportsHandled += decoded;
+    return decoded;
+}
+
+// =================================================================================================
+// ProcessDeviceChange      keep the registry in step with device arrival and removal
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CWin32RawInputSource::ProcessDeviceChange(WPARAM change, HANDLE hDevice)
+{
+    if (m_sink == NULL)
+    {
+        return;
+    }
+
+    if (change == GIDC_ARRIVAL)
+    {
+        AttachDevice(hDevice);
+    }
+    else if (change == GIDC_REMOVAL)
+    {
+        m_sink->OnDeviceRemoved(hDevice);
+    }
+}
+
+// =================================================================================================
+// AttachDevice             report the device to the sink with its descriptor on first sight
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CWin32RawInputSource::AttachDevice(HANDLE hDevice)
+{
+    if (m_sink->IsDeviceAttached(hDevice))
+    {
+        return true;
+    }
+
+    SHidDeviceDescriptor descriptor;
+    if (!BuildDeviceDescriptor(hDevice, descriptor))
+    {
+        m_sink->OnInputError(hDevice, INPUT_ERROR_DEVICE_INFO, (int)GetLastError());
+        return false;
+    }
+
+    return m_sink->OnDeviceArrived(hDevice, GetDeviceIdentity(hDevice), std::move(descriptor)) != INVALID_PLAYER_INDEX;
+}
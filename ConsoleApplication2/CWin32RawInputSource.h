@@ -0,0 +1,61 @@
+// =================================================================================================
+// Win32 raw input backend. Reads WM_INPUT / GetRawInputBuffer reports of the game pads registered
+// for a window and hands them to the portable core.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+#pragma comment(lib, "hid.lib")
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <windows.h>
+#include <vector>
+#include "IInputSource.h"
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+class CWin32RawInputSource : public IInputSource
+{
+public:
+   CWin32RawInputSource();
+   ~CWin32RawInputSource();
+
+   // Window that receives WM_INPUT, its procedure forwards to ProcessRawInput / ProcessDeviceChange.
+   // Without one, Open creates a message-only window of its own on the calling thread.
+   void SetTargetWindow(HWND hwnd);
+
+   // Drain every pending report per WM_INPUT wakeup through GetRawInputBuffer
+   void SetBatchedRead(bool batched);
+
+   // IInputSource, Open and Poll run on the thread that owns the target window
+   bool Open(IInputSink* sink) override;
+   int Poll(int timeoutMs) override;
+   void Wake() override;
+   void Close() override;
+
+   bool ProcessRawInput(HRAWINPUT hRawInput);
+   void ProcessDeviceChange(WPARAM change, HANDLE hDevice);
+
+private:
+   static LRESULT CALLBACK MessageWindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+   HWND CreateMessageWindow();
+   bool AttachDevice(HANDLE hDevice);
+   void DrainRawInputBuffer(uint64_t timestampNs);
+   int ProcessHidBlock(HANDLE hDevice, const BYTE* reports, DWORD reportSize, DWORD reportCount, uint64_t timestampNs);
+
+
+   IInputSink* m_sink;
+   HWND m_hwnd;
+   bool m_ownsWindow;
+   DWORD m_threadId;
+   bool m_batchedRead;
+   int m_reportsHandled;
+   std::vector<BYTE> m_rawInputBuffer;
+   std::vector<QWORD> m_rawBatchBuffer;
+};
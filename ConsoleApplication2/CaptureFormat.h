@@ -0,0 +1,123 @@
+// =================================================================================================
+// On-disk layout of an input capture: a file header followed by records, each a fixed record
+// header and its payload. Little-endian, no padding between records.
+//
+//   SCaptureFileHeader
+//   SCaptureRecordHeader  payload (length bytes)
+//   SCaptureRecordHeader  payload
+//   ...
+//
+// A capture cut short (crash, full disk) ends at its last complete record.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include "JSData.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const char CAPTURE_MAGIC[4] = { 'J', 'S', 'C', 'P' };
+const uint16_t CAPTURE_VERSION = 1;
+
+enum ECaptureRecord
+{
+	CAPTURE_RECORD_DEVICE_ARRIVED = 1,  // payload SCaptureDevice
+	CAPTURE_RECORD_DEVICE_REMOVED = 2,  // no payload
+	CAPTURE_RECORD_REPORT = 3,          // raw input report, report ID in the first byte
+	CAPTURE_RECORD_STATE = 4            // payload SCaptureState, sources that decode by themselves
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SCaptureFileHeader
+{
+	char magic[4];
+	uint16_t version;
+	uint16_t headerSize;        // sizeof(SCaptureFileHeader), records start here
+	uint64_t startNs;           // MonotonicNowNs() when the capture was opened
+	uint64_t reserved;
+};
+
+struct SCaptureRecordHeader
+{
+	uint8_t type;               // ECaptureRecord
+	uint8_t reserved;
+	uint16_t length;            // payload bytes that follow
+	uint32_t deviceId;          // numbered per arrival within the capture, from 1
+	uint64_t timestampNs;       // as the source stamped it, same clock as startNs
+};
+
+struct SCaptureDevice
+{
+	uint16_t vendorId;
+	uint16_t productId;
+	uint32_t identity;          // hash of the device path, as the registry keys players
+	uint32_t descriptorHash;    // HashDeviceDescriptor, tells apart devices sharing a VID/PID
+};
+
+struct SCaptureState
+{
+	int32_t axes[6];            // leftX, leftY, rightX, rightY, L2, R2
+	int32_t arrowValue;
+	uint32_t buttons;           // bit i = HandlePressed[i]
+};
+
+static_assert(sizeof(SCaptureFileHeader) == 24, "capture file header layout");
+static_assert(sizeof(SCaptureRecordHeader) == 16, "capture record header layout");
+static_assert(sizeof(SCaptureDevice) == 12, "capture device layout");
+static_assert(sizeof(SCaptureState) == 32, "capture state layout");
+
+// One record as the reader hands it out, payload points into the mapped file
+struct SCaptureRecordView
+{
+	ECaptureRecord type;
+	uint32_t deviceId;
+	uint64_t timestampNs;
+	const unsigned char* payload;
+	size_t length;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+inline void PackCaptureState(const JSDATA& jsData, SCaptureState& state)
+{
+	state.axes[0] = jsData.leftX;
+	state.axes[1] = jsData.leftY;
+	state.axes[2] = jsData.rightX;
+	state.axes[3] = jsData.rightY;
+	state.axes[4] = jsData.L2;
+	state.axes[5] = jsData.R2;
+	state.arrowValue = jsData.arrowValue;
+	state.buttons = 0;
+	for (int i = 0; i < BUTTONS_NUM; i++)
+	{
+		state.buttons |= uint32_t(jsData.HandlePressed[i]) << i;
+	}
+}
+
+inline void UnpackCaptureState(const SCaptureState& state, JSDATA& jsData)
+{
+	jsData.leftX = state.axes[0];
+	jsData.leftY = state.axes[1];
+	jsData.rightX = state.axes[2];
+	jsData.rightY = state.axes[3];
+	jsData.L2 = state.axes[4];
+	jsData.R2 = state.axes[5];
+	jsData.arrowValue = state.arrowValue;
+	for (int i = 0; i < BUTTONS_NUM; i++)
+	{
+		jsData.HandlePressed[i] = (state.buttons >> i) & 1;
+	}
+}
@@ -0,0 +1,71 @@
+// =================================================================================================
+// Instruction sets the SIMD kernels may use: what the compiler can emit for this build and what
+// the CPU running it supports, detected once with CPUID.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "CpuFeatures.h"
+#if JOYSTICK_HAVE_AVX2 && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// DetectCpuFeatures
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t DetectCpuFeatures()
+{
+    uint32_t features = 0;
+#if JOYSTICK_HAVE_SSE2
+    features |= CPU_FEATURE_SSE2;
+#endif
+
+#if JOYSTICK_HAVE_AVX2
+#if defined(_MSC_VER)
+    int registers[4];
+    __cpuid(registers, 0);
+    int maxLeaf = registers[0];
+    __cpuid(registers, 1);
+    bool osSavesYmm = (registers[2] & (1 << 27)) != 0 && (registers[2] & (1 << 28)) != 0 &&
+                      (_xgetbv(0) & 0x06) == 0x06;
+    if (osSavesYmm && maxLeaf >= 7)
+    {
+        __cpuidex(registers, 7, 0);
+        if ((registers[1] & (1 << 5)) != 0)
+        {
+            features |= CPU_FEATURE_AVX2;
+        }
+    }
+#else
+    // The GCC/Clang builtin checks OSXSAVE and XCR0 as well
+    if (__builtin_cpu_supports("avx2"))
+    {
+        features |= CPU_FEATURE_AVX2;
+    }
+#endif
+#endif
+
+    return features;
+}
+
+// =================================================================================================
+// GetCpuFeatures
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint32_t GetCpuFeatures()
+{
+    static const uint32_t features = DetectCpuFeatures();
+    return features;
+}
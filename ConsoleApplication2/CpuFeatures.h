@@ -0,0 +1,49 @@
+// =================================================================================================
+// Instruction sets the SIMD kernels may use: what the compiler can emit for this build and what
+// the CPU running it supports, detected once with CPUID.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// SSE2 is part of the baseline of every x64 build and of x86 builds that enable it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JOYSTICK_HAVE_SSE2 1
+#else
+#define JOYSTICK_HAVE_SSE2 0
+#endif
+
+// AVX2 kernels are compiled into x86 builds regardless of the target flags and only called when
+// the CPU reports AVX2. GCC and Clang need the instruction set enabled per function.
+#if JOYSTICK_HAVE_SSE2 && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define JOYSTICK_HAVE_AVX2 1
+#if defined(__GNUC__)
+#define JOYSTICK_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define JOYSTICK_TARGET_AVX2
+#endif
+#else
+#define JOYSTICK_HAVE_AVX2 0
+#define JOYSTICK_TARGET_AVX2
+#endif
+
+// Bits of GetCpuFeatures()
+const uint32_t CPU_FEATURE_SSE2 = 0x01;
+const uint32_t CPU_FEATURE_AVX2 = 0x02;     // also requires the OS to save the YMM registers
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// CPU_FEATURE_* the running CPU supports, limited to what this build has kernels for
+uint32_t GetCpuFeatures();
@@ -0,0 +1,68 @@
+// =================================================================================================
+// CRC-32 (IEEE 802.3) as used by the DualShock 4 / DualSense Bluetooth reports.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "Crc32.h"
+
+// =================================================================================================
+// ================================ TYPES, CLASSES, STRUCTURES =====================================
+
+struct SCrc32Table
+{
+    uint32_t entries[256];
+
+    constexpr SCrc32Table() : entries()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+// =================================================================================================
+// ===================================== GLOBAL VARIABLES ==========================================
+
+static constexpr SCrc32Table s_crc32Table;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// Crc32Update
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint32_t Crc32Update(uint32_t crc, const unsigned char* data, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = s_crc32Table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+// =================================================================================================
+// Crc32Report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint32_t Crc32Report(unsigned char seed, const unsigned char* report, size_t length)
+{
+    uint32_t crc = Crc32Update(CRC32_INITIAL, &seed, 1);
+    crc = Crc32Update(crc, report, length);
+    return Crc32Final(crc);
+}
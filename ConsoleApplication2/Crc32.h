@@ -0,0 +1,39 @@
+// =================================================================================================
+// CRC-32 (IEEE 802.3) as used by the DualShock 4 / DualSense Bluetooth reports.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint32_t CRC32_INITIAL = 0xFFFFFFFF;
+
+// Seed bytes the Sony Bluetooth reports prepend to the CRC input (HID transaction header)
+const unsigned char CRC32_SEED_BT_INPUT = 0xA1;
+const unsigned char CRC32_SEED_BT_OUTPUT = 0xA2;
+const unsigned char CRC32_SEED_BT_FEATURE = 0xA3;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// Running update, start with CRC32_INITIAL and finish with Crc32Final
+uint32_t Crc32Update(uint32_t crc, const unsigned char* data, size_t length);
+
+inline uint32_t Crc32Final(uint32_t crc)
+{
+	return ~crc;
+}
+
+// CRC of a Bluetooth report, seed byte followed by the report bytes
+uint32_t Crc32Report(unsigned char seed, const unsigned char* report, size_t length);
@@ -0,0 +1,493 @@
+// =================================================================================================
+// Compact UDP state protocol of the state server. A datagram carries several reports; each record
+// holds only the field groups that differ from its base: the state the client last acknowledged,
+// the previous record of the pad in the same datagram, or the idle state for a keyframe. Bases are
+// only ever states the client is known to hold, so a lost datagram costs nothing but itself.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "DeltaProtocol.h"
+#include <cstring>
+#include "ByteOrder.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Bytes of each field group, by bit
+const size_t DELTA_FIELD_SIZES[11] = { 4, 1, 4, 4, 4, 6, 6, 2, 12, 1, 1 };
+
+const uint16_t DELTA_FIELDS_ALL = 0x07FF;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// GetDeltaFieldMask        the groups are compared as wholes, a stick that moved on one axis
+//                          sends both
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint16_t GetDeltaFieldMask(const SPadState& base, const SPadState& state)
+{
+    uint16_t mask = 0;
+    mask |= base.buttons != state.buttons ? DELTA_FIELD_BUTTONS : 0;
+    mask |= base.hat != state.hat ? DELTA_FIELD_HAT : 0;
+    mask |= (base.leftX != state.leftX || base.leftY != state.leftY) ? DELTA_FIELD_LEFT_STICK : 0;
+    mask |= (base.rightX != state.rightX || base.rightY != state.rightY) ? DELTA_FIELD_RIGHT_STICK : 0;
+    mask |= (base.L2 != state.L2 || base.R2 != state.R2) ? DELTA_FIELD_TRIGGERS : 0;
+    mask |= std::memcmp(base.gyro, state.gyro, sizeof(state.gyro)) != 0 ? DELTA_FIELD_GYRO : 0;
+    mask |= std::memcmp(base.accel, state.accel, sizeof(state.accel)) != 0 ? DELTA_FIELD_ACCEL : 0;
+    mask |= base.sensorTimestamp != state.sensorTimestamp ? DELTA_FIELD_SENSOR_TIME : 0;
+    mask |= std::memcmp(base.touch, state.touch, sizeof(state.touch)) != 0 ? DELTA_FIELD_TOUCH : 0;
+    mask |= base.battery != state.battery ? DELTA_FIELD_BATTERY : 0;
+    mask |= base.flags != state.flags ? DELTA_FIELD_FLAGS : 0;
+    return mask;
+}
+
+// =================================================================================================
+// GetDeltaRecordSize
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t GetDeltaRecordSize(uint16_t fieldMask)
+{
+    size_t size = DELTA_RECORD_HEADER_SIZE;
+    for (int bit = 0; bit < 11; bit++)
+    {
+        if ((fieldMask >> bit) & 1)
+        {
+            size += DELTA_FIELD_SIZES[bit];
+        }
+    }
+    return size;
+}
+
+// =================================================================================================
+// WriteDeltaDatagramHeader
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void WriteDeltaDatagramHeader(uint32_t serverId, uint8_t recordCount, unsigned char* datagram)
+{
+    std::memcpy(datagram, DELTA_MAGIC_SERVER, 4);
+    StoreLe16(datagram + 4, DELTA_PROTOCOL_VERSION);
+    datagram[6] = recordCount;
+    datagram[7] = 0;
+    StoreLe32(datagram + 8, serverId);
+}
+
+// =================================================================================================
+// WriteDeltaRecord
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t WriteDeltaRecord(const SDeltaRecordHeader& header, const SPadState& state, unsigned char* bytes)
+{
+    uint16_t mask = header.fieldMask;
+    bytes[0] = header.playerIndex;
+    bytes[1] = header.baseDistance;
+    StoreLe16(bytes + 2, mask);
+    StoreLe32(bytes + 4, header.sequence);
+    StoreLe32(bytes + 8, header.timeUs);
+
+    unsigned char* out = bytes + DELTA_RECORD_HEADER_SIZE;
+    if (mask & DELTA_FIELD_BUTTONS)
+    {
+        StoreLe32(out, state.buttons);
+        out += 4;
+    }
+    if (mask & DELTA_FIELD_HAT)
+    {
+        *out++ = state.hat;
+    }
+    if (mask & DELTA_FIELD_LEFT_STICK)
+    {
+        StoreLe16(out, state.leftX);
+        StoreLe16(out + 2, state.leftY);
+        out += 4;
+    }
+    if (mask & DELTA_FIELD_RIGHT_STICK)
+    {
+        StoreLe16(out, state.rightX);
+        StoreLe16(out + 2, state.rightY);
+        out += 4;
+    }
+    if (mask & DELTA_FIELD_TRIGGERS)
+    {
+        StoreLe16(out, state.L2);
+        StoreLe16(out + 2, state.R2);
+        out += 4;
+    }
+    if (mask & DELTA_FIELD_GYRO)
+    {
+        for (int i = 0; i < 3; i++, out += 2)
+        {
+            StoreLe16(out, (uint16_t)state.gyro[i]);
+        }
+    }
+    if (mask & DELTA_FIELD_ACCEL)
+    {
+        for (int i = 0; i < 3; i++, out += 2)
+        {
+            StoreLe16(out, (uint16_t)state.accel[i]);
+        }
+    }
+    if (mask & DELTA_FIELD_SENSOR_TIME)
+    {
+        StoreLe16(out, state.sensorTimestamp);
+        out += 2;
+    }
+    if (mask & DELTA_FIELD_TOUCH)
+    {
+        for (int i = 0; i < PAD_TOUCH_POINTS; i++, out += 6)
+        {
+            StoreLe16(out, state.touch[i].x);
+            StoreLe16(out + 2, state.touch[i].y);
+            out[4] = state.touch[i].id;
+            out[5] = state.touch[i].active;
+        }
+    }
+    if (mask & DELTA_FIELD_BATTERY)
+    {
+        *out++ = state.battery;
+    }
+    if (mask & DELTA_FIELD_FLAGS)
+    {
+        *out++ = state.flags;
+    }
+    return (size_t)(out - bytes);
+}
+
+// =================================================================================================
+// ParseDeltaRecordHeader
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t ParseDeltaRecordHeader(const unsigned char* bytes, size_t length, SDeltaRecordHeader& header)
+{
+    if (length < DELTA_RECORD_HEADER_SIZE)
+    {
+        return 0;
+    }
+
+    header.playerIndex = bytes[0];
+    header.baseDistance = bytes[1];
+    header.fieldMask = LoadLe16(bytes + 2);
+    header.sequence = LoadLe32(bytes + 4);
+    header.timeUs = LoadLe32(bytes + 8);
+    return DELTA_RECORD_HEADER_SIZE;
+}
+
+// =================================================================================================
+// ApplyDeltaRecord         the groups are read into the base in place
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t ApplyDeltaRecord(const unsigned char* bytes, size_t length, const SDeltaRecordHeader& header, SPadState& state)
+{
+    uint16_t mask = header.fieldMask;
+    size_t size = GetDeltaRecordSize(mask) - DELTA_RECORD_HEADER_SIZE;
+    if (length < size)
+    {
+        return 0;
+    }
+
+    const unsigned char* in = bytes;
+    if (mask & DELTA_FIELD_BUTTONS)
+    {
+        state.buttons = LoadLe32(in);
+        in += 4;
+    }
+    if (mask & DELTA_FIELD_HAT)
+    {
+        state.hat = *in++;
+    }
+    if (mask & DELTA_FIELD_LEFT_STICK)
+    {
+        state.leftX = LoadLe16(in);
+        state.leftY = LoadLe16(in + 2);
+        in += 4;
+    }
+    if (mask & DELTA_FIELD_RIGHT_STICK)
+    {
+        state.rightX = LoadLe16(in);
+        state.rightY = LoadLe16(in + 2);
+        in += 4;
+    }
+    if (mask & DELTA_FIELD_TRIGGERS)
+    {
+        state.L2 = LoadLe16(in);
+        state.R2 = LoadLe16(in + 2);
+        in += 4;
+    }
+    if (mask & DELTA_FIELD_GYRO)
+    {
+        for (int i = 0; i < 3; i++, in += 2)
+        {
+            state.gyro[i] = (int16_t)LoadLe16(in);
+        }
+    }
+    if (mask & DELTA_FIELD_ACCEL)
+    {
+        for (int i = 0; i < 3; i++, in += 2)
+        {
+            state.accel[i] = (int16_t)LoadLe16(in);
+        }
+    }
+    if (mask & DELTA_FIELD_SENSOR_TIME)
+    {
+        state.sensorTimestamp = LoadLe16(in);
+        in += 2;
+    }
+    if (mask & DELTA_FIELD_TOUCH)
+    {
+        for (int i = 0; i < PAD_TOUCH_POINTS; i++, in += 6)
+        {
+            state.touch[i].x = LoadLe16(in);
+            state.touch[i].y = LoadLe16(in + 2);
+            state.touch[i].id = in[4];
+            state.touch[i].active = in[5];
+        }
+    }
+    if (mask & DELTA_FIELD_BATTERY)
+    {
+        state.battery = *in++;
+    }
+    if (mask & DELTA_FIELD_FLAGS)
+    {
+        state.flags = *in++;
+    }
+
+    state.timestampNs = (uint64_t)header.timeUs * 1000;
+    state.sequence = header.sequence;
+    state.playerIndex = header.playerIndex;
+    return size;
+}
+
+// =================================================================================================
+// BuildDeltaClientMessage
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t BuildDeltaClientMessage(const SDeltaClientMessage& message, unsigned char* packet)
+{
+    std::memcpy(packet, DELTA_MAGIC_CLIENT, 4);
+    StoreLe16(packet + 4, DELTA_PROTOCOL_VERSION);
+    packet[6] = message.message;
+    packet[7] = message.playerMask;
+    StoreLe32(packet + 8, message.clientId);
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        StoreLe32(packet + 12 + 4 * i, message.acked[i]);
+    }
+    return DELTA_CLIENT_MESSAGE_SIZE;
+}
+
+// =================================================================================================
+// ParseDeltaClientMessage
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool ParseDeltaClientMessage(const unsigned char* packet, size_t length, SDeltaClientMessage& message)
+{
+    if (length < DELTA_CLIENT_MESSAGE_SIZE || std::memcmp(packet, DELTA_MAGIC_CLIENT, 4) != 0 ||
+        LoadLe16(packet + 4) != DELTA_PROTOCOL_VERSION)
+    {
+        return false;
+    }
+
+    message.message = packet[6];
+    message.playerMask = packet[7];
+    message.clientId = LoadLe32(packet + 8);
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        message.acked[i] = LoadLe32(packet + 12 + 4 * i);
+    }
+    return message.message == DELTA_CLIENT_SUBSCRIBE || message.message == DELTA_CLIENT_UNSUBSCRIBE;
+}
+
+// =================================================================================================
+// CDeltaHistory
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CDeltaHistory::CDeltaHistory()
+{
+    Reset();
+}
+
+// =================================================================================================
+// Reset                    sequence 0 is never stored, so it marks the empty entries
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CDeltaHistory::Reset()
+{
+    std::memset(m_sequences, 0, sizeof(m_sequences));
+}
+
+// =================================================================================================
+// Store
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CDeltaHistory::Store(uint32_t sequence, const SPadState& state)
+{
+    uint32_t index = sequence & (DELTA_HISTORY - 1);
+    m_states[index] = state;
+    m_sequences[index] = sequence;
+}
+
+// =================================================================================================
+// Find
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+const SPadState* CDeltaHistory::Find(uint32_t sequence) const
+{
+    uint32_t index = sequence & (DELTA_HISTORY - 1);
+    if (sequence == 0 || m_sequences[index] != sequence)
+    {
+        return nullptr;
+    }
+    return &m_states[index];
+}
+
+// =================================================================================================
+// CDeltaDecoder
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CDeltaDecoder::CDeltaDecoder()
+{
+    Reset();
+}
+
+// =================================================================================================
+// Reset
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CDeltaDecoder::Reset()
+{
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        m_history[i].Reset();
+        m_states[i] = SPadState();
+        m_latest[i] = 0;
+    }
+    m_records = 0;
+    m_missingBases = 0;
+}
+
+// =================================================================================================
+// Decode                   a record older than the pad's latest, reordered on the way, still
+//                          goes into the history for the records based on it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CDeltaDecoder::Decode(const unsigned char* datagram, size_t length)
+{
+    if (length < DELTA_DATAGRAM_HEADER_SIZE || std::memcmp(datagram, DELTA_MAGIC_SERVER, 4) != 0 ||
+        LoadLe16(datagram + 4) != DELTA_PROTOCOL_VERSION)
+    {
+        return false;
+    }
+
+    int recordCount = datagram[6];
+    size_t offset = DELTA_DATAGRAM_HEADER_SIZE;
+    for (int record = 0; record < recordCount; record++)
+    {
+        SDeltaRecordHeader header;
+        size_t headerSize = ParseDeltaRecordHeader(datagram + offset, length - offset, header);
+        if (headerSize == 0 || header.playerIndex >= MAX_CONTROLLERS)
+        {
+            return false;
+        }
+        offset += headerSize;
+
+        int playerIndex = header.playerIndex;
+        if (header.fieldMask & DELTA_FIELD_DISCONNECTED)
+        {
+            m_history[playerIndex].Reset();
+            m_states[playerIndex] = SPadState();
+            m_latest[playerIndex] = 0;
+            m_records++;
+            continue;
+        }
+
+        SPadState state = SPadState();
+        const SPadState* pBase = nullptr;
+        if (header.baseDistance != 0)
+        {
+            pBase = m_history[playerIndex].Find(header.sequence - header.baseDistance);
+            if (pBase == nullptr)
+            {
+                m_missingBases++;
+            }
+            else
+            {
+                state = *pBase;
+            }
+        }
+
+        size_t fieldSize = ApplyDeltaRecord(datagram + offset, length - offset, header, state);
+        if (fieldSize == 0 && (header.fieldMask & DELTA_FIELDS_ALL) != 0)
+        {
+            return false;
+        }
+        offset += fieldSize;
+        if (header.baseDistance != 0 && pBase == nullptr)
+        {
+            continue;
+        }
+
+        m_history[playerIndex].Store(header.sequence, state);
+        if (m_latest[playerIndex] == 0 || (int32_t)(header.sequence - m_latest[playerIndex]) > 0)
+        {
+            m_states[playerIndex] = state;
+            m_latest[playerIndex] = header.sequence;
+        }
+        m_records++;
+    }
+    return true;
+}
+
+// =================================================================================================
+// GetState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CDeltaDecoder::GetState(int playerIndex, SPadState& state) const
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS || m_latest[playerIndex] == 0)
+    {
+        return false;
+    }
+    state = m_states[playerIndex];
+    return true;
+}
+
+// =================================================================================================
+// BuildAck                 subscribes, renews and acknowledges the latest record of every pad
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t CDeltaDecoder::BuildAck(uint32_t clientId, uint8_t playerMask, unsigned char* packet) const
+{
+    SDeltaClientMessage message = SDeltaClientMessage();
+    message.message = DELTA_CLIENT_SUBSCRIBE;
+    message.playerMask = playerMask;
+    message.clientId = clientId;
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        message.acked[i] = m_latest[i];
+    }
+    return BuildDeltaClientMessage(message, packet);
+}
@@ -0,0 +1,147 @@
+// =================================================================================================
+// Compact UDP state protocol of the state server. A datagram carries several reports; each record
+// holds only the field groups that differ from its base: the state the client last acknowledged,
+// the previous record of the pad in the same datagram, or the idle state for a keyframe. Bases are
+// only ever states the client is known to hold, so a lost datagram costs nothing but itself.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include "CDeviceRegistry.h"
+#include "PadState.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const char DELTA_MAGIC_SERVER[4] = { 'J', 'S', 'D', 'S' };
+const char DELTA_MAGIC_CLIENT[4] = { 'J', 'S', 'D', 'C' };
+const uint16_t DELTA_PROTOCOL_VERSION = 1;
+const uint16_t DELTA_DEFAULT_PORT = 26761;
+
+// Below the path MTU of any link the state is streamed over, so no datagram is fragmented
+const size_t DELTA_MAX_DATAGRAM = 1200;
+
+const size_t DELTA_DATAGRAM_HEADER_SIZE = 12;   // magic, version, record count, server id
+const size_t DELTA_RECORD_HEADER_SIZE = 12;     // player, base distance, field mask, sequence, time
+const size_t DELTA_MAX_RECORD_SIZE = DELTA_RECORD_HEADER_SIZE + 45;
+const size_t DELTA_CLIENT_MESSAGE_SIZE = 12 + 4 * MAX_CONTROLLERS;
+
+// States both ends keep per pad to resolve bases, power of two; an acknowledgement older than
+// this turns the next record into a keyframe
+const uint32_t DELTA_HISTORY = 64;
+
+const uint64_t DELTA_SUBSCRIPTION_TIMEOUT_NS = 5000000000ULL;
+
+// Field groups of a record, in the order their bytes follow the record header
+enum EDeltaField
+{
+	DELTA_FIELD_BUTTONS = 0x0001,       // 4 bytes
+	DELTA_FIELD_HAT = 0x0002,           // 1
+	DELTA_FIELD_LEFT_STICK = 0x0004,    // 4
+	DELTA_FIELD_RIGHT_STICK = 0x0008,   // 4
+	DELTA_FIELD_TRIGGERS = 0x0010,      // 4
+	DELTA_FIELD_GYRO = 0x0020,          // 6
+	DELTA_FIELD_ACCEL = 0x0040,         // 6
+	DELTA_FIELD_SENSOR_TIME = 0x0080,   // 2
+	DELTA_FIELD_TOUCH = 0x0100,         // 12
+	DELTA_FIELD_BATTERY = 0x0200,       // 1
+	DELTA_FIELD_FLAGS = 0x0400,         // 1
+	DELTA_FIELD_DISCONNECTED = 0x8000   // no bytes; the pad went away, the client drops its state
+};
+
+enum EDeltaClientMessage
+{
+	DELTA_CLIENT_SUBSCRIBE = 1,         // subscribes or renews, and acknowledges
+	DELTA_CLIENT_UNSUBSCRIBE = 2
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SDeltaRecordHeader
+{
+	uint8_t playerIndex;
+	uint8_t baseDistance;       // sequence minus the base's sequence, 0 for a keyframe
+	uint16_t fieldMask;         // EDeltaField bits
+	uint32_t sequence;          // per pad, counted by the server from 1
+	uint32_t timeUs;            // low 32 bits of the report's timestamp in microseconds
+};
+
+// Subscription of a client, repeated with every acknowledgement
+struct SDeltaClientMessage
+{
+	uint8_t message;            // EDeltaClientMessage
+	uint8_t playerMask;         // pads the client wants, bit per player index
+	uint32_t clientId;
+	uint32_t acked[MAX_CONTROLLERS];    // latest sequence the client holds per pad, 0 for none
+};
+
+// The last DELTA_HISTORY states of one pad by sequence
+class CDeltaHistory
+{
+public:
+   CDeltaHistory();
+
+   void Reset();
+   void Store(uint32_t sequence, const SPadState& state);
+   // Null when the sequence was never stored or is evicted
+   const SPadState* Find(uint32_t sequence) const;
+
+private:
+   SPadState m_states[DELTA_HISTORY];
+   uint32_t m_sequences[DELTA_HISTORY];
+};
+
+// Client side: applies the records of server datagrams and keeps what the acknowledgements need
+class CDeltaDecoder
+{
+public:
+   CDeltaDecoder();
+
+   void Reset();
+   // False for a datagram that is not a valid server datagram; records whose base the decoder no
+   // longer holds are skipped and counted
+   bool Decode(const unsigned char* datagram, size_t length);
+
+   // Latest state of a pad; its sequence is the record sequence, not the core's
+   bool GetState(int playerIndex, SPadState& state) const;
+   size_t BuildAck(uint32_t clientId, uint8_t playerMask, unsigned char* packet) const;
+
+   uint64_t GetRecordCount() const { return m_records; }
+   uint64_t GetMissingBaseCount() const { return m_missingBases; }
+
+private:
+   CDeltaHistory m_history[MAX_CONTROLLERS];
+   SPadState m_states[MAX_CONTROLLERS];
+   uint32_t m_latest[MAX_CONTROLLERS];    // 0 until a record arrived, and after a disconnect
+   uint64_t m_records;
+   uint64_t m_missingBases;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// Field groups in which the two states differ
+uint16_t GetDeltaFieldMask(const SPadState& base, const SPadState& state);
+size_t GetDeltaRecordSize(uint16_t fieldMask);
+
+void WriteDeltaDatagramHeader(uint32_t serverId, uint8_t recordCount, unsigned char* datagram);
+// Header and the groups of fieldMask; bytes has room for DELTA_MAX_RECORD_SIZE
+size_t WriteDeltaRecord(const SDeltaRecordHeader& header, const SPadState& state, unsigned char* bytes);
+
+// A record is its header and then the field bytes; state holds the base on entry and the decoded
+// state on return. Both return the bytes taken, 0 when the record is cut short.
+size_t ParseDeltaRecordHeader(const unsigned char* bytes, size_t length, SDeltaRecordHeader& header);
+size_t ApplyDeltaRecord(const unsigned char* bytes, size_t length, const SDeltaRecordHeader& header, SPadState& state);
+
+size_t BuildDeltaClientMessage(const SDeltaClientMessage& message, unsigned char* packet);
+bool ParseDeltaClientMessage(const unsigned char* packet, size_t length, SDeltaClientMessage& message);
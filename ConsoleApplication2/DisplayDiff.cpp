@@ -0,0 +1,126 @@
+// =================================================================================================
+// Line layout of the data window and the diff that decides which lines need to be redrawn. Kept
+// free of GDI so it can be measured and exercised on any platform.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "DisplayDiff.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+static_assert(DISPLAY_LINE_COUNT <= 32, "display lines must fit the dirty mask");
+
+// Buttons start below the axes with a gap, the player line follows them with another one
+const int DISPLAY_AXES_TOP = 10;
+const int DISPLAY_BUTTONS_TOP = 160;
+const int DISPLAY_SECTION_GAP = 10;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// DiffDisplayLines         lines whose text differs between two states
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint32_t DiffDisplayLines(const JSDATA& drawn, const JSDATA& current)
+{
+    uint32_t dirty = 0;
+
+    dirty |= uint32_t(drawn.leftX != current.leftX) << DISPLAY_LINE_LEFT_X;
+    dirty |= uint32_t(drawn.leftY != current.leftY) << DISPLAY_LINE_LEFT_Y;
+    dirty |= uint32_t(drawn.rightX != current.rightX) << DISPLAY_LINE_RIGHT_X;
+    dirty |= uint32_t(drawn.rightY != current.rightY) << DISPLAY_LINE_RIGHT_Y;
+    dirty |= uint32_t(drawn.R2 != current.R2) << DISPLAY_LINE_R2;
+    dirty |= uint32_t(drawn.L2 != current.L2) << DISPLAY_LINE_L2;
+    dirty |= uint32_t(drawn.arrowValue != current.arrowValue) << DISPLAY_LINE_ARROW;
+
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        dirty |= uint32_t(drawn.HandlePressed[i] != current.HandlePressed[i]) << (DISPLAY_LINE_BUTTON_FIRST + i);
+    }
+
+    return dirty;
+}
+
+// =================================================================================================
+// GetDisplayLineTop        y of a line's text, as DrawTextOnDC has always laid them out
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int GetDisplayLineTop(int line)
+{
+    if (line < DISPLAY_LINE_BUTTON_FIRST)
+    {
+        return DISPLAY_AXES_TOP + line * DISPLAY_LINE_HEIGHT;
+    }
+    if (line < DISPLAY_LINE_PLAYER)
+    {
+        return DISPLAY_BUTTONS_TOP + (line - DISPLAY_LINE_BUTTON_FIRST) * DISPLAY_LINE_HEIGHT;
+    }
+    return DISPLAY_BUTTONS_TOP + BUTTONS_NUM * DISPLAY_LINE_HEIGHT + DISPLAY_SECTION_GAP +
+        (line - DISPLAY_LINE_PLAYER) * DISPLAY_LINE_HEIGHT;
+}
+
+// =================================================================================================
+// GetDisplayLineRect       full-width band of one line
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+SDisplayRect GetDisplayLineRect(int line, int clientWidth)
+{
+    int top = GetDisplayLineTop(line);
+    SDisplayRect rect = { 0, top, clientWidth, top + DISPLAY_LINE_HEIGHT };
+    return rect;
+}
+
+// =================================================================================================
+// CDisplayDiff
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CDisplayDiff::CDisplayDiff() :
+    m_playerIndex(0),
+    m_connectedCount(0),
+    m_valid(false)
+{
+}
+
+// =================================================================================================
+// Update
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint32_t CDisplayDiff::Update(const JSDATA& jsData, int playerIndex, int connectedCount)
+{
+    uint32_t dirty = DISPLAY_ALL_LINES;
+    if (m_valid)
+    {
+        // Switching to another player only redraws the lines whose text differs
+        dirty = DiffDisplayLines(m_drawn, jsData);
+        dirty |= uint32_t(playerIndex != m_playerIndex || connectedCount != m_connectedCount) << DISPLAY_LINE_PLAYER;
+    }
+
+    m_drawn = jsData;
+    m_playerIndex = playerIndex;
+    m_connectedCount = connectedCount;
+    m_valid = true;
+    return dirty;
+}
+
+// =================================================================================================
+// Invalidate               the next Update redraws every line
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CDisplayDiff::Invalidate()
+{
+    m_valid = false;
+}
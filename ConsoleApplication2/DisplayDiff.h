@@ -0,0 +1,77 @@
+// =================================================================================================
+// Line layout of the data window and the diff that decides which lines need to be redrawn. Kept
+// free of GDI so it can be measured and exercised on any platform.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include "JSData.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// One text line of the data window each, top to bottom
+enum EDisplayLine
+{
+	DISPLAY_LINE_LEFT_X,
+	DISPLAY_LINE_LEFT_Y,
+	DISPLAY_LINE_RIGHT_X,
+	DISPLAY_LINE_RIGHT_Y,
+	DISPLAY_LINE_R2,
+	DISPLAY_LINE_L2,
+	DISPLAY_LINE_ARROW,
+	DISPLAY_LINE_BUTTON_FIRST,
+	DISPLAY_LINE_PLAYER = DISPLAY_LINE_BUTTON_FIRST + BUTTONS_NUM,
+	DISPLAY_LINE_STATS_RATE,        // report rate and losses of the shown player, when stats are on
+	DISPLAY_LINE_STATS_LATENCY,
+	DISPLAY_LINE_COUNT
+};
+
+const uint32_t DISPLAY_ALL_LINES = (1u << DISPLAY_LINE_COUNT) - 1;
+
+const int DISPLAY_TEXT_LEFT = 10;
+const int DISPLAY_LINE_HEIGHT = 20;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SDisplayRect
+{
+	int left;
+	int top;
+	int right;
+	int bottom;
+};
+
+// Remembers what was drawn last and reports the lines a new state changes
+class CDisplayDiff
+{
+public:
+   CDisplayDiff();
+
+   // Mask of EDisplayLine bits that differ from the last drawn state; the new state becomes the
+   // drawn one. Everything is dirty after Invalidate.
+   uint32_t Update(const JSDATA& jsData, int playerIndex, int connectedCount);
+   void Invalidate();
+
+private:
+   JSDATA m_drawn;
+   int m_playerIndex;
+   int m_connectedCount;
+   bool m_valid;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+uint32_t DiffDisplayLines(const JSDATA& drawn, const JSDATA& current);
+int GetDisplayLineTop(int line);
+SDisplayRect GetDisplayLineRect(int line, int clientWidth);
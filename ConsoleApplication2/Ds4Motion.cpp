@@ -0,0 +1,172 @@
+// =================================================================================================
+// DS4 motion: factory IMU calibration from feature report 0x02 (USB) / 0x05 (Bluetooth), the
+// conversion of the six raw gyro/accel channels to deg/s and g, and the unwrapping of the pad's
+// 16-bit sensor clock.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "Ds4Motion.h"
+#include <cstddef>
+#include "Crc32.h"
+#include "CpuFeatures.h"
+#if JOYSTICK_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// The SIMD path loads eight int16 lanes starting at gyro: gyro and accel, then two more fields of
+// the same struct whose lanes have a zero scale
+static_assert(offsetof(SPadState, accel) == offsetof(SPadState, gyro) + 3 * sizeof(int16_t), "accel must follow gyro");
+static_assert(offsetof(SPadState, gyro) + IMU_LANES * sizeof(int16_t) <= sizeof(SPadState), "IMU lanes must stay inside SPadState");
+
+// ...and stores the six results with one 16-byte and one 8-byte write
+static_assert(offsetof(SMotionSample, accelG) == offsetof(SMotionSample, gyroDps) + 3 * sizeof(float), "accelG must follow gyroDps");
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ReadInt16
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int ReadInt16(const unsigned char* bytes)
+{
+    return (int16_t)(uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+// =================================================================================================
+// SetDefaultImuCalibration
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void SetDefaultImuCalibration(SImuCalibration& calibration)
+{
+    for (int i = 0; i < IMU_LANES; i++)
+    {
+        calibration.bias[i] = 0.0f;
+        calibration.scale[i] = 0.0f;
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        calibration.scale[i] = DS4_DEFAULT_GYRO_SCALE;
+        calibration.scale[3 + i] = DS4_DEFAULT_ACCEL_SCALE;
+    }
+    calibration.factory = false;
+}
+
+// =================================================================================================
+// ParseDs4Calibration      the divisions of the calibration happen here, once per pad; the same
+//                          arithmetic as the Linux hid-playstation driver
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool ParseDs4Calibration(const unsigned char* report, size_t length, bool bluetoothOrder, SImuCalibration& calibration)
+{
+    if (report == nullptr || length < DS4_CALIBRATION_USB_SIZE)
+    {
+        return false;
+    }
+    if (report[0] == DS4_CALIBRATION_BT_REPORT_ID)
+    {
+        if (length < DS4_CALIBRATION_BT_SIZE)
+        {
+            return false;
+        }
+        size_t crcOffset = DS4_CALIBRATION_BT_SIZE - 4;
+        uint32_t expected = uint32_t(report[crcOffset]) | (uint32_t(report[crcOffset + 1]) << 8) |
+                            (uint32_t(report[crcOffset + 2]) << 16) | (uint32_t(report[crcOffset + 3]) << 24);
+        if (Crc32Report(CRC32_SEED_BT_FEATURE, report, crcOffset) != expected)
+        {
+            return false;
+        }
+    }
+    else if (report[0] != DS4_CALIBRATION_USB_REPORT_ID)
+    {
+        return false;
+    }
+
+    int gyroBias[3] = { ReadInt16(report + 1), ReadInt16(report + 3), ReadInt16(report + 5) };
+    int gyroPlus[3];
+    int gyroMinus[3];
+    for (int i = 0; i < 3; i++)
+    {
+        // USB interleaves plus/minus per axis, Bluetooth lists the three plus values first
+        gyroPlus[i] = ReadInt16(report + (bluetoothOrder ? 7 + 2 * i : 7 + 4 * i));
+        gyroMinus[i] = ReadInt16(report + (bluetoothOrder ? 13 + 2 * i : 9 + 4 * i));
+    }
+    int gyroSpeed2x = ReadInt16(report + 19) + ReadInt16(report + 21);
+
+    SImuCalibration parsed;
+    SetDefaultImuCalibration(parsed);
+    for (int i = 0; i < 3; i++)
+    {
+        // The pad reports the gyro with its bias already removed; the bias only sets the range
+        int gyroRange = (gyroPlus[i] > gyroBias[i] ? gyroPlus[i] - gyroBias[i] : gyroBias[i] - gyroPlus[i]) +
+                        (gyroMinus[i] > gyroBias[i] ? gyroMinus[i] - gyroBias[i] : gyroBias[i] - gyroMinus[i]);
+        int accelPlus = ReadInt16(report + 23 + 4 * i);
+        int accelMinus = ReadInt16(report + 25 + 4 * i);
+        int accelRange2g = accelPlus - accelMinus;
+        if (gyroRange == 0 || gyroSpeed2x == 0 || accelRange2g <= 0)
+        {
+            return false;
+        }
+
+        parsed.scale[i] = (float)gyroSpeed2x / (float)gyroRange;
+        parsed.bias[3 + i] = (float)(accelPlus - accelRange2g / 2);
+        parsed.scale[3 + i] = 2.0f / (float)accelRange2g;
+    }
+
+    parsed.factory = true;
+    calibration = parsed;
+    return true;
+}
+
+// =================================================================================================
+// ConvertPadMotionScalar
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void ConvertPadMotionScalar(const SImuCalibration& calibration, const SPadState& state, SMotionSample& motion)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        motion.gyroDps[i] = ((float)state.gyro[i] - calibration.bias[i]) * calibration.scale[i];
+        motion.accelG[i] = ((float)state.accel[i] - calibration.bias[3 + i]) * calibration.scale[3 + i];
+    }
+}
+
+// =================================================================================================
+// ConvertPadMotion         all six channels at once: one load, sign extension, two subtracts and
+//                          two multiplies on four lanes each
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void ConvertPadMotion(const SImuCalibration& calibration, const SPadState& state, SMotionSample& motion)
+{
+#if JOYSTICK_HAVE_SSE2
+    __m128i raw = _mm_loadu_si128((const __m128i*)state.gyro);
+
+    // Sign-extend by placing each int16 in the high half of an int32 and shifting it back down
+    __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(raw, raw), 16);
+    __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(raw, raw), 16);
+
+    __m128 lowValues = _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(low), _mm_load_ps(calibration.bias)), _mm_load_ps(calibration.scale));
+    __m128 highValues = _mm_mul_ps(_mm_sub_ps(_mm_cvtepi32_ps(high), _mm_load_ps(calibration.bias + 4)), _mm_load_ps(calibration.scale + 4));
+
+    // Straight into the sample: lanes 0..3 are the gyro and accel x, lanes 4..5 accel y and z.
+    // Going through a local array instead stalls the copy out of it on store forwarding.
+    _mm_storeu_ps(motion.gyroDps, lowValues);
+    _mm_storel_pi((__m64*)(motion.accelG + 1), highValues);
+#else
+    ConvertPadMotionScalar(calibration, state, motion);
+#endif
+}
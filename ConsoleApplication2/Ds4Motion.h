@@ -0,0 +1,122 @@
+// =================================================================================================
+// DS4 motion: factory IMU calibration from feature report 0x02 (USB) / 0x05 (Bluetooth), the
+// conversion of the six raw gyro/accel channels to deg/s and g, and the unwrapping of the pad's
+// 16-bit sensor clock.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include "PadState.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const unsigned char DS4_CALIBRATION_USB_REPORT_ID = 0x02;
+const unsigned char DS4_CALIBRATION_BT_REPORT_ID = 0x05;
+const size_t DS4_CALIBRATION_USB_SIZE = 37;
+const size_t DS4_CALIBRATION_BT_SIZE = 41;          // CRC-32 in the last four bytes
+
+// Resolution the calibration data is expressed in
+const int DS4_GYRO_RES_PER_DEG_S = 1024;
+const int DS4_ACC_RES_PER_G = 8192;
+
+// Used when a pad gives no calibration: the nominal ranges of the sensors
+const float DS4_DEFAULT_GYRO_SCALE = 1.0f / 16.0f;          // deg/s per LSB
+const float DS4_DEFAULT_ACCEL_SCALE = 1.0f / 8192.0f;       // g per LSB
+
+// The sensor clock counts in 16/3 us steps and wraps after about 350 ms
+const uint64_t DS4_SENSOR_TICK_NUMERATOR_NS = 16000;
+const uint64_t DS4_SENSOR_TICK_DENOMINATOR = 3;
+const uint64_t DS4_SENSOR_WRAP_NS = 65536 * DS4_SENSOR_TICK_NUMERATOR_NS / DS4_SENSOR_TICK_DENOMINATOR;
+
+// Channel order: gyro pitch, yaw, roll, then accel x, y, z; two unused lanes keep it SIMD-wide
+const int IMU_CHANNELS = 6;
+const int IMU_LANES = 8;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// physical = (raw - bias) * scale, per channel. The unused lanes are zero.
+struct alignas(16) SImuCalibration
+{
+	float bias[IMU_LANES];
+	float scale[IMU_LANES];
+	bool factory;               // read from the pad, not the nominal defaults
+};
+
+struct SMotionSample
+{
+	uint64_t timestampNs;       // host time the report was decoded
+	uint64_t sensorTimeNs;      // the pad's clock, unwrapped, from its first report
+	float dtSeconds;            // sensor time since the previous report, 0 for the first
+	float gyroDps[3];           // pitch, yaw, roll
+	float accelG[3];
+	int32_t playerIndex;
+};
+
+// Unwraps the pad's 16-bit sensor clock. A gap longer than one wrap is bridged with the host clock.
+class CSensorClock
+{
+public:
+   CSensorClock() : m_ticks(0), m_lastTicks(0), m_lastHostNs(0), m_started(false) {}
+
+   void Reset() { m_started = false; }
+
+   // Ticks since the first report; deltaTicks receives the step from the previous one
+   uint64_t Unwrap(uint16_t ticks, uint64_t hostNs, uint64_t& deltaTicks)
+   {
+      if (!m_started)
+      {
+         m_started = true;
+         m_ticks = 0;
+         deltaTicks = 0;
+      }
+      else
+      {
+         deltaTicks = (uint16_t)(ticks - m_lastTicks);
+         uint64_t hostDeltaNs = hostNs > m_lastHostNs ? hostNs - m_lastHostNs : 0;
+         if (hostDeltaNs > DS4_SENSOR_WRAP_NS)
+         {
+            // Whole wraps the host saw pass that the 16-bit delta cannot show
+            uint64_t deltaNs = deltaTicks * DS4_SENSOR_TICK_NUMERATOR_NS / DS4_SENSOR_TICK_DENOMINATOR;
+            uint64_t missedWraps = hostDeltaNs > deltaNs ? (hostDeltaNs - deltaNs + DS4_SENSOR_WRAP_NS / 2) / DS4_SENSOR_WRAP_NS : 0;
+            deltaTicks += missedWraps * 65536;
+         }
+         m_ticks += deltaTicks;
+      }
+      m_lastTicks = ticks;
+      m_lastHostNs = hostNs;
+      return m_ticks;
+   }
+
+   static uint64_t TicksToNs(uint64_t ticks) { return ticks * DS4_SENSOR_TICK_NUMERATOR_NS / DS4_SENSOR_TICK_DENOMINATOR; }
+
+private:
+   uint64_t m_ticks;
+   uint16_t m_lastTicks;
+   uint64_t m_lastHostNs;
+   bool m_started;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+void SetDefaultImuCalibration(SImuCalibration& calibration);
+
+// Feature report 0x02 or 0x05 as read from the pad, report ID included. bluetoothOrder selects
+// the gyro field order of the Bluetooth report, which the wireless dongle also uses over USB.
+// False, leaving calibration untouched, when the report is short, fails its CRC or is degenerate.
+bool ParseDs4Calibration(const unsigned char* report, size_t length, bool bluetoothOrder, SImuCalibration& calibration);
+
+// Gyro and accel of a decoded state in physical units; SSE2 where available, no divisions
+void ConvertPadMotion(const SImuCalibration& calibration, const SPadState& state, SMotionSample& motion);
+void ConvertPadMotionScalar(const SImuCalibration& calibration, const SPadState& state, SMotionSample& motion);
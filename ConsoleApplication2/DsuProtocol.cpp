@@ -0,0 +1,416 @@
+// =================================================================================================
+// DSU ("cemuhook") UDP protocol as emulators speak it: clients ask for the slots and subscribe,
+// the server answers with one 100-byte pad data packet per report and slot. Little-endian, every
+// packet behind a 16-byte header with a CRC-32 of the whole packet.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "DsuProtocol.h"
+#include <cstring>
+#include "ByteOrder.h"
+#include "Crc32.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Header offsets
+const size_t DSU_OFFSET_LENGTH = 6;
+const size_t DSU_OFFSET_CRC = 8;
+const size_t DSU_OFFSET_ID = 12;
+const size_t DSU_OFFSET_MESSAGE = 16;
+const size_t DSU_OFFSET_PAYLOAD = 20;
+
+const uint8_t DSU_MODEL_FULL_GYRO = 2;
+
+// First button byte
+const uint8_t DSU_BUTTON_SHARE = 0x01;
+const uint8_t DSU_BUTTON_L3 = 0x02;
+const uint8_t DSU_BUTTON_R3 = 0x04;
+const uint8_t DSU_BUTTON_OPTIONS = 0x08;
+const uint8_t DSU_DPAD_UP = 0x10;
+const uint8_t DSU_DPAD_RIGHT = 0x20;
+const uint8_t DSU_DPAD_DOWN = 0x40;
+const uint8_t DSU_DPAD_LEFT = 0x80;
+
+// Second button byte
+const uint8_t DSU_BUTTON_L2 = 0x01;
+const uint8_t DSU_BUTTON_R2 = 0x02;
+const uint8_t DSU_BUTTON_L1 = 0x04;
+const uint8_t DSU_BUTTON_R1 = 0x08;
+const uint8_t DSU_BUTTON_SQUARE = 0x10;
+const uint8_t DSU_BUTTON_CROSS = 0x20;
+const uint8_t DSU_BUTTON_CIRCLE = 0x40;
+const uint8_t DSU_BUTTON_TRIANGLE = 0x80;
+
+// D-pad bits of the hat values 0 = up .. 7 = up-left; neutral and anything above is none
+const uint8_t DSU_HAT_TO_DPAD[8] =
+{
+    DSU_DPAD_UP,
+    DSU_DPAD_UP | DSU_DPAD_RIGHT,
+    DSU_DPAD_RIGHT,
+    DSU_DPAD_DOWN | DSU_DPAD_RIGHT,
+    DSU_DPAD_DOWN,
+    DSU_DPAD_DOWN | DSU_DPAD_LEFT,
+    DSU_DPAD_LEFT,
+    DSU_DPAD_UP | DSU_DPAD_LEFT
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ClampToByte              the pads' axes are 0..255 in the 16-bit fields, DSU has a byte
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint8_t ClampToByte(uint16_t value)
+{
+    return value > 255 ? 255 : (uint8_t)value;
+}
+
+// =================================================================================================
+// WriteDsuHeader           the length counts from the message type on
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void WriteDsuHeader(const char* magic, uint32_t senderId, uint32_t message, size_t packetSize, unsigned char* packet)
+{
+    std::memcpy(packet, magic, 4);
+    StoreLe16(packet + 4, DSU_PROTOCOL_VERSION);
+    StoreLe16(packet + DSU_OFFSET_LENGTH, (uint16_t)(packetSize - DSU_HEADER_SIZE));
+    StoreLe32(packet + DSU_OFFSET_CRC, 0);
+    StoreLe32(packet + DSU_OFFSET_ID, senderId);
+    StoreLe32(packet + DSU_OFFSET_MESSAGE, message);
+}
+
+// =================================================================================================
+// SealDsuPacket            the CRC is taken over the whole packet with its own field zero
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static size_t SealDsuPacket(unsigned char* packet, size_t packetSize)
+{
+    StoreLe32(packet + DSU_OFFSET_CRC, Crc32Final(Crc32Update(CRC32_INITIAL, packet, packetSize)));
+    return packetSize;
+}
+
+// =================================================================================================
+// WriteDsuSlotInfo
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void WriteDsuSlotInfo(const SDsuSlotInfo& info, unsigned char* bytes)
+{
+    bytes[0] = info.slot;
+    bytes[1] = info.state;
+    bytes[2] = info.model;
+    bytes[3] = info.connection;
+    std::memcpy(bytes + 4, info.mac, sizeof(info.mac));
+    bytes[10] = info.battery;
+}
+
+// =================================================================================================
+// DsuBatteryCode           dying, low, medium, high and full; the pads do not say they charge
+//                          in the percent
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint8_t DsuBatteryCode(uint8_t batteryPercent)
+{
+    if (batteryPercent == 0)
+    {
+        return 0x00;
+    }
+    if (batteryPercent < 10)
+    {
+        return 0x01;
+    }
+    if (batteryPercent < 30)
+    {
+        return 0x02;
+    }
+    if (batteryPercent < 60)
+    {
+        return 0x03;
+    }
+    return batteryPercent < 90 ? 0x04 : 0x05;
+}
+
+// =================================================================================================
+// MakeDsuSlotInfo          the MAC only has to tell the slots apart for the clients
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void MakeDsuSlotInfo(int slot, bool connected, uint8_t batteryPercent, SDsuSlotInfo& info)
+{
+    info = SDsuSlotInfo();
+    info.slot = (uint8_t)slot;
+    if (!connected)
+    {
+        return;
+    }
+
+    info.state = DSU_SLOT_CONNECTED;
+    info.model = DSU_MODEL_FULL_GYRO;
+    info.connection = DSU_CONNECTION_USB;
+    const uint8_t mac[6] = { 0x02, 0x4A, 0x53, 0x00, 0x00, (uint8_t)(slot + 1) };
+    std::memcpy(info.mac, mac, sizeof(mac));
+    info.battery = DsuBatteryCode(batteryPercent);
+}
+
+// =================================================================================================
+// BuildDsuVersion
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t BuildDsuVersion(uint32_t serverId, unsigned char* packet)
+{
+    WriteDsuHeader(DSU_MAGIC_SERVER, serverId, DSU_MESSAGE_VERSION, DSU_VERSION_PACKET_SIZE, packet);
+    StoreLe16(packet + DSU_OFFSET_PAYLOAD, DSU_PROTOCOL_VERSION);
+    return SealDsuPacket(packet, DSU_VERSION_PACKET_SIZE);
+}
+
+// =================================================================================================
+// BuildDsuPortInfo
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t BuildDsuPortInfo(uint32_t serverId, const SDsuSlotInfo& info, unsigned char* packet)
+{
+    WriteDsuHeader(DSU_MAGIC_SERVER, serverId, DSU_MESSAGE_PORT_INFO, DSU_PORT_INFO_PACKET_SIZE, packet);
+    WriteDsuSlotInfo(info, packet + DSU_OFFSET_PAYLOAD);
+    packet[DSU_OFFSET_PAYLOAD + 11] = 0;
+    return SealDsuPacket(packet, DSU_PORT_INFO_PACKET_SIZE);
+}
+
+// =================================================================================================
+// BuildDsuPadData          stick Y grows upwards in DSU, the pads grow it downwards; the pads
+//                          have no pressure sensing, so the analog buttons are 0 or 255
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t BuildDsuPadData(uint32_t serverId, const SDsuSlotInfo& info, uint32_t packetNumber,
+                       const SPadState& state, const SMotionSample* pMotion, unsigned char* packet)
+{
+    WriteDsuHeader(DSU_MAGIC_SERVER, serverId, DSU_MESSAGE_PAD_DATA, DSU_PAD_DATA_PACKET_SIZE, packet);
+    unsigned char* bytes = packet + DSU_OFFSET_PAYLOAD;
+    WriteDsuSlotInfo(info, bytes);
+    bytes[11] = info.state == DSU_SLOT_CONNECTED ? 1 : 0;
+    StoreLe32(bytes + 12, packetNumber);
+
+    uint32_t buttons = state.buttons;
+    uint8_t dpad = state.hat < 8 ? DSU_HAT_TO_DPAD[state.hat] : 0;
+    uint8_t buttons1 = dpad;
+    buttons1 |= (buttons >> PAD_BUTTON_SHARE & 1) ? DSU_BUTTON_SHARE : 0;
+    buttons1 |= (buttons >> PAD_BUTTON_L3 & 1) ? DSU_BUTTON_L3 : 0;
+    buttons1 |= (buttons >> PAD_BUTTON_R3 & 1) ? DSU_BUTTON_R3 : 0;
+    buttons1 |= (buttons >> PAD_BUTTON_OPTIONS & 1) ? DSU_BUTTON_OPTIONS : 0;
+
+    uint8_t buttons2 = 0;
+    buttons2 |= (buttons >> PAD_BUTTON_L2 & 1) ? DSU_BUTTON_L2 : 0;
+    buttons2 |= (buttons >> PAD_BUTTON_R2 & 1) ? DSU_BUTTON_R2 : 0;
+    buttons2 |= (buttons >> PAD_BUTTON_L1 & 1) ? DSU_BUTTON_L1 : 0;
+    buttons2 |= (buttons >> PAD_BUTTON_R1 & 1) ? DSU_BUTTON_R1 : 0;
+    buttons2 |= (buttons >> PAD_BUTTON_SQUARE & 1) ? DSU_BUTTON_SQUARE : 0;
+    buttons2 |= (buttons >> PAD_BUTTON_CROSS & 1) ? DSU_BUTTON_CROSS : 0;
+    buttons2 |= (buttons >> PAD_BUTTON_CIRCLE & 1) ? DSU_BUTTON_CIRCLE : 0;
+    buttons2 |= (buttons >> PAD_BUTTON_TRIANGLE & 1) ? DSU_BUTTON_TRIANGLE : 0;
+
+    bytes[16] = buttons1;
+    bytes[17] = buttons2;
+    bytes[18] = (uint8_t)(buttons >> PAD_BUTTON_PS & 1);
+    bytes[19] = (uint8_t)(buttons >> PAD_BUTTON_TOUCHPAD & 1);
+    bytes[20] = ClampToByte(state.leftX);
+    bytes[21] = (uint8_t)(255 - ClampToByte(state.leftY));
+    bytes[22] = ClampToByte(state.rightX);
+    bytes[23] = (uint8_t)(255 - ClampToByte(state.rightY));
+
+    // Analog d-pad left, down, right, up, then triangle, circle, cross, square, R1, L1, R2, L2
+    bytes[24] = (dpad & DSU_DPAD_LEFT) ? 255 : 0;
+    bytes[25] = (dpad & DSU_DPAD_DOWN) ? 255 : 0;
+    bytes[26] = (dpad & DSU_DPAD_RIGHT) ? 255 : 0;
+    bytes[27] = (dpad & DSU_DPAD_UP) ? 255 : 0;
+    bytes[28] = (buttons2 & DSU_BUTTON_TRIANGLE) ? 255 : 0;
+    bytes[29] = (buttons2 & DSU_BUTTON_CIRCLE) ? 255 : 0;
+    bytes[30] = (buttons2 & DSU_BUTTON_CROSS) ? 255 : 0;
+    bytes[31] = (buttons2 & DSU_BUTTON_SQUARE) ? 255 : 0;
+    bytes[32] = (buttons2 & DSU_BUTTON_R1) ? 255 : 0;
+    bytes[33] = (buttons2 & DSU_BUTTON_L1) ? 255 : 0;
+    bytes[34] = ClampToByte(state.R2);
+    bytes[35] = ClampToByte(state.L2);
+
+    for (int i = 0; i < PAD_TOUCH_POINTS; i++)
+    {
+        unsigned char* touch = bytes + 36 + 6 * i;
+        bool active = (state.flags & PAD_FLAG_TOUCH) != 0 && state.touch[i].active != 0;
+        touch[0] = active ? 1 : 0;
+        touch[1] = state.touch[i].id;
+        StoreLe16(touch + 2, active ? state.touch[i].x : 0);
+        StoreLe16(touch + 4, active ? state.touch[i].y : 0);
+    }
+
+    SMotionSample motion = pMotion != nullptr ? *pMotion : SMotionSample();
+    StoreLe64(bytes + 48, pMotion != nullptr ? motion.sensorTimeNs / 1000 : state.timestampNs / 1000);
+    for (int i = 0; i < 3; i++)
+    {
+        StoreLeFloat(bytes + 56 + 4 * i, motion.accelG[i]);
+        StoreLeFloat(bytes + 68 + 4 * i, motion.gyroDps[i]);
+    }
+    return SealDsuPacket(packet, DSU_PAD_DATA_PACKET_SIZE);
+}
+
+// =================================================================================================
+// BuildDsuPortInfoRequest
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t BuildDsuPortInfoRequest(uint32_t clientId, const uint8_t* slots, uint32_t slotCount, unsigned char* packet)
+{
+    if (slotCount > DSU_SLOTS)
+    {
+        slotCount = DSU_SLOTS;
+    }
+
+    size_t packetSize = DSU_OFFSET_PAYLOAD + 4 + slotCount;
+    WriteDsuHeader(DSU_MAGIC_CLIENT, clientId, DSU_MESSAGE_PORT_INFO, packetSize, packet);
+    StoreLe32(packet + DSU_OFFSET_PAYLOAD, slotCount);
+    std::memcpy(packet + DSU_OFFSET_PAYLOAD + 4, slots, slotCount);
+    return SealDsuPacket(packet, packetSize);
+}
+
+// =================================================================================================
+// BuildDsuPadDataRequest
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t BuildDsuPadDataRequest(uint32_t clientId, uint8_t registration, uint8_t slot, unsigned char* packet)
+{
+    size_t packetSize = DSU_OFFSET_PAYLOAD + 8;
+    WriteDsuHeader(DSU_MAGIC_CLIENT, clientId, DSU_MESSAGE_PAD_DATA, packetSize, packet);
+    packet[DSU_OFFSET_PAYLOAD] = registration;
+    packet[DSU_OFFSET_PAYLOAD + 1] = slot;
+    std::memset(packet + DSU_OFFSET_PAYLOAD + 2, 0, 6);
+    return SealDsuPacket(packet, packetSize);
+}
+
+// =================================================================================================
+// CheckDsuPacket           a datagram longer than the header says is cut to it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CheckDsuPacket(const unsigned char* packet, size_t length, const char* magic, uint32_t& senderId, uint32_t& message)
+{
+    if (length < DSU_OFFSET_PAYLOAD || std::memcmp(packet, magic, 4) != 0 || LoadLe16(packet + 4) != DSU_PROTOCOL_VERSION)
+    {
+        return false;
+    }
+
+    size_t packetSize = DSU_HEADER_SIZE + LoadLe16(packet + DSU_OFFSET_LENGTH);
+    if (packetSize < DSU_OFFSET_PAYLOAD || packetSize > length)
+    {
+        return false;
+    }
+
+    const unsigned char zero[4] = { 0, 0, 0, 0 };
+    uint32_t crc = Crc32Update(CRC32_INITIAL, packet, DSU_OFFSET_CRC);
+    crc = Crc32Update(crc, zero, sizeof(zero));
+    crc = Crc32Update(crc, packet + DSU_OFFSET_ID, packetSize - DSU_OFFSET_ID);
+    if (Crc32Final(crc) != LoadLe32(packet + DSU_OFFSET_CRC))
+    {
+        return false;
+    }
+
+    senderId = LoadLe32(packet + DSU_OFFSET_ID);
+    message = LoadLe32(packet + DSU_OFFSET_MESSAGE);
+    return true;
+}
+
+// =================================================================================================
+// ParseDsuRequest          a request too short for its message is dropped
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool ParseDsuRequest(const unsigned char* packet, size_t length, SDsuRequest& request)
+{
+    request = SDsuRequest();
+    if (!CheckDsuPacket(packet, length, DSU_MAGIC_CLIENT, request.clientId, request.message))
+    {
+        return false;
+    }
+
+    size_t payloadSize = LoadLe16(packet + DSU_OFFSET_LENGTH) + DSU_HEADER_SIZE - DSU_OFFSET_PAYLOAD;
+    const unsigned char* payload = packet + DSU_OFFSET_PAYLOAD;
+    switch (request.message)
+    {
+        case DSU_MESSAGE_VERSION:
+            return true;
+
+        case DSU_MESSAGE_PORT_INFO:
+        {
+            if (payloadSize < 4)
+            {
+                return false;
+            }
+            uint32_t slotCount = LoadLe32(payload);
+            if (slotCount > DSU_SLOTS || payloadSize < 4 + slotCount)
+            {
+                return false;
+            }
+            request.slotCount = slotCount;
+            std::memcpy(request.slots, payload + 4, slotCount);
+            return true;
+        }
+
+        case DSU_MESSAGE_PAD_DATA:
+            if (payloadSize < 8)
+            {
+                return false;
+            }
+            request.registration = payload[0];
+            request.slot = payload[1];
+            std::memcpy(request.mac, payload + 2, sizeof(request.mac));
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+// =================================================================================================
+// ParseDsuPadData
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool ParseDsuPadData(const unsigned char* packet, size_t length, SDsuPadData& padData)
+{
+    uint32_t serverId = 0;
+    uint32_t message = 0;
+    if (!CheckDsuPacket(packet, length, DSU_MAGIC_SERVER, serverId, message) || message != DSU_MESSAGE_PAD_DATA ||
+        LoadLe16(packet + DSU_OFFSET_LENGTH) + DSU_HEADER_SIZE < DSU_PAD_DATA_PACKET_SIZE)
+    {
+        return false;
+    }
+
+    const unsigned char* bytes = packet + DSU_OFFSET_PAYLOAD;
+    padData.slot = bytes[0];
+    padData.connected = bytes[11];
+    padData.packetNumber = LoadLe32(bytes + 12);
+    padData.buttons[0] = bytes[16];
+    padData.buttons[1] = bytes[17];
+    padData.ps = bytes[18];
+    padData.touchButton = bytes[19];
+    std::memcpy(padData.sticks, bytes + 20, sizeof(padData.sticks));
+    padData.motionTimestampUs = LoadLe64(bytes + 48);
+    for (int i = 0; i < 3; i++)
+    {
+        padData.accelG[i] = LoadLeFloat(bytes + 56 + 4 * i);
+        padData.gyroDps[i] = LoadLeFloat(bytes + 68 + 4 * i);
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+// =================================================================================================
+// DSU ("cemuhook") UDP protocol as emulators speak it: clients ask for the slots and subscribe,
+// the server answers with one 100-byte pad data packet per report and slot. Little-endian, every
+// packet behind a 16-byte header with a CRC-32 of the whole packet.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include "PadState.h"
+#include "Ds4Motion.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const char DSU_MAGIC_SERVER[4] = { 'D', 'S', 'U', 'S' };
+const char DSU_MAGIC_CLIENT[4] = { 'D', 'S', 'U', 'C' };
+const uint16_t DSU_PROTOCOL_VERSION = 1001;
+const uint16_t DSU_DEFAULT_PORT = 26760;
+
+const int DSU_SLOTS = 4;                        // the protocol has no room for more players
+
+const size_t DSU_HEADER_SIZE = 16;              // magic, version, length, CRC, sender id
+const size_t DSU_VERSION_PACKET_SIZE = 22;
+const size_t DSU_PORT_INFO_PACKET_SIZE = 32;
+const size_t DSU_PAD_DATA_PACKET_SIZE = 100;
+const size_t DSU_MAX_REQUEST_SIZE = 64;
+
+// A subscription lapses unless the client renews it; emulators ask again about once a second
+const uint64_t DSU_SUBSCRIPTION_TIMEOUT_NS = 5000000000ULL;
+
+enum EDsuMessage
+{
+	DSU_MESSAGE_VERSION = 0x100000,
+	DSU_MESSAGE_PORT_INFO = 0x100001,
+	DSU_MESSAGE_PAD_DATA = 0x100002
+};
+
+enum EDsuSlotState
+{
+	DSU_SLOT_DISCONNECTED = 0,
+	DSU_SLOT_RESERVED = 1,
+	DSU_SLOT_CONNECTED = 2
+};
+
+enum EDsuConnection
+{
+	DSU_CONNECTION_NONE = 0,
+	DSU_CONNECTION_USB = 1,
+	DSU_CONNECTION_BLUETOOTH = 2
+};
+
+// SDsuRequest::registration of a pad data request; none of the bits asks for every slot
+const uint8_t DSU_REGISTER_SLOT = 0x01;
+const uint8_t DSU_REGISTER_MAC = 0x02;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// The slot block every server message about a slot starts with
+struct SDsuSlotInfo
+{
+	uint8_t slot;
+	uint8_t state;              // EDsuSlotState
+	uint8_t model;              // 2 = full gyro, the only model the pads here are
+	uint8_t connection;         // EDsuConnection
+	uint8_t mac[6];             // made up from the player index, the pads do not report theirs
+	uint8_t battery;            // DSU battery code, see DsuBatteryCode
+};
+
+// A client message, as far as the server needs it
+struct SDsuRequest
+{
+	uint32_t clientId;
+	uint32_t message;           // EDsuMessage
+	uint32_t slotCount;         // DSU_MESSAGE_PORT_INFO: the slots asked about
+	uint8_t slots[DSU_SLOTS];
+	uint8_t registration;       // DSU_MESSAGE_PAD_DATA: DSU_REGISTER_* bits
+	uint8_t slot;
+	uint8_t mac[6];
+};
+
+// A pad data packet as a client reads it; sticks with Y growing upwards
+struct SDsuPadData
+{
+	uint8_t slot;
+	uint8_t connected;
+	uint32_t packetNumber;
+	uint8_t buttons[2];
+	uint8_t ps;
+	uint8_t touchButton;
+	uint8_t sticks[4];          // left X, left Y, right X, right Y
+	uint64_t motionTimestampUs;
+	float accelG[3];
+	float gyroDps[3];
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// Percent, 0 when unknown, to the DSU battery code
+uint8_t DsuBatteryCode(uint8_t batteryPercent);
+
+// The core does not know the bus a pad is on; every connected slot says USB
+void MakeDsuSlotInfo(int slot, bool connected, uint8_t batteryPercent, SDsuSlotInfo& info);
+
+// Server messages; packet has room for the *_PACKET_SIZE, the size written is returned
+size_t BuildDsuVersion(uint32_t serverId, unsigned char* packet);
+size_t BuildDsuPortInfo(uint32_t serverId, const SDsuSlotInfo& info, unsigned char* packet);
+// Motion is in the pad's sensor frame, gyro pitch/yaw/roll in deg/s and accel in g; without a
+// sample the motion fields are zero
+size_t BuildDsuPadData(uint32_t serverId, const SDsuSlotInfo& info, uint32_t packetNumber,
+                       const SPadState& state, const SMotionSample* pMotion, unsigned char* packet);
+
+// Client messages, for loopback clients and tests
+size_t BuildDsuPortInfoRequest(uint32_t clientId, const uint8_t* slots, uint32_t slotCount, unsigned char* packet);
+size_t BuildDsuPadDataRequest(uint32_t clientId, uint8_t registration, uint8_t slot, unsigned char* packet);
+
+// Checks magic, version, length and CRC; message and sender id of a valid packet
+bool CheckDsuPacket(const unsigned char* packet, size_t length, const char* magic, uint32_t& senderId, uint32_t& message);
+bool ParseDsuRequest(const unsigned char* packet, size_t length, SDsuRequest& request);
+bool ParseDsuPadData(const unsigned char* packet, size_t length, SDsuPadData& padData);
@@ -0,0 +1,275 @@
+// =================================================================================================
+// The generic decode path of a USB DualShock 4 without a platform HID parser, for the bench and the
+// tests. The input caps are what Windows makes of the DS4 report descriptor, and the generic decoder
+// looks every field up by usage on every report, as HidP_GetUsageValue and HidP_GetUsages do. The
+// DS4 and DualSense report descriptors themselves are included so the compiled report program can
+// be set against the caps and the layout decoders.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "HidCapsModel.h"
+#include "HidReportProgram.h"
+#include "PadState.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// Input caps of a USB DualShock 4 as its report descriptor declares them
+struct SCapsValueCap
+{
+   unsigned short usagePage;
+   unsigned short usage;
+   unsigned short bitOffset;
+   unsigned short bitSize;
+};
+
+struct SCapsButtonCap
+{
+   unsigned short usagePage;
+   unsigned short usageMin;
+   unsigned short usageMax;
+   unsigned short bitOffset;
+};
+
+static const SCapsValueCap DS4_VALUE_CAPS[] =
+{
+   { JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_X, 8, 8 },
+   { JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_Y, 16, 8 },
+   { JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_Z, 24, 8 },
+   { JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_RZ, 32, 8 },
+   { JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_HATSWITCH, 40, 4 },
+   { JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_RX, 64, 8 },
+   { JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_RY, 72, 8 },
+};
+
+static const SCapsButtonCap DS4_BUTTON_CAP = { JS_USAGE_PAGE_BUTTON, 1, 14, 44 };
+
+// The caps above are what Windows makes of the same bytes
+const unsigned char DS4_USB_REPORT_DESCRIPTOR[DS4_USB_REPORT_DESCRIPTOR_SIZE] =
+{
+    0x05, 0x01, 0x09, 0x05, 0xA1, 0x01, 0x85, 0x01, 0x09, 0x30, 0x09, 0x31, 0x09, 0x32, 0x09, 0x35,
+    0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x04, 0x81, 0x02, 0x09, 0x39, 0x15, 0x00, 0x25,
+    0x07, 0x35, 0x00, 0x46, 0x3B, 0x01, 0x65, 0x14, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42, 0x65, 0x00,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x0E, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x0E, 0x81, 0x02,
+    0x06, 0x00, 0xFF, 0x09, 0x20, 0x75, 0x06, 0x95, 0x01, 0x15, 0x00, 0x25, 0x7F, 0x81, 0x02, 0x05,
+    0x01, 0x09, 0x33, 0x09, 0x34, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x02, 0x81, 0x02,
+    0x06, 0x00, 0xFF, 0x09, 0x21, 0x95, 0x36, 0x81, 0x02, 0x85, 0x05, 0x09, 0x22, 0x95, 0x1F, 0x91,
+    0x02, 0xC0
+};
+
+const unsigned char DUALSENSE_USB_REPORT_DESCRIPTOR[DUALSENSE_USB_REPORT_DESCRIPTOR_SIZE] =
+{
+    0x05, 0x01, 0x09, 0x05, 0xA1, 0x01, 0x85, 0x01, 0x09, 0x30, 0x09, 0x31, 0x09, 0x32, 0x09, 0x35,
+    0x09, 0x33, 0x09, 0x34, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x06, 0x81, 0x02, 0x06,
+    0x00, 0xFF, 0x09, 0x20, 0x95, 0x01, 0x81, 0x02, 0x05, 0x01, 0x09, 0x39, 0x15, 0x00, 0x25, 0x07,
+    0x35, 0x00, 0x46, 0x3B, 0x01, 0x65, 0x14, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42, 0x65, 0x00, 0x05,
+    0x09, 0x19, 0x01, 0x29, 0x0F, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x0F, 0x81, 0x02, 0x06,
+    0x00, 0xFF, 0x09, 0x21, 0x95, 0x0D, 0x81, 0x02, 0x06, 0x00, 0xFF, 0x09, 0x22, 0x15, 0x00, 0x26,
+    0xFF, 0x00, 0x75, 0x08, 0x95, 0x34, 0x81, 0x02, 0x85, 0x02, 0x09, 0x23, 0x95, 0x2F, 0x91, 0x02,
+    0xC0
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ReadReportBits
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static unsigned long ReadReportBits(const unsigned char* report, unsigned bitOffset, unsigned bitSize)
+{
+    unsigned long value = 0;
+    for (unsigned bit = 0; bit < bitSize; bit++)
+    {
+        unsigned position = bitOffset + bit;
+        value |= (unsigned long)((report[position / 8] >> (position % 8)) & 1) << bit;
+    }
+    return value;
+}
+
+// =================================================================================================
+// GetCapsUsageValue        HidP_GetUsageValue over the DS4 caps
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool GetCapsUsageValue(unsigned short usagePage, unsigned short usage, unsigned long& value, const unsigned char* report, size_t length)
+{
+    for (const SCapsValueCap& cap : DS4_VALUE_CAPS)
+    {
+        if (cap.usagePage == usagePage && cap.usage == usage)
+        {
+            if ((size_t)(cap.bitOffset + cap.bitSize + 7) / 8 > length)
+            {
+                return false;
+            }
+            value = ReadReportBits(report, cap.bitOffset, cap.bitSize);
+            return true;
+        }
+    }
+    return false;
+}
+
+// =================================================================================================
+// GetCapsUsages            HidP_GetUsages over the DS4 caps: the pressed button usages
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool GetCapsUsages(unsigned short usagePage, unsigned short* usages, size_t& usageLength, const unsigned char* report, size_t length)
+{
+    const SCapsButtonCap& cap = DS4_BUTTON_CAP;
+    unsigned buttonCount = cap.usageMax - cap.usageMin + 1;
+    if (cap.usagePage != usagePage || (size_t)(cap.bitOffset + buttonCount + 7) / 8 > length || usageLength < buttonCount)
+    {
+        return false;
+    }
+
+    size_t found = 0;
+    for (unsigned i = 0; i < buttonCount; i++)
+    {
+        if (ReadReportBits(report, cap.bitOffset + i, 1))
+        {
+            usages[found++] = (unsigned short)(cap.usageMin + i);
+        }
+    }
+    usageLength = found;
+    return true;
+}
+
+// =================================================================================================
+// DecodeCapsReport         the generic decoder loop of the Windows source, on the DS4 caps
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool DecodeCapsReport(SHidDeviceDescriptor& descriptor, const unsigned char* report, size_t length, JSDATA& jsData)
+{
+    for (const SValueField& valueField : descriptor.valueFields)
+    {
+        unsigned long value;
+        if (GetCapsUsageValue(valueField.usagePage, valueField.usage, value, report, length))
+        {
+            StoreFieldValue(jsData, valueField.field, value);
+        }
+    }
+
+    for (int j = 0; j < BUTTONS_NUM; j++)
+    {
+        jsData.HandlePressed[j] = false;
+    }
+
+    unsigned short* usages = descriptor.usageBuffer.data();
+    for (const SButtonRange& buttonRange : descriptor.buttonRanges)
+    {
+        size_t usageLength = descriptor.usageBuffer.size();
+        if (GetCapsUsages(buttonRange.usagePage, usages, usageLength, report, length))
+        {
+            for (size_t j = 0; j < usageLength; j++)
+            {
+                if (usages[j] >= 1 && usages[j] <= BUTTONS_NUM)
+                {
+                    jsData.HandlePressed[usages[j] - 1] = true;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// =================================================================================================
+// BuildCapsDescriptor      what BuildDeviceDescriptor makes of the DS4 caps
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+SHidDeviceDescriptor BuildCapsDescriptor()
+{
+    SHidDeviceDescriptor descriptor;
+    descriptor.vendorId = CAPS_MODEL_VENDOR_ID;
+    descriptor.productId = DS4_PRODUCT_ID_V2;
+
+    for (const SCapsValueCap& cap : DS4_VALUE_CAPS)
+    {
+        SValueField valueField = { cap.usagePage, cap.usage, MapUsageToField(cap.usagePage, cap.usage) };
+        descriptor.valueFields.push_back(valueField);
+    }
+
+    SButtonRange buttonRange = { DS4_BUTTON_CAP.usagePage, DS4_BUTTON_CAP.usageMin, DS4_BUTTON_CAP.usageMax };
+    descriptor.buttonRanges.push_back(buttonRange);
+    descriptor.usageBuffer.resize(DS4_BUTTON_CAP.usageMax - DS4_BUTTON_CAP.usageMin + 1);
+
+    descriptor.genericDecoder = DecodeCapsReport;
+    return descriptor;
+}
+
+// =================================================================================================
+// BuildProgramDescriptor   what the hidraw source makes of the DS4 report descriptor
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+SHidDeviceDescriptor BuildProgramDescriptor()
+{
+    SHidDeviceDescriptor descriptor;
+    descriptor.vendorId = CAPS_MODEL_VENDOR_ID;
+    descriptor.productId = DS4_PRODUCT_ID_V2;
+    descriptor.reportDescriptor.assign(DS4_USB_REPORT_DESCRIPTOR, DS4_USB_REPORT_DESCRIPTOR + DS4_USB_REPORT_DESCRIPTOR_SIZE);
+    CompileHidReportDescriptor(descriptor.reportDescriptor.data(), descriptor.reportDescriptor.size(), descriptor.reportProgram);
+    descriptor.genericDecoder = DecodeReportProgram;
+    return descriptor;
+}
+
+// =================================================================================================
+// SamePadInput             the two paths agree where it reaches the pad state; JSDATA itself may
+//                          differ, HidP hands out a released hat as its raw null value
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool SamePadInput(const JSDATA& a, const JSDATA& b)
+{
+    SPadState stateA = SPadState();
+    SPadState stateB = SPadState();
+    PadStateFromJsData(a, stateA);
+    PadStateFromJsData(b, stateB);
+    return stateA.buttons == stateB.buttons && stateA.hat == stateB.hat &&
+           stateA.leftX == stateB.leftX && stateA.leftY == stateB.leftY &&
+           stateA.rightX == stateB.rightX && stateA.rightY == stateB.rightY &&
+           stateA.L2 == stateB.L2 && stateA.R2 == stateB.R2;
+}
+
+// =================================================================================================
+// CheckHidProgram          what a compiled program promises the interpreter: every op inside the
+//                          length its report is checked against, and in range of its field
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CheckHidProgram(const SHidReportProgram& program)
+{
+    size_t linked = 0;
+    for (const SHidProgramReport& programReport : program.reports)
+    {
+        if (programReport.minLength > HID_REPORT_MAX_SIZE || (size_t)programReport.firstOp + programReport.opCount > program.ops.size())
+        {
+            return false;
+        }
+        for (size_t i = programReport.firstOp; i < (size_t)programReport.firstOp + programReport.opCount; i++)
+        {
+            const SHidExtractOp& op = program.ops[i];
+            if (op.reportId != programReport.reportId || op.bitSize == 0 || op.bitSize > HID_FIELD_MAX_BITS ||
+                op.bitOffset + op.bitSize > (uint32_t)programReport.minLength * 8 || op.field == JSFIELD_NONE ||
+                op.field > JSFIELD_BUTTONS || op.logicalMax < op.logicalMin ||
+                (op.field == JSFIELD_BUTTONS && !(op.flags & HID_OP_ARRAY) &&
+                 op.button + ((op.flags & HID_OP_BUTTON_RUN) ? op.bitSize : 1) > BUTTONS_NUM))
+            {
+                return false;
+            }
+        }
+        linked += programReport.opCount;
+    }
+    return linked == program.ops.size() && program.ops.size() <= HID_PROGRAM_MAX_OPS;
+}
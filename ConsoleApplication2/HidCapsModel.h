@@ -0,0 +1,56 @@
+// =================================================================================================
+// The generic decode path of a USB DualShock 4 without a platform HID parser, for the bench and the
+// tests. The input caps are what Windows makes of the DS4 report descriptor, and the generic decoder
+// looks every field up by usage on every report, as HidP_GetUsageValue and HidP_GetUsages do. The
+// DS4 and DualSense report descriptors themselves are included so the compiled report program can
+// be set against the caps and the layout decoders.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include "HidDescriptor.h"
+#include "JSData.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Any VID the layout decoders do not claim, so the core takes the generic path
+const unsigned long CAPS_MODEL_VENDOR_ID = 0xFFFF;
+
+// The input and output reports of the USB DualShock 4 report descriptor, its feature reports
+// left out
+const size_t DS4_USB_REPORT_DESCRIPTOR_SIZE = 114;
+extern const unsigned char DS4_USB_REPORT_DESCRIPTOR[DS4_USB_REPORT_DESCRIPTOR_SIZE];
+
+// The same of the USB DualSense: 64-byte input report 0x01 with a 15-button run, mute included,
+// and output report 0x02
+const size_t DUALSENSE_USB_REPORT_DESCRIPTOR_SIZE = 113;
+extern const unsigned char DUALSENSE_USB_REPORT_DESCRIPTOR[DUALSENSE_USB_REPORT_DESCRIPTOR_SIZE];
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// The generic decoder loop of the Windows source, on the DS4 caps
+bool DecodeCapsReport(SHidDeviceDescriptor& descriptor, const unsigned char* report, size_t length, JSDATA& jsData);
+
+// What BuildDeviceDescriptor makes of the DS4 caps
+SHidDeviceDescriptor BuildCapsDescriptor();
+
+// What the hidraw source makes of the DS4 report descriptor
+SHidDeviceDescriptor BuildProgramDescriptor();
+
+// The two paths agree where it reaches the pad state; JSDATA itself may differ, HidP hands out a
+// released hat as its raw null value
+bool SamePadInput(const JSDATA& a, const JSDATA& b);
+
+// What a compiled program promises the interpreter: every op inside the length its report is
+// checked against, and in range of its field
+bool CheckHidProgram(const SHidReportProgram& program);
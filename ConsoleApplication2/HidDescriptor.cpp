@@ -0,0 +1,99 @@
+// =================================================================================================
+// HID descriptor data of one device and the mapping of its usages to JSDATA fields.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "HidDescriptor.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// MapUsageToField          resolve a value usage to the JSDATA member it feeds
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+EJsField MapUsageToField(unsigned short usagePage, unsigned short usage)
+{
+    if (usagePage != JS_USAGE_PAGE_GENERIC)
+    {
+        return JSFIELD_NONE;
+    }
+
+    switch (usage)
+    {
+        case JS_USAGE_GENERIC_X:            return JSFIELD_LEFT_X;
+        case JS_USAGE_GENERIC_Y:            return JSFIELD_LEFT_Y;
+        case JS_USAGE_GENERIC_Z:            return JSFIELD_RIGHT_X;
+        case JS_USAGE_GENERIC_RX:           return JSFIELD_L2;
+        case JS_USAGE_GENERIC_RY:           return JSFIELD_R2;
+        case JS_USAGE_GENERIC_RZ:           return JSFIELD_RIGHT_Y;
+        case JS_USAGE_GENERIC_HATSWITCH:    return JSFIELD_ARROW;
+    }
+
+    return JSFIELD_NONE;
+}
+
+// =================================================================================================
+// StoreFieldValue
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void StoreFieldValue(JSDATA& jsData, EJsField field, unsigned long value)
+{
+    switch (field)
+    {
+        case JSFIELD_LEFT_X:    jsData.leftX = (int32_t)value;  break;
+        case JSFIELD_LEFT_Y:    jsData.leftY = (int32_t)value;  break;
+        case JSFIELD_RIGHT_X:   jsData.rightX = (int32_t)value; break;
+        case JSFIELD_RIGHT_Y:   jsData.rightY = (int32_t)value; break;
+        case JSFIELD_L2:        jsData.L2 = (int32_t)value;     break;
+        case JSFIELD_R2:        jsData.R2 = (int32_t)value;     break;
+        case JSFIELD_ARROW:     jsData.arrowValue = (int)value; break;
+        case JSFIELD_NONE:
+        case JSFIELD_BUTTONS:   break;
+    }
+}
+
+// =================================================================================================
+// HashDeviceDescriptor
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint32_t HashDeviceDescriptor(const SHidDeviceDescriptor& descriptor)
+{
+    uint32_t hash = 2166136261u;
+    unsigned char ids[4] = {
+        (unsigned char)descriptor.vendorId, (unsigned char)(descriptor.vendorId >> 8),
+        (unsigned char)descriptor.productId, (unsigned char)(descriptor.productId >> 8) };
+
+    for (unsigned char c : ids)
+    {
+        hash = (hash ^ c) * 16777619u;
+    }
+    for (unsigned char c : descriptor.preparsedData)
+    {
+        hash = (hash ^ c) * 16777619u;
+    }
+    for (unsigned char c : descriptor.reportDescriptor)
+    {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+// =================================================================================================
+// DecodeReportProgram
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool DecodeReportProgram(SHidDeviceDescriptor& descriptor, const unsigned char* report, size_t length, JSDATA& jsData)
+{
+    return RunHidReportProgram(descriptor.reportProgram, report, length, jsData);
+}
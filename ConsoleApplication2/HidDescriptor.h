@@ -0,0 +1,85 @@
+// =================================================================================================
+// HID descriptor data of one device and the mapping of its usages to JSDATA fields.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "HidReportProgram.h"
+#include "JSData.h"
+#include "PadOutput.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const unsigned short JS_USAGE_PAGE_GENERIC = 0x01;
+const unsigned short JS_USAGE_PAGE_BUTTON = 0x09;
+
+const unsigned short JS_USAGE_GENERIC_X = 0x30;
+const unsigned short JS_USAGE_GENERIC_Y = 0x31;
+const unsigned short JS_USAGE_GENERIC_Z = 0x32;
+const unsigned short JS_USAGE_GENERIC_RX = 0x33;
+const unsigned short JS_USAGE_GENERIC_RY = 0x34;
+const unsigned short JS_USAGE_GENERIC_RZ = 0x35;
+const unsigned short JS_USAGE_GENERIC_HATSWITCH = 0x39;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SValueField
+{
+	unsigned short usagePage;
+	unsigned short usage;
+	EJsField field;
+};
+
+struct SButtonRange
+{
+	unsigned short usagePage;
+	unsigned short usageMin;
+	unsigned short usageMax;
+};
+
+struct SHidDeviceDescriptor;
+
+// Platform parser for reports no layout decoder recognises (HidP_* on Windows, the compiled
+// report descriptor on Linux)
+typedef bool (*PFN_GENERIC_DECODER)(SHidDeviceDescriptor& descriptor, const unsigned char* report, size_t length, JSDATA& jsData);
+
+// Everything the input source and the core need about one device, built once when it arrives
+struct SHidDeviceDescriptor
+{
+	unsigned long vendorId = 0;
+	unsigned long productId = 0;
+	EReportDecoder decoder = DECODER_GENERIC;
+	PFN_GENERIC_DECODER genericDecoder = nullptr;
+	std::vector<unsigned char> preparsedData;
+	std::vector<SValueField> valueFields;
+	std::vector<SButtonRange> buttonRanges;
+	std::vector<unsigned short> usageBuffer;
+	std::vector<unsigned char> reportDescriptor;      // raw HID report descriptor, where the platform has it
+	SHidReportProgram reportProgram;                  // compiled from reportDescriptor
+	std::vector<unsigned char> calibrationReport;     // DS4 IMU feature report, report ID first; empty when not read
+	bool bluetooth = false;                           // connected over Bluetooth rather than USB
+	std::shared_ptr<IPadOutputDevice> output;         // opened for output reports; null when the device takes none
+};
+
+EJsField MapUsageToField(unsigned short usagePage, unsigned short usage);
+void StoreFieldValue(JSDATA& jsData, EJsField field, unsigned long value);
+
+// FNV-1a over the VID/PID and the platform parser data, equal for identical devices
+uint32_t HashDeviceDescriptor(const SHidDeviceDescriptor& descriptor);
+
+// PFN_GENERIC_DECODER running descriptor.reportProgram
+bool DecodeReportProgram(SHidDeviceDescriptor& descriptor, const unsigned char* report, size_t length, JSDATA& jsData);
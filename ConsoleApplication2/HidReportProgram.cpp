@@ -0,0 +1,621 @@
+// =================================================================================================
+// Portable HID report descriptor compiler. A raw report descriptor is parsed once per device into
+// a flat list of extraction ops, one per report field a pad uses (bit offset, bit size, logical
+// range, JSDATA field), and every input report is then decoded by running the ops in a tight loop.
+// Stands in for the HidP_* parser where there is none (Linux hidraw) and for pads no layout
+// decoder knows.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "HidReportProgram.h"
+#include <algorithm>
+#include "HidDescriptor.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Short item prefix: tag in the high nibble, type in bits 2-3, data size code in bits 0-1
+const unsigned char HID_ITEM_LONG = 0xFE;
+
+enum EHidItemType
+{
+    HID_ITEM_MAIN = 0,
+    HID_ITEM_GLOBAL = 1,
+    HID_ITEM_LOCAL = 2
+};
+
+enum EHidMainTag
+{
+    HID_MAIN_INPUT = 0x8,
+    HID_MAIN_OUTPUT = 0x9,
+    HID_MAIN_COLLECTION = 0xA,
+    HID_MAIN_FEATURE = 0xB,
+    HID_MAIN_END_COLLECTION = 0xC
+};
+
+enum EHidGlobalTag
+{
+    HID_GLOBAL_USAGE_PAGE = 0x0,
+    HID_GLOBAL_LOGICAL_MIN = 0x1,
+    HID_GLOBAL_LOGICAL_MAX = 0x2,
+    HID_GLOBAL_REPORT_SIZE = 0x7,
+    HID_GLOBAL_REPORT_ID = 0x8,
+    HID_GLOBAL_REPORT_COUNT = 0x9,
+    HID_GLOBAL_PUSH = 0xA,
+    HID_GLOBAL_POP = 0xB
+};
+
+enum EHidLocalTag
+{
+    HID_LOCAL_USAGE = 0x0,
+    HID_LOCAL_USAGE_MIN = 0x1,
+    HID_LOCAL_USAGE_MAX = 0x2
+};
+
+// Input item data bits
+const uint32_t HID_INPUT_CONSTANT = 0x01;
+const uint32_t HID_INPUT_VARIABLE = 0x02;
+
+const uint32_t HID_COLLECTION_APPLICATION = 0x01;
+
+const unsigned short JS_USAGE_GENERIC_JOYSTICK = 0x04;
+const unsigned short JS_USAGE_GENERIC_GAMEPAD = 0x05;
+
+const int HID_REPORT_IDS = 256;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SHidGlobals
+{
+    uint16_t usagePage;
+    int32_t logicalMin;
+    uint32_t logicalMaxData;    // resolved against the minimum when a main item uses it
+    int logicalMaxSize;
+    uint32_t reportSize;
+    uint32_t reportCount;
+    uint8_t reportId;
+};
+
+// A local usage; one of 1 or 2 bytes takes the usage page current at the main item
+struct SHidUsage
+{
+    uint32_t usage;
+    bool extended;
+};
+
+struct SHidLocals
+{
+    std::vector<SHidUsage> usages;
+    SHidUsage usageMin;
+    SHidUsage usageMax;
+    bool hasUsageMin;
+    bool hasUsageMax;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ItemUnsigned
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t ItemUnsigned(const unsigned char* data, int size)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < size; i++)
+    {
+        value |= (uint32_t)data[i] << (8 * i);
+    }
+    return value;
+}
+
+// =================================================================================================
+// ItemSigned               the data sign-extended from its own size
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int32_t ItemSigned(uint32_t value, int size)
+{
+    if (size == 0 || size == 4)
+    {
+        return (int32_t)value;
+    }
+    uint32_t signBit = 1u << (8 * size - 1);
+    return (int32_t)((value ^ signBit) - signBit);
+}
+
+// =================================================================================================
+// ResolveUsage             page in the high half, usage in the low
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t ResolveUsage(const SHidUsage& usage, uint16_t usagePage)
+{
+    return usage.extended ? usage.usage : ((uint32_t)usagePage << 16) | (usage.usage & 0xFFFF);
+}
+
+// =================================================================================================
+// ExpandUsageRange         a Usage Minimum/Maximum pair into the usage list
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool ExpandUsageRange(SHidLocals& locals)
+{
+    // An end of 1 or 2 bytes takes the page of an extended other end
+    SHidUsage first = locals.usageMin;
+    SHidUsage last = locals.usageMax;
+    if (first.extended != last.extended)
+    {
+        uint32_t page = (first.extended ? first.usage : last.usage) & 0xFFFF0000;
+        first.usage = first.extended ? first.usage : page | (first.usage & 0xFFFF);
+        last.usage = last.extended ? last.usage : page | (last.usage & 0xFFFF);
+        first.extended = true;
+    }
+    if (last.usage < first.usage || last.usage - first.usage >= HID_PARSER_MAX_USAGES - locals.usages.size())
+    {
+        return false;
+    }
+
+    for (uint32_t usage = first.usage; usage <= last.usage; usage++)
+    {
+        locals.usages.push_back({ usage, first.extended });
+    }
+    locals.hasUsageMin = false;
+    locals.hasUsageMax = false;
+    return true;
+}
+
+// =================================================================================================
+// AddInputOps              the ops of one Input item of a pad collection; fields nothing maps
+//                          to are left out but still take their bits
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool AddInputOps(const SHidGlobals& globals, const SHidLocals& locals, uint32_t flags, uint32_t bitOffset,
+                        std::vector<SHidExtractOp>& ops)
+{
+    if ((flags & HID_INPUT_CONSTANT) || globals.reportSize == 0 || globals.reportSize > HID_FIELD_MAX_BITS ||
+        locals.usages.empty())
+    {
+        return true;
+    }
+
+    SHidExtractOp op = SHidExtractOp();
+    op.bitSize = (uint8_t)globals.reportSize;
+    op.reportId = globals.reportId;
+    op.logicalMin = globals.logicalMin;
+    op.logicalMax = globals.logicalMin < 0 ? ItemSigned(globals.logicalMaxData, globals.logicalMaxSize)
+                                           : (int32_t)globals.logicalMaxData;
+    op.flags = globals.logicalMin < 0 ? HID_OP_SIGNED : 0;
+    if (op.logicalMax < op.logicalMin)
+    {
+        return true;
+    }
+
+    if (!(flags & HID_INPUT_VARIABLE))
+    {
+        // An array of indices into the usages; only button arrays have a place in JSDATA
+        uint32_t first = ResolveUsage(locals.usages[0], globals.usagePage);
+        if ((first >> 16) != JS_USAGE_PAGE_BUTTON)
+        {
+            return true;
+        }
+        op.field = JSFIELD_BUTTONS;
+        op.flags |= HID_OP_ARRAY;
+        op.button = (uint16_t)first;
+        for (uint32_t i = 0; i < globals.reportCount; i++)
+        {
+            if (ops.size() >= HID_PROGRAM_MAX_OPS)
+            {
+                return false;
+            }
+            op.bitOffset = bitOffset + i * globals.reportSize;
+            ops.push_back(op);
+        }
+        return true;
+    }
+
+    // Fields past the usages would repeat the last one; no pad field is read twice
+    uint32_t count = std::min<uint32_t>(globals.reportCount, (uint32_t)locals.usages.size());
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t usage = ResolveUsage(locals.usages[i], globals.usagePage);
+        unsigned short usagePage = (unsigned short)(usage >> 16);
+        unsigned short usageId = (unsigned short)usage;
+
+        uint32_t fieldOffset = bitOffset + i * globals.reportSize;
+        if (usagePage == JS_USAGE_PAGE_BUTTON)
+        {
+            if (usageId < 1 || usageId > BUTTONS_NUM)
+            {
+                continue;
+            }
+
+            // One-bit buttons next to each other in the report and in usage are read as one field
+            SHidExtractOp* pRun = ops.empty() ? nullptr : &ops.back();
+            if (globals.reportSize == 1 && pRun != nullptr && (pRun->flags & HID_OP_BUTTON_RUN) &&
+                pRun->reportId == op.reportId && pRun->bitOffset + pRun->bitSize == fieldOffset &&
+                pRun->button + pRun->bitSize == usageId - 1u && pRun->bitSize < HID_FIELD_MAX_BITS)
+            {
+                pRun->bitSize++;
+                continue;
+            }
+            op.field = JSFIELD_BUTTONS;
+            op.button = (uint16_t)(usageId - 1);
+            op.flags = (uint8_t)((op.flags & ~HID_OP_BUTTON_RUN) | (globals.reportSize == 1 ? HID_OP_BUTTON_RUN : 0));
+        }
+        else
+        {
+            EJsField field = MapUsageToField(usagePage, usageId);
+            if (field == JSFIELD_NONE)
+            {
+                continue;
+            }
+            op.field = (uint8_t)field;
+            op.button = 0;
+            op.flags &= ~HID_OP_BUTTON_RUN;
+        }
+
+        if (ops.size() >= HID_PROGRAM_MAX_OPS)
+        {
+            return false;
+        }
+        op.bitOffset = fieldOffset;
+        ops.push_back(op);
+    }
+    return true;
+}
+
+// =================================================================================================
+// LinkReports              groups the ops by report ID and sizes each report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void LinkReports(SHidReportProgram& program)
+{
+    std::stable_sort(program.ops.begin(), program.ops.end(),
+                     [](const SHidExtractOp& a, const SHidExtractOp& b) { return a.reportId < b.reportId; });
+
+    for (size_t i = 0; i < program.ops.size(); i++)
+    {
+        const SHidExtractOp& op = program.ops[i];
+        if (program.reports.empty() || program.reports.back().reportId != op.reportId)
+        {
+            SHidProgramReport report = SHidProgramReport();
+            report.reportId = op.reportId;
+            report.firstOp = (uint16_t)i;
+            program.reports.push_back(report);
+        }
+
+        SHidProgramReport& report = program.reports.back();
+        report.opCount++;
+        uint16_t end = (uint16_t)((op.bitOffset + op.bitSize + 7) / 8);
+        report.minLength = std::max(report.minLength, end);
+        report.clearsButtons = report.clearsButtons || op.field == JSFIELD_BUTTONS;
+    }
+}
+
+// =================================================================================================
+// CompileHidReportDescriptor   short items only carry meaning, long items are skipped. Report
+//                              bit positions are counted per report ID over every Input item,
+//                              pad or not, so the ops land where the device puts the fields.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CompileHidReportDescriptor(const unsigned char* descriptor, size_t length, SHidReportProgram& program)
+{
+    program = SHidReportProgram();
+    if (descriptor == nullptr || length > HID_DESCRIPTOR_MAX_SIZE)
+    {
+        return false;
+    }
+
+    SHidGlobals globals = SHidGlobals();
+    SHidGlobals globalStack[HID_PARSER_MAX_PUSH];
+    int pushDepth = 0;
+    SHidLocals locals = SHidLocals();
+    locals.usages.reserve(HID_PARSER_MAX_USAGES);
+
+    // A collection nests inside a pad when it or one of its parents is a pad application
+    bool padCollection[HID_PARSER_MAX_COLLECTIONS + 1] = { false };
+    int collectionDepth = 0;
+
+    std::vector<uint32_t> inputBits(HID_REPORT_IDS, 0);
+    bool unnumberedInput = false;
+
+    size_t position = 0;
+    while (position < length)
+    {
+        unsigned char prefix = descriptor[position];
+        if (prefix == HID_ITEM_LONG)
+        {
+            if (length - position < 3 || length - position - 3 < descriptor[position + 1])
+            {
+                program = SHidReportProgram();
+                return false;
+            }
+            position += 3 + (size_t)descriptor[position + 1];
+            continue;
+        }
+
+        int size = (prefix & 0x03) == 3 ? 4 : (prefix & 0x03);
+        int type = (prefix >> 2) & 0x03;
+        int tag = prefix >> 4;
+        if (length - position - 1 < (size_t)size)
+        {
+            program = SHidReportProgram();
+            return false;
+        }
+        uint32_t data = ItemUnsigned(&descriptor[position + 1], size);
+        position += 1 + (size_t)size;
+
+        bool valid = true;
+        switch (type)
+        {
+            case HID_ITEM_MAIN:
+            {
+                if (tag == HID_MAIN_INPUT)
+                {
+                    if (program.numbered && globals.reportId == 0)
+                    {
+                        valid = false;
+                        break;
+                    }
+                    uint64_t bits = (uint64_t)globals.reportSize * globals.reportCount;
+                    uint32_t headerBits = program.numbered ? 8 : 0;
+                    uint32_t& reportBits = inputBits[globals.reportId];
+                    if (headerBits + reportBits + bits > HID_REPORT_MAX_SIZE * 8)
+                    {
+                        valid = false;
+                        break;
+                    }
+                    if (padCollection[collectionDepth])
+                    {
+                        valid = AddInputOps(globals, locals, data, headerBits + reportBits, program.ops);
+                    }
+                    reportBits += (uint32_t)bits;
+                    unnumberedInput = unnumberedInput || !program.numbered;
+                }
+                else if (tag == HID_MAIN_COLLECTION)
+                {
+                    if (collectionDepth >= HID_PARSER_MAX_COLLECTIONS)
+                    {
+                        valid = false;
+                        break;
+                    }
+                    uint32_t usage = locals.usages.empty() ? 0 : ResolveUsage(locals.usages[0], globals.usagePage);
+                    bool pad = data == HID_COLLECTION_APPLICATION &&
+                               (usage == (((uint32_t)JS_USAGE_PAGE_GENERIC << 16) | JS_USAGE_GENERIC_JOYSTICK) ||
+                                usage == (((uint32_t)JS_USAGE_PAGE_GENERIC << 16) | JS_USAGE_GENERIC_GAMEPAD));
+                    padCollection[collectionDepth + 1] = padCollection[collectionDepth] || pad;
+                    collectionDepth++;
+                }
+                else if (tag == HID_MAIN_END_COLLECTION)
+                {
+                    if (collectionDepth == 0)
+                    {
+                        valid = false;
+                        break;
+                    }
+                    collectionDepth--;
+                }
+
+                // Output and Feature items take no input bits; every main item ends the locals
+                locals.usages.clear();
+                locals.hasUsageMin = false;
+                locals.hasUsageMax = false;
+                break;
+            }
+
+            case HID_ITEM_GLOBAL:
+                switch (tag)
+                {
+                    case HID_GLOBAL_USAGE_PAGE:     globals.usagePage = (uint16_t)data;                 break;
+                    case HID_GLOBAL_LOGICAL_MIN:    globals.logicalMin = ItemSigned(data, size);        break;
+                    case HID_GLOBAL_REPORT_SIZE:    globals.reportSize = data;                          break;
+                    case HID_GLOBAL_REPORT_COUNT:   globals.reportCount = data;                         break;
+                    case HID_GLOBAL_LOGICAL_MAX:
+                        globals.logicalMaxData = data;
+                        globals.logicalMaxSize = size;
+                        break;
+                    case HID_GLOBAL_REPORT_ID:
+                        // Report IDs are 1 to 255, and a device numbers all of its reports or none
+                        if (data == 0 || data >= HID_REPORT_IDS || unnumberedInput)
+                        {
+                            valid = false;
+                            break;
+                        }
+                        globals.reportId = (uint8_t)data;
+                        program.numbered = true;
+                        break;
+                    case HID_GLOBAL_PUSH:
+                        if (pushDepth >= HID_PARSER_MAX_PUSH)
+                        {
+                            valid = false;
+                            break;
+                        }
+                        globalStack[pushDepth++] = globals;
+                        break;
+                    case HID_GLOBAL_POP:
+                        if (pushDepth == 0)
+                        {
+                            valid = false;
+                            break;
+                        }
+                        globals = globalStack[--pushDepth];
+                        break;
+                }
+                break;
+
+            case HID_ITEM_LOCAL:
+                switch (tag)
+                {
+                    case HID_LOCAL_USAGE:
+                        if (locals.usages.size() >= HID_PARSER_MAX_USAGES)
+                        {
+                            valid = false;
+                            break;
+                        }
+                        locals.usages.push_back({ data, size == 4 });
+                        break;
+                    case HID_LOCAL_USAGE_MIN:
+                        locals.usageMin = { data, size == 4 };
+                        locals.hasUsageMin = true;
+                        break;
+                    case HID_LOCAL_USAGE_MAX:
+                        locals.usageMax = { data, size == 4 };
+                        locals.hasUsageMax = true;
+                        break;
+                }
+                if (valid && locals.hasUsageMin && locals.hasUsageMax)
+                {
+                    valid = ExpandUsageRange(locals);
+                }
+                break;
+        }
+
+        if (!valid)
+        {
+            program = SHidReportProgram();
+            return false;
+        }
+    }
+
+    if (collectionDepth != 0)
+    {
+        program = SHidReportProgram();
+        return false;
+    }
+
+    LinkReports(program);
+    return true;
+}
+
+// =================================================================================================
+// ReadReportField          little-endian bits of the report; the caller has checked the length
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static inline uint32_t ReadReportField(const unsigned char* report, uint32_t bitOffset, uint32_t bitSize)
+{
+    const unsigned char* p = report + (bitOffset >> 3);
+    uint32_t shift = bitOffset & 7;
+    if (shift == 0 && bitSize == 8)
+    {
+        return p[0];
+    }
+
+    uint32_t bytes = (shift + bitSize + 7) >> 3;
+    uint64_t raw = 0;
+    for (uint32_t i = 0; i < bytes; i++)
+    {
+        raw |= (uint64_t)p[i] << (8 * i);
+    }
+    return (uint32_t)((raw >> shift) & ((1ull << bitSize) - 1));
+}
+
+// =================================================================================================
+// RunHidReportProgram      axes are stored raw as HidP_GetUsageValue returns them, signed ones
+//                          moved up to start at 0; a hat outside its logical range is neutral
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool RunHidReportProgram(const SHidReportProgram& program, const unsigned char* report, size_t length, JSDATA& jsData)
+{
+    if (report == nullptr || length == 0)
+    {
+        return false;
+    }
+
+    uint8_t reportId = program.numbered ? report[0] : 0;
+    const SHidProgramReport* pReport = nullptr;
+    for (const SHidProgramReport& candidate : program.reports)
+    {
+        if (candidate.reportId == reportId)
+        {
+            pReport = &candidate;
+            break;
+        }
+    }
+    if (pReport == nullptr || length < pReport->minLength)
+    {
+        return false;
+    }
+
+    if (pReport->clearsButtons)
+    {
+        for (int i = 0; i < BUTTONS_NUM; i++)
+        {
+            jsData.HandlePressed[i] = false;
+        }
+    }
+
+    const SHidExtractOp* pOp = &program.ops[pReport->firstOp];
+    const SHidExtractOp* pEnd = pOp + pReport->opCount;
+    for (; pOp != pEnd; pOp++)
+    {
+        uint32_t raw = ReadReportField(report, pOp->bitOffset, pOp->bitSize);
+        int64_t value = raw;
+        if (pOp->flags & HID_OP_SIGNED)
+        {
+            uint32_t signBit = 1u << (pOp->bitSize - 1);
+            value = (int64_t)(int32_t)((raw ^ signBit) - signBit);
+        }
+
+        switch (pOp->field)
+        {
+            case JSFIELD_BUTTONS:
+                if (pOp->flags & HID_OP_BUTTON_RUN)
+                {
+                    bool* pPressed = &jsData.HandlePressed[pOp->button];
+                    for (; raw != 0; raw >>= 1, pPressed++)
+                    {
+                        *pPressed = *pPressed || (raw & 1) != 0;
+                    }
+                }
+                else if (!(pOp->flags & HID_OP_ARRAY))
+                {
+                    if (raw != 0)
+                    {
+                        jsData.HandlePressed[pOp->button] = true;
+                    }
+                }
+                else if (value >= pOp->logicalMin && value <= pOp->logicalMax)
+                {
+                    int64_t usage = pOp->button + (value - pOp->logicalMin);
+                    if (usage >= 1 && usage <= BUTTONS_NUM)
+                    {
+                        jsData.HandlePressed[usage - 1] = true;
+                    }
+                }
+                break;
+
+            case JSFIELD_ARROW:
+                if (value < pOp->logicalMin || value > pOp->logicalMax)
+                {
+                    jsData.arrowValue = -1;
+                }
+                else
+                {
+                    // A four-way hat steps over the diagonals of the eight-way one
+                    int position = (int)(value - pOp->logicalMin);
+                    jsData.arrowValue = (int64_t)pOp->logicalMax - pOp->logicalMin == 3 ? position * 2 : position;
+                }
+                break;
+
+            default:
+                StoreFieldValue(jsData, (EJsField)pOp->field,
+                                (unsigned long)((pOp->flags & HID_OP_SIGNED) ? value - pOp->logicalMin : value));
+                break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+// =================================================================================================
+// Portable HID report descriptor compiler. A raw report descriptor is parsed once per device into
+// a flat list of extraction ops, one per report field a pad uses (bit offset, bit size, logical
+// range, JSDATA field), and every input report is then decoded by running the ops in a tight loop.
+// Stands in for the HidP_* parser where there is none (Linux hidraw) and for pads no layout
+// decoder knows.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "JSData.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Limits of the compiler; a descriptor past any of them is refused rather than trusted
+const size_t HID_DESCRIPTOR_MAX_SIZE = 4096;        // HID_MAX_DESCRIPTOR_SIZE of the Linux kernel
+const size_t HID_REPORT_MAX_SIZE = 4096;            // bytes of one report, report ID included
+const size_t HID_PROGRAM_MAX_OPS = 256;
+const size_t HID_PARSER_MAX_USAGES = 256;           // local usages of one main item
+const int HID_PARSER_MAX_PUSH = 8;                  // nested Push items
+const int HID_PARSER_MAX_COLLECTIONS = 16;          // nested collections
+const uint32_t HID_FIELD_MAX_BITS = 32;             // wider fields are skipped, no pad field is
+
+// SHidExtractOp::flags
+const uint8_t HID_OP_SIGNED = 0x01;                 // the logical minimum is negative
+const uint8_t HID_OP_ARRAY = 0x02;                  // a button array: the value is a usage index
+const uint8_t HID_OP_BUTTON_RUN = 0x04;             // bitSize one-bit buttons, from button on
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// One report field to read and where it goes
+struct SHidExtractOp
+{
+	uint32_t bitOffset;         // from the start of the report, its report ID byte included
+	uint8_t bitSize;            // 1 to HID_FIELD_MAX_BITS
+	uint8_t field;              // EJsField
+	uint8_t flags;              // HID_OP_* bits
+	uint8_t reportId;           // 0 when the device numbers no reports
+	uint16_t button;            // JSFIELD_BUTTONS: the HandlePressed index of the first button, for
+	                            // an array the button usage of the logical minimum
+	int32_t logicalMin;
+	int32_t logicalMax;
+};
+
+// The ops of one input report, a slice of SHidReportProgram::ops
+struct SHidProgramReport
+{
+	uint8_t reportId;
+	uint16_t firstOp;
+	uint16_t opCount;
+	uint16_t minLength;         // bytes the ops read, shorter reports are refused
+	bool clearsButtons;
+};
+
+// The compiled descriptor; ops are grouped by report ID in the order of reports
+struct SHidReportProgram
+{
+	std::vector<SHidExtractOp> ops;
+	std::vector<SHidProgramReport> reports;
+	bool numbered = false;      // reports start with their report ID
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// Compiles the input fields of the Joystick and GamePad application collections of a raw report
+// descriptor. False, with the program emptied, when the descriptor is malformed or past the
+// limits above; true with no ops when it describes no pad.
+bool CompileHidReportDescriptor(const unsigned char* descriptor, size_t length, SHidReportProgram& program);
+
+// Runs the ops of the report's ID into jsData. False, jsData untouched, when the program has no
+// ops for the report or the report is too short for them.
+bool RunHidReportProgram(const SHidReportProgram& program, const unsigned char* report, size_t length, JSDATA& jsData);
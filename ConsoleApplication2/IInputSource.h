@@ -0,0 +1,80 @@
+// =================================================================================================
+// Platform-neutral boundary between the input backends (Win32 raw input, Linux hidraw / evdev) and
+// the portable core. A source owns the OS handles and calls its sink from a single input thread.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include "JSData.h"
+#include "HidDescriptor.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// What a source could not do, reported to the sink instead of being dropped silently
+enum EInputError
+{
+	INPUT_ERROR_READ,           // reading input failed (GetRawInputData, read, epoll_wait ...)
+	INPUT_ERROR_DEVICE_INFO,    // a device's descriptor, caps or IDs could not be queried
+	INPUT_ERROR_OPEN,           // a device node could not be opened
+	INPUT_ERROR_COUNT
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// Receives what a source reads. deviceKey is any pointer the source keeps unique per open device.
+class IInputSink
+{
+public:
+   virtual ~IInputSink() {}
+
+   virtual bool IsDeviceAttached(void* deviceKey) = 0;
+
+   // Player index of the device, INVALID_PLAYER_INDEX when all slots are taken
+   virtual int OnDeviceArrived(void* deviceKey, uint32_t identity, SHidDeviceDescriptor&& descriptor) = 0;
+   virtual void OnDeviceRemoved(void* deviceKey) = 0;
+
+   // One raw input report, report ID in the first byte. False when nothing could be decoded.
+   // timestampNs is when the source received it; reports a source drains together in one wakeup
+   // may all carry the timestamp of that wakeup.
+   virtual bool OnReport(void* deviceKey, const unsigned char* report, size_t length, uint64_t timestampNs) = 0;
+
+   // A complete state from a source that decodes by itself (evdev)
+   virtual bool OnState(void* deviceKey, const JSDATA& state, uint64_t timestampNs) = 0;
+
+   // Every report of one wakeup has been handed over
+   virtual void OnBatchEnd() = 0;
+
+   // deviceKey is nullptr when the failure is not tied to an attached device; osError is
+   // GetLastError() or errno
+   virtual void OnInputError(void* deviceKey, EInputError error, int osError) = 0;
+};
+
+class IInputSource
+{
+public:
+   virtual ~IInputSource() {}
+
+   // Open the devices present now and report them to sink; later arrivals are reported by Poll.
+   // Opening an open source again with the same sink succeeds without doing anything.
+   virtual bool Open(IInputSink* sink) = 0;
+
+   // Wait up to timeoutMs (-1 = forever) for input and hand it to the sink.
+   // Returns the reports handled, -1 on a fatal error.
+   virtual int Poll(int timeoutMs) = 0;
+
+   // Make a blocked Poll return early, callable from any thread
+   virtual void Wake() = 0;
+
+   virtual void Close() = 0;
+};
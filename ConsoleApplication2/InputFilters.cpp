@@ -0,0 +1,313 @@
+// =================================================================================================
+// Input filtering and prediction: exponential, One Euro and Kalman filters over the normalized
+// axes and the calibrated IMU of every pad, with short-horizon extrapolation to the time a
+// consumer samples. State is kept channel by channel across devices so one pass filters all pads.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "InputFilters.h"
+#include <algorithm>
+#include <cmath>
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const float FILTER_TWO_PI = 6.28318530718f;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// FilterNone               the row of one channel: value follows the input, velocity the raw slope
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void FilterNone(const float* input, float* value, float* velocity, const float* invDt, const float* weight)
+{
+    for (int d = 0; d < MAX_CONTROLLERS; d++)
+    {
+        float slope = (input[d] - value[d]) * invDt[d];
+        velocity[d] += weight[d] * (slope - velocity[d]);
+        value[d] += weight[d] * (input[d] - value[d]);
+    }
+}
+
+// =================================================================================================
+// FilterExponential        fixed weight per report; the velocity is smoothed by the same weight
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void FilterExponential(const SFilterSettings& settings, const float* input, float* value, float* velocity,
+                              const float* invDt, const float* weight)
+{
+    for (int d = 0; d < MAX_CONTROLLERS; d++)
+    {
+        float step = settings.smoothing * (input[d] - value[d]);
+        velocity[d] += weight[d] * settings.smoothing * (step * invDt[d] - velocity[d]);
+        value[d] += weight[d] * step;
+    }
+}
+
+// =================================================================================================
+// FilterOneEuro            Casiez et al.: smoothing factor dt / (dt + tau), tau from a cutoff that
+//                          grows with the filtered speed
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void FilterOneEuro(const SFilterSettings& settings, float derivativeTau, const float* input, float* value, float* velocity,
+                          const float* dt, const float* invDt, const float* weight)
+{
+    for (int d = 0; d < MAX_CONTROLLERS; d++)
+    {
+        float slope = (input[d] - value[d]) * invDt[d];
+        float speed = velocity[d] + dt[d] / (dt[d] + derivativeTau) * (slope - velocity[d]);
+
+        float cutoffHz = settings.minCutoffHz + settings.beta * std::fabs(speed);
+        float tau = 1.0f / (FILTER_TWO_PI * cutoffHz);
+        float smoothing = dt[d] / (dt[d] + tau);
+
+        velocity[d] += weight[d] * (speed - velocity[d]);
+        value[d] += weight[d] * smoothing * (input[d] - value[d]);
+    }
+}
+
+// =================================================================================================
+// FilterKalman             constant-velocity model: predict position and covariance over dt with
+//                          white-noise acceleration, then correct with the measurement
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void FilterKalman(const SFilterSettings& settings, const float* input, float* value, float* velocity,
+                         float* covariance00, float* covariance01, float* covariance11, const float* dt, const float* weight)
+{
+    float q = settings.processNoise;
+    float r = settings.measurementNoise;
+
+    for (int d = 0; d < MAX_CONTROLLERS; d++)
+    {
+        float t = dt[d];
+        float predicted = value[d] + velocity[d] * t;
+        float p00 = covariance00[d] + t * (2.0f * covariance01[d] + t * covariance11[d]) + q * t * t * t * (1.0f / 3.0f);
+        float p01 = covariance01[d] + t * covariance11[d] + q * t * t * 0.5f;
+        float p11 = covariance11[d] + q * t;
+
+        float gainScale = 1.0f / (p00 + r);
+        float k0 = p00 * gainScale;
+        float k1 = p01 * gainScale;
+        float innovation = input[d] - predicted;
+
+        float w = weight[d];
+        value[d] += w * (predicted + k0 * innovation - value[d]);
+        velocity[d] += w * (k1 * innovation);
+        covariance00[d] += w * ((1.0f - k0) * p00 - covariance00[d]);
+        covariance01[d] += w * ((1.0f - k0) * p01 - covariance01[d]);
+        covariance11[d] += w * (p11 - k1 * p01 - covariance11[d]);
+    }
+}
+
+// =================================================================================================
+// CInputFilterBank
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CInputFilterBank::CInputFilterBank() :
+    m_pending(0)
+{
+    Configure(SFilterConfig());
+    for (int device = 0; device < MAX_CONTROLLERS; device++)
+    {
+        Reset(device);
+    }
+}
+
+// =================================================================================================
+// Configure                every channel of every pad; running filters keep their state
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CInputFilterBank::Configure(const SFilterConfig& config)
+{
+    m_config = config;
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        SFilterSettings& settings = m_config.channels[channel];
+        settings.smoothing = std::min(std::max(settings.smoothing, 0.0f), 1.0f);
+        settings.minCutoffHz = std::max(settings.minCutoffHz, 0.001f);
+        settings.derivativeCutoffHz = std::max(settings.derivativeCutoffHz, 0.001f);
+        settings.measurementNoise = std::max(settings.measurementNoise, 1e-9f);
+        settings.processNoise = std::max(settings.processNoise, 0.0f);
+        settings.predictionMs = std::max(settings.predictionMs, 0.0f);
+        m_derivativeTau[channel] = 1.0f / (FILTER_TWO_PI * settings.derivativeCutoffHz);
+    }
+}
+
+// =================================================================================================
+// Reset                    the next report of the pad starts its filters over
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CInputFilterBank::Reset(int device)
+{
+    if (device < 0 || device >= MAX_CONTROLLERS)
+    {
+        return;
+    }
+
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        m_input[channel][device] = 0.0f;
+        m_value[channel][device] = 0.0f;
+        m_velocity[channel][device] = 0.0f;
+        m_covariance00[channel][device] = 0.0f;
+        m_covariance01[channel][device] = 0.0f;
+        m_covariance11[channel][device] = 0.0f;
+    }
+    m_dt[device] = 1.0f;
+    m_weight[device] = 0.0f;
+    m_lastNs[device] = 0;
+    m_started[device] = false;
+    m_pending &= ~(1u << device);
+}
+
+// =================================================================================================
+// Submit                   the first report of a pad sets its filters to the values as they are
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CInputFilterBank::Submit(int device, const float* values, uint64_t timestampNs)
+{
+    if (device < 0 || device >= MAX_CONTROLLERS)
+    {
+        return;
+    }
+
+    if (!m_started[device])
+    {
+        for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+        {
+            const SFilterSettings& settings = m_config.channels[channel];
+            m_input[channel][device] = values[channel];
+            m_value[channel][device] = values[channel];
+            m_velocity[channel][device] = 0.0f;
+            m_covariance00[channel][device] = settings.measurementNoise;
+            m_covariance01[channel][device] = 0.0f;
+            m_covariance11[channel][device] = settings.processNoise * FILTER_MAX_DT_SECONDS;
+        }
+        m_started[device] = true;
+        m_lastNs[device] = timestampNs;
+        m_pending |= 1u << device;
+        return;
+    }
+
+    // A report replacing a queued one spans the time of both
+    float stepSeconds = timestampNs > m_lastNs[device] ? (float)(timestampNs - m_lastNs[device]) * 1e-9f : 0.0f;
+    float dt = m_weight[device] != 0.0f ? m_dt[device] + stepSeconds : stepSeconds;
+    m_dt[device] = std::min(std::max(dt, FILTER_MIN_DT_SECONDS), FILTER_MAX_DT_SECONDS);
+    m_weight[device] = 1.0f;
+    m_lastNs[device] = std::max(timestampNs, m_lastNs[device]);
+
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        m_input[channel][device] = values[channel];
+    }
+    m_pending |= 1u << device;
+}
+
+// =================================================================================================
+// Update                   pads without a queued report go through the same arithmetic with a
+//                          zero weight, so every row is one loop without branches
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+unsigned int CInputFilterBank::Update()
+{
+    unsigned int updated = m_pending;
+    if (updated == 0)
+    {
+        return 0;
+    }
+
+    alignas(64) float invDt[MAX_CONTROLLERS];
+    for (int d = 0; d < MAX_CONTROLLERS; d++)
+    {
+        invDt[d] = 1.0f / m_dt[d];
+    }
+
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        const SFilterSettings& settings = m_config.channels[channel];
+        switch (settings.type)
+        {
+            case FILTER_NONE:
+                FilterNone(m_input[channel], m_value[channel], m_velocity[channel], invDt, m_weight);
+                break;
+
+            case FILTER_EXPONENTIAL:
+                FilterExponential(settings, m_input[channel], m_value[channel], m_velocity[channel], invDt, m_weight);
+                break;
+
+            case FILTER_ONE_EURO:
+                FilterOneEuro(settings, m_derivativeTau[channel], m_input[channel], m_value[channel], m_velocity[channel], m_dt, invDt, m_weight);
+                break;
+
+            case FILTER_KALMAN:
+                FilterKalman(settings, m_input[channel], m_value[channel], m_velocity[channel],
+                             m_covariance00[channel], m_covariance01[channel], m_covariance11[channel], m_dt, m_weight);
+                break;
+        }
+    }
+
+    for (int d = 0; d < MAX_CONTROLLERS; d++)
+    {
+        m_dt[d] = 1.0f;
+        m_weight[d] = 0.0f;
+    }
+    m_pending = 0;
+    return updated;
+}
+
+// =================================================================================================
+// GetState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CInputFilterBank::GetState(int device, SFilteredState& state) const
+{
+    state.timestampNs = m_lastNs[device];
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        state.value[channel] = m_value[channel][device];
+        state.velocity[channel] = m_velocity[channel][device];
+    }
+}
+
+// =================================================================================================
+// Predict                  a target before the state's own time reads the state as it is
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CInputFilterBank::Predict(const SFilteredState& state, uint64_t targetNs, float* values) const
+{
+    float aheadSeconds = targetNs > state.timestampNs ? (float)(targetNs - state.timestampNs) * 1e-9f : 0.0f;
+
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        float horizon = std::min(aheadSeconds, m_config.channels[channel].predictionMs * 0.001f);
+        float value = state.value[channel] + state.velocity[channel] * horizon;
+        if (channel < FILTER_L2)
+        {
+            value = std::min(std::max(value, -1.0f), 1.0f);
+        }
+        else if (channel <= FILTER_R2)
+        {
+            value = std::min(std::max(value, 0.0f), 1.0f);
+        }
+        values[channel] = value;
+    }
+}
@@ -0,0 +1,123 @@
+// =================================================================================================
+// Input filtering and prediction: exponential, One Euro and Kalman filters over the normalized
+// axes and the calibrated IMU of every pad, with short-horizon extrapolation to the time a
+// consumer samples. State is kept channel by channel across devices so one pass filters all pads.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include "CDeviceRegistry.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// The axes in EAxis order, then gyro in deg/s and accel in g
+enum EFilterChannel
+{
+	FILTER_LEFT_X,
+	FILTER_LEFT_Y,
+	FILTER_RIGHT_X,
+	FILTER_RIGHT_Y,
+	FILTER_L2,
+	FILTER_R2,
+	FILTER_GYRO_PITCH,
+	FILTER_GYRO_YAW,
+	FILTER_GYRO_ROLL,
+	FILTER_ACCEL_X,
+	FILTER_ACCEL_Y,
+	FILTER_ACCEL_Z,
+	FILTER_CHANNELS
+};
+
+enum EFilterType
+{
+	FILTER_NONE,            // passes the samples through, still tracks velocity for prediction
+	FILTER_EXPONENTIAL,     // fixed weight per report
+	FILTER_ONE_EURO,        // cutoff rises with speed: smooth at rest, little lag in motion
+	FILTER_KALMAN           // constant-velocity model, meant for the IMU
+};
+
+// Time between two reports of a pad is clamped to this range; a longer gap does not blow up the
+// velocity and a duplicate timestamp does not divide by zero
+const float FILTER_MIN_DT_SECONDS = 0.0001f;
+const float FILTER_MAX_DT_SECONDS = 0.1f;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SFilterSettings
+{
+	EFilterType type = FILTER_NONE;
+	float smoothing = 0.5f;             // exponential: weight of the new sample, 1 = no filtering
+	float minCutoffHz = 1.0f;           // One Euro: cutoff at rest
+	float beta = 0.0f;                  // One Euro: cutoff added per unit/s of speed
+	float derivativeCutoffHz = 1.0f;    // One Euro: smoothing of the speed itself
+	float processNoise = 100.0f;        // Kalman: acceleration variance per second
+	float measurementNoise = 0.01f;     // Kalman: variance of one sample
+	float predictionMs = 0.0f;          // furthest a read may extrapolate, 0 = no prediction
+};
+
+// One setting per channel, the same for every pad
+struct SFilterConfig
+{
+	SFilterSettings channels[FILTER_CHANNELS];
+};
+
+// Output of one pad after its latest report
+struct SFilteredState
+{
+	uint64_t timestampNs;               // of the report the values belong to
+	float value[FILTER_CHANNELS];
+	float velocity[FILTER_CHANNELS];    // per second
+};
+
+class CInputFilterBank
+{
+public:
+   CInputFilterBank();
+
+   void Configure(const SFilterConfig& config);
+   void Reset(int device);
+
+   // Queues the FILTER_CHANNELS values of one report. A pad queued twice before Update keeps
+   // only the second; callers flush with Update when IsPending says so.
+   void Submit(int device, const float* values, uint64_t timestampNs);
+   bool IsPending(int device) const { return (m_pending >> device) & 1; }
+   // Timestamp of the newest report submitted for the pad
+   uint64_t GetLastTimestamp(int device) const { return m_lastNs[device]; }
+
+   // Filters every queued report, channel by channel; returns the bit mask of the pads updated
+   unsigned int Update();
+
+   void GetState(int device, SFilteredState& state) const;
+
+   // Extrapolates a state to targetNs, at most predictionMs ahead per channel; axes stay in range
+   void Predict(const SFilteredState& state, uint64_t targetNs, float* values) const;
+
+private:
+   SFilterConfig m_config;
+   float m_derivativeTau[FILTER_CHANNELS];     // 1 / (2 pi derivativeCutoffHz)
+
+   // [channel][device]: each filter walks a row, all pads side by side
+   alignas(64) float m_input[FILTER_CHANNELS][MAX_CONTROLLERS];
+   alignas(64) float m_value[FILTER_CHANNELS][MAX_CONTROLLERS];
+   alignas(64) float m_velocity[FILTER_CHANNELS][MAX_CONTROLLERS];
+   alignas(64) float m_covariance00[FILTER_CHANNELS][MAX_CONTROLLERS];
+   alignas(64) float m_covariance01[FILTER_CHANNELS][MAX_CONTROLLERS];
+   alignas(64) float m_covariance11[FILTER_CHANNELS][MAX_CONTROLLERS];
+
+   // Per pad: the step to the queued report and 1 when there is one, 0 otherwise
+   alignas(64) float m_dt[MAX_CONTROLLERS];
+   float m_weight[MAX_CONTROLLERS];
+   uint64_t m_lastNs[MAX_CONTROLLERS];
+   bool m_started[MAX_CONTROLLERS];
+   unsigned int m_pending;
+};
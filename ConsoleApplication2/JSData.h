@@ -0,0 +1,76 @@
+// =================================================================================================
+// Joystick state shared by the platform code and the portable decode core.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int BUTTONS_NUM = 12;
+
+// JSDATA member a decoded report field is stored into
+enum EJsField
+{
+	JSFIELD_NONE,
+	JSFIELD_LEFT_X,
+	JSFIELD_LEFT_Y,
+	JSFIELD_RIGHT_X,
+	JSFIELD_RIGHT_Y,
+	JSFIELD_L2,
+	JSFIELD_R2,
+	JSFIELD_ARROW,
+	JSFIELD_BUTTONS     // one bit per HandlePressed entry
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct JSDATA
+{
+	int32_t leftX;
+	int32_t leftY;
+	int32_t rightX;
+	int32_t rightY;
+	int32_t L2;
+	int32_t R2;
+	bool HandlePressed[BUTTONS_NUM];
+	int arrowValue;
+
+	JSDATA() :
+			leftX(0),
+			leftY(0),
+			rightX(0),
+			rightY(0),
+			L2(0),
+			R2(0),
+		    arrowValue(-1)
+	{
+		for (int i=0;i< BUTTONS_NUM;i++)
+		{
+			HandlePressed[i] = false;
+		}
+	}
+};
+
+// One decoded report as delivered to consumers
+struct SJoystickSample
+{
+	uint64_t timestampNs;   // MonotonicNowNs() when the source received the report; shared by the
+	                        // reports of one batched read
+	uint64_t sequence;      // increments by one per decoded report, across all players
+	int32_t playerIndex;
+	JSDATA data;
+};
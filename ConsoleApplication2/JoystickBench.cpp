@@ -0,0 +1,2717 @@
+// =================================================================================================
+// Benchmark runner. Measures the portable parts of the pipeline on synthetic DS4 reports and
+// prints the results as one JSON document on stdout. Not a test, nothing is asserted.
+//
+//   decode          ns and heap allocations per report, layout decoder against the caps-driven
+//                   generic path and the compiled report descriptor, alone and through CJoystickCore
+//   descriptor_cache   ns and heap allocations per report of the caps path, the descriptor built
+//                   from the caps again for every report as WM_INPUT used to, against decoding
+//                   with the descriptor cached at arrival
+//   hid_program     the caps path against the compiled DS4 report descriptor on the same reports,
+//                   synthetic and from the captures: ns per report and reports that disagree
+//   hid_descriptor_fuzz   malformed descriptors through the compiler, programs checked and run
+//   delivery        callback and queue latency percentiles and throughput on the input thread,
+//                   1/4/8 synthetic pads at 250 Hz to 8 kHz
+//   raw_input_batch GetRawInputBuffer-style buffers of 4 pads, 1 to 16 reports each per wakeup,
+//                   walked and fed to the core with every report delivered and with the latest
+//                   per pad: ns and heap allocations per report, samples delivered per wakeup
+//   stats           per-report cost of the CJoystickStats bookkeeping against the direct decode
+//                   through the core; build with JOYSTICK_ENABLE_STATS=OFF for the core without it
+//   state_*         legacy JSDATA samples against SPadState: copies, callbacks, queue throughput
+//                   between two threads and button edge detection
+//   display_*       redraw work of the data window per report
+//   replay_decode   captures given on the command line, replayed as fast as the core decodes
+//   filter          cost of one filter pass per report, each filter type on 1 and 8 pads
+//   filter_eval     the same captures through each filter preset offline: lag against the input
+//                   and jitter of the output, for a stick axis and the gyro yaw
+//   shared_state    report to reader visibility through the shared-memory region, and the cost of
+//                   a reader's poll and read
+//   seqlock         one writer publishing flat out against 1/2/4 spinning readers: ns per
+//                   publish, reads per second, the share of read attempts a write overlapped, and
+//                   torn copies, which must stay 0
+//   events          legacy per-report callbacks against change-driven events, idle and active pad:
+//                   callbacks and consumer CPU time per second of input
+//   events_replay   the events comparison on the captures
+//   combo           16 to 4096 random combos on a resting and a busy pad: ns per report and per
+//                   report that changed an input
+//   combo_replay    the 4096 combos on the captures
+//   state_server    synthetic pads streamed over loopback UDP to a client stand-in, DSU against
+//                   the compact delta protocol: datagrams and bytes per second per pad, and
+//                   whether the client ends up with the pads' final state
+//   state_server_resting   the same for a pad at rest, fed straight into the server
+//   output          rumble set at 1 kHz, 8 kHz and unthrottled on a DS4 over USB and Bluetooth,
+//                   written to a stand-in device: reports written against updates, the shortest
+//                   gap between reports, submit cost and whether the last report holds the last
+//                   update
+//
+// JoystickBench [--duration-ms N] [capture ...]
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+#include "AllocationCounter.h"
+#include "AxisProcessing.h"
+#include "ByteOrder.h"
+#include "CCaptureReader.h"
+#include "CInputThread.h"
+#include "CJoystickCore.h"
+#include "CJoystickStats.h"
+#include "CPadOutputWriter.h"
+#include "CSeqLock.h"
+#include "CReplaySource.h"
+#include "CSharedStateReader.h"
+#include "CStateClient.h"
+#include "CStateServer.h"
+#include "CSyntheticInputSource.h"
+#include "CpuFeatures.h"
+#include "Crc32.h"
+#include "DisplayDiff.h"
+#include "Ds4Motion.h"
+#include "HidCapsModel.h"
+#include "HidDescriptor.h"
+#include "HidReportProgram.h"
+#include "InputFilters.h"
+#include "MonotonicClock.h"
+#include "PadCombos.h"
+#include "PadEvents.h"
+#include "PadOutput.h"
+#include "PadState.h"
+#include "RawInputBatch.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Input time simulated per redraw case; the clock is simulated, the run takes milliseconds
+const unsigned int REDRAW_SIMULATED_SECONDS = 10;
+const unsigned int REDRAW_REFRESH_HZ = 60;
+const unsigned int REDRAW_INPUT_RATES_HZ[] = { 250, 1000, 8000 };
+
+const int DIFF_ITERATIONS = 1000000;
+
+const int DECODE_ITERATIONS = 2000000;
+const int DECODE_DISTINCT_REPORTS = 256;           // cycled so the branches see changing input
+
+const int DESCRIPTOR_CACHE_ITERATIONS = 200000;    // fewer, the uncached case rebuilds per report
+
+const int HID_FUZZ_ITERATIONS = 200000;
+const int HID_FUZZ_REPORTS = 4;                    // random reports run through each accepted program
+const size_t HID_FUZZ_MAX_REPORT_SIZE = 96;
+const size_t HID_FUZZ_MAX_RANDOM_SIZE = 256;
+
+const int STATS_ITERATIONS = 10000000;
+
+const int STATE_ITERATIONS = 10000000;
+const size_t STATE_ARRAY_SIZE = 4096;              // samples cycled through by the copy case
+const uint64_t STATE_QUEUE_ITEMS = 1000000;
+const size_t STATE_QUEUE_CAPACITY = 1024;
+
+const int MOTION_ITERATIONS = 10000000;
+
+const size_t AXIS_BATCH_SIZES[] = { 1, 16, 256, 4096 };
+const size_t AXIS_REPORTS = 4000000;               // per kernel and batch size
+
+const int FILTER_ITERATIONS = 1000000;
+const int FILTER_PADS[] = { 1, MAX_CONTROLLERS };
+
+// Offline evaluation: the output is matched against the input shifted by up to this many reports
+const int FILTER_EVAL_MAX_SHIFT = 32;
+
+const int EVENT_REPORTS = 2000000;
+const unsigned int EVENT_REPORT_RATE_HZ = 250;      // a DS4 over USB, for callbacks per second
+const int EVENT_IDLE_NOISE_PERIOD = 16;             // reports between one-step wobbles of a resting stick
+const int EVENT_REPEATS = 5;                        // the fastest run counts, the machine is shared
+
+const size_t COMBO_BENCH_COUNTS[] = { 16, 256, 1024, 4096 };
+const size_t COMBO_BENCH_MAX_STEPS = 6;
+const size_t COMBO_BENCH_REPORTS = 200000;           // 200 s of a pad at 1 kHz
+const uint32_t COMBO_BENCH_CHANGE_PERIOD = 20;       // an input change every 20 ms on average
+
+// Region the shared_state case publishes into, apart from the default a running demo may use
+const char* const SHARED_BENCH_NAME = "JoystickBenchSharedState";
+const unsigned int SHARED_RATES_HZ[] = { 250, 1000, 8000 };
+const int SHARED_READ_ITERATIONS = 10000000;
+
+const int SEQLOCK_READERS[] = { 1, 2, 4 };
+const int SEQLOCK_PAYLOAD_WORDS = 8;                   // one cache line, as SPadState
+
+const int STATE_SERVER_PADS[] = { 1, 4, 8 };
+const unsigned int STATE_SERVER_RATES_HZ[] = { 250, 1000 };
+const uint32_t STATE_SERVER_CLIENT_POLL_US = 1000;
+const unsigned int STATE_SERVER_SETTLE_MS = 20;        // flush intervals the client waits after the feed
+
+// Update rates of the output case, 0 = as fast as the caller can loop
+const unsigned int OUTPUT_SUBMIT_RATES_HZ[] = { 1000, 8000, 0 };
+const uint32_t OUTPUT_DEVICE_WRITE_US = 1000;          // the stand-in takes a USB frame per report
+const size_t OUTPUT_MAX_COSTS = 4000000;               // submit costs kept for the percentiles
+const int OUTPUT_LIGHTBAR_PERIOD = 256;                // updates between lightbar changes
+
+// How the consumer of the events case takes the input
+const char* const EVENT_CONSUMERS[] = { "none", "legacy", "events" };
+
+const int DELIVERY_PADS[] = { 1, 4, 8 };
+const unsigned int DELIVERY_RATES_HZ[] = { 250, 1000, 4000, 8000 };
+const unsigned int DELIVERY_DEFAULT_DURATION_MS = 500;
+const size_t DELIVERY_QUEUE_CAPACITY = 4096;
+
+const int RAW_BATCH_PADS = 4;
+const uint32_t RAW_BATCH_REPORTS_PER_PAD[] = { 1, 4, 16 };
+const uint64_t RAW_BATCH_REPORTS = 2000000;            // per case, over as many wakeups as it takes
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// One report of a capture as filter input: normalized axes and IMU
+struct SFilterInput
+{
+	uint64_t timestampNs;
+	float values[FILTER_CHANNELS];
+};
+
+// What an event consumer saw
+struct SEventCounts
+{
+	uint64_t callbacks;
+	uint64_t changes;           // legacy: callbacks whose JSDATA differed from the previous one
+	uint64_t events;
+};
+
+// A filter setup the offline evaluation compares
+struct SFilterPreset
+{
+	const char* name;
+	SFilterSettings settings;
+};
+
+// Writes {"benchmarks":[{...},...]} one case at a time
+class CBenchReport
+{
+public:
+   CBenchReport() : m_cases(0)
+   {
+      std::printf("{\n  \"benchmarks\": [");
+   }
+
+   ~CBenchReport()
+   {
+      std::printf("\n  ]\n}\n");
+   }
+
+   void BeginCase(const char* name)
+   {
+      std::printf("%s\n    {\"name\": \"%s\"", m_cases++ ? "," : "", name);
+   }
+
+   void Field(const char* key, double value)
+   {
+      std::printf(", \"%s\": %.3f", key, value);
+   }
+
+   void Field(const char* key, uint64_t value)
+   {
+      std::printf(", \"%s\": %llu", key, (unsigned long long)value);
+   }
+
+   void Field(const char* key, const char* value)
+   {
+      std::printf(", \"%s\": \"", key);
+      for (; *value != '\0'; value++)
+      {
+         if (*value == '"' || *value == '\\')
+         {
+            std::putchar('\\');
+         }
+         std::putchar(*value);
+      }
+      std::putchar('"');
+   }
+
+   void EndCase()
+   {
+      std::printf("}");
+   }
+
+private:
+   int m_cases;
+};
+
+// Stand-in for a pad's output handle: keeps when each report came and the last one, checks the
+// Bluetooth CRC and takes OUTPUT_DEVICE_WRITE_US per report as a USB interrupt endpoint does.
+// Read only after the writer let go of it.
+class CBenchOutputDevice : public IPadOutputDevice
+{
+public:
+   explicit CBenchOutputDevice(size_t expectedWrites) : m_length(0), m_crcErrors(0)
+   {
+      m_writeNs.reserve(expectedWrites);
+   }
+
+   bool Write(const unsigned char* report, size_t length) override
+   {
+      m_writeNs.push_back(MonotonicNowNs());
+      std::memcpy(m_report, report, length);
+      m_length = length;
+      if (report[0] == DS4_OUTPUT_BT_REPORT_ID && LoadLe32(report + length - 4) != Crc32Report(CRC32_SEED_BT_OUTPUT, report, length - 4))
+      {
+         m_crcErrors++;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(OUTPUT_DEVICE_WRITE_US));
+      return true;
+   }
+
+   const std::vector<uint64_t>& GetWriteTimes() const { return m_writeNs; }
+   bool LastReportIs(const unsigned char* report, size_t length) const
+   {
+      return m_length == length && std::memcmp(m_report, report, length) == 0;
+   }
+   uint64_t GetCrcErrors() const { return m_crcErrors; }
+
+private:
+   std::vector<uint64_t> m_writeNs;
+   unsigned char m_report[PAD_OUTPUT_MAX_REPORT_SIZE];
+   size_t m_length;
+   uint64_t m_crcErrors;
+};
+
+// Every word holds the version it was published as, so a torn copy shows
+struct SBenchVersionPayload
+{
+	uint64_t words[SEQLOCK_PAYLOAD_WORDS];
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// Percentile               of values sorted ascending
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint64_t Percentile(const std::vector<uint64_t>& sortedValues, double fraction)
+{
+    if (sortedValues.empty())
+    {
+        return 0;
+    }
+    size_t index = (size_t)(fraction * (double)sortedValues.size());
+    return sortedValues[index < sortedValues.size() ? index : sortedValues.size() - 1];
+}
+
+// =================================================================================================
+// CountLines
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int CountLines(uint32_t lineMask)
+{
+    int count = 0;
+    for (; lineMask != 0; lineMask &= lineMask - 1)
+    {
+        count++;
+    }
+    return count;
+}
+
+// =================================================================================================
+// ElapsedNs
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static double ElapsedNs(std::chrono::steady_clock::time_point start)
+{
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// =================================================================================================
+// BuildDecodeReports       DECODE_DISTINCT_REPORTS synthetic DS4 USB reports back to back
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<unsigned char> BuildDecodeReports()
+{
+    std::vector<unsigned char> reports(DECODE_DISTINCT_REPORTS * SYNTHETIC_REPORT_SIZE);
+    for (int i = 0; i < DECODE_DISTINCT_REPORTS; i++)
+    {
+        CSyntheticInputSource::BuildReport(0, (uint64_t)i * 37, &reports[i * SYNTHETIC_REPORT_SIZE]);
+    }
+    return reports;
+}
+
+// =================================================================================================
+// BenchDecode              the same DS4 reports through the layout decoder, the caps path and the
+//                          compiled report descriptor, first the decoders alone, then
+//                          CJoystickCore::OnReport with a callback and the sample queue attached
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchDecode(CBenchReport& report)
+{
+    std::vector<unsigned char> reports = BuildDecodeReports();
+
+    const char* paths[] = { "direct", "generic", "program" };
+    for (int path = 0; path < 3; path++)
+    {
+        SHidDeviceDescriptor capsDescriptor = BuildCapsDescriptor();
+        SHidDeviceDescriptor programDescriptor = BuildProgramDescriptor();
+        JSDATA jsData;
+        uint64_t checksum = 0;
+
+        uint64_t allocationsBefore = GetAllocationCount();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < DECODE_ITERATIONS; i++)
+        {
+            const unsigned char* raw = &reports[(i % DECODE_DISTINCT_REPORTS) * SYNTHETIC_REPORT_SIZE];
+            if (path == 1)
+            {
+                DecodeCapsReport(capsDescriptor, raw, SYNTHETIC_REPORT_SIZE, jsData);
+            }
+            else if (path == 2)
+            {
+                DecodeReportProgram(programDescriptor, raw, SYNTHETIC_REPORT_SIZE, jsData);
+            }
+            else
+            {
+                DecodeDs4UsbReport(raw, SYNTHETIC_REPORT_SIZE, jsData);
+            }
+            checksum += jsData.leftX + jsData.HandlePressed[i % BUTTONS_NUM];
+        }
+        double elapsedNs = ElapsedNs(start);
+        uint64_t allocations = GetAllocationCount() - allocationsBefore;
+
+        report.BeginCase("decode");
+        report.Field("path", paths[path]);
+        report.Field("stage", "decoder");
+        report.Field("iterations", (uint64_t)DECODE_ITERATIONS);
+        report.Field("ns_per_report", elapsedNs / DECODE_ITERATIONS);
+        report.Field("allocs_per_report", (double)allocations / DECODE_ITERATIONS);
+        report.Field("checksum", checksum);
+        report.EndCase();
+    }
+
+    for (int path = 0; path < 3; path++)
+    {
+        CJoystickCore core;
+        uint64_t callbacks = 0;
+        core.SetCallback([&callbacks](int, JSDATA) { callbacks++; });
+        core.EnableSampleQueue(DELIVERY_QUEUE_CAPACITY, RING_OVERWRITE_OLDEST);
+
+        SHidDeviceDescriptor descriptor = path == 2 ? BuildProgramDescriptor() : BuildCapsDescriptor();
+        if (path == 0)
+        {
+            descriptor.vendorId = SONY_VENDOR_ID;
+        }
+        int deviceKey = 0;
+        core.OnDeviceArrived(&deviceKey, 1, std::move(descriptor));
+
+        uint64_t allocationsBefore = GetAllocationCount();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < DECODE_ITERATIONS; i++)
+        {
+            const unsigned char* raw = &reports[(i % DECODE_DISTINCT_REPORTS) * SYNTHETIC_REPORT_SIZE];
+            core.OnReport(&deviceKey, raw, SYNTHETIC_REPORT_SIZE, (uint64_t)i);
+        }
+        double elapsedNs = ElapsedNs(start);
+        uint64_t allocations = GetAllocationCount() - allocationsBefore;
+
+        report.BeginCase("decode");
+        report.Field("path", paths[path]);
+        report.Field("stage", "core");
+        report.Field("iterations", (uint64_t)DECODE_ITERATIONS);
+        report.Field("ns_per_report", elapsedNs / DECODE_ITERATIONS);
+        report.Field("allocs_per_report", (double)allocations / DECODE_ITERATIONS);
+        report.Field("callbacks", callbacks);
+        report.Field("stats_enabled", (uint64_t)JOYSTICK_ENABLE_STATS);
+        report.EndCase();
+    }
+}
+
+// =================================================================================================
+// BenchDescriptorCache     the caps path with the descriptor built from the caps for every report,
+//                          the per-WM_INPUT query before the cache, then with the descriptor built
+//                          once and reused, as the registry keeps it from arrival on
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchDescriptorCache(CBenchReport& report)
+{
+    std::vector<unsigned char> reports = BuildDecodeReports();
+
+    const char* modes[] = { "before", "after" };
+    for (int mode = 0; mode < 2; mode++)
+    {
+        SHidDeviceDescriptor cachedDescriptor = BuildCapsDescriptor();
+        JSDATA jsData;
+        uint64_t checksum = 0;
+
+        uint64_t allocationsBefore = GetAllocationCount();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < DESCRIPTOR_CACHE_ITERATIONS; i++)
+        {
+            const unsigned char* raw = &reports[(i % DECODE_DISTINCT_REPORTS) * SYNTHETIC_REPORT_SIZE];
+            if (mode == 0)
+            {
+                SHidDeviceDescriptor descriptor = BuildCapsDescriptor();
+                DecodeCapsReport(descriptor, raw, SYNTHETIC_REPORT_SIZE, jsData);
+            }
+            else
+            {
+                DecodeCapsReport(cachedDescriptor, raw, SYNTHETIC_REPORT_SIZE, jsData);
+            }
+            checksum += jsData.leftX + jsData.HandlePressed[i % BUTTONS_NUM];
+        }
+        double elapsedNs = ElapsedNs(start);
+        uint64_t allocations = GetAllocationCount() - allocationsBefore;
+
+        report.BeginCase("descriptor_cache");
+        report.Field("mode", modes[mode]);
+        report.Field("iterations", (uint64_t)DESCRIPTOR_CACHE_ITERATIONS);
+        report.Field("ns_per_report", elapsedNs / DESCRIPTOR_CACHE_ITERATIONS);
+        report.Field("allocs_per_report", (double)allocations / DESCRIPTOR_CACHE_ITERATIONS);
+        report.Field("checksum", checksum);
+        report.EndCase();
+    }
+}
+
+// =================================================================================================
+// BenchHidProgram          caps path against the compiled DS4 descriptor on the same USB reports:
+//                          time per report of each and the reports whose pad input differs
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchHidProgram(CBenchReport& report, const char* source, const std::vector<unsigned char>& reports)
+{
+    size_t count = reports.size() / SYNTHETIC_REPORT_SIZE;
+    SHidDeviceDescriptor capsDescriptor = BuildCapsDescriptor();
+    SHidDeviceDescriptor programDescriptor = BuildProgramDescriptor();
+
+    uint64_t mismatches = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        JSDATA caps;
+        JSDATA program;
+        DecodeCapsReport(capsDescriptor, &reports[i * SYNTHETIC_REPORT_SIZE], SYNTHETIC_REPORT_SIZE, caps);
+        DecodeReportProgram(programDescriptor, &reports[i * SYNTHETIC_REPORT_SIZE], SYNTHETIC_REPORT_SIZE, program);
+        mismatches += SamePadInput(caps, program) ? 0 : 1;
+    }
+
+    double nsPerReport[2] = { 0.0, 0.0 };
+    uint64_t checksum = 0;
+    int iterations = count != 0 ? DECODE_ITERATIONS : 0;
+    for (int path = 0; path < 2 && count != 0; path++)
+    {
+        JSDATA jsData;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            const unsigned char* raw = &reports[(i % count) * SYNTHETIC_REPORT_SIZE];
+            if (path == 0)
+            {
+                DecodeCapsReport(capsDescriptor, raw, SYNTHETIC_REPORT_SIZE, jsData);
+            }
+            else
+            {
+                DecodeReportProgram(programDescriptor, raw, SYNTHETIC_REPORT_SIZE, jsData);
+            }
+            checksum += jsData.leftX + jsData.HandlePressed[i % BUTTONS_NUM];
+        }
+        nsPerReport[path] = ElapsedNs(start) / iterations;
+    }
+
+    report.BeginCase("hid_program");
+    report.Field("source", source);
+    report.Field("reports", (uint64_t)count);
+    report.Field("ops", (uint64_t)programDescriptor.reportProgram.ops.size());
+    report.Field("caps_ns_per_report", nsPerReport[0]);
+    report.Field("program_ns_per_report", nsPerReport[1]);
+    report.Field("mismatches", mismatches);
+    report.Field("checksum", checksum);
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchHidProgramReplay    the DS4 USB reports of a capture through BenchHidProgram
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool BenchHidProgramReplay(CBenchReport& report, const char* path)
+{
+    CCaptureReader reader;
+    if (!reader.Open(path))
+    {
+        return false;
+    }
+
+    // Capture device IDs count arrivals from 1
+    std::vector<EReportDecoder> decoders;
+    std::vector<unsigned char> reports;
+    SCaptureRecordView record;
+    while (reader.Next(record))
+    {
+        if (record.type == CAPTURE_RECORD_DEVICE_ARRIVED && record.length >= sizeof(SCaptureDevice))
+        {
+            SCaptureDevice device;
+            std::memcpy(&device, record.payload, sizeof(device));
+            if (decoders.size() < record.deviceId)
+            {
+                decoders.resize(record.deviceId, DECODER_GENERIC);
+            }
+            decoders[record.deviceId - 1] = SelectReportDecoder(device.vendorId, device.productId);
+        }
+        else if (record.type == CAPTURE_RECORD_REPORT && record.deviceId != 0 && record.deviceId <= decoders.size() &&
+                 decoders[record.deviceId - 1] == DECODER_DS4 && record.length == SYNTHETIC_REPORT_SIZE &&
+                 record.payload[0] == DS4_USB_REPORT_ID)
+        {
+            reports.insert(reports.end(), record.payload, record.payload + record.length);
+        }
+    }
+
+    BenchHidProgram(report, path, reports);
+    return true;
+}
+
+// =================================================================================================
+// NextFuzzValue            xorshift32, the same sequence on every run
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t NextFuzzValue(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// =================================================================================================
+// BenchHidDescriptorFuzz   malformed descriptors through the compiler: the DS4 descriptor with
+//                          bits flipped, bytes replaced, cut short or a slice repeated, and random
+//                          bytes. Accepted programs are checked and run on reports of random
+//                          length, each in a buffer of exactly that size for the sanitizers.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchHidDescriptorFuzz(CBenchReport& report)
+{
+    uint32_t random = 0x9E3779B9u;
+    uint64_t accepted = 0;
+    uint64_t withOps = 0;
+    uint64_t violations = 0;
+    uint64_t decoded = 0;
+    size_t maxOps = 0;
+    std::vector<unsigned char> descriptor;
+    SHidReportProgram program;
+    JSDATA jsData;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < HID_FUZZ_ITERATIONS; i++)
+    {
+        descriptor.assign(DS4_USB_REPORT_DESCRIPTOR, DS4_USB_REPORT_DESCRIPTOR + DS4_USB_REPORT_DESCRIPTOR_SIZE);
+        uint32_t mutation = NextFuzzValue(random) % 5;
+        switch (mutation)
+        {
+            case 0:
+                for (uint32_t flips = 1 + NextFuzzValue(random) % 4; flips != 0; flips--)
+                {
+                    uint32_t bit = NextFuzzValue(random) % (uint32_t)(descriptor.size() * 8);
+                    descriptor[bit / 8] ^= (unsigned char)(1u << (bit % 8));
+                }
+                break;
+            case 1:
+                for (uint32_t bytes = 1 + NextFuzzValue(random) % 4; bytes != 0; bytes--)
+                {
+                    descriptor[NextFuzzValue(random) % descriptor.size()] = (unsigned char)NextFuzzValue(random);
+                }
+                break;
+            case 2:
+                descriptor.resize(NextFuzzValue(random) % descriptor.size());
+                break;
+            case 3:
+            {
+                size_t first = NextFuzzValue(random) % descriptor.size();
+                size_t sliceLength = 1 + NextFuzzValue(random) % 8;
+                sliceLength = std::min(sliceLength, descriptor.size() - first);
+                std::vector<unsigned char> slice(descriptor.begin() + first, descriptor.begin() + first + sliceLength);
+                for (uint32_t repeats = 1 + NextFuzzValue(random) % 64; repeats != 0; repeats--)
+                {
+                    descriptor.insert(descriptor.begin() + first, slice.begin(), slice.end());
+                }
+                break;
+            }
+            default:
+                descriptor.resize(NextFuzzValue(random) % HID_FUZZ_MAX_RANDOM_SIZE);
+                for (unsigned char& c : descriptor)
+                {
+                    c = (unsigned char)NextFuzzValue(random);
+                }
+                break;
+        }
+
+        if (!CompileHidReportDescriptor(descriptor.data(), descriptor.size(), program))
+        {
+            violations += program.ops.empty() && program.reports.empty() ? 0 : 1;
+            continue;
+        }
+        accepted++;
+        violations += CheckHidProgram(program) ? 0 : 1;
+        if (program.ops.empty())
+        {
+            continue;
+        }
+        withOps++;
+        maxOps = std::max(maxOps, program.ops.size());
+
+        for (int run = 0; run < HID_FUZZ_REPORTS; run++)
+        {
+            std::vector<unsigned char> input(NextFuzzValue(random) % HID_FUZZ_MAX_REPORT_SIZE);
+            for (unsigned char& c : input)
+            {
+                c = (unsigned char)NextFuzzValue(random);
+            }
+            if (!input.empty() && program.numbered)
+            {
+                input[0] = program.reports[NextFuzzValue(random) % program.reports.size()].reportId;
+            }
+            decoded += RunHidReportProgram(program, input.data(), input.size(), jsData) ? 1 : 0;
+        }
+    }
+    double elapsedNs = ElapsedNs(start);
+
+    report.BeginCase("hid_descriptor_fuzz");
+    report.Field("iterations", (uint64_t)HID_FUZZ_ITERATIONS);
+    report.Field("accepted", accepted);
+    report.Field("rejected", (uint64_t)HID_FUZZ_ITERATIONS - accepted);
+    report.Field("with_ops", withOps);
+    report.Field("max_ops", (uint64_t)maxOps);
+    report.Field("reports_decoded", decoded);
+    report.Field("invariant_violations", violations);
+    report.Field("ns_per_iteration", elapsedNs / HID_FUZZ_ITERATIONS);
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchStats               what the core adds per report when statistics are compiled in: the
+//                          report and delivery counters, plus the clock read and histogram record
+//                          of every STATS_LATENCY_SAMPLE_INTERVAL-th sample
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchStats(CBenchReport& report)
+{
+    std::unique_ptr<CJoystickStats> stats(new CJoystickStats);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < STATS_ITERATIONS; i++)
+    {
+        int playerIndex = i & 3;
+        stats->OnReport(playerIndex, true);
+        if (stats->OnDelivered(playerIndex))
+        {
+            stats->RecordLatency(playerIndex, MonotonicNowNs() & 0xFFFF);
+        }
+    }
+    double elapsedNs = ElapsedNs(start);
+
+    std::unique_ptr<SJoystickStatsSnapshot> snapshot(new SJoystickStatsSnapshot);
+    start = std::chrono::steady_clock::now();
+    stats->Snapshot(*snapshot);
+    double snapshotNs = ElapsedNs(start);
+
+    report.BeginCase("stats");
+    report.Field("iterations", (uint64_t)STATS_ITERATIONS);
+    report.Field("ns_per_report", elapsedNs / STATS_ITERATIONS);
+    report.Field("latency_sample_interval", STATS_LATENCY_SAMPLE_INTERVAL);
+    report.Field("latency_samples", snapshot->devices[0].latency.total);
+    report.Field("snapshot_ns", snapshotNs);
+    report.EndCase();
+}
+
+// =================================================================================================
+// MeasureQueueThroughput   items per second through a CSpscRing from one thread to another; the
+//                          producer yields while the ring is full so nothing is dropped, and
+//                          both yield so a single core still makes progress
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+static double MeasureQueueThroughput(const T& item, uint64_t& received)
+{
+    CSpscRing<T> queue(STATE_QUEUE_CAPACITY, RING_COUNT_DROPS);
+    received = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&queue, &received]()
+    {
+        T popped;
+        while (received < STATE_QUEUE_ITEMS)
+        {
+            if (queue.TryPop(popped))
+            {
+                received++;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (uint64_t i = 0; i < STATE_QUEUE_ITEMS; i++)
+    {
+        while (!queue.Push(item))
+        {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    return STATE_QUEUE_ITEMS * 1e9 / ElapsedNs(start);
+}
+
+// =================================================================================================
+// BenchStateLayout         SJoystickSample (JSDATA inside) against SPadState for the same reports
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchStateLayout(CBenchReport& report)
+{
+    std::vector<SJoystickSample> samples(STATE_ARRAY_SIZE);
+    std::vector<SPadState> states(STATE_ARRAY_SIZE);
+    for (size_t i = 0; i < STATE_ARRAY_SIZE; i++)
+    {
+        unsigned char raw[SYNTHETIC_REPORT_SIZE];
+        CSyntheticInputSource::BuildReport(0, (uint64_t)i * 37, raw);
+        samples[i].timestampNs = i;
+        samples[i].sequence = i;
+        samples[i].playerIndex = 0;
+        DecodeDs4UsbReport(raw, sizeof(raw), samples[i].data);
+        PadStateFromSample(samples[i], states[i]);
+    }
+
+    const char* layouts[] = { "jsdata", "pad_state" };
+    const size_t sizes[] = { sizeof(SJoystickSample), sizeof(SPadState) };
+
+    // Copy every element of an array into a second one, as a consumer snapshotting all pads does
+    for (int packed = 0; packed < 2; packed++)
+    {
+        std::vector<SJoystickSample> sampleCopies(STATE_ARRAY_SIZE);
+        std::vector<SPadState> stateCopies(STATE_ARRAY_SIZE);
+        uint64_t checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < STATE_ITERATIONS; i++)
+        {
+            size_t index = (size_t)i % STATE_ARRAY_SIZE;
+            if (packed)
+            {
+                stateCopies[index] = states[index];
+                checksum += stateCopies[index].leftX;
+            }
+            else
+            {
+                sampleCopies[index] = samples[index];
+                checksum += sampleCopies[index].data.leftX;
+            }
+        }
+        double elapsedNs = ElapsedNs(start);
+
+        report.BeginCase("state_copy");
+        report.Field("layout", layouts[packed]);
+        report.Field("bytes", (uint64_t)sizes[packed]);
+        report.Field("ns_per_copy", elapsedNs / STATE_ITERATIONS);
+        report.Field("checksum", checksum);
+        report.EndCase();
+    }
+
+    // The legacy callback takes JSDATA by value, the packed one a reference
+    for (int packed = 0; packed < 2; packed++)
+    {
+        uint64_t checksum = 0;
+        std::function<void(int, JSDATA)> legacyCallback = [&checksum](int, JSDATA jsData) { checksum += jsData.leftX; };
+        std::function<void(const SPadState&)> stateCallback = [&checksum](const SPadState& state) { checksum += state.leftX; };
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < STATE_ITERATIONS; i++)
+        {
+            size_t index = (size_t)i % STATE_ARRAY_SIZE;
+            if (packed)
+            {
+                stateCallback(states[index]);
+            }
+            else
+            {
+                legacyCallback(samples[index].playerIndex, samples[index].data);
+            }
+        }
+        double elapsedNs = ElapsedNs(start);
+
+        report.BeginCase("state_callback");
+        report.Field("layout", layouts[packed]);
+        report.Field("ns_per_call", elapsedNs / STATE_ITERATIONS);
+        report.Field("checksum", checksum);
+        report.EndCase();
+    }
+
+    for (int packed = 0; packed < 2; packed++)
+    {
+        uint64_t received = 0;
+        double itemsPerSecond = packed ? MeasureQueueThroughput(states[1], received) : MeasureQueueThroughput(samples[1], received);
+
+        report.BeginCase("state_queue");
+        report.Field("layout", layouts[packed]);
+        report.Field("items", received);
+        report.Field("items_per_s", itemsPerSecond);
+        report.EndCase();
+    }
+
+    // Pressed/released buttons between consecutive states: bool arrays compared one by one
+    // against one XOR of the masks
+    for (int packed = 0; packed < 2; packed++)
+    {
+        uint64_t pressedCount = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 1; i < STATE_ITERATIONS; i++)
+        {
+            size_t index = (size_t)i % STATE_ARRAY_SIZE;
+            size_t previous = (size_t)(i - 1) % STATE_ARRAY_SIZE;
+            if (packed)
+            {
+                SPadEdges edges = GetPadEdges(states[previous].buttons, states[index].buttons);
+                pressedCount += CountLines(edges.pressed);
+            }
+            else
+            {
+                const JSDATA& before = samples[previous].data;
+                const JSDATA& after = samples[index].data;
+                for (int button = 0; button < BUTTONS_NUM; button++)
+                {
+                    pressedCount += after.HandlePressed[button] && !before.HandlePressed[button];
+                }
+            }
+        }
+        double elapsedNs = ElapsedNs(start);
+
+        report.BeginCase("state_edges");
+        report.Field("layout", layouts[packed]);
+        report.Field("ns_per_state", elapsedNs / STATE_ITERATIONS);
+        report.Field("pressed", pressedCount);
+        report.EndCase();
+    }
+}
+
+// =================================================================================================
+// BenchMotion              the motion part of a DS4 report: decoding it with the rest of the pad
+//                          state, calibrating the six channels with SSE2 and one by one, and
+//                          unwrapping the sensor clock
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchMotion(CBenchReport& report)
+{
+    std::vector<std::vector<unsigned char>> reports(DECODE_DISTINCT_REPORTS, std::vector<unsigned char>(SYNTHETIC_REPORT_SIZE));
+    std::vector<SPadState> states(DECODE_DISTINCT_REPORTS);
+    for (int i = 0; i < DECODE_DISTINCT_REPORTS; i++)
+    {
+        CSyntheticInputSource::BuildReport(0, (uint64_t)i * 37, reports[i].data());
+        DecodeDs4UsbPadState(reports[i].data(), SYNTHETIC_REPORT_SIZE, states[i]);
+    }
+
+    SPadState state = SPadState();
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < MOTION_ITERATIONS; i++)
+    {
+        const std::vector<unsigned char>& raw = reports[i % DECODE_DISTINCT_REPORTS];
+        DecodeDs4UsbPadState(raw.data(), raw.size(), state);
+        checksum += (uint16_t)state.gyro[1] + state.flags;
+    }
+    double elapsedNs = ElapsedNs(start);
+
+    report.BeginCase("motion_decode");
+    report.Field("ns_per_report", elapsedNs / MOTION_ITERATIONS);
+    report.Field("checksum", checksum);
+    report.EndCase();
+
+    // A calibration with non-trivial bias so neither path can skip the subtraction
+    SImuCalibration calibration;
+    SetDefaultImuCalibration(calibration);
+    for (int i = 0; i < IMU_CHANNELS; i++)
+    {
+        calibration.bias[i] = (float)(i * 3 - 7);
+    }
+
+    const char* paths[] = { "sse2", "scalar" };
+    for (int scalar = 0; scalar < 2; scalar++)
+    {
+        SMotionSample motion = SMotionSample();
+        double sum = 0.0;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < MOTION_ITERATIONS; i++)
+        {
+            const SPadState& input = states[i % DECODE_DISTINCT_REPORTS];
+            if (scalar)
+            {
+                ConvertPadMotionScalar(calibration, input, motion);
+            }
+            else
+            {
+                ConvertPadMotion(calibration, input, motion);
+            }
+            sum += motion.gyroDps[1] + motion.accelG[0];
+        }
+        elapsedNs = ElapsedNs(start);
+
+        report.BeginCase("motion_convert");
+        report.Field("path", paths[scalar]);
+        report.Field("ns_per_sample", elapsedNs / MOTION_ITERATIONS);
+        report.Field("checksum", sum);
+        report.EndCase();
+    }
+
+    CSensorClock clock;
+    uint64_t ticks = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < MOTION_ITERATIONS; i++)
+    {
+        uint64_t deltaTicks;
+        ticks = clock.Unwrap((uint16_t)(i * 188), (uint64_t)i * 1000000, deltaTicks);
+    }
+    elapsedNs = ElapsedNs(start);
+
+    report.BeginCase("sensor_clock");
+    report.Field("ns_per_unwrap", elapsedNs / MOTION_ITERATIONS);
+    report.Field("sensor_seconds", CSensorClock::TicksToNs(ticks) * 1e-9);
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchAxes                reports per second of every axis kernel the CPU runs, batch by batch,
+//                          and how far each one lands from the scalar reference
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchAxes(CBenchReport& report)
+{
+    // Every feature switched on: radial and axial deadzones, anti-deadzone, curves and inversion
+    SAxisConfig config;
+    config.rightStick = DEADZONE_AXIAL;
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        config.axes[axis].deadzone = 0.08f;
+        config.axes[axis].outerDeadzone = 0.95f;
+        config.axes[axis].antiDeadzone = 0.05f;
+        config.axes[axis].curveExponent = 1.5f;
+    }
+    config.axes[AXIS_LEFT_Y].invert = true;
+    config.axes[AXIS_RIGHT_Y].invert = true;
+    config.axes[AXIS_R2].curvePoints = { 0.0f, 0.5f, 0.8f, 1.0f };
+
+    std::unique_ptr<SAxisProcessor> processor(new SAxisProcessor);
+    BuildAxisProcessor(config, *processor);
+
+    size_t largestBatch = AXIS_BATCH_SIZES[sizeof(AXIS_BATCH_SIZES) / sizeof(AXIS_BATCH_SIZES[0]) - 1];
+    std::vector<SPadState> states(largestBatch);
+    for (size_t i = 0; i < largestBatch; i++)
+    {
+        unsigned char raw[SYNTHETIC_REPORT_SIZE];
+        CSyntheticInputSource::BuildReport((int)(i & 3), (uint64_t)i * 7, raw);
+        DecodeDs4UsbPadState(raw, sizeof(raw), states[i]);
+    }
+
+    std::vector<SAxisOutput> reference(largestBatch);
+    GetAxisKernel(AXIS_KERNEL_SCALAR)(*processor, states.data(), largestBatch, reference.data());
+
+    const char* kernelNames[] = { "scalar", "sse2", "avx2" };
+    std::vector<SAxisOutput> outputs(largestBatch);
+    for (int kernel = 0; kernel < AXIS_KERNEL_COUNT; kernel++)
+    {
+        PFN_AXIS_KERNEL processAxes = GetAxisKernel((EAxisKernel)kernel);
+        if (processAxes == nullptr)
+        {
+            continue;
+        }
+
+        processAxes(*processor, states.data(), largestBatch, outputs.data());
+        double maxDifference = 0.0;
+        for (size_t i = 0; i < largestBatch; i++)
+        {
+            for (int lane = 0; lane < AXIS_LANES; lane++)
+            {
+                maxDifference = std::max(maxDifference, (double)std::fabs(outputs[i].values[lane] - reference[i].values[lane]));
+            }
+        }
+
+        for (size_t batchSize : AXIS_BATCH_SIZES)
+        {
+            size_t batches = AXIS_REPORTS / batchSize;
+            double checksum = 0.0;
+
+            auto start = std::chrono::steady_clock::now();
+            for (size_t batch = 0; batch < batches; batch++)
+            {
+                size_t first = (batch * batchSize) % largestBatch;
+                processAxes(*processor, states.data() + first, batchSize, outputs.data() + first);
+                checksum += outputs[first].values[AXIS_LEFT_X];
+            }
+            double elapsedNs = ElapsedNs(start);
+
+            report.BeginCase("axes");
+            report.Field("kernel", kernelNames[kernel]);
+            report.Field("batch", (uint64_t)batchSize);
+            report.Field("ns_per_report", elapsedNs / (double)(batches * batchSize));
+            report.Field("reports_per_s", (double)(batches * batchSize) * 1e9 / elapsedNs);
+            report.Field("max_abs_diff_vs_scalar", maxDifference);
+            report.Field("checksum", checksum);
+            report.EndCase();
+        }
+    }
+}
+
+// =================================================================================================
+// BenchFilters             one filter pass per report and pad, every channel filtered the same way
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchFilters(CBenchReport& report)
+{
+    const char* typeNames[] = { "none", "exponential", "one_euro", "kalman" };
+
+    for (int type = FILTER_NONE; type <= FILTER_KALMAN; type++)
+    {
+        SFilterConfig config;
+        for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+        {
+            config.channels[channel].type = (EFilterType)type;
+            config.channels[channel].beta = 0.5f;
+            config.channels[channel].predictionMs = 8.0f;
+        }
+
+        for (int pads : FILTER_PADS)
+        {
+            std::unique_ptr<CInputFilterBank> filters(new CInputFilterBank);
+            filters->Configure(config);
+
+            float values[FILTER_CHANNELS] = {};
+            float predicted[FILTER_CHANNELS];
+            SFilteredState state;
+            double checksum = 0.0;
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < FILTER_ITERATIONS; i++)
+            {
+                uint64_t timestampNs = (uint64_t)i * 1000000;
+                for (int pad = 0; pad < pads; pad++)
+                {
+                    values[FILTER_LEFT_X] = (float)((i + pad * 17) & 0xFF) * (1.0f / 128.0f) - 1.0f;
+                    values[FILTER_GYRO_YAW] = (float)(i & 0x3F);
+                    filters->Submit(pad, values, timestampNs);
+                }
+                filters->Update();
+
+                filters->GetState(0, state);
+                filters->Predict(state, timestampNs + 4000000, predicted);
+                checksum += predicted[FILTER_LEFT_X];
+            }
+            double elapsedNs = ElapsedNs(start);
+
+            report.BeginCase("filter");
+            report.Field("type", typeNames[type]);
+            report.Field("pads", (uint64_t)pads);
+            report.Field("channels", (uint64_t)FILTER_CHANNELS);
+            report.Field("ns_per_report", elapsedNs / ((double)FILTER_ITERATIONS * pads));
+            report.Field("ns_per_pass", elapsedNs / FILTER_ITERATIONS);
+            report.Field("checksum", checksum);
+            report.EndCase();
+        }
+    }
+}
+
+// =================================================================================================
+// LoadCapturePadStates     the reports of every device of a capture, decoded offline into pad
+//                          states stamped with the recording time
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool LoadCapturePadStates(const char* path, std::vector<std::vector<SPadState>>& devices)
+{
+    CCaptureReader reader;
+    if (!reader.Open(path))
+    {
+        return false;
+    }
+
+    // Capture device IDs count arrivals from 1
+    std::vector<EReportDecoder> decoders;
+    std::vector<SPadState> states;
+    devices.clear();
+
+    SCaptureRecordView record;
+    while (reader.Next(record))
+    {
+        if (record.type == CAPTURE_RECORD_DEVICE_ARRIVED && record.length >= sizeof(SCaptureDevice))
+        {
+            SCaptureDevice device;
+            std::memcpy(&device, record.payload, sizeof(device));
+            if (decoders.size() < record.deviceId)
+            {
+                decoders.resize(record.deviceId, DECODER_GENERIC);
+                states.resize(record.deviceId);
+                devices.resize(record.deviceId);
+            }
+            decoders[record.deviceId - 1] = SelectReportDecoder(device.vendorId, device.productId);
+            continue;
+        }
+        if (record.deviceId == 0 || record.deviceId > decoders.size())
+        {
+            continue;
+        }
+
+        SPadState& state = states[record.deviceId - 1];
+        if (record.type == CAPTURE_RECORD_REPORT && record.length > 0)
+        {
+            // Reports of the generic path need the platform parser and are left out
+            PFN_PAD_STATE_DECODER decodePadState = GetPadStateDecoder(decoders[record.deviceId - 1], record.payload[0]);
+            if (decodePadState == nullptr || !decodePadState(record.payload, record.length, state))
+            {
+                continue;
+            }
+        }
+        else if (record.type == CAPTURE_RECORD_STATE && record.length >= sizeof(SCaptureState))
+        {
+            SCaptureState captured;
+            std::memcpy(&captured, record.payload, sizeof(captured));
+            JSDATA jsData;
+            UnpackCaptureState(captured, jsData);
+            PadStateFromJsData(jsData, state);
+            state.flags = 0;
+        }
+        else
+        {
+            continue;
+        }
+
+        state.timestampNs = record.timestampNs;
+        devices[record.deviceId - 1].push_back(state);
+    }
+    return true;
+}
+
+// =================================================================================================
+// LoadFilterInputs         the pad states of a capture turned into filter input with the default
+//                          axis configuration and nominal IMU scales (captures carry no calibration)
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool LoadFilterInputs(const char* path, std::vector<std::vector<SFilterInput>>& devices)
+{
+    std::vector<std::vector<SPadState>> states;
+    if (!LoadCapturePadStates(path, states))
+    {
+        return false;
+    }
+
+    std::unique_ptr<SAxisProcessor> axisProcessor(new SAxisProcessor);
+    BuildAxisProcessor(SAxisConfig(), *axisProcessor);
+    SImuCalibration calibration;
+    SetDefaultImuCalibration(calibration);
+
+    devices.assign(states.size(), std::vector<SFilterInput>());
+    for (size_t device = 0; device < states.size(); device++)
+    {
+        for (const SPadState& state : states[device])
+        {
+            SFilterInput input = SFilterInput();
+            input.timestampNs = state.timestampNs;
+            SAxisOutput axes;
+            ProcessAxes(*axisProcessor, &state, 1, &axes);
+            for (int axis = 0; axis < AXIS_COUNT; axis++)
+            {
+                input.values[FILTER_LEFT_X + axis] = axes.values[axis];
+            }
+            if (state.flags & PAD_FLAG_MOTION)
+            {
+                SMotionSample motion;
+                ConvertPadMotion(calibration, state, motion);
+                for (int i = 0; i < 3; i++)
+                {
+                    input.values[FILTER_GYRO_PITCH + i] = motion.gyroDps[i];
+                    input.values[FILTER_ACCEL_X + i] = motion.accelG[i];
+                }
+            }
+            devices[device].push_back(input);
+        }
+    }
+    return true;
+}
+
+// =================================================================================================
+// SecondDifferenceRms      jitter: the RMS of x[n] - 2 x[n-1] + x[n-2], what a still hand shows
+//                          as shake and a moving one as roughness
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static double SecondDifferenceRms(const std::vector<float>& signal)
+{
+    if (signal.size() < 3)
+    {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for (size_t n = 2; n < signal.size(); n++)
+    {
+        double difference = (double)signal[n] - 2.0 * signal[n - 1] + signal[n - 2];
+        sum += difference * difference;
+    }
+    return std::sqrt(sum / (double)(signal.size() - 2));
+}
+
+// =================================================================================================
+// BenchFilterEval          latency against jitter of each preset on recorded input. The output at
+//                          report n is the filter's estimate for the time the consumer shows it,
+//                          the report time plus the prediction horizon. Its lag is that horizon
+//                          minus the shift that best lines it up with the input.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool BenchFilterEval(CBenchReport& report, const char* path)
+{
+    std::vector<std::vector<SFilterInput>> devices;
+    if (!LoadFilterInputs(path, devices))
+    {
+        std::fprintf(stderr, "cannot read %s\n", path);
+        return false;
+    }
+
+    SFilterPreset presets[7];
+    presets[0].name = "none";
+    presets[1].name = "exponential_0.5";
+    presets[1].settings.type = FILTER_EXPONENTIAL;
+    presets[1].settings.smoothing = 0.5f;
+    presets[2].name = "exponential_0.2";
+    presets[2].settings.type = FILTER_EXPONENTIAL;
+    presets[2].settings.smoothing = 0.2f;
+    presets[3].name = "one_euro";
+    presets[3].settings.type = FILTER_ONE_EURO;
+    presets[3].settings.minCutoffHz = 1.0f;
+    presets[3].settings.beta = 1.0f;
+    presets[4].name = "one_euro_predict_8ms";
+    presets[4].settings = presets[3].settings;
+    presets[4].settings.predictionMs = 8.0f;
+    presets[5].name = "kalman";
+    presets[5].settings.type = FILTER_KALMAN;
+    presets[6].name = "kalman_predict_8ms";
+    presets[6].settings = presets[5].settings;
+    presets[6].settings.predictionMs = 8.0f;
+
+    const int channels[] = { FILTER_LEFT_X, FILTER_GYRO_YAW };
+    const char* channelNames[] = { "left_x", "gyro_yaw" };
+
+    for (size_t device = 0; device < devices.size() && device < (size_t)MAX_CONTROLLERS; device++)
+    {
+        const std::vector<SFilterInput>& inputs = devices[device];
+        if (inputs.size() < 2 * FILTER_EVAL_MAX_SHIFT)
+        {
+            continue;
+        }
+        double intervalMs = (double)(inputs.back().timestampNs - inputs.front().timestampNs) * 1e-6 / (double)(inputs.size() - 1);
+
+        for (const SFilterPreset& preset : presets)
+        {
+            SFilterConfig config;
+            for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+            {
+                config.channels[channel] = preset.settings;
+            }
+            std::unique_ptr<CInputFilterBank> filters(new CInputFilterBank);
+            filters->Configure(config);
+
+            std::vector<std::vector<float>> raw(2), output(2);
+            uint64_t horizonNs = (uint64_t)(preset.settings.predictionMs * 1e6f);
+            for (const SFilterInput& input : inputs)
+            {
+                filters->Submit(0, input.values, input.timestampNs);
+                filters->Update();
+
+                SFilteredState state;
+                float predicted[FILTER_CHANNELS];
+                filters->GetState(0, state);
+                filters->Predict(state, input.timestampNs + horizonNs, predicted);
+                for (int c = 0; c < 2; c++)
+                {
+                    raw[c].push_back(input.values[channels[c]]);
+                    output[c].push_back(predicted[channels[c]]);
+                }
+            }
+
+            for (int c = 0; c < 2; c++)
+            {
+                // Shift s lines output[n] up with raw[n + s]
+                int bestShift = 0;
+                double bestError = -1.0;
+                size_t count = raw[c].size();
+                for (int shift = -FILTER_EVAL_MAX_SHIFT; shift <= FILTER_EVAL_MAX_SHIFT; shift++)
+                {
+                    double error = 0.0;
+                    for (size_t n = FILTER_EVAL_MAX_SHIFT; n + FILTER_EVAL_MAX_SHIFT < count; n++)
+                    {
+                        error += std::fabs((double)output[c][n] - raw[c][n + shift]);
+                    }
+                    if (bestError < 0.0 || error < bestError)
+                    {
+                        bestError = error;
+                        bestShift = shift;
+                    }
+                }
+
+                double squaredError = 0.0;
+                for (size_t n = 0; n < count; n++)
+                {
+                    double difference = (double)output[c][n] - raw[c][n];
+                    squaredError += difference * difference;
+                }
+
+                report.BeginCase("filter_eval");
+                report.Field("capture", path);
+                report.Field("device", (uint64_t)device);
+                report.Field("channel", channelNames[c]);
+                report.Field("preset", preset.name);
+                report.Field("reports", (uint64_t)count);
+                report.Field("lag_ms", preset.settings.predictionMs - bestShift * intervalMs);
+                report.Field("jitter", SecondDifferenceRms(output[c]));
+                report.Field("input_jitter", SecondDifferenceRms(raw[c]));
+                report.Field("rms_error", std::sqrt(squaredError / (double)count));
+                report.EndCase();
+            }
+        }
+    }
+    return true;
+}
+
+// =================================================================================================
+// AttachEventConsumer      legacy: a callback per report that diffs its JSDATA copy against the
+//                          last one, what our consumers do today. events: one subscription to
+//                          every button, the hat and every axis.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void AttachEventConsumer(CJoystickCore& core, int consumer, SEventCounts& counts, JSDATA& previous)
+{
+    counts = SEventCounts();
+    previous = JSDATA();
+
+    if (consumer == 1)
+    {
+        core.SetCallback([&counts, &previous](int, JSDATA jsData)
+        {
+            counts.callbacks++;
+            if (std::memcmp(&jsData, &previous, sizeof(JSDATA)) != 0)
+            {
+                counts.changes++;
+                previous = jsData;
+            }
+        });
+    }
+    else if (consumer == 2)
+    {
+        SPadEventSubscription subscription;
+        subscription.buttons = PAD_EVENT_ALL_BUTTONS;
+        subscription.axes = PAD_EVENT_ALL_AXES;
+        subscription.hat = true;
+        subscription.callback = [&counts](const SPadEvent* pEvents, size_t count)
+        {
+            (void)pEvents;
+            counts.callbacks++;
+            counts.changes++;
+            counts.events += count;
+        };
+        core.SubscribeEvents(subscription);
+    }
+}
+
+// =================================================================================================
+// ReportEventCase
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ReportEventCase(CBenchReport& report, int consumer, const SEventCounts& counts, uint64_t reports,
+                            double seconds, double elapsedNs, double baselineNs)
+{
+    report.Field("consumer", EVENT_CONSUMERS[consumer]);
+    report.Field("reports", reports);
+    report.Field("callbacks", counts.callbacks);
+    report.Field("changes", counts.changes);
+    report.Field("events", counts.events);
+    report.Field("callbacks_per_second", seconds > 0.0 ? counts.callbacks / seconds : 0.0);
+    report.Field("ns_per_report", reports ? elapsedNs / reports : 0.0);
+    // What the consumer side adds over a core nobody listens to, per report and per second of input
+    double consumerNs = reports && elapsedNs > baselineNs ? (elapsedNs - baselineNs) / reports : 0.0;
+    report.Field("consumer_ns_per_report", consumerNs);
+    report.Field("consumer_ns_per_second", seconds > 0.0 ? consumerNs * reports / seconds : 0.0);
+    report.EndCase();
+}
+
+// =================================================================================================
+// RunEventStream           the reports through a fresh core with the given consumer; returns the
+//                          elapsed ns
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static double RunEventStream(const std::vector<unsigned char>& reports, int consumer, SEventCounts& counts)
+{
+    CJoystickCore core;
+    JSDATA previous;
+    AttachEventConsumer(core, consumer, counts, previous);
+
+    SHidDeviceDescriptor descriptor = BuildCapsDescriptor();
+    descriptor.vendorId = SONY_VENDOR_ID;
+    int deviceKey = 0;
+    core.OnDeviceArrived(&deviceKey, 1, std::move(descriptor));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < EVENT_REPORTS; i++)
+    {
+        const unsigned char* raw = &reports[(i % DECODE_DISTINCT_REPORTS) * SYNTHETIC_REPORT_SIZE];
+        core.OnReport(&deviceKey, raw, SYNTHETIC_REPORT_SIZE, (uint64_t)i);
+    }
+    return ElapsedNs(start);
+}
+
+// =================================================================================================
+// RunEventReplay           a capture through a fresh core with the given consumer, as fast as it
+//                          decodes; returns the elapsed ns, negative when it cannot be replayed
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static double RunEventReplay(const char* path, int consumer, SEventCounts& counts, uint64_t& reports)
+{
+    CJoystickCore core;
+    JSDATA previous;
+    AttachEventConsumer(core, consumer, counts, previous);
+
+    CReplaySource source(path, REPLAY_SPEED_UNLIMITED);
+    if (!source.Open(&core))
+    {
+        return -1.0;
+    }
+
+    reports = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (!source.IsFinished())
+    {
+        int handled = source.Poll(0);
+        if (handled < 0)
+        {
+            break;
+        }
+        reports += handled;
+    }
+    double elapsedNs = ElapsedNs(start);
+    source.Close();
+    return elapsedNs;
+}
+
+// =================================================================================================
+// BenchEvents              legacy per-report callbacks against change-driven events on a resting
+//                          pad, reports differing only in counter, clock and IMU with a rare
+//                          one-step stick wobble, and on the moving synthetic pad
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchEvents(CBenchReport& report)
+{
+    const char* streams[] = { "idle", "active" };
+    std::vector<unsigned char> reports(DECODE_DISTINCT_REPORTS * SYNTHETIC_REPORT_SIZE);
+
+    for (int active = 0; active < 2; active++)
+    {
+        for (int i = 0; i < DECODE_DISTINCT_REPORTS; i++)
+        {
+            unsigned char* raw = &reports[i * SYNTHETIC_REPORT_SIZE];
+            CSyntheticInputSource::BuildReport(0, active ? (uint64_t)i * 37 : (uint64_t)i, raw);
+            if (!active)
+            {
+                raw[1] = (unsigned char)(0x80 + ((i / EVENT_IDLE_NOISE_PERIOD) & 1));
+                raw[2] = raw[3] = raw[4] = 0x80;
+                raw[5] = PAD_HAT_NEUTRAL;
+                raw[6] = 0;
+                raw[8] = raw[9] = 0;
+            }
+        }
+
+        // Consumers take turns so drift of the machine hits them alike
+        SEventCounts counts[3];
+        double elapsedNs[3] = { 0.0, 0.0, 0.0 };
+        for (int repeat = 0; repeat < EVENT_REPEATS; repeat++)
+        {
+            for (int consumer = 0; consumer < 3; consumer++)
+            {
+                double runNs = RunEventStream(reports, consumer, counts[consumer]);
+                elapsedNs[consumer] = repeat == 0 ? runNs : std::min(elapsedNs[consumer], runNs);
+            }
+        }
+
+        for (int consumer = 0; consumer < 3; consumer++)
+        {
+            report.BeginCase("events");
+            report.Field("stream", streams[active]);
+            ReportEventCase(report, consumer, counts[consumer], EVENT_REPORTS, (double)EVENT_REPORTS / EVENT_REPORT_RATE_HZ,
+                            elapsedNs[consumer], elapsedNs[0]);
+        }
+    }
+}
+
+// =================================================================================================
+// BenchEventReplay         the same comparison on a capture; rates are per second of the recording
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool BenchEventReplay(CBenchReport& report, const char* path)
+{
+    CCaptureReader reader;
+    if (!reader.Open(path))
+    {
+        std::fprintf(stderr, "cannot read %s\n", path);
+        return false;
+    }
+
+    uint64_t firstNs = 0;
+    uint64_t lastNs = 0;
+    SCaptureRecordView record;
+    while (reader.Next(record))
+    {
+        if (record.type == CAPTURE_RECORD_REPORT || record.type == CAPTURE_RECORD_STATE)
+        {
+            firstNs = firstNs != 0 ? firstNs : record.timestampNs;
+            lastNs = record.timestampNs;
+        }
+    }
+    double seconds = (double)(lastNs - firstNs) * 1e-9;
+
+    SEventCounts counts[3];
+    uint64_t reports = 0;
+    double elapsedNs[3] = { 0.0, 0.0, 0.0 };
+    for (int repeat = 0; repeat < EVENT_REPEATS; repeat++)
+    {
+        for (int consumer = 0; consumer < 3; consumer++)
+        {
+            double runNs = RunEventReplay(path, consumer, counts[consumer], reports);
+            if (runNs < 0.0)
+            {
+                std::fprintf(stderr, "cannot replay %s\n", path);
+                return false;
+            }
+            elapsedNs[consumer] = repeat == 0 ? runNs : std::min(elapsedNs[consumer], runNs);
+        }
+    }
+
+    for (int consumer = 0; consumer < 3; consumer++)
+    {
+        report.BeginCase("events_replay");
+        report.Field("capture", path);
+        ReportEventCase(report, consumer, counts[consumer], reports, seconds, elapsedNs[consumer], elapsedNs[0]);
+    }
+    return true;
+}
+
+// =================================================================================================
+// GenerateCombos           count random combos of one to COMBO_BENCH_MAX_STEPS steps: mostly
+//                          single buttons and hat directions, some chords, releases and holds, on
+//                          a handful of windows as games use
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<SComboDefinition> GenerateCombos(size_t count)
+{
+    static const uint16_t windowsMs[] = { 100, 150, 250, 500 };
+    static const uint16_t holdsMs[] = { 300, 500, 1000 };
+
+    uint32_t seed = 0x2545F491u;
+    std::vector<SComboDefinition> combos(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        combos[i].id = (uint32_t)i;
+        size_t steps = 1 + NextFuzzValue(seed) % COMBO_BENCH_MAX_STEPS;
+        for (size_t step = 0; step < steps; step++)
+        {
+            uint32_t kind = NextFuzzValue(seed) % 16;
+            uint32_t input = NextFuzzValue(seed) % (PAD_BUTTON_COUNT + PAD_HAT_NEUTRAL);
+            SComboStep comboStep = { input < PAD_BUTTON_COUNT ? ComboButton((EPadButton)input) : ComboHat((uint8_t)(input - PAD_BUTTON_COUNT)),
+                                     COMBO_STEP_PRESS, 0, windowsMs[NextFuzzValue(seed) % 4] };
+            if (kind == 0)
+            {
+                comboStep.inputs |= ComboButton((EPadButton)(NextFuzzValue(seed) % PAD_BUTTON_COUNT));
+            }
+            else if (kind == 1 && step > 0)
+            {
+                comboStep = combos[i].steps.back();
+                comboStep.kind = COMBO_STEP_RELEASE;
+                comboStep.minMs = 0;
+                comboStep.maxMs = windowsMs[NextFuzzValue(seed) % 4];
+            }
+            else if (kind == 2 && step > 0)
+            {
+                comboStep = combos[i].steps.back();
+                comboStep.kind = COMBO_STEP_HOLD;
+                comboStep.minMs = holdsMs[NextFuzzValue(seed) % 3];
+                comboStep.maxMs = 0;
+            }
+            combos[i].steps.push_back(comboStep);
+        }
+    }
+    return combos;
+}
+
+// =================================================================================================
+// BuildComboStream         a pad at 1 kHz; active: an input toggles or the hat moves on one report
+//                          in COMBO_BENCH_CHANGE_PERIOD on average, idle: nothing changes
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<SPadState> BuildComboStream(bool active)
+{
+    uint32_t seed = 0x9E3779B9u;
+    std::vector<SPadState> states(COMBO_BENCH_REPORTS);
+    SPadState state = SPadState();
+    state.hat = PAD_HAT_NEUTRAL;
+    for (size_t i = 0; i < states.size(); i++)
+    {
+        state.timestampNs = (uint64_t)i * 1000000;
+        state.sequence = (uint32_t)i;
+        if (active && NextFuzzValue(seed) % COMBO_BENCH_CHANGE_PERIOD == 0)
+        {
+            uint32_t input = NextFuzzValue(seed) % (PAD_BUTTON_COUNT + 4);
+            if (input < PAD_BUTTON_COUNT)
+            {
+                state.buttons ^= 1u << input;
+            }
+            else
+            {
+                state.hat = (uint8_t)(NextFuzzValue(seed) % (PAD_HAT_NEUTRAL + 1));
+            }
+        }
+        states[i] = state;
+    }
+    return states;
+}
+
+// =================================================================================================
+// RunComboStream           the states through the engine as one player; returns the elapsed ns
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static double RunComboStream(CPadComboEngine& engine, const std::vector<SPadState>& states, uint64_t& matches)
+{
+    matches = 0;
+    engine.Reset(0);
+    auto start = std::chrono::steady_clock::now();
+    for (const SPadState& state : states)
+    {
+        matches += engine.Process(0, state);
+    }
+    return ElapsedNs(start);
+}
+
+// =================================================================================================
+// CountInputChanges        reports whose buttons or hat differ from the report before
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint64_t CountInputChanges(const std::vector<SPadState>& states)
+{
+    uint64_t changes = 0;
+    for (size_t i = 1; i < states.size(); i++)
+    {
+        changes += states[i].buttons != states[i - 1].buttons || states[i].hat != states[i - 1].hat ? 1 : 0;
+    }
+    return changes;
+}
+
+// =================================================================================================
+// BenchCombos              random combos over a resting and a busy pad: ns per report against the
+//                          number of combos, and per report that changed an input
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchCombos(CBenchReport& report)
+{
+    const char* streams[] = { "idle", "active" };
+    for (int active = 0; active < 2; active++)
+    {
+        std::vector<SPadState> states = BuildComboStream(active != 0);
+        uint64_t changes = CountInputChanges(states);
+
+        for (size_t count : COMBO_BENCH_COUNTS)
+        {
+            std::vector<SComboDefinition> combos = GenerateCombos(count);
+            size_t steps = 0;
+            for (const SComboDefinition& combo : combos)
+            {
+                steps += combo.steps.size();
+            }
+
+            CPadComboEngine engine;
+            if (!engine.Compile(combos))
+            {
+                std::fprintf(stderr, "cannot compile %zu combos\n", count);
+                return;
+            }
+            uint64_t matches = 0;
+            double elapsedNs = RunComboStream(engine, states, matches);
+
+            report.BeginCase("combo");
+            report.Field("stream", streams[active]);
+            report.Field("combos", (uint64_t)count);
+            report.Field("steps", (uint64_t)steps);
+            report.Field("words", (uint64_t)((steps + 63) / 64));
+            report.Field("reports", (uint64_t)states.size());
+            report.Field("changed_reports", changes);
+            report.Field("matches", matches);
+            report.Field("ns_per_report", elapsedNs / states.size());
+            report.Field("ns_per_changed_report", changes ? elapsedNs / changes : 0.0);
+            report.EndCase();
+        }
+    }
+}
+
+// =================================================================================================
+// BenchComboReplay         every device of a capture against the most combos of BenchCombos
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool BenchComboReplay(CBenchReport& report, const char* path)
+{
+    std::vector<std::vector<SPadState>> devices;
+    if (!LoadCapturePadStates(path, devices))
+    {
+        std::fprintf(stderr, "cannot read %s\n", path);
+        return false;
+    }
+
+    size_t count = COMBO_BENCH_COUNTS[sizeof(COMBO_BENCH_COUNTS) / sizeof(COMBO_BENCH_COUNTS[0]) - 1];
+    CPadComboEngine engine;
+    if (!engine.Compile(GenerateCombos(count)))
+    {
+        std::fprintf(stderr, "cannot compile %zu combos\n", count);
+        return false;
+    }
+    for (size_t device = 0; device < devices.size(); device++)
+    {
+        if (devices[device].empty())
+        {
+            continue;
+        }
+
+        uint64_t matches = 0;
+        uint64_t changes = CountInputChanges(devices[device]);
+        double elapsedNs = RunComboStream(engine, devices[device], matches);
+
+        report.BeginCase("combo_replay");
+        report.Field("capture", path);
+        report.Field("device", (uint64_t)device);
+        report.Field("combos", (uint64_t)count);
+        report.Field("reports", (uint64_t)devices[device].size());
+        report.Field("changed_reports", changes);
+        report.Field("matches", matches);
+        report.Field("ns_per_report", elapsedNs / devices[device].size());
+        report.Field("ns_per_changed_report", changes ? elapsedNs / changes : 0.0);
+        report.EndCase();
+    }
+    return true;
+}
+
+// =================================================================================================
+// BenchSeqLock             the writer publishes for durationMs while the readers spin on TryRead
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchSeqLock(CBenchReport& report, int readerCount, unsigned int durationMs)
+{
+    CSeqLock<SBenchVersionPayload> seqLock;
+    std::atomic<bool> writerDone(false);
+    std::vector<uint64_t> attempts(readerCount, 0);
+    std::vector<uint64_t> reads(readerCount, 0);
+    std::vector<uint64_t> torn(readerCount, 0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readerCount; r++)
+    {
+        readers.emplace_back([&, r]()
+        {
+            SBenchVersionPayload payload;
+            uint64_t attempted = 0;
+            uint64_t read = 0;
+            uint64_t broken = 0;
+            while (!writerDone.load(std::memory_order_relaxed))
+            {
+                uint64_t version = 0;
+                attempted++;
+                if (!seqLock.TryRead(payload, &version))
+                {
+                    continue;
+                }
+                read++;
+                for (int i = 0; i < SEQLOCK_PAYLOAD_WORDS; i++)
+                {
+                    if (payload.words[i] != version)
+                    {
+                        broken++;
+                        break;
+                    }
+                }
+            }
+            attempts[r] = attempted;
+            reads[r] = read;
+            torn[r] = broken;
+        });
+    }
+
+    SBenchVersionPayload payload;
+    uint64_t publishes = 0;
+    uint64_t durationNs = (uint64_t)durationMs * 1000000;
+    auto start = std::chrono::steady_clock::now();
+    do
+    {
+        // Publish in runs of 256 so the clock is not read on every publication
+        for (int i = 0; i < 256; i++)
+        {
+            publishes++;
+            for (int j = 0; j < SEQLOCK_PAYLOAD_WORDS; j++)
+            {
+                payload.words[j] = publishes;
+            }
+            seqLock.Publish(payload);
+        }
+    }
+    while (ElapsedNs(start) < (double)durationNs);
+    double elapsedNs = ElapsedNs(start);
+    writerDone.store(true, std::memory_order_relaxed);
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    uint64_t totalAttempts = 0;
+    uint64_t totalReads = 0;
+    uint64_t totalTorn = 0;
+    for (int r = 0; r < readerCount; r++)
+    {
+        totalAttempts += attempts[r];
+        totalReads += reads[r];
+        totalTorn += torn[r];
+    }
+
+    report.BeginCase("seqlock");
+    report.Field("readers", (uint64_t)readerCount);
+    report.Field("publishes", publishes);
+    report.Field("ns_per_publish", elapsedNs / (double)publishes);
+    report.Field("reads_per_s", totalReads * 1e9 / elapsedNs);
+    report.Field("retry_fraction", totalAttempts != 0 ? (double)(totalAttempts - totalReads) / (double)totalAttempts : 0.0);
+    report.Field("torn", totalTorn);
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchSharedState         a reader with its own mapping of the region, as another process has,
+//                          polls the version of player 0 while one synthetic pad is published:
+//                          time from the report to the reader holding it, then the cost of a poll
+//                          and of a full read
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchSharedState(CBenchReport& report, unsigned int rateHz, unsigned int durationMs)
+{
+    CJoystickCore core;
+    if (!core.EnableSharedState(SHARED_BENCH_NAME))
+    {
+        std::fprintf(stderr, "cannot create the shared state region\n");
+        return;
+    }
+
+    CSharedStateReader reader;
+    if (!reader.Open(SHARED_BENCH_NAME))
+    {
+        std::fprintf(stderr, "cannot open the shared state region\n");
+        return;
+    }
+
+    std::vector<uint64_t> latencies;
+    latencies.reserve(2 * (size_t)rateHz * durationMs / 1000 + 64);
+    uint64_t skipped = 0;
+    std::atomic<bool> reading(true);
+    std::thread readerThread([&reader, &reading, &latencies, &skipped]()
+    {
+        uint64_t seenVersion = 0;
+        while (reading.load(std::memory_order_acquire))
+        {
+            if (reader.GetPadStateVersion(0) == seenVersion)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            SPadState state;
+            uint64_t version = 0;
+            if (!reader.ReadPadState(0, state, &version))
+            {
+                continue;
+            }
+            uint64_t nowNs = MonotonicNowNs();
+            if (seenVersion != 0 && version > seenVersion + 1)
+            {
+                skipped += version - seenVersion - 1;
+            }
+            seenVersion = version;
+            if (latencies.size() < latencies.capacity())
+            {
+                latencies.push_back(nowNs - state.timestampNs);
+            }
+        }
+    });
+
+    CInputThread inputThread;
+    if (inputThread.Start([rateHz]() { return std::unique_ptr<IInputSource>(new CSyntheticInputSource(1, rateHz)); }, &core, INPUT_THREAD_HIGH))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+    }
+    inputThread.Stop();
+    reading.store(false, std::memory_order_release);
+    readerThread.join();
+
+    // Nothing writes now; what a poll and a read cost on their own
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SHARED_READ_ITERATIONS; i++)
+    {
+        checksum += reader.GetPadStateVersion(0);
+    }
+    double pollNs = ElapsedNs(start) / SHARED_READ_ITERATIONS;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SHARED_READ_ITERATIONS; i++)
+    {
+        SPadState state;
+        reader.ReadPadState(0, state);
+        checksum += state.leftX;
+    }
+    double readNs = ElapsedNs(start) / SHARED_READ_ITERATIONS;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    report.BeginCase("shared_state");
+    report.Field("rate_hz", (uint64_t)rateHz);
+    report.Field("duration_ms", (uint64_t)durationMs);
+    report.Field("reads", (uint64_t)latencies.size());
+    report.Field("skipped", skipped);
+    report.Field("visible_p50_ns", Percentile(latencies, 0.50));
+    report.Field("visible_p99_ns", Percentile(latencies, 0.99));
+    report.Field("visible_p999_ns", Percentile(latencies, 0.999));
+    report.Field("poll_ns", pollNs);
+    report.Field("read_ns", readNs);
+    report.Field("checksum", checksum);
+    report.EndCase();
+}
+
+// =================================================================================================
+// RunStateServerClient     a loopback client of the server's one protocol, polling on a thread of
+//                          its own while feed runs; the client is polled once more after the feed
+//                          so the last flush interval arrives
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool RunStateServerClient(const CStateServer& server, EStateClientProtocol protocol, CStateClient& client,
+                                 std::function<void()> feed)
+{
+    uint16_t port = protocol == STATE_CLIENT_DSU ? server.GetDsuPort() : server.GetCompactPort();
+    if (!client.Open(protocol, port))
+    {
+        std::fprintf(stderr, "cannot open the state client\n");
+        return false;
+    }
+
+    // The subscription lands before the first report
+    for (int i = 0; i < 100 && server.GetCounters().requests == 0; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::atomic<bool> polling(true);
+    std::thread clientThread([&client, &polling]()
+    {
+        while (polling.load(std::memory_order_acquire))
+        {
+            client.Poll(STATE_SERVER_CLIENT_POLL_US);
+        }
+    });
+
+    feed();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(STATE_SERVER_SETTLE_MS));
+    polling.store(false, std::memory_order_release);
+    clientThread.join();
+    client.Poll(0);
+    return true;
+}
+
+// =================================================================================================
+// ReportStateServerCase    rates per served pad: DSU has four slots, so at most four are served.
+//                          checked counts the served pads the client ended up right about.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ReportStateServerCase(CBenchReport& report, const char* name, EStateClientProtocol protocol, int pads,
+                                  unsigned int rateHz, unsigned int durationMs, const CStateServer& server,
+                                  const CStateClient& client, const char* checkName, int checked)
+{
+    SStateServerCounters serverCounters = server.GetCounters();
+    SStateClientCounters clientCounters = client.GetCounters();
+    bool dsu = protocol == STATE_CLIENT_DSU;
+    int servedPads = dsu && pads > DSU_SLOTS ? DSU_SLOTS : pads;
+    uint64_t datagrams = dsu ? serverCounters.dsuPackets : serverCounters.compactDatagrams;
+    uint64_t bytes = dsu ? serverCounters.dsuBytes : serverCounters.compactBytes;
+    double seconds = durationMs / 1000.0;
+
+    report.BeginCase(name);
+    report.Field("protocol", dsu ? "dsu" : "compact");
+    report.Field("pads", (uint64_t)pads);
+    report.Field("served_pads", (uint64_t)servedPads);
+    report.Field("rate_hz", (uint64_t)rateHz);
+    report.Field("duration_ms", (uint64_t)durationMs);
+    report.Field("reports", serverCounters.reports);
+    report.Field("datagrams", datagrams);
+    report.Field("bytes", bytes);
+    report.Field("packets_per_second_per_pad", datagrams / seconds / servedPads);
+    report.Field("bytes_per_second_per_pad", bytes / seconds / servedPads);
+    report.Field("bytes_per_update", clientCounters.updates != 0 ? (double)clientCounters.bytes / clientCounters.updates : 0.0);
+    report.Field("client_datagrams", clientCounters.datagrams);
+    report.Field("client_updates", clientCounters.updates);
+    report.Field("client_acks", clientCounters.sent);
+    report.Field("lost", clientCounters.lost);
+    report.Field("missing_bases", clientCounters.missingBases);
+    report.Field("invalid", clientCounters.invalid);
+    report.Field("keyframes", serverCounters.compactKeyframes);
+    report.Field("send_errors", serverCounters.sendErrors);
+    report.Field("queue_overwrites", serverCounters.queueOverwrites);
+    report.Field(checkName, (uint64_t)checked);
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchStateServer         synthetic pads through the core into the state server, every field
+//                          changing with every report, the worst case for the delta encoding.
+//                          The pads are removed when the input thread stops: a compact client
+//                          must have dropped them, a DSU client holds their last sticks.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchStateServer(CBenchReport& report, EStateClientProtocol protocol, int pads, unsigned int rateHz, unsigned int durationMs)
+{
+    SStateServerConfig config;
+    config.dsu = protocol == STATE_CLIENT_DSU;
+    config.dsuPort = 0;
+    config.compact = protocol == STATE_CLIENT_COMPACT;
+    config.compactPort = 0;
+
+    CJoystickCore core;
+    if (!core.EnableStateServer(config))
+    {
+        std::fprintf(stderr, "cannot start the state server\n");
+        return;
+    }
+
+    CStateClient client;
+    bool ran = RunStateServerClient(*core.GetStateServer(), protocol, client, [&core, pads, rateHz, durationMs]()
+    {
+        CInputThread inputThread;
+        if (inputThread.Start([pads, rateHz]() { return std::unique_ptr<IInputSource>(new CSyntheticInputSource(pads, rateHz)); }, &core, INPUT_THREAD_HIGH))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+        }
+        inputThread.Stop();
+    });
+    if (!ran)
+    {
+        return;
+    }
+
+    int checked = 0;
+    for (int playerIndex = 0; playerIndex < pads; playerIndex++)
+    {
+        SPadState latest;
+        if (!core.GetLatestPadState(playerIndex, latest))
+        {
+            continue;
+        }
+        if (protocol == STATE_CLIENT_DSU)
+        {
+            SDsuPadData padData;
+            checked += client.GetDsuPadData(playerIndex, padData) && padData.sticks[0] == latest.leftX &&
+                       padData.sticks[1] == 255 - latest.leftY && padData.sticks[2] == latest.rightX ? 1 : 0;
+        }
+        else
+        {
+            SPadState decoded;
+            checked += client.GetState(playerIndex, decoded) ? 0 : 1;
+        }
+    }
+
+    ReportStateServerCase(report, "state_server", protocol, pads, rateHz, durationMs, *core.GetStateServer(), client,
+                          protocol == STATE_CLIENT_DSU ? "final_sticks_match" : "removals_seen", checked);
+}
+
+// =================================================================================================
+// BenchStateServerResting  pads lying on the desk: sticks at rest with a wobble now and then,
+//                          the IMU jittering by a count, fed straight into the server at the rate.
+//                          The pads stay connected, so the client's final state must equal the last fed.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchStateServerResting(CBenchReport& report, EStateClientProtocol protocol, int pads, unsigned int rateHz, unsigned int durationMs)
+{
+    SStateServerConfig config;
+    config.dsu = protocol == STATE_CLIENT_DSU;
+    config.dsuPort = 0;
+    config.compact = protocol == STATE_CLIENT_COMPACT;
+    config.compactPort = 0;
+
+    CStateServer server;
+    if (!server.Start(config))
+    {
+        std::fprintf(stderr, "cannot start the state server\n");
+        return;
+    }
+    for (int playerIndex = 0; playerIndex < pads; playerIndex++)
+    {
+        server.SubmitDevice(playerIndex, true);
+    }
+
+    std::vector<SPadState> latest(pads);
+    CStateClient client;
+    bool ran = RunStateServerClient(server, protocol, client, [&server, &latest, pads, rateHz, durationMs]()
+    {
+        uint64_t reports = (uint64_t)rateHz * durationMs / 1000;
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < reports; i++)
+        {
+            std::this_thread::sleep_until(start + std::chrono::nanoseconds(i * 1000000000ULL / rateHz));
+            for (int playerIndex = 0; playerIndex < pads; playerIndex++)
+            {
+                SPadState& state = latest[playerIndex];
+                state.timestampNs = MonotonicNowNs();
+                state.playerIndex = (uint8_t)playerIndex;
+                state.leftX = (uint16_t)(0x80 + ((i / EVENT_IDLE_NOISE_PERIOD) & 1));
+                state.leftY = 0x80;
+                state.rightX = 0x80;
+                state.rightY = 0x7F;
+                state.hat = PAD_HAT_NEUTRAL;
+                state.flags = PAD_FLAG_MOTION;
+                state.battery = 80;
+                state.gyro[0] = (int16_t)((i * 7 + playerIndex) % 3) - 1;
+                state.gyro[1] = (int16_t)((i * 5 + playerIndex) % 3) - 1;
+                state.accel[2] = 8192;
+                state.sensorTimestamp = (uint16_t)(i * 188);
+                server.SubmitState(playerIndex, state, nullptr);
+            }
+        }
+    });
+    if (!ran)
+    {
+        return;
+    }
+
+    int matched = 0;
+    for (int playerIndex = 0; playerIndex < pads; playerIndex++)
+    {
+        if (protocol == STATE_CLIENT_DSU)
+        {
+            SDsuPadData padData;
+            matched += client.GetDsuPadData(playerIndex, padData) && padData.sticks[0] == latest[playerIndex].leftX ? 1 : 0;
+        }
+        else
+        {
+            SPadState decoded;
+            matched += client.GetState(playerIndex, decoded) && GetDeltaFieldMask(latest[playerIndex], decoded) == 0 ? 1 : 0;
+        }
+    }
+
+    ReportStateServerCase(report, "state_server_resting", protocol, pads, rateHz, durationMs, server, client,
+                          "final_state_matches", matched);
+}
+
+// =================================================================================================
+// BenchOutput              one DS4 with the stand-in as its output handle, rumble set through the
+//                          core at the rate for the duration, the lightbar now and then. The pad is
+//                          removed a few intervals after the last update so every report is in.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchOutput(CBenchReport& report, bool bluetooth, unsigned int rateHz, unsigned int durationMs)
+{
+    SPadOutputConfig config;
+    uint32_t intervalUs = bluetooth ? config.minIntervalBluetoothUs : config.minIntervalUsbUs;
+
+    CJoystickCore core;
+    core.EnableOutput(config);
+
+    std::shared_ptr<CBenchOutputDevice> device(new CBenchOutputDevice((size_t)durationMs * 1000 / intervalUs + 16));
+    SHidDeviceDescriptor descriptor;
+    descriptor.vendorId = SONY_VENDOR_ID;
+    descriptor.productId = DS4_PRODUCT_ID_V2;
+    descriptor.bluetooth = bluetooth;
+    descriptor.output = device;
+    int deviceKey = 0;
+    int playerIndex = core.OnDeviceArrived(&deviceKey, 1, std::move(descriptor));
+
+    SPadOutput last = {};
+    std::vector<uint64_t> costs;
+    costs.reserve(rateHz != 0 ? (size_t)rateHz * durationMs / 1000 + 16 : OUTPUT_MAX_COSTS);
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::milliseconds(durationMs);
+    auto next = start;
+    for (uint32_t i = 0; std::chrono::steady_clock::now() < end; i++)
+    {
+        if (i % OUTPUT_LIGHTBAR_PERIOD == 0)
+        {
+            last.red = (uint8_t)(i / OUTPUT_LIGHTBAR_PERIOD);
+            last.green = 0x40;
+            last.blue = (uint8_t)~last.red;
+            core.SetLightbar(playerIndex, last.red, last.green, last.blue);
+        }
+
+        last.strongMotor = (uint8_t)i;
+        last.weakMotor = (uint8_t)(i >> 3);
+        uint64_t submitNs = MonotonicNowNs();
+        core.SetRumble(playerIndex, last.strongMotor, last.weakMotor);
+        if (costs.size() < costs.capacity())
+        {
+            costs.push_back(MonotonicNowNs() - submitNs);
+        }
+
+        if (rateHz != 0)
+        {
+            next += std::chrono::nanoseconds(1000000000ULL / rateHz);
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    std::this_thread::sleep_for(std::chrono::microseconds(2 * intervalUs + OUTPUT_DEVICE_WRITE_US));
+    SPadOutputCounters counters;
+    core.GetOutputCounters(playerIndex, counters);
+    core.OnDeviceRemoved(&deviceKey);
+
+    const std::vector<uint64_t>& writeNs = device->GetWriteTimes();
+    uint64_t minGapNs = 0;
+    for (size_t i = 1; i < writeNs.size(); i++)
+    {
+        uint64_t gapNs = writeNs[i] - writeNs[i - 1];
+        minGapNs = (i == 1 || gapNs < minGapNs) ? gapNs : minGapNs;
+    }
+
+    unsigned char expected[PAD_OUTPUT_MAX_REPORT_SIZE];
+    size_t expectedLength = BuildDs4OutputReport(last, bluetooth, expected);
+    std::sort(costs.begin(), costs.end());
+
+    report.BeginCase("output");
+    report.Field("bus", bluetooth ? "bluetooth" : "usb");
+    report.Field("submit_rate_hz", (uint64_t)rateHz);
+    report.Field("duration_ms", (uint64_t)durationMs);
+    report.Field("interval_us", (uint64_t)intervalUs);
+    report.Field("submits", counters.submits);
+    report.Field("coalesced", counters.coalesced);
+    report.Field("writes", counters.writes);
+    report.Field("unchanged", counters.unchanged);
+    report.Field("write_errors", counters.writeErrors);
+    report.Field("writes_per_second", counters.writes * 1000.0 / durationMs);
+    report.Field("min_gap_us", minGapNs / 1000.0);
+    report.Field("submit_p50_ns", Percentile(costs, 0.50));
+    report.Field("submit_p99_ns", Percentile(costs, 0.99));
+    report.Field("submit_p999_ns", Percentile(costs, 0.999));
+    report.Field("final_report_match", (uint64_t)(device->LastReportIs(expected, expectedLength) ? 1 : 0));
+    report.Field("crc_errors", device->GetCrcErrors());
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchRawInputBatch       what CWin32RawInputSource does with a drained buffer, without Win32: walk
+//                          the blocks, hand every report to the core, end the wakeup
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchRawInputBatch(CBenchReport& report, uint32_t reportsPerPad, EBatchDelivery delivery)
+{
+    CJoystickCore core;
+    uint64_t delivered = 0;
+    core.EnableBatchedDelivery(delivery, [&delivered](const SJoystickSample*, size_t count) { delivered += count; });
+
+    int keys[RAW_BATCH_PADS];
+    std::vector<unsigned char> buffer;
+    std::vector<unsigned char> reports((size_t)reportsPerPad * SYNTHETIC_REPORT_SIZE);
+    for (int pad = 0; pad < RAW_BATCH_PADS; pad++)
+    {
+        SHidDeviceDescriptor descriptor;
+        descriptor.vendorId = SONY_VENDOR_ID;
+        descriptor.productId = DS4_PRODUCT_ID_V2;
+        core.OnDeviceArrived(&keys[pad], (uint32_t)pad + 1, std::move(descriptor));
+
+        for (uint32_t i = 0; i < reportsPerPad; i++)
+        {
+            CSyntheticInputSource::BuildReport(pad, i * 37, &reports[(size_t)i * SYNTHETIC_REPORT_SIZE]);
+        }
+        AppendRawInputBlock(buffer, &keys[pad], reports.data(), SYNTHETIC_REPORT_SIZE, reportsPerPad);
+    }
+
+    uint64_t reportsPerWakeup = (uint64_t)RAW_BATCH_PADS * reportsPerPad;
+    uint64_t wakeups = RAW_BATCH_REPORTS / reportsPerWakeup;
+    uint64_t decoded = 0;
+    uint64_t allocationsBefore = GetAllocationCount();
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t wakeup = 0; wakeup < wakeups; wakeup++)
+    {
+        uint64_t timestampNs = wakeup * 1000000;
+        ForEachRawInputBlock(buffer.data(), buffer.size(), RAW_BATCH_PADS, [&core, &decoded, timestampNs](const SRawInputBlock& block)
+        {
+            for (uint32_t i = 0; i < block.reportCount; i++)
+            {
+                decoded += core.OnReport(block.device, block.reports + (size_t)i * block.reportSize, block.reportSize, timestampNs) ? 1 : 0;
+            }
+        });
+        core.OnBatchEnd();
+    }
+    double elapsedNs = ElapsedNs(start);
+    uint64_t allocations = GetAllocationCount() - allocationsBefore;
+
+    report.BeginCase("raw_input_batch");
+    report.Field("reports_per_wakeup", reportsPerWakeup);
+    report.Field("delivery", delivery == BATCH_DELIVER_LATEST ? "latest" : "all");
+    report.Field("reports", decoded);
+    report.Field("ns_per_report", elapsedNs / (double)(wakeups * reportsPerWakeup));
+    report.Field("allocs_per_report", (double)allocations / (double)(wakeups * reportsPerWakeup));
+    report.Field("samples_per_wakeup", (double)delivered / (double)wakeups);
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchDelivery            synthetic pads on a real input thread: latency from the report's
+//                          timestamp to the callback and to a consumer popping the sample queue
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchDelivery(CBenchReport& report, int pads, unsigned int rateHz, unsigned int durationMs)
+{
+    // Room for twice the expected samples, recording stops rather than allocating
+    size_t expected = (size_t)pads * rateHz * durationMs / 1000;
+    std::vector<uint64_t> callbackLatencies;
+    std::vector<uint64_t> queueLatencies;
+    callbackLatencies.reserve(2 * expected + 64);
+    queueLatencies.reserve(2 * expected + 64);
+
+    CJoystickCore core;
+    std::atomic<uint64_t> delivered(0);
+    core.EnableSampleQueue(DELIVERY_QUEUE_CAPACITY, RING_COUNT_DROPS);
+    core.SetCallback([&core, &callbackLatencies, &delivered](int playerIndex, JSDATA)
+    {
+        uint64_t nowNs = MonotonicNowNs();
+        SJoystickSample sample;
+        if (callbackLatencies.size() < callbackLatencies.capacity() && core.GetLatestState(playerIndex, sample))
+        {
+            callbackLatencies.push_back(nowNs - sample.timestampNs);
+        }
+        delivered.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    CSpscRing<SJoystickSample>* queue = core.GetSampleQueue();
+    std::atomic<bool> consuming(true);
+    std::thread consumer([queue, &consuming, &queueLatencies]()
+    {
+        SJoystickSample sample;
+        while (consuming.load(std::memory_order_acquire))
+        {
+            if (!queue->TryPop(sample))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            uint64_t nowNs = MonotonicNowNs();
+            if (queueLatencies.size() < queueLatencies.capacity())
+            {
+                queueLatencies.push_back(nowNs - sample.timestampNs);
+            }
+        }
+    });
+
+    CInputThread inputThread;
+    bool started = inputThread.Start([pads, rateHz]()
+    {
+        return std::unique_ptr<IInputSource>(new CSyntheticInputSource(pads, rateHz));
+    }, &core, INPUT_THREAD_HIGH);
+
+    uint64_t allocationsBefore = GetAllocationCount();
+    uint64_t deliveredBefore = delivered.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    if (started)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+    }
+    double elapsedNs = ElapsedNs(start);
+    uint64_t reports = delivered.load(std::memory_order_relaxed) - deliveredBefore;
+    uint64_t allocations = GetAllocationCount() - allocationsBefore;
+
+    inputThread.Stop();
+    consuming.store(false, std::memory_order_release);
+    consumer.join();
+
+    std::sort(callbackLatencies.begin(), callbackLatencies.end());
+    std::sort(queueLatencies.begin(), queueLatencies.end());
+
+    report.BeginCase("delivery");
+    report.Field("pads", (uint64_t)pads);
+    report.Field("rate_hz", (uint64_t)rateHz);
+    report.Field("duration_ms", (uint64_t)durationMs);
+    report.Field("reports", reports);
+    report.Field("reports_per_s", reports * 1e9 / elapsedNs);
+    report.Field("expected_per_s", (double)pads * rateHz);
+    report.Field("callback_p50_ns", Percentile(callbackLatencies, 0.50));
+    report.Field("callback_p99_ns", Percentile(callbackLatencies, 0.99));
+    report.Field("callback_p999_ns", Percentile(callbackLatencies, 0.999));
+    report.Field("queue_p50_ns", Percentile(queueLatencies, 0.50));
+    report.Field("queue_p99_ns", Percentile(queueLatencies, 0.99));
+    report.Field("queue_p999_ns", Percentile(queueLatencies, 0.999));
+    report.Field("queue_dropped", queue->DroppedCount());
+    report.Field("allocs_per_report", reports ? (double)allocations / reports : 0.0);
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchDisplayRedraw       text lines drawn per input report: the data window used to repaint all
+//                          of them per report, it now redraws the changed ones per refresh
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchDisplayRedraw(CBenchReport& report, unsigned int inputRateHz)
+{
+    const uint64_t reportCount = (uint64_t)inputRateHz * REDRAW_SIMULATED_SECONDS;
+    const uint64_t frameCount = (uint64_t)REDRAW_REFRESH_HZ * REDRAW_SIMULATED_SECONDS;
+
+    unsigned char raw[SYNTHETIC_REPORT_SIZE];
+    JSDATA latest;
+    CDisplayDiff displayDiff;
+    uint64_t decoded = 0;
+    uint64_t linesDrawn = 0;
+    uint64_t framesDrawn = 0;
+
+    for (uint64_t frame = 0; frame < frameCount; frame++)
+    {
+        // Reports that arrived before this frame's timer tick
+        uint64_t reportsDue = (frame + 1) * reportCount / frameCount;
+        for (; decoded < reportsDue; decoded++)
+        {
+            CSyntheticInputSource::BuildReport(0, decoded, raw);
+            DecodeDs4UsbReport(raw, sizeof(raw), latest);
+        }
+
+        int lines = CountLines(displayDiff.Update(latest, 0, 1));
+        linesDrawn += lines;
+        framesDrawn += lines != 0;
+    }
+
+    report.BeginCase("display_redraw");
+    report.Field("input_hz", (uint64_t)inputRateHz);
+    report.Field("refresh_hz", (uint64_t)REDRAW_REFRESH_HZ);
+    report.Field("reports", reportCount);
+    report.Field("lines_per_report_before", (double)DISPLAY_LINE_COUNT);
+    report.Field("lines_per_report", (double)linesDrawn / reportCount);
+    report.Field("paints_per_report_before", 1.0);
+    report.Field("paints_per_report", (double)framesDrawn / reportCount);
+    report.EndCase();
+}
+
+// =================================================================================================
+// BenchDisplayDiff         cost of one CDisplayDiff::Update alternating between two states and with
+//                          the state standing still
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BenchDisplayDiff(CBenchReport& report)
+{
+    unsigned char raw[SYNTHETIC_REPORT_SIZE];
+    JSDATA states[2];
+    CSyntheticInputSource::BuildReport(0, 0, raw);
+    DecodeDs4UsbReport(raw, sizeof(raw), states[0]);
+    CSyntheticInputSource::BuildReport(0, 0x5A5, raw);
+    DecodeDs4UsbReport(raw, sizeof(raw), states[1]);
+
+    const char* names[] = { "display_diff_active", "display_diff_idle" };
+    for (int idle = 0; idle < 2; idle++)
+    {
+        CDisplayDiff displayDiff;
+        uint64_t linesDirty = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < DIFF_ITERATIONS; i++)
+        {
+            linesDirty += CountLines(displayDiff.Update(states[idle ? 0 : (i & 1)], 0, 1));
+        }
+        double elapsedNs = ElapsedNs(start);
+
+        report.BeginCase(names[idle]);
+        report.Field("iterations", (uint64_t)DIFF_ITERATIONS);
+        report.Field("ns_per_update", elapsedNs / DIFF_ITERATIONS);
+        report.Field("lines_per_update", (double)linesDirty / DIFF_ITERATIONS);
+        report.EndCase();
+    }
+}
+
+// =================================================================================================
+// BenchReplay              decode cost of a recorded session, replay overhead included
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool BenchReplay(CBenchReport& report, const char* path)
+{
+    CJoystickCore core;
+    CReplaySource source(path, REPLAY_SPEED_UNLIMITED);
+    if (!source.Open(&core))
+    {
+        std::fprintf(stderr, "cannot replay %s\n", path);
+        return false;
+    }
+
+    uint64_t decoded = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (!source.IsFinished())
+    {
+        int handled = source.Poll(0);
+        if (handled < 0)
+        {
+            break;
+        }
+        decoded += handled;
+    }
+    double elapsedNs = ElapsedNs(start);
+    source.Close();
+
+    report.BeginCase("replay_decode");
+    report.Field("capture", path);
+    report.Field("reports", decoded);
+    report.Field("ns_per_report", decoded ? elapsedNs / decoded : 0.0);
+    report.EndCase();
+    return true;
+}
+
+// =================================================================================================
+// main
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    unsigned int durationMs = DELIVERY_DEFAULT_DURATION_MS;
+    std::vector<const char*> captures;
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if (std::strcmp(argv[arg], "--duration-ms") == 0 && arg + 1 < argc)
+        {
+            durationMs = (unsigned int)std::atoi(argv[++arg]);
+        }
+        else
+        {
+            captures.push_back(argv[arg]);
+        }
+    }
+
+    CBenchReport report;
+    int result = 0;
+
+    BenchDecode(report);
+    BenchDescriptorCache(report);
+    BenchHidProgram(report, "synthetic", BuildDecodeReports());
+    BenchHidDescriptorFuzz(report);
+    BenchStats(report);
+    BenchStateLayout(report);
+    BenchMotion(report);
+    BenchAxes(report);
+    BenchFilters(report);
+    BenchEvents(report);
+    BenchCombos(report);
+    for (int pads : DELIVERY_PADS)
+    {
+        for (unsigned int rateHz : DELIVERY_RATES_HZ)
+        {
+            BenchDelivery(report, pads, rateHz, durationMs);
+        }
+    }
+
+    for (uint32_t reportsPerPad : RAW_BATCH_REPORTS_PER_PAD)
+    {
+        for (EBatchDelivery delivery : { BATCH_DELIVER_ALL, BATCH_DELIVER_LATEST })
+        {
+            BenchRawInputBatch(report, reportsPerPad, delivery);
+        }
+    }
+
+    for (unsigned int rateHz : SHARED_RATES_HZ)
+    {
+        BenchSharedState(report, rateHz, durationMs);
+    }
+
+    for (int readerCount : SEQLOCK_READERS)
+    {
+        BenchSeqLock(report, readerCount, durationMs);
+    }
+
+    for (EStateClientProtocol protocol : { STATE_CLIENT_DSU, STATE_CLIENT_COMPACT })
+    {
+        for (int pads : STATE_SERVER_PADS)
+        {
+            for (unsigned int rateHz : STATE_SERVER_RATES_HZ)
+            {
+                BenchStateServer(report, protocol, pads, rateHz, durationMs);
+            }
+        }
+        BenchStateServerResting(report, protocol, 1, 1000, durationMs);
+    }
+
+    for (bool bluetooth : { false, true })
+    {
+        for (unsigned int rateHz : OUTPUT_SUBMIT_RATES_HZ)
+        {
+            BenchOutput(report, bluetooth, rateHz, durationMs);
+        }
+    }
+
+    for (unsigned int inputRateHz : REDRAW_INPUT_RATES_HZ)
+    {
+        BenchDisplayRedraw(report, inputRateHz);
+    }
+    BenchDisplayDiff(report);
+
+    for (const char* capture : captures)
+    {
+        if (!BenchReplay(report, capture) || !BenchHidProgramReplay(report, capture) || !BenchFilterEval(report, capture) ||
+            !BenchEventReplay(report, capture) || !BenchComboReplay(report, capture))
+        {
+            result = 1;
+        }
+    }
+
+    return result;
+}
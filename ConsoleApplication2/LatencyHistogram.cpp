@@ -0,0 +1,120 @@
+// =================================================================================================
+// Log-linear latency histogram in the style of HdrHistogram: 32 buckets per power of two, so any
+// recorded value is known to within about 3%. One thread records, any thread can copy it out.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "LatencyHistogram.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CLatencyHistogram
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CLatencyHistogram::CLatencyHistogram()
+{
+    Reset();
+}
+
+// =================================================================================================
+// Snapshot
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLatencyHistogram::Snapshot(SHistogramSnapshot& snapshot) const
+{
+    snapshot.total = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        snapshot.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        snapshot.total += snapshot.counts[i];
+    }
+    snapshot.maxValue = m_maxValue.load(std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// Reset                    only while nothing records
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CLatencyHistogram::Reset()
+{
+    for (std::atomic<uint64_t>& count : m_counts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+    m_maxValue.store(0, std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// HistogramBucketHighest
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint64_t HistogramBucketHighest(size_t index)
+{
+    if (index < HISTOGRAM_SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    int shift = (int)(index / HISTOGRAM_SUB_BUCKETS) - 1;
+    uint64_t subBucket = index % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+// =================================================================================================
+// HistogramPercentile
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint64_t HistogramPercentile(const SHistogramSnapshot& snapshot, double fraction)
+{
+    if (snapshot.total == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the wanted value, 1-based, at least the first one
+    uint64_t rank = (uint64_t)(fraction * (double)snapshot.total + 0.5);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        seen += snapshot.counts[i];
+        if (seen >= rank)
+        {
+            return HistogramBucketHighest(i);
+        }
+    }
+    return HistogramBucketHighest(HISTOGRAM_BUCKETS - 1);
+}
+
+// =================================================================================================
+// SubtractHistogram
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void SubtractHistogram(const SHistogramSnapshot& current, const SHistogramSnapshot& previous, SHistogramSnapshot& difference)
+{
+    difference.total = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        difference.counts[i] = current.counts[i] - previous.counts[i];
+        difference.total += difference.counts[i];
+    }
+    difference.maxValue = current.maxValue;
+}
@@ -0,0 +1,96 @@
+// =================================================================================================
+// Log-linear latency histogram in the style of HdrHistogram: 32 buckets per power of two, so any
+// recorded value is known to within about 3%. One thread records, any thread can copy it out.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int HISTOGRAM_SUB_BUCKET_BITS = 5;
+const uint64_t HISTOGRAM_SUB_BUCKETS = 1ull << HISTOGRAM_SUB_BUCKET_BITS;
+
+// Values from 2^36 ns (about 69 s) up all land in the last bucket
+const int HISTOGRAM_MAX_VALUE_BITS = 36;
+const size_t HISTOGRAM_BUCKETS = (HISTOGRAM_MAX_VALUE_BITS - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKETS;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// A plain copy of the counts, cheap to subtract for the activity between two snapshots
+struct SHistogramSnapshot
+{
+	uint64_t counts[HISTOGRAM_BUCKETS];
+	uint64_t total;
+	uint64_t maxValue;          // largest value ever recorded, not reduced by subtraction
+};
+
+class CLatencyHistogram
+{
+public:
+   CLatencyHistogram();
+
+   // Single writer; relaxed load and store, no read-modify-write on the hot path
+   void Record(uint64_t value)
+   {
+      std::atomic<uint64_t>& count = m_counts[BucketIndex(value)];
+      count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      if (value > m_maxValue.load(std::memory_order_relaxed))
+      {
+         m_maxValue.store(value, std::memory_order_relaxed);
+      }
+   }
+
+   // Counts may be a few records apart from each other, never torn
+   void Snapshot(SHistogramSnapshot& snapshot) const;
+   void Reset();
+
+   static size_t BucketIndex(uint64_t value)
+   {
+      if (value < HISTOGRAM_SUB_BUCKETS)
+      {
+         return (size_t)value;
+      }
+
+      int topBit = 63;
+      while (!(value >> topBit))
+      {
+         topBit--;
+      }
+      if (topBit >= HISTOGRAM_MAX_VALUE_BITS)
+      {
+         return HISTOGRAM_BUCKETS - 1;
+      }
+
+      int shift = topBit - HISTOGRAM_SUB_BUCKET_BITS;
+      return (size_t)(shift + 1) * HISTOGRAM_SUB_BUCKETS + (size_t)((value >> shift) - HISTOGRAM_SUB_BUCKETS);
+   }
+
+private:
+   std::atomic<uint64_t> m_counts[HISTOGRAM_BUCKETS];
+   std::atomic<uint64_t> m_maxValue;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// Highest value that falls into a bucket
+uint64_t HistogramBucketHighest(size_t index);
+
+// Value below which the given fraction of the recorded values lie, 0 when nothing was recorded
+uint64_t HistogramPercentile(const SHistogramSnapshot& snapshot, double fraction);
+
+// current - previous, bucket by bucket
+void SubtractHistogram(const SHistogramSnapshot& current, const SHistogramSnapshot& previous, SHistogramSnapshot& difference);
@@ -0,0 +1,25 @@
+// =================================================================================================
+// Monotonic high-resolution timestamps shared by the input path and its consumers.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <chrono>
+#include <cstdint>
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// Nanoseconds on the steady clock (QueryPerformanceCounter on Windows, CLOCK_MONOTONIC on Linux)
+inline uint64_t MonotonicNowNs()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,520 @@
+// =================================================================================================
+// Combo and gesture recognition over the decoded pad state: chords, sequences such as fighting-game
+// motions, taps, double taps and holds. The definitions are compiled into bit tables with one bit
+// per step of every combo, and each report advances all combos of its pad at once, shift-and
+// style, a machine word of steps per operation. Reports that change no input cost a compare.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "PadCombos.h"
+#include <algorithm>
+#include <cstring>
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint64_t COMBO_NS_PER_MS = 1000000;
+
+static_assert(COMBO_INPUT_BITS <= 32, "combo inputs must fit SComboStep::inputs");
+static_assert(PAD_BUTTON_COUNT <= COMBO_INPUT_HAT_SHIFT, "the hat bits follow the buttons");
+static_assert(COMBO_MAX_LAYERS <= 32, "a report's empty layers are kept in one 32-bit mask");
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// SetBit
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void SetBit(uint64_t* bits, uint32_t bit)
+{
+    bits[bit >> 6] |= 1ull << (bit & 63);
+}
+
+// =================================================================================================
+// ClearBits                bits begin up to end
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ClearBits(uint64_t* bits, uint32_t begin, uint32_t end)
+{
+    for (uint32_t bit = begin; bit < end; bit++)
+    {
+        bits[bit >> 6] &= ~(1ull << (bit & 63));
+    }
+}
+
+// =================================================================================================
+// CountInputs
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int CountInputs(uint32_t inputs)
+{
+    int count = 0;
+    for (; inputs != 0; inputs &= inputs - 1)
+    {
+        count++;
+    }
+    return count;
+}
+
+// =================================================================================================
+// StepMaxMs
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t StepMaxMs(const SComboStep& step)
+{
+    return step.maxMs != 0 ? step.maxMs : (uint32_t)step.minMs + COMBO_DEFAULT_STEP_MAX_MS;
+}
+
+// =================================================================================================
+// OrRows                   the rows of table selected by inputs ORed into bits
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void OrRows(const std::vector<uint64_t>& table, size_t words, uint32_t inputs, uint64_t* bits)
+{
+    for (; inputs != 0; inputs &= inputs - 1)
+    {
+        int input = 0;
+        while (((inputs >> input) & 1) == 0)
+        {
+            input++;
+        }
+
+        const uint64_t* row = &table[input * words];
+        for (size_t word = 0; word < words; word++)
+        {
+            bits[word] |= row[word];
+        }
+    }
+}
+
+// =================================================================================================
+// CPadComboEngine
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CPadComboEngine::CPadComboEngine() :
+    m_words(0),
+    m_pressChordInputs(0),
+    m_releaseChordInputs(0),
+    m_holdInputs(0)
+{
+    for (int playerIndex = 0; playerIndex < MAX_CONTROLLERS; playerIndex++)
+    {
+        Reset(playerIndex);
+    }
+}
+
+// =================================================================================================
+// Compile                  step bits are numbered combo after combo, so a combo's next step is
+//                          the bit above its current one and a shift moves every combo at once.
+//                          The step windows are turned into masks by age once here.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CPadComboEngine::Compile(const std::vector<SComboDefinition>& combos)
+{
+    size_t stepCount = 0;
+    for (const SComboDefinition& combo : combos)
+    {
+        if (combo.steps.empty() || combo.steps.size() > COMBO_MAX_STEPS)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < combo.steps.size(); i++)
+        {
+            const SComboStep& step = combo.steps[i];
+            if (step.inputs == 0 || (step.inputs & ~(COMBO_INPUT_BUTTONS | COMBO_INPUT_HATS)) != 0 || step.kind > COMBO_STEP_HOLD ||
+                (step.kind == COMBO_STEP_HOLD && (i == 0 || step.minMs == 0)) ||
+                (step.maxMs != 0 && step.maxMs < step.minMs) || StepMaxMs(step) > COMBO_MAX_STEP_MS)
+            {
+                return false;
+            }
+        }
+        stepCount += combo.steps.size();
+    }
+
+    m_words = std::max<size_t>((stepCount + 63) / 64, 1);
+    size_t tableSize = COMBO_INPUT_BITS * m_words;
+    m_press.assign(tableSize, 0);
+    m_pressChord.assign(tableSize, 0);
+    m_release.assign(tableSize, 0);
+    m_releaseChord.assign(tableSize, 0);
+    m_hold.assign(tableSize, 0);
+    m_holdSource.assign(tableSize, 0);
+    m_pressChordInputs = 0;
+    m_releaseChordInputs = 0;
+    m_holdInputs = 0;
+    m_first.assign(m_words, 0);
+    m_last.assign(m_words, 0);
+    m_holdSteps.assign(m_words, 0);
+    m_holdSourceSteps.assign(m_words, 0);
+    m_comboIds.clear();
+    m_comboFirst.clear();
+    m_stepCombo.clear();
+    m_boundariesNs.assign(1, 0);
+    m_holdThresholdsNs.clear();
+
+    uint32_t bit = 0;
+    for (const SComboDefinition& combo : combos)
+    {
+        m_comboFirst.push_back(bit);
+        for (size_t i = 0; i < combo.steps.size(); i++, bit++)
+        {
+            const SComboStep& step = combo.steps[i];
+            bool chord = CountInputs(step.inputs) > 1;
+            for (int input = 0; input < COMBO_INPUT_BITS; input++)
+            {
+                if (((step.inputs >> input) & 1) == 0)
+                {
+                    continue;
+                }
+
+                switch (step.kind)
+                {
+                    case COMBO_STEP_PRESS:
+                        SetBit(Table(m_press, input), bit);
+                        if (chord)
+                        {
+                            SetBit(Table(m_pressChord, input), bit);
+                            m_pressChordInputs |= 1u << input;
+                        }
+                        break;
+
+                    case COMBO_STEP_RELEASE:
+                        SetBit(Table(m_release, input), bit);
+                        if (chord)
+                        {
+                            SetBit(Table(m_releaseChord, input), bit);
+                            m_releaseChordInputs |= 1u << input;
+                        }
+                        break;
+
+                    case COMBO_STEP_HOLD:
+                        SetBit(Table(m_hold, input), bit);
+                        SetBit(Table(m_holdSource, input), bit - 1);
+                        m_holdInputs |= 1u << input;
+                        break;
+                }
+            }
+
+            if (step.kind == COMBO_STEP_HOLD)
+            {
+                SetBit(m_holdSteps.data(), bit);
+                SetBit(m_holdSourceSteps.data(), bit - 1);
+                m_holdThresholdsNs.push_back(step.minMs * COMBO_NS_PER_MS);
+            }
+            if (i == 0)
+            {
+                SetBit(m_first.data(), bit);
+            }
+            else
+            {
+                m_boundariesNs.push_back(step.minMs * COMBO_NS_PER_MS);
+                m_boundariesNs.push_back(StepMaxMs(step) * COMBO_NS_PER_MS + 1);
+            }
+            if (i + 1 == combo.steps.size())
+            {
+                SetBit(m_last.data(), bit);
+            }
+            m_stepCombo.push_back((uint32_t)m_comboIds.size());
+        }
+        m_comboIds.push_back(combo.id);
+    }
+    m_comboFirst.push_back(bit);
+
+    std::sort(m_boundariesNs.begin(), m_boundariesNs.end());
+    m_boundariesNs.erase(std::unique(m_boundariesNs.begin(), m_boundariesNs.end()), m_boundariesNs.end());
+    std::sort(m_holdThresholdsNs.begin(), m_holdThresholdsNs.end());
+    m_holdThresholdsNs.erase(std::unique(m_holdThresholdsNs.begin(), m_holdThresholdsNs.end()), m_holdThresholdsNs.end());
+
+    // Every window starts and ends on a boundary, so a window covers whole rows
+    m_open.assign(m_boundariesNs.size() * m_words, 0);
+    m_alive.assign(m_boundariesNs.size() * m_words, 0);
+    bit = 0;
+    for (const SComboDefinition& combo : combos)
+    {
+        for (size_t i = 0; i < combo.steps.size(); i++, bit++)
+        {
+            if (i == 0)
+            {
+                continue;
+            }
+
+            const SComboStep& step = combo.steps[i];
+            size_t opens = std::lower_bound(m_boundariesNs.begin(), m_boundariesNs.end(), step.minMs * COMBO_NS_PER_MS) - m_boundariesNs.begin();
+            size_t closes = std::lower_bound(m_boundariesNs.begin(), m_boundariesNs.end(), StepMaxMs(step) * COMBO_NS_PER_MS + 1) - m_boundariesNs.begin();
+            for (size_t row = 0; row < closes; row++)
+            {
+                SetBit(Table(m_alive, row), bit - 1);
+                if (row >= opens)
+                {
+                    SetBit(Table(m_open, row), bit - 1);
+                }
+            }
+        }
+    }
+
+    for (int playerIndex = 0; playerIndex < MAX_CONTROLLERS; playerIndex++)
+    {
+        m_players[playerIndex].layers.assign(COMBO_MAX_LAYERS * m_words, 0);
+        Reset(playerIndex);
+    }
+    m_scratch.assign(3 * m_words, 0);
+    m_completed.clear();
+    m_completed.reserve(combos.size());
+    return true;
+}
+
+// =================================================================================================
+// SetCallback
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadComboEngine::SetCallback(std::function<void(const SComboEvent*, size_t)> callback)
+{
+    m_callback = callback;
+}
+
+// =================================================================================================
+// Reset
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadComboEngine::Reset(int playerIndex)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return;
+    }
+
+    SPlayerProgress& progress = m_players[playerIndex];
+    progress.oldestLayer = 0;
+    progress.layerCount = 0;
+    progress.previousInputs = ComboHat(PAD_HAT_NEUTRAL);
+}
+
+// =================================================================================================
+// FindInterval             the boundary row of an age
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int CPadComboEngine::FindInterval(uint64_t ageNs) const
+{
+    return (int)(std::upper_bound(m_boundariesNs.begin(), m_boundariesNs.end(), ageNs) - m_boundariesNs.begin()) - 1;
+}
+
+// =================================================================================================
+// Process                  only a report that changes an input, or brings a pending HOLD to its
+//                          minimum, reaches the tables
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t CPadComboEngine::Process(int playerIndex, const SPadState& state)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS || m_comboIds.empty())
+    {
+        return 0;
+    }
+
+    SPlayerProgress& progress = m_players[playerIndex];
+    uint32_t inputs = (state.buttons & COMBO_INPUT_BUTTONS) | ComboHat(state.hat);
+    uint32_t pressed = inputs & ~progress.previousInputs;
+    uint32_t released = progress.previousInputs & ~inputs;
+    progress.previousInputs = inputs;
+    uint64_t nowNs = state.timestampNs;
+
+    bool holdDue = false;
+    for (int i = 0; i < progress.layerCount && !m_holdThresholdsNs.empty(); i++)
+    {
+        int layer = (progress.oldestLayer + i) % COMBO_MAX_LAYERS;
+        uint16_t stage = progress.layerHoldStage[layer];
+        if (stage < m_holdThresholdsNs.size() && nowNs >= progress.layerNs[layer] + m_holdThresholdsNs[stage])
+        {
+            holdDue = true;
+            break;
+        }
+    }
+    if ((pressed | released) == 0 && !holdDue)
+    {
+        return 0;
+    }
+
+    // The steps this report satisfies: a PRESS whose inputs are all down with one just gone down,
+    // a RELEASE whose inputs are all up with one just gone up, a HOLD whose inputs are all down
+    uint64_t* satisfied = &m_scratch[0];
+    uint64_t* excluded = &m_scratch[m_words];
+    std::memset(satisfied, 0, 2 * m_words * sizeof(uint64_t));
+    OrRows(m_press, m_words, pressed, satisfied);
+    OrRows(m_release, m_words, released, satisfied);
+    OrRows(m_pressChord, m_words, ~inputs & m_pressChordInputs, excluded);
+    OrRows(m_releaseChord, m_words, inputs & m_releaseChordInputs, excluded);
+    if (m_holdInputs != 0)
+    {
+        OrRows(m_hold, m_words, ~inputs & m_holdInputs, excluded);
+        for (size_t word = 0; word < m_words; word++)
+        {
+            satisfied[word] |= m_holdSteps[word];
+        }
+    }
+    for (size_t word = 0; word < m_words; word++)
+    {
+        satisfied[word] &= ~excluded[word];
+    }
+
+    // Letting go of a HOLD's inputs ends the wait for it
+    uint64_t* cancelled = excluded;
+    std::memset(cancelled, 0, m_words * sizeof(uint64_t));
+    OrRows(m_holdSource, m_words, released & m_holdInputs, cancelled);
+
+    AdvanceLayers(progress, nowNs, satisfied, cancelled);
+    return Complete(playerIndex, progress, nowNs);
+}
+
+// =================================================================================================
+// AdvanceLayers            drops from every layer the steps whose window has passed or whose HOLD
+//                          was let go, and leaves in the source row the next steps of those whose
+//                          window is open: (sources << 1 | first steps) & satisfied
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadComboEngine::AdvanceLayers(SPlayerProgress& progress, uint64_t nowNs, const uint64_t* satisfied, const uint64_t* cancelled)
+{
+    uint64_t* sources = &m_scratch[2 * m_words];
+    std::memset(sources, 0, m_words * sizeof(uint64_t));
+
+    uint32_t emptyLayers = 0;
+    int lastRow = (int)m_boundariesNs.size() - 1;
+    for (int i = 0; i < progress.layerCount; i++)
+    {
+        int layer = (progress.oldestLayer + i) % COMBO_MAX_LAYERS;
+        uint64_t ageNs = nowNs > progress.layerNs[layer] ? nowNs - progress.layerNs[layer] : 0;
+        while (progress.layerHoldStage[layer] < m_holdThresholdsNs.size() && ageNs >= m_holdThresholdsNs[progress.layerHoldStage[layer]])
+        {
+            progress.layerHoldStage[layer]++;
+        }
+
+        int row = FindInterval(ageNs);
+        if (row >= lastRow)
+        {
+            // Past every window
+            emptyLayers |= 1u << i;
+            continue;
+        }
+
+        uint64_t* bits = &progress.layers[layer * m_words];
+        const uint64_t* open = &m_open[row * m_words];
+        const uint64_t* alive = &m_alive[row * m_words];
+        uint64_t any = 0;
+        uint64_t holding = 0;
+        for (size_t word = 0; word < m_words; word++)
+        {
+            uint64_t kept = bits[word] & alive[word] & ~cancelled[word];
+            bits[word] = kept;
+            sources[word] |= kept & open[word];
+            any |= kept;
+            holding |= kept & m_holdSourceSteps[word];
+        }
+        if (any == 0)
+        {
+            emptyLayers |= 1u << i;
+        }
+        if (holding == 0)
+        {
+            progress.layerHoldStage[layer] = (uint16_t)m_holdThresholdsNs.size();
+        }
+    }
+
+    while (progress.layerCount > 0 && (emptyLayers & 1) != 0)
+    {
+        progress.oldestLayer = (progress.oldestLayer + 1) % COMBO_MAX_LAYERS;
+        progress.layerCount--;
+        emptyLayers >>= 1;
+    }
+
+    // Downwards, so each word still reads the unshifted word below it
+    for (size_t word = m_words; word-- > 0;)
+    {
+        uint64_t carry = word > 0 ? sources[word - 1] >> 63 : 0;
+        sources[word] = ((sources[word] << 1) | carry | m_first[word]) & satisfied[word];
+    }
+}
+
+// =================================================================================================
+// Complete                 reports the combos whose last step was reached and starts them over;
+//                          the other steps reached become a new layer
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t CPadComboEngine::Complete(int playerIndex, SPlayerProgress& progress, uint64_t nowNs)
+{
+    uint64_t* reached = &m_scratch[2 * m_words];
+
+    m_completed.clear();
+    for (size_t word = 0; word < m_words; word++)
+    {
+        for (uint64_t done = reached[word] & m_last[word]; done != 0; done &= done - 1)
+        {
+            int bitInWord = 0;
+            while (((done >> bitInWord) & 1) == 0)
+            {
+                bitInWord++;
+            }
+
+            uint32_t combo = m_stepCombo[word * 64 + bitInWord];
+            SComboEvent event;
+            event.timestampNs = nowNs;
+            event.id = m_comboIds[combo];
+            event.playerIndex = (uint8_t)playerIndex;
+            m_completed.push_back(event);
+
+            uint32_t begin = m_comboFirst[combo];
+            uint32_t end = m_comboFirst[combo + 1];
+            ClearBits(reached, begin, end);
+            for (int i = 0; i < progress.layerCount; i++)
+            {
+                ClearBits(&progress.layers[((progress.oldestLayer + i) % COMBO_MAX_LAYERS) * m_words], begin, end);
+            }
+        }
+    }
+
+    uint64_t any = 0;
+    uint64_t holding = 0;
+    for (size_t word = 0; word < m_words; word++)
+    {
+        any |= reached[word];
+        holding |= reached[word] & m_holdSourceSteps[word];
+    }
+    if (any != 0)
+    {
+        // Full: the oldest progress makes room
+        if (progress.layerCount == COMBO_MAX_LAYERS)
+        {
+            progress.oldestLayer = (progress.oldestLayer + 1) % COMBO_MAX_LAYERS;
+            progress.layerCount--;
+        }
+
+        int layer = (progress.oldestLayer + progress.layerCount) % COMBO_MAX_LAYERS;
+        std::memcpy(&progress.layers[layer * m_words], reached, m_words * sizeof(uint64_t));
+        progress.layerNs[layer] = nowNs;
+        progress.layerHoldStage[layer] = holding != 0 ? 0 : (uint16_t)m_holdThresholdsNs.size();
+        progress.layerCount++;
+    }
+
+    if (!m_completed.empty() && m_callback)
+    {
+        m_callback(m_completed.data(), m_completed.size());
+    }
+    return m_completed.size();
+}
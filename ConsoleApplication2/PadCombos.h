@@ -0,0 +1,168 @@
+// =================================================================================================
+// Combo and gesture recognition over the decoded pad state: chords, sequences such as fighting-game
+// motions, taps, double taps and holds. The definitions are compiled into bit tables with one bit
+// per step of every combo, and each report advances all combos of its pad at once, shift-and
+// style, a machine word of steps per operation. Reports that change no input cost a compare.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "PadState.h"
+#include "CDeviceRegistry.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Inputs a step looks at: the EPadButton bits, then one bit per hat value, neutral included, so a
+// direction is entered and left like a button
+const int COMBO_INPUT_HAT_SHIFT = 16;
+const int COMBO_INPUT_BITS = COMBO_INPUT_HAT_SHIFT + PAD_HAT_NEUTRAL + 1;
+const uint32_t COMBO_INPUT_BUTTONS = (1u << PAD_BUTTON_COUNT) - 1;
+const uint32_t COMBO_INPUT_HATS = ((1u << (PAD_HAT_NEUTRAL + 1)) - 1) << COMBO_INPUT_HAT_SHIFT;
+
+const size_t COMBO_MAX_STEPS = 16;
+const uint16_t COMBO_DEFAULT_STEP_MAX_MS = 500;     // SComboStep::maxMs 0
+const uint16_t COMBO_MAX_STEP_MS = 10000;
+
+// Reports that moved combos forward and are still inside a step window, per pad; past it the
+// oldest progress is dropped
+const int COMBO_MAX_LAYERS = 32;
+
+enum EComboStepKind
+{
+	COMBO_STEP_PRESS,           // the last of the inputs goes down while the others are held
+	COMBO_STEP_RELEASE,         // the last of the inputs goes up
+	COMBO_STEP_HOLD             // the inputs are still held minMs after the step before
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// The timing is counted from the step before and ignored on the first step. A HOLD is seen on the
+// first report at or past minMs, so it needs a pad that keeps reporting while it rests.
+struct SComboStep
+{
+	uint32_t inputs;            // ComboButton / ComboHat bits
+	uint8_t kind;               // EComboStepKind
+	uint16_t minMs;
+	uint16_t maxMs;             // 0 = COMBO_DEFAULT_STEP_MAX_MS past minMs
+};
+
+struct SComboDefinition
+{
+	uint32_t id;                // handed back in SComboEvent
+	std::vector<SComboStep> steps;
+};
+
+struct SComboEvent
+{
+	uint64_t timestampNs;       // of the report that completed the combo
+	uint32_t id;
+	uint8_t playerIndex;
+};
+
+class CPadComboEngine
+{
+public:
+   CPadComboEngine();
+
+   // Configuration, before input starts flowing. False, with nothing compiled, when a definition
+   // has no steps or more than COMBO_MAX_STEPS, no inputs, a HOLD first, a HOLD of 0 ms or a
+   // window past COMBO_MAX_STEP_MS.
+   bool Compile(const std::vector<SComboDefinition>& combos);
+   void SetCallback(std::function<void(const SComboEvent*, size_t)> callback);
+   size_t GetComboCount() const { return m_comboIds.size(); }
+
+   // Drops the progress of the player; its next state counts from a released pad
+   void Reset(int playerIndex);
+
+   // Advances every combo on the player's new state and calls back with the ones it completed, in
+   // definition order; returns their number. A completed combo starts over.
+   size_t Process(int playerIndex, const SPadState& state);
+
+private:
+   struct SPlayerProgress
+   {
+      std::vector<uint64_t> layers;               // COMBO_MAX_LAYERS rings of m_words words
+      uint64_t layerNs[COMBO_MAX_LAYERS];
+      uint16_t layerHoldStage[COMBO_MAX_LAYERS];  // HOLD minimums the layer has passed, all of them
+                                                  // once it holds no step a HOLD follows
+      int oldestLayer;
+      int layerCount;
+      uint32_t previousInputs;
+   };
+
+   uint64_t* Table(std::vector<uint64_t>& table, size_t row) { return &table[row * m_words]; }
+   int FindInterval(uint64_t ageNs) const;
+   void AdvanceLayers(SPlayerProgress& progress, uint64_t nowNs, const uint64_t* satisfied, const uint64_t* cancelled);
+   size_t Complete(int playerIndex, SPlayerProgress& progress, uint64_t nowNs);
+
+
+   size_t m_words;                                 // 64-bit words of one bit per step
+   std::vector<uint32_t> m_comboIds;
+   std::vector<uint32_t> m_comboFirst;             // first step bit of each combo, one past the end last
+   std::vector<uint32_t> m_stepCombo;              // combo of each step bit
+
+   // One row per input bit: the steps the input takes part in
+   std::vector<uint64_t> m_press;
+   std::vector<uint64_t> m_pressChord;             // PRESS steps of more than one input
+   std::vector<uint64_t> m_release;
+   std::vector<uint64_t> m_releaseChord;
+   std::vector<uint64_t> m_hold;
+   std::vector<uint64_t> m_holdSource;             // steps followed by a HOLD of the input
+   uint32_t m_pressChordInputs;                    // inputs with a non-empty row, nothing else is looked at
+   uint32_t m_releaseChordInputs;
+   uint32_t m_holdInputs;
+
+   std::vector<uint64_t> m_first;
+   std::vector<uint64_t> m_last;
+   std::vector<uint64_t> m_holdSteps;
+   std::vector<uint64_t> m_holdSourceSteps;        // steps followed by a HOLD
+
+   // Ages at which some step window opens or closes; row k holds the steps that may be followed
+   // at an age from m_boundariesNs[k] up to the next boundary, and the steps still inside their
+   // window then
+   std::vector<uint64_t> m_boundariesNs;
+   std::vector<uint64_t> m_open;
+   std::vector<uint64_t> m_alive;
+   std::vector<uint64_t> m_holdThresholdsNs;       // distinct HOLD minimums, ascending
+
+   SPlayerProgress m_players[MAX_CONTROLLERS];
+   std::vector<uint64_t> m_scratch;                // 3 * m_words for one report's work
+   std::vector<SComboEvent> m_completed;
+   std::function<void(const SComboEvent*, size_t)> m_callback;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ComboButton
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline uint32_t ComboButton(EPadButton button)
+{
+	return 1u << button;
+}
+
+// =================================================================================================
+// ComboHat                 a hat value, PAD_HAT_NEUTRAL for the released hat
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline uint32_t ComboHat(uint8_t hat)
+{
+	return 1u << (COMBO_INPUT_HAT_SHIFT + (hat <= PAD_HAT_NEUTRAL ? hat : PAD_HAT_NEUTRAL));
+}
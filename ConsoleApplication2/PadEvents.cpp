@@ -0,0 +1,263 @@
+// =================================================================================================
+// Change-driven pad events: each decoded state is compared with the previous one of its pad word
+// by word, and only what changed is raised as typed events, button down and up, hat and axes moved
+// past a threshold, to the subscribers of those fields.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "PadEvents.h"
+#include <cstddef>
+#include <cstring>
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int PAD_STATE_WORDS = sizeof(SPadState) / sizeof(uint64_t);
+
+// The bits of each little-endian 64-bit word of SPadState that can raise an event: the buttons in
+// the upper half of word 1, the four sticks in word 2, the triggers and the hat in word 3.
+// Timestamp, sequence, motion and touch change with every report and are masked out.
+static const uint64_t PAD_EVENT_WORD_MASKS[PAD_STATE_WORDS] =
+{
+    0,
+    0xFFFFFFFF00000000ull,
+    0xFFFFFFFFFFFFFFFFull,
+    0x000000FFFFFFFFFFull,
+    0, 0, 0, 0
+};
+
+static_assert(offsetof(SPadState, buttons) == 12, "PAD_EVENT_WORD_MASKS expects the buttons in bytes 12..15");
+static_assert(offsetof(SPadState, leftX) == 16 && offsetof(SPadState, R2) == 26, "PAD_EVENT_WORD_MASKS expects the axes in bytes 16..27");
+static_assert(offsetof(SPadState, hat) == 28, "PAD_EVENT_WORD_MASKS expects the hat in byte 28");
+static_assert(PAD_EVENT_ALL_PLAYERS >> (MAX_CONTROLLERS - 1) != 0, "SPadEventSubscription::players has a bit per player");
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CPadEventDispatcher
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CPadEventDispatcher::CPadEventDispatcher() :
+    m_subscribedButtons(0),
+    m_subscribedAxes(0),
+    m_subscribedHat(false)
+{
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        m_axisThreshold[axis] = PAD_EVENT_DEFAULT_AXIS_THRESHOLD;
+    }
+    for (int playerIndex = 0; playerIndex < MAX_CONTROLLERS; playerIndex++)
+    {
+        Reset(playerIndex);
+    }
+}
+
+// =================================================================================================
+// SetAxisThreshold         0 raises an event for every step
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadEventDispatcher::SetAxisThreshold(EAxis axis, uint16_t threshold)
+{
+    if (axis < 0 || axis >= AXIS_COUNT)
+    {
+        return;
+    }
+    m_axisThreshold[axis] = threshold != 0 ? threshold : 1;
+}
+
+// =================================================================================================
+// Subscribe
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadEventDispatcher::Subscribe(const SPadEventSubscription& subscription)
+{
+    if (!subscription.callback)
+    {
+        return;
+    }
+
+    m_subscriptions.push_back(subscription);
+    m_subscribedButtons |= subscription.buttons & PAD_EVENT_ALL_BUTTONS;
+    m_subscribedAxes |= subscription.axes & PAD_EVENT_ALL_AXES;
+    m_subscribedHat = m_subscribedHat || subscription.hat;
+}
+
+// =================================================================================================
+// Reset
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CPadEventDispatcher::Reset(int playerIndex)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS)
+    {
+        return;
+    }
+
+    m_previous[playerIndex] = SPadState();
+    m_previous[playerIndex].hat = PAD_HAT_NEUTRAL;
+    m_started[playerIndex] = false;
+}
+
+// =================================================================================================
+// Process                  a resting pad repeats its buttons, sticks and hat report after report,
+//                          so three masked XORs settle most states. Only a change walks the
+//                          fields, and only the subscribed ones.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t CPadEventDispatcher::Process(int playerIndex, const SPadState& state)
+{
+    if (playerIndex < 0 || playerIndex >= MAX_CONTROLLERS || m_subscriptions.empty())
+    {
+        return 0;
+    }
+
+    SPadState& previous = m_previous[playerIndex];
+    const uint16_t* axes = &state.leftX;
+    uint16_t* raisedAxes = m_raisedAxes[playerIndex];
+    if (!m_started[playerIndex])
+    {
+        std::memcpy(&previous.leftX, axes, AXIS_COUNT * sizeof(uint16_t));
+        std::memcpy(raisedAxes, axes, AXIS_COUNT * sizeof(uint16_t));
+        m_started[playerIndex] = true;
+    }
+
+    uint64_t currentWords[PAD_STATE_WORDS];
+    uint64_t previousWords[PAD_STATE_WORDS];
+    std::memcpy(currentWords, &state, sizeof(currentWords));
+    std::memcpy(previousWords, &previous, sizeof(previousWords));
+
+    uint64_t changed = 0;
+    for (int word = 0; word < PAD_STATE_WORDS; word++)
+    {
+        changed |= (currentWords[word] ^ previousWords[word]) & PAD_EVENT_WORD_MASKS[word];
+    }
+    if (changed == 0)
+    {
+        return 0;
+    }
+
+    SPadEvent events[PAD_EVENT_MAX_PER_REPORT];
+    size_t count = 0;
+    SPadEvent event = SPadEvent();
+    event.timestampNs = state.timestampNs;
+    event.playerIndex = (uint8_t)playerIndex;
+
+    SPadEdges edges = GetPadEdges(previous.buttons, state.buttons);
+    uint32_t buttonChanges = (edges.pressed | edges.released) & m_subscribedButtons;
+    while (buttonChanges != 0)
+    {
+        int button = 0;
+        while (((buttonChanges >> button) & 1) == 0)
+        {
+            button++;
+        }
+        buttonChanges &= buttonChanges - 1;
+
+        bool down = ((edges.pressed >> button) & 1) != 0;
+        event.type = down ? PAD_EVENT_BUTTON_DOWN : PAD_EVENT_BUTTON_UP;
+        event.code = (uint8_t)button;
+        event.value = down ? 1 : 0;
+        event.previous = down ? 0 : 1;
+        events[count++] = event;
+    }
+
+    if (m_subscribedHat && state.hat != previous.hat)
+    {
+        event.type = PAD_EVENT_HAT;
+        event.code = 0;
+        event.value = state.hat;
+        event.previous = previous.hat;
+        events[count++] = event;
+    }
+
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        if (((m_subscribedAxes >> axis) & 1) == 0)
+        {
+            continue;
+        }
+
+        uint16_t value = axes[axis];
+        uint16_t raised = raisedAxes[axis];
+        int distance = value > raised ? value - raised : raised - value;
+        bool atEnd = value != raised && (value == 0 || value == 255);
+        if (distance >= m_axisThreshold[axis] || atEnd)
+        {
+            event.type = PAD_EVENT_AXIS;
+            event.code = (uint8_t)axis;
+            event.value = value;
+            event.previous = raised;
+            events[count++] = event;
+            raisedAxes[axis] = value;
+        }
+    }
+
+    previous = state;
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // Each subscriber gets its own events in report order, in one call
+    unsigned int playerBit = 1u << playerIndex;
+    for (const SPadEventSubscription& subscription : m_subscriptions)
+    {
+        if ((subscription.players & playerBit) == 0)
+        {
+            continue;
+        }
+
+        // A subscriber to every subscribed field takes the events as they are
+        if ((m_subscribedButtons & ~subscription.buttons) == 0 && (m_subscribedAxes & ~subscription.axes) == 0 &&
+            (subscription.hat || !m_subscribedHat))
+        {
+            subscription.callback(events, count);
+            continue;
+        }
+
+        SPadEvent selected[PAD_EVENT_MAX_PER_REPORT];
+        size_t selectedCount = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            const SPadEvent& candidate = events[i];
+            bool wanted = false;
+            switch (candidate.type)
+            {
+                case PAD_EVENT_BUTTON_DOWN:
+                case PAD_EVENT_BUTTON_UP:
+                    wanted = ((subscription.buttons >> candidate.code) & 1) != 0;
+                    break;
+
+                case PAD_EVENT_HAT:
+                    wanted = subscription.hat;
+                    break;
+
+                case PAD_EVENT_AXIS:
+                    wanted = ((subscription.axes >> candidate.code) & 1) != 0;
+                    break;
+            }
+            if (wanted)
+            {
+                selected[selectedCount++] = candidate;
+            }
+        }
+
+        if (selectedCount != 0)
+        {
+            subscription.callback(selected, selectedCount);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,98 @@
+// =================================================================================================
+// Change-driven pad events: each decoded state is compared with the previous one of its pad word
+// by word, and only what changed is raised as typed events, button down and up, hat and axes moved
+// past a threshold, to the subscribers of those fields.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "PadState.h"
+#include "AxisProcessing.h"
+#include "CDeviceRegistry.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+enum EPadEventType
+{
+	PAD_EVENT_BUTTON_DOWN,      // code is the EPadButton
+	PAD_EVENT_BUTTON_UP,
+	PAD_EVENT_HAT,              // value and previous are hat values, PAD_HAT_NEUTRAL when released
+	PAD_EVENT_AXIS              // code is the EAxis, value and previous the raw axis values
+};
+
+// Every button, the hat and every axis at once
+const int PAD_EVENT_MAX_PER_REPORT = PAD_BUTTON_COUNT + 1 + AXIS_COUNT;
+
+// Raw steps an axis has to move from the value last raised. 2 hides the one-step noise of a
+// resting DS4 stick; reaching 0 or 255, the ends of the Sony pads' range, raises an event regardless.
+const uint16_t PAD_EVENT_DEFAULT_AXIS_THRESHOLD = 2;
+
+const uint32_t PAD_EVENT_ALL_BUTTONS = (1u << PAD_BUTTON_COUNT) - 1;
+const uint8_t PAD_EVENT_ALL_AXES = (1u << AXIS_COUNT) - 1;
+const uint8_t PAD_EVENT_ALL_PLAYERS = 0xFF;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SPadEvent
+{
+	uint64_t timestampNs;       // of the report that raised it
+	uint8_t type;               // EPadEventType
+	uint8_t playerIndex;
+	uint8_t code;               // EPadButton or EAxis, 0 for the hat
+	uint8_t reserved;
+	uint16_t value;             // 1 down and 0 up for buttons
+	uint16_t previous;
+};
+
+// The fields one consumer cares about; the callback gets only their events, once per report
+struct SPadEventSubscription
+{
+	uint32_t buttons = 0;                   // EPadButton bits
+	uint8_t axes = 0;                       // EAxis bits
+	bool hat = false;
+	uint8_t players = PAD_EVENT_ALL_PLAYERS; // player index bits
+	std::function<void(const SPadEvent*, size_t)> callback;
+};
+
+class CPadEventDispatcher
+{
+public:
+   CPadEventDispatcher();
+
+   // Configuration, before input starts flowing
+   void SetAxisThreshold(EAxis axis, uint16_t threshold);
+   void Subscribe(const SPadEventSubscription& subscription);
+   bool HasSubscriptions() const { return !m_subscriptions.empty(); }
+
+   // The next state of the player counts from a released pad: held buttons and a pressed hat
+   // raise events, the axes start where they are
+   void Reset(int playerIndex);
+
+   // Compares a state with the previous one of its player and calls the subscribers of what
+   // changed; returns the number of events raised
+   size_t Process(int playerIndex, const SPadState& state);
+
+private:
+   std::vector<SPadEventSubscription> m_subscriptions;
+   uint32_t m_subscribedButtons;   // union over the subscriptions, nothing else is looked at
+   uint8_t m_subscribedAxes;
+   bool m_subscribedHat;
+   uint16_t m_axisThreshold[AXIS_COUNT];
+
+   SPadState m_previous[MAX_CONTROLLERS];
+   uint16_t m_raisedAxes[MAX_CONTROLLERS][AXIS_COUNT];     // values of the last axis events
+   bool m_started[MAX_CONTROLLERS];
+};
@@ -0,0 +1,84 @@
+// =================================================================================================
+// Output side of a pad: rumble motors and lightbar, the device handle the input source opens for
+// writing and the DualShock 4 output reports (USB 0x05, Bluetooth 0x11 with its CRC-32).
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "PadOutput.h"
+#include <cstring>
+#include "ByteOrder.h"
+#include "Crc32.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Valid-flags byte: motors, lightbar colour, lightbar flash
+const unsigned char DS4_OUTPUT_FLAGS = 0x07;
+
+// Bluetooth byte 1: HID and CRC present, 4 ms input interval as the Linux driver asks for
+const unsigned char DS4_OUTPUT_BT_HEADER = 0xC4;
+
+// The payload starts after the flags, 4 bytes into the USB report and 6 into the Bluetooth one
+const size_t DS4_OUTPUT_USB_PAYLOAD = 4;
+const size_t DS4_OUTPUT_BT_PAYLOAD = 6;
+const size_t DS4_OUTPUT_BT_FLAGS_OFFSET = 3;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// BuildDs4OutputReport
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+size_t BuildDs4OutputReport(const SPadOutput& output, bool bluetooth, unsigned char* report)
+{
+    size_t size = bluetooth ? DS4_OUTPUT_BT_SIZE : DS4_OUTPUT_USB_SIZE;
+    std::memset(report, 0, size);
+
+    size_t payload;
+    if (bluetooth)
+    {
+        report[0] = DS4_OUTPUT_BT_REPORT_ID;
+        report[1] = DS4_OUTPUT_BT_HEADER;
+        report[DS4_OUTPUT_BT_FLAGS_OFFSET] = DS4_OUTPUT_FLAGS;
+        payload = DS4_OUTPUT_BT_PAYLOAD;
+    }
+    else
+    {
+        report[0] = DS4_OUTPUT_USB_REPORT_ID;
+        report[1] = DS4_OUTPUT_FLAGS;
+        payload = DS4_OUTPUT_USB_PAYLOAD;
+    }
+
+    report[payload + 0] = output.weakMotor;
+    report[payload + 1] = output.strongMotor;
+    report[payload + 2] = output.red;
+    report[payload + 3] = output.green;
+    report[payload + 4] = output.blue;
+    report[payload + 5] = output.flashOn;
+    report[payload + 6] = output.flashOff;
+
+    if (bluetooth)
+    {
+        StoreLe32(&report[size - 4], Crc32Report(CRC32_SEED_BT_OUTPUT, report, size - 4));
+    }
+    return size;
+}
+
+// =================================================================================================
+// Ds4FlashSteps
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+uint8_t Ds4FlashSteps(unsigned int ms)
+{
+    unsigned int steps = (ms + DS4_FLASH_UNIT_MS - 1) / DS4_FLASH_UNIT_MS;
+    return (uint8_t)(steps > 255 ? 255 : steps);
+}
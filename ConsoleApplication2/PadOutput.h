@@ -0,0 +1,73 @@
+// =================================================================================================
+// Output side of a pad: rumble motors and lightbar, the device handle the input source opens for
+// writing and the DualShock 4 output reports (USB 0x05, Bluetooth 0x11 with its CRC-32).
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const unsigned char DS4_OUTPUT_USB_REPORT_ID = 0x05;
+const unsigned char DS4_OUTPUT_BT_REPORT_ID = 0x11;
+const size_t DS4_OUTPUT_USB_SIZE = 32;
+const size_t DS4_OUTPUT_BT_SIZE = 78;               // CRC-32 in the last four bytes
+const size_t PAD_OUTPUT_MAX_REPORT_SIZE = DS4_OUTPUT_BT_SIZE;
+
+// The DS4 counts flash times in 10 ms steps
+const unsigned int DS4_FLASH_UNIT_MS = 10;
+
+// Parts of SPadOutput an update carries; the others keep their last value
+enum EPadOutputField
+{
+	PAD_OUTPUT_RUMBLE = 0x01,
+	PAD_OUTPUT_LIGHTBAR = 0x02,
+	PAD_OUTPUT_FLASH = 0x04,
+	PAD_OUTPUT_ALL = 0x07
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// What the pad is told to do, in the units of its output report
+struct SPadOutput
+{
+	uint8_t strongMotor;        // left, heavy motor
+	uint8_t weakMotor;          // right, light motor
+	uint8_t red;
+	uint8_t green;
+	uint8_t blue;
+	uint8_t flashOn;            // DS4_FLASH_UNIT_MS steps, both 0 = steady light
+	uint8_t flashOff;
+};
+
+// Where the output reports of one device go; opened by the input source next to its input handle
+class IPadOutputDevice
+{
+public:
+   virtual ~IPadOutputDevice() {}
+
+   // One output report, report ID first. Only the writer thread calls it, so it may block for as
+   // long as the device takes. False when the device refused the report or is gone.
+   virtual bool Write(const unsigned char* report, size_t length) = 0;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// The whole state in one report, every part flagged valid; report has room for
+// PAD_OUTPUT_MAX_REPORT_SIZE bytes, the size written is returned
+size_t BuildDs4OutputReport(const SPadOutput& output, bool bluetooth, unsigned char* report);
+
+// Milliseconds to DS4_FLASH_UNIT_MS steps, rounded up so a short flash does not turn steady
+uint8_t Ds4FlashSteps(unsigned int ms);
@@ -0,0 +1,88 @@
+// =================================================================================================
+// Compact pad state: 16-bit axes, a button bitmask, a hat nibble and room for motion and touch,
+// one cache line per sample. JSDATA stays the legacy view and converts both ways.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "PadState.h"
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ClampAxis
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint16_t ClampAxis(int32_t value)
+{
+    if (value < 0)
+    {
+        return 0;
+    }
+    return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+// =================================================================================================
+// PadStateFromJsData
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void PadStateFromJsData(const JSDATA& jsData, SPadState& state)
+{
+    state.leftX = ClampAxis(jsData.leftX);
+    state.leftY = ClampAxis(jsData.leftY);
+    state.rightX = ClampAxis(jsData.rightX);
+    state.rightY = ClampAxis(jsData.rightY);
+    state.L2 = ClampAxis(jsData.L2);
+    state.R2 = ClampAxis(jsData.R2);
+    state.hat = jsData.arrowValue >= 0 && jsData.arrowValue < PAD_HAT_NEUTRAL ? (uint8_t)jsData.arrowValue : PAD_HAT_NEUTRAL;
+
+    uint32_t buttons = state.buttons & ~PAD_LEGACY_BUTTONS_MASK;
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        buttons |= (uint32_t)jsData.HandlePressed[i] << i;
+    }
+    state.buttons = buttons;
+}
+
+// =================================================================================================
+// PadStateToJsData
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void PadStateToJsData(const SPadState& state, JSDATA& jsData)
+{
+    jsData.leftX = state.leftX;
+    jsData.leftY = state.leftY;
+    jsData.rightX = state.rightX;
+    jsData.rightY = state.rightY;
+    jsData.L2 = state.L2;
+    jsData.R2 = state.R2;
+    jsData.arrowValue = state.hat;
+
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        jsData.HandlePressed[i] = ((state.buttons >> i) & 1) != 0;
+    }
+}
+
+// =================================================================================================
+// PadStateFromSample       a delivered sample as a fresh pad state, no motion or touch
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void PadStateFromSample(const SJoystickSample& sample, SPadState& state)
+{
+    state = SPadState();
+    state.timestampNs = sample.timestampNs;
+    state.sequence = (uint32_t)sample.sequence;
+    state.playerIndex = (uint8_t)sample.playerIndex;
+    PadStateFromJsData(sample.data, state);
+}
@@ -0,0 +1,132 @@
+// =================================================================================================
+// Compact pad state: 16-bit axes, a button bitmask, a hat nibble and room for motion and touch,
+// one cache line per sample. JSDATA stays the legacy view and converts both ways.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include "JSData.h"
+#include "CSpscRing.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Bits of SPadState::buttons. The first BUTTONS_NUM follow HandlePressed, the rest are the buttons
+// JSDATA has no room for.
+enum EPadButton
+{
+	PAD_BUTTON_SQUARE,
+	PAD_BUTTON_CROSS,
+	PAD_BUTTON_CIRCLE,
+	PAD_BUTTON_TRIANGLE,
+	PAD_BUTTON_L1,
+	PAD_BUTTON_R1,
+	PAD_BUTTON_L2,
+	PAD_BUTTON_R2,
+	PAD_BUTTON_SHARE,
+	PAD_BUTTON_OPTIONS,
+	PAD_BUTTON_L3,
+	PAD_BUTTON_R3,
+	PAD_BUTTON_PS,
+	PAD_BUTTON_TOUCHPAD,
+	PAD_BUTTON_MUTE,            // DualSense only
+	PAD_BUTTON_COUNT
+};
+
+const uint32_t PAD_LEGACY_BUTTONS_MASK = (1u << BUTTONS_NUM) - 1;
+
+// Hat values as the pads report them, 0 = up going clockwise to 7 = up-left
+const uint8_t PAD_HAT_NEUTRAL = 8;
+
+const int PAD_TOUCH_POINTS = 2;
+
+// SPadState::flags
+const uint8_t PAD_FLAG_MOTION = 0x01;       // gyro and accel hold a reading
+const uint8_t PAD_FLAG_TOUCH = 0x02;        // touch holds a reading
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SPadTouch
+{
+	uint16_t x;
+	uint16_t y;
+	uint8_t id;                 // changes with every new finger
+	uint8_t active;
+};
+
+// One sample of a pad in one cache line; trivially copyable, zero is a valid idle state
+struct alignas(CACHE_LINE_SIZE) SPadState
+{
+	uint64_t timestampNs;       // MonotonicNowNs() when the report was decoded
+	uint32_t sequence;          // low 32 bits of SJoystickSample::sequence
+	uint32_t buttons;           // EPadButton bits
+	uint16_t leftX;
+	uint16_t leftY;
+	uint16_t rightX;
+	uint16_t rightY;
+	uint16_t L2;
+	uint16_t R2;
+	uint8_t hat;                // low nibble, PAD_HAT_NEUTRAL when released
+	uint8_t playerIndex;
+	uint8_t flags;              // PAD_FLAG_*
+	uint8_t battery;            // percent, 0 when the report has none
+	int16_t gyro[3];            // raw sensor units until calibrated
+	int16_t accel[3];
+	uint16_t sensorTimestamp;   // the pad's own clock, wraps
+	SPadTouch touch[PAD_TOUCH_POINTS];
+};
+
+static_assert(sizeof(SPadState) == CACHE_LINE_SIZE, "SPadState must stay one cache line");
+
+// Buttons that went down and up between two states
+struct SPadEdges
+{
+	uint32_t pressed;
+	uint32_t released;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// GetPadEdges              one XOR finds every changed button, the new and old state split it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline SPadEdges GetPadEdges(uint32_t previousButtons, uint32_t currentButtons)
+{
+	uint32_t changed = previousButtons ^ currentButtons;
+	SPadEdges edges = { changed & currentButtons, changed & previousButtons };
+	return edges;
+}
+
+// =================================================================================================
+// IsPadButtonDown
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline bool IsPadButtonDown(const SPadState& state, EPadButton button)
+{
+	return (state.buttons >> button) & 1;
+}
+
+// =================================================================================================
+// ===================================== FUNCTION PROTOTYPES =======================================
+
+// Axes outside 0..65535 are clamped, a hat outside 0..7 becomes PAD_HAT_NEUTRAL. Timestamp,
+// sequence, player, motion and touch are left as they are.
+void PadStateFromJsData(const JSDATA& jsData, SPadState& state);
+
+// The buttons past BUTTONS_NUM have no JSDATA field and are dropped
+void PadStateToJsData(const SPadState& state, JSDATA& jsData);
+
+void PadStateFromSample(const SJoystickSample& sample, SPadState& state);
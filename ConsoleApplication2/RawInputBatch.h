@@ -0,0 +1,138 @@
+// =================================================================================================
+// Walks the packed RAWINPUT blocks returned by GetRawInputBuffer without touching the Win32 API,
+// so the batching logic can be driven from synthetic buffers on any platform.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint32_t RAW_INPUT_TYPE_HID = 2;             // RIM_TYPEHID
+
+// NEXTRAWINPUTBLOCK aligns every block to the pointer size (QWORD on 64-bit, DWORD on 32-bit)
+const size_t RAW_INPUT_BLOCK_ALIGNMENT = sizeof(void*);
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// Same layout as RAWINPUTHEADER
+struct SRawInputHeader
+{
+	uint32_t type;
+	uint32_t size;          // whole block: header, HID header and report bytes
+	void* device;
+	uintptr_t wParam;
+};
+
+// Same layout as the fixed part of RAWHID, the report bytes follow
+struct SRawHidHeader
+{
+	uint32_t reportSize;
+	uint32_t reportCount;
+};
+
+// One HID block of a batch: reportCount reports of reportSize bytes each
+struct SRawInputBlock
+{
+	void* device;
+	const unsigned char* reports;
+	uint32_t reportSize;
+	uint32_t reportCount;
+};
+
+const size_t RAW_HID_DATA_OFFSET = sizeof(SRawInputHeader) + sizeof(SRawHidHeader);
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// AlignRawInputOffset
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline size_t AlignRawInputOffset(size_t offset)
+{
+	return (offset + RAW_INPUT_BLOCK_ALIGNMENT - 1) & ~(RAW_INPUT_BLOCK_ALIGNMENT - 1);
+}
+
+// =================================================================================================
+// ForEachRawInputBlock     call onBlock(const SRawInputBlock&) for every HID block of a packed
+//                          buffer. The buffer must start on a RAW_INPUT_BLOCK_ALIGNMENT boundary.
+//                          Stops at the first block that does not fit; returns the blocks visited.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename F>
+size_t ForEachRawInputBlock(const void* buffer, size_t bufferSize, size_t blockCount, F&& onBlock)
+{
+	const unsigned char* bytes = (const unsigned char*)buffer;
+	size_t offset = 0;
+	size_t visited = 0;
+
+	for (; visited < blockCount; visited++)
+	{
+		if (offset + sizeof(SRawInputHeader) > bufferSize)
+		{
+			break;
+		}
+
+		SRawInputHeader header;
+		std::memcpy(&header, bytes + offset, sizeof(header));
+		if (header.size < sizeof(SRawInputHeader) || offset + header.size > bufferSize)
+		{
+			break;
+		}
+
+		if (header.type == RAW_INPUT_TYPE_HID && header.size >= RAW_HID_DATA_OFFSET)
+		{
+			SRawHidHeader hid;
+			std::memcpy(&hid, bytes + offset + sizeof(SRawInputHeader), sizeof(hid));
+
+			uint64_t dataSize = (uint64_t)hid.reportSize * hid.reportCount;
+			if (RAW_HID_DATA_OFFSET + dataSize <= header.size)
+			{
+				SRawInputBlock block = { header.device, bytes + offset + RAW_HID_DATA_OFFSET, hid.reportSize, hid.reportCount };
+				onBlock(block);
+			}
+		}
+
+		offset = AlignRawInputOffset(offset + header.size);
+	}
+
+	return visited;
+}
+
+// =================================================================================================
+// AppendRawInputBlock      pack one HID block the way GetRawInputBuffer does, for replay and
+//                          synthetic input
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline void AppendRawInputBlock(std::vector<unsigned char>& buffer, void* device, const unsigned char* reports, uint32_t reportSize, uint32_t reportCount)
+{
+	size_t offset = AlignRawInputOffset(buffer.size());
+	size_t blockSize = RAW_HID_DATA_OFFSET + (size_t)reportSize * reportCount;
+	buffer.resize(offset + blockSize);
+
+	SRawInputHeader header = { RAW_INPUT_TYPE_HID, (uint32_t)blockSize, device, 0 };
+	SRawHidHeader hid = { reportSize, reportCount };
+	std::memcpy(&buffer[offset], &header, sizeof(header));
+	std::memcpy(&buffer[offset + sizeof(header)], &hid, sizeof(hid));
+	if (blockSize > RAW_HID_DATA_OFFSET)
+	{
+		std::memcpy(&buffer[offset + RAW_HID_DATA_OFFSET], reports, blockSize - RAW_HID_DATA_OFFSET);
+	}
+}
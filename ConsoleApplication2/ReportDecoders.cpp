@@ -0,0 +1,422 @@
+// =================================================================================================
+// Direct decoders for pads with a known input report layout, bypassing the HidP_* parser.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "ReportDecoders.h"
+#include "ReportLayouts.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Buttons are numbered like the HID button usages: HandlePressed[usage - 1].
+// Byte 5 holds the hat in the low nibble and square/cross/circle/triangle in the high nibble,
+// byte 6 holds L1 R1 L2 R2 share options L3 R3.
+static constexpr SReportLayout<9> DS4_USB_LAYOUT =
+{
+    DS4_USB_REPORT_ID, 10, false, 0,
+    {
+        { 1, 0, 8, false, JSFIELD_LEFT_X, 0 },
+        { 2, 0, 8, false, JSFIELD_LEFT_Y, 0 },
+        { 3, 0, 8, false, JSFIELD_RIGHT_X, 0 },
+        { 4, 0, 8, false, JSFIELD_RIGHT_Y, 0 },
+        { 5, 0, 4, false, JSFIELD_ARROW, 0 },
+        { 5, 4, 4, false, JSFIELD_BUTTONS, 0 },
+        { 6, 0, 8, false, JSFIELD_BUTTONS, 4 },
+        { 8, 0, 8, false, JSFIELD_L2, 0 },
+        { 9, 0, 8, false, JSFIELD_R2, 0 },
+    }
+};
+
+// Same payload as USB behind two extra header bytes, CRC-32 in the last four bytes of the report
+static constexpr SReportLayout<9> DS4_BT_LAYOUT =
+{
+    DS4_BT_REPORT_ID, 78, true, CRC32_SEED_BT_INPUT,
+    {
+        { 3, 0, 8, false, JSFIELD_LEFT_X, 0 },
+        { 4, 0, 8, false, JSFIELD_LEFT_Y, 0 },
+        { 5, 0, 8, false, JSFIELD_RIGHT_X, 0 },
+        { 6, 0, 8, false, JSFIELD_RIGHT_Y, 0 },
+        { 7, 0, 4, false, JSFIELD_ARROW, 0 },
+        { 7, 4, 4, false, JSFIELD_BUTTONS, 0 },
+        { 8, 0, 8, false, JSFIELD_BUTTONS, 4 },
+        { 10, 0, 8, false, JSFIELD_L2, 0 },
+        { 11, 0, 8, false, JSFIELD_R2, 0 },
+    }
+};
+
+// Triggers follow the sticks, the hat/button bytes come after the report counter
+static constexpr SReportLayout<9> DUALSENSE_USB_LAYOUT =
+{
+    DUALSENSE_USB_REPORT_ID, 10, false, 0,
+    {
+        { 1, 0, 8, false, JSFIELD_LEFT_X, 0 },
+        { 2, 0, 8, false, JSFIELD_LEFT_Y, 0 },
+        { 3, 0, 8, false, JSFIELD_RIGHT_X, 0 },
+        { 4, 0, 8, false, JSFIELD_RIGHT_Y, 0 },
+        { 5, 0, 8, false, JSFIELD_L2, 0 },
+        { 6, 0, 8, false, JSFIELD_R2, 0 },
+        { 8, 0, 4, false, JSFIELD_ARROW, 0 },
+        { 8, 4, 4, false, JSFIELD_BUTTONS, 0 },
+        { 9, 0, 8, false, JSFIELD_BUTTONS, 4 },
+    }
+};
+
+// Where the pad-state decoders find each group of fields. The hat shares its byte with the face
+// buttons, the byte after holds the shoulder buttons, extraButtons holds PS, touchpad and mute.
+// Motion is the sensor clock, then gyro and accel as six int16; battery and touch follow further
+// on. An offset of 0 marks a group the decoder does not read.
+struct SPadReportOffsets
+{
+    unsigned char reportId;
+    size_t minLength;
+    bool hasCrc;
+    size_t sticks;
+    size_t triggers;
+    size_t hatButtons;
+    size_t extraButtons;
+    uint32_t extraMask;
+    size_t motion;
+    size_t battery;
+    size_t touch;
+};
+
+static constexpr SPadReportOffsets DS4_USB_OFFSETS = { DS4_USB_REPORT_ID, 10, false, 1, 8, 5, 7, 0x03, 10, 30, 35 };
+static constexpr SPadReportOffsets DS4_BT_OFFSETS = { DS4_BT_REPORT_ID, 78, true, 3, 10, 7, 9, 0x03, 12, 32, 37 };
+static constexpr SPadReportOffsets DUALSENSE_USB_OFFSETS = { DUALSENSE_USB_REPORT_ID, 11, false, 1, 5, 8, 10, 0x07, 0, 0, 0 };
+
+// Bytes between the report ID and the payload of a DS4 Bluetooth report
+const size_t DS4_BT_PAYLOAD_SHIFT = 2;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// LayoutIsShifted          compile-time check that every field of shifted sits shift bytes after
+//                          the same field of base
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <size_t N>
+constexpr bool LayoutIsShifted(const SReportLayout<N>& base, const SReportLayout<N>& shifted, size_t shift)
+{
+    for (size_t i = 0; i < N; i++)
+    {
+        const SReportField& a = base.fields[i];
+        const SReportField& b = shifted.fields[i];
+        if (b.offset != a.offset + shift || b.bitShift != a.bitShift || b.bitWidth != a.bitWidth ||
+            b.isSigned != a.isSigned || b.target != a.target || b.firstButton != a.firstButton)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =================================================================================================
+// OffsetsMatchLayout       compile-time check that the pad-state decoder reads sticks, triggers and
+//                          the hat byte where the JSDATA layout does
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <size_t N>
+constexpr bool OffsetsMatchLayout(const SPadReportOffsets& offsets, const SReportLayout<N>& layout)
+{
+    if (offsets.reportId != layout.reportId || offsets.hasCrc != layout.hasCrc || offsets.minLength < layout.minLength)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < N; i++)
+    {
+        const SReportField& field = layout.fields[i];
+        size_t expected = 0;
+        switch (field.target)
+        {
+            case JSFIELD_LEFT_X:  expected = offsets.sticks; break;
+            case JSFIELD_LEFT_Y:  expected = offsets.sticks + 1; break;
+            case JSFIELD_RIGHT_X: expected = offsets.sticks + 2; break;
+            case JSFIELD_RIGHT_Y: expected = offsets.sticks + 3; break;
+            case JSFIELD_L2:      expected = offsets.triggers; break;
+            case JSFIELD_R2:      expected = offsets.triggers + 1; break;
+            case JSFIELD_ARROW:   expected = offsets.hatButtons; break;
+            case JSFIELD_BUTTONS: expected = offsets.hatButtons + (field.firstButton == 0 ? 0 : 1); break;
+            default:              return false;
+        }
+        if (field.offset != expected)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(LayoutIsValid(DS4_USB_LAYOUT) && LayoutIsValid(DS4_BT_LAYOUT) && LayoutIsValid(DUALSENSE_USB_LAYOUT),
+              "report field lies outside its layout");
+static_assert(LayoutIsShifted(DS4_USB_LAYOUT, DS4_BT_LAYOUT, DS4_BT_PAYLOAD_SHIFT),
+              "DS4 Bluetooth fields must be the USB fields behind the two header bytes");
+static_assert(DS4_BT_LAYOUT.minLength == 78 && DS4_BT_LAYOUT.crcSeed == CRC32_SEED_BT_INPUT,
+              "DS4 Bluetooth CRC covers bytes 0..73 and is stored in 74..77");
+static_assert(OffsetsMatchLayout(DS4_USB_OFFSETS, DS4_USB_LAYOUT) && OffsetsMatchLayout(DS4_BT_OFFSETS, DS4_BT_LAYOUT) &&
+              OffsetsMatchLayout(DUALSENSE_USB_OFFSETS, DUALSENSE_USB_LAYOUT),
+              "pad-state offsets disagree with the JSDATA layout");
+static_assert(DS4_BT_OFFSETS.motion == DS4_USB_OFFSETS.motion + DS4_BT_PAYLOAD_SHIFT &&
+              DS4_BT_OFFSETS.battery == DS4_USB_OFFSETS.battery + DS4_BT_PAYLOAD_SHIFT &&
+              DS4_BT_OFFSETS.touch == DS4_USB_OFFSETS.touch + DS4_BT_PAYLOAD_SHIFT &&
+              DS4_BT_OFFSETS.extraButtons == DS4_USB_OFFSETS.extraButtons + DS4_BT_PAYLOAD_SHIFT,
+              "DS4 Bluetooth motion, battery and touch must be the USB ones behind the two header bytes");
+
+// =================================================================================================
+// ReadLe16
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint16_t ReadLe16(const unsigned char* bytes)
+{
+    return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+// =================================================================================================
+// DecodeTouchPoint         bit 7 of the first byte is set while no finger is down, the rest is the
+//                          finger's ID; then two 12-bit coordinates packed in three bytes
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void DecodeTouchPoint(const unsigned char* point, SPadTouch& touch)
+{
+    touch.active = (point[0] & 0x80) == 0;
+    touch.id = point[0] & 0x7F;
+    touch.x = (uint16_t)(point[1] | ((point[2] & 0x0F) << 8));
+    touch.y = (uint16_t)((point[2] >> 4) | (point[3] << 4));
+}
+
+// =================================================================================================
+// DecodePadReport          all buttons in three shifts and ORs, no per-button loop
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool DecodePadReport(const SPadReportOffsets& offsets, const unsigned char* report, size_t length, SPadState& state)
+{
+    if (report == nullptr || length < offsets.minLength || report[0] != offsets.reportId)
+    {
+        return false;
+    }
+    if (offsets.hasCrc)
+    {
+        size_t crcOffset = offsets.minLength - 4;
+        uint32_t expected = uint32_t(report[crcOffset]) | (uint32_t(report[crcOffset + 1]) << 8) |
+                            (uint32_t(report[crcOffset + 2]) << 16) | (uint32_t(report[crcOffset + 3]) << 24);
+        if (Crc32Report(CRC32_SEED_BT_INPUT, report, crcOffset) != expected)
+        {
+            return false;
+        }
+    }
+
+    const unsigned char* sticks = report + offsets.sticks;
+    state.leftX = sticks[0];
+    state.leftY = sticks[1];
+    state.rightX = sticks[2];
+    state.rightY = sticks[3];
+    state.L2 = report[offsets.triggers];
+    state.R2 = report[offsets.triggers + 1];
+
+    uint32_t hatButtons = report[offsets.hatButtons];
+    state.hat = (uint8_t)(hatButtons & 0x0F);
+    state.buttons = (hatButtons >> 4) |
+                    ((uint32_t)report[offsets.hatButtons + 1] << 4) |
+                    (((uint32_t)report[offsets.extraButtons] & offsets.extraMask) << PAD_BUTTON_PS);
+
+    uint8_t flags = 0;
+    if (offsets.motion != 0 && length >= offsets.motion + 2 + sizeof(state.gyro) + sizeof(state.accel))
+    {
+        const unsigned char* motion = report + offsets.motion;
+        state.sensorTimestamp = ReadLe16(motion);
+        // Skip the temperature byte between the clock and the gyro
+        for (int i = 0; i < 3; i++)
+        {
+            state.gyro[i] = (int16_t)ReadLe16(motion + 3 + 2 * i);
+            state.accel[i] = (int16_t)ReadLe16(motion + 9 + 2 * i);
+        }
+        flags |= PAD_FLAG_MOTION;
+    }
+    if (offsets.battery != 0 && length > offsets.battery)
+    {
+        // Low nibble 0..10 on battery, 0..11 while charging, 11 meaning full
+        unsigned int level = report[offsets.battery] & 0x0F;
+        state.battery = (uint8_t)(level >= 10 ? 100 : level * 10);
+    }
+    if (offsets.touch != 0 && length >= offsets.touch + 4 * PAD_TOUCH_POINTS)
+    {
+        for (int i = 0; i < PAD_TOUCH_POINTS; i++)
+        {
+            DecodeTouchPoint(report + offsets.touch + 4 * i, state.touch[i]);
+        }
+        flags |= PAD_FLAG_TOUCH;
+    }
+    state.flags = flags;
+    return true;
+}
+
+
+// =================================================================================================
+// SelectReportDecoder
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+EReportDecoder SelectReportDecoder(unsigned long vendorId, unsigned long productId)
+{
+    if (vendorId == SONY_VENDOR_ID)
+    {
+        switch (productId)
+        {
+            case DS4_PRODUCT_ID_V1:
+            case DS4_PRODUCT_ID_V2:
+            case DS4_PRODUCT_ID_DONGLE:
+                return DECODER_DS4;
+
+            case DUALSENSE_PRODUCT_ID:
+            case DUALSENSE_EDGE_PRODUCT_ID:
+                return DECODER_DUALSENSE;
+        }
+    }
+    else if ((vendorId == RAZER_VENDOR_ID && productId == RAZER_RAIJU_PRODUCT_ID) ||
+             (vendorId == NACON_VENDOR_ID && productId == NACON_REVOLUTION_PRO_PRODUCT_ID))
+    {
+        return DECODER_DS4;
+    }
+
+    return DECODER_GENERIC;
+}
+
+// =================================================================================================
+// GetReportDecoder         the only runtime dispatch: family and report ID pick the instantiation
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+PFN_REPORT_DECODER GetReportDecoder(EReportDecoder decoder, unsigned char reportId)
+{
+    switch (decoder)
+    {
+        case DECODER_DS4:
+            if (reportId == DS4_USB_REPORT_ID)
+            {
+                return DecodeDs4UsbReport;
+            }
+            if (reportId == DS4_BT_REPORT_ID)
+            {
+                return DecodeDs4BluetoothReport;
+            }
+            break;
+
+        case DECODER_DUALSENSE:
+            if (reportId == DUALSENSE_USB_REPORT_ID)
+            {
+                return DecodeDualSenseUsbReport;
+            }
+            break;
+
+        case DECODER_GENERIC:
+            break;
+    }
+
+    return nullptr;
+}
+
+// =================================================================================================
+// GetPadStateDecoder
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+PFN_PAD_STATE_DECODER GetPadStateDecoder(EReportDecoder decoder, unsigned char reportId)
+{
+    switch (decoder)
+    {
+        case DECODER_DS4:
+            if (reportId == DS4_USB_REPORT_ID)
+            {
+                return DecodeDs4UsbPadState;
+            }
+            if (reportId == DS4_BT_REPORT_ID)
+            {
+                return DecodeDs4BluetoothPadState;
+            }
+            break;
+
+        case DECODER_DUALSENSE:
+            if (reportId == DUALSENSE_USB_REPORT_ID)
+            {
+                return DecodeDualSenseUsbPadState;
+            }
+            break;
+
+        case DECODER_GENERIC:
+            break;
+    }
+
+    return nullptr;
+}
+
+// =================================================================================================
+// DecodeDs4UsbReport
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool DecodeDs4UsbReport(const unsigned char* report, size_t length, JSDATA& jsData)
+{
+    return DecodeReportLayout<DS4_USB_LAYOUT>(report, length, jsData);
+}
+
+// =================================================================================================
+// DecodeDs4BluetoothReport
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool DecodeDs4BluetoothReport(const unsigned char* report, size_t length, JSDATA& jsData)
+{
+    return DecodeReportLayout<DS4_BT_LAYOUT>(report, length, jsData);
+}
+
+// =================================================================================================
+// DecodeDualSenseUsbReport
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool DecodeDualSenseUsbReport(const unsigned char* report, size_t length, JSDATA& jsData)
+{
+    return DecodeReportLayout<DUALSENSE_USB_LAYOUT>(report, length, jsData);
+}
+
+// =================================================================================================
+// DecodeDs4UsbPadState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool DecodeDs4UsbPadState(const unsigned char* report, size_t length, SPadState& state)
+{
+    return DecodePadReport(DS4_USB_OFFSETS, report, length, state);
+}
+
+// =================================================================================================
+// DecodeDs4BluetoothPadState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool DecodeDs4BluetoothPadState(const unsigned char* report, size_t length, SPadState& state)
+{
+    return DecodePadReport(DS4_BT_OFFSETS, report, length, state);
+}
+
+// =================================================================================================
+// DecodeDualSenseUsbPadState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool DecodeDualSenseUsbPadState(const unsigned char* report, size_t length, SPadState& state)
+{
+    return DecodePadReport(DUALSENSE_USB_OFFSETS, report, length, state);
+}
@@ -0,0 +1,68 @@
+// =================================================================================================
+// Direct decoders for pads with a known input report layout, bypassing the HidP_* parser.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include "JSData.h"
+#include "PadState.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const unsigned long SONY_VENDOR_ID = 0x054C;
+const unsigned long DS4_PRODUCT_ID_V1 = 0x05C4;
+const unsigned long DS4_PRODUCT_ID_V2 = 0x09CC;
+const unsigned long DS4_PRODUCT_ID_DONGLE = 0x0BA0;
+const unsigned long DUALSENSE_PRODUCT_ID = 0x0CE6;
+const unsigned long DUALSENSE_EDGE_PRODUCT_ID = 0x0DF2;
+
+const unsigned long RAZER_VENDOR_ID = 0x1532;
+const unsigned long RAZER_RAIJU_PRODUCT_ID = 0x1000;
+const unsigned long NACON_VENDOR_ID = 0x146B;
+const unsigned long NACON_REVOLUTION_PRO_PRODUCT_ID = 0x0D01;
+
+const unsigned char DS4_USB_REPORT_ID = 0x01;
+const unsigned char DS4_BT_REPORT_ID = 0x11;
+const unsigned char DUALSENSE_USB_REPORT_ID = 0x01;
+
+// Report layout family of a pad, picked once per device from its VID/PID
+enum EReportDecoder
+{
+	DECODER_GENERIC,    // HidP_* driven by the device caps, or the compiled report descriptor
+	DECODER_DS4,        // DualShock 4 and pads that clone its report
+	DECODER_DUALSENSE
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// Decodes one input report (report ID included). Returns false without touching jsData when the
+// report does not match the layout.
+typedef bool (*PFN_REPORT_DECODER)(const unsigned char* report, size_t length, JSDATA& jsData);
+
+// The same for SPadState, every button included. Raw motion, touch and battery are filled in and
+// flagged when the report carries them; timestamp, sequence and player are left as they are.
+typedef bool (*PFN_PAD_STATE_DECODER)(const unsigned char* report, size_t length, SPadState& state);
+
+EReportDecoder SelectReportDecoder(unsigned long vendorId, unsigned long productId);
+
+// Generated decoder for a report of the given family, or nullptr when the report ID is unknown
+PFN_REPORT_DECODER GetReportDecoder(EReportDecoder decoder, unsigned char reportId);
+PFN_PAD_STATE_DECODER GetPadStateDecoder(EReportDecoder decoder, unsigned char reportId);
+
+bool DecodeDs4UsbReport(const unsigned char* report, size_t length, JSDATA& jsData);
+bool DecodeDs4BluetoothReport(const unsigned char* report, size_t length, JSDATA& jsData);
+bool DecodeDualSenseUsbReport(const unsigned char* report, size_t length, JSDATA& jsData);
+
+bool DecodeDs4UsbPadState(const unsigned char* report, size_t length, SPadState& state);
+bool DecodeDs4BluetoothPadState(const unsigned char* report, size_t length, SPadState& state);
+bool DecodeDualSenseUsbPadState(const unsigned char* report, size_t length, SPadState& state);
@@ -0,0 +1,199 @@
+// =================================================================================================
+// Compile-time report layouts. Every known pad is described by a constexpr table of fields and
+// DecodeReportLayout<> turns that table into a straight-line decoder with constant offsets.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include "JSData.h"
+#include "Crc32.h"
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SReportField
+{
+	size_t offset;              // byte offset from the start of the report, report ID included
+	unsigned char bitShift;     // first bit inside the byte at offset
+	unsigned char bitWidth;
+	bool isSigned;
+	EJsField target;
+	unsigned char firstButton;  // JSFIELD_BUTTONS only: HandlePressed index of the lowest bit
+};
+
+template <size_t N>
+struct SReportLayout
+{
+	unsigned char reportId;
+	size_t minLength;
+	bool hasCrc;                // CRC-32 over seed + report in the 4 bytes ending at minLength
+	unsigned char crcSeed;
+	SReportField fields[N];
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// LayoutIsValid            compile-time check that every field lies inside the report and fits the
+//                          32-bit extractor
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <size_t N>
+constexpr bool LayoutIsValid(const SReportLayout<N>& layout)
+{
+	size_t dataEnd = layout.hasCrc ? layout.minLength - 4 : layout.minLength;
+
+	for (size_t i = 0; i < N; i++)
+	{
+		const SReportField& field = layout.fields[i];
+		size_t byteCount = (field.bitShift + field.bitWidth + 7) / 8;
+
+		if (field.bitWidth == 0 || field.bitShift > 7 || field.bitShift + field.bitWidth > 32)
+		{
+			return false;
+		}
+		if (field.offset == 0 || field.offset + byteCount > dataEnd)
+		{
+			return false;
+		}
+		if (field.target == JSFIELD_BUTTONS && field.firstButton + field.bitWidth > BUTTONS_NUM)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// =================================================================================================
+// ExtractBits              little-endian bit field read, the byte count is a constant so the loop
+//                          is fully unrolled
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <size_t Offset, unsigned Shift, unsigned Width>
+inline uint32_t ExtractBits(const unsigned char* report)
+{
+	constexpr unsigned byteCount = (Shift + Width + 7) / 8;
+	constexpr uint32_t mask = Width >= 32 ? 0xFFFFFFFFu : ((1u << Width) - 1);
+
+	uint32_t value = 0;
+	for (unsigned i = 0; i < byteCount; i++)
+	{
+		value |= uint32_t(report[Offset + i]) << (8 * i);
+	}
+
+	return (value >> Shift) & mask;
+}
+
+// =================================================================================================
+// DecodeLayoutField
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <const auto& Layout, size_t I>
+inline void DecodeLayoutField(const unsigned char* report, JSDATA& jsData)
+{
+	constexpr SReportField field = Layout.fields[I];
+
+	uint32_t bits = ExtractBits<field.offset, field.bitShift, field.bitWidth>(report);
+
+	int32_t value = (int32_t)bits;
+	if constexpr (field.isSigned && field.bitWidth < 32)
+	{
+		constexpr uint32_t signBit = 1u << (field.bitWidth - 1);
+		value = (int32_t)(bits ^ signBit) - (int32_t)signBit;
+	}
+
+	if constexpr (field.target == JSFIELD_LEFT_X)
+	{
+		jsData.leftX = value;
+	}
+	else if constexpr (field.target == JSFIELD_LEFT_Y)
+	{
+		jsData.leftY = value;
+	}
+	else if constexpr (field.target == JSFIELD_RIGHT_X)
+	{
+		jsData.rightX = value;
+	}
+	else if constexpr (field.target == JSFIELD_RIGHT_Y)
+	{
+		jsData.rightY = value;
+	}
+	else if constexpr (field.target == JSFIELD_L2)
+	{
+		jsData.L2 = value;
+	}
+	else if constexpr (field.target == JSFIELD_R2)
+	{
+		jsData.R2 = value;
+	}
+	else if constexpr (field.target == JSFIELD_ARROW)
+	{
+		jsData.arrowValue = (int)value;
+	}
+	else if constexpr (field.target == JSFIELD_BUTTONS)
+	{
+		for (unsigned i = 0; i < field.bitWidth; i++)
+		{
+			jsData.HandlePressed[field.firstButton + i] = ((bits >> i) & 1) != 0;
+		}
+	}
+}
+
+// =================================================================================================
+// DecodeLayoutFields
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <const auto& Layout, size_t... I>
+inline void DecodeLayoutFields(const unsigned char* report, JSDATA& jsData, std::index_sequence<I...>)
+{
+	(DecodeLayoutField<Layout, I>(report, jsData), ...);
+}
+
+// =================================================================================================
+// DecodeReportLayout       decoder generated from a constexpr layout table. Returns false without
+//                          touching jsData when the report does not match the layout.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <const auto& Layout>
+bool DecodeReportLayout(const unsigned char* report, size_t length, JSDATA& jsData)
+{
+	static_assert(LayoutIsValid(Layout), "report field lies outside the layout");
+
+	if (report == nullptr || length < Layout.minLength || report[0] != Layout.reportId)
+	{
+		return false;
+	}
+
+	if constexpr (Layout.hasCrc)
+	{
+		constexpr size_t crcOffset = Layout.minLength - 4;
+		uint32_t expected = uint32_t(report[crcOffset]) | (uint32_t(report[crcOffset + 1]) << 8) |
+		                    (uint32_t(report[crcOffset + 2]) << 16) | (uint32_t(report[crcOffset + 3]) << 24);
+
+		if (Crc32Report(Layout.crcSeed, report, crcOffset) != expected)
+		{
+			return false;
+		}
+	}
+
+	DecodeLayoutFields<Layout>(report, jsData, std::make_index_sequence<std::size(Layout.fields)>());
+	return true;
+}
@@ -0,0 +1,96 @@
+// =================================================================================================
+// Layout of the shared-memory region the joystick process publishes pad state into and other
+// processes read without any IPC round-trip: a header, a device table and one slot per player,
+// each behind its own seqlock.
+//
+// Every field is fixed-size and naturally aligned and the seqlocks are lock-free 64-bit atomics,
+// so writer and readers only need to agree on SHARED_STATE_VERSION, not on compiler or process.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "CSeqLock.h"
+#include "CDeviceRegistry.h"
+#include "PadState.h"
+#include "Ds4Motion.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const char SHARED_STATE_MAGIC[4] = { 'J', 'S', 'S', 'M' };
+const uint16_t SHARED_STATE_VERSION = 1;
+
+// Name both sides use unless told otherwise; "/" is put in front on Linux, "Local\" on Windows
+const char* const SHARED_STATE_DEFAULT_NAME = "SonyPlayStation4Joystick";
+const size_t SHARED_STATE_MAX_NAME = 128;
+
+const int SHARED_STATE_SLOTS = MAX_CONTROLLERS;
+
+// SSharedStateHeader::status
+enum ESharedStateStatus
+{
+	SHARED_STATE_STARTING = 0,      // the writer is laying the region out
+	SHARED_STATE_LIVE = 1,
+	SHARED_STATE_CLOSED = 2         // the writer went away; readers reopen by name
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the seqlocks are shared between processes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "the status is shared between processes");
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct alignas(64) SSharedStateHeader
+{
+	char magic[4];
+	uint16_t version;
+	uint16_t headerSize;            // sizeof(SSharedStateHeader)
+	uint32_t regionSize;            // sizeof(SSharedStateRegion)
+	uint32_t slotCount;
+	uint32_t slotSize;              // sizeof(SSharedStateSlot)
+	uint32_t writerProcessId;
+	uint64_t writerStartNs;         // MonotonicNowNs() of the writer, new for every writer
+	std::atomic<uint32_t> status;   // ESharedStateStatus, set LIVE once the rest is valid
+};
+
+struct SSharedDevice
+{
+	uint16_t vendorId;
+	uint16_t productId;
+	uint8_t connected;
+	uint8_t reserved[3];
+	uint32_t arrivals;              // counts the devices that took this player index
+};
+
+struct SSharedDeviceTable
+{
+	SSharedDevice devices[SHARED_STATE_SLOTS];
+};
+
+// One player; the pad state is published with every report, motion with every report carrying it
+struct SSharedStateSlot
+{
+	CSeqLock<SPadState> padState;
+	CSeqLock<SMotionSample> motion;
+};
+
+struct SSharedStateRegion
+{
+	SSharedStateHeader header;
+	CSeqLock<SSharedDeviceTable> deviceTable;
+	SSharedStateSlot slots[SHARED_STATE_SLOTS];
+};
+
+static_assert(sizeof(SSharedStateHeader) == 64, "shared state header layout");
+static_assert(sizeof(SSharedDevice) == 12, "shared device layout");
+static_assert(sizeof(CSeqLock<SPadState>) == 128, "shared pad state slot layout");
@@ -36,11 +36,11 @@
 
 
 // =================================================================================================
-// callBackUpdate           return data form HID
+// callBackUpdate           return data form HID, playerIndex tells the controllers apart
 // 
 // Author: Eran Yeruham, Date: 28 july 2024
 // -------------------------------------------------------------------------------------------------
-void callBackUpdate(JSDATA jsData)
+void callBackUpdate(int playerIndex, JSDATA jsData)
 {
 
 }
@@ -59,7 +59,12 @@ CSonyJoystick m_sony(callBackUpdate);
 // -------------------------------------------------------------------------------------------------
 int main() 
 {
+    if (!m_sony.Start())
+    {
+        return 1;
+    }
     m_sony.ShowDataWindow();
+    m_sony.ShowStats(true);
 
     MSG msg;
     while (GetMessage(&msg, NULL, 0, 0) > 0) 
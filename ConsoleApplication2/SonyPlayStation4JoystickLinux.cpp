@@ -0,0 +1,391 @@
+// =================================================================================================
+// Linux console demo: reads the connected pads through hidraw (evdev as fallback) on the input
+// thread and prints the newest state of every player until Ctrl+C. Input can be recorded to a
+// capture and a capture replayed instead of the pads (speed 0 = as fast as possible). --share
+// publishes the state to other processes, which --read-shared shows without touching the pads.
+// --serve streams it over UDP on loopback, DSU on the port and the compact protocol on the next.
+// --output lights the lightbar of DualShock 4 pads in the colour given and lets L2/R2 drive the
+// motors. --combos prints a few combos and gestures to stderr as they are recognised.
+//
+// SonyPlayStation4JoystickLinux [--synthetic [pads] [Hz] | --replay capture [speed]] [--record capture] [--stats [ms]]
+//                               [--share [name]] [--serve [port]] [--output [RRGGBB]] [--combos]
+// SonyPlayStation4JoystickLinux --read-shared [name]
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CJoystickCore.h"
+#include "CJoystickStats.h"
+#include "CInputThread.h"
+#include "CCaptureSink.h"
+#include "CLinuxHidrawSource.h"
+#include "CReplaySource.h"
+#include "CSharedStateReader.h"
+#include "CSyntheticInputSource.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int PRINT_INTERVAL_MS = 100;
+const int SYNTHETIC_DEFAULT_PADS = 2;
+const unsigned int SYNTHETIC_DEFAULT_RATE_HZ = 250;
+const unsigned int STATS_DEFAULT_INTERVAL_MS = 1000;
+const unsigned long OUTPUT_DEFAULT_LIGHTBAR = 0x0000FF;
+
+// SComboDefinition::id of the --combos set indexes this
+const char* const DEMO_COMBO_NAMES[] = { "L1+R1", "quarter circle forward + square", "double tap cross", "hold triangle" };
+
+// =================================================================================================
+// ===================================== GLOBAL VARIABLES ==========================================
+
+static std::atomic<bool> g_quit(false);
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// OnSignal
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void OnSignal(int)
+{
+    g_quit.store(true);
+}
+
+// =================================================================================================
+// PrintPlayers
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void PrintPlayers(const CJoystickCore& core)
+{
+    for (int player = 0; player < MAX_CONTROLLERS; player++)
+    {
+        SJoystickSample sample;
+        if (!core.GetLatestState(player, sample))
+        {
+            continue;
+        }
+
+        const JSDATA& jsData = sample.data;
+        unsigned int buttons = 0;
+        for (int i = 0; i < BUTTONS_NUM; i++)
+        {
+            buttons |= (jsData.HandlePressed[i] ? 1u : 0u) << i;
+        }
+
+        std::printf("P%d L(%3ld,%3ld) R(%3ld,%3ld) L2 %3ld R2 %3ld hat %d buttons %03x  ",
+            player + 1, (long)jsData.leftX, (long)jsData.leftY, (long)jsData.rightX, (long)jsData.rightY,
+            (long)jsData.L2, (long)jsData.R2, jsData.arrowValue, buttons);
+    }
+
+    std::printf("(%d connected)\r", core.GetConnectedCount());
+    std::fflush(stdout);
+}
+
+// =================================================================================================
+// UpdateOutputs            lightbar colour and trigger-driven rumble of every player; a pad
+//                          without output refuses both
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void UpdateOutputs(CJoystickCore& core, unsigned long lightbar)
+{
+    for (int player = 0; player < MAX_CONTROLLERS; player++)
+    {
+        SJoystickSample sample;
+        if (!core.GetLatestState(player, sample))
+        {
+            continue;
+        }
+
+        core.SetLightbar(player, (uint8_t)(lightbar >> 16), (uint8_t)(lightbar >> 8), (uint8_t)lightbar);
+        core.SetRumble(player, (uint8_t)sample.data.L2, (uint8_t)sample.data.R2);
+    }
+}
+
+// =================================================================================================
+// BuildDemoCombos          one of each kind: a chord, a motion, a double tap and a hold
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<SComboDefinition> BuildDemoCombos()
+{
+    std::vector<SComboDefinition> combos(4);
+    combos[0].id = 0;
+    combos[0].steps = { { ComboButton(PAD_BUTTON_L1) | ComboButton(PAD_BUTTON_R1), COMBO_STEP_PRESS, 0, 0 } };
+
+    // Hat 4 = down, 3 = down-right, 2 = right
+    combos[1].id = 1;
+    combos[1].steps = { { ComboHat(4), COMBO_STEP_PRESS, 0, 0 },
+                        { ComboHat(3), COMBO_STEP_PRESS, 0, 150 },
+                        { ComboHat(2), COMBO_STEP_PRESS, 0, 150 },
+                        { ComboButton(PAD_BUTTON_SQUARE), COMBO_STEP_PRESS, 0, 200 } };
+
+    combos[2].id = 2;
+    combos[2].steps = { { ComboButton(PAD_BUTTON_CROSS), COMBO_STEP_PRESS, 0, 0 },
+                        { ComboButton(PAD_BUTTON_CROSS), COMBO_STEP_RELEASE, 0, 200 },
+                        { ComboButton(PAD_BUTTON_CROSS), COMBO_STEP_PRESS, 0, 200 } };
+
+    combos[3].id = 3;
+    combos[3].steps = { { ComboButton(PAD_BUTTON_TRIANGLE), COMBO_STEP_PRESS, 0, 0 },
+                        { ComboButton(PAD_BUTTON_TRIANGLE), COMBO_STEP_HOLD, 500, 0 } };
+    return combos;
+}
+
+// =================================================================================================
+// PrintSharedPlayers       the same line out of another process's shared state
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void PrintSharedPlayers(const CSharedStateReader& reader)
+{
+    SSharedDeviceTable table;
+    if (!reader.ReadDeviceTable(table))
+    {
+        return;
+    }
+
+    int connected = 0;
+    for (int player = 0; player < SHARED_STATE_SLOTS; player++)
+    {
+        SPadState state;
+        connected += table.devices[player].connected;
+        if (!table.devices[player].connected || !reader.ReadPadState(player, state))
+        {
+            continue;
+        }
+
+        std::printf("P%d L(%3u,%3u) R(%3u,%3u) L2 %3u R2 %3u hat %d buttons %04x  ",
+            player + 1, state.leftX, state.leftY, state.rightX, state.rightY, state.L2, state.R2,
+            state.hat != PAD_HAT_NEUTRAL ? state.hat : -1, state.buttons);
+    }
+
+    std::printf("(%d connected)\r", connected);
+    std::fflush(stdout);
+}
+
+// =================================================================================================
+// RunSharedReader          until Ctrl+C; follows the writer when it restarts
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int RunSharedReader(const char* name)
+{
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+
+    CSharedStateReader reader;
+    bool waiting = false;
+    while (!g_quit.load())
+    {
+        if (!reader.IsLive())
+        {
+            reader.Close();
+            if (!reader.Open(name))
+            {
+                if (!waiting)
+                {
+                    std::fprintf(stderr, "waiting for %s\n", name);
+                    waiting = true;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(PRINT_INTERVAL_MS));
+                continue;
+            }
+            waiting = false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(PRINT_INTERVAL_MS));
+        PrintSharedPlayers(reader);
+    }
+
+    std::printf("\n");
+    return 0;
+}
+
+// =================================================================================================
+// main
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    CJoystickCore core;
+    CCaptureSink captureSink(&core);
+    IInputSink* sink = &core;
+    CInputThread::SourceFactory createSource;
+    CReplaySource* replay = nullptr;     // set on the input thread before Start returns
+    unsigned int statsIntervalMs = 0;
+    bool output = false;
+    unsigned long lightbar = OUTPUT_DEFAULT_LIGHTBAR;
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if (std::strcmp(argv[arg], "--synthetic") == 0)
+        {
+            int pads = arg + 1 < argc ? std::atoi(argv[++arg]) : SYNTHETIC_DEFAULT_PADS;
+            unsigned int rateHz = arg + 1 < argc ? (unsigned int)std::atoi(argv[++arg]) : SYNTHETIC_DEFAULT_RATE_HZ;
+            createSource = [pads, rateHz]() { return std::unique_ptr<IInputSource>(new CSyntheticInputSource(pads, rateHz)); };
+        }
+        else if (std::strcmp(argv[arg], "--replay") == 0 && arg + 1 < argc)
+        {
+            std::string path = argv[++arg];
+            double speed = arg + 1 < argc && argv[arg + 1][0] != '-' ? std::atof(argv[++arg]) : REPLAY_SPEED_ORIGINAL;
+            createSource = [path, speed, &replay]()
+            {
+                replay = new CReplaySource(path, speed);
+                return std::unique_ptr<IInputSource>(replay);
+            };
+        }
+        else if (std::strcmp(argv[arg], "--record") == 0 && arg + 1 < argc)
+        {
+            if (!captureSink.Open(argv[++arg]))
+            {
+                std::fprintf(stderr, "cannot create %s\n", argv[arg]);
+                return 1;
+            }
+            sink = &captureSink;
+        }
+        else if (std::strcmp(argv[arg], "--stats") == 0)
+        {
+            statsIntervalMs = arg + 1 < argc && argv[arg + 1][0] != '-' ? (unsigned int)std::atoi(argv[++arg]) : STATS_DEFAULT_INTERVAL_MS;
+        }
+        else if (std::strcmp(argv[arg], "--share") == 0)
+        {
+            const char* name = arg + 1 < argc && argv[arg + 1][0] != '-' ? argv[++arg] : SHARED_STATE_DEFAULT_NAME;
+            if (!core.EnableSharedState(name))
+            {
+                std::fprintf(stderr, "cannot share the state as %s\n", name);
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[arg], "--serve") == 0)
+        {
+            SStateServerConfig config;
+            if (arg + 1 < argc && argv[arg + 1][0] != '-')
+            {
+                config.dsuPort = (uint16_t)std::atoi(argv[++arg]);
+                config.compactPort = (uint16_t)(config.dsuPort + 1);
+            }
+            if (!core.EnableStateServer(config))
+            {
+                std::fprintf(stderr, "cannot serve on UDP ports %u and %u\n", config.dsuPort, config.compactPort);
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[arg], "--output") == 0)
+        {
+            if (arg + 1 < argc && argv[arg + 1][0] != '-')
+            {
+                lightbar = std::strtoul(argv[++arg], nullptr, 16);
+            }
+            core.EnableOutput(SPadOutputConfig());
+            output = true;
+        }
+        else if (std::strcmp(argv[arg], "--combos") == 0)
+        {
+            core.EnableCombos(BuildDemoCombos(), [](const SComboEvent* pEvents, size_t count)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    std::fprintf(stderr, "\nP%d %s\n", pEvents[i].playerIndex + 1, DEMO_COMBO_NAMES[pEvents[i].id]);
+                }
+            });
+        }
+        else if (std::strcmp(argv[arg], "--read-shared") == 0)
+        {
+            return RunSharedReader(arg + 1 < argc ? argv[arg + 1] : SHARED_STATE_DEFAULT_NAME);
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--synthetic [pads] [Hz] | --replay capture [speed]] [--record capture] [--stats [ms]] [--share [name]] [--serve [port]] [--output [RRGGBB]] [--combos]\n"
+                                 "       %s --read-shared [name]\n", argv[0], argv[0]);
+            return 1;
+        }
+    }
+
+    if (!createSource)
+    {
+        // Probing hidraw against evdev opens the source already, Open on the thread is then a no-op
+        createSource = [sink]() { return CreateLinuxInputSource(sink); };
+    }
+
+    CInputThread inputThread;
+    if (!inputThread.Start(createSource, sink, INPUT_THREAD_HIGH))
+    {
+        std::fprintf(stderr, "no input available\n");
+        return 1;
+    }
+
+    // Stats lines go to stderr, away from the \r-updated player line
+    CStatsDump statsDump;
+    if (statsIntervalMs != 0 && !statsDump.Start([&core](SJoystickStatsSnapshot& snapshot) { return core.GetStatsSnapshot(snapshot); }, statsIntervalMs))
+    {
+        std::fprintf(stderr, "statistics are not available in this build\n");
+    }
+
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+
+    while (!g_quit.load() && inputThread.IsRunning() && (replay == nullptr || !replay->IsFinished()))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(PRINT_INTERVAL_MS));
+        PrintPlayers(core);
+        if (output)
+        {
+            UpdateOutputs(core, lightbar);
+        }
+    }
+
+    inputThread.Stop();
+    statsDump.Stop();
+    PrintPlayers(core);
+    std::printf("\n");
+
+    const CStateServer* pServer = core.GetStateServer();
+    if (pServer != nullptr)
+    {
+        SStateServerCounters counters = pServer->GetCounters();
+        std::fprintf(stderr, "served %llu reports: %llu DSU packets, %llu compact datagrams (%llu bytes), %llu send errors\n",
+            (unsigned long long)counters.reports, (unsigned long long)counters.dsuPackets,
+            (unsigned long long)counters.compactDatagrams, (unsigned long long)counters.compactBytes,
+            (unsigned long long)counters.sendErrors);
+    }
+
+    for (int player = 0; output && player < MAX_CONTROLLERS; player++)
+    {
+        SPadOutputCounters counters;
+        if (core.GetOutputCounters(player, counters) && counters.submits != 0)
+        {
+            std::fprintf(stderr, "P%d output: %llu updates, %llu coalesced, %llu reports, %llu unchanged, %llu write errors\n",
+                player + 1, (unsigned long long)counters.submits, (unsigned long long)counters.coalesced,
+                (unsigned long long)counters.writes, (unsigned long long)counters.unchanged,
+                (unsigned long long)counters.writeErrors);
+        }
+    }
+
+    captureSink.Close();
+    if (captureSink.GetWriter().GetDroppedRecords() != 0 || !captureSink.GetWriter().IsHealthy())
+    {
+        std::fprintf(stderr, "capture incomplete: %llu records dropped%s\n",
+            (unsigned long long)captureSink.GetWriter().GetDroppedRecords(),
+            captureSink.GetWriter().IsHealthy() ? "" : ", write failed");
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+// =================================================================================================
+// Allocation tests: a capture replayed through CJoystickCore::OnReport makes no heap allocation,
+// with the plain callback path and with every per-report stage of the core turned on.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "TestHarness.h"
+#include "TestReports.h"
+#include "AllocationCounter.h"
+#include "CJoystickCore.h"
+#include "CReplaySource.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int ALLOCATION_REPORTS_PER_PAD = 2000;
+const size_t ALLOCATION_QUEUE_CAPACITY = 1024;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// Passes everything on to the core and counts the allocations made inside OnReport only; arrival,
+// removal and batch ends may allocate
+class CAllocationCountingSink : public IInputSink
+{
+public:
+   explicit CAllocationCountingSink(CJoystickCore& core) : m_core(core), m_reports(0), m_decoded(0), m_allocations(0)
+   {
+   }
+
+   bool IsDeviceAttached(void* deviceKey) override { return m_core.IsDeviceAttached(deviceKey); }
+   int OnDeviceArrived(void* deviceKey, uint32_t identity, SHidDeviceDescriptor&& descriptor) override
+   {
+      return m_core.OnDeviceArrived(deviceKey, identity, std::move(descriptor));
+   }
+   void OnDeviceRemoved(void* deviceKey) override { m_core.OnDeviceRemoved(deviceKey); }
+   bool OnReport(void* deviceKey, const unsigned char* report, size_t length, uint64_t timestampNs) override
+   {
+      uint64_t before = GetAllocationCount();
+      bool decoded = m_core.OnReport(deviceKey, report, length, timestampNs);
+      m_allocations += GetAllocationCount() - before;
+      m_reports++;
+      m_decoded += decoded ? 1 : 0;
+      return decoded;
+   }
+   bool OnState(void* deviceKey, const JSDATA& state, uint64_t timestampNs) override
+   {
+      return m_core.OnState(deviceKey, state, timestampNs);
+   }
+   void OnBatchEnd() override { m_core.OnBatchEnd(); }
+   void OnInputError(void* deviceKey, EInputError error, int osError) override { m_core.OnInputError(deviceKey, error, osError); }
+
+   uint64_t GetReports() const { return m_reports; }
+   uint64_t GetDecoded() const { return m_decoded; }
+   uint64_t GetAllocations() const { return m_allocations; }
+
+private:
+   CJoystickCore& m_core;
+   uint64_t m_reports;
+   uint64_t m_decoded;
+   uint64_t m_allocations;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ReplayCounted            the test capture through the sink as fast as it takes it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool ReplayCounted(const std::string& path, CAllocationCountingSink& sink)
+{
+    CReplaySource source(path, REPLAY_SPEED_UNLIMITED);
+    if (!source.Open(&sink))
+    {
+        return false;
+    }
+    while (!source.IsFinished())
+    {
+        if (source.Poll(0) < 0)
+        {
+            break;
+        }
+    }
+    source.Close();
+    return true;
+}
+
+// =================================================================================================
+// replay_callback          USB and Bluetooth DS4 reports, callback and sample queue attached
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(allocations, replay_callback)
+{
+    std::string path = TestTempPath("allocations_callback.jscp");
+    REQUIRE(WriteDs4TestCapture(path.c_str(), ALLOCATION_REPORTS_PER_PAD));
+
+    CJoystickCore core;
+    uint64_t callbacks = 0;
+    core.SetCallback([&callbacks](int, JSDATA) { callbacks++; });
+    core.EnableSampleQueue(ALLOCATION_QUEUE_CAPACITY, RING_OVERWRITE_OLDEST);
+
+    CAllocationCountingSink sink(core);
+    bool replayed = ReplayCounted(path, sink);
+    std::remove(path.c_str());
+    REQUIRE(replayed);
+
+    CHECK_EQ(sink.GetReports(), (uint64_t)(2 * ALLOCATION_REPORTS_PER_PAD));
+    CHECK_EQ(sink.GetDecoded(), sink.GetReports());
+    CHECK_EQ(callbacks, sink.GetDecoded());
+    CHECK_EQ(sink.GetAllocations(), (uint64_t)0);
+}
+
+// =================================================================================================
+// replay_all_stages        batched delivery, axes, filters, events and combos on top
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(allocations, replay_all_stages)
+{
+    std::string path = TestTempPath("allocations_stages.jscp");
+    REQUIRE(WriteDs4TestCapture(path.c_str(), ALLOCATION_REPORTS_PER_PAD));
+
+    CJoystickCore core;
+    uint64_t samples = 0;
+    uint64_t events = 0;
+    uint64_t combos = 0;
+    core.EnableSampleQueue(ALLOCATION_QUEUE_CAPACITY, RING_OVERWRITE_OLDEST);
+    core.EnableBatchedDelivery(BATCH_DELIVER_ALL, [&samples](const SJoystickSample*, size_t count) { samples += count; });
+    for (int playerIndex = 0; playerIndex < 2; playerIndex++)
+    {
+        core.SetAxisConfig(playerIndex, SAxisConfig());
+    }
+
+    SFilterConfig filterConfig;
+    for (SFilterSettings& channel : filterConfig.channels)
+    {
+        channel.type = FILTER_ONE_EURO;
+    }
+    core.EnableFiltering(filterConfig);
+
+    SPadEventSubscription subscription;
+    subscription.buttons = ~0u;
+    subscription.axes = 0xFF;
+    subscription.hat = true;
+    subscription.callback = [&events](const SPadEvent*, size_t count) { events += count; };
+    core.SubscribeEvents(subscription);
+
+    SComboDefinition combo;
+    combo.id = 1;
+    combo.steps.push_back({ ComboButton(PAD_BUTTON_CROSS), COMBO_STEP_PRESS, 0, 0 });
+    combo.steps.push_back({ ComboButton(PAD_BUTTON_CROSS), COMBO_STEP_RELEASE, 0, 0 });
+    REQUIRE(core.EnableCombos({ combo }, [&combos](const SComboEvent*, size_t count) { combos += count; }));
+
+    CAllocationCountingSink sink(core);
+    bool replayed = ReplayCounted(path, sink);
+    std::remove(path.c_str());
+    REQUIRE(replayed);
+
+    CHECK_EQ(sink.GetDecoded(), (uint64_t)(2 * ALLOCATION_REPORTS_PER_PAD));
+    CHECK_EQ(samples, sink.GetDecoded());
+    CHECK(events > 0);
+    CHECK(combos > 0);
+    CHECK_EQ(sink.GetAllocations(), (uint64_t)0);
+}
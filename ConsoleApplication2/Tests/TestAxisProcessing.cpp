@@ -0,0 +1,323 @@
+// =================================================================================================
+// Axis kernel tests: every SIMD kernel the build and the CPU have against the scalar reference,
+// over deadzone shapes, anti-deadzones, power and custom curves, inversion and raw ranges, on
+// centred, saturated, out-of-range and random inputs. The kernels must agree within
+// AXIS_TEST_TOLERANCE, and the centred and saturated outputs must be the values they stand for.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "TestHarness.h"
+#include "AxisProcessing.h"
+#include "CpuFeatures.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// The kernels do the same float operations in the same order; what is left is a compiler
+// contracting a multiply and an add of the scalar path, a few ulp of an output in -1..1
+const double AXIS_TEST_TOLERANCE = 1e-6;
+
+// A stick axis at rest on 0..255 is half a raw step, 1 / 255, off its centre; on a radial stick
+// that step leans the other axis of a saturated stick by as much
+const double AXIS_TEST_CENTRE_TOLERANCE = 0.01;
+
+const int AXIS_TEST_RANDOM_STATES = 4096;
+
+// Raw values every axis is tried with, pairwise on the sticks: the ends, around the centre of
+// 0..255 and of 0..254, and past the range
+const uint16_t AXIS_TEST_RAW_VALUES[] = { 0, 1, 2, 20, 64, 100, 120, 126, 127, 128, 129, 135, 160, 200, 240, 253, 254, 255, 256, 1000, 65535 };
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// NextAxisTestValue        xorshift32
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t NextAxisTestValue(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// =================================================================================================
+// BuildAxisTestConfigs     one configuration per feature of the processor, then all of them at once
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<SAxisConfig> BuildAxisTestConfigs()
+{
+    std::vector<SAxisConfig> configs;
+
+    // Linear, no deadzone
+    configs.push_back(SAxisConfig());
+
+    SAxisConfig config;
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        config.axes[axis].deadzone = 0.1f;
+        config.axes[axis].outerDeadzone = 0.9f;
+    }
+    configs.push_back(config);
+    config.leftStick = DEADZONE_AXIAL;
+    config.rightStick = DEADZONE_AXIAL;
+    configs.push_back(config);
+
+    // Anti-deadzone and power curves, one steeper and one flatter than linear
+    config = SAxisConfig();
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        config.axes[axis].deadzone = 0.05f;
+        config.axes[axis].antiDeadzone = 0.2f;
+        config.axes[axis].curveExponent = axis % 2 == 0 ? 2.0f : 0.5f;
+    }
+    configs.push_back(config);
+
+    // Custom curves, inversion, and 0..254, whose centre is a raw value
+    config = SAxisConfig();
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        config.axes[axis].rawMax = 254;
+        config.axes[axis].invert = axis % 3 == 1;
+        config.axes[axis].curvePoints = { 0.0f, 0.1f, 0.4f, 0.9f, 1.0f };
+    }
+    configs.push_back(config);
+
+    // Everything at once, mixed shapes, as the bench configures it
+    config = SAxisConfig();
+    config.rightStick = DEADZONE_AXIAL;
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        config.axes[axis].deadzone = 0.08f;
+        config.axes[axis].outerDeadzone = 0.95f;
+        config.axes[axis].antiDeadzone = 0.05f;
+        config.axes[axis].curveExponent = 1.5f;
+    }
+    config.axes[AXIS_LEFT_Y].invert = true;
+    config.axes[AXIS_RIGHT_Y].invert = true;
+    config.axes[AXIS_R2].curvePoints = { 0.0f, 0.5f, 0.8f, 1.0f };
+    configs.push_back(config);
+
+    // A deadzone past the clamp, and a wide raw range
+    config = SAxisConfig();
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        config.axes[axis].deadzone = 1.5f;
+        config.axes[axis].rawMax = axis % 2 == 0 ? 255 : 65535;
+    }
+    configs.push_back(config);
+
+    return configs;
+}
+
+// =================================================================================================
+// BuildAxisTestStates      every pair of AXIS_TEST_RAW_VALUES on each stick, with the triggers
+//                          walking the same values, then random states
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<SPadState> BuildAxisTestStates()
+{
+    const size_t rawCount = sizeof(AXIS_TEST_RAW_VALUES) / sizeof(AXIS_TEST_RAW_VALUES[0]);
+    std::vector<SPadState> states;
+
+    for (size_t x = 0; x < rawCount; x++)
+    {
+        for (size_t y = 0; y < rawCount; y++)
+        {
+            SPadState state = SPadState();
+            state.leftX = AXIS_TEST_RAW_VALUES[x];
+            state.leftY = AXIS_TEST_RAW_VALUES[y];
+            state.rightX = AXIS_TEST_RAW_VALUES[y];
+            state.rightY = AXIS_TEST_RAW_VALUES[x];
+            state.L2 = AXIS_TEST_RAW_VALUES[x];
+            state.R2 = AXIS_TEST_RAW_VALUES[(x + y) % rawCount];
+            states.push_back(state);
+        }
+    }
+
+    uint32_t random = 0x2545F491u;
+    for (int i = 0; i < AXIS_TEST_RANDOM_STATES; i++)
+    {
+        SPadState state = SPadState();
+        state.leftX = (uint16_t)(NextAxisTestValue(random) & 0xFF);
+        state.leftY = (uint16_t)(NextAxisTestValue(random) & 0xFF);
+        state.rightX = (uint16_t)(NextAxisTestValue(random) & 0xFF);
+        state.rightY = (uint16_t)(NextAxisTestValue(random) & 0xFF);
+        state.L2 = (uint16_t)(NextAxisTestValue(random) & 0xFF);
+        state.R2 = (uint16_t)NextAxisTestValue(random);
+        states.push_back(state);
+    }
+    return states;
+}
+
+// =================================================================================================
+// ProcessTestState         one state through a kernel
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SAxisOutput ProcessTestState(EAxisKernel kernel, const SAxisProcessor& processor, uint16_t leftX, uint16_t leftY, uint16_t trigger)
+{
+    SPadState state = SPadState();
+    state.leftX = leftX;
+    state.leftY = leftY;
+    state.rightX = leftX;
+    state.rightY = leftY;
+    state.L2 = trigger;
+    state.R2 = trigger;
+    SAxisOutput output;
+    GetAxisKernel(kernel)(processor, &state, 1, &output);
+    return output;
+}
+
+// =================================================================================================
+// kernels_agree            each kernel against the scalar one on every configuration and state, in
+//                          one batch and state by state; no output may be NaN or leave its range
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(axis_kernels, kernels_agree)
+{
+#if JOYSTICK_HAVE_SSE2
+    // Every x86 CPU the build targets has SSE2, so the SSE2 kernel is always compared
+    REQUIRE(GetAxisKernel(AXIS_KERNEL_SSE2) != nullptr);
+#endif
+
+    std::vector<SPadState> states = BuildAxisTestStates();
+    std::vector<SAxisConfig> configs = BuildAxisTestConfigs();
+    std::vector<SAxisOutput> reference(states.size());
+    std::vector<SAxisOutput> outputs(states.size());
+    SAxisProcessor processor;
+
+    for (size_t c = 0; c < configs.size(); c++)
+    {
+        BuildAxisProcessor(configs[c], processor);
+        GetAxisKernel(AXIS_KERNEL_SCALAR)(processor, states.data(), states.size(), reference.data());
+
+        for (size_t i = 0; i < states.size(); i++)
+        {
+            for (int axis = 0; axis < AXIS_COUNT; axis++)
+            {
+                float value = reference[i].values[axis];
+                float minimum = axis < AXIS_L2 ? -1.0f : 0.0f;
+                if (!(value >= minimum - AXIS_TEST_TOLERANCE && value <= 1.0f + AXIS_TEST_TOLERANCE))
+                {
+                    TestFailure(__FILE__, __LINE__, "scalar output in range",
+                                "config " + std::to_string(c) + " state " + std::to_string(i) + " axis " + std::to_string(axis) + ": " + std::to_string(value));
+                }
+            }
+        }
+
+        for (int kernel = AXIS_KERNEL_SCALAR + 1; kernel < AXIS_KERNEL_COUNT; kernel++)
+        {
+            PFN_AXIS_KERNEL processAxes = GetAxisKernel((EAxisKernel)kernel);
+            if (processAxes == nullptr)
+            {
+                continue;
+            }
+
+            // The whole batch, then one state per call
+            processAxes(processor, states.data(), states.size(), outputs.data());
+            for (size_t i = 0; i < states.size(); i += 97)
+            {
+                processAxes(processor, &states[i], 1, &outputs[i]);
+            }
+
+            double maxDifference = 0.0;
+            for (size_t i = 0; i < states.size(); i++)
+            {
+                for (int lane = 0; lane < AXIS_LANES; lane++)
+                {
+                    double difference = std::fabs((double)outputs[i].values[lane] - (double)reference[i].values[lane]);
+                    if (!(difference <= AXIS_TEST_TOLERANCE))
+                    {
+                        TestFailure(__FILE__, __LINE__, "kernel output ~= scalar output",
+                                    "kernel " + std::to_string(kernel) + " config " + std::to_string(c) + " state " + std::to_string(i) + " lane " +
+                                    std::to_string(lane) + ": " + std::to_string(outputs[i].values[lane]) + " against " + std::to_string(reference[i].values[lane]));
+                        return;
+                    }
+                    maxDifference = std::max(maxDifference, difference);
+                }
+            }
+            CHECK(maxDifference <= AXIS_TEST_TOLERANCE);
+        }
+    }
+}
+
+// =================================================================================================
+// centred_and_saturated    on every kernel: a centred stick and a resting trigger read 0, a stick
+//                          pushed to one end of an axis -1 or 1, a radial stick pushed into a
+//                          corner 1 in length, a trigger pulled all the way 1
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(axis_kernels, centred_and_saturated)
+{
+    SAxisConfig config;
+    config.rightStick = DEADZONE_AXIAL;
+    for (int axis = 0; axis < AXIS_COUNT; axis++)
+    {
+        config.axes[axis].deadzone = 0.1f;
+        config.axes[axis].outerDeadzone = 0.9f;
+        config.axes[axis].antiDeadzone = 0.1f;
+        config.axes[axis].curveExponent = 2.0f;
+    }
+    SAxisProcessor processor;
+    BuildAxisProcessor(config, processor);
+
+    for (int kernel = AXIS_KERNEL_SCALAR; kernel < AXIS_KERNEL_COUNT; kernel++)
+    {
+        if (GetAxisKernel((EAxisKernel)kernel) == nullptr)
+        {
+            continue;
+        }
+
+        // Centred, on either side of the half-way point 127.5
+        for (uint16_t centre : { (uint16_t)127, (uint16_t)128 })
+        {
+            SAxisOutput output = ProcessTestState((EAxisKernel)kernel, processor, centre, centre, 0);
+            for (int axis = 0; axis < AXIS_COUNT; axis++)
+            {
+                CHECK_EQ(output.values[axis], 0.0f);
+            }
+        }
+
+        // One end of X with Y centred; the radial left stick and the axial right stick agree
+        SAxisOutput output = ProcessTestState((EAxisKernel)kernel, processor, 255, 128, 255);
+        CHECK_NEAR(output.values[AXIS_LEFT_X], 1.0, AXIS_TEST_CENTRE_TOLERANCE);
+        CHECK_NEAR(output.values[AXIS_LEFT_Y], 0.0, AXIS_TEST_CENTRE_TOLERANCE);
+        CHECK_EQ(output.values[AXIS_RIGHT_Y], 0.0f);
+        CHECK_NEAR(output.values[AXIS_RIGHT_X], 1.0, AXIS_TEST_TOLERANCE);
+        CHECK_NEAR(output.values[AXIS_L2], 1.0, AXIS_TEST_TOLERANCE);
+        CHECK_NEAR(output.values[AXIS_R2], 1.0, AXIS_TEST_TOLERANCE);
+
+        output = ProcessTestState((EAxisKernel)kernel, processor, 127, 0, 0);
+        CHECK_NEAR(output.values[AXIS_LEFT_Y], -1.0, AXIS_TEST_CENTRE_TOLERANCE);
+        CHECK_NEAR(output.values[AXIS_RIGHT_Y], -1.0, AXIS_TEST_TOLERANCE);
+
+        // A corner: the radial stick keeps its direction at length 1, the axial one saturates both
+        output = ProcessTestState((EAxisKernel)kernel, processor, 0, 255, 0);
+        double length = std::sqrt((double)output.values[AXIS_LEFT_X] * output.values[AXIS_LEFT_X] +
+                                  (double)output.values[AXIS_LEFT_Y] * output.values[AXIS_LEFT_Y]);
+        CHECK_NEAR(length, 1.0, AXIS_TEST_TOLERANCE);
+        CHECK_NEAR(output.values[AXIS_LEFT_X], -output.values[AXIS_LEFT_Y], AXIS_TEST_TOLERANCE);
+        CHECK_NEAR(output.values[AXIS_RIGHT_X], -1.0, AXIS_TEST_TOLERANCE);
+        CHECK_NEAR(output.values[AXIS_RIGHT_Y], 1.0, AXIS_TEST_TOLERANCE);
+
+        // The unused lanes stay zero
+        CHECK_EQ(output.values[AXIS_COUNT], 0.0f);
+        CHECK_EQ(output.values[AXIS_LANES - 1], 0.0f);
+    }
+}
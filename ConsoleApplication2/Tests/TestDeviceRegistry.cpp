@@ -0,0 +1,251 @@
+// =================================================================================================
+// CDeviceRegistry tests: ten seconds of 2 kHz arrival and removal churn on the 8-controller
+// registry, in random order, checked after every step against a std::map oracle and a model of
+// the player-index policy, so the backward-shift deletion of the handle table is exercised with
+// every probe chain the churn builds.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+#include "TestHarness.h"
+#include "CDeviceRegistry.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int REGISTRY_CHURN_EVENTS = 20000;         // 10 s at 2 kHz
+const int REGISTRY_CHURN_IDENTITIES = 12;        // more pads than slots, so the registry fills up
+const int REGISTRY_CHURN_HANDLES = 40;           // a replugged pad comes back under a new handle
+const uint32_t REGISTRY_CHURN_SEED = 0x6D2B79F5;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// What the registry should remember about a player index
+struct SModelSlot
+{
+	bool connected;
+	bool used;
+	uint32_t identity;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// NextChurnValue           xorshift32, the same churn on every run
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t NextChurnValue(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// =================================================================================================
+// ExpectedPlayerIndex      the slot the pad had before when nobody took it since, else the first
+//                          never used one, else the first free one
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int ExpectedPlayerIndex(const SModelSlot* slots, uint32_t identity)
+{
+    int neverUsed = INVALID_PLAYER_INDEX;
+    int anyFree = INVALID_PLAYER_INDEX;
+    for (int i = 0; i < MAX_CONTROLLERS; i++)
+    {
+        if (slots[i].connected)
+        {
+            continue;
+        }
+        if (slots[i].used && slots[i].identity == identity)
+        {
+            return i;
+        }
+        if (!slots[i].used && neverUsed == INVALID_PLAYER_INDEX)
+        {
+            neverUsed = i;
+        }
+        if (anyFree == INVALID_PLAYER_INDEX)
+        {
+            anyFree = i;
+        }
+    }
+    return neverUsed != INVALID_PLAYER_INDEX ? neverUsed : anyFree;
+}
+
+// =================================================================================================
+// churn                    random arrivals, removals and lookups; after every step each handle of
+//                          the pool is found exactly when the oracle holds it, in its own slot
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(device_registry, churn)
+{
+    CDeviceRegistry registry;
+    SModelSlot model[MAX_CONTROLLERS] = {};
+    std::map<void*, int> oracle;                          // attached handle to player index
+    std::map<uint32_t, void*> attachedHandles;            // attached identity to its handle
+
+    // Neighbouring addresses, so the 8 live handles share probe chains in the table
+    std::vector<unsigned char> storage(REGISTRY_CHURN_HANDLES * 8);
+    std::vector<void*> handles;
+    for (int i = 0; i < REGISTRY_CHURN_HANDLES; i++)
+    {
+        handles.push_back(&storage[i * 8]);
+    }
+
+    uint32_t random = REGISTRY_CHURN_SEED;
+    int arrivals = 0;
+    int refused = 0;
+    int sameIndexAgain = 0;
+    int mismatches = 0;
+    for (int event = 0; event < REGISTRY_CHURN_EVENTS; event++)
+    {
+        uint32_t action = NextChurnValue(random) % 3;
+        if (action == 0)
+        {
+            // Arrival of a pad that is not attached, under a handle nobody holds
+            uint32_t identity = 1 + NextChurnValue(random) % REGISTRY_CHURN_IDENTITIES;
+            if (attachedHandles.count(identity) != 0)
+            {
+                continue;
+            }
+            void* handle = handles[NextChurnValue(random) % REGISTRY_CHURN_HANDLES];
+            while (oracle.count(handle) != 0)
+            {
+                handle = handles[NextChurnValue(random) % REGISTRY_CHURN_HANDLES];
+            }
+
+            int expected = ExpectedPlayerIndex(model, identity);
+            bool returning = expected != INVALID_PLAYER_INDEX && model[expected].used && model[expected].identity == identity;
+            int playerIndex = registry.Attach(handle, identity);
+            CHECK_EQ(playerIndex, expected);
+            if (playerIndex != expected)
+            {
+                mismatches++;
+                break;
+            }
+            if (playerIndex == INVALID_PLAYER_INDEX)
+            {
+                refused++;
+                continue;
+            }
+
+            arrivals++;
+            sameIndexAgain += returning ? 1 : 0;
+            model[playerIndex].connected = true;
+            model[playerIndex].used = true;
+            model[playerIndex].identity = identity;
+            oracle[handle] = playerIndex;
+            attachedHandles[identity] = handle;
+
+            // Attaching it again changes nothing
+            CHECK_EQ(registry.Attach(handle, identity), playerIndex);
+        }
+        else if (action == 1 && !oracle.empty())
+        {
+            // Removal of a random attached pad
+            std::map<void*, int>::iterator victim = oracle.begin();
+            std::advance(victim, NextChurnValue(random) % oracle.size());
+            int playerIndex = victim->second;
+            registry.Detach(victim->first);
+            attachedHandles.erase(model[playerIndex].identity);
+            model[playerIndex].connected = false;
+            oracle.erase(victim);
+        }
+        else
+        {
+            // Removing a handle that is not attached is a no-op
+            void* handle = handles[NextChurnValue(random) % REGISTRY_CHURN_HANDLES];
+            if (oracle.count(handle) == 0)
+            {
+                registry.Detach(handle);
+            }
+        }
+
+        for (void* handle : handles)
+        {
+            std::map<void*, int>::const_iterator entry = oracle.find(handle);
+            SDeviceSlot* slot = registry.Find(handle);
+            int expected = entry != oracle.end() ? entry->second : INVALID_PLAYER_INDEX;
+            int found = slot != nullptr ? registry.PlayerIndexOf(slot) : INVALID_PLAYER_INDEX;
+            if (found != expected || (slot != nullptr && slot->handle != handle))
+            {
+                mismatches++;
+            }
+        }
+        if (registry.ConnectedCount() != (int)oracle.size())
+        {
+            mismatches++;
+        }
+        if (mismatches != 0)
+        {
+            TestFailure(__FILE__, __LINE__, "registry agrees with the oracle", "diverged at event " + std::to_string(event));
+            break;
+        }
+    }
+
+    CHECK_EQ(mismatches, 0);
+    CHECK(registry.Find(nullptr) == nullptr);
+
+    // The churn went through a full registry, returning pads and slots handed to newcomers
+    CHECK(arrivals > REGISTRY_CHURN_EVENTS / 10);
+    CHECK(refused > 0);
+    CHECK(sameIndexAgain > 0);
+    CHECK(sameIndexAgain < arrivals);
+}
+
+// =================================================================================================
+// player_index_stable      a pad unplugged and replugged under a new handle gets its index back
+//                          while the others stay where they are; a stranger takes a free slot
+//                          only when no never-used one is left
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(device_registry, player_index_stable)
+{
+    CDeviceRegistry registry;
+    int keys[MAX_CONTROLLERS + 2] = {};
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK_EQ(registry.Attach(&keys[i], 100 + i), i);
+    }
+
+    registry.Detach(&keys[1]);
+    CHECK(registry.Find(&keys[1]) == nullptr);
+    CHECK(registry.Find(&keys[0]) == registry.GetSlot(0));
+    CHECK(registry.Find(&keys[2]) == registry.GetSlot(2));
+
+    // A newcomer skips the slot kept for identity 101
+    CHECK_EQ(registry.Attach(&keys[3], 200), 3);
+    CHECK_EQ(registry.Attach(&keys[4], 101), 1);
+    CHECK_EQ(registry.ConnectedCount(), 4);
+
+    for (int i = 5; i < MAX_CONTROLLERS + 1; i++)
+    {
+        CHECK_EQ(registry.Attach(&keys[i], 300 + i), i - 1);
+    }
+    CHECK_EQ(registry.Attach(&keys[MAX_CONTROLLERS + 1], 999), INVALID_PLAYER_INDEX);
+
+    // With every slot used once, a stranger takes the first free one; the pad it belonged to takes
+    // whatever is free when it comes back
+    registry.Detach(&keys[2]);
+    registry.Detach(&keys[6]);
+    CHECK_EQ(registry.Attach(&keys[MAX_CONTROLLERS + 1], 999), 2);
+    CHECK_EQ(registry.Attach(&keys[2], 102), 5);
+    CHECK_EQ(registry.ConnectedCount(), MAX_CONTROLLERS);
+}
@@ -0,0 +1,239 @@
+// =================================================================================================
+// CDisplayDiff tests: the lines a change of each JSDATA field dirties, none for the same sample,
+// the player line on a switch of player or connected count, and the bands the data window
+// invalidates for a mask, laid out where DrawTextOnDC has always drawn its text.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <vector>
+#include "TestHarness.h"
+#include "DisplayDiff.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int DISPLAY_TEST_WIDTH = 640;
+
+// The lines a state change can dirty; the stats lines are redrawn by their own timer
+const uint32_t DISPLAY_TEST_STATE_LINES = (1u << DISPLAY_LINE_STATS_RATE) - 1;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// MakeDisplayState         a pad mid-use, every field away from its default
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static JSDATA MakeDisplayState()
+{
+    JSDATA jsData;
+    jsData.leftX = 100;
+    jsData.leftY = 110;
+    jsData.rightX = 120;
+    jsData.rightY = 130;
+    jsData.L2 = 40;
+    jsData.R2 = 50;
+    jsData.arrowValue = 2;
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        jsData.HandlePressed[i] = (i % 3) == 0;
+    }
+    return jsData;
+}
+
+// =================================================================================================
+// ChangeDisplayLine        changes the one field shown on the given state line
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void ChangeDisplayLine(JSDATA& jsData, int line)
+{
+    switch (line)
+    {
+        case DISPLAY_LINE_LEFT_X:   jsData.leftX++; break;
+        case DISPLAY_LINE_LEFT_Y:   jsData.leftY++; break;
+        case DISPLAY_LINE_RIGHT_X:  jsData.rightX++; break;
+        case DISPLAY_LINE_RIGHT_Y:  jsData.rightY++; break;
+        case DISPLAY_LINE_R2:       jsData.R2++; break;
+        case DISPLAY_LINE_L2:       jsData.L2++; break;
+        case DISPLAY_LINE_ARROW:    jsData.arrowValue = -1; break;
+        default:
+            jsData.HandlePressed[line - DISPLAY_LINE_BUTTON_FIRST] = !jsData.HandlePressed[line - DISPLAY_LINE_BUTTON_FIRST];
+            break;
+    }
+}
+
+// =================================================================================================
+// DirtyRects               the bands InvalidateLines hands to WM_PAINT for a mask, top to bottom
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<SDisplayRect> DirtyRects(uint32_t lineMask, int clientWidth)
+{
+    std::vector<SDisplayRect> rects;
+    for (int line = 0; line < DISPLAY_LINE_COUNT; line++)
+    {
+        if (lineMask & (1u << line))
+        {
+            rects.push_back(GetDisplayLineRect(line, clientWidth));
+        }
+    }
+    return rects;
+}
+
+// =================================================================================================
+// first_update             nothing drawn yet, or drawn and invalidated, redraws every line
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(display_diff, first_update)
+{
+    CDisplayDiff diff;
+    JSDATA jsData = MakeDisplayState();
+    CHECK_EQ(diff.Update(jsData, 0, 1), DISPLAY_ALL_LINES);
+    CHECK_EQ(diff.Update(jsData, 0, 1), 0u);
+
+    diff.Invalidate();
+    CHECK_EQ(diff.Update(jsData, 0, 1), DISPLAY_ALL_LINES);
+    CHECK_EQ(diff.Update(jsData, 0, 1), 0u);
+
+    // A default JSDATA is a state like any other once drawn
+    CDisplayDiff idle;
+    CHECK_EQ(idle.Update(JSDATA(), 0, 0), DISPLAY_ALL_LINES);
+    CHECK_EQ(idle.Update(JSDATA(), 0, 0), 0u);
+}
+
+// =================================================================================================
+// single_field             a change of one field dirties its line alone, and so does changing it
+//                          back; an identical sample dirties nothing
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(display_diff, single_field)
+{
+    const JSDATA base = MakeDisplayState();
+    for (int line = 0; line < DISPLAY_LINE_PLAYER; line++)
+    {
+        CDisplayDiff diff;
+        diff.Update(base, 1, 2);
+
+        JSDATA changed = base;
+        ChangeDisplayLine(changed, line);
+        CHECK_EQ(DiffDisplayLines(base, changed), 1u << line);
+        CHECK_EQ(diff.Update(changed, 1, 2), 1u << line);
+        CHECK_EQ(diff.Update(changed, 1, 2), 0u);
+        CHECK_EQ(diff.Update(base, 1, 2), 1u << line);
+    }
+
+    CHECK_EQ(DiffDisplayLines(base, base), 0u);
+}
+
+// =================================================================================================
+// several_fields           the mask is the union of the changed lines and nothing else; a state
+//                          change never touches the stats lines
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(display_diff, several_fields)
+{
+    const JSDATA base = MakeDisplayState();
+    JSDATA changed = base;
+    ChangeDisplayLine(changed, DISPLAY_LINE_LEFT_Y);
+    ChangeDisplayLine(changed, DISPLAY_LINE_ARROW);
+    ChangeDisplayLine(changed, DISPLAY_LINE_BUTTON_FIRST);
+    ChangeDisplayLine(changed, DISPLAY_LINE_BUTTON_FIRST + BUTTONS_NUM - 1);
+
+    uint32_t expected = (1u << DISPLAY_LINE_LEFT_Y) | (1u << DISPLAY_LINE_ARROW) |
+                        (1u << DISPLAY_LINE_BUTTON_FIRST) | (1u << (DISPLAY_LINE_BUTTON_FIRST + BUTTONS_NUM - 1));
+    CHECK_EQ(DiffDisplayLines(base, changed), expected);
+
+    CDisplayDiff diff;
+    diff.Update(base, 0, 1);
+    CHECK_EQ(diff.Update(changed, 0, 1), expected);
+
+    JSDATA everything = base;
+    for (int line = 0; line < DISPLAY_LINE_PLAYER; line++)
+    {
+        ChangeDisplayLine(everything, line);
+    }
+    CHECK_EQ(DiffDisplayLines(base, everything), (1u << DISPLAY_LINE_PLAYER) - 1);
+    diff.Update(base, 0, 1);
+    CHECK_EQ(diff.Update(everything, 3, 4), DISPLAY_TEST_STATE_LINES);
+}
+
+// =================================================================================================
+// player_line              another player or another connected count dirties the player line
+//                          alone; the shown player's fields are diffed against what was drawn
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(display_diff, player_line)
+{
+    const JSDATA base = MakeDisplayState();
+    CDisplayDiff diff;
+    diff.Update(base, 0, 1);
+
+    CHECK_EQ(diff.Update(base, 0, 2), 1u << DISPLAY_LINE_PLAYER);
+    CHECK_EQ(diff.Update(base, 1, 2), 1u << DISPLAY_LINE_PLAYER);
+    CHECK_EQ(diff.Update(base, 1, 2), 0u);
+    CHECK_EQ(diff.Update(base, 0, 1), 1u << DISPLAY_LINE_PLAYER);
+
+    // Switching to a player whose pad differs in one button redraws that button and the player
+    JSDATA other = base;
+    ChangeDisplayLine(other, DISPLAY_LINE_BUTTON_FIRST + 2);
+    CHECK_EQ(diff.Update(other, 1, 1), (1u << DISPLAY_LINE_PLAYER) | (1u << (DISPLAY_LINE_BUTTON_FIRST + 2)));
+}
+
+// =================================================================================================
+// line_rects               every line sits where DrawTextOnDC drew it: the axes from y 10, the
+//                          buttons from y 160, the player line and stats a gap below them; the
+//                          bands of a mask are full width, one line high and never overlap
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(display_diff, line_rects)
+{
+    for (int line = 0; line < DISPLAY_LINE_BUTTON_FIRST; line++)
+    {
+        CHECK_EQ(GetDisplayLineTop(line), 10 + line * DISPLAY_LINE_HEIGHT);
+    }
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        CHECK_EQ(GetDisplayLineTop(DISPLAY_LINE_BUTTON_FIRST + i), 160 + i * 20);
+    }
+    int playerTop = 160 + BUTTONS_NUM * 20 + 10;
+    CHECK_EQ(GetDisplayLineTop(DISPLAY_LINE_PLAYER), playerTop);
+    CHECK_EQ(GetDisplayLineTop(DISPLAY_LINE_STATS_RATE), playerTop + DISPLAY_LINE_HEIGHT);
+    CHECK_EQ(GetDisplayLineTop(DISPLAY_LINE_STATS_LATENCY), playerTop + 2 * DISPLAY_LINE_HEIGHT);
+
+    CHECK(DirtyRects(0, DISPLAY_TEST_WIDTH).empty());
+
+    uint32_t mask = (1u << DISPLAY_LINE_LEFT_X) | (1u << DISPLAY_LINE_ARROW) |
+                    (1u << (DISPLAY_LINE_BUTTON_FIRST + 4)) | (1u << DISPLAY_LINE_PLAYER);
+    std::vector<SDisplayRect> rects = DirtyRects(mask, DISPLAY_TEST_WIDTH);
+    REQUIRE(rects.size() == 4);
+    CHECK_EQ(rects[0].top, GetDisplayLineTop(DISPLAY_LINE_LEFT_X));
+    CHECK_EQ(rects[1].top, GetDisplayLineTop(DISPLAY_LINE_ARROW));
+    CHECK_EQ(rects[2].top, 160 + 4 * 20);
+    CHECK_EQ(rects[3].top, playerTop);
+
+    std::vector<SDisplayRect> all = DirtyRects(DISPLAY_ALL_LINES, DISPLAY_TEST_WIDTH);
+    REQUIRE(all.size() == (size_t)DISPLAY_LINE_COUNT);
+    for (size_t i = 0; i < all.size(); i++)
+    {
+        CHECK_EQ(all[i].left, 0);
+        CHECK_EQ(all[i].right, DISPLAY_TEST_WIDTH);
+        CHECK_EQ(all[i].bottom - all[i].top, DISPLAY_LINE_HEIGHT);
+        if (i > 0)
+        {
+            CHECK(all[i].top >= all[i - 1].bottom);
+        }
+    }
+}
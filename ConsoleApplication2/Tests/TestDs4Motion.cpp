@@ -0,0 +1,383 @@
+// =================================================================================================
+// DS4 motion tests: the factory calibration of golden feature reports 0x02 and 0x05, reports it
+// refuses, gyro and accel conversion in physical units, the SSE2 conversion against the scalar
+// one, the sensor clock across wraps, and the battery level of input reports.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cmath>
+#include <cstring>
+#include "TestHarness.h"
+#include "TestReports.h"
+#include "CpuFeatures.h"
+#include "Ds4Motion.h"
+#include "DsuProtocol.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint32_t MOTION_TEST_SEED = 0x3C6EF372u;
+const int MOTION_TEST_SAMPLES = 20000;
+const double MOTION_TEST_TOLERANCE = 1e-4;
+
+// Both kernels subtract and multiply in single precision, so they agree to rounding at most
+const double MOTION_TEST_KERNEL_TOLERANCE = 1e-6;
+
+// The golden pad: gyro bias -7 3 1; pitch +8900 -8880, yaw +8850 -8866, roll +8870 -8860;
+// speed +540 -540; accel X +8300 -8100, Y +8200 -8150, Z +8250 -8000
+static const unsigned char GOLDEN_DS4_USB_CALIBRATION[DS4_CALIBRATION_USB_SIZE] =
+{
+    0x02, 0xF9, 0xFF, 0x03, 0x00, 0x01, 0x00, 0xC4, 0x22, 0x50,     // 0..9
+    0xDD, 0x92, 0x22, 0x5E, 0xDD, 0xA6, 0x22, 0x64, 0xDD, 0x1C,     // 10..19
+    0x02, 0x1C, 0x02, 0x6C, 0x20, 0x5C, 0xE0, 0x08, 0x20, 0x2A,     // 20..29
+    0xE0, 0x3A, 0x20, 0xC0, 0xE0, 0x00, 0x00                        // 30..36
+};
+
+// The same pad over Bluetooth: the three plus values of the gyro first, then the three minus,
+// and the CRC-32 of the report
+static const unsigned char GOLDEN_DS4_BT_CALIBRATION[DS4_CALIBRATION_BT_SIZE] =
+{
+    0x05, 0xF9, 0xFF, 0x03, 0x00, 0x01, 0x00, 0xC4, 0x22, 0x92,     // 0..9
+    0x22, 0xA6, 0x22, 0x50, 0xDD, 0x5E, 0xDD, 0x64, 0xDD, 0x1C,     // 10..19
+    0x02, 0x1C, 0x02, 0x6C, 0x20, 0x5C, 0xE0, 0x08, 0x20, 0x2A,     // 20..29
+    0xE0, 0x3A, 0x20, 0xC0, 0xE0, 0x00, 0x00, 0x78, 0xDA, 0x88,     // 30..39
+    0x22                                                            // 40
+};
+
+// What the golden pad calibrates to: twice the speed over the gyro range about the bias, and the
+// accel centred between its 1 g readings; one float division each, so exact once rounded to float
+static const double GOLDEN_GYRO_SCALE[3] = { 1080.0 / 17780.0, 1080.0 / 17716.0, 1080.0 / 17730.0 };
+static const double GOLDEN_ACCEL_BIAS[3] = { 100.0, 25.0, 125.0 };
+static const double GOLDEN_ACCEL_SCALE[3] = { 2.0 / 16400.0, 2.0 / 16350.0, 2.0 / 16250.0 };
+
+// Offsets in report 0x02 of the fields the refusal cases break
+const size_t CALIBRATION_PITCH_PLUS = 7;
+const size_t CALIBRATION_PITCH_MINUS = 9;
+const size_t CALIBRATION_SPEED_PLUS = 19;
+const size_t CALIBRATION_SPEED_MINUS = 21;
+const size_t CALIBRATION_ACCEL_Z_PLUS = 31;
+
+// Battery byte of a DS4 USB input report: level in the low nibble, cable connected in bit 4
+const size_t DS4_USB_BATTERY_OFFSET = 30;
+const unsigned char DS4_BATTERY_CABLE = 0x10;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// NextMotionTestValue      xorshift32
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t NextMotionTestValue(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// =================================================================================================
+// WriteTestInt16
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void WriteTestInt16(unsigned char* bytes, int value)
+{
+    bytes[0] = (unsigned char)(value & 0xFF);
+    bytes[1] = (unsigned char)((value >> 8) & 0xFF);
+}
+
+// =================================================================================================
+// CheckGoldenCalibration
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CheckGoldenCalibration(const SImuCalibration& calibration)
+{
+    CHECK(calibration.factory);
+    for (int i = 0; i < 3; i++)
+    {
+        // The pad removes the gyro bias itself
+        CHECK_EQ(calibration.bias[i], 0.0f);
+        CHECK_EQ(calibration.scale[i], (float)GOLDEN_GYRO_SCALE[i]);
+        CHECK_EQ(calibration.bias[3 + i], (float)GOLDEN_ACCEL_BIAS[i]);
+        CHECK_EQ(calibration.scale[3 + i], (float)GOLDEN_ACCEL_SCALE[i]);
+    }
+    for (int i = IMU_CHANNELS; i < IMU_LANES; i++)
+    {
+        CHECK_EQ(calibration.bias[i], 0.0f);
+        CHECK_EQ(calibration.scale[i], 0.0f);
+    }
+}
+
+// =================================================================================================
+// SameCalibration          bit for bit
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool SameCalibration(const SImuCalibration& a, const SImuCalibration& b)
+{
+    return std::memcmp(a.bias, b.bias, sizeof(a.bias)) == 0 && std::memcmp(a.scale, b.scale, sizeof(a.scale)) == 0 &&
+           a.factory == b.factory;
+}
+
+// =================================================================================================
+// calibration_golden       report 0x02 and report 0x05 of the same pad calibrate alike; the USB
+//                          report read in the Bluetooth order, as from the dongle, does not
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(motion, calibration_golden)
+{
+    SImuCalibration usb;
+    SetDefaultImuCalibration(usb);
+    REQUIRE(ParseDs4Calibration(GOLDEN_DS4_USB_CALIBRATION, sizeof(GOLDEN_DS4_USB_CALIBRATION), false, usb));
+    CheckGoldenCalibration(usb);
+
+    SImuCalibration bluetooth;
+    SetDefaultImuCalibration(bluetooth);
+    REQUIRE(ParseDs4Calibration(GOLDEN_DS4_BT_CALIBRATION, sizeof(GOLDEN_DS4_BT_CALIBRATION), true, bluetooth));
+    CheckGoldenCalibration(bluetooth);
+    CHECK(SameCalibration(usb, bluetooth));
+
+    // Pitch +8900 and yaw -8866 about the bias -7: 8907 + 8859
+    SImuCalibration dongle;
+    REQUIRE(ParseDs4Calibration(GOLDEN_DS4_USB_CALIBRATION, sizeof(GOLDEN_DS4_USB_CALIBRATION), true, dongle));
+    CHECK_EQ(dongle.scale[0], (float)(1080.0 / 17766.0));
+    CHECK(!SameCalibration(usb, dongle));
+}
+
+// =================================================================================================
+// calibration_refused      short reports, other IDs, a bad CRC and degenerate ranges leave the
+//                          calibration as it was
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(motion, calibration_refused)
+{
+    SImuCalibration calibration;
+    SetDefaultImuCalibration(calibration);
+    SImuCalibration before = calibration;
+    unsigned char report[DS4_CALIBRATION_BT_SIZE];
+
+    CHECK(!ParseDs4Calibration(nullptr, DS4_CALIBRATION_USB_SIZE, false, calibration));
+    CHECK(!ParseDs4Calibration(GOLDEN_DS4_USB_CALIBRATION, DS4_CALIBRATION_USB_SIZE - 1, false, calibration));
+    CHECK(!ParseDs4Calibration(GOLDEN_DS4_BT_CALIBRATION, DS4_CALIBRATION_BT_SIZE - 1, true, calibration));
+
+    std::memcpy(report, GOLDEN_DS4_USB_CALIBRATION, DS4_CALIBRATION_USB_SIZE);
+    report[0] = 0x03;
+    CHECK(!ParseDs4Calibration(report, DS4_CALIBRATION_USB_SIZE, false, calibration));
+
+    std::memcpy(report, GOLDEN_DS4_BT_CALIBRATION, DS4_CALIBRATION_BT_SIZE);
+    report[CALIBRATION_SPEED_PLUS] ^= 0x01;
+    CHECK(!ParseDs4Calibration(report, DS4_CALIBRATION_BT_SIZE, true, calibration));
+
+    // No gyro range: both limits on the bias
+    std::memcpy(report, GOLDEN_DS4_USB_CALIBRATION, DS4_CALIBRATION_USB_SIZE);
+    WriteTestInt16(report + CALIBRATION_PITCH_PLUS, -7);
+    WriteTestInt16(report + CALIBRATION_PITCH_MINUS, -7);
+    CHECK(!ParseDs4Calibration(report, DS4_CALIBRATION_USB_SIZE, false, calibration));
+
+    std::memcpy(report, GOLDEN_DS4_USB_CALIBRATION, DS4_CALIBRATION_USB_SIZE);
+    WriteTestInt16(report + CALIBRATION_SPEED_PLUS, 0);
+    WriteTestInt16(report + CALIBRATION_SPEED_MINUS, 0);
+    CHECK(!ParseDs4Calibration(report, DS4_CALIBRATION_USB_SIZE, false, calibration));
+
+    // Accel Z +1 g below -1 g
+    std::memcpy(report, GOLDEN_DS4_USB_CALIBRATION, DS4_CALIBRATION_USB_SIZE);
+    WriteTestInt16(report + CALIBRATION_ACCEL_Z_PLUS, -8100);
+    CHECK(!ParseDs4Calibration(report, DS4_CALIBRATION_USB_SIZE, false, calibration));
+
+    CHECK(SameCalibration(calibration, before));
+    CHECK(!calibration.factory);
+}
+
+// =================================================================================================
+// conversion               the golden pad's 1 g readings are 1 g, the gyro scales by its range,
+//                          and the nominal calibration reads 16 LSB as 1 deg/s and 8192 as 1 g
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(motion, conversion)
+{
+    SImuCalibration calibration;
+    REQUIRE(ParseDs4Calibration(GOLDEN_DS4_USB_CALIBRATION, sizeof(GOLDEN_DS4_USB_CALIBRATION), false, calibration));
+    SImuCalibration nominal;
+    SetDefaultImuCalibration(nominal);
+
+    SPadState state = SPadState();
+    state.gyro[0] = 1000;
+    state.gyro[1] = -2000;
+    state.gyro[2] = 32767;
+    state.accel[0] = 8300;
+    state.accel[1] = -8150;
+    state.accel[2] = 125;
+
+    SMotionSample motions[2];
+    ConvertPadMotion(calibration, state, motions[0]);
+    ConvertPadMotionScalar(calibration, state, motions[1]);
+    for (const SMotionSample& motion : motions)
+    {
+        CHECK_NEAR(motion.gyroDps[0], 1000 * GOLDEN_GYRO_SCALE[0], MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.gyroDps[1], -2000 * GOLDEN_GYRO_SCALE[1], MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.gyroDps[2], 32767 * GOLDEN_GYRO_SCALE[2], MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.accelG[0], 1.0, MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.accelG[1], -1.0, MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.accelG[2], 0.0, MOTION_TEST_TOLERANCE);
+    }
+
+    state.gyro[0] = 16;
+    state.gyro[1] = -32768;
+    state.gyro[2] = 0;
+    state.accel[0] = 8192;
+    state.accel[1] = -8192;
+    state.accel[2] = 4096;
+    ConvertPadMotion(nominal, state, motions[0]);
+    ConvertPadMotionScalar(nominal, state, motions[1]);
+    for (const SMotionSample& motion : motions)
+    {
+        CHECK_NEAR(motion.gyroDps[0], 1.0, MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.gyroDps[1], -2048.0, MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.gyroDps[2], 0.0, MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.accelG[0], 1.0, MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.accelG[1], -1.0, MOTION_TEST_TOLERANCE);
+        CHECK_NEAR(motion.accelG[2], 0.5, MOTION_TEST_TOLERANCE);
+    }
+}
+
+// =================================================================================================
+// kernels_agree            ConvertPadMotion, the SSE2 kernel where JOYSTICK_HAVE_SSE2, against the
+//                          scalar one over random readings and random valid calibrations; the
+//                          fields around the six results stay as they were
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(motion, kernels_agree)
+{
+    uint32_t random = MOTION_TEST_SEED;
+    SImuCalibration calibration;
+    SetDefaultImuCalibration(calibration);
+    int calibrations = 0;
+    int mismatches = 0;
+    int clobbered = 0;
+    for (int sample = 0; sample < MOTION_TEST_SAMPLES; sample++)
+    {
+        if (sample % 64 == 0)
+        {
+            unsigned char report[DS4_CALIBRATION_USB_SIZE];
+            std::memcpy(report, GOLDEN_DS4_USB_CALIBRATION, sizeof(report));
+            for (size_t offset = 1; offset + 1 < 35; offset += 2)
+            {
+                int value = (int16_t)(uint16_t)(report[offset] | (report[offset + 1] << 8));
+                WriteTestInt16(report + offset, value + (int)(NextMotionTestValue(random) % 2001) - 1000);
+            }
+            calibrations += ParseDs4Calibration(report, sizeof(report), (sample & 64) != 0, calibration) ? 1 : 0;
+        }
+
+        SPadState state = SPadState();
+        for (int i = 0; i < 3; i++)
+        {
+            state.gyro[i] = (int16_t)NextMotionTestValue(random);
+            state.accel[i] = (int16_t)NextMotionTestValue(random);
+        }
+        SMotionSample simd;
+        SMotionSample scalar;
+        std::memset(&simd, 0xA5, sizeof(simd));
+        std::memset(&scalar, 0xA5, sizeof(scalar));
+        ConvertPadMotion(calibration, state, simd);
+        ConvertPadMotionScalar(calibration, state, scalar);
+        for (int i = 0; i < 3; i++)
+        {
+            mismatches += std::fabs(simd.gyroDps[i] - scalar.gyroDps[i]) <= MOTION_TEST_KERNEL_TOLERANCE * (1 + std::fabs(scalar.gyroDps[i])) ? 0 : 1;
+            mismatches += std::fabs(simd.accelG[i] - scalar.accelG[i]) <= MOTION_TEST_KERNEL_TOLERANCE * (1 + std::fabs(scalar.accelG[i])) ? 0 : 1;
+        }
+        clobbered += std::memcmp(&simd.playerIndex, &scalar.playerIndex, sizeof(simd.playerIndex)) == 0 &&
+                     std::memcmp(&simd.dtSeconds, &scalar.dtSeconds, sizeof(simd.dtSeconds)) == 0 ? 0 : 1;
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(clobbered, 0);
+    CHECK(calibrations > MOTION_TEST_SAMPLES / 64 / 2);
+}
+
+// =================================================================================================
+// sensor_clock             188 ticks a report across the 16-bit wrap, and a gap of a second, more
+//                          than the clock shows, bridged with the host clock
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(motion, sensor_clock)
+{
+    CSensorClock clock;
+    uint64_t deltaTicks = 99;
+    uint16_t ticks = 65000;
+    uint64_t hostNs = 1000000000ULL;
+    CHECK_EQ(clock.Unwrap(ticks, hostNs, deltaTicks), 0u);
+    CHECK_EQ(deltaTicks, 0u);
+
+    uint64_t expected = 0;
+    for (int report = 0; report < 1000; report++)
+    {
+        ticks = (uint16_t)(ticks + 188);
+        hostNs += CSensorClock::TicksToNs(188);
+        expected += 188;
+        if (clock.Unwrap(ticks, hostNs, deltaTicks) != expected || deltaTicks != 188)
+        {
+            TestFailure(__FILE__, __LINE__, "Unwrap == 188 a report", "report " + std::to_string(report));
+            return;
+        }
+    }
+    CHECK_EQ(CSensorClock::TicksToNs(3), 16000u);
+
+    // One second is 187500 ticks, two wraps and 56428 more
+    ticks = (uint16_t)(ticks + 187500);
+    hostNs += 1000000000ULL;
+    CHECK_EQ(clock.Unwrap(ticks, hostNs, deltaTicks), expected + 187500);
+    CHECK_EQ(deltaTicks, 187500u);
+
+    clock.Reset();
+    CHECK_EQ(clock.Unwrap(ticks, hostNs + 1000000, deltaTicks), 0u);
+    CHECK_EQ(deltaTicks, 0u);
+}
+
+// =================================================================================================
+// battery                  the level nibble of a USB input report in percent, the same with the
+//                          cable in as without, 10 and the charging-only 11 both full; and the
+//                          DSU code each percent is served as
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(motion, battery)
+{
+    unsigned char report[DS4_USB_INPUT_REPORT_SIZE] = { DS4_USB_REPORT_ID, 0x80, 0x80, 0x80, 0x80, 0x08 };
+    for (unsigned int level = 0; level < 16; level++)
+    {
+        for (unsigned char cable : { (unsigned char)0, DS4_BATTERY_CABLE })
+        {
+            report[DS4_USB_BATTERY_OFFSET] = (unsigned char)(cable | level);
+            SPadState state = SPadState();
+            REQUIRE(DecodeDs4UsbPadState(report, sizeof(report), state));
+            unsigned int expected = level >= 10 ? 100 : level * 10;
+            if (state.battery != expected)
+            {
+                TestFailure(__FILE__, __LINE__, "state.battery == level percent",
+                            "level " + std::to_string(level) + (cable != 0 ? " on cable: " : ": ") + std::to_string(state.battery));
+            }
+        }
+    }
+
+    // Dying, low, medium, high, full; 0 is unknown
+    static const uint8_t percents[] = { 0, 5, 10, 29, 30, 59, 60, 89, 90, 100 };
+    static const uint8_t codes[] = { 0x00, 0x01, 0x02, 0x02, 0x03, 0x03, 0x04, 0x04, 0x05, 0x05 };
+    for (size_t i = 0; i < sizeof(percents); i++)
+    {
+        CHECK_EQ(DsuBatteryCode(percents[i]), codes[i]);
+    }
+}
@@ -0,0 +1,109 @@
+// =================================================================================================
+// The harness of joystick_tests. A case registers itself under a group at static initialisation;
+// CHECK records a failure and goes on, REQUIRE leaves the case. ctest runs one group per test:
+//
+//   joystick_tests [group ...]       no group runs them all
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+typedef void (*PFN_TEST_CASE)();
+
+class CTestRegistrar
+{
+public:
+   CTestRegistrar(const char* group, const char* name, PFN_TEST_CASE testCase);
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+void TestFailure(const char* file, int line, const char* expression, const std::string& detail);
+
+// A file for the case to write and read back, in the system temp directory; removed by the caller
+std::string TestTempPath(const char* name);
+
+// =================================================================================================
+// TestValueText
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename T>
+std::string TestValueText(const T& value)
+{
+	if constexpr (std::is_floating_point<T>::value)
+	{
+		return std::to_string((double)value);
+	}
+	else if constexpr (std::is_signed<T>::value)
+	{
+		return std::to_string((long long)value);
+	}
+	else
+	{
+		return std::to_string((unsigned long long)value);
+	}
+}
+
+// =================================================================================================
+// TestCheckEqual
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename A, typename B>
+bool TestCheckEqual(const A& actual, const B& expected, const char* file, int line, const char* expression)
+{
+	if (actual == expected)
+	{
+		return true;
+	}
+	TestFailure(file, line, expression, TestValueText(actual) + " != " + TestValueText(expected));
+	return false;
+}
+
+// =================================================================================================
+// TestCheckNear
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+inline bool TestCheckNear(double actual, double expected, double tolerance, const char* file, int line, const char* expression)
+{
+	double difference = actual > expected ? actual - expected : expected - actual;
+	if (difference <= tolerance)
+	{
+		return true;
+	}
+	TestFailure(file, line, expression, std::to_string(actual) + " not within " + std::to_string(tolerance) + " of " + std::to_string(expected));
+	return false;
+}
+
+#define TEST_CASE(group, name) \
+	static void Test_##group##_##name(); \
+	static CTestRegistrar g_testRegistrar_##group##_##name(#group, #name, Test_##group##_##name); \
+	static void Test_##group##_##name()
+
+#define CHECK(expression) \
+	((expression) ? (void)0 : TestFailure(__FILE__, __LINE__, #expression, std::string()))
+
+#define CHECK_EQ(actual, expected) \
+	((void)TestCheckEqual((actual), (expected), __FILE__, __LINE__, #actual " == " #expected))
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+	((void)TestCheckNear((actual), (expected), (tolerance), __FILE__, __LINE__, #actual " ~= " #expected))
+
+#define REQUIRE(expression) \
+	do { if (!(expression)) { TestFailure(__FILE__, __LINE__, #expression, std::string()); return; } } while (0)
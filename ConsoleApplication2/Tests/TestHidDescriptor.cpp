@@ -0,0 +1,200 @@
+// =================================================================================================
+// Descriptor cache tests: the usage to JSDATA field map, the descriptor hash, and the core keeping
+// one descriptor per device from arrival to removal instead of rebuilding it per report.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "TestHarness.h"
+#include "CJoystickCore.h"
+#include "HidDescriptor.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Vendor no layout decoder claims, so every report goes to the generic decoder
+const unsigned long TEST_GENERIC_VENDOR_ID = 0xFFFF;
+const unsigned long TEST_GENERIC_PRODUCT_ID = 0x0001;
+
+const size_t TEST_GENERIC_REPORT_SIZE = 8;
+
+// =================================================================================================
+// ===================================== GLOBAL VARIABLES ==========================================
+
+// What the stand-in generic decoder saw
+static int g_genericCalls = 0;
+static const SHidDeviceDescriptor* g_lastDescriptor = nullptr;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// DecodeTestGeneric        the value fields of the descriptor, in order, one report byte each
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool DecodeTestGeneric(SHidDeviceDescriptor& descriptor, const unsigned char* report, size_t length, JSDATA& jsData)
+{
+    g_genericCalls++;
+    g_lastDescriptor = &descriptor;
+    if (length < 1 + descriptor.valueFields.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < descriptor.valueFields.size(); i++)
+    {
+        StoreFieldValue(jsData, descriptor.valueFields[i].field, report[1 + i]);
+    }
+    return true;
+}
+
+// =================================================================================================
+// BuildTestDescriptor      every generic usage the field map knows, X first
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SHidDeviceDescriptor BuildTestDescriptor()
+{
+    static const unsigned short usages[] =
+    {
+        JS_USAGE_GENERIC_X, JS_USAGE_GENERIC_Y, JS_USAGE_GENERIC_Z, JS_USAGE_GENERIC_RZ,
+        JS_USAGE_GENERIC_RX, JS_USAGE_GENERIC_RY, JS_USAGE_GENERIC_HATSWITCH
+    };
+
+    SHidDeviceDescriptor descriptor;
+    descriptor.vendorId = TEST_GENERIC_VENDOR_ID;
+    descriptor.productId = TEST_GENERIC_PRODUCT_ID;
+    for (unsigned short usage : usages)
+    {
+        SValueField valueField = { JS_USAGE_PAGE_GENERIC, usage, MapUsageToField(JS_USAGE_PAGE_GENERIC, usage) };
+        descriptor.valueFields.push_back(valueField);
+    }
+    descriptor.preparsedData.assign(16, 0x5A);
+    descriptor.genericDecoder = DecodeTestGeneric;
+    return descriptor;
+}
+
+// =================================================================================================
+// field_map                every axis and the hat reach their own field, nothing else maps
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(descriptor_cache, field_map)
+{
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_X), JSFIELD_LEFT_X);
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_Y), JSFIELD_LEFT_Y);
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_Z), JSFIELD_RIGHT_X);
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_RZ), JSFIELD_RIGHT_Y);
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_RX), JSFIELD_L2);
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_RY), JSFIELD_R2);
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_GENERIC, JS_USAGE_GENERIC_HATSWITCH), JSFIELD_ARROW);
+
+    // Vendor and button pages and unknown generic usages feed nothing
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_BUTTON, JS_USAGE_GENERIC_X), JSFIELD_NONE);
+    CHECK_EQ(MapUsageToField(0xFF00, JS_USAGE_GENERIC_X), JSFIELD_NONE);
+    CHECK_EQ(MapUsageToField(JS_USAGE_PAGE_GENERIC, 0x36), JSFIELD_NONE);
+
+    JSDATA jsData;
+    StoreFieldValue(jsData, JSFIELD_LEFT_X, 1);
+    StoreFieldValue(jsData, JSFIELD_LEFT_Y, 2);
+    StoreFieldValue(jsData, JSFIELD_RIGHT_X, 3);
+    StoreFieldValue(jsData, JSFIELD_RIGHT_Y, 4);
+    StoreFieldValue(jsData, JSFIELD_L2, 5);
+    StoreFieldValue(jsData, JSFIELD_R2, 6);
+    StoreFieldValue(jsData, JSFIELD_ARROW, 7);
+    StoreFieldValue(jsData, JSFIELD_NONE, 99);
+    CHECK_EQ(jsData.leftX, 1);
+    CHECK_EQ(jsData.leftY, 2);
+    CHECK_EQ(jsData.rightX, 3);
+    CHECK_EQ(jsData.rightY, 4);
+    CHECK_EQ(jsData.L2, 5);
+    CHECK_EQ(jsData.R2, 6);
+    CHECK_EQ(jsData.arrowValue, 7);
+}
+
+// =================================================================================================
+// hash                     equal for identical devices, different once the IDs or parser data
+//                          differ
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(descriptor_cache, hash)
+{
+    SHidDeviceDescriptor a = BuildTestDescriptor();
+    SHidDeviceDescriptor b = BuildTestDescriptor();
+    CHECK_EQ(HashDeviceDescriptor(a), HashDeviceDescriptor(b));
+
+    b.productId++;
+    CHECK(HashDeviceDescriptor(a) != HashDeviceDescriptor(b));
+
+    b = BuildTestDescriptor();
+    b.preparsedData[7] ^= 1;
+    CHECK(HashDeviceDescriptor(a) != HashDeviceDescriptor(b));
+
+    b = BuildTestDescriptor();
+    b.reportDescriptor.push_back(0xC0);
+    CHECK(HashDeviceDescriptor(a) != HashDeviceDescriptor(b));
+}
+
+// =================================================================================================
+// kept_per_device          every report of a device is decoded with the descriptor it arrived with,
+//                          the last value field included; removal drops it and a new arrival
+//                          starts from its own
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(descriptor_cache, kept_per_device)
+{
+    CJoystickCore core;
+    JSDATA delivered;
+    core.SetCallback([&delivered](int, JSDATA jsData) { delivered = jsData; });
+
+    int firstKey = 0;
+    int secondKey = 0;
+    g_genericCalls = 0;
+    REQUIRE(core.OnDeviceArrived(&firstKey, 1, BuildTestDescriptor()) == 0);
+    REQUIRE(core.OnDeviceArrived(&secondKey, 2, BuildTestDescriptor()) == 1);
+
+    unsigned char report[TEST_GENERIC_REPORT_SIZE] = { 0x01, 10, 20, 30, 40, 50, 60, 3 };
+    REQUIRE(core.OnReport(&firstKey, report, sizeof(report), 1));
+    const SHidDeviceDescriptor* firstDescriptor = g_lastDescriptor;
+    CHECK_EQ(delivered.leftX, 10);
+    CHECK_EQ(delivered.leftY, 20);
+    CHECK_EQ(delivered.rightX, 30);
+    CHECK_EQ(delivered.rightY, 40);
+    CHECK_EQ(delivered.L2, 50);
+    CHECK_EQ(delivered.R2, 60);
+    CHECK_EQ(delivered.arrowValue, 3);
+
+    for (int i = 0; i < 100; i++)
+    {
+        report[1] = (unsigned char)i;
+        CHECK(core.OnReport(&firstKey, report, sizeof(report), 2 + i));
+        CHECK(g_lastDescriptor == firstDescriptor);
+    }
+    CHECK_EQ(delivered.leftX, 99);
+
+    CHECK(core.OnReport(&secondKey, report, sizeof(report), 200));
+    CHECK(g_lastDescriptor != firstDescriptor);
+    CHECK_EQ(g_genericCalls, 102);
+
+    // A report shorter than the cached field map is refused, not read past its end
+    CHECK(!core.OnReport(&firstKey, report, 4, 201));
+
+    core.OnDeviceRemoved(&firstKey);
+    CHECK(!core.IsDeviceAttached(&firstKey));
+    CHECK(!core.OnReport(&firstKey, report, sizeof(report), 202));
+    CHECK_EQ(g_genericCalls, 103);
+
+    SHidDeviceDescriptor fewerFields = BuildTestDescriptor();
+    fewerFields.valueFields.resize(2);
+    REQUIRE(core.OnDeviceArrived(&firstKey, 1, std::move(fewerFields)) == 0);
+    report[3] = 77;
+    CHECK(core.OnReport(&firstKey, report, 4, 203));
+    CHECK_EQ(delivered.rightX, 0);
+}
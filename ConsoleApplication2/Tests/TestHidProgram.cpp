@@ -0,0 +1,495 @@
+// =================================================================================================
+// Report program tests: the DS4 and DualSense report descriptors compile to golden programs that
+// decode like the layout decoders; rewrites of them that mean the same to a HID parser (wider
+// global items, Push/Pop blocks, feature and output items, string indices, vendor collections)
+// compile to the same program; and mangled descriptors are either refused or compile to a program
+// that keeps every promise it makes the interpreter.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "TestHarness.h"
+#include "TestReports.h"
+#include "HidCapsModel.h"
+#include "HidReportProgram.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint32_t HID_PROGRAM_TEST_SEED = 0x6A09E667u;
+const int HID_PROGRAM_TEST_REPORTS = 2000;          // random reports against the layout decoders
+const int HID_PROGRAM_TEST_REWRITES = 2000;         // equivalent descriptors of each pad
+const int HID_PROGRAM_TEST_FUZZ = 20000;            // mangled descriptors of each pad
+const int HID_PROGRAM_TEST_FUZZ_REPORTS = 4;
+const size_t HID_PROGRAM_TEST_MAX_REPORT_SIZE = 96;
+const size_t HID_PROGRAM_TEST_MAX_RANDOM_SIZE = 256;
+
+// Both pads send 64-byte input reports 0x01
+const size_t HID_PROGRAM_TEST_REPORT_SIZE = 64;
+
+// Item prefixes: type in bits 2-3, tag in bits 4-7, data size code in bits 0-1
+const unsigned char HID_ITEM_LONG = 0xFE;
+const unsigned char HID_ITEM_TYPE_MAIN = 0;
+const unsigned char HID_ITEM_TYPE_GLOBAL = 1;
+const unsigned char HID_ITEM_GLOBAL_PUSH = 0xA;
+const unsigned char HID_ITEM_GLOBAL_POP = 0xB;
+
+// Blocks that change nothing a parser compiles input from: globals undone by Pop, a feature and an
+// output report of their own usage, a string index taken by the next main item, and a vendor
+// application collection, which is no pad
+const unsigned char HID_BLOCK_GLOBALS[] = { 0xA4, 0x75, 0x10, 0x95, 0x03, 0x05, 0x0C, 0x15, 0x81, 0xB4 };
+const unsigned char HID_BLOCK_FEATURE[] = { 0xA4, 0x06, 0x00, 0xFF, 0x09, 0x40, 0x75, 0x08, 0x95, 0x05, 0xB1, 0x02, 0xB4 };
+const unsigned char HID_BLOCK_OUTPUT[] = { 0xA4, 0x06, 0x00, 0xFF, 0x09, 0x41, 0x75, 0x08, 0x95, 0x02, 0x91, 0x02, 0xB4 };
+const unsigned char HID_BLOCK_STRING_INDEX[] = { 0x79, 0x03 };
+const unsigned char HID_BLOCK_VENDOR_COLLECTION[] =
+{
+    0xA4, 0x06, 0x00, 0xFF, 0x09, 0x01, 0xA1, 0x01, 0x85, 0x7F, 0x09, 0x02, 0x75, 0x08, 0x95, 0x04, 0x81, 0x02, 0xC0, 0xB4
+};
+
+// What the descriptors compile to, checked by hand against them: sticks, triggers, the hat and the
+// first BUTTONS_NUM buttons of the run
+const SHidExtractOp DS4_GOLDEN_OPS[] =
+{
+    { 8, 8, JSFIELD_LEFT_X, 0, 1, 0, 0, 255 },
+    { 16, 8, JSFIELD_LEFT_Y, 0, 1, 0, 0, 255 },
+    { 24, 8, JSFIELD_RIGHT_X, 0, 1, 0, 0, 255 },
+    { 32, 8, JSFIELD_RIGHT_Y, 0, 1, 0, 0, 255 },
+    { 40, 4, JSFIELD_ARROW, 0, 1, 0, 0, 7 },
+    { 44, 12, JSFIELD_BUTTONS, HID_OP_BUTTON_RUN, 1, 0, 0, 1 },
+    { 64, 8, JSFIELD_L2, 0, 1, 0, 0, 255 },
+    { 72, 8, JSFIELD_R2, 0, 1, 0, 0, 255 },
+};
+
+const SHidExtractOp DUALSENSE_GOLDEN_OPS[] =
+{
+    { 8, 8, JSFIELD_LEFT_X, 0, 1, 0, 0, 255 },
+    { 16, 8, JSFIELD_LEFT_Y, 0, 1, 0, 0, 255 },
+    { 24, 8, JSFIELD_RIGHT_X, 0, 1, 0, 0, 255 },
+    { 32, 8, JSFIELD_RIGHT_Y, 0, 1, 0, 0, 255 },
+    { 40, 8, JSFIELD_L2, 0, 1, 0, 0, 255 },
+    { 48, 8, JSFIELD_R2, 0, 1, 0, 0, 255 },
+    { 64, 4, JSFIELD_ARROW, 0, 1, 0, 0, 7 },
+    { 68, 12, JSFIELD_BUTTONS, HID_OP_BUTTON_RUN, 1, 0, 0, 1 },
+};
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SHidTestPad
+{
+	const char* name;
+	const unsigned char* descriptor;
+	size_t descriptorSize;
+	const SHidExtractOp* goldenOps;
+	size_t goldenOpCount;
+	PFN_REPORT_DECODER reference;
+};
+
+const SHidTestPad HID_TEST_PADS[] =
+{
+    { "ds4", DS4_USB_REPORT_DESCRIPTOR, DS4_USB_REPORT_DESCRIPTOR_SIZE, DS4_GOLDEN_OPS,
+      sizeof(DS4_GOLDEN_OPS) / sizeof(DS4_GOLDEN_OPS[0]), DecodeDs4UsbReport },
+    { "dualsense", DUALSENSE_USB_REPORT_DESCRIPTOR, DUALSENSE_USB_REPORT_DESCRIPTOR_SIZE, DUALSENSE_GOLDEN_OPS,
+      sizeof(DUALSENSE_GOLDEN_OPS) / sizeof(DUALSENSE_GOLDEN_OPS[0]), DecodeDualSenseUsbReport },
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// NextHidTestValue         xorshift32
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t NextHidTestValue(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// =================================================================================================
+// SameExtractOp
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool SameExtractOp(const SHidExtractOp& a, const SHidExtractOp& b)
+{
+    return a.bitOffset == b.bitOffset && a.bitSize == b.bitSize && a.field == b.field && a.flags == b.flags &&
+           a.reportId == b.reportId && a.button == b.button && a.logicalMin == b.logicalMin && a.logicalMax == b.logicalMax;
+}
+
+// =================================================================================================
+// SameHidProgram           op for op and report for report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool SameHidProgram(const SHidReportProgram& a, const SHidReportProgram& b)
+{
+    if (a.numbered != b.numbered || a.ops.size() != b.ops.size() || a.reports.size() != b.reports.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.ops.size(); i++)
+    {
+        if (!SameExtractOp(a.ops[i], b.ops[i]))
+        {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a.reports.size(); i++)
+    {
+        const SHidProgramReport& ra = a.reports[i];
+        const SHidProgramReport& rb = b.reports[i];
+        if (ra.reportId != rb.reportId || ra.firstOp != rb.firstOp || ra.opCount != rb.opCount ||
+            ra.minLength != rb.minLength || ra.clearsButtons != rb.clearsButtons)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =================================================================================================
+// SplitHidItems            the short items of a descriptor, prefix and data each; false on a long
+//                          item or one cut short
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool SplitHidItems(const unsigned char* descriptor, size_t length, std::vector<std::vector<unsigned char>>& items)
+{
+    items.clear();
+    size_t position = 0;
+    while (position < length)
+    {
+        unsigned char prefix = descriptor[position];
+        size_t dataSize = (size_t)(prefix & 3) == 3 ? 4 : (size_t)(prefix & 3);
+        if (prefix == HID_ITEM_LONG || position + 1 + dataSize > length)
+        {
+            return false;
+        }
+        items.emplace_back(descriptor + position, descriptor + position + 1 + dataSize);
+        position += 1 + dataSize;
+    }
+    return true;
+}
+
+// =================================================================================================
+// WidenGlobalItem          the same value in four data bytes, sign-extended for the signed items:
+//                          logical and physical extents and the unit exponent
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<unsigned char> WidenGlobalItem(const std::vector<unsigned char>& item)
+{
+    unsigned char tag = (unsigned char)(item[0] >> 4);
+    size_t dataSize = item.size() - 1;
+    uint32_t value = 0;
+    for (size_t i = 0; i < dataSize; i++)
+    {
+        value |= (uint32_t)item[1 + i] << (8 * i);
+    }
+    bool isSigned = tag >= 1 && tag <= 5;
+    if (isSigned && dataSize < 4 && (value >> (8 * dataSize - 1)) != 0)
+    {
+        value |= ~0u << (8 * dataSize);
+    }
+
+    std::vector<unsigned char> wide(1, (unsigned char)(item[0] | 3));
+    for (int i = 0; i < 4; i++)
+    {
+        wide.push_back((unsigned char)(value >> (8 * i)));
+    }
+    return wide;
+}
+
+// =================================================================================================
+// RewriteHidDescriptor     a descriptor a parser must read as the same pad: global items widened,
+//                          blocks of no effect inserted where no local items are pending, string
+//                          indices anywhere, and vendor collections before and after
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<unsigned char> RewriteHidDescriptor(const std::vector<std::vector<unsigned char>>& items, uint32_t& random)
+{
+    static const std::vector<unsigned char> blocks[] =
+    {
+        std::vector<unsigned char>(HID_BLOCK_GLOBALS, HID_BLOCK_GLOBALS + sizeof(HID_BLOCK_GLOBALS)),
+        std::vector<unsigned char>(HID_BLOCK_FEATURE, HID_BLOCK_FEATURE + sizeof(HID_BLOCK_FEATURE)),
+        std::vector<unsigned char>(HID_BLOCK_OUTPUT, HID_BLOCK_OUTPUT + sizeof(HID_BLOCK_OUTPUT)),
+    };
+    std::vector<unsigned char> vendorCollection(HID_BLOCK_VENDOR_COLLECTION, HID_BLOCK_VENDOR_COLLECTION + sizeof(HID_BLOCK_VENDOR_COLLECTION));
+
+    std::vector<unsigned char> descriptor;
+    if (NextHidTestValue(random) % 4 == 0)
+    {
+        descriptor = vendorCollection;
+    }
+
+    bool localsPending = false;
+    for (const std::vector<unsigned char>& item : items)
+    {
+        unsigned char type = (unsigned char)((item[0] >> 2) & 3);
+        unsigned char tag = (unsigned char)(item[0] >> 4);
+
+        if (!localsPending && NextHidTestValue(random) % 4 == 0)
+        {
+            const std::vector<unsigned char>& block = blocks[NextHidTestValue(random) % 3];
+            descriptor.insert(descriptor.end(), block.begin(), block.end());
+        }
+        if (NextHidTestValue(random) % 8 == 0)
+        {
+            descriptor.insert(descriptor.end(), HID_BLOCK_STRING_INDEX, HID_BLOCK_STRING_INDEX + sizeof(HID_BLOCK_STRING_INDEX));
+        }
+
+        if (type == HID_ITEM_TYPE_GLOBAL && tag != HID_ITEM_GLOBAL_PUSH && tag != HID_ITEM_GLOBAL_POP &&
+            item.size() > 1 && item.size() < 5 && NextHidTestValue(random) % 3 == 0)
+        {
+            std::vector<unsigned char> wide = WidenGlobalItem(item);
+            descriptor.insert(descriptor.end(), wide.begin(), wide.end());
+        }
+        else
+        {
+            descriptor.insert(descriptor.end(), item.begin(), item.end());
+        }
+        localsPending = type != HID_ITEM_TYPE_MAIN && (localsPending || type != HID_ITEM_TYPE_GLOBAL);
+    }
+
+    if (NextHidTestValue(random) % 2 == 0)
+    {
+        descriptor.insert(descriptor.end(), vendorCollection.begin(), vendorCollection.end());
+    }
+    return descriptor;
+}
+
+// =================================================================================================
+// CheckAgainstReference    random input reports decode through the program as through the pad's
+//                          layout decoder; a short report or another ID leaves jsData untouched
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int CheckAgainstReference(const SHidTestPad& pad, const SHidReportProgram& program, uint32_t& random, int reports)
+{
+    int mismatches = 0;
+    unsigned char report[HID_PROGRAM_TEST_REPORT_SIZE];
+    for (int i = 0; i < reports; i++)
+    {
+        for (unsigned char& c : report)
+        {
+            c = (unsigned char)NextHidTestValue(random);
+        }
+        report[0] = 0x01;
+
+        JSDATA reference;
+        JSDATA decoded;
+        if (!pad.reference(report, sizeof(report), reference) || !RunHidReportProgram(program, report, sizeof(report), decoded) ||
+            !SamePadInput(reference, decoded))
+        {
+            mismatches++;
+        }
+
+        JSDATA untouched = decoded;
+        report[0] = 0x02;
+        mismatches += RunHidReportProgram(program, report, sizeof(report), decoded) ? 1 : 0;
+        report[0] = 0x01;
+        mismatches += RunHidReportProgram(program, report, program.reports[0].minLength - 1, decoded) ? 1 : 0;
+        mismatches += SameJsData(untouched, decoded) ? 0 : 1;
+    }
+    return mismatches;
+}
+
+// =================================================================================================
+// MangleHidDescriptor      bits flipped, bytes replaced, cut short, a slice repeated, or all random
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void MangleHidDescriptor(std::vector<unsigned char>& descriptor, uint32_t& random)
+{
+    switch (NextHidTestValue(random) % 5)
+    {
+        case 0:
+            for (uint32_t flips = 1 + NextHidTestValue(random) % 4; flips != 0; flips--)
+            {
+                uint32_t bit = NextHidTestValue(random) % (uint32_t)(descriptor.size() * 8);
+                descriptor[bit / 8] ^= (unsigned char)(1u << (bit % 8));
+            }
+            break;
+
+        case 1:
+            for (uint32_t bytes = 1 + NextHidTestValue(random) % 4; bytes != 0; bytes--)
+            {
+                descriptor[NextHidTestValue(random) % descriptor.size()] = (unsigned char)NextHidTestValue(random);
+            }
+            break;
+
+        case 2:
+            descriptor.resize(NextHidTestValue(random) % descriptor.size());
+            break;
+
+        case 3:
+        {
+            size_t first = NextHidTestValue(random) % descriptor.size();
+            size_t sliceLength = std::min<size_t>(1 + NextHidTestValue(random) % 8, descriptor.size() - first);
+            std::vector<unsigned char> slice(descriptor.begin() + first, descriptor.begin() + first + sliceLength);
+            for (uint32_t repeats = 1 + NextHidTestValue(random) % 64; repeats != 0; repeats--)
+            {
+                descriptor.insert(descriptor.begin() + first, slice.begin(), slice.end());
+            }
+            break;
+        }
+
+        default:
+            descriptor.resize(NextHidTestValue(random) % HID_PROGRAM_TEST_MAX_RANDOM_SIZE);
+            for (unsigned char& c : descriptor)
+            {
+                c = (unsigned char)NextHidTestValue(random);
+            }
+            break;
+    }
+}
+
+// =================================================================================================
+// golden                   each descriptor compiles to its golden program, and the program decodes
+//                          random reports as the layout decoder of the pad does
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(hid_program, golden)
+{
+    uint32_t random = HID_PROGRAM_TEST_SEED;
+    for (const SHidTestPad& pad : HID_TEST_PADS)
+    {
+        SHidReportProgram program;
+        REQUIRE(CompileHidReportDescriptor(pad.descriptor, pad.descriptorSize, program));
+        CHECK(CheckHidProgram(program));
+        CHECK(program.numbered);
+        REQUIRE(program.reports.size() == 1);
+        CHECK_EQ(program.reports[0].reportId, 1u);
+        CHECK_EQ(program.reports[0].firstOp, 0u);
+        CHECK_EQ(program.reports[0].minLength, 10u);
+        CHECK(program.reports[0].clearsButtons);
+
+        REQUIRE(program.ops.size() == pad.goldenOpCount);
+        for (size_t i = 0; i < pad.goldenOpCount; i++)
+        {
+            if (!SameExtractOp(program.ops[i], pad.goldenOps[i]))
+            {
+                TestFailure(__FILE__, __LINE__, "op == golden op", std::string(pad.name) + " op " + std::to_string(i));
+            }
+        }
+
+        int mismatches = CheckAgainstReference(pad, program, random, HID_PROGRAM_TEST_REPORTS);
+        if (mismatches != 0)
+        {
+            TestFailure(__FILE__, __LINE__, "program decode == layout decode", std::string(pad.name) + ": " + std::to_string(mismatches) + " mismatches");
+        }
+    }
+}
+
+// =================================================================================================
+// equivalent_rewrites      rewritten descriptors compile to the golden program and decode the same
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(hid_program, equivalent_rewrites)
+{
+    uint32_t random = HID_PROGRAM_TEST_SEED;
+    for (const SHidTestPad& pad : HID_TEST_PADS)
+    {
+        SHidReportProgram golden;
+        REQUIRE(CompileHidReportDescriptor(pad.descriptor, pad.descriptorSize, golden));
+        std::vector<std::vector<unsigned char>> items;
+        REQUIRE(SplitHidItems(pad.descriptor, pad.descriptorSize, items));
+
+        int refused = 0;
+        int different = 0;
+        int mismatches = 0;
+        for (int i = 0; i < HID_PROGRAM_TEST_REWRITES; i++)
+        {
+            std::vector<unsigned char> descriptor = RewriteHidDescriptor(items, random);
+            SHidReportProgram program;
+            if (!CompileHidReportDescriptor(descriptor.data(), descriptor.size(), program))
+            {
+                refused++;
+                continue;
+            }
+            if (!SameHidProgram(golden, program))
+            {
+                different++;
+                continue;
+            }
+            // The program is the golden one; a few reports show it runs the same
+            mismatches += CheckAgainstReference(pad, program, random, 4);
+        }
+        if (refused != 0 || different != 0 || mismatches != 0)
+        {
+            TestFailure(__FILE__, __LINE__, "rewrite compiles to the golden program",
+                        std::string(pad.name) + ": " + std::to_string(refused) + " refused, " + std::to_string(different) +
+                        " different, " + std::to_string(mismatches) + " decode mismatches");
+        }
+    }
+}
+
+// =================================================================================================
+// mangled                  a refused descriptor leaves the program empty; an accepted one keeps its
+//                          promises, and runs on random reports, each in a buffer of exactly its
+//                          size for the sanitizers, leaving jsData untouched when it refuses one
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(hid_program, mangled)
+{
+    uint32_t random = HID_PROGRAM_TEST_SEED;
+    int accepted = 0;
+    int violations = 0;
+    for (int i = 0; i < HID_PROGRAM_TEST_FUZZ; i++)
+    {
+        const SHidTestPad& pad = HID_TEST_PADS[i % 2];
+        std::vector<unsigned char> descriptor(pad.descriptor, pad.descriptor + pad.descriptorSize);
+        MangleHidDescriptor(descriptor, random);
+
+        SHidReportProgram program;
+        if (!CompileHidReportDescriptor(descriptor.data(), descriptor.size(), program))
+        {
+            violations += program.ops.empty() && program.reports.empty() ? 0 : 1;
+            continue;
+        }
+        accepted++;
+        violations += CheckHidProgram(program) ? 0 : 1;
+
+        for (int run = 0; run < HID_PROGRAM_TEST_FUZZ_REPORTS && !program.ops.empty(); run++)
+        {
+            std::vector<unsigned char> input(NextHidTestValue(random) % HID_PROGRAM_TEST_MAX_REPORT_SIZE);
+            for (unsigned char& c : input)
+            {
+                c = (unsigned char)NextHidTestValue(random);
+            }
+            if (!input.empty() && program.numbered)
+            {
+                input[0] = program.reports[NextHidTestValue(random) % program.reports.size()].reportId;
+            }
+
+            JSDATA jsData;
+            jsData.leftX = 12345;
+            jsData.HandlePressed[0] = true;
+            JSDATA before = jsData;
+            if (!RunHidReportProgram(program, input.data(), input.size(), jsData))
+            {
+                violations += SameJsData(before, jsData) ? 0 : 1;
+            }
+        }
+    }
+    CHECK_EQ(violations, 0);
+    // Most mangled descriptors still parse; a run that refuses all of them tests nothing
+    CHECK(accepted > HID_PROGRAM_TEST_FUZZ / 10);
+}
@@ -0,0 +1,320 @@
+// =================================================================================================
+// CInputFilterBank tests against the filters' own equations: the exponential step response, the
+// One Euro cutoff rising with speed, the Kalman filter settling on a constant, prediction along a
+// ramp up to its horizon, and the samples passed through untouched when nothing is filtered.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cmath>
+#include "TestHarness.h"
+#include "CJoystickCore.h"
+#include "InputFilters.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint64_t FILTER_TEST_STEP_NS = 4000000;       // a DS4 over USB
+const float FILTER_TEST_DT = 0.004f;
+const float FILTER_TEST_TWO_PI = 6.28318530718f;
+const int FILTER_TEST_DEVICE = 1;
+
+const int FILTER_TEST_STEP_REPORTS = 20;
+const int FILTER_TEST_SETTLE_REPORTS = 500;
+const float FILTER_TEST_RAMP_SLOPE = 2.0f;          // units per second
+const float FILTER_TEST_PREDICTION_MS = 8.0f;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// FilterConfigOf           every channel filtered the same way
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SFilterConfig FilterConfigOf(const SFilterSettings& settings)
+{
+    SFilterConfig config;
+    for (SFilterSettings& channel : config.channels)
+    {
+        channel = settings;
+    }
+    return config;
+}
+
+// =================================================================================================
+// FilterReport             one report of the device, every channel at value, filtered at once;
+//                          returns the state after it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SFilteredState FilterReport(CInputFilterBank& bank, float value, uint64_t timestampNs)
+{
+    float values[FILTER_CHANNELS];
+    for (float& channel : values)
+    {
+        channel = value;
+    }
+    bank.Submit(FILTER_TEST_DEVICE, values, timestampNs);
+    bank.Update();
+
+    SFilteredState state;
+    bank.GetState(FILTER_TEST_DEVICE, state);
+    return state;
+}
+
+// =================================================================================================
+// OneEuroFirstStep         what the One Euro filter makes of a step of size step from rest after
+//                          one report: the speed through its own low-pass, the cutoff from the speed
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static float OneEuroFirstStep(const SFilterSettings& settings, float step)
+{
+    float derivativeTau = 1.0f / (FILTER_TEST_TWO_PI * settings.derivativeCutoffHz);
+    float speed = FILTER_TEST_DT / (FILTER_TEST_DT + derivativeTau) * (step / FILTER_TEST_DT);
+    float cutoffHz = settings.minCutoffHz + settings.beta * std::fabs(speed);
+    float tau = 1.0f / (FILTER_TEST_TWO_PI * cutoffHz);
+    return step * FILTER_TEST_DT / (FILTER_TEST_DT + tau);
+}
+
+// =================================================================================================
+// pass_through             unfiltered channels follow every sample exactly and track its slope;
+//                          a core without filtering has no filtered or predicted state at all
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_filters, pass_through)
+{
+    CInputFilterBank bank;
+    const float samples[] = { 0.25f, -0.5f, 0.75f, 0.0f, 1.0f, -1.0f, 0.5f };
+    uint64_t timestampNs = FILTER_TEST_STEP_NS;
+    float previous = samples[0];
+    FilterReport(bank, previous, timestampNs);
+    for (float sample : samples)
+    {
+        timestampNs += FILTER_TEST_STEP_NS;
+        SFilteredState state = FilterReport(bank, sample, timestampNs);
+        CHECK_EQ(state.timestampNs, timestampNs);
+        for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+        {
+            CHECK_NEAR(state.value[channel], sample, 1e-6);
+            CHECK_NEAR(state.velocity[channel], (sample - previous) / FILTER_TEST_DT, 1e-3);
+        }
+        previous = sample;
+    }
+
+    // Without a prediction horizon a read ahead is the state as it is
+    SFilteredState state;
+    bank.GetState(FILTER_TEST_DEVICE, state);
+    float values[FILTER_CHANNELS];
+    bank.Predict(state, timestampNs + 10 * FILTER_TEST_STEP_NS, values);
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        CHECK_EQ(values[channel], state.value[channel]);
+    }
+
+    CJoystickCore core;
+    CHECK(!core.GetFilteredState(0, state));
+    CHECK(!core.GetPredictedState(0, timestampNs, values));
+}
+
+// =================================================================================================
+// exponential_step         a unit step after n reports stands at 1 - (1 - smoothing)^n
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_filters, exponential_step)
+{
+    const float smoothings[] = { 0.1f, 0.5f, 0.9f };
+    for (float smoothing : smoothings)
+    {
+        SFilterSettings settings;
+        settings.type = FILTER_EXPONENTIAL;
+        settings.smoothing = smoothing;
+        CInputFilterBank bank;
+        bank.Configure(FilterConfigOf(settings));
+
+        uint64_t timestampNs = FILTER_TEST_STEP_NS;
+        FilterReport(bank, 0.0f, timestampNs);
+        for (int n = 1; n <= FILTER_TEST_STEP_REPORTS; n++)
+        {
+            timestampNs += FILTER_TEST_STEP_NS;
+            SFilteredState state = FilterReport(bank, 1.0f, timestampNs);
+            double expected = 1.0 - std::pow(1.0 - smoothing, n);
+            CHECK_NEAR(state.value[FILTER_LEFT_X], expected, 1e-5);
+            CHECK_NEAR(state.value[FILTER_ACCEL_Z], expected, 1e-5);
+        }
+    }
+
+    // Smoothing 1 is no filtering, out of range values are clamped to it
+    SFilterSettings settings;
+    settings.type = FILTER_EXPONENTIAL;
+    settings.smoothing = 3.0f;
+    CInputFilterBank bank;
+    bank.Configure(FilterConfigOf(settings));
+    FilterReport(bank, 0.0f, FILTER_TEST_STEP_NS);
+    CHECK_NEAR(FilterReport(bank, 0.5f, 2 * FILTER_TEST_STEP_NS).value[FILTER_R2], 0.5, 1e-6);
+}
+
+// =================================================================================================
+// one_euro_cutoff          from rest, the share of a step taken in one report follows the cutoff
+//                          the step's speed raises: the same for a small and a large step without
+//                          beta, larger for the large step with it. On a ramp beta cuts the lag.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_filters, one_euro_cutoff)
+{
+    const float betas[] = { 0.0f, 1.0f };
+    const float steps[] = { 0.001f, 0.5f };
+    float share[2][2];
+    for (int b = 0; b < 2; b++)
+    {
+        for (int s = 0; s < 2; s++)
+        {
+            SFilterSettings settings;
+            settings.type = FILTER_ONE_EURO;
+            settings.minCutoffHz = 1.0f;
+            settings.derivativeCutoffHz = 1.0f;
+            settings.beta = betas[b];
+            CInputFilterBank bank;
+            bank.Configure(FilterConfigOf(settings));
+
+            FilterReport(bank, 0.0f, FILTER_TEST_STEP_NS);
+            SFilteredState state = FilterReport(bank, steps[s], 2 * FILTER_TEST_STEP_NS);
+            CHECK_NEAR(state.value[FILTER_RIGHT_X], OneEuroFirstStep(settings, steps[s]), 1e-6);
+            share[b][s] = state.value[FILTER_RIGHT_X] / steps[s];
+        }
+    }
+    CHECK_NEAR(share[0][0], share[0][1], 1e-4);
+    CHECK(share[1][1] > 2.0f * share[1][0]);
+    CHECK_NEAR(share[1][0], share[0][0], 1e-3);
+
+    // Following a ramp, the speed-raised cutoff lags behind it less
+    float lag[2];
+    for (int b = 0; b < 2; b++)
+    {
+        SFilterSettings settings;
+        settings.type = FILTER_ONE_EURO;
+        settings.beta = betas[b];
+        CInputFilterBank bank;
+        bank.Configure(FilterConfigOf(settings));
+
+        float input = 0.0f;
+        SFilteredState state = SFilteredState();
+        for (int n = 0; n < FILTER_TEST_STEP_REPORTS * 5; n++)
+        {
+            input = n * FILTER_TEST_DT * FILTER_TEST_RAMP_SLOPE * 0.1f;
+            state = FilterReport(bank, input, (uint64_t)(n + 1) * FILTER_TEST_STEP_NS);
+        }
+        lag[b] = input - state.value[FILTER_GYRO_YAW];
+        CHECK(lag[b] > 0.0f);
+    }
+    CHECK(lag[1] < 0.5f * lag[0]);
+}
+
+// =================================================================================================
+// kalman_constant          started away from it, the filter settles on a constant input with no
+//                          velocity left; on noise around a constant its output scatters less
+//                          than the input
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_filters, kalman_constant)
+{
+    SFilterSettings settings;
+    settings.type = FILTER_KALMAN;
+    CInputFilterBank bank;
+    bank.Configure(FilterConfigOf(settings));
+
+    const float target = 0.7f;
+    FilterReport(bank, 0.0f, FILTER_TEST_STEP_NS);
+    SFilteredState state = SFilteredState();
+    for (int n = 0; n < FILTER_TEST_SETTLE_REPORTS; n++)
+    {
+        state = FilterReport(bank, target, (uint64_t)(n + 2) * FILTER_TEST_STEP_NS);
+        for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+        {
+            REQUIRE(std::isfinite(state.value[channel]) && std::isfinite(state.velocity[channel]));
+        }
+    }
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        CHECK_NEAR(state.value[channel], target, 1e-4);
+        CHECK_NEAR(state.velocity[channel], 0.0, 1e-2);
+    }
+
+    settings.processNoise = 1.0f;
+    settings.measurementNoise = 0.01f;
+    bank.Configure(FilterConfigOf(settings));
+    bank.Reset(FILTER_TEST_DEVICE);
+    double inputError = 0.0;
+    double outputError = 0.0;
+    for (int n = 0; n < FILTER_TEST_SETTLE_REPORTS; n++)
+    {
+        float noise = (n % 2 == 0 ? 0.05f : -0.05f) * (float)((n % 3) + 1);
+        state = FilterReport(bank, target + noise, (uint64_t)(n + 1) * FILTER_TEST_STEP_NS);
+        if (n >= FILTER_TEST_SETTLE_REPORTS / 2)
+        {
+            inputError += noise * noise;
+            outputError += (state.value[FILTER_GYRO_PITCH] - target) * (state.value[FILTER_GYRO_PITCH] - target);
+        }
+    }
+    CHECK(outputError < 0.25 * inputError);
+}
+
+// =================================================================================================
+// prediction_ramp          along a ramp a read ahead moves on by the slope times the time ahead,
+//                          never further than the horizon, not backwards for a target in the past,
+//                          and axes and triggers stay in their range
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_filters, prediction_ramp)
+{
+    SFilterSettings settings;
+    settings.predictionMs = FILTER_TEST_PREDICTION_MS;
+    CInputFilterBank bank;
+    bank.Configure(FilterConfigOf(settings));
+
+    SFilteredState state = SFilteredState();
+    for (int n = 0; n < FILTER_TEST_STEP_REPORTS; n++)
+    {
+        state = FilterReport(bank, 0.1f + n * FILTER_TEST_DT * FILTER_TEST_RAMP_SLOPE, (uint64_t)(n + 1) * FILTER_TEST_STEP_NS);
+    }
+    float last = state.value[FILTER_GYRO_ROLL];
+    CHECK_NEAR(state.velocity[FILTER_GYRO_ROLL], FILTER_TEST_RAMP_SLOPE, 1e-3);
+
+    float values[FILTER_CHANNELS];
+    bank.Predict(state, state.timestampNs + FILTER_TEST_STEP_NS, values);
+    CHECK_NEAR(values[FILTER_GYRO_ROLL], last + FILTER_TEST_DT * FILTER_TEST_RAMP_SLOPE, 1e-5);
+    CHECK_NEAR(values[FILTER_LEFT_X], last + FILTER_TEST_DT * FILTER_TEST_RAMP_SLOPE, 1e-5);
+
+    bank.Predict(state, state.timestampNs + 10 * FILTER_TEST_STEP_NS, values);
+    CHECK_NEAR(values[FILTER_GYRO_ROLL], last + FILTER_TEST_PREDICTION_MS * 0.001f * FILTER_TEST_RAMP_SLOPE, 1e-5);
+
+    bank.Predict(state, state.timestampNs - FILTER_TEST_STEP_NS, values);
+    CHECK_EQ(values[FILTER_GYRO_ROLL], last);
+
+    // Near the top of their range the axes and triggers stop at 1, falling sticks at -1; the IMU
+    // has no range
+    state.value[FILTER_LEFT_Y] = 0.999f;
+    state.value[FILTER_L2] = 0.999f;
+    state.value[FILTER_RIGHT_Y] = -0.999f;
+    state.velocity[FILTER_RIGHT_Y] = -FILTER_TEST_RAMP_SLOPE;
+    state.value[FILTER_R2] = 0.001f;
+    state.velocity[FILTER_R2] = -FILTER_TEST_RAMP_SLOPE;
+    state.value[FILTER_GYRO_ROLL] = 0.999f;
+    bank.Predict(state, state.timestampNs + 10 * FILTER_TEST_STEP_NS, values);
+    CHECK_EQ(values[FILTER_LEFT_Y], 1.0f);
+    CHECK_EQ(values[FILTER_L2], 1.0f);
+    CHECK_EQ(values[FILTER_RIGHT_Y], -1.0f);
+    CHECK_EQ(values[FILTER_R2], 0.0f);
+    CHECK_NEAR(values[FILTER_GYRO_ROLL], 0.999f + FILTER_TEST_PREDICTION_MS * 0.001f * FILTER_TEST_RAMP_SLOPE, 1e-5);
+}
@@ -0,0 +1,236 @@
+// =================================================================================================
+// CInputThread tests, driven by the synthetic source: a second Start while running, Stop before
+// Start, a Stop that has to wake a Poll blocked for a second, the reports reaching the sink only
+// between Start and Stop, and many Start / Stop cycles on the same object.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "TestHarness.h"
+#include "CInputThread.h"
+#include "CSyntheticInputSource.h"
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int INPUT_THREAD_TEST_DEVICES = 2;
+const unsigned int INPUT_THREAD_TEST_RATE_HZ = 1000;
+const unsigned int INPUT_THREAD_TEST_IDLE_RATE_HZ = 1;     // the first report is a second away
+const int INPUT_THREAD_TEST_TIMEOUT_MS = 2000;
+const int INPUT_THREAD_TEST_QUIET_MS = 20;                 // after Stop, long enough for reports
+const uint64_t INPUT_THREAD_TEST_WAKE_NS = 200000000;      // Stop of an idle source, far below 1 s
+const int INPUT_THREAD_TEST_CYCLES = 50;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// Counts what the source hands over and remembers the thread it came from
+class CCountingSink : public IInputSink
+{
+public:
+   bool IsDeviceAttached(void*) override { return true; }
+
+   int OnDeviceArrived(void*, uint32_t, SHidDeviceDescriptor&&) override
+   {
+      arrivals++;
+      callbackThread = std::this_thread::get_id();
+      return arrivals - 1;
+   }
+
+   void OnDeviceRemoved(void*) override { removals++; }
+
+   bool OnReport(void*, const unsigned char*, size_t, uint64_t) override
+   {
+      reports.fetch_add(1, std::memory_order_relaxed);
+      return true;
+   }
+
+   bool OnState(void*, const JSDATA&, uint64_t) override { return false; }
+   void OnBatchEnd() override {}
+   void OnInputError(void*, EInputError, int) override { errors++; }
+
+   std::atomic<uint64_t> reports{0};
+   int arrivals = 0;               // these are read once the thread has been joined
+   int removals = 0;
+   int errors = 0;
+   std::thread::id callbackThread;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// SyntheticFactory         a source of the test's pads at rateHz, counting the sources it made
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static CInputThread::SourceFactory SyntheticFactory(unsigned int rateHz, int* created = nullptr)
+{
+    return [rateHz, created]() -> std::unique_ptr<IInputSource>
+    {
+        if (created != nullptr)
+        {
+            (*created)++;
+        }
+        return std::unique_ptr<IInputSource>(new CSyntheticInputSource(INPUT_THREAD_TEST_DEVICES, rateHz));
+    };
+}
+
+// =================================================================================================
+// WaitForReports           until the sink has counted more than count reports
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool WaitForReports(const CCountingSink& sink, uint64_t count)
+{
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(INPUT_THREAD_TEST_TIMEOUT_MS);
+    while (sink.reports.load(std::memory_order_relaxed) <= count)
+    {
+        if (std::chrono::steady_clock::now() >= end)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// =================================================================================================
+// reports_between          reports flow on the input thread from Start on and stop with Stop;
+//                          every pad that arrived is removed before Stop returns
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_thread, reports_between)
+{
+    CCountingSink sink;
+    CInputThread thread;
+    CHECK(!thread.IsRunning());
+
+    REQUIRE(thread.Start(SyntheticFactory(INPUT_THREAD_TEST_RATE_HZ), &sink));
+    CHECK(thread.IsRunning());
+    CHECK(WaitForReports(sink, 0));
+
+    thread.Stop();
+    CHECK(!thread.IsRunning());
+    CHECK_EQ(sink.arrivals, INPUT_THREAD_TEST_DEVICES);
+    CHECK_EQ(sink.removals, INPUT_THREAD_TEST_DEVICES);
+    CHECK_EQ(sink.errors, 0);
+    CHECK(sink.callbackThread != std::this_thread::get_id());
+
+    uint64_t stoppedAt = sink.reports.load(std::memory_order_relaxed);
+    CHECK(stoppedAt > 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(INPUT_THREAD_TEST_QUIET_MS));
+    CHECK_EQ(sink.reports.load(std::memory_order_relaxed), stoppedAt);
+}
+
+// =================================================================================================
+// start_running            a second Start neither creates a source nor disturbs the running one
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_thread, start_running)
+{
+    CCountingSink sink;
+    CCountingSink otherSink;
+    CInputThread thread;
+    int created = 0;
+
+    REQUIRE(thread.Start(SyntheticFactory(INPUT_THREAD_TEST_RATE_HZ, &created), &sink));
+    CHECK(!thread.Start(SyntheticFactory(INPUT_THREAD_TEST_RATE_HZ, &created), &otherSink));
+    CHECK(thread.IsRunning());
+    CHECK_EQ(created, 1);
+
+    uint64_t reported = sink.reports.load(std::memory_order_relaxed);
+    CHECK(WaitForReports(sink, reported));
+
+    thread.Stop();
+    CHECK_EQ(otherSink.arrivals, 0);
+    CHECK_EQ(otherSink.reports.load(std::memory_order_relaxed), 0u);
+    CHECK_EQ(sink.removals, INPUT_THREAD_TEST_DEVICES);
+}
+
+// =================================================================================================
+// stop_before_start        Stop of a thread never started, twice, does nothing; Start still works
+//                          and so does a Stop repeated after it. Without a source nothing starts.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_thread, stop_before_start)
+{
+    CCountingSink sink;
+    CInputThread thread;
+    thread.Stop();
+    thread.Stop();
+    CHECK(!thread.IsRunning());
+
+    CHECK(!thread.Start([]() { return std::unique_ptr<IInputSource>(); }, &sink));
+    CHECK(!thread.Start(SyntheticFactory(INPUT_THREAD_TEST_RATE_HZ), nullptr));
+    CHECK(!thread.Start(CInputThread::SourceFactory(), &sink));
+    CHECK(!thread.IsRunning());
+
+    REQUIRE(thread.Start(SyntheticFactory(INPUT_THREAD_TEST_RATE_HZ), &sink));
+    thread.Stop();
+    thread.Stop();
+    CHECK(!thread.IsRunning());
+    CHECK_EQ(sink.arrivals, INPUT_THREAD_TEST_DEVICES);
+    CHECK_EQ(sink.removals, INPUT_THREAD_TEST_DEVICES);
+}
+
+// =================================================================================================
+// stop_wakes_poll          the source's next report is a second away, so the thread is blocked in
+//                          Poll; Stop must get it out through Wake instead of waiting the second
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_thread, stop_wakes_poll)
+{
+    CCountingSink sink;
+    CInputThread thread;
+    REQUIRE(thread.Start(SyntheticFactory(INPUT_THREAD_TEST_IDLE_RATE_HZ), &sink));
+    std::this_thread::sleep_for(std::chrono::milliseconds(INPUT_THREAD_TEST_QUIET_MS));
+
+    uint64_t startNs = MonotonicNowNs();
+    thread.Stop();
+    uint64_t stopNs = MonotonicNowNs() - startNs;
+
+    CHECK(stopNs < INPUT_THREAD_TEST_WAKE_NS);
+    CHECK(!thread.IsRunning());
+    CHECK_EQ(sink.reports.load(std::memory_order_relaxed), 0u);
+    CHECK_EQ(sink.removals, INPUT_THREAD_TEST_DEVICES);
+}
+
+// =================================================================================================
+// cycles                   the same thread object started and stopped over and over, each run
+//                          delivering reports and closing every pad it opened
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(input_thread, cycles)
+{
+    CCountingSink sink;
+    CInputThread thread;
+    int created = 0;
+
+    for (int cycle = 0; cycle < INPUT_THREAD_TEST_CYCLES; cycle++)
+    {
+        uint64_t reported = sink.reports.load(std::memory_order_relaxed);
+        REQUIRE(thread.Start(SyntheticFactory(INPUT_THREAD_TEST_RATE_HZ, &created), &sink));
+        CHECK(WaitForReports(sink, reported));
+        thread.Stop();
+
+        REQUIRE(!thread.IsRunning());
+        CHECK_EQ(sink.arrivals, (cycle + 1) * INPUT_THREAD_TEST_DEVICES);
+        CHECK_EQ(sink.removals, sink.arrivals);
+    }
+    CHECK_EQ(created, INPUT_THREAD_TEST_CYCLES);
+}
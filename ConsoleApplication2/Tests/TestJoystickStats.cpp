@@ -0,0 +1,326 @@
+// =================================================================================================
+// Statistics tests: the bucket edges of the latency histogram and its overflow bucket, percentiles
+// of known data, the activity between two snapshots that SummarizeStats turns into rates, the
+// counters of CJoystickStats, and, with JOYSTICK_ENABLE_STATS, the same counters kept by the core.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <memory>
+#include "TestHarness.h"
+#include "CJoystickCore.h"
+#include "CJoystickStats.h"
+#include "CSyntheticInputSource.h"
+#include "LatencyHistogram.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint64_t STATS_TEST_OVERFLOW = 1ull << HISTOGRAM_MAX_VALUE_BITS;
+const uint64_t STATS_TEST_INTERVAL_NS = 2000000000;        // two seconds between the snapshots
+const int STATS_TEST_OS_ERROR = 5;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// bucket_edges             values below 32 have a bucket each; above, every bucket ends one below
+//                          where the next begins and is at most 1/32 of its values wide; the last
+//                          one also takes everything from 2^36 on
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(stats, bucket_edges)
+{
+    for (uint64_t value = 0; value < 2 * HISTOGRAM_SUB_BUCKETS; value++)
+    {
+        CHECK_EQ(CLatencyHistogram::BucketIndex(value), (size_t)value);
+        CHECK_EQ(HistogramBucketHighest((size_t)value), value);
+    }
+    CHECK_EQ(CLatencyHistogram::BucketIndex(64), (size_t)64);
+    CHECK_EQ(CLatencyHistogram::BucketIndex(65), (size_t)64);
+    CHECK_EQ(CLatencyHistogram::BucketIndex(66), (size_t)65);
+    CHECK_EQ(HistogramBucketHighest(64), 65u);
+
+    uint64_t lowest = 0;
+    for (size_t index = 0; index < HISTOGRAM_BUCKETS - 1; index++)
+    {
+        uint64_t highest = HistogramBucketHighest(index);
+        CHECK_EQ(CLatencyHistogram::BucketIndex(lowest), index);
+        CHECK_EQ(CLatencyHistogram::BucketIndex(highest), index);
+        CHECK(highest - lowest <= lowest / HISTOGRAM_SUB_BUCKETS);
+        lowest = highest + 1;
+    }
+
+    // The last bucket is the top one below 2^36 and also everything above
+    CHECK_EQ(CLatencyHistogram::BucketIndex(lowest), HISTOGRAM_BUCKETS - 1);
+    CHECK_EQ(HistogramBucketHighest(HISTOGRAM_BUCKETS - 1), STATS_TEST_OVERFLOW - 1);
+    CHECK_EQ(CLatencyHistogram::BucketIndex(STATS_TEST_OVERFLOW - 1), HISTOGRAM_BUCKETS - 1);
+    CHECK_EQ(CLatencyHistogram::BucketIndex(STATS_TEST_OVERFLOW), HISTOGRAM_BUCKETS - 1);
+    CHECK_EQ(CLatencyHistogram::BucketIndex(~0ull), HISTOGRAM_BUCKETS - 1);
+
+    // The overflow bucket counts the value and the maximum keeps it
+    std::unique_ptr<CLatencyHistogram> histogram(new CLatencyHistogram);
+    std::unique_ptr<SHistogramSnapshot> snapshot(new SHistogramSnapshot);
+    histogram->Record(STATS_TEST_OVERFLOW * 3);
+    histogram->Snapshot(*snapshot);
+    CHECK_EQ(snapshot->counts[HISTOGRAM_BUCKETS - 1], 1u);
+    CHECK_EQ(snapshot->total, 1u);
+    CHECK_EQ(snapshot->maxValue, STATS_TEST_OVERFLOW * 3);
+}
+
+// =================================================================================================
+// percentiles              the value of a rank, reported as the top of its bucket: exact below 64,
+//                          rounded up by less than 1/32 above; nothing recorded gives 0
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(stats, percentiles)
+{
+    std::unique_ptr<CLatencyHistogram> histogram(new CLatencyHistogram);
+    std::unique_ptr<SHistogramSnapshot> snapshot(new SHistogramSnapshot);
+
+    histogram->Snapshot(*snapshot);
+    CHECK_EQ(snapshot->total, 0u);
+    CHECK_EQ(HistogramPercentile(*snapshot, 0.5), 0u);
+
+    for (uint64_t value = 1; value <= 100; value++)
+    {
+        histogram->Record(value);
+    }
+    histogram->Snapshot(*snapshot);
+    CHECK_EQ(snapshot->total, 100u);
+    CHECK_EQ(snapshot->maxValue, 100u);
+    CHECK_EQ(HistogramPercentile(*snapshot, 0.0), 1u);
+    CHECK_EQ(HistogramPercentile(*snapshot, 0.10), 10u);
+    CHECK_EQ(HistogramPercentile(*snapshot, 0.50), 50u);
+    CHECK_EQ(HistogramPercentile(*snapshot, 0.99), 99u);     // 98 and 99 share a bucket
+    CHECK_EQ(HistogramPercentile(*snapshot, 1.0), 101u);     // 100 and 101 share one
+
+    // One slow sample in a thousand fast ones moves p99.9 and the maximum, not p50
+    histogram->Reset();
+    for (int i = 0; i < 999; i++)
+    {
+        histogram->Record(1000000);
+    }
+    histogram->Record(50000000);
+    histogram->Snapshot(*snapshot);
+    uint64_t p50 = HistogramPercentile(*snapshot, 0.50);
+    CHECK(p50 >= 1000000 && p50 - 1000000 < 1000000 / HISTOGRAM_SUB_BUCKETS);
+    CHECK_EQ(HistogramPercentile(*snapshot, 0.999), p50);
+    uint64_t p100 = HistogramPercentile(*snapshot, 1.0);
+    CHECK(p100 >= 50000000 && p100 - 50000000 < 50000000 / HISTOGRAM_SUB_BUCKETS);
+    CHECK_EQ(snapshot->maxValue, 50000000u);
+}
+
+// =================================================================================================
+// snapshot_delta           the difference of two snapshots holds only what was recorded between
+//                          them; SummarizeStats turns it into a rate over the elapsed time, the
+//                          counter deltas and the interval's percentiles in microseconds
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(stats, snapshot_delta)
+{
+    std::unique_ptr<CLatencyHistogram> histogram(new CLatencyHistogram);
+    std::unique_ptr<SHistogramSnapshot> before(new SHistogramSnapshot);
+    std::unique_ptr<SHistogramSnapshot> after(new SHistogramSnapshot);
+    std::unique_ptr<SHistogramSnapshot> difference(new SHistogramSnapshot);
+
+    for (int i = 0; i < 10; i++)
+    {
+        histogram->Record(90000);
+    }
+    histogram->Snapshot(*before);
+    for (int i = 0; i < 4; i++)
+    {
+        histogram->Record(20);
+    }
+    histogram->Snapshot(*after);
+
+    SubtractHistogram(*after, *before, *difference);
+    CHECK_EQ(difference->total, 4u);
+    CHECK_EQ(difference->counts[20], 4u);
+    CHECK_EQ(difference->counts[CLatencyHistogram::BucketIndex(90000)], 0u);
+    CHECK_EQ(HistogramPercentile(*difference, 0.99), 20u);
+    CHECK_EQ(difference->maxValue, 90000u);                 // the maximum is never subtracted
+
+    std::unique_ptr<CJoystickStats> stats(new CJoystickStats);
+    std::unique_ptr<SJoystickStatsSnapshot> previous(new SJoystickStatsSnapshot);
+    std::unique_ptr<SJoystickStatsSnapshot> current(new SJoystickStatsSnapshot);
+
+    for (int i = 0; i < 100; i++)
+    {
+        stats->OnReport(1, true);
+    }
+    stats->OnQueueDrop(1);
+    stats->Snapshot(*previous);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        stats->OnReport(1, i % 100 != 0);
+        if (stats->OnDelivered(1))
+        {
+            stats->RecordLatency(1, 2000);
+        }
+    }
+    stats->OnCoalesced(1);
+    stats->OnQueueDrop(1);
+    stats->OnQueueDrop(1);
+    stats->Snapshot(*current);
+
+    previous->timestampNs = 0;
+    current->timestampNs = STATS_TEST_INTERVAL_NS;
+    SStatsSummary summary;
+    SummarizeStats(*previous, *current, 1, summary);
+    CHECK_NEAR(summary.reportsPerSecond, 500.0, 1e-9);
+    CHECK_EQ(summary.decodeFailures, 10u);
+    CHECK_EQ(summary.coalesced, 1u);
+    CHECK_EQ(summary.queueDrops, 2u);
+    CHECK_EQ(summary.latencySamples, 1000 / STATS_LATENCY_SAMPLE_INTERVAL + 1);
+    CHECK_NEAR(summary.latencyP50Us, HistogramBucketHighest(CLatencyHistogram::BucketIndex(2000)) / 1000.0, 1e-9);
+    CHECK_NEAR(summary.latencyP999Us, summary.latencyP50Us, 1e-9);
+
+    // A player with no activity, and snapshots taken at the same instant
+    SummarizeStats(*previous, *current, 0, summary);
+    CHECK_EQ(summary.reportsPerSecond, 0.0);
+    CHECK_EQ(summary.latencySamples, 0u);
+    CHECK_EQ(summary.latencyP99Us, 0.0);
+    current->timestampNs = previous->timestampNs;
+    SummarizeStats(*previous, *current, 1, summary);
+    CHECK_EQ(summary.reportsPerSecond, 0.0);
+}
+
+// =================================================================================================
+// counters                 each event bumps its own counter of its own player; every 64th delivery
+//                          is timed, starting with the first; an unknown input error is ignored
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(stats, counters)
+{
+    std::unique_ptr<CJoystickStats> stats(new CJoystickStats);
+    std::unique_ptr<SJoystickStatsSnapshot> snapshot(new SJoystickStatsSnapshot);
+
+    stats->Snapshot(*snapshot);
+    for (int player = 0; player < MAX_CONTROLLERS; player++)
+    {
+        CHECK_EQ(snapshot->devices[player].reports, 0u);
+        CHECK_EQ(snapshot->devices[player].latency.total, 0u);
+    }
+    for (int error = 0; error < INPUT_ERROR_COUNT; error++)
+    {
+        CHECK_EQ(snapshot->inputErrors[error], 0u);
+    }
+
+    stats->OnReport(2, true);
+    stats->OnReport(2, false);
+    stats->OnReport(3, true);
+    stats->OnCoalesced(3);
+    stats->OnQueueDrop(2);
+    stats->OnUnknownDevice();
+    stats->OnUnknownDevice();
+    stats->OnRejectedDevice();
+
+    int timed = 0;
+    for (uint64_t i = 0; i < 3 * STATS_LATENCY_SAMPLE_INTERVAL; i++)
+    {
+        bool sampled = stats->OnDelivered(2);
+        CHECK_EQ(sampled, (i % STATS_LATENCY_SAMPLE_INTERVAL) == 0);
+        timed += sampled ? 1 : 0;
+    }
+    CHECK_EQ(timed, 3);
+
+    stats->OnInputError(INPUT_ERROR_READ, STATS_TEST_OS_ERROR);
+    stats->OnInputError(INPUT_ERROR_READ, STATS_TEST_OS_ERROR);
+    stats->OnInputError(INPUT_ERROR_OPEN, STATS_TEST_OS_ERROR + 1);
+    stats->OnInputError(INPUT_ERROR_COUNT, STATS_TEST_OS_ERROR + 2);
+    stats->OnInputError((EInputError)-1, STATS_TEST_OS_ERROR + 3);
+
+    stats->Snapshot(*snapshot);
+    CHECK_EQ(snapshot->devices[2].reports, 2u);
+    CHECK_EQ(snapshot->devices[2].decodeFailures, 1u);
+    CHECK_EQ(snapshot->devices[2].queueDrops, 1u);
+    CHECK_EQ(snapshot->devices[2].coalesced, 0u);
+    CHECK_EQ(snapshot->devices[2].delivered, 3 * STATS_LATENCY_SAMPLE_INTERVAL);
+    CHECK_EQ(snapshot->devices[3].reports, 1u);
+    CHECK_EQ(snapshot->devices[3].decodeFailures, 0u);
+    CHECK_EQ(snapshot->devices[3].coalesced, 1u);
+    CHECK_EQ(snapshot->devices[0].reports, 0u);
+    CHECK_EQ(snapshot->unknownDeviceReports, 2u);
+    CHECK_EQ(snapshot->rejectedDevices, 1u);
+    CHECK_EQ(snapshot->inputErrors[INPUT_ERROR_READ], 2u);
+    CHECK_EQ(snapshot->inputErrors[INPUT_ERROR_DEVICE_INFO], 0u);
+    CHECK_EQ(snapshot->inputErrors[INPUT_ERROR_OPEN], 1u);
+    CHECK_EQ(snapshot->lastOsError, STATS_TEST_OS_ERROR + 1);
+}
+
+#if JOYSTICK_ENABLE_STATS
+
+// =================================================================================================
+// core_counters            what the core counts as reports flow: reports and decode failures of
+//                          the player, drops of a full sample queue, timed deliveries, reports of
+//                          a device never attached, a pad with no slot left and input errors
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(stats, core_counters)
+{
+    unsigned char report[SYNTHETIC_REPORT_SIZE];
+    CSyntheticInputSource::BuildReport(0, 0, report);
+
+    CJoystickCore core;
+    core.EnableSampleQueue(2, RING_COUNT_DROPS);
+
+    int deviceKeys[MAX_CONTROLLERS + 1];
+    for (int i = 0; i <= MAX_CONTROLLERS; i++)
+    {
+        SHidDeviceDescriptor descriptor;
+        descriptor.vendorId = SONY_VENDOR_ID;
+        descriptor.productId = DS4_PRODUCT_ID_V2;
+        CHECK_EQ(core.OnDeviceArrived(&deviceKeys[i], i + 1, std::move(descriptor)), i < MAX_CONTROLLERS ? i : INVALID_PLAYER_INDEX);
+    }
+
+    for (uint64_t i = 0; i < 5; i++)
+    {
+        CHECK(core.OnReport(&deviceKeys[0], report, sizeof(report), i + 1));
+    }
+    CHECK(!core.OnReport(&deviceKeys[0], report, 3, 6));
+    CHECK(!core.OnReport(&deviceKeys[MAX_CONTROLLERS], report, sizeof(report), 7));
+    core.OnInputError(&deviceKeys[0], INPUT_ERROR_DEVICE_INFO, STATS_TEST_OS_ERROR);
+
+    std::unique_ptr<SJoystickStatsSnapshot> snapshot(new SJoystickStatsSnapshot);
+    REQUIRE(core.GetStatsSnapshot(*snapshot));
+    CHECK_EQ(snapshot->devices[0].reports, 6u);
+    CHECK_EQ(snapshot->devices[0].decodeFailures, 1u);
+    CHECK_EQ(snapshot->devices[0].delivered, 5u);
+    CHECK_EQ(snapshot->devices[0].queueDrops, 3u);
+    CHECK_EQ(snapshot->devices[0].latency.total, 1u);
+    CHECK_EQ(snapshot->devices[1].reports, 0u);
+    CHECK_EQ(snapshot->unknownDeviceReports, 1u);
+    CHECK_EQ(snapshot->rejectedDevices, 1u);
+    CHECK_EQ(snapshot->inputErrors[INPUT_ERROR_DEVICE_INFO], 1u);
+    CHECK_EQ(snapshot->lastOsError, STATS_TEST_OS_ERROR);
+}
+
+#else
+
+// =================================================================================================
+// core_counters            built without statistics the core has no snapshot to give
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(stats, core_counters)
+{
+    CJoystickCore core;
+    std::unique_ptr<SJoystickStatsSnapshot> snapshot(new SJoystickStatsSnapshot);
+    CHECK(!core.GetStatsSnapshot(*snapshot));
+}
+
+#endif
@@ -0,0 +1,138 @@
+// =================================================================================================
+// Runner of joystick_tests: the registered cases of the groups named on the command line, or of
+// all groups, one after the other. Exits 1 on any failed check or an unknown group.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "TestHarness.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct STestCase
+{
+	const char* group;
+	const char* name;
+	PFN_TEST_CASE testCase;
+};
+
+// =================================================================================================
+// ===================================== GLOBAL VARIABLES ==========================================
+
+static int g_failures = 0;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// GetTestCases             built on first use, the registrars run in no set order
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::vector<STestCase>& GetTestCases()
+{
+    static std::vector<STestCase> testCases;
+    return testCases;
+}
+
+// =================================================================================================
+// CTestRegistrar
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CTestRegistrar::CTestRegistrar(const char* group, const char* name, PFN_TEST_CASE testCase)
+{
+    STestCase entry = { group, name, testCase };
+    GetTestCases().push_back(entry);
+}
+
+// =================================================================================================
+// TestFailure
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void TestFailure(const char* file, int line, const char* expression, const std::string& detail)
+{
+    g_failures++;
+    std::printf("%s:%d: check failed: %s%s%s\n", file, line, expression, detail.empty() ? "" : "  -- ", detail.c_str());
+}
+
+// =================================================================================================
+// TestTempPath
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+std::string TestTempPath(const char* name)
+{
+#ifdef _WIN32
+    const char* directory = std::getenv("TEMP");
+    const char* separator = "\\";
+#else
+    const char* directory = std::getenv("TMPDIR");
+    const char* separator = "/";
+#endif
+    if (directory == nullptr || *directory == '\0')
+    {
+        directory = ".";
+    }
+    return std::string(directory) + separator + "joystick_tests_" + name;
+}
+
+// =================================================================================================
+// main
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    std::vector<const char*> groups(argv + 1, argv + argc);
+    for (const char* group : groups)
+    {
+        bool known = false;
+        for (const STestCase& testCase : GetTestCases())
+        {
+            known = known || std::strcmp(testCase.group, group) == 0;
+        }
+        if (!known)
+        {
+            std::printf("no test group %s\n", group);
+            result = 1;
+        }
+    }
+
+    int run = 0;
+    int failed = 0;
+    for (const STestCase& testCase : GetTestCases())
+    {
+        bool selected = groups.empty();
+        for (const char* group : groups)
+        {
+            selected = selected || std::strcmp(testCase.group, group) == 0;
+        }
+        if (!selected)
+        {
+            continue;
+        }
+
+        int failuresBefore = g_failures;
+        testCase.testCase();
+        run++;
+        bool passed = g_failures == failuresBefore;
+        failed += passed ? 0 : 1;
+        std::printf("%s %s.%s\n", passed ? "pass" : "FAIL", testCase.group, testCase.name);
+    }
+
+    std::printf("%d cases, %d failed\n", run, failed);
+    return failed != 0 ? 1 : result;
+}
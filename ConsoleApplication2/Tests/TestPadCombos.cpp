@@ -0,0 +1,466 @@
+// =================================================================================================
+// CPadComboEngine tests: chords, sequences against their step windows, double taps and holds, each
+// played on a pad right at the edge of its timing and just past it, and the definitions Compile
+// must refuse.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <vector>
+#include "TestHarness.h"
+#include "PadCombos.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint64_t COMBO_TEST_NS_PER_MS = 1000000;
+const uint32_t COMBO_TEST_REPORT_MS = 4;            // a DS4 over USB
+
+// Hat 4 = down, 3 = down-right, 2 = right
+const uint8_t COMBO_TEST_HAT_DOWN = 4;
+const uint8_t COMBO_TEST_HAT_DOWN_RIGHT = 3;
+const uint8_t COMBO_TEST_HAT_RIGHT = 2;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// From timeMs on the pad holds these buttons and hat
+struct SComboScriptStep
+{
+	uint32_t timeMs;
+	uint32_t buttons;
+	uint8_t hat;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CompileTestCombos        the events the engine calls back with are appended to events
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool CompileTestCombos(CPadComboEngine& engine, const std::vector<SComboDefinition>& combos, std::vector<SComboEvent>& events)
+{
+    engine.SetCallback([&events](const SComboEvent* pEvents, size_t count)
+    {
+        events.insert(events.end(), pEvents, pEvents + count);
+    });
+    return engine.Compile(combos);
+}
+
+// =================================================================================================
+// ProcessPad               one report of the player's pad at timeMs
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static size_t ProcessPad(CPadComboEngine& engine, int playerIndex, uint64_t timeMs, uint32_t buttons, uint8_t hat = PAD_HAT_NEUTRAL)
+{
+    SPadState state = SPadState();
+    state.buttons = buttons;
+    state.hat = hat;
+    state.playerIndex = (uint8_t)playerIndex;
+    state.timestampNs = timeMs * COMBO_TEST_NS_PER_MS;
+    return engine.Process(playerIndex, state);
+}
+
+// =================================================================================================
+// PlayComboScript          the script on player 0, a report every COMBO_TEST_REPORT_MS up to the
+//                          time of its last step
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void PlayComboScript(CPadComboEngine& engine, const SComboScriptStep* script, size_t count)
+{
+    size_t next = 0;
+    uint32_t buttons = 0;
+    uint8_t hat = PAD_HAT_NEUTRAL;
+    for (uint32_t timeMs = 0; timeMs <= script[count - 1].timeMs; timeMs += COMBO_TEST_REPORT_MS)
+    {
+        while (next < count && script[next].timeMs <= timeMs)
+        {
+            buttons = script[next].buttons;
+            hat = script[next].hat;
+            next++;
+        }
+        ProcessPad(engine, 0, timeMs, buttons, hat);
+    }
+}
+
+// =================================================================================================
+// CountComboEvents
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static size_t CountComboEvents(const std::vector<SComboEvent>& events, uint32_t id)
+{
+    size_t count = 0;
+    for (const SComboEvent& event : events)
+    {
+        count += event.id == id ? 1 : 0;
+    }
+    return count;
+}
+
+// =================================================================================================
+// MotionCombo              down, down-right, right, each within windowMs of the one before
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SComboDefinition MotionCombo(uint32_t id, uint16_t windowMs)
+{
+    SComboDefinition combo;
+    combo.id = id;
+    combo.steps = { { ComboHat(COMBO_TEST_HAT_DOWN), COMBO_STEP_PRESS, 0, 0 },
+                    { ComboHat(COMBO_TEST_HAT_DOWN_RIGHT), COMBO_STEP_PRESS, 0, windowMs },
+                    { ComboHat(COMBO_TEST_HAT_RIGHT), COMBO_STEP_PRESS, 0, windowMs } };
+    return combo;
+}
+
+// =================================================================================================
+// scripted                 one combo of each kind played in time on a 4 ms pad, then the same moves
+//                          too slowly or let go too early: each is reported once, in time
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(combos, scripted)
+{
+    std::vector<SComboDefinition> combos(4);
+    combos[0].id = 0;
+    combos[0].steps = { { ComboButton(PAD_BUTTON_L1) | ComboButton(PAD_BUTTON_R1), COMBO_STEP_PRESS, 0, 0 } };
+    combos[1] = MotionCombo(1, 150);
+    combos[1].steps.push_back({ ComboButton(PAD_BUTTON_SQUARE), COMBO_STEP_PRESS, 0, 200 });
+    combos[2].id = 2;
+    combos[2].steps = { { ComboButton(PAD_BUTTON_CROSS), COMBO_STEP_PRESS, 0, 0 }, { ComboButton(PAD_BUTTON_CROSS), COMBO_STEP_RELEASE, 0, 200 },
+                        { ComboButton(PAD_BUTTON_CROSS), COMBO_STEP_PRESS, 0, 200 } };
+    combos[3].id = 3;
+    combos[3].steps = { { ComboButton(PAD_BUTTON_TRIANGLE), COMBO_STEP_PRESS, 0, 0 }, { ComboButton(PAD_BUTTON_TRIANGLE), COMBO_STEP_HOLD, 500, 0 } };
+
+    const uint32_t L1 = ComboButton(PAD_BUTTON_L1);
+    const uint32_t R1 = ComboButton(PAD_BUTTON_R1);
+    const uint32_t SQUARE = ComboButton(PAD_BUTTON_SQUARE);
+    const uint32_t CROSS = ComboButton(PAD_BUTTON_CROSS);
+    const uint32_t TRIANGLE = ComboButton(PAD_BUTTON_TRIANGLE);
+    static const SComboScriptStep script[] =
+    {
+        { 0, L1, PAD_HAT_NEUTRAL }, { 40, L1 | R1, PAD_HAT_NEUTRAL }, { 80, 0, PAD_HAT_NEUTRAL },
+        { 200, 0, 4 }, { 260, 0, 3 }, { 320, 0, 2 }, { 380, SQUARE, 2 }, { 420, 0, PAD_HAT_NEUTRAL },
+        { 600, CROSS, PAD_HAT_NEUTRAL }, { 680, 0, PAD_HAT_NEUTRAL }, { 760, CROSS, PAD_HAT_NEUTRAL }, { 800, 0, PAD_HAT_NEUTRAL },
+        { 1000, TRIANGLE, PAD_HAT_NEUTRAL }, { 1700, 0, PAD_HAT_NEUTRAL },
+        // Too slow or let go too early: none of these may complete
+        { 2000, 0, 4 }, { 2300, 0, 3 }, { 2360, 0, 2 }, { 2420, SQUARE, 2 }, { 2460, 0, PAD_HAT_NEUTRAL },
+        { 2600, CROSS, PAD_HAT_NEUTRAL }, { 2700, 0, PAD_HAT_NEUTRAL }, { 3000, CROSS, PAD_HAT_NEUTRAL }, { 3040, 0, PAD_HAT_NEUTRAL },
+        { 3200, TRIANGLE, PAD_HAT_NEUTRAL }, { 3400, 0, PAD_HAT_NEUTRAL }, { 3500, TRIANGLE, PAD_HAT_NEUTRAL }, { 3600, 0, PAD_HAT_NEUTRAL },
+        { 4000, 0, PAD_HAT_NEUTRAL }
+    };
+
+    CPadComboEngine engine;
+    std::vector<SComboEvent> events;
+    REQUIRE(CompileTestCombos(engine, combos, events));
+    CHECK_EQ(engine.GetComboCount(), 4u);
+    PlayComboScript(engine, script, sizeof(script) / sizeof(script[0]));
+
+    REQUIRE(events.size() == 4);
+    const uint64_t expectedMs[] = { 40, 380, 760, 1500 };
+    for (uint32_t id = 0; id < 4; id++)
+    {
+        CHECK_EQ(events[id].id, id);
+        CHECK_EQ(events[id].playerIndex, 0u);
+        CHECK_EQ(events[id].timestampNs, expectedMs[id] * COMBO_TEST_NS_PER_MS);
+    }
+}
+
+// =================================================================================================
+// chord                    the last chord input going down completes it, whatever the order; held
+//                          on, it does not repeat, and one input alone or let go does nothing
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(combos, chord)
+{
+    const uint32_t L1 = ComboButton(PAD_BUTTON_L1);
+    const uint32_t R1 = ComboButton(PAD_BUTTON_R1);
+    std::vector<SComboDefinition> combos(1);
+    combos[0].id = 7;
+    combos[0].steps = { { L1 | R1, COMBO_STEP_PRESS, 0, 0 } };
+
+    CPadComboEngine engine;
+    std::vector<SComboEvent> events;
+    REQUIRE(CompileTestCombos(engine, combos, events));
+
+    // L1 then R1, and held on
+    CHECK_EQ(ProcessPad(engine, 0, 0, L1), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4, L1 | R1), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 8, L1 | R1), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 400, L1 | R1), 0u);
+
+    // R1 let go and pressed again under a held L1 completes it again
+    CHECK_EQ(ProcessPad(engine, 0, 404, L1), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 408, L1 | R1), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 412, 0), 0u);
+
+    // R1 first, then both in one report
+    CHECK_EQ(ProcessPad(engine, 0, 416, R1), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 420, L1 | R1), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 424, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 428, L1 | R1), 1u);
+
+    // One at a time never makes the chord
+    CHECK_EQ(ProcessPad(engine, 0, 432, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 436, L1), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 440, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 444, R1), 0u);
+
+    REQUIRE(events.size() == 4);
+    CHECK_EQ(events[0].id, 7u);
+    CHECK_EQ(events[0].timestampNs, 4 * COMBO_TEST_NS_PER_MS);
+    CHECK_EQ(events[3].timestampNs, 428 * COMBO_TEST_NS_PER_MS);
+}
+
+// =================================================================================================
+// players                  each player advances on its own pad only: half a chord on each of two
+//                          pads is nothing, and the event names the pad that completed it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(combos, players)
+{
+    const uint32_t L1 = ComboButton(PAD_BUTTON_L1);
+    const uint32_t R1 = ComboButton(PAD_BUTTON_R1);
+    std::vector<SComboDefinition> combos(2);
+    combos[0].id = 0;
+    combos[0].steps = { { L1 | R1, COMBO_STEP_PRESS, 0, 0 } };
+    combos[1] = MotionCombo(1, 150);
+
+    CPadComboEngine engine;
+    std::vector<SComboEvent> events;
+    REQUIRE(CompileTestCombos(engine, combos, events));
+
+    CHECK_EQ(ProcessPad(engine, 0, 0, L1), 0u);
+    CHECK_EQ(ProcessPad(engine, 1, 0, R1), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4, L1), 0u);
+    CHECK_EQ(ProcessPad(engine, 1, 4, R1), 0u);
+    CHECK(events.empty());
+
+    // The motion on player 2 interleaved with an unrelated pad moving its hat
+    CHECK_EQ(ProcessPad(engine, 2, 100, 0, COMBO_TEST_HAT_DOWN), 0u);
+    CHECK_EQ(ProcessPad(engine, 1, 110, 0, COMBO_TEST_HAT_RIGHT), 0u);
+    CHECK_EQ(ProcessPad(engine, 2, 150, 0, COMBO_TEST_HAT_DOWN_RIGHT), 0u);
+    CHECK_EQ(ProcessPad(engine, 1, 160, 0, COMBO_TEST_HAT_DOWN), 0u);
+    CHECK_EQ(ProcessPad(engine, 2, 200, 0, COMBO_TEST_HAT_RIGHT), 1u);
+    CHECK_EQ(ProcessPad(engine, MAX_CONTROLLERS, 200, L1 | R1), 0u);
+
+    REQUIRE(events.size() == 1);
+    CHECK_EQ(events[0].id, 1u);
+    CHECK_EQ(events[0].playerIndex, 2u);
+}
+
+// =================================================================================================
+// sequence_timeout         a step on the last ms of its window counts and one ms past it does not;
+//                          a step before its minimum does not either. A sequence that timed out
+//                          starts over from its first step.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(combos, sequence_timeout)
+{
+    std::vector<SComboDefinition> combos(2);
+    combos[0] = MotionCombo(0, 150);
+    // Square, then circle no sooner than 100 ms and no later than 300 ms after it
+    combos[1].id = 1;
+    combos[1].steps = { { ComboButton(PAD_BUTTON_SQUARE), COMBO_STEP_PRESS, 0, 0 }, { ComboButton(PAD_BUTTON_CIRCLE), COMBO_STEP_PRESS, 100, 300 } };
+
+    CPadComboEngine engine;
+    std::vector<SComboEvent> events;
+    REQUIRE(CompileTestCombos(engine, combos, events));
+
+    // Each step on the last ms of its window
+    CHECK_EQ(ProcessPad(engine, 0, 1000, 0, COMBO_TEST_HAT_DOWN), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 1150, 0, COMBO_TEST_HAT_DOWN_RIGHT), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 1300, 0, COMBO_TEST_HAT_RIGHT), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 1400, 0), 0u);
+
+    // The second step one ms late: the third step finds nothing to follow
+    CHECK_EQ(ProcessPad(engine, 0, 2000, 0, COMBO_TEST_HAT_DOWN), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 2151, 0, COMBO_TEST_HAT_DOWN_RIGHT), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 2160, 0, COMBO_TEST_HAT_RIGHT), 0u);
+
+    // The last step one ms late
+    CHECK_EQ(ProcessPad(engine, 0, 3000, 0, COMBO_TEST_HAT_DOWN), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3010, 0, COMBO_TEST_HAT_DOWN_RIGHT), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3161, 0, COMBO_TEST_HAT_RIGHT), 0u);
+
+    // Timed out, the motion is played again from the start
+    CHECK_EQ(ProcessPad(engine, 0, 3200, 0, COMBO_TEST_HAT_DOWN), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3220, 0, COMBO_TEST_HAT_DOWN_RIGHT), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3240, 0, COMBO_TEST_HAT_RIGHT), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 3300, 0), 0u);
+
+    // Circle one ms before its window, on its first ms and on its last
+    const uint32_t SQUARE = ComboButton(PAD_BUTTON_SQUARE);
+    const uint32_t CIRCLE = ComboButton(PAD_BUTTON_CIRCLE);
+    CHECK_EQ(ProcessPad(engine, 0, 4000, SQUARE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4099, SQUARE | CIRCLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4200, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 5000, SQUARE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 5100, SQUARE | CIRCLE), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 5200, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 6000, SQUARE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 6300, SQUARE | CIRCLE), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 6400, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 7000, SQUARE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 7301, SQUARE | CIRCLE), 0u);
+
+    CHECK_EQ(CountComboEvents(events, 0), 2u);
+    CHECK_EQ(CountComboEvents(events, 1), 2u);
+}
+
+// =================================================================================================
+// double_tap               press, release, press with 200 ms windows: on the edge of both windows
+//                          it completes, a release or a second press one ms late does not
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(combos, double_tap)
+{
+    const uint32_t CROSS = ComboButton(PAD_BUTTON_CROSS);
+    std::vector<SComboDefinition> combos(1);
+    combos[0].id = 0;
+    combos[0].steps = { { CROSS, COMBO_STEP_PRESS, 0, 0 }, { CROSS, COMBO_STEP_RELEASE, 0, 200 }, { CROSS, COMBO_STEP_PRESS, 0, 200 } };
+
+    CPadComboEngine engine;
+    std::vector<SComboEvent> events;
+    REQUIRE(CompileTestCombos(engine, combos, events));
+
+    CHECK_EQ(ProcessPad(engine, 0, 1000, CROSS), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 1200, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 1400, CROSS), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 1500, 0), 0u);
+
+    // Released one ms late
+    CHECK_EQ(ProcessPad(engine, 0, 2000, CROSS), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 2201, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 2300, CROSS), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 2400, 0), 0u);
+
+    // Pressed again one ms late
+    CHECK_EQ(ProcessPad(engine, 0, 3000, CROSS), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3100, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3301, CROSS), 0u);
+
+    // A quick triple tap completes once: the third press would need a release before it
+    CHECK_EQ(ProcessPad(engine, 0, 3400, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4000, CROSS), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4050, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4100, CROSS), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 4150, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4200, CROSS), 0u);
+
+    CHECK_EQ(events.size(), 2u);
+}
+
+// =================================================================================================
+// hold_edges               a HOLD completes on the first report at or past its minimum, once per
+//                          hold; let go one ms before it, it does not, and Reset starts it over
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(combos, hold_edges)
+{
+    const uint32_t TRIANGLE = ComboButton(PAD_BUTTON_TRIANGLE);
+    std::vector<SComboDefinition> combos(1);
+    combos[0].id = 0;
+    combos[0].steps = { { TRIANGLE, COMBO_STEP_PRESS, 0, 0 }, { TRIANGLE, COMBO_STEP_HOLD, 500, 0 } };
+
+    CPadComboEngine engine;
+    std::vector<SComboEvent> events;
+    REQUIRE(CompileTestCombos(engine, combos, events));
+
+    // On the ms of the minimum, and held on after it
+    CHECK_EQ(ProcessPad(engine, 0, 1000, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 1499, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 1500, TRIANGLE), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 1504, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 2500, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 2504, 0), 0u);
+
+    // Let go one ms before the minimum
+    CHECK_EQ(ProcessPad(engine, 0, 3000, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3499, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3500, 0), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 3600, 0), 0u);
+
+    // A pad silent until past the minimum completes it on its next report
+    CHECK_EQ(ProcessPad(engine, 0, 4000, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 4800, TRIANGLE), 1u);
+    CHECK_EQ(ProcessPad(engine, 0, 4804, 0), 0u);
+
+    // Reset drops the press; the next report counts from a released pad, so the button still
+    // held is a new press and the hold is timed from it
+    CHECK_EQ(ProcessPad(engine, 0, 5000, TRIANGLE), 0u);
+    engine.Reset(0);
+    CHECK_EQ(ProcessPad(engine, 0, 5200, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 5500, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 5699, TRIANGLE), 0u);
+    CHECK_EQ(ProcessPad(engine, 0, 5700, TRIANGLE), 1u);
+
+    REQUIRE(events.size() == 3);
+    CHECK_EQ(events[0].timestampNs, 1500 * COMBO_TEST_NS_PER_MS);
+    CHECK_EQ(events[1].timestampNs, 4800 * COMBO_TEST_NS_PER_MS);
+    CHECK_EQ(events[2].timestampNs, 5700 * COMBO_TEST_NS_PER_MS);
+}
+
+// =================================================================================================
+// compile_refused          every definition Compile documents as refused, with nothing compiled
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(combos, compile_refused)
+{
+    const uint32_t CROSS = ComboButton(PAD_BUTTON_CROSS);
+    std::vector<std::vector<SComboStep>> refused =
+    {
+        {},
+        { { 0, COMBO_STEP_PRESS, 0, 0 } },
+        { { CROSS, COMBO_STEP_HOLD, 100, 0 } },
+        { { CROSS, COMBO_STEP_PRESS, 0, 0 }, { CROSS, COMBO_STEP_HOLD, 0, 0 } },
+        { { CROSS, COMBO_STEP_PRESS, 0, 0 }, { CROSS, COMBO_STEP_PRESS, 0, COMBO_MAX_STEP_MS + 1 } },
+        { { CROSS, COMBO_STEP_PRESS, 0, 0 }, { CROSS, COMBO_STEP_HOLD, COMBO_MAX_STEP_MS, 0 } },
+        { { CROSS, COMBO_STEP_PRESS, 0, 0 }, { CROSS, COMBO_STEP_PRESS, 300, 200 } },
+        { { CROSS, COMBO_STEP_HOLD + 1, 0, 0 } },
+        { { 1u << COMBO_INPUT_BITS, COMBO_STEP_PRESS, 0, 0 } },
+        std::vector<SComboStep>(COMBO_MAX_STEPS + 1, { CROSS, COMBO_STEP_PRESS, 0, 0 })
+    };
+
+    for (const std::vector<SComboStep>& steps : refused)
+    {
+        // Alongside a valid definition, which must not be compiled either
+        std::vector<SComboDefinition> combos(2);
+        combos[0].id = 0;
+        combos[0].steps = { { CROSS, COMBO_STEP_PRESS, 0, 0 } };
+        combos[1].id = 1;
+        combos[1].steps = steps;
+
+        CPadComboEngine engine;
+        std::vector<SComboEvent> events;
+        CHECK(!CompileTestCombos(engine, combos, events));
+        CHECK_EQ(engine.GetComboCount(), 0u);
+        CHECK_EQ(ProcessPad(engine, 0, 0, CROSS), 0u);
+    }
+
+    // The limits themselves are accepted
+    std::vector<SComboDefinition> combos(2);
+    combos[0].id = 0;
+    combos[0].steps.assign(COMBO_MAX_STEPS, { CROSS, COMBO_STEP_PRESS, 0, 0 });
+    combos[1].id = 1;
+    combos[1].steps = { { CROSS, COMBO_STEP_PRESS, 0, 0 }, { CROSS, COMBO_STEP_HOLD, COMBO_MAX_STEP_MS - COMBO_DEFAULT_STEP_MAX_MS, 0 } };
+    CPadComboEngine engine;
+    std::vector<SComboEvent> events;
+    CHECK(CompileTestCombos(engine, combos, events));
+    CHECK_EQ(engine.GetComboCount(), 2u);
+}
@@ -0,0 +1,392 @@
+// =================================================================================================
+// CPadEventDispatcher tests: button edges, the hat, axes against their threshold measured from the
+// value last raised, what each subscription is handed, and a pad that starts over once Reset, by
+// hand and through CJoystickCore when the device arrives again.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <vector>
+#include "TestHarness.h"
+#include "CJoystickCore.h"
+#include "CSyntheticInputSource.h"
+#include "PadEvents.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint16_t EVENT_TEST_CENTER = 128;
+const uint16_t EVENT_TEST_THRESHOLD = 4;
+const uint8_t EVENT_TEST_HAT_RIGHT = 2;
+
+// DS4 USB report byte 5: hat in the low nibble, square, cross, circle, triangle in the high one
+const unsigned char EVENT_TEST_DS4_CROSS = 0x20;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// What one subscriber was called with
+struct SEventLog
+{
+	std::vector<SPadEvent> events;
+	int calls = 0;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// LogSubscription          a subscription to the given fields that appends to log
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SPadEventSubscription LogSubscription(SEventLog& log, uint32_t buttons, uint8_t axes, bool hat,
+                                             uint8_t players = PAD_EVENT_ALL_PLAYERS)
+{
+    SPadEventSubscription subscription;
+    subscription.buttons = buttons;
+    subscription.axes = axes;
+    subscription.hat = hat;
+    subscription.players = players;
+    subscription.callback = [&log](const SPadEvent* events, size_t count)
+    {
+        log.events.insert(log.events.end(), events, events + count);
+        log.calls++;
+    };
+    return subscription;
+}
+
+// =================================================================================================
+// RestingState             released pad, sticks centred, triggers up
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SPadState RestingState(uint64_t timestampNs = 0)
+{
+    SPadState state = SPadState();
+    state.timestampNs = timestampNs;
+    state.leftX = EVENT_TEST_CENTER;
+    state.leftY = EVENT_TEST_CENTER;
+    state.rightX = EVENT_TEST_CENTER;
+    state.rightY = EVENT_TEST_CENTER;
+    state.hat = PAD_HAT_NEUTRAL;
+    return state;
+}
+
+// =================================================================================================
+// CheckEvent
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CheckEvent(const SPadEvent& event, EPadEventType type, int code, uint16_t value, uint16_t previous)
+{
+    CHECK_EQ(event.type, (uint8_t)type);
+    CHECK_EQ(event.code, (uint8_t)code);
+    CHECK_EQ(event.value, value);
+    CHECK_EQ(event.previous, previous);
+}
+
+// =================================================================================================
+// button_edges             a press raises one down, holding it nothing, and a release one up per
+//                          button in button order, each stamped with its report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_events, button_edges)
+{
+    SEventLog log;
+    CPadEventDispatcher dispatcher;
+    dispatcher.Subscribe(LogSubscription(log, PAD_EVENT_ALL_BUTTONS, 0, false));
+
+    SPadState state = RestingState(10);
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+
+    state.timestampNs = 20;
+    state.buttons = 1u << PAD_BUTTON_CROSS;
+    REQUIRE(dispatcher.Process(0, state) == 1);
+    REQUIRE(log.events.size() == 1);
+    CheckEvent(log.events[0], PAD_EVENT_BUTTON_DOWN, PAD_BUTTON_CROSS, 1, 0);
+    CHECK_EQ(log.events[0].timestampNs, 20u);
+    CHECK_EQ(log.events[0].playerIndex, 0);
+
+    state.timestampNs = 30;
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+
+    state.buttons |= 1u << PAD_BUTTON_L1;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+    REQUIRE(log.events.size() == 2);
+    CheckEvent(log.events[1], PAD_EVENT_BUTTON_DOWN, PAD_BUTTON_L1, 1, 0);
+
+    state.buttons = 0;
+    state.timestampNs = 40;
+    CHECK_EQ(dispatcher.Process(0, state), 2u);
+    REQUIRE(log.events.size() == 4);
+    CheckEvent(log.events[2], PAD_EVENT_BUTTON_UP, PAD_BUTTON_CROSS, 0, 1);
+    CheckEvent(log.events[3], PAD_EVENT_BUTTON_UP, PAD_BUTTON_L1, 0, 1);
+    CHECK_EQ(log.events[3].timestampNs, 40u);
+    CHECK_EQ(log.calls, 3);
+
+    // A press and a release in the same report, and a DualSense-only button past the legacy ones
+    state.buttons = (1u << PAD_BUTTON_MUTE) | (1u << PAD_BUTTON_SQUARE);
+    dispatcher.Process(0, state);
+    state.buttons = (1u << PAD_BUTTON_MUTE) | (1u << PAD_BUTTON_TRIANGLE);
+    CHECK_EQ(dispatcher.Process(0, state), 2u);
+    REQUIRE(log.events.size() == 8);
+    CheckEvent(log.events[6], PAD_EVENT_BUTTON_UP, PAD_BUTTON_SQUARE, 0, 1);
+    CheckEvent(log.events[7], PAD_EVENT_BUTTON_DOWN, PAD_BUTTON_TRIANGLE, 1, 0);
+}
+
+// =================================================================================================
+// hat                      every change of the hat is one event holding the old and new value
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_events, hat)
+{
+    SEventLog log;
+    CPadEventDispatcher dispatcher;
+    dispatcher.Subscribe(LogSubscription(log, 0, 0, true));
+
+    SPadState state = RestingState();
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+    state.hat = EVENT_TEST_HAT_RIGHT;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+    state.hat = PAD_HAT_NEUTRAL;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+
+    REQUIRE(log.events.size() == 2);
+    CheckEvent(log.events[0], PAD_EVENT_HAT, 0, EVENT_TEST_HAT_RIGHT, PAD_HAT_NEUTRAL);
+    CheckEvent(log.events[1], PAD_EVENT_HAT, 0, PAD_HAT_NEUTRAL, EVENT_TEST_HAT_RIGHT);
+}
+
+// =================================================================================================
+// axis_threshold           below the threshold nothing is raised however long the axis wanders
+//                          around the value last raised; reaching it raises one event, and the
+//                          next is measured from there. The ends of the range always raise.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_events, axis_threshold)
+{
+    SEventLog log;
+    CPadEventDispatcher dispatcher;
+    dispatcher.SetAxisThreshold(AXIS_LEFT_X, EVENT_TEST_THRESHOLD);
+    dispatcher.Subscribe(LogSubscription(log, 0, 1u << AXIS_LEFT_X, false));
+
+    // The axes start where the first state has them
+    SPadState state = RestingState();
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+
+    const uint16_t wander[] = { 131, 125, 129, 126, 131, 128 };
+    for (uint16_t value : wander)
+    {
+        state.leftX = value;
+        CHECK_EQ(dispatcher.Process(0, state), 0u);
+    }
+    CHECK(log.events.empty());
+
+    state.leftX = EVENT_TEST_CENTER + EVENT_TEST_THRESHOLD;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+    REQUIRE(log.events.size() == 1);
+    CheckEvent(log.events[0], PAD_EVENT_AXIS, AXIS_LEFT_X, EVENT_TEST_CENTER + EVENT_TEST_THRESHOLD, EVENT_TEST_CENTER);
+
+    // Hysteresis: around the new value, even back across where the first event fired
+    const uint16_t around[] = { 130, 134, 129, 135, 132 };
+    for (uint16_t value : around)
+    {
+        state.leftX = value;
+        CHECK_EQ(dispatcher.Process(0, state), 0u);
+    }
+    state.leftX = EVENT_TEST_CENTER;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+    REQUIRE(log.events.size() == 2);
+    CheckEvent(log.events[1], PAD_EVENT_AXIS, AXIS_LEFT_X, EVENT_TEST_CENTER, EVENT_TEST_CENTER + EVENT_TEST_THRESHOLD);
+
+    // Within the threshold of an end, the end itself still raises
+    state.leftX = 253;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+    state.leftX = 255;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+    state.leftX = 2;
+    dispatcher.Process(0, state);
+    state.leftX = 0;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+    REQUIRE(log.events.size() == 6);
+    CheckEvent(log.events[3], PAD_EVENT_AXIS, AXIS_LEFT_X, 255, 253);
+    CheckEvent(log.events[5], PAD_EVENT_AXIS, AXIS_LEFT_X, 0, 2);
+}
+
+// =================================================================================================
+// axis_default_threshold   untouched axes skip the one-step noise of a resting stick; a threshold
+//                          of 0 raises every step
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_events, axis_default_threshold)
+{
+    SEventLog log;
+    CPadEventDispatcher dispatcher;
+    dispatcher.SetAxisThreshold(AXIS_R2, 0);
+    dispatcher.Subscribe(LogSubscription(log, 0, PAD_EVENT_ALL_AXES, false));
+
+    SPadState state = RestingState();
+    dispatcher.Process(0, state);
+
+    state.leftY = EVENT_TEST_CENTER + 1;
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+    state.leftY = EVENT_TEST_CENTER - 1;
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+    state.leftY = EVENT_TEST_CENTER + PAD_EVENT_DEFAULT_AXIS_THRESHOLD;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+
+    state.R2 = 1;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+    state.R2 = 2;
+    CHECK_EQ(dispatcher.Process(0, state), 1u);
+
+    REQUIRE(log.events.size() == 3);
+    CheckEvent(log.events[0], PAD_EVENT_AXIS, AXIS_LEFT_Y, EVENT_TEST_CENTER + PAD_EVENT_DEFAULT_AXIS_THRESHOLD, EVENT_TEST_CENTER);
+    CheckEvent(log.events[2], PAD_EVENT_AXIS, AXIS_R2, 2, 1);
+}
+
+// =================================================================================================
+// subscriptions            each subscriber gets only its fields of its players, in one call per
+//                          report; a field nobody subscribed raises nothing at all
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_events, subscriptions)
+{
+    SEventLog crossLog;
+    SEventLog rightYLog;
+    SEventLog hatLog;
+    SEventLog secondPlayerLog;
+    CPadEventDispatcher dispatcher;
+    CHECK(!dispatcher.HasSubscriptions());
+    dispatcher.Subscribe(LogSubscription(crossLog, 1u << PAD_BUTTON_CROSS, 0, false));
+    dispatcher.Subscribe(LogSubscription(rightYLog, 0, 1u << AXIS_RIGHT_Y, false));
+    dispatcher.Subscribe(LogSubscription(hatLog, 0, 0, true));
+    dispatcher.Subscribe(LogSubscription(secondPlayerLog, PAD_EVENT_ALL_BUTTONS, 0, false, 1u << 1));
+
+    // Without a callback a subscription is ignored
+    SPadEventSubscription silent;
+    silent.axes = 1u << AXIS_LEFT_X;
+    dispatcher.Subscribe(silent);
+    CHECK(dispatcher.HasSubscriptions());
+
+    for (int playerIndex = 0; playerIndex < 2; playerIndex++)
+    {
+        dispatcher.Process(playerIndex, RestingState());
+    }
+
+    // Nobody took the left stick, nor the square button of player 0
+    SPadState state = RestingState();
+    state.leftX = 0;
+    CHECK_EQ(dispatcher.Process(0, state), 0u);
+    state.buttons = 1u << PAD_BUTTON_SQUARE;
+    dispatcher.Process(0, state);
+    CHECK(crossLog.events.empty() && rightYLog.events.empty() && hatLog.events.empty() && secondPlayerLog.events.empty());
+
+    state.buttons |= 1u << PAD_BUTTON_CROSS;
+    state.rightY = 0;
+    state.hat = EVENT_TEST_HAT_RIGHT;
+    state.leftX = 255;
+    CHECK_EQ(dispatcher.Process(0, state), 3u);
+
+    REQUIRE(crossLog.events.size() == 1);
+    CheckEvent(crossLog.events[0], PAD_EVENT_BUTTON_DOWN, PAD_BUTTON_CROSS, 1, 0);
+    REQUIRE(rightYLog.events.size() == 1);
+    CheckEvent(rightYLog.events[0], PAD_EVENT_AXIS, AXIS_RIGHT_Y, 0, EVENT_TEST_CENTER);
+    REQUIRE(hatLog.events.size() == 1);
+    CheckEvent(hatLog.events[0], PAD_EVENT_HAT, 0, EVENT_TEST_HAT_RIGHT, PAD_HAT_NEUTRAL);
+    CHECK(secondPlayerLog.events.empty());
+    CHECK_EQ(crossLog.calls, 1);
+
+    // The same change on player 1 also reaches its own subscriber, with its buttons only
+    state.buttons = (1u << PAD_BUTTON_SQUARE) | (1u << PAD_BUTTON_CROSS);
+    CHECK_EQ(dispatcher.Process(1, state), 4u);
+    REQUIRE(secondPlayerLog.events.size() == 2);
+    CHECK_EQ(secondPlayerLog.calls, 1);
+    CheckEvent(secondPlayerLog.events[0], PAD_EVENT_BUTTON_DOWN, PAD_BUTTON_SQUARE, 1, 0);
+    CheckEvent(secondPlayerLog.events[1], PAD_EVENT_BUTTON_DOWN, PAD_BUTTON_CROSS, 1, 0);
+    CHECK_EQ(secondPlayerLog.events[0].playerIndex, 1);
+    CHECK_EQ(crossLog.events.size(), 2u);
+    CHECK_EQ(crossLog.events[1].playerIndex, 1);
+
+    // Out of range players are ignored
+    CHECK_EQ(dispatcher.Process(-1, state), 0u);
+    CHECK_EQ(dispatcher.Process(MAX_CONTROLLERS, state), 0u);
+}
+
+// =================================================================================================
+// reset                    after Reset the pad counts from released: what is held is pressed
+//                          again, the hat too, while the axes start where they are
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_events, reset)
+{
+    SEventLog log;
+    CPadEventDispatcher dispatcher;
+    dispatcher.Subscribe(LogSubscription(log, PAD_EVENT_ALL_BUTTONS, PAD_EVENT_ALL_AXES, true));
+
+    SPadState state = RestingState();
+    state.buttons = 1u << PAD_BUTTON_R1;
+    state.hat = EVENT_TEST_HAT_RIGHT;
+    state.leftX = 20;
+    CHECK_EQ(dispatcher.Process(2, state), 2u);
+    CHECK_EQ(dispatcher.Process(2, state), 0u);
+
+    dispatcher.Reset(2);
+    CHECK_EQ(dispatcher.Process(2, state), 2u);
+    REQUIRE(log.events.size() == 4);
+    CheckEvent(log.events[2], PAD_EVENT_BUTTON_DOWN, PAD_BUTTON_R1, 1, 0);
+    CheckEvent(log.events[3], PAD_EVENT_HAT, 0, EVENT_TEST_HAT_RIGHT, PAD_HAT_NEUTRAL);
+
+    // Other players keep their state
+    dispatcher.Process(3, state);
+    dispatcher.Reset(2);
+    CHECK_EQ(dispatcher.Process(3, state), 0u);
+}
+
+// =================================================================================================
+// core_arrival             through the core: a pad removed and arriving again with a button
+//                          held raises it down again, as the dispatcher is reset on arrival
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_events, core_arrival)
+{
+    unsigned char report[SYNTHETIC_REPORT_SIZE];
+    CSyntheticInputSource::BuildReport(0, 0, report);
+    report[5] = PAD_HAT_NEUTRAL | EVENT_TEST_DS4_CROSS;
+    report[6] = 0;
+    report[7] = 0;
+
+    SEventLog log;
+    CJoystickCore core;
+    core.SubscribeEvents(LogSubscription(log, PAD_EVENT_ALL_BUTTONS, 0, false));
+
+    int deviceKey = 0;
+    for (int arrival = 0; arrival < 2; arrival++)
+    {
+        SHidDeviceDescriptor descriptor;
+        descriptor.vendorId = SONY_VENDOR_ID;
+        descriptor.productId = DS4_PRODUCT_ID_V2;
+        REQUIRE(core.OnDeviceArrived(&deviceKey, 1, std::move(descriptor)) == 0);
+
+        CHECK(core.OnReport(&deviceKey, report, sizeof(report), 1));
+        CHECK(core.OnReport(&deviceKey, report, sizeof(report), 2));
+        REQUIRE(log.events.size() == (size_t)(arrival + 1));
+        CheckEvent(log.events[arrival], PAD_EVENT_BUTTON_DOWN, PAD_BUTTON_CROSS, 1, 0);
+        core.OnDeviceRemoved(&deviceKey);
+    }
+}
@@ -0,0 +1,438 @@
+// =================================================================================================
+// Output tests: the DS4 output reports byte by byte, with the Bluetooth CRC checked by a plain
+// bitwise CRC-32, and CPadOutputWriter against a fake device that records every report and when
+// it came, can hold a write back and can refuse one. Updates must coalesce into the last state,
+// reports must keep the minimum interval, and every Bluetooth report must carry a valid CRC.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "TestHarness.h"
+#include "ByteOrder.h"
+#include "CJoystickCore.h"
+#include "CPadOutputWriter.h"
+#include "Crc32.h"
+#include "MonotonicClock.h"
+#include "PadOutput.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Longest a case waits for the writer thread before it fails
+const uint32_t OUTPUT_TEST_TIMEOUT_MS = 2000;
+
+// Updates of the interval cases, one every OUTPUT_TEST_SUBMIT_US for OUTPUT_TEST_DURATION_MS
+const uint32_t OUTPUT_TEST_SUBMIT_US = 200;
+const uint32_t OUTPUT_TEST_DURATION_MS = 200;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct STestOutputWrite
+{
+	std::vector<unsigned char> report;
+	uint64_t startNs;           // when the writer called Write
+};
+
+// Records every report; Hold keeps the next writes waiting inside Write until it is let go, and
+// Refuse makes the next writes fail
+class CTestOutputDevice : public IPadOutputDevice
+{
+public:
+   CTestOutputDevice() : m_hold(false), m_refuse(0), m_entered(0) {}
+
+   bool Write(const unsigned char* report, size_t length) override
+   {
+      uint64_t startNs = MonotonicNowNs();
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_entered++;
+      m_changed.notify_all();
+      m_changed.wait(lock, [this]() { return !m_hold; });
+
+      if (m_refuse != 0)
+      {
+         m_refuse--;
+         return false;
+      }
+      STestOutputWrite write;
+      write.report.assign(report, report + length);
+      write.startNs = startNs;
+      m_writes.push_back(write);
+      m_changed.notify_all();
+      return true;
+   }
+
+   void Hold(bool hold)
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_hold = hold;
+      m_changed.notify_all();
+   }
+
+   void Refuse(int count)
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_refuse = count;
+   }
+
+   // Write calls so far, held and refused ones included
+   bool WaitForEntered(size_t count)
+   {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      return m_changed.wait_for(lock, std::chrono::milliseconds(OUTPUT_TEST_TIMEOUT_MS), [this, count]() { return m_entered >= count; });
+   }
+
+   bool WaitForWrites(size_t count)
+   {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      return m_changed.wait_for(lock, std::chrono::milliseconds(OUTPUT_TEST_TIMEOUT_MS), [this, count]() { return m_writes.size() >= count; });
+   }
+
+   // Until the last report taken is this one
+   bool WaitForLastReport(const unsigned char* report, size_t length)
+   {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      return m_changed.wait_for(lock, std::chrono::milliseconds(OUTPUT_TEST_TIMEOUT_MS), [this, report, length]()
+      {
+         return !m_writes.empty() && m_writes.back().report.size() == length && std::memcmp(m_writes.back().report.data(), report, length) == 0;
+      });
+   }
+
+   std::vector<STestOutputWrite> GetWrites()
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_writes;
+   }
+
+private:
+   std::mutex m_mutex;
+   std::condition_variable m_changed;
+   bool m_hold;
+   int m_refuse;
+   size_t m_entered;
+   std::vector<STestOutputWrite> m_writes;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// ReferenceCrc32           bit by bit, reflected polynomial 0xEDB88320, seed byte first
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t ReferenceCrc32(unsigned char seed, const unsigned char* data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i <= length; i++)
+    {
+        crc ^= i == 0 ? seed : data[i - 1];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0xEDB88320u : 0);
+        }
+    }
+    return ~crc;
+}
+
+// =================================================================================================
+// HasValidOutputCrc        a Bluetooth output report ends in the CRC of its seed and the rest
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool HasValidOutputCrc(const std::vector<unsigned char>& report)
+{
+    return report.size() == DS4_OUTPUT_BT_SIZE && report[0] == DS4_OUTPUT_BT_REPORT_ID &&
+           LoadLe32(&report[report.size() - 4]) == ReferenceCrc32(CRC32_SEED_BT_OUTPUT, report.data(), report.size() - 4);
+}
+
+// =================================================================================================
+// WaitForUnchanged         until the writer has passed over count states equal to its last report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool WaitForUnchanged(const CPadOutputWriter& writer, uint64_t count)
+{
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(OUTPUT_TEST_TIMEOUT_MS);
+    while (writer.GetCounters().unchanged < count)
+    {
+        if (std::chrono::steady_clock::now() >= end)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// =================================================================================================
+// TestPadOutput
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SPadOutput TestPadOutput(uint8_t strongMotor, uint8_t weakMotor, uint8_t red, uint8_t green, uint8_t blue)
+{
+    SPadOutput output = SPadOutput();
+    output.strongMotor = strongMotor;
+    output.weakMotor = weakMotor;
+    output.red = red;
+    output.green = green;
+    output.blue = blue;
+    return output;
+}
+
+// =================================================================================================
+// CheckMinimumInterval     updates flat out for a while: no two reports closer than the minimum,
+//                          each a valid report of the link, and the last update the last report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CheckMinimumInterval(bool bluetooth, uint32_t minIntervalUs)
+{
+    std::shared_ptr<CTestOutputDevice> device(new CTestOutputDevice);
+    CPadOutputWriter writer;
+    writer.Attach(device, bluetooth, minIntervalUs);
+
+    uint32_t submits = 0;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(OUTPUT_TEST_DURATION_MS);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        submits++;
+        CHECK(writer.Submit(TestPadOutput((uint8_t)submits, (uint8_t)(submits >> 8), 0x10, 0x20, 0x30), PAD_OUTPUT_ALL));
+        std::this_thread::sleep_for(std::chrono::microseconds(OUTPUT_TEST_SUBMIT_US));
+    }
+    SPadOutput last = TestPadOutput(0xAB, 0xCD, 0x01, 0x02, 0x03);
+    CHECK(writer.Submit(last, PAD_OUTPUT_ALL));
+
+    unsigned char expected[PAD_OUTPUT_MAX_REPORT_SIZE];
+    size_t expectedLength = BuildDs4OutputReport(last, bluetooth, expected);
+    REQUIRE(device->WaitForLastReport(expected, expectedLength));
+    writer.Detach();
+
+    std::vector<STestOutputWrite> writes = device->GetWrites();
+    REQUIRE(writes.size() >= 2);
+    // The update that wakes the writer is sent at once; after that one per interval at most
+    CHECK(writes.size() <= (size_t)OUTPUT_TEST_DURATION_MS * 1000 / minIntervalUs + 2);
+    for (size_t i = 0; i < writes.size(); i++)
+    {
+        if (i > 0 && writes[i].startNs - writes[i - 1].startNs < (uint64_t)minIntervalUs * 1000)
+        {
+            TestFailure(__FILE__, __LINE__, "report gap >= minimum interval",
+                        "write " + std::to_string(i) + ": " + std::to_string(writes[i].startNs - writes[i - 1].startNs) + " ns");
+        }
+        if (bluetooth)
+        {
+            CHECK(HasValidOutputCrc(writes[i].report));
+        }
+        else
+        {
+            CHECK_EQ(writes[i].report.size(), DS4_OUTPUT_USB_SIZE);
+            CHECK_EQ(writes[i].report[0], DS4_OUTPUT_USB_REPORT_ID);
+        }
+    }
+
+    SPadOutputCounters counters = writer.GetCounters();
+    CHECK_EQ(counters.submits, (uint64_t)submits + 1);
+    CHECK_EQ(counters.writes, (uint64_t)writes.size());
+    CHECK_EQ(counters.writeErrors, 0u);
+}
+
+// =================================================================================================
+// report_layout            both links byte by byte, the Bluetooth CRC against the bitwise one, and
+//                          a changed byte no longer matching it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_output, report_layout)
+{
+    SPadOutput output = TestPadOutput(0x11, 0x22, 0x33, 0x44, 0x55);
+    output.flashOn = Ds4FlashSteps(15);
+    output.flashOff = Ds4FlashSteps(2550);
+    CHECK_EQ(output.flashOn, 2u);
+    CHECK_EQ(output.flashOff, 255u);
+    CHECK_EQ(Ds4FlashSteps(0), 0u);
+    CHECK_EQ(Ds4FlashSteps(100000), 255u);
+
+    unsigned char report[PAD_OUTPUT_MAX_REPORT_SIZE];
+    REQUIRE(BuildDs4OutputReport(output, false, report) == DS4_OUTPUT_USB_SIZE);
+    const unsigned char usbHead[] = { DS4_OUTPUT_USB_REPORT_ID, 0x07, 0x00, 0x00, 0x22, 0x11, 0x33, 0x44, 0x55, 0x02, 0xFF };
+    CHECK(std::memcmp(report, usbHead, sizeof(usbHead)) == 0);
+    for (size_t i = sizeof(usbHead); i < DS4_OUTPUT_USB_SIZE; i++)
+    {
+        CHECK_EQ(report[i], 0u);
+    }
+
+    REQUIRE(BuildDs4OutputReport(output, true, report) == DS4_OUTPUT_BT_SIZE);
+    const unsigned char btHead[] = { DS4_OUTPUT_BT_REPORT_ID, 0xC4, 0x00, 0x07, 0x00, 0x00, 0x22, 0x11, 0x33, 0x44, 0x55, 0x02, 0xFF };
+    CHECK(std::memcmp(report, btHead, sizeof(btHead)) == 0);
+    for (size_t i = sizeof(btHead); i < DS4_OUTPUT_BT_SIZE - 4; i++)
+    {
+        CHECK_EQ(report[i], 0u);
+    }
+    std::vector<unsigned char> bluetooth(report, report + DS4_OUTPUT_BT_SIZE);
+    CHECK(HasValidOutputCrc(bluetooth));
+    bluetooth[8] ^= 0x01;
+    CHECK(!HasValidOutputCrc(bluetooth));
+}
+
+// =================================================================================================
+// coalesces_to_last        updates made while a report is being written go out as one report of the
+//                          last value of each field, rumble and lightbar merged
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_output, coalesces_to_last)
+{
+    std::shared_ptr<CTestOutputDevice> device(new CTestOutputDevice);
+    CPadOutputWriter writer;
+    CHECK(!writer.Submit(SPadOutput(), PAD_OUTPUT_ALL));
+    writer.Attach(device, false, 0);
+
+    // The first update is written at once and held inside the device
+    device->Hold(true);
+    CHECK(writer.Submit(TestPadOutput(1, 1, 0, 0, 0), PAD_OUTPUT_RUMBLE));
+    REQUIRE(device->WaitForEntered(1));
+
+    CHECK(writer.Submit(TestPadOutput(2, 2, 0, 0, 0), PAD_OUTPUT_RUMBLE));
+    CHECK(writer.Submit(TestPadOutput(3, 3, 0x90, 0x91, 0x92), PAD_OUTPUT_LIGHTBAR));
+    CHECK(writer.Submit(TestPadOutput(4, 5, 0, 0, 0), PAD_OUTPUT_RUMBLE));
+    CHECK(writer.Submit(TestPadOutput(9, 9, 0xA0, 0xA1, 0xA2), PAD_OUTPUT_LIGHTBAR));
+    device->Hold(false);
+
+    REQUIRE(device->WaitForWrites(2));
+    writer.Detach();
+    CHECK(!writer.Submit(SPadOutput(), PAD_OUTPUT_ALL));
+
+    std::vector<STestOutputWrite> writes = device->GetWrites();
+    REQUIRE(writes.size() == 2);
+    unsigned char expected[PAD_OUTPUT_MAX_REPORT_SIZE];
+    size_t length = BuildDs4OutputReport(TestPadOutput(1, 1, 0, 0, 0), false, expected);
+    CHECK(writes[0].report == std::vector<unsigned char>(expected, expected + length));
+    length = BuildDs4OutputReport(TestPadOutput(4, 5, 0xA0, 0xA1, 0xA2), false, expected);
+    CHECK(writes[1].report == std::vector<unsigned char>(expected, expected + length));
+
+    SPadOutputCounters counters = writer.GetCounters();
+    CHECK_EQ(counters.submits, 5u);
+    CHECK_EQ(counters.coalesced, 3u);
+    CHECK_EQ(counters.writes, 2u);
+}
+
+// =================================================================================================
+// unchanged_and_refused    a state equal to the last report is not sent again; a refused report is
+//                          counted, and the same state submitted again is retried
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_output, unchanged_and_refused)
+{
+    std::shared_ptr<CTestOutputDevice> device(new CTestOutputDevice);
+    CPadOutputWriter writer;
+    writer.Attach(device, true, 0);
+
+    SPadOutput output = TestPadOutput(0x40, 0x41, 0x42, 0x43, 0x44);
+    CHECK(writer.Submit(output, PAD_OUTPUT_ALL));
+    REQUIRE(device->WaitForWrites(1));
+    CHECK(writer.Submit(output, PAD_OUTPUT_ALL));
+    REQUIRE(WaitForUnchanged(writer, 1));
+
+    device->Refuse(1);
+    output.red = 0x50;
+    CHECK(writer.Submit(output, PAD_OUTPUT_LIGHTBAR));
+    REQUIRE(device->WaitForEntered(2));
+    CHECK(writer.Submit(output, PAD_OUTPUT_LIGHTBAR));
+    REQUIRE(device->WaitForWrites(2));
+    writer.Detach();
+
+    std::vector<STestOutputWrite> writes = device->GetWrites();
+    REQUIRE(writes.size() == 2);
+    CHECK(HasValidOutputCrc(writes[0].report));
+    CHECK(HasValidOutputCrc(writes[1].report));
+    CHECK_EQ(writes[1].report[8], 0x50u);
+
+    SPadOutputCounters counters = writer.GetCounters();
+    CHECK_EQ(counters.submits, 4u);
+    CHECK_EQ(counters.unchanged, 1u);
+    CHECK_EQ(counters.writeErrors, 1u);
+    CHECK_EQ(counters.writes, 2u);
+}
+
+// =================================================================================================
+// min_interval_usb         PAD_OUTPUT_MIN_INTERVAL_USB_US between reports under flat-out updates
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_output, min_interval_usb)
+{
+    CheckMinimumInterval(false, PAD_OUTPUT_MIN_INTERVAL_USB_US);
+}
+
+// =================================================================================================
+// min_interval_bluetooth   PAD_OUTPUT_MIN_INTERVAL_BT_US between reports, each with a valid CRC
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_output, min_interval_bluetooth)
+{
+    CheckMinimumInterval(true, PAD_OUTPUT_MIN_INTERVAL_BT_US);
+}
+
+// =================================================================================================
+// through_core             a Bluetooth DS4 arriving with an output handle gets a writer; SetRumble
+//                          and SetLightbar reach the device as one valid report
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_output, through_core)
+{
+    CJoystickCore core;
+    CHECK(!core.SetRumble(0, 1, 1));
+    core.EnableOutput(SPadOutputConfig());
+
+    std::shared_ptr<CTestOutputDevice> device(new CTestOutputDevice);
+    SHidDeviceDescriptor descriptor;
+    descriptor.vendorId = SONY_VENDOR_ID;
+    descriptor.productId = DS4_PRODUCT_ID_V2;
+    descriptor.bluetooth = true;
+    descriptor.output = device;
+    int deviceKey = 0;
+    int playerIndex = core.OnDeviceArrived(&deviceKey, 1, std::move(descriptor));
+    REQUIRE(playerIndex >= 0);
+
+    device->Hold(true);
+    CHECK(core.SetRumble(playerIndex, 0x80, 0x20));
+    REQUIRE(device->WaitForEntered(1));
+    CHECK(core.SetLightbar(playerIndex, 0x00, 0x7F, 0xFF));
+    CHECK(core.SetLightbarFlash(playerIndex, 500, 250));
+    device->Hold(false);
+
+    SPadOutput last = TestPadOutput(0x80, 0x20, 0x00, 0x7F, 0xFF);
+    last.flashOn = 50;
+    last.flashOff = 25;
+    unsigned char expected[PAD_OUTPUT_MAX_REPORT_SIZE];
+    size_t length = BuildDs4OutputReport(last, true, expected);
+    REQUIRE(device->WaitForLastReport(expected, length));
+
+    // The writer counts a write once the device returns, so the device's own record is compared
+    SPadOutputCounters counters = SPadOutputCounters();
+    REQUIRE(core.GetOutputCounters(playerIndex, counters));
+    CHECK_EQ(counters.submits, 3u);
+    std::vector<STestOutputWrite> writes = device->GetWrites();
+    CHECK_EQ(writes.size(), 2u);
+    for (const STestOutputWrite& write : writes)
+    {
+        CHECK(HasValidOutputCrc(write.report));
+    }
+}
@@ -0,0 +1,250 @@
+// =================================================================================================
+// SPadState tests: the bit each HandlePressed entry lands on, the hat and axes as they are checked
+// on the way in, the fields JSDATA has no room for kept as they were, and the pressed, released
+// and held buttons between two states.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "TestHarness.h"
+#include "PadState.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// HandlePressed order, as every decoder fills it
+const EPadButton PAD_STATE_TEST_LEGACY_ORDER[BUTTONS_NUM] =
+{
+	PAD_BUTTON_SQUARE, PAD_BUTTON_CROSS, PAD_BUTTON_CIRCLE, PAD_BUTTON_TRIANGLE,
+	PAD_BUTTON_L1, PAD_BUTTON_R1, PAD_BUTTON_L2, PAD_BUTTON_R2,
+	PAD_BUTTON_SHARE, PAD_BUTTON_OPTIONS, PAD_BUTTON_L3, PAD_BUTTON_R3
+};
+
+const uint32_t PAD_STATE_TEST_EXTRA_BUTTONS = (1u << PAD_BUTTON_PS) | (1u << PAD_BUTTON_MUTE);
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// PadButtons               bit mask of the given buttons
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t PadButtons(EPadButton first, EPadButton second = PAD_BUTTON_COUNT, EPadButton third = PAD_BUTTON_COUNT)
+{
+    uint32_t buttons = 1u << first;
+    buttons |= second < PAD_BUTTON_COUNT ? 1u << second : 0;
+    buttons |= third < PAD_BUTTON_COUNT ? 1u << third : 0;
+    return buttons;
+}
+
+// =================================================================================================
+// button_bits              each HandlePressed entry alone sets its EPadButton bit and no other,
+//                          and comes back from the bit to the same entry; all of them set the
+//                          legacy mask
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_state, button_bits)
+{
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        JSDATA jsData;
+        jsData.HandlePressed[i] = true;
+
+        SPadState state = SPadState();
+        PadStateFromJsData(jsData, state);
+        CHECK_EQ(state.buttons, 1u << PAD_STATE_TEST_LEGACY_ORDER[i]);
+        CHECK(IsPadButtonDown(state, PAD_STATE_TEST_LEGACY_ORDER[i]));
+
+        JSDATA back;
+        PadStateToJsData(state, back);
+        for (int j = 0; j < BUTTONS_NUM; j++)
+        {
+            CHECK_EQ(back.HandlePressed[j], i == j);
+        }
+    }
+
+    JSDATA all;
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        all.HandlePressed[i] = true;
+    }
+    SPadState state = SPadState();
+    PadStateFromJsData(all, state);
+    CHECK_EQ(state.buttons, PAD_LEGACY_BUTTONS_MASK);
+    CHECK(!IsPadButtonDown(state, PAD_BUTTON_PS));
+
+    PadStateFromJsData(JSDATA(), state);
+    CHECK_EQ(state.buttons, 0u);
+}
+
+// =================================================================================================
+// extra_buttons            the buttons past BUTTONS_NUM survive a JSDATA update of the legacy ones,
+//                          which still clears what was released; on the way out they are dropped
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_state, extra_buttons)
+{
+    SPadState state = SPadState();
+    state.buttons = PAD_STATE_TEST_EXTRA_BUTTONS | PadButtons(PAD_BUTTON_CROSS, PAD_BUTTON_R3);
+
+    JSDATA jsData;
+    jsData.HandlePressed[PAD_BUTTON_TRIANGLE] = true;
+    PadStateFromJsData(jsData, state);
+    CHECK_EQ(state.buttons, PAD_STATE_TEST_EXTRA_BUTTONS | PadButtons(PAD_BUTTON_TRIANGLE));
+
+    JSDATA back;
+    PadStateToJsData(state, back);
+    SPadState again = SPadState();
+    PadStateFromJsData(back, again);
+    CHECK_EQ(again.buttons, PadButtons(PAD_BUTTON_TRIANGLE));
+}
+
+// =================================================================================================
+// hat                      0..7 pass through both ways; released (-1) and anything out of range
+//                          becomes PAD_HAT_NEUTRAL
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_state, hat)
+{
+    SPadState state = SPadState();
+    for (int hat = 0; hat < PAD_HAT_NEUTRAL; hat++)
+    {
+        JSDATA jsData;
+        jsData.arrowValue = hat;
+        PadStateFromJsData(jsData, state);
+        CHECK_EQ((int)state.hat, hat);
+
+        JSDATA back;
+        PadStateToJsData(state, back);
+        CHECK_EQ(back.arrowValue, hat);
+    }
+
+    const int outOfRange[] = { -1, -100, PAD_HAT_NEUTRAL, 15, 0x108 };
+    for (int value : outOfRange)
+    {
+        JSDATA jsData;
+        jsData.arrowValue = value;
+        state.hat = 3;
+        PadStateFromJsData(jsData, state);
+        CHECK_EQ(state.hat, PAD_HAT_NEUTRAL);
+    }
+    PadStateFromJsData(JSDATA(), state);
+    CHECK_EQ(state.hat, PAD_HAT_NEUTRAL);
+}
+
+// =================================================================================================
+// axes_and_extras          axes are clamped to 16 bits; timestamp, sequence, player, motion and
+//                          touch are left as they were, and a sample starts from a clean state
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_state, axes_and_extras)
+{
+    JSDATA jsData;
+    jsData.leftX = -1;
+    jsData.leftY = 0x10000;
+    jsData.rightX = 0xFFFF;
+    jsData.rightY = 128;
+    jsData.L2 = -70000;
+    jsData.R2 = 255;
+
+    SPadState state = SPadState();
+    state.timestampNs = 77;
+    state.sequence = 9;
+    state.playerIndex = 2;
+    state.flags = PAD_FLAG_MOTION | PAD_FLAG_TOUCH;
+    state.gyro[1] = -300;
+    state.touch[0].active = 1;
+    PadStateFromJsData(jsData, state);
+
+    CHECK_EQ(state.leftX, 0);
+    CHECK_EQ(state.leftY, 0xFFFF);
+    CHECK_EQ(state.rightX, 0xFFFF);
+    CHECK_EQ(state.rightY, 128);
+    CHECK_EQ(state.L2, 0);
+    CHECK_EQ(state.R2, 255);
+    CHECK_EQ(state.timestampNs, 77u);
+    CHECK_EQ(state.sequence, 9u);
+    CHECK_EQ(state.playerIndex, 2);
+    CHECK_EQ(state.flags, PAD_FLAG_MOTION | PAD_FLAG_TOUCH);
+    CHECK_EQ(state.gyro[1], -300);
+    CHECK_EQ(state.touch[0].active, 1);
+
+    SJoystickSample sample;
+    sample.timestampNs = 1234;
+    sample.sequence = 0x100000005ull;
+    sample.playerIndex = 3;
+    sample.data.R2 = 40;
+    sample.data.HandlePressed[PAD_BUTTON_SHARE] = true;
+    PadStateFromSample(sample, state);
+    CHECK_EQ(state.timestampNs, 1234u);
+    CHECK_EQ(state.sequence, 5u);
+    CHECK_EQ(state.playerIndex, 3);
+    CHECK_EQ(state.R2, 40);
+    CHECK_EQ(state.buttons, PadButtons(PAD_BUTTON_SHARE));
+    CHECK_EQ(state.flags, 0);
+    CHECK_EQ(state.gyro[1], 0);
+    CHECK_EQ(state.touch[0].active, 0);
+}
+
+// =================================================================================================
+// edges                    between two states a button is pressed, released or held: the edges
+//                          hold the first two, a held button is down in both and in neither edge
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(pad_state, edges)
+{
+    SPadState previous = SPadState();
+    SPadState current = SPadState();
+    previous.buttons = PadButtons(PAD_BUTTON_CROSS, PAD_BUTTON_L1, PAD_BUTTON_MUTE);
+    current.buttons = PadButtons(PAD_BUTTON_CROSS, PAD_BUTTON_R2, PAD_BUTTON_PS);
+
+    SPadEdges edges = GetPadEdges(previous.buttons, current.buttons);
+    CHECK_EQ(edges.pressed, PadButtons(PAD_BUTTON_R2, PAD_BUTTON_PS));
+    CHECK_EQ(edges.released, PadButtons(PAD_BUTTON_L1, PAD_BUTTON_MUTE));
+    CHECK_EQ(edges.pressed & edges.released, 0u);
+
+    uint32_t held = previous.buttons & current.buttons;
+    CHECK_EQ(held, PadButtons(PAD_BUTTON_CROSS));
+    CHECK(IsPadButtonDown(previous, PAD_BUTTON_CROSS) && IsPadButtonDown(current, PAD_BUTTON_CROSS));
+    CHECK_EQ((edges.pressed | edges.released) & held, 0u);
+    CHECK_EQ(edges.pressed | held, current.buttons);
+    CHECK_EQ(edges.released | held, previous.buttons);
+
+    // Nothing changed: no edges, everything down is held
+    edges = GetPadEdges(current.buttons, current.buttons);
+    CHECK_EQ(edges.pressed, 0u);
+    CHECK_EQ(edges.released, 0u);
+
+    // From and back to idle
+    edges = GetPadEdges(0, current.buttons);
+    CHECK_EQ(edges.pressed, current.buttons);
+    CHECK_EQ(edges.released, 0u);
+    edges = GetPadEdges(current.buttons, 0);
+    CHECK_EQ(edges.pressed, 0u);
+    CHECK_EQ(edges.released, current.buttons);
+
+    // Through JSDATA, as the core builds the states; each keeps the extra button it had
+    JSDATA before;
+    JSDATA after;
+    before.HandlePressed[PAD_BUTTON_SQUARE] = true;
+    before.HandlePressed[PAD_BUTTON_OPTIONS] = true;
+    after.HandlePressed[PAD_BUTTON_OPTIONS] = true;
+    after.HandlePressed[PAD_BUTTON_R3] = true;
+    PadStateFromJsData(before, previous);
+    PadStateFromJsData(after, current);
+    edges = GetPadEdges(previous.buttons, current.buttons);
+    CHECK_EQ(edges.pressed, PadButtons(PAD_BUTTON_R3, PAD_BUTTON_PS));
+    CHECK_EQ(edges.released, PadButtons(PAD_BUTTON_SQUARE, PAD_BUTTON_MUTE));
+    CHECK_EQ(previous.buttons & current.buttons, PadButtons(PAD_BUTTON_OPTIONS));
+}
@@ -0,0 +1,337 @@
+// =================================================================================================
+// Batched raw input tests: GetRawInputBuffer-style buffers packed with AppendRawInputBlock and
+// walked with ForEachRawInputBlock, their reports fed to the core as CWin32RawInputSource does,
+// and the filters given the reports of one batched read under the one timestamp they share.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "TestHarness.h"
+#include "TestReports.h"
+#include "CJoystickCore.h"
+#include "CSyntheticInputSource.h"
+#include "InputFilters.h"
+#include "RawInputBatch.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint64_t BATCH_TEST_WAKEUP_NS = 4000000;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// BuildMarkedReport        a synthetic DS4 USB report whose left stick X is the marker
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void BuildMarkedReport(unsigned char marker, unsigned char* report)
+{
+    CSyntheticInputSource::BuildReport(0, marker, report);
+    report[1] = marker;
+}
+
+// =================================================================================================
+// DeliverRawInputBuffer    what ProcessHidBlock does with every block of a drained buffer, then the
+//                          end of the wakeup; returns the reports decoded
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int DeliverRawInputBuffer(CJoystickCore& core, const std::vector<unsigned char>& buffer, size_t blockCount, uint64_t timestampNs)
+{
+    int decoded = 0;
+    ForEachRawInputBlock(buffer.data(), buffer.size(), blockCount, [&](const SRawInputBlock& block)
+    {
+        for (uint32_t i = 0; i < block.reportCount; i++)
+        {
+            decoded += core.OnReport(block.device, block.reports + (size_t)i * block.reportSize, block.reportSize, timestampNs) ? 1 : 0;
+        }
+    });
+    core.OnBatchEnd();
+    return decoded;
+}
+
+// =================================================================================================
+// AttachDs4                a USB DualShock 4 under key
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int AttachDs4(CJoystickCore& core, void* key, uint32_t identity)
+{
+    SHidDeviceDescriptor descriptor;
+    descriptor.vendorId = SONY_VENDOR_ID;
+    descriptor.productId = DS4_PRODUCT_ID_V2;
+    return core.OnDeviceArrived(key, identity, std::move(descriptor));
+}
+
+// =================================================================================================
+// alignment                every block starts on the pointer-size boundary whatever the size of the
+//                          one before, and comes back with its device and bytes
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(raw_input_batch, alignment)
+{
+    static const uint32_t reportSizes[] = { 13, 1, 64, 7, 78 };
+    const size_t blockCount = sizeof(reportSizes) / sizeof(reportSizes[0]);
+    int devices[blockCount] = {};
+
+    std::vector<unsigned char> buffer;
+    std::vector<unsigned char> bytes(78);
+    for (size_t i = 0; i < blockCount; i++)
+    {
+        for (uint32_t j = 0; j < reportSizes[i]; j++)
+        {
+            bytes[j] = (unsigned char)(i * 16 + j);
+        }
+        AppendRawInputBlock(buffer, &devices[i], bytes.data(), reportSizes[i], 1);
+    }
+
+    size_t seen = 0;
+    size_t misaligned = 0;
+    size_t corrupted = 0;
+    size_t visited = ForEachRawInputBlock(buffer.data(), buffer.size(), blockCount, [&](const SRawInputBlock& block)
+    {
+        size_t offset = (size_t)(block.reports - buffer.data()) - RAW_HID_DATA_OFFSET;
+        misaligned += offset % RAW_INPUT_BLOCK_ALIGNMENT != 0 ? 1 : 0;
+        corrupted += block.device != &devices[seen] || block.reportSize != reportSizes[seen] || block.reportCount != 1 ? 1 : 0;
+        for (uint32_t j = 0; j < block.reportSize; j++)
+        {
+            corrupted += block.reports[j] != (unsigned char)(seen * 16 + j) ? 1 : 0;
+        }
+        seen++;
+    });
+    CHECK_EQ(visited, blockCount);
+    CHECK_EQ(seen, blockCount);
+    CHECK_EQ(misaligned, 0u);
+    CHECK_EQ(corrupted, 0u);
+}
+
+// =================================================================================================
+// malformed_blocks         blocks of other input types are stepped over, a block whose reports do
+//                          not fit is not handed out, a truncated buffer ends the walk
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(raw_input_batch, malformed_blocks)
+{
+    int device = 0;
+    unsigned char reports[3 * DS4_USB_INPUT_REPORT_SIZE] = {};
+
+    // A mouse block (RIM_TYPEMOUSE) between two HID blocks of three reports each
+    std::vector<unsigned char> buffer;
+    AppendRawInputBlock(buffer, &device, reports, DS4_USB_INPUT_REPORT_SIZE, 3);
+    size_t mouseOffset = AlignRawInputOffset(buffer.size());
+    SRawInputHeader mouse = { 0, (uint32_t)(sizeof(SRawInputHeader) + 24), &device, 0 };
+    buffer.resize(mouseOffset + mouse.size, 0);
+    std::memcpy(&buffer[mouseOffset], &mouse, sizeof(mouse));
+    AppendRawInputBlock(buffer, &device, reports, DS4_USB_INPUT_REPORT_SIZE, 3);
+
+    int blocks = 0;
+    uint32_t reportTotal = 0;
+    auto count = [&](const SRawInputBlock& block) { blocks++; reportTotal += block.reportCount; };
+    CHECK_EQ(ForEachRawInputBlock(buffer.data(), buffer.size(), 3, count), 3u);
+    CHECK_EQ(blocks, 2);
+    CHECK_EQ(reportTotal, 6u);
+
+    // Fewer blocks than the buffer holds: the walk stops at the count
+    blocks = 0;
+    CHECK_EQ(ForEachRawInputBlock(buffer.data(), buffer.size(), 1, count), 1u);
+    CHECK_EQ(blocks, 1);
+
+    // The last block cut short
+    blocks = 0;
+    CHECK_EQ(ForEachRawInputBlock(buffer.data(), buffer.size() - 1, 3, count), 2u);
+    CHECK_EQ(blocks, 1);
+
+    // A HID header claiming more reports than the block holds
+    std::vector<unsigned char> lying;
+    AppendRawInputBlock(lying, &device, reports, DS4_USB_INPUT_REPORT_SIZE, 3);
+    SRawHidHeader hid = { DS4_USB_INPUT_REPORT_SIZE, 4 };
+    std::memcpy(&lying[sizeof(SRawInputHeader)], &hid, sizeof(hid));
+    blocks = 0;
+    CHECK_EQ(ForEachRawInputBlock(lying.data(), lying.size(), 1, count), 1u);
+    CHECK_EQ(blocks, 0);
+}
+
+// =================================================================================================
+// deliver_latest           two pads, multi-report blocks and a second block of the first pad in one
+//                          wakeup: every report in order with BATCH_DELIVER_ALL, the last of each
+//                          pad with BATCH_DELIVER_LATEST
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(raw_input_batch, deliver_latest)
+{
+    int padA = 0;
+    int padB = 0;
+    unsigned char reports[3 * DS4_USB_INPUT_REPORT_SIZE];
+    std::vector<unsigned char> buffer;
+    for (int i = 0; i < 3; i++)
+    {
+        BuildMarkedReport((unsigned char)(10 + i), reports + i * DS4_USB_INPUT_REPORT_SIZE);
+    }
+    AppendRawInputBlock(buffer, &padA, reports, DS4_USB_INPUT_REPORT_SIZE, 3);
+    for (int i = 0; i < 2; i++)
+    {
+        BuildMarkedReport((unsigned char)(20 + i), reports + i * DS4_USB_INPUT_REPORT_SIZE);
+    }
+    AppendRawInputBlock(buffer, &padB, reports, DS4_USB_INPUT_REPORT_SIZE, 2);
+    BuildMarkedReport(13, reports);
+    AppendRawInputBlock(buffer, &padA, reports, DS4_USB_INPUT_REPORT_SIZE, 1);
+
+    static const int allMarkers[] = { 10, 11, 12, 20, 21, 13 };
+    static const int allPlayers[] = { 0, 0, 0, 1, 1, 0 };
+    for (int latest = 0; latest < 2; latest++)
+    {
+        CJoystickCore core;
+        std::vector<SJoystickSample> delivered;
+        int callbacks = 0;
+        core.SetCallback([&callbacks](int, JSDATA) { callbacks++; });
+        core.EnableBatchedDelivery(latest ? BATCH_DELIVER_LATEST : BATCH_DELIVER_ALL, [&delivered](const SJoystickSample* samples, size_t count)
+        {
+            delivered.assign(samples, samples + count);
+        });
+        REQUIRE(AttachDs4(core, &padA, 1) == 0);
+        REQUIRE(AttachDs4(core, &padB, 2) == 1);
+
+        CHECK_EQ(DeliverRawInputBuffer(core, buffer, 3, BATCH_TEST_WAKEUP_NS), 6);
+        if (latest)
+        {
+            // Each pad where its last report stood: B before A
+            REQUIRE(delivered.size() == 2);
+            CHECK_EQ(delivered[0].playerIndex, 1);
+            CHECK_EQ(delivered[0].data.leftX, 21);
+            CHECK_EQ(delivered[1].playerIndex, 0);
+            CHECK_EQ(delivered[1].data.leftX, 13);
+            CHECK_EQ(callbacks, 2);
+        }
+        else
+        {
+            REQUIRE(delivered.size() == 6);
+            for (size_t i = 0; i < delivered.size(); i++)
+            {
+                CHECK_EQ(delivered[i].playerIndex, allPlayers[i]);
+                CHECK_EQ(delivered[i].data.leftX, allMarkers[i]);
+                CHECK(i == 0 || delivered[i].sequence > delivered[i - 1].sequence);
+            }
+            CHECK_EQ(callbacks, 6);
+        }
+        for (const SJoystickSample& sample : delivered)
+        {
+            CHECK_EQ(sample.timestampNs, BATCH_TEST_WAKEUP_NS);
+        }
+    }
+}
+
+// =================================================================================================
+// shared_timestamp         reports of one batched read share the wakeup's timestamp; the filters
+//                          take the newest of them over the step from the previous wakeup, as if
+//                          it had come alone, instead of filtering over a zero step
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(raw_input_batch, shared_timestamp)
+{
+    SFilterConfig filterConfig;
+    for (SFilterSettings& settings : filterConfig.channels)
+    {
+        settings.type = FILTER_ONE_EURO;
+        settings.beta = 0.01f;
+    }
+    filterConfig.channels[FILTER_GYRO_PITCH].type = FILTER_KALMAN;
+
+    SFilteredState filtered[2];
+    for (int batched = 0; batched < 2; batched++)
+    {
+        CJoystickCore core;
+        core.EnableFiltering(filterConfig);
+        int pad = 0;
+        REQUIRE(AttachDs4(core, &pad, 1) == 0);
+
+        unsigned char reports[3 * DS4_USB_INPUT_REPORT_SIZE];
+        std::vector<unsigned char> buffer;
+        BuildMarkedReport(0x80, reports);
+        AppendRawInputBlock(buffer, &pad, reports, DS4_USB_INPUT_REPORT_SIZE, 1);
+        CHECK_EQ(DeliverRawInputBuffer(core, buffer, 1, BATCH_TEST_WAKEUP_NS), 1);
+
+        // The batched core sees three reports, the other only the last of them
+        buffer.clear();
+        BuildMarkedReport(0x10, reports);
+        BuildMarkedReport(0xF0, reports + DS4_USB_INPUT_REPORT_SIZE);
+        BuildMarkedReport(0xC0, reports + 2 * DS4_USB_INPUT_REPORT_SIZE);
+        if (batched)
+        {
+            AppendRawInputBlock(buffer, &pad, reports, DS4_USB_INPUT_REPORT_SIZE, 3);
+        }
+        else
+        {
+            AppendRawInputBlock(buffer, &pad, reports + 2 * DS4_USB_INPUT_REPORT_SIZE, DS4_USB_INPUT_REPORT_SIZE, 1);
+        }
+        CHECK_EQ(DeliverRawInputBuffer(core, buffer, 1, 2 * BATCH_TEST_WAKEUP_NS), batched ? 3 : 1);
+        REQUIRE(core.GetFilteredState(0, filtered[batched]));
+    }
+
+    CHECK_EQ(filtered[1].timestampNs, 2 * BATCH_TEST_WAKEUP_NS);
+    for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+    {
+        CHECK(std::isfinite(filtered[1].value[channel]) && std::isfinite(filtered[1].velocity[channel]));
+        CHECK_EQ(filtered[1].value[channel], filtered[0].value[channel]);
+        CHECK_EQ(filtered[1].velocity[channel], filtered[0].velocity[channel]);
+    }
+}
+
+// =================================================================================================
+// filters_zero_dt          every filter type fed changing values under one timestamp, flushed after
+//                          each, stays finite and the smoothing ones inside the input range
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(raw_input_batch, filters_zero_dt)
+{
+    static const EFilterType types[] = { FILTER_NONE, FILTER_EXPONENTIAL, FILTER_ONE_EURO, FILTER_KALMAN };
+    for (EFilterType type : types)
+    {
+        SFilterConfig config;
+        for (SFilterSettings& settings : config.channels)
+        {
+            settings.type = type;
+            settings.beta = 0.01f;
+        }
+        CInputFilterBank filters;
+        filters.Configure(config);
+
+        float values[FILTER_CHANNELS];
+        int nonFinite = 0;
+        int outOfRange = 0;
+        for (int i = 0; i < 100; i++)
+        {
+            for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+            {
+                values[channel] = (i & 1) != 0 ? 1.0f : -1.0f;
+            }
+            filters.Submit(0, values, BATCH_TEST_WAKEUP_NS);
+            filters.Update();
+
+            SFilteredState state;
+            filters.GetState(0, state);
+            for (int channel = 0; channel < FILTER_CHANNELS; channel++)
+            {
+                nonFinite += std::isfinite(state.value[channel]) && std::isfinite(state.velocity[channel]) ? 0 : 1;
+                outOfRange += type != FILTER_KALMAN && std::fabs(state.value[channel]) > 1.0f ? 1 : 0;
+            }
+        }
+        CHECK_EQ(nonFinite, 0);
+        CHECK_EQ(outOfRange, 0);
+    }
+}
@@ -0,0 +1,257 @@
+// =================================================================================================
+// DualShock 4 direct decoder tests on golden reports: every JSDATA and SPadState field of a USB
+// report and of the same input over Bluetooth, the released hat, and reports the decoders refuse.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstring>
+#include "TestHarness.h"
+#include "TestReports.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// A DS4 USB report 0x01 with every field set to something recognisable:
+//   sticks 0x12 0x34 0xAB 0xCD, hat 3 (down-right) with square and triangle,
+//   L1 R2 options R3, PS and touchpad with report counter 5, L2 0x40, R2 0xFF,
+//   sensor clock 0x1234, gyro 100 -200 300, accel -8192 8192 32767, battery level 7,
+//   finger 5 down at 1000,500 and the second touch point up
+static const unsigned char GOLDEN_DS4_USB_REPORT[DS4_USB_INPUT_REPORT_SIZE] =
+{
+    0x01, 0x12, 0x34, 0xAB, 0xCD, 0x93, 0xA9, 0x17, 0x40, 0xFF,     // 0..9
+    0x34, 0x12, 0x1B, 0x64, 0x00, 0x38, 0xFF, 0x2C, 0x01, 0x00,     // 10..19
+    0xE0, 0x00, 0x20, 0xFF, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,     // 20..29
+    0x07, 0x00, 0x00, 0x01, 0x2A, 0x05, 0xE8, 0x43, 0x1F, 0x80,     // 30..39
+    0x00, 0x00, 0x00
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CheckGoldenJsData
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CheckGoldenJsData(const JSDATA& jsData)
+{
+    static const bool pressed[BUTTONS_NUM] =
+    {
+        true, false, false, true,       // square cross circle triangle
+        true, false, false, true,       // L1 R1 L2 R2
+        false, true, false, true        // share options L3 R3
+    };
+
+    CHECK_EQ(jsData.leftX, 0x12);
+    CHECK_EQ(jsData.leftY, 0x34);
+    CHECK_EQ(jsData.rightX, 0xAB);
+    CHECK_EQ(jsData.rightY, 0xCD);
+    CHECK_EQ(jsData.L2, 0x40);
+    CHECK_EQ(jsData.R2, 0xFF);
+    CHECK_EQ(jsData.arrowValue, 3);
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        CHECK_EQ(jsData.HandlePressed[i], pressed[i]);
+    }
+}
+
+// =================================================================================================
+// CheckGoldenPadState
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CheckGoldenPadState(const SPadState& state)
+{
+    uint32_t buttons = (1u << PAD_BUTTON_SQUARE) | (1u << PAD_BUTTON_TRIANGLE) | (1u << PAD_BUTTON_L1) |
+                       (1u << PAD_BUTTON_R2) | (1u << PAD_BUTTON_OPTIONS) | (1u << PAD_BUTTON_R3) |
+                       (1u << PAD_BUTTON_PS) | (1u << PAD_BUTTON_TOUCHPAD);
+
+    CHECK_EQ(state.leftX, 0x12);
+    CHECK_EQ(state.leftY, 0x34);
+    CHECK_EQ(state.rightX, 0xAB);
+    CHECK_EQ(state.rightY, 0xCD);
+    CHECK_EQ(state.L2, 0x40);
+    CHECK_EQ(state.R2, 0xFF);
+    CHECK_EQ(state.hat, 3);
+    CHECK_EQ(state.buttons, buttons);
+    CHECK_EQ(state.flags, (uint8_t)(PAD_FLAG_MOTION | PAD_FLAG_TOUCH));
+    CHECK_EQ(state.sensorTimestamp, 0x1234);
+    CHECK_EQ(state.gyro[0], 100);
+    CHECK_EQ(state.gyro[1], -200);
+    CHECK_EQ(state.gyro[2], 300);
+    CHECK_EQ(state.accel[0], -8192);
+    CHECK_EQ(state.accel[1], 8192);
+    CHECK_EQ(state.accel[2], 32767);
+    CHECK_EQ(state.battery, 70);
+    CHECK_EQ(state.touch[0].active, 1);
+    CHECK_EQ(state.touch[0].id, 5);
+    CHECK_EQ(state.touch[0].x, 1000);
+    CHECK_EQ(state.touch[0].y, 500);
+    CHECK_EQ(state.touch[1].active, 0);
+}
+
+// =================================================================================================
+// usb_golden               every field of the USB report, through the family lookup as the core
+//                          does it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(report_decoders, usb_golden)
+{
+    REQUIRE(SelectReportDecoder(SONY_VENDOR_ID, DS4_PRODUCT_ID_V2) == DECODER_DS4);
+    PFN_REPORT_DECODER decodeReport = GetReportDecoder(DECODER_DS4, DS4_USB_REPORT_ID);
+    PFN_PAD_STATE_DECODER decodePadState = GetPadStateDecoder(DECODER_DS4, DS4_USB_REPORT_ID);
+    REQUIRE(decodeReport == DecodeDs4UsbReport);
+    REQUIRE(decodePadState == DecodeDs4UsbPadState);
+
+    JSDATA jsData;
+    CHECK(decodeReport(GOLDEN_DS4_USB_REPORT, sizeof(GOLDEN_DS4_USB_REPORT), jsData));
+    CheckGoldenJsData(jsData);
+
+    SPadState state = SPadState();
+    state.timestampNs = 42;
+    state.playerIndex = 3;
+    CHECK(decodePadState(GOLDEN_DS4_USB_REPORT, sizeof(GOLDEN_DS4_USB_REPORT), state));
+    CheckGoldenPadState(state);
+    CHECK_EQ(state.timestampNs, (uint64_t)42);
+    CHECK_EQ(state.playerIndex, 3);
+}
+
+// =================================================================================================
+// bluetooth_golden         the same input two bytes further on behind the 0x11 header, and the
+//                          clones of the DS4 taking the same decoders
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(report_decoders, bluetooth_golden)
+{
+    unsigned char btReport[DS4_BT_INPUT_REPORT_SIZE];
+    Ds4UsbToBluetooth(GOLDEN_DS4_USB_REPORT, btReport);
+    CHECK_EQ(btReport[1 + DS4_BT_INPUT_SHIFT], 0x12);
+
+    REQUIRE(GetReportDecoder(DECODER_DS4, DS4_BT_REPORT_ID) == DecodeDs4BluetoothReport);
+    REQUIRE(GetPadStateDecoder(DECODER_DS4, DS4_BT_REPORT_ID) == DecodeDs4BluetoothPadState);
+
+    JSDATA jsData;
+    CHECK(DecodeDs4BluetoothReport(btReport, sizeof(btReport), jsData));
+    CheckGoldenJsData(jsData);
+
+    SPadState state = SPadState();
+    CHECK(DecodeDs4BluetoothPadState(btReport, sizeof(btReport), state));
+    CheckGoldenPadState(state);
+
+    CHECK_EQ(SelectReportDecoder(SONY_VENDOR_ID, DS4_PRODUCT_ID_V1), DECODER_DS4);
+    CHECK_EQ(SelectReportDecoder(SONY_VENDOR_ID, DS4_PRODUCT_ID_DONGLE), DECODER_DS4);
+    CHECK_EQ(SelectReportDecoder(RAZER_VENDOR_ID, RAZER_RAIJU_PRODUCT_ID), DECODER_DS4);
+    CHECK_EQ(SelectReportDecoder(NACON_VENDOR_ID, NACON_REVOLUTION_PRO_PRODUCT_ID), DECODER_DS4);
+    CHECK_EQ(SelectReportDecoder(SONY_VENDOR_ID, DUALSENSE_PRODUCT_ID), DECODER_DUALSENSE);
+    CHECK_EQ(SelectReportDecoder(RAZER_VENDOR_ID, 0x0001), DECODER_GENERIC);
+}
+
+// =================================================================================================
+// hat_neutral              a released hat is value 8 with no button bits, an idle pad all zero
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(report_decoders, hat_neutral)
+{
+    unsigned char usbReport[DS4_USB_INPUT_REPORT_SIZE] = {};
+    usbReport[0] = DS4_USB_REPORT_ID;
+    usbReport[1] = 0x80;
+    usbReport[2] = 0x80;
+    usbReport[3] = 0x80;
+    usbReport[4] = 0x80;
+    usbReport[5] = PAD_HAT_NEUTRAL;
+    usbReport[35] = 0x80;       // both touch points up, as an idle pad sends them
+    usbReport[39] = 0x80;
+
+    unsigned char btReport[DS4_BT_INPUT_REPORT_SIZE];
+    Ds4UsbToBluetooth(usbReport, btReport);
+
+    for (int transport = 0; transport < 2; transport++)
+    {
+        const unsigned char* report = transport == 0 ? usbReport : btReport;
+        size_t length = transport == 0 ? sizeof(usbReport) : sizeof(btReport);
+
+        JSDATA jsData;
+        jsData.HandlePressed[5] = true;
+        CHECK((transport == 0 ? DecodeDs4UsbReport : DecodeDs4BluetoothReport)(report, length, jsData));
+        CHECK_EQ(jsData.arrowValue, (int)PAD_HAT_NEUTRAL);
+        CHECK_EQ(jsData.leftX, 0x80);
+        CHECK_EQ(jsData.L2, 0);
+        for (int i = 0; i < BUTTONS_NUM; i++)
+        {
+            CHECK(!jsData.HandlePressed[i]);
+        }
+
+        SPadState state = SPadState();
+        CHECK((transport == 0 ? DecodeDs4UsbPadState : DecodeDs4BluetoothPadState)(report, length, state));
+        CHECK_EQ(state.hat, PAD_HAT_NEUTRAL);
+        CHECK_EQ(state.buttons, 0u);
+        CHECK_EQ(state.battery, 0);
+        CHECK_EQ(state.touch[0].active, 0);
+        CHECK_EQ(state.touch[1].active, 0);
+    }
+
+    // Every pressed direction comes through as is
+    for (uint8_t hat = 0; hat < PAD_HAT_NEUTRAL; hat++)
+    {
+        usbReport[5] = hat;
+        SPadState state = SPadState();
+        JSDATA jsData;
+        CHECK(DecodeDs4UsbPadState(usbReport, sizeof(usbReport), state));
+        CHECK(DecodeDs4UsbReport(usbReport, sizeof(usbReport), jsData));
+        CHECK_EQ(state.hat, hat);
+        CHECK_EQ(jsData.arrowValue, (int)hat);
+    }
+}
+
+// =================================================================================================
+// refused                  wrong report ID, short reports and a full battery; a refused report
+//                          leaves the output as it was
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(report_decoders, refused)
+{
+    unsigned char btReport[DS4_BT_INPUT_REPORT_SIZE];
+    Ds4UsbToBluetooth(GOLDEN_DS4_USB_REPORT, btReport);
+
+    JSDATA jsData;
+    jsData.leftX = 77;
+    SPadState state = SPadState();
+    state.leftX = 77;
+
+    // The USB layout at the Bluetooth offsets and the other way round
+    CHECK(!DecodeDs4UsbReport(btReport, sizeof(btReport), jsData));
+    CHECK(!DecodeDs4BluetoothReport(GOLDEN_DS4_USB_REPORT, sizeof(GOLDEN_DS4_USB_REPORT), jsData));
+    CHECK(!DecodeDs4UsbPadState(btReport, sizeof(btReport), state));
+    CHECK(!DecodeDs4BluetoothPadState(GOLDEN_DS4_USB_REPORT, sizeof(GOLDEN_DS4_USB_REPORT), state));
+
+    CHECK(!DecodeDs4UsbReport(GOLDEN_DS4_USB_REPORT, 9, jsData));
+    CHECK(!DecodeDs4BluetoothReport(btReport, DS4_BT_INPUT_REPORT_SIZE - 1, jsData));
+    CHECK(!DecodeDs4UsbReport(nullptr, sizeof(GOLDEN_DS4_USB_REPORT), jsData));
+    CHECK_EQ(jsData.leftX, 77);
+    CHECK_EQ(state.leftX, 77);
+    CHECK(GetReportDecoder(DECODER_DS4, 0x05) == nullptr);
+    CHECK(GetReportDecoder(DECODER_GENERIC, DS4_USB_REPORT_ID) == nullptr);
+
+    // The minimum USB report carries no motion, battery or touch
+    CHECK(DecodeDs4UsbPadState(GOLDEN_DS4_USB_REPORT, 10, state));
+    CHECK_EQ(state.flags, 0);
+    CHECK_EQ(state.leftX, 0x12);
+
+    // Level 10 and past (11 while charging) read as full
+    unsigned char usbReport[DS4_USB_INPUT_REPORT_SIZE];
+    std::memcpy(usbReport, GOLDEN_DS4_USB_REPORT, sizeof(usbReport));
+    usbReport[30] = 0x1B;
+    CHECK(DecodeDs4UsbPadState(usbReport, sizeof(usbReport), state));
+    CHECK_EQ(state.battery, 100);
+}
@@ -0,0 +1,171 @@
+// =================================================================================================
+// Layout decoder tests: random DS4 reports through the constexpr layouts against the caps-driven
+// generic decoder and the compiled report descriptor, and Bluetooth reports failing their CRC
+// dropped by the core rather than handed to the generic decoder.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstring>
+#include "TestHarness.h"
+#include "TestReports.h"
+#include "CJoystickCore.h"
+#include "Crc32.h"
+#include "HidCapsModel.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int LAYOUT_FUZZ_REPORTS = 20000;
+const uint32_t LAYOUT_FUZZ_SEED = 0x2545F491;
+
+// =================================================================================================
+// ===================================== GLOBAL VARIABLES ==========================================
+
+static int g_genericCalls = 0;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// NextLayoutFuzzValue      xorshift32, the same reports on every run
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint32_t NextLayoutFuzzValue(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// =================================================================================================
+// DecodeCountingGeneric    stands in for HidP_*; only counts, a report reaching it is a failure
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool DecodeCountingGeneric(SHidDeviceDescriptor&, const unsigned char*, size_t, JSDATA& jsData)
+{
+    g_genericCalls++;
+    jsData.leftX = 0x7F;
+    return true;
+}
+
+// =================================================================================================
+// matches_generic          random USB reports decode to the same JSDATA through the layout, the
+//                          HidP caps and the compiled report descriptor, and to the same through
+//                          the Bluetooth layout once wrapped in a sealed report 0x11
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(report_layouts, matches_generic)
+{
+    SHidDeviceDescriptor capsDescriptor = BuildCapsDescriptor();
+    SHidDeviceDescriptor programDescriptor = BuildProgramDescriptor();
+    REQUIRE(!programDescriptor.reportProgram.ops.empty());
+
+    unsigned char usbReport[DS4_USB_INPUT_REPORT_SIZE];
+    unsigned char btReport[DS4_BT_INPUT_REPORT_SIZE];
+    uint32_t fuzzState = LAYOUT_FUZZ_SEED;
+    int layoutMismatches = 0;
+    int programMismatches = 0;
+    int bluetoothMismatches = 0;
+    for (int i = 0; i < LAYOUT_FUZZ_REPORTS; i++)
+    {
+        for (size_t j = 0; j < sizeof(usbReport); j++)
+        {
+            usbReport[j] = (unsigned char)NextLayoutFuzzValue(fuzzState);
+        }
+        usbReport[0] = DS4_USB_REPORT_ID;
+
+        JSDATA layout;
+        JSDATA caps;
+        JSDATA program;
+        JSDATA bluetooth;
+        REQUIRE(DecodeDs4UsbReport(usbReport, sizeof(usbReport), layout));
+        REQUIRE(DecodeCapsReport(capsDescriptor, usbReport, sizeof(usbReport), caps));
+        REQUIRE(DecodeReportProgram(programDescriptor, usbReport, sizeof(usbReport), program));
+        Ds4UsbToBluetooth(usbReport, btReport);
+        REQUIRE(DecodeDs4BluetoothReport(btReport, sizeof(btReport), bluetooth));
+
+        layoutMismatches += SameJsData(layout, caps) ? 0 : 1;
+        programMismatches += SamePadInput(layout, program) ? 0 : 1;
+        bluetoothMismatches += SameJsData(layout, bluetooth) ? 0 : 1;
+    }
+    CHECK_EQ(layoutMismatches, 0);
+    CHECK_EQ(programMismatches, 0);
+    CHECK_EQ(bluetoothMismatches, 0);
+}
+
+// =================================================================================================
+// bluetooth_crc            a sealed report 0x11 decodes; one with a flipped payload bit, a broken
+//                          CRC, a CRC on the wrong seed or cut short is dropped with the pad state
+//                          untouched and never reaches the generic decoder, which still takes the
+//                          report IDs no layout knows
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(report_layouts, bluetooth_crc)
+{
+    CJoystickCore core;
+    int delivered = 0;
+    JSDATA last;
+    core.SetCallback([&](int, JSDATA jsData) { delivered++; last = jsData; });
+
+    SHidDeviceDescriptor descriptor;
+    descriptor.vendorId = SONY_VENDOR_ID;
+    descriptor.productId = DS4_PRODUCT_ID_V1;
+    descriptor.genericDecoder = DecodeCountingGeneric;
+    int key = 0;
+    g_genericCalls = 0;
+    REQUIRE(core.OnDeviceArrived(&key, 1, std::move(descriptor)) == 0);
+
+    unsigned char usbReport[DS4_USB_INPUT_REPORT_SIZE] = {};
+    usbReport[0] = DS4_USB_REPORT_ID;
+    usbReport[1] = 0x20;
+    usbReport[5] = 0x08;
+    unsigned char sealed[DS4_BT_INPUT_REPORT_SIZE];
+    Ds4UsbToBluetooth(usbReport, sealed);
+    REQUIRE(core.OnReport(&key, sealed, sizeof(sealed), 1));
+    CHECK_EQ(delivered, 1);
+    CHECK_EQ(last.leftX, 0x20);
+
+    unsigned char btReport[DS4_BT_INPUT_REPORT_SIZE];
+    std::memcpy(btReport, sealed, sizeof(btReport));
+    btReport[3] ^= 0x01;
+    CHECK(!core.OnReport(&key, btReport, sizeof(btReport), 2));
+
+    std::memcpy(btReport, sealed, sizeof(btReport));
+    btReport[DS4_BT_INPUT_REPORT_SIZE - 1] ^= 0x80;
+    CHECK(!core.OnReport(&key, btReport, sizeof(btReport), 3));
+
+    // The DS4 CRC is seeded with 0xA1; the same bytes summed from seed 0 are refused
+    size_t crcOffset = DS4_BT_INPUT_REPORT_SIZE - 4;
+    std::memcpy(btReport, sealed, sizeof(btReport));
+    uint32_t unseeded = Crc32Report(0, btReport, crcOffset);
+    for (int i = 0; i < 4; i++)
+    {
+        btReport[crcOffset + i] = (unsigned char)(unseeded >> (8 * i));
+    }
+    CHECK(!core.OnReport(&key, btReport, sizeof(btReport), 4));
+
+    CHECK(!core.OnReport(&key, sealed, sizeof(sealed) - 1, 5));
+
+    CHECK_EQ(g_genericCalls, 0);
+    CHECK_EQ(delivered, 1);
+    CHECK_EQ(last.leftX, 0x20);
+
+    // Report 0x05 has no layout, the generic decoder is still the fallback for it
+    unsigned char unknown[DS4_USB_INPUT_REPORT_SIZE] = {};
+    unknown[0] = 0x05;
+    CHECK(core.OnReport(&key, unknown, sizeof(unknown), 6));
+    CHECK_EQ(g_genericCalls, 1);
+    CHECK_EQ(delivered, 2);
+}
@@ -0,0 +1,113 @@
+// =================================================================================================
+// DualShock 4 input reports for the tests: the Bluetooth form of a USB report with its CRC, a
+// capture of synthetic pads written to a file for replay, and decoded JSDATA compared.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include "TestReports.h"
+#include <cstring>
+#include "ByteOrder.h"
+#include "CCaptureWriter.h"
+#include "CSyntheticInputSource.h"
+#include "Crc32.h"
+#include "ReportDecoders.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+// Bluetooth byte 1: HID and CRC present; byte 2 is left 0
+const unsigned char DS4_BT_INPUT_HEADER = 0xC0;
+
+const uint64_t TEST_CAPTURE_PERIOD_NS = 1000000;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// SealDs4BluetoothReport
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void SealDs4BluetoothReport(unsigned char* btReport)
+{
+    size_t crcOffset = DS4_BT_INPUT_REPORT_SIZE - 4;
+    StoreLe32(btReport + crcOffset, Crc32Report(CRC32_SEED_BT_INPUT, btReport, crcOffset));
+}
+
+// =================================================================================================
+// Ds4UsbToBluetooth
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void Ds4UsbToBluetooth(const unsigned char* usbReport, unsigned char* btReport)
+{
+    std::memset(btReport, 0, DS4_BT_INPUT_REPORT_SIZE);
+    btReport[0] = DS4_BT_REPORT_ID;
+    btReport[1] = DS4_BT_INPUT_HEADER;
+    std::memcpy(btReport + 1 + DS4_BT_INPUT_SHIFT, usbReport + 1, DS4_USB_INPUT_REPORT_SIZE - 1);
+    SealDs4BluetoothReport(btReport);
+}
+
+// =================================================================================================
+// WriteDs4TestCapture
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool WriteDs4TestCapture(const char* path, int reportsPerPad)
+{
+    CCaptureWriter writer;
+    if (!writer.Open(path))
+    {
+        return false;
+    }
+
+    SCaptureDevice usbPad = { (uint16_t)SONY_VENDOR_ID, (uint16_t)DS4_PRODUCT_ID_V2, 0x1001, 0 };
+    SCaptureDevice bluetoothPad = { (uint16_t)SONY_VENDOR_ID, (uint16_t)DS4_PRODUCT_ID_V1, 0x1002, 0 };
+    writer.WriteDeviceArrived(1, 0, usbPad);
+    writer.WriteDeviceArrived(2, 0, bluetoothPad);
+
+    unsigned char usbReport[SYNTHETIC_REPORT_SIZE];
+    unsigned char btReport[DS4_BT_INPUT_REPORT_SIZE];
+    for (int i = 0; i < reportsPerPad; i++)
+    {
+        uint64_t timestampNs = (uint64_t)(i + 1) * TEST_CAPTURE_PERIOD_NS;
+        CSyntheticInputSource::BuildReport(0, (uint64_t)i, usbReport);
+        writer.WriteReport(1, timestampNs, usbReport, sizeof(usbReport));
+
+        CSyntheticInputSource::BuildReport(1, (uint64_t)i, usbReport);
+        Ds4UsbToBluetooth(usbReport, btReport);
+        writer.WriteReport(2, timestampNs, btReport, sizeof(btReport));
+    }
+    writer.WriteDeviceRemoved(1, (uint64_t)(reportsPerPad + 1) * TEST_CAPTURE_PERIOD_NS);
+
+    writer.Close();
+    return writer.IsHealthy() && writer.GetDroppedRecords() == 0;
+}
+
+// =================================================================================================
+// SameJsData               every field, bit for bit
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool SameJsData(const JSDATA& a, const JSDATA& b)
+{
+    if (a.leftX != b.leftX || a.leftY != b.leftY || a.rightX != b.rightX || a.rightY != b.rightY ||
+        a.L2 != b.L2 || a.R2 != b.R2 || a.arrowValue != b.arrowValue)
+    {
+        return false;
+    }
+    for (int i = 0; i < BUTTONS_NUM; i++)
+    {
+        if (a.HandlePressed[i] != b.HandlePressed[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
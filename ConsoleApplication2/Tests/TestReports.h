@@ -0,0 +1,42 @@
+// =================================================================================================
+// DualShock 4 input reports for the tests: the Bluetooth form of a USB report with its CRC, a
+// capture of synthetic pads written to a file for replay, and decoded JSDATA compared.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+#pragma once
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstddef>
+#include <cstdint>
+#include "JSData.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const size_t DS4_USB_INPUT_REPORT_SIZE = 64;
+const size_t DS4_BT_INPUT_REPORT_SIZE = 78;
+
+// USB byte i is Bluetooth byte i + DS4_BT_INPUT_SHIFT, the two header bytes in between
+const size_t DS4_BT_INPUT_SHIFT = 2;
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// Stores the CRC-32 of the report into its last four bytes
+void SealDs4BluetoothReport(unsigned char* btReport);
+
+// The same input as a sealed Bluetooth report 0x11
+void Ds4UsbToBluetooth(const unsigned char* usbReport, unsigned char* btReport);
+
+// Writes a capture of a USB pad and a Bluetooth pad, both DualShock 4, reportsPerPad synthetic
+// reports each, interleaved 1 ms apart. False when the file cannot be written.
+bool WriteDs4TestCapture(const char* path, int reportsPerPad);
+
+// Every field, bit for bit
+bool SameJsData(const JSDATA& a, const JSDATA& b);
@@ -0,0 +1,166 @@
+// =================================================================================================
+// CSeqLock tests: one writer publishing self-checking payloads, every word equal to the version it
+// is published as, against several readers. A reader that ever gets a copy mixing two writes, or a
+// version going backwards, fails the test.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "TestHarness.h"
+#include "CSeqLock.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int SEQLOCK_TEST_READERS = 4;
+const uint64_t SEQLOCK_TEST_PUBLICATIONS = 200000;   // at least; more until every reader is done
+const uint64_t SEQLOCK_TEST_READS = 20000;           // consistent reads each reader must make
+
+// Several cache lines, so a copy spans more than one line the writer may be rewriting
+const int SEQLOCK_TEST_WORDS = 24;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct STestVersionPayload
+{
+	uint64_t words[SEQLOCK_TEST_WORDS];
+};
+
+struct SSeqLockReaderResult
+{
+	std::atomic<uint64_t> reads{0};     // read by the writer to know when to stop
+	uint64_t torn = 0;                  // words disagreeing with each other or with the version
+	uint64_t backwards = 0;             // a version older than the one read before
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CheckVersionPayload      every word holds the version the payload was read as
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool CheckVersionPayload(const STestVersionPayload& payload, uint64_t version)
+{
+    for (int i = 0; i < SEQLOCK_TEST_WORDS; i++)
+    {
+        if (payload.words[i] != version)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =================================================================================================
+// empty                    nothing published reads as nothing, the first publication as version 1
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(seqlock, empty)
+{
+    CSeqLock<STestVersionPayload> seqLock;
+    STestVersionPayload payload = STestVersionPayload();
+    uint64_t version = 99;
+    CHECK(!seqLock.TryRead(payload));
+    CHECK(!seqLock.Read(payload, &version));
+    CHECK_EQ(version, 99u);
+    CHECK_EQ(seqLock.Version(), 0u);
+
+    for (int i = 0; i < SEQLOCK_TEST_WORDS; i++)
+    {
+        payload.words[i] = 1;
+    }
+    seqLock.Publish(payload);
+    STestVersionPayload read = STestVersionPayload();
+    REQUIRE(seqLock.Read(read, &version));
+    CHECK_EQ(version, 1u);
+    CHECK(CheckVersionPayload(read, 1));
+}
+
+// =================================================================================================
+// no_torn_reads            one writer flat out, SEQLOCK_TEST_READERS readers with Read and TryRead;
+//                          the writer goes on until every reader has its reads, so on one core the
+//                          readers are preempted mid-copy too
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(seqlock, no_torn_reads)
+{
+    CSeqLock<STestVersionPayload> seqLock;
+    std::atomic<bool> writerDone(false);
+    std::vector<SSeqLockReaderResult> results(SEQLOCK_TEST_READERS);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < SEQLOCK_TEST_READERS; r++)
+    {
+        readers.emplace_back([&seqLock, &writerDone, &results, r]()
+        {
+            SSeqLockReaderResult& result = results[r];
+            uint64_t lastVersion = 0;
+            STestVersionPayload payload;
+            while (!writerDone.load(std::memory_order_acquire))
+            {
+                uint64_t version = 0;
+                // Half the readers retry inside Read, the others make single attempts
+                bool read = (r & 1) != 0 ? seqLock.TryRead(payload, &version) : seqLock.Read(payload, &version);
+                if (!read)
+                {
+                    continue;
+                }
+                result.reads.store(result.reads.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                result.torn += CheckVersionPayload(payload, version) ? 0 : 1;
+                result.backwards += version < lastVersion ? 1 : 0;
+                lastVersion = version;
+            }
+        });
+    }
+
+    STestVersionPayload payload;
+    uint64_t published = 0;
+    bool readersDone = false;
+    while (published < SEQLOCK_TEST_PUBLICATIONS || !readersDone)
+    {
+        published++;
+        for (int i = 0; i < SEQLOCK_TEST_WORDS; i++)
+        {
+            payload.words[i] = published;
+        }
+        seqLock.Publish(payload);
+
+        readersDone = true;
+        for (const SSeqLockReaderResult& result : results)
+        {
+            readersDone = readersDone && result.reads.load(std::memory_order_relaxed) >= SEQLOCK_TEST_READS;
+        }
+    }
+    writerDone.store(true, std::memory_order_release);
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    for (const SSeqLockReaderResult& result : results)
+    {
+        CHECK_EQ(result.torn, 0u);
+        CHECK_EQ(result.backwards, 0u);
+        CHECK(result.reads.load() >= SEQLOCK_TEST_READS);
+    }
+    CHECK_EQ(seqLock.Version(), published);
+
+    STestVersionPayload last;
+    uint64_t version = 0;
+    REQUIRE(seqLock.Read(last, &version));
+    CHECK_EQ(version, published);
+    CHECK(CheckVersionPayload(last, published));
+}
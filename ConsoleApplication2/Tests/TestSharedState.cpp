@@ -0,0 +1,690 @@
+// =================================================================================================
+// Shared state tests: a CSharedStatePublisher and CSharedStateReaders, each reader with a mapping
+// of its own opened by name as another process would. The publisher writes self-checking pad
+// states, motion and device tables from one thread while the readers copy them out on others; a
+// copy mixing two publications, or disagreeing with the version it was read as, fails the test.
+// On Linux the readers and a second writer also run in forked processes, for what only another
+// process sees: the takeover check, the name removed while still mapped, a region created there.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TestHarness.h"
+#include "CSharedStatePublisher.h"
+#include "CSharedStateReader.h"
+#include "MonotonicClock.h"
+#include "ReportDecoders.h"
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const int SHARED_TEST_READERS = 2;
+const int SHARED_TEST_PLAYERS = 2;
+const uint64_t SHARED_TEST_PUBLICATIONS = 1000000;  // at least; more until every reader is done
+const uint64_t SHARED_TEST_READS = 50000;           // consistent pad states each reader must read
+const uint64_t SHARED_TEST_DEVICE_PERIOD = 64;      // publications between device table changes
+
+// Product IDs the writer pairs with its vendor IDs
+const uint16_t SHARED_TEST_PRODUCT_MASK = 0x5A5A;
+
+#ifndef _WIN32
+const unsigned int SHARED_TEST_CHILD_TIMEOUT_S = 60;  // a child stuck waiting dies by SIGALRM
+const uint64_t SHARED_TEST_POLL_PERIOD = 256;         // publications between looks at the pipe
+const uint64_t SHARED_TEST_CHILD_PUBLICATIONS = 5;
+
+// What a child process found wrong, its exit status
+enum ESharedChildFailure
+{
+	SHARED_CHILD_OPEN = 0x01,           // could not attach, or could not create the region
+	SHARED_CHILD_TORN = 0x02,
+	SHARED_CHILD_BACKWARDS = 0x04,
+	SHARED_CHILD_NO_TABLE = 0x08,
+	SHARED_CHILD_LIVE = 0x10,           // still live after the writer closed
+	SHARED_CHILD_REOPENED = 0x20,       // the name still there after the writer closed
+	SHARED_CHILD_PIPE = 0x40            // the other side went away early
+};
+#endif
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+struct SSharedReaderResult
+{
+	std::atomic<uint64_t> reads{0};     // read by the writer to know when to stop
+	bool opened = false;
+	uint64_t torn = 0;                  // snapshots disagreeing with themselves or their version
+	uint64_t backwards = 0;             // a version older than the one read before
+	uint64_t tables = 0;
+	uint64_t tornTables = 0;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// SharedTestName           one region per run, so parallel runs and leftovers do not meet
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static std::string SharedTestName(const char* name)
+{
+    return std::string("SonyPlayStation4JoystickTest_") + name + "_" + std::to_string(MonotonicNowNs());
+}
+
+// =================================================================================================
+// MakeSharedPadState       publication number of a player, every field derived from it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SPadState MakeSharedPadState(int playerIndex, uint64_t number)
+{
+    SPadState state = SPadState();
+    state.timestampNs = number * 1000 + (uint64_t)playerIndex;
+    state.sequence = (uint32_t)number;
+    state.buttons = (uint32_t)(number * 2654435761u);
+    state.leftX = (uint16_t)number;
+    state.leftY = (uint16_t)(number * 3);
+    state.rightX = (uint16_t)(number * 5);
+    state.rightY = (uint16_t)(number * 7);
+    state.L2 = (uint16_t)(number >> 3);
+    state.R2 = (uint16_t)(number >> 5);
+    state.hat = (uint8_t)(number % 9);
+    state.playerIndex = (uint8_t)playerIndex;
+    state.flags = (uint8_t)(number & 3);
+    state.battery = (uint8_t)(number % 101);
+    for (int axis = 0; axis < 3; axis++)
+    {
+        state.gyro[axis] = (int16_t)(number * (axis + 11));
+        state.accel[axis] = (int16_t)(number * (axis + 13));
+    }
+    state.sensorTimestamp = (uint16_t)(number * 188);
+    for (int i = 0; i < PAD_TOUCH_POINTS; i++)
+    {
+        state.touch[i].x = (uint16_t)(number + i);
+        state.touch[i].y = (uint16_t)(number * 2 + i);
+        state.touch[i].id = (uint8_t)(number + i);
+        state.touch[i].active = (uint8_t)((number >> i) & 1);
+    }
+    return state;
+}
+
+// =================================================================================================
+// MakeSharedMotion
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SMotionSample MakeSharedMotion(int playerIndex, uint64_t number)
+{
+    SMotionSample motion = SMotionSample();
+    motion.timestampNs = number;
+    motion.sensorTimeNs = number * 1250000;
+    motion.dtSeconds = (float)(number % 16) * 0.00125f;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        motion.gyroDps[axis] = (float)(number % 2000) + axis;
+        motion.accelG[axis] = (float)(number % 4) - axis;
+    }
+    motion.playerIndex = playerIndex;
+    return motion;
+}
+
+// =================================================================================================
+// SameSharedPadState       byte for byte; both sides start from a zeroed state
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool SameSharedPadState(const SPadState& a, const SPadState& b)
+{
+    return std::memcmp(&a, &b, sizeof(SPadState)) == 0;
+}
+
+// =================================================================================================
+// SameSharedMotion
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool SameSharedMotion(const SMotionSample& a, const SMotionSample& b)
+{
+    return std::memcmp(&a, &b, sizeof(SMotionSample)) == 0;
+}
+
+// =================================================================================================
+// CheckSharedDevice        the device of table change k of the writer: vendor k, its product, in
+//                          on odd changes and counting one arrival per odd change; all zero
+//                          before the first
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool CheckSharedDevice(const SSharedDevice& device)
+{
+    if (device.vendorId == 0)
+    {
+        return device.productId == 0 && device.connected == 0 && device.arrivals == 0;
+    }
+    return device.productId == (uint16_t)(device.vendorId ^ SHARED_TEST_PRODUCT_MASK) &&
+           device.connected == (device.vendorId & 1) && device.arrivals == (uint32_t)(device.vendorId + 1) / 2;
+}
+
+// =================================================================================================
+// lifecycle                a reader attaches only to a live region, sees nothing before the first
+//                          publication and every publication after it, and goes stale when the
+//                          publisher closes
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(shared_state, lifecycle)
+{
+    std::string name = SharedTestName("lifecycle");
+    CSharedStateReader reader;
+    CHECK(!reader.Open(name.c_str()));
+
+    CSharedStatePublisher publisher;
+    REQUIRE(publisher.Open(name.c_str()));
+    REQUIRE(reader.Open(name.c_str()));
+    CHECK(reader.IsLive());
+
+    SPadState state;
+    SMotionSample motion;
+    SSharedDeviceTable table;
+    uint64_t version = 99;
+    CHECK(!reader.ReadPadState(0, state, &version));
+    CHECK(!reader.ReadMotion(0, motion));
+    CHECK_EQ(version, 99u);
+    CHECK_EQ(reader.GetPadStateVersion(0), 0u);
+    REQUIRE(reader.ReadDeviceTable(table, &version));
+    CHECK_EQ(version, 1u);
+    CHECK_EQ(table.devices[0].arrivals, 0u);
+
+    publisher.PublishDevice(1, SONY_VENDOR_ID, DS4_PRODUCT_ID_V2, true);
+    publisher.PublishDevice(1, SONY_VENDOR_ID, DS4_PRODUCT_ID_V2, false);
+    publisher.PublishDevice(1, SONY_VENDOR_ID, DUALSENSE_PRODUCT_ID, true);
+    publisher.PublishDevice(SHARED_STATE_SLOTS, SONY_VENDOR_ID, DS4_PRODUCT_ID_V2, true);
+    REQUIRE(reader.ReadDeviceTable(table, &version));
+    CHECK_EQ(version, 4u);
+    CHECK_EQ(table.devices[1].vendorId, SONY_VENDOR_ID);
+    CHECK_EQ(table.devices[1].productId, DUALSENSE_PRODUCT_ID);
+    CHECK_EQ(table.devices[1].connected, 1);
+    CHECK_EQ(table.devices[1].arrivals, 2u);
+    CHECK_EQ(table.devices[0].arrivals, 0u);
+
+    for (uint64_t number = 1; number <= 3; number++)
+    {
+        publisher.PublishPadState(1, MakeSharedPadState(1, number));
+    }
+    publisher.PublishMotion(1, MakeSharedMotion(1, 7));
+    REQUIRE(reader.ReadPadState(1, state, &version));
+    CHECK_EQ(version, 3u);
+    CHECK(SameSharedPadState(state, MakeSharedPadState(1, 3)));
+    CHECK_EQ(reader.GetPadStateVersion(1), 3u);
+    REQUIRE(reader.ReadMotion(1, motion, &version));
+    CHECK_EQ(version, 1u);
+    CHECK(SameSharedMotion(motion, MakeSharedMotion(1, 7)));
+    CHECK(!reader.ReadPadState(0, state));
+    CHECK(!reader.ReadPadState(SHARED_STATE_SLOTS, state));
+
+    publisher.Close();
+    CHECK(!reader.IsLive());
+    CHECK(!reader.ReadPadState(1, state));
+    CHECK(!reader.ReadDeviceTable(table));
+    CHECK_EQ(reader.GetPadStateVersion(1), 0u);
+    reader.Close();
+    CHECK(!reader.Open(name.c_str()));
+
+    // A new writer under the name starts from nothing
+    REQUIRE(publisher.Open(name.c_str()));
+    REQUIRE(reader.Open(name.c_str()));
+    CHECK(!reader.ReadPadState(1, state));
+    REQUIRE(reader.ReadDeviceTable(table));
+    CHECK_EQ(table.devices[1].arrivals, 0u);
+}
+
+// =================================================================================================
+// consistent_snapshots     the publisher flat out on this thread, SHARED_TEST_READERS readers on
+//                          theirs, each through its own mapping. A pad state read as version v is
+//                          the v-th publication of its player whole, motion likewise, and every
+//                          device of a table is one the writer published whole.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(shared_state, consistent_snapshots)
+{
+    std::string name = SharedTestName("snapshots");
+    CSharedStatePublisher publisher;
+    REQUIRE(publisher.Open(name.c_str()));
+
+    std::atomic<bool> writerDone(false);
+    std::vector<SSharedReaderResult> results(SHARED_TEST_READERS);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < SHARED_TEST_READERS; r++)
+    {
+        readers.emplace_back([&name, &writerDone, &results, r]()
+        {
+            SSharedReaderResult& result = results[r];
+            CSharedStateReader reader;
+            result.opened = reader.Open(name.c_str());
+            if (!result.opened)
+            {
+                result.reads.store(SHARED_TEST_READS, std::memory_order_relaxed);
+                return;
+            }
+            uint64_t lastVersions[SHARED_TEST_PLAYERS] = {};
+            uint64_t lastTableVersion = 0;
+            while (!writerDone.load(std::memory_order_acquire))
+            {
+                for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+                {
+                    SPadState state;
+                    uint64_t version = 0;
+                    if (reader.ReadPadState(playerIndex, state, &version))
+                    {
+                        result.reads.store(result.reads.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                        result.torn += SameSharedPadState(state, MakeSharedPadState(playerIndex, version)) ? 0 : 1;
+                        result.backwards += version < lastVersions[playerIndex] ? 1 : 0;
+                        lastVersions[playerIndex] = version;
+                    }
+                    SMotionSample motion;
+                    if (reader.ReadMotion(playerIndex, motion, &version))
+                    {
+                        result.torn += SameSharedMotion(motion, MakeSharedMotion(playerIndex, version)) ? 0 : 1;
+                    }
+                }
+                SSharedDeviceTable table;
+                uint64_t tableVersion = 0;
+                if (reader.ReadDeviceTable(table, &tableVersion))
+                {
+                    result.tables++;
+                    result.backwards += tableVersion < lastTableVersion ? 1 : 0;
+                    lastTableVersion = tableVersion;
+                    for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+                    {
+                        result.tornTables += CheckSharedDevice(table.devices[playerIndex]) ? 0 : 1;
+                    }
+                }
+            }
+        });
+    }
+
+    uint64_t published = 0;
+    uint64_t tableChanges = 0;
+    bool readersDone = false;
+    while (published < SHARED_TEST_PUBLICATIONS || !readersDone)
+    {
+        published++;
+        for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+        {
+            publisher.PublishPadState(playerIndex, MakeSharedPadState(playerIndex, published));
+            publisher.PublishMotion(playerIndex, MakeSharedMotion(playerIndex, published));
+        }
+        if (published % SHARED_TEST_DEVICE_PERIOD == 0)
+        {
+            tableChanges++;
+            for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+            {
+                publisher.PublishDevice(playerIndex, (uint16_t)tableChanges, (uint16_t)(tableChanges ^ SHARED_TEST_PRODUCT_MASK),
+                                        (tableChanges & 1) != 0);
+            }
+        }
+
+        readersDone = true;
+        for (const SSharedReaderResult& result : results)
+        {
+            readersDone = readersDone && result.reads.load(std::memory_order_relaxed) >= SHARED_TEST_READS;
+        }
+    }
+    writerDone.store(true, std::memory_order_release);
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    for (const SSharedReaderResult& result : results)
+    {
+        CHECK(result.opened);
+        CHECK_EQ(result.torn, 0u);
+        CHECK_EQ(result.backwards, 0u);
+        CHECK_EQ(result.tornTables, 0u);
+        CHECK(result.tables != 0);
+    }
+
+    // After the writer, a fresh mapping reads the last publications exactly
+    CSharedStateReader reader;
+    REQUIRE(reader.Open(name.c_str()));
+    for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+    {
+        SPadState state;
+        uint64_t version = 0;
+        REQUIRE(reader.ReadPadState(playerIndex, state, &version));
+        CHECK_EQ(version, published);
+        CHECK(SameSharedPadState(state, MakeSharedPadState(playerIndex, published)));
+    }
+    SSharedDeviceTable table;
+    uint64_t version = 0;
+    REQUIRE(reader.ReadDeviceTable(table, &version));
+    CHECK_EQ(version, 1 + SHARED_TEST_PLAYERS * tableChanges);
+    CHECK_EQ(table.devices[1].vendorId, (uint16_t)tableChanges);
+}
+
+#ifndef _WIN32
+// =================================================================================================
+// SignalProcess            one byte down the pipe; the other side waits for it in WaitForProcess
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool SignalProcess(int fd)
+{
+    char signal = 1;
+    return write(fd, &signal, 1) == 1;
+}
+
+// =================================================================================================
+// WaitForProcess           false when the other side closed its end, by exiting, without signalling
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool WaitForProcess(int fd)
+{
+    char signal = 0;
+    return read(fd, &signal, 1) == 1;
+}
+
+// =================================================================================================
+// ForkChild                body runs in a child process and its result becomes the exit status.
+//                          The child talks through toParent and listens on fromParent; the parent
+//                          gets the other two ends. -1 when the process cannot be made.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+template <typename Body>
+static pid_t ForkChild(int& toChild, int& fromChild, Body body)
+{
+    int down[2];
+    int up[2];
+    if (pipe(down) != 0)
+    {
+        return -1;
+    }
+    if (pipe(up) != 0)
+    {
+        close(down[0]);
+        close(down[1]);
+        return -1;
+    }
+
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // No destructors or atexit handlers of the parent's copy; the body reports through the status
+        close(down[1]);
+        close(up[0]);
+        alarm(SHARED_TEST_CHILD_TIMEOUT_S);
+        int failures = body(down[0], up[1]);
+        _exit(failures);
+    }
+
+    close(down[0]);
+    close(up[1]);
+    if (pid < 0)
+    {
+        close(down[1]);
+        close(up[0]);
+        return -1;
+    }
+    toChild = down[1];
+    fromChild = up[0];
+    return pid;
+}
+
+// =================================================================================================
+// WaitForChild             the child's failure bits, -1 when it did not exit by itself
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int WaitForChild(pid_t pid, int toChild, int fromChild)
+{
+    close(toChild);
+    close(fromChild);
+
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status))
+    {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+// =================================================================================================
+// ReadInChild              a reader process: attaches by name, reads SHARED_TEST_READS pad states
+//                          while the parent publishes, then has the parent close the region under
+//                          its mapping and checks the reader goes stale and the name is gone
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int ReadInChild(const std::string& name, int fromParent, int toParent)
+{
+    CSharedStateReader reader;
+    if (!reader.Open(name.c_str()))
+    {
+        return SHARED_CHILD_OPEN;
+    }
+
+    int failures = 0;
+    uint64_t reads = 0;
+    uint64_t tables = 0;
+    uint64_t lastVersions[SHARED_TEST_PLAYERS] = {};
+    while (reads < SHARED_TEST_READS)
+    {
+        for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+        {
+            SPadState state;
+            uint64_t version = 0;
+            if (reader.ReadPadState(playerIndex, state, &version))
+            {
+                reads++;
+                failures |= SameSharedPadState(state, MakeSharedPadState(playerIndex, version)) ? 0 : SHARED_CHILD_TORN;
+                failures |= version < lastVersions[playerIndex] ? SHARED_CHILD_BACKWARDS : 0;
+                lastVersions[playerIndex] = version;
+            }
+            SMotionSample motion;
+            if (reader.ReadMotion(playerIndex, motion, &version))
+            {
+                failures |= SameSharedMotion(motion, MakeSharedMotion(playerIndex, version)) ? 0 : SHARED_CHILD_TORN;
+            }
+        }
+        SSharedDeviceTable table;
+        if (reader.ReadDeviceTable(table))
+        {
+            tables++;
+            for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+            {
+                failures |= CheckSharedDevice(table.devices[playerIndex]) ? 0 : SHARED_CHILD_TORN;
+            }
+        }
+    }
+    failures |= tables != 0 ? 0 : SHARED_CHILD_NO_TABLE;
+
+    if (!SignalProcess(toParent) || !WaitForProcess(fromParent))
+    {
+        return failures | SHARED_CHILD_PIPE;
+    }
+
+    // The parent closed: the mapping stays readable, marked closed, and the object is unlinked,
+    // which a reader's Open cannot tell from a closed region still under the name
+    SPadState state;
+    failures |= reader.IsLive() || reader.ReadPadState(0, state) ? SHARED_CHILD_LIVE : 0;
+    int fd = shm_open(("/" + name).c_str(), O_RDONLY | O_CLOEXEC, 0);
+    failures |= fd >= 0 || errno != ENOENT ? SHARED_CHILD_REOPENED : 0;
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    reader.Close();
+    return failures;
+}
+
+// =================================================================================================
+// WriteInChild             a writer process: creates the region, publishes a device and a few pad
+//                          states, signals, and once the parent is done exits without Close as a
+//                          crashing writer would
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static int WriteInChild(const std::string& name, int fromParent, int toParent)
+{
+    CSharedStatePublisher publisher;
+    if (!publisher.Open(name.c_str()))
+    {
+        return SHARED_CHILD_OPEN;
+    }
+
+    publisher.PublishDevice(1, SONY_VENDOR_ID, DS4_PRODUCT_ID_V2, true);
+    for (uint64_t number = 1; number <= SHARED_TEST_CHILD_PUBLICATIONS; number++)
+    {
+        publisher.PublishPadState(1, MakeSharedPadState(1, number));
+    }
+
+    if (!SignalProcess(toParent) || !WaitForProcess(fromParent))
+    {
+        return SHARED_CHILD_PIPE;
+    }
+    return 0;
+}
+
+// =================================================================================================
+// reader_process           a reader in another process against the publisher flat out here; the
+//                          publisher then closes, removing the name while that process still has
+//                          the region mapped
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(shared_state, reader_process)
+{
+    std::string name = SharedTestName("reader_process");
+    CSharedStatePublisher publisher;
+    REQUIRE(publisher.Open(name.c_str()));
+
+    int toChild = -1;
+    int fromChild = -1;
+    pid_t pid = ForkChild(toChild, fromChild, [&name](int fromParent, int toParent)
+    {
+        return ReadInChild(name, fromParent, toParent);
+    });
+    REQUIRE(pid > 0);
+
+    uint64_t published = 0;
+    uint64_t tableChanges = 0;
+    bool readerDone = false;
+    while (!readerDone)
+    {
+        published++;
+        for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+        {
+            publisher.PublishPadState(playerIndex, MakeSharedPadState(playerIndex, published));
+            publisher.PublishMotion(playerIndex, MakeSharedMotion(playerIndex, published));
+        }
+        if (published % SHARED_TEST_DEVICE_PERIOD == 0)
+        {
+            tableChanges++;
+            for (int playerIndex = 0; playerIndex < SHARED_TEST_PLAYERS; playerIndex++)
+            {
+                publisher.PublishDevice(playerIndex, (uint16_t)tableChanges, (uint16_t)(tableChanges ^ SHARED_TEST_PRODUCT_MASK),
+                                        (tableChanges & 1) != 0);
+            }
+        }
+        if (published % SHARED_TEST_POLL_PERIOD == 0)
+        {
+            // A child that exited early shows as end of file, and this ends the loop as well
+            pollfd descriptor = { fromChild, POLLIN, 0 };
+            readerDone = poll(&descriptor, 1, 0) == 1;
+        }
+    }
+
+    bool signalled = WaitForProcess(fromChild);
+    publisher.Close();
+    CHECK(signalled);
+    if (signalled)
+    {
+        CHECK(SignalProcess(toChild));
+    }
+    CHECK_EQ(WaitForChild(pid, toChild, fromChild), 0);
+}
+
+// =================================================================================================
+// writer_process           a region created by another process: readable here, not to be taken
+//                          over while that writer lives, taken over and laid out anew once it
+//                          died without closing
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(shared_state, writer_process)
+{
+    std::string name = SharedTestName("writer_process");
+    int toChild = -1;
+    int fromChild = -1;
+    pid_t pid = ForkChild(toChild, fromChild, [&name](int fromParent, int toParent)
+    {
+        return WriteInChild(name, fromParent, toParent);
+    });
+    REQUIRE(pid > 0);
+
+    bool created = WaitForProcess(fromChild);
+    CSharedStateReader reader;
+    CSharedStatePublisher publisher;
+    if (created)
+    {
+        CHECK(reader.Open(name.c_str()));
+        SPadState state;
+        uint64_t version = 0;
+        CHECK(reader.ReadPadState(1, state, &version));
+        CHECK_EQ(version, SHARED_TEST_CHILD_PUBLICATIONS);
+        CHECK(SameSharedPadState(state, MakeSharedPadState(1, SHARED_TEST_CHILD_PUBLICATIONS)));
+        SSharedDeviceTable table;
+        CHECK(reader.ReadDeviceTable(table));
+        CHECK_EQ(table.devices[1].productId, DS4_PRODUCT_ID_V2);
+
+        // The live writer keeps the region, and the refused Open leaves its name in place
+        CHECK(!publisher.Open(name.c_str()));
+        CHECK(reader.IsLive());
+        CSharedStateReader second;
+        CHECK(second.Open(name.c_str()));
+        CHECK(SignalProcess(toChild));
+    }
+    CHECK(created);
+    CHECK_EQ(WaitForChild(pid, toChild, fromChild), 0);
+
+    // The writer is gone with the region still marked live: the next writer takes it over, which
+    // leaves the dead writer's readers stale and a new reader sees only what it published
+    REQUIRE(publisher.Open(name.c_str()));
+    SPadState state;
+    CHECK(!reader.IsLive());
+    CHECK(!reader.ReadPadState(1, state));
+    reader.Close();
+    REQUIRE(reader.Open(name.c_str()));
+    CHECK(!reader.ReadPadState(1, state));
+    publisher.PublishPadState(1, MakeSharedPadState(1, 1));
+    uint64_t version = 0;
+    CHECK(reader.ReadPadState(1, state, &version));
+    CHECK_EQ(version, 1u);
+    publisher.Close();
+    CHECK(!reader.IsLive());
+}
+#endif
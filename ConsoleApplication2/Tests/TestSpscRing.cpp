@@ -0,0 +1,226 @@
+// =================================================================================================
+// CSpscRing stress tests: a producer thread pushing sequence-numbered, self-checking samples at
+// 8 kHz and unthrottled against a consumer that stalls now and then, under each overflow policy.
+// The consumer must see the samples in order, none torn, and every missing one counted as dropped.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "TestHarness.h"
+#include "CSpscRing.h"
+#include "MonotonicClock.h"
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+const uint64_t RING_TEST_PERIOD_NS = 125000;           // 8 kHz
+const uint64_t RING_TEST_PACED_SAMPLES = 4000;         // half a second of input
+const uint64_t RING_TEST_UNPACED_SAMPLES = 200000;
+const size_t RING_TEST_CAPACITY = 8;
+
+// The consumer sleeps this long after every RING_TEST_STALL_EVERY samples, long enough for the
+// producer to lap a ring of RING_TEST_CAPACITY at 8 kHz
+const uint64_t RING_TEST_STALL_EVERY = 256;
+const unsigned RING_TEST_STALL_MS = 3;
+
+const size_t RING_TEST_BATCH = 32;
+const int RING_TEST_CHECK_WORDS = 6;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// One cache line; every check word is derived from the sequence, so a sample mixing two writes
+// shows up
+struct STestRingSample
+{
+	uint64_t sequence;
+	uint64_t timestampNs;
+	uint64_t check[RING_TEST_CHECK_WORDS];
+};
+
+struct SRingRunResult
+{
+	uint64_t produced;
+	uint64_t rejected;          // pushes that returned false
+	uint64_t dropped;           // DroppedCount() once the ring is drained
+	uint64_t torn;
+	uint64_t outOfOrder;
+	uint64_t notAccepted;       // received, yet its push was refused
+	std::vector<uint64_t> received;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// RingCheckWord
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static uint64_t RingCheckWord(uint64_t sequence, int word)
+{
+    return (sequence + 1) * 0x9E3779B97F4A7C15ull ^ ((uint64_t)word << 56);
+}
+
+// =================================================================================================
+// RunRingStress            one producer thread, the calling thread consumes; periodNs 0 pushes as
+//                          fast as it can
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SRingRunResult RunRingStress(ERingOverflowPolicy policy, uint64_t count, uint64_t periodNs, bool stall)
+{
+    CSpscRing<STestRingSample> ring(RING_TEST_CAPACITY, policy);
+    std::vector<unsigned char> accepted(count, 0);
+    std::atomic<bool> producerDone(false);
+
+    SRingRunResult result = SRingRunResult();
+    result.produced = count;
+    result.received.reserve(count);
+
+    std::thread producer([&]()
+    {
+        uint64_t startNs = MonotonicNowNs();
+        for (uint64_t i = 0; i < count; i++)
+        {
+            uint64_t deadlineNs = startNs + i * periodNs;
+            while (periodNs != 0 && MonotonicNowNs() < deadlineNs)
+            {
+                std::this_thread::yield();
+            }
+
+            STestRingSample sample;
+            sample.sequence = i;
+            sample.timestampNs = MonotonicNowNs();
+            for (int j = 0; j < RING_TEST_CHECK_WORDS; j++)
+            {
+                sample.check[j] = RingCheckWord(i, j);
+            }
+            if (ring.Push(sample))
+            {
+                accepted[i] = 1;
+            }
+            else
+            {
+                result.rejected++;
+            }
+        }
+        producerDone.store(true, std::memory_order_release);
+    });
+
+    STestRingSample batch[RING_TEST_BATCH];
+    bool haveLast = false;
+    uint64_t lastSequence = 0;
+    for (;;)
+    {
+        // Read the flag first: once it is set, one more drain empties the ring for good
+        bool done = producerDone.load(std::memory_order_acquire);
+        size_t drained = ring.DrainBatch(batch, RING_TEST_BATCH);
+        for (size_t i = 0; i < drained; i++)
+        {
+            const STestRingSample& sample = batch[i];
+            bool intact = true;
+            for (int j = 0; j < RING_TEST_CHECK_WORDS; j++)
+            {
+                intact = intact && sample.check[j] == RingCheckWord(sample.sequence, j);
+            }
+            result.torn += intact ? 0 : 1;
+            result.outOfOrder += haveLast && sample.sequence <= lastSequence ? 1 : 0;
+            haveLast = true;
+            lastSequence = sample.sequence;
+            result.received.push_back(sample.sequence);
+
+            if (stall && result.received.size() % RING_TEST_STALL_EVERY == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(RING_TEST_STALL_MS));
+            }
+        }
+        if (drained == 0)
+        {
+            if (done)
+            {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    for (uint64_t sequence : result.received)
+    {
+        result.notAccepted += sequence < count && accepted[sequence] ? 0 : 1;
+    }
+    result.dropped = ring.DroppedCount();
+    return result;
+}
+
+// =================================================================================================
+// CheckRingAccounting      in order, intact, and what did not arrive is exactly what was dropped
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CheckRingAccounting(const SRingRunResult& result)
+{
+    CHECK_EQ(result.torn, 0u);
+    CHECK_EQ(result.outOfOrder, 0u);
+    CHECK_EQ(result.notAccepted, 0u);
+    CHECK_EQ(result.received.size() + result.dropped, result.produced);
+}
+
+// =================================================================================================
+// count_drops_8khz         a full ring refuses the newest sample: every refused push is counted
+//                          and every accepted one is delivered
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(spsc_ring, count_drops_8khz)
+{
+    SRingRunResult result = RunRingStress(RING_COUNT_DROPS, RING_TEST_PACED_SAMPLES, RING_TEST_PERIOD_NS, true);
+    CheckRingAccounting(result);
+    CHECK_EQ(result.dropped, result.rejected);
+    CHECK(result.rejected > 0);
+}
+
+// =================================================================================================
+// overwrite_oldest_8khz    the producer never fails; the consumer skips what was overwritten, counts
+//                          it, and still ends on the newest sample
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(spsc_ring, overwrite_oldest_8khz)
+{
+    SRingRunResult result = RunRingStress(RING_OVERWRITE_OLDEST, RING_TEST_PACED_SAMPLES, RING_TEST_PERIOD_NS, true);
+    CheckRingAccounting(result);
+    CHECK_EQ(result.rejected, 0u);
+    CHECK(result.dropped > 0);
+    REQUIRE(!result.received.empty());
+    CHECK_EQ(result.received.back(), RING_TEST_PACED_SAMPLES - 1);
+}
+
+// =================================================================================================
+// unpaced                  both policies with the producer pushing flat out into a consumer that
+//                          never stalls, where a slot rewritten mid-copy is most likely
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(spsc_ring, unpaced)
+{
+    SRingRunResult dropping = RunRingStress(RING_COUNT_DROPS, RING_TEST_UNPACED_SAMPLES, 0, false);
+    CheckRingAccounting(dropping);
+    CHECK_EQ(dropping.dropped, dropping.rejected);
+
+    SRingRunResult overwriting = RunRingStress(RING_OVERWRITE_OLDEST, RING_TEST_UNPACED_SAMPLES, 0, false);
+    CheckRingAccounting(overwriting);
+    CHECK_EQ(overwriting.rejected, 0u);
+    REQUIRE(!overwriting.received.empty());
+    CHECK_EQ(overwriting.received.back(), RING_TEST_UNPACED_SAMPLES - 1);
+}
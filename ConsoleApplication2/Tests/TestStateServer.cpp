@@ -0,0 +1,515 @@
+// =================================================================================================
+// State server tests: a CStateServer on ephemeral loopback ports and a CStateClient in each
+// protocol. The compact client can sit behind a relay that drops the server's datagrams on
+// demand, to show a delta client resyncs from its acknowledged state or from a keyframe.
+//
+// Author: Eran yeruham, Date: October 17, 2026
+//
+// Copyright  Globus 2026 All Rights Reserved
+// -------------------------------------------------------------------------------------------------
+
+// =================================================================================================
+// ======================================== INCLUDED FILES =========================================
+
+#include <cstring>
+#include <functional>
+#include "TestHarness.h"
+#include "CStateClient.h"
+#include "CStateServer.h"
+#include "MonotonicClock.h"
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// =================================================================================================
+// ====================================== CONSTANTS, ENUMS =========================================
+
+#ifdef _WIN32
+const STATE_SERVER_SOCKET STATE_TEST_NO_SOCKET = (STATE_SERVER_SOCKET)INVALID_SOCKET;
+#else
+const STATE_SERVER_SOCKET STATE_TEST_NO_SOCKET = -1;
+#endif
+
+// Longest wait for something that takes a millisecond on loopback
+const uint64_t STATE_TEST_TIMEOUT_NS = 2000000000ULL;
+// How long a datagram that must not arrive is waited for
+const uint64_t STATE_TEST_QUIET_NS = 50000000ULL;
+const uint32_t STATE_TEST_POLL_US = 1000;
+const size_t STATE_TEST_MAX_DATAGRAM = 2048;
+const int STATE_TEST_REPORTS = 20;
+
+// =================================================================================================
+// ================================= TYPES, CLASSES, STRUCTURES ====================================
+
+// Forwards datagrams between one client and the server, both ways, when pumped; the next
+// datagrams of the server can be dropped instead
+class CTestUdpRelay
+{
+public:
+   CTestUdpRelay();
+   ~CTestUdpRelay();
+
+   bool Open(uint16_t serverPort);
+   uint16_t GetPort() const { return m_port; }
+   void DropFromServer(uint64_t datagrams) { m_toDrop += datagrams; }
+   uint64_t GetDropped() const { return m_dropped; }
+   void Pump();
+
+private:
+   void Close();
+
+
+   STATE_SERVER_SOCKET m_clientSide;    // the client sends here
+   STATE_SERVER_SOCKET m_serverSide;    // connected to the server
+   uint16_t m_port;
+   sockaddr_in m_client;
+   bool m_haveClient;
+   uint64_t m_toDrop;
+   uint64_t m_dropped;
+};
+
+// =================================================================================================
+// ===================================== FUNCTION DEFINITIONS ======================================
+
+// =================================================================================================
+// CloseTestSocket
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static void CloseTestSocket(STATE_SERVER_SOCKET udpSocket)
+{
+#ifdef _WIN32
+    closesocket((SOCKET)udpSocket);
+#else
+    close(udpSocket);
+#endif
+}
+
+// =================================================================================================
+// OpenTestSocket           non-blocking; bound to a free loopback port when bindPort, else
+//                          connected to the loopback port
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static STATE_SERVER_SOCKET OpenTestSocket(bool bindPort, uint16_t& port)
+{
+#ifdef _WIN32
+    STATE_SERVER_SOCKET udpSocket = (STATE_SERVER_SOCKET)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    u_long nonBlocking = 1;
+    if (udpSocket != STATE_TEST_NO_SOCKET && ioctlsocket((SOCKET)udpSocket, FIONBIO, &nonBlocking) != 0)
+    {
+        CloseTestSocket(udpSocket);
+        return STATE_TEST_NO_SOCKET;
+    }
+#else
+    STATE_SERVER_SOCKET udpSocket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+#endif
+    if (udpSocket == STATE_TEST_NO_SOCKET)
+    {
+        return STATE_TEST_NO_SOCKET;
+    }
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(bindPort ? 0 : port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+    bool ready = bindPort ? bind(udpSocket, (const sockaddr*)&address, sizeof(address)) == 0 &&
+                            getsockname(udpSocket, (sockaddr*)&address, &addressLength) == 0
+                          : connect(udpSocket, (const sockaddr*)&address, sizeof(address)) == 0;
+    if (!ready)
+    {
+        CloseTestSocket(udpSocket);
+        return STATE_TEST_NO_SOCKET;
+    }
+    if (bindPort)
+    {
+        port = ntohs(address.sin_port);
+    }
+    return udpSocket;
+}
+
+// =================================================================================================
+// CTestUdpRelay
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CTestUdpRelay::CTestUdpRelay() :
+    m_clientSide(STATE_TEST_NO_SOCKET),
+    m_serverSide(STATE_TEST_NO_SOCKET),
+    m_port(0),
+    m_haveClient(false),
+    m_toDrop(0),
+    m_dropped(0)
+{
+    std::memset(&m_client, 0, sizeof(m_client));
+}
+
+// =================================================================================================
+// ~CTestUdpRelay
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+CTestUdpRelay::~CTestUdpRelay()
+{
+    Close();
+}
+
+// =================================================================================================
+// Open
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+bool CTestUdpRelay::Open(uint16_t serverPort)
+{
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        return false;
+    }
+#endif
+    m_clientSide = OpenTestSocket(true, m_port);
+    m_serverSide = OpenTestSocket(false, serverPort);
+    if (m_clientSide == STATE_TEST_NO_SOCKET || m_serverSide == STATE_TEST_NO_SOCKET)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+// =================================================================================================
+// Close
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CTestUdpRelay::Close()
+{
+    if (m_clientSide == STATE_TEST_NO_SOCKET && m_serverSide == STATE_TEST_NO_SOCKET)
+    {
+        return;
+    }
+    if (m_clientSide != STATE_TEST_NO_SOCKET)
+    {
+        CloseTestSocket(m_clientSide);
+        m_clientSide = STATE_TEST_NO_SOCKET;
+    }
+    if (m_serverSide != STATE_TEST_NO_SOCKET)
+    {
+        CloseTestSocket(m_serverSide);
+        m_serverSide = STATE_TEST_NO_SOCKET;
+    }
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+// =================================================================================================
+// Pump                     everything waiting on either side; the server's datagrams go to the
+//                          last address the client sent from
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+void CTestUdpRelay::Pump()
+{
+    unsigned char datagram[STATE_TEST_MAX_DATAGRAM];
+    for (;;)
+    {
+        sockaddr_in from;
+        socklen_t fromLength = sizeof(from);
+        int received = (int)recvfrom(m_clientSide, (char*)datagram, sizeof(datagram), 0, (sockaddr*)&from, &fromLength);
+        if (received < 0)
+        {
+            break;
+        }
+        m_client = from;
+        m_haveClient = true;
+        send(m_serverSide, (const char*)datagram, received, 0);
+    }
+    for (;;)
+    {
+        int received = (int)recv(m_serverSide, (char*)datagram, sizeof(datagram), 0);
+        if (received < 0)
+        {
+            break;
+        }
+        if (m_toDrop != 0)
+        {
+            m_toDrop--;
+            m_dropped++;
+        }
+        else if (m_haveClient)
+        {
+            sendto(m_clientSide, (const char*)datagram, received, 0, (const sockaddr*)&m_client, sizeof(m_client));
+        }
+    }
+}
+
+// =================================================================================================
+// PollUntil                polls the client, pumping the relay if there is one, until done is true
+//                          or the time runs out; the last answer of done
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool PollUntil(CStateClient& client, CTestUdpRelay* pRelay, uint64_t timeoutNs, std::function<bool()> done)
+{
+    uint64_t deadlineNs = MonotonicNowNs() + timeoutNs;
+    while (!done())
+    {
+        if (MonotonicNowNs() >= deadlineNs)
+        {
+            return false;
+        }
+        if (pRelay != nullptr)
+        {
+            pRelay->Pump();
+        }
+        client.Poll(STATE_TEST_POLL_US);
+        if (pRelay != nullptr)
+        {
+            pRelay->Pump();
+        }
+    }
+    return true;
+}
+
+// =================================================================================================
+// MakeTestPadState         report number of a pad, every group a record can carry changing with it
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static SPadState MakeTestPadState(int playerIndex, int number)
+{
+    SPadState state = SPadState();
+    state.timestampNs = MonotonicNowNs();
+    state.playerIndex = (uint8_t)playerIndex;
+    state.buttons = (uint32_t)(number * 37 + playerIndex) & ((1u << PAD_BUTTON_COUNT) - 1);
+    state.leftX = (uint16_t)((number * 11 + playerIndex * 40) & 0xFF);
+    state.leftY = (uint16_t)((number * 13 + 7) & 0xFF);
+    state.rightX = (uint16_t)((number * 17 + 3) & 0xFF);
+    state.rightY = (uint16_t)((255 - number * 5) & 0xFF);
+    state.L2 = (uint16_t)((number * 19) & 0xFF);
+    state.R2 = (uint16_t)((number * 23) & 0xFF);
+    state.hat = (uint8_t)(number % 9);
+    state.flags = PAD_FLAG_MOTION | ((number & 1) != 0 ? PAD_FLAG_TOUCH : 0);
+    state.battery = (uint8_t)(50 + playerIndex);
+    state.gyro[0] = (int16_t)(number * 101 - 900);
+    state.gyro[2] = (int16_t)(-number * 7);
+    state.accel[1] = (int16_t)(8192 - number);
+    state.sensorTimestamp = (uint16_t)(number * 188);
+    state.touch[0].active = (number & 1) != 0 ? 1 : 0;
+    state.touch[0].id = (uint8_t)number;
+    state.touch[0].x = (uint16_t)(number * 31);
+    state.touch[0].y = (uint16_t)(number * 29);
+    return state;
+}
+
+// =================================================================================================
+// HoldsState               the compact client's state of the pad has every group of expected
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool HoldsState(const CStateClient& client, int playerIndex, const SPadState& expected)
+{
+    SPadState decoded;
+    return client.GetState(playerIndex, decoded) && GetDeltaFieldMask(expected, decoded) == 0;
+}
+
+// =================================================================================================
+// StartTestServer          one protocol on an ephemeral loopback port
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+static bool StartTestServer(CStateServer& server, bool compact)
+{
+    SStateServerConfig config;
+    config.dsu = !compact;
+    config.dsuPort = 0;
+    config.compact = compact;
+    config.compactPort = 0;
+    return server.Start(config);
+}
+
+// =================================================================================================
+// dsu                      the client learns the slots, subscribes, and follows every report of
+//                          the four DSU slots without a gap; a fifth player is not served
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(state_server, dsu)
+{
+    CStateServer server;
+    REQUIRE(StartTestServer(server, false));
+    CHECK(server.GetDsuPort() != 0);
+    CHECK_EQ(server.GetCompactPort(), 0u);
+    server.SubmitDevice(0, true);
+    server.SubmitDevice(1, true);
+    server.SubmitDevice(DSU_SLOTS, true);
+
+    CStateClient client;
+    REQUIRE(client.Open(STATE_CLIENT_DSU, server.GetDsuPort()));
+    // The slot query and the pad data request
+    REQUIRE(PollUntil(client, nullptr, STATE_TEST_TIMEOUT_NS, [&server]() { return server.GetCounters().requests >= 2; }));
+
+    SPadState last[2];
+    for (int number = 1; number <= STATE_TEST_REPORTS; number++)
+    {
+        for (int playerIndex = 0; playerIndex < 2; playerIndex++)
+        {
+            last[playerIndex] = MakeTestPadState(playerIndex, number);
+            server.SubmitState(playerIndex, last[playerIndex], nullptr);
+        }
+        server.SubmitState(DSU_SLOTS, MakeTestPadState(DSU_SLOTS, number), nullptr);
+    }
+
+    SDsuPadData padData[2];
+    REQUIRE(PollUntil(client, nullptr, STATE_TEST_TIMEOUT_NS, [&client, &padData]()
+    {
+        return client.GetDsuPadData(0, padData[0]) && padData[0].packetNumber == STATE_TEST_REPORTS - 1 &&
+               client.GetDsuPadData(1, padData[1]) && padData[1].packetNumber == STATE_TEST_REPORTS - 1;
+    }));
+    for (int playerIndex = 0; playerIndex < 2; playerIndex++)
+    {
+        const SDsuPadData& data = padData[playerIndex];
+        const SPadState& state = last[playerIndex];
+        CHECK_EQ(data.slot, playerIndex);
+        CHECK_EQ(data.connected, 1);
+        CHECK_EQ(data.sticks[0], state.leftX);
+        CHECK_EQ(data.sticks[1], 255 - state.leftY);
+        CHECK_EQ(data.sticks[2], state.rightX);
+        CHECK_EQ(data.sticks[3], 255 - state.rightY);
+        CHECK_EQ(data.ps, (state.buttons >> PAD_BUTTON_PS) & 1);
+        CHECK_EQ(data.touchButton, (state.buttons >> PAD_BUTTON_TOUCHPAD) & 1);
+    }
+    SDsuPadData unused;
+    CHECK(!client.GetDsuPadData(2, unused));
+
+    SStateClientCounters counters = client.GetCounters();
+    CHECK_EQ(counters.updates, (uint64_t)(2 * STATE_TEST_REPORTS));
+    CHECK_EQ(counters.lost, 0u);
+    CHECK_EQ(counters.invalid, 0u);
+    CHECK_EQ(server.GetCounters().reports, (uint64_t)(3 * STATE_TEST_REPORTS));
+}
+
+// =================================================================================================
+// compact                  the client ends up holding the last state of each pad, through deltas
+//                          on the keyframe, and drops a pad that is removed
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(state_server, compact)
+{
+    CStateServer server;
+    REQUIRE(StartTestServer(server, true));
+    CHECK(server.GetCompactPort() != 0);
+    CHECK_EQ(server.GetDsuPort(), 0u);
+    server.SubmitDevice(0, true);
+    server.SubmitDevice(2, true);
+
+    CStateClient client;
+    REQUIRE(client.Open(STATE_CLIENT_COMPACT, server.GetCompactPort()));
+    REQUIRE(PollUntil(client, nullptr, STATE_TEST_TIMEOUT_NS, [&server]() { return server.GetCounters().requests >= 1; }));
+
+    SPadState last[2];
+    for (int number = 1; number <= STATE_TEST_REPORTS; number++)
+    {
+        last[0] = MakeTestPadState(0, number);
+        last[1] = MakeTestPadState(2, number);
+        server.SubmitState(0, last[0], nullptr);
+        server.SubmitState(2, last[1], nullptr);
+        // Every other report waits to be taken, so some records ride on acknowledged bases
+        if ((number & 1) == 0)
+        {
+            CHECK(PollUntil(client, nullptr, STATE_TEST_TIMEOUT_NS, [&client, &last]()
+            {
+                return HoldsState(client, 0, last[0]) && HoldsState(client, 2, last[1]);
+            }));
+        }
+    }
+    SPadState unused;
+    CHECK(!client.GetState(1, unused));
+
+    SStateServerCounters serverCounters = server.GetCounters();
+    CHECK(serverCounters.compactKeyframes >= 2);
+    CHECK(serverCounters.compactRecords > serverCounters.compactKeyframes);
+
+    server.SubmitDevice(2, false);
+    CHECK(PollUntil(client, nullptr, STATE_TEST_TIMEOUT_NS, [&client, &unused]() { return !client.GetState(2, unused); }));
+    CHECK(HoldsState(client, 0, last[0]));
+
+    SStateClientCounters counters = client.GetCounters();
+    CHECK_EQ(counters.missingBases, 0u);
+    CHECK_EQ(counters.invalid, 0u);
+}
+
+// =================================================================================================
+// compact_resync           a dropped datagram costs only itself: the next record is a delta on
+//                          the state the client acknowledged. Drops longer than the history end
+//                          in a keyframe. Either way the client holds the last state again.
+//
+// Author: Eran Yeruham, Date: 17 October 2026
+// -------------------------------------------------------------------------------------------------
+TEST_CASE(state_server, compact_resync)
+{
+    CStateServer server;
+    REQUIRE(StartTestServer(server, true));
+    CTestUdpRelay relay;
+    REQUIRE(relay.Open(server.GetCompactPort()));
+    server.SubmitDevice(0, true);
+
+    CStateClient client;
+    REQUIRE(client.Open(STATE_CLIENT_COMPACT, relay.GetPort()));
+    REQUIRE(PollUntil(client, &relay, STATE_TEST_TIMEOUT_NS, [&server]() { return server.GetCounters().requests >= 1; }));
+
+    // One report per datagram, each taken and acknowledged before the next
+    int number = 0;
+    SPadState state;
+    for (int i = 0; i < STATE_TEST_REPORTS; i++)
+    {
+        state = MakeTestPadState(0, ++number);
+        server.SubmitState(0, state, nullptr);
+        REQUIRE(PollUntil(client, &relay, STATE_TEST_TIMEOUT_NS, [&client, &state]() { return HoldsState(client, 0, state); }));
+    }
+    SPadState held = state;
+    uint64_t keyframes = server.GetCounters().compactKeyframes;
+    CHECK_EQ(keyframes, 1u);
+
+    // One lost datagram
+    relay.DropFromServer(1);
+    state = MakeTestPadState(0, ++number);
+    server.SubmitState(0, state, nullptr);
+    REQUIRE(PollUntil(client, &relay, STATE_TEST_TIMEOUT_NS, [&relay]() { return relay.GetDropped() == 1; }));
+    PollUntil(client, &relay, STATE_TEST_QUIET_NS, []() { return false; });
+    CHECK(HoldsState(client, 0, held));
+
+    state = MakeTestPadState(0, ++number);
+    server.SubmitState(0, state, nullptr);
+    CHECK(PollUntil(client, &relay, STATE_TEST_TIMEOUT_NS, [&client, &state]() { return HoldsState(client, 0, state); }));
+    CHECK_EQ(server.GetCounters().compactKeyframes, keyframes);
+
+    // More lost datagrams than the history holds; the acknowledged state is evicted on the server
+    uint64_t dropped = relay.GetDropped();
+    for (uint32_t i = 0; i < DELTA_HISTORY + 8; i++)
+    {
+        relay.DropFromServer(1);
+        state = MakeTestPadState(0, ++number);
+        server.SubmitState(0, state, nullptr);
+        REQUIRE(PollUntil(client, &relay, STATE_TEST_TIMEOUT_NS, [&relay, dropped, i]() { return relay.GetDropped() == dropped + i + 1; }));
+    }
+    keyframes = server.GetCounters().compactKeyframes;
+    state = MakeTestPadState(0, ++number);
+    server.SubmitState(0, state, nullptr);
+    CHECK(PollUntil(client, &relay, STATE_TEST_TIMEOUT_NS, [&client, &state]() { return HoldsState(client, 0, state); }));
+    CHECK_EQ(server.GetCounters().compactKeyframes, keyframes + 1);
+
+    SStateClientCounters counters = client.GetCounters();
+    CHECK_EQ(counters.missingBases, 0u);
+    CHECK_EQ(counters.invalid, 0u);
+}